@@ -64,6 +64,7 @@ struct evt_options {
 	uint8_t timdev_cnt;
 	uint8_t nb_timer_adptrs;
 	uint8_t timdev_use_burst;
+	uint8_t timdev_use_wheel;
 	uint8_t per_port_pool;
 	uint8_t preschedule;
 	uint8_t preschedule_opted;
@@ -82,8 +83,10 @@ struct evt_options {
 	uint32_t crypto_cipher_key_sz;
 	uint32_t q_priority:1;
 	uint32_t fwd_latency:1;
+	uint32_t lat_hist:1;
 	uint32_t ena_vector : 1;
 	uint64_t nb_pkts;
+	uint64_t prod_rate;
 	uint64_t nb_timers;
 	uint64_t expiry_nsec;
 	uint64_t max_tmo_nsec;
@@ -91,6 +94,8 @@ struct evt_options {
 	uint64_t timer_tick_nsec;
 	uint64_t optm_timer_tick_nsec;
 	enum evt_prod_type prod_type;
+	const char *lat_csv;
+	const char *xstats;
 	enum rte_event_dma_adapter_mode dma_adptr_mode;
 	enum rte_event_crypto_adapter_mode crypto_adptr_mode;
 	enum rte_crypto_op_type crypto_op_type;
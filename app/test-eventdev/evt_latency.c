@@ -0,0 +1,175 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+
+#include "evt_latency.h"
+#include "evt_options.h"
+
+#define EVT_LAT_NB_SCHED_TYPES (RTE_SCHED_TYPE_PARALLEL + 1)
+
+struct evt_lat_hist *
+evt_lat_hist_alloc(struct evt_options *opt)
+{
+	return rte_zmalloc_socket("evt_lat_hist", sizeof(struct evt_lat_hist) *
+				  (opt->nb_stages + 1), RTE_CACHE_LINE_SIZE,
+				  opt->socket_id);
+}
+
+void
+evt_lat_hist_free(struct evt_lat_hist *h)
+{
+	rte_free(h);
+}
+
+static void
+evt_lat_hist_merge(struct evt_lat_hist *dst, const struct evt_lat_hist *src)
+{
+	unsigned int i;
+
+	if (src->count == 0)
+		return;
+
+	for (i = 0; i < EVT_LAT_HIST_NB_BUCKETS; i++)
+		dst->buckets[i] += src->buckets[i];
+	dst->count += src->count;
+	dst->sum += src->sum;
+	dst->max = RTE_MAX(dst->max, src->max);
+}
+
+/* Highest value recorded in a bucket */
+static uint64_t
+evt_lat_hist_value(unsigned int idx)
+{
+	unsigned int shift;
+
+	if (idx < EVT_LAT_HIST_SUB_CNT)
+		return idx;
+
+	shift = idx / EVT_LAT_HIST_HALF_CNT - 1;
+	return ((uint64_t)(idx % EVT_LAT_HIST_HALF_CNT +
+			   EVT_LAT_HIST_HALF_CNT + 1) << shift) - 1;
+}
+
+static uint64_t
+evt_lat_hist_percentile(const struct evt_lat_hist *h, double pct)
+{
+	uint64_t rank, seen = 0;
+	unsigned int i;
+
+	if (h->count == 0)
+		return 0;
+
+	rank = RTE_MAX((uint64_t)ceil(h->count * pct / 100), UINT64_C(1));
+	for (i = 0; i < EVT_LAT_HIST_NB_BUCKETS; i++) {
+		seen += h->buckets[i];
+		if (seen >= rank)
+			return RTE_MIN(evt_lat_hist_value(i), h->max);
+	}
+
+	return h->max;
+}
+
+static void
+evt_lat_hist_print(FILE *csv, const char *test, const char *scope,
+		   const char *name, const char *sched_type,
+		   const struct evt_lat_hist *h)
+{
+	const double cycles_per_us = rte_get_timer_hz() / 1E6;
+	const double avg = h->count ? (double)h->sum / h->count : 0;
+	const double p50 = evt_lat_hist_percentile(h, 50);
+	const double p99 = evt_lat_hist_percentile(h, 99);
+	const double p999 = evt_lat_hist_percentile(h, 99.9);
+	const double max = h->max;
+
+	printf("%-10s %-8s %-4s %12"PRIu64" %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+	       scope, name, sched_type, h->count, avg / cycles_per_us,
+	       p50 / cycles_per_us, p99 / cycles_per_us,
+	       p999 / cycles_per_us, max / cycles_per_us);
+
+	if (csv == NULL)
+		return;
+
+	fprintf(csv, "%s,%s,%s,%s,%"PRIu64",%.3f,%.3f,%.3f,%.3f,%.3f\n",
+		test, scope, name, sched_type, h->count, avg / cycles_per_us,
+		p50 / cycles_per_us, p99 / cycles_per_us,
+		p999 / cycles_per_us, max / cycles_per_us);
+}
+
+int
+evt_lat_report(struct evt_options *opt, const uint8_t *sched_type_list,
+	       struct evt_lat_hist *const lat[], uint8_t nb_workers)
+{
+	const uint8_t nb_stages = opt->nb_stages;
+	struct evt_lat_hist *stages, *types;
+	char name[EVT_STR_FMT];
+	FILE *csv = NULL;
+	uint8_t i, s;
+	int ret = 0;
+
+	stages = rte_zmalloc(NULL, sizeof(struct evt_lat_hist) *
+			     (nb_stages + 1 + EVT_LAT_NB_SCHED_TYPES), 0);
+	if (stages == NULL) {
+		evt_err("failed to allocate latency histograms");
+		return -ENOMEM;
+	}
+	types = &stages[nb_stages + 1];
+
+	for (i = 0; i < nb_workers; i++) {
+		if (lat[i] == NULL)
+			continue;
+		for (s = 0; s <= nb_stages; s++)
+			evt_lat_hist_merge(&stages[s], &lat[i][s]);
+	}
+	for (s = 0; s < nb_stages; s++)
+		if (sched_type_list[s] < EVT_LAT_NB_SCHED_TYPES)
+			evt_lat_hist_merge(&types[sched_type_list[s]],
+					   &stages[s]);
+
+	if (opt->lat_csv != NULL) {
+		csv = fopen(opt->lat_csv, "w");
+		if (csv == NULL) {
+			evt_err("failed to open %s", opt->lat_csv);
+			ret = -errno;
+		} else {
+			fprintf(csv, "test,scope,name,sched_type,count,"
+				"avg_us,p50_us,p99_us,p99.9_us,max_us\n");
+		}
+	}
+
+	printf("Latency distribution (us):\n");
+	printf("%-10s %-8s %-4s %12s %10s %10s %10s %10s %10s\n", "scope",
+	       "name", "type", "count", "avg", "p50", "p99", "p99.9", "max");
+	for (s = 0; s < nb_stages; s++) {
+		/* Stages whose entry time is unknown have no samples */
+		if (stages[s].count == 0)
+			continue;
+		snprintf(name, sizeof(name), "%u", s);
+		evt_lat_hist_print(csv, opt->test_name, "stage", name,
+				   evt_sched_type_2_str(sched_type_list[s]),
+				   &stages[s]);
+	}
+	for (s = 0; s < EVT_LAT_NB_SCHED_TYPES; s++) {
+		if (types[s].count == 0)
+			continue;
+		evt_lat_hist_print(csv, opt->test_name, "sched_type",
+				   evt_sched_type_2_str(s),
+				   evt_sched_type_2_str(s), &types[s]);
+	}
+	evt_lat_hist_print(csv, opt->test_name, "total", "all", "-",
+			   &stages[nb_stages]);
+
+	if (csv != NULL)
+		fclose(csv);
+	rte_free(stages);
+
+	return ret;
+}
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef _EVT_LATENCY_
+#define _EVT_LATENCY_
+
+#include <stdint.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+
+#include "evt_common.h"
+
+/*
+ * HDR style latency histogram: values below EVT_LAT_HIST_SUB_CNT timer cycles
+ * have a bucket each, larger values are recorded with EVT_LAT_HIST_SUB_BITS
+ * significant bits, i.e. with a relative error below 1%.
+ */
+#define EVT_LAT_HIST_SUB_BITS   7
+#define EVT_LAT_HIST_SUB_CNT    (1 << EVT_LAT_HIST_SUB_BITS)
+#define EVT_LAT_HIST_HALF_CNT   (EVT_LAT_HIST_SUB_CNT >> 1)
+#define EVT_LAT_HIST_NB_BUCKETS \
+	((64 - EVT_LAT_HIST_SUB_BITS + 2) * EVT_LAT_HIST_HALF_CNT)
+
+struct evt_lat_hist {
+	uint64_t count;
+	uint64_t sum;
+	uint64_t max;
+	uint64_t buckets[EVT_LAT_HIST_NB_BUCKETS];
+};
+
+static __rte_always_inline unsigned int
+evt_lat_hist_index(uint64_t cycles)
+{
+	unsigned int shift;
+
+	if (cycles < EVT_LAT_HIST_SUB_CNT)
+		return cycles;
+
+	shift = rte_fls_u64(cycles) - EVT_LAT_HIST_SUB_BITS;
+	return shift * EVT_LAT_HIST_HALF_CNT + (cycles >> shift);
+}
+
+static __rte_always_inline void
+evt_lat_hist_record(struct evt_lat_hist *h, uint64_t cycles)
+{
+	h->buckets[evt_lat_hist_index(cycles)]++;
+	h->count++;
+	h->sum += cycles;
+	if (cycles > h->max)
+		h->max = cycles;
+}
+
+/*
+ * Allocate the histograms of a worker: one per stage, followed by the one of
+ * the latency from the first stage to the end of the pipeline.
+ */
+struct evt_lat_hist *evt_lat_hist_alloc(struct evt_options *opt);
+void evt_lat_hist_free(struct evt_lat_hist *h);
+
+/*
+ * Print the latency percentiles of all workers per stage, per scheduling type
+ * and from the first to the last stage, and write them to the CSV file given
+ * in options if any.
+ */
+int evt_lat_report(struct evt_options *opt, const uint8_t *sched_type_list,
+		   struct evt_lat_hist *const lat[], uint8_t nb_workers);
+
+#endif /* _EVT_LATENCY_ */
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <signal.h>
 
@@ -37,6 +38,58 @@ evt_options_dump_all(struct evt_test *test, struct evt_options *opts)
 		test->ops.opt_dump(opts);
 }
 
+static void
+evt_xstats_mode_dump(uint8_t dev_id, enum rte_event_dev_xstats_mode mode,
+		     uint8_t queue_port_id, const char *filter)
+{
+	struct rte_event_dev_xstats_name *names;
+	uint64_t *ids, *values;
+	int nb, i;
+
+	nb = rte_event_dev_xstats_names_get(dev_id, mode, queue_port_id,
+					    NULL, NULL, 0);
+	if (nb <= 0)
+		return;
+
+	names = calloc(nb, sizeof(*names));
+	ids = calloc(nb, sizeof(*ids));
+	values = calloc(nb, sizeof(*values));
+	if (names == NULL || ids == NULL || values == NULL)
+		goto free;
+
+	if (rte_event_dev_xstats_names_get(dev_id, mode, queue_port_id, names,
+					   ids, nb) != nb)
+		goto free;
+
+	if (rte_event_dev_xstats_get(dev_id, mode, queue_port_id, ids, values,
+				     nb) != nb)
+		goto free;
+
+	for (i = 0; i < nb; i++)
+		if (strstr(names[i].name, filter) != NULL)
+			printf("%-40s : %"PRIu64"\n", names[i].name, values[i]);
+free:
+	free(values);
+	free(ids);
+	free(names);
+}
+
+static void
+evt_xstats_dump(uint8_t dev_id, const char *filter)
+{
+	uint32_t nb_ports = 0;
+	uint32_t port;
+
+	printf("xstats matching \"%s\":\n", filter);
+	evt_xstats_mode_dump(dev_id, RTE_EVENT_DEV_XSTATS_DEVICE, 0, filter);
+
+	rte_event_dev_attr_get(dev_id, RTE_EVENT_DEV_ATTR_PORT_COUNT,
+			       &nb_ports);
+	for (port = 0; port < nb_ports; port++)
+		evt_xstats_mode_dump(dev_id, RTE_EVENT_DEV_XSTATS_PORT, port,
+				     filter);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -170,6 +223,9 @@ main(int argc, char **argv)
 	if (test->ops.test_result)
 		test->ops.test_result(test, &opt);
 
+	if (opt.xstats != NULL)
+		evt_xstats_dump(opt.dev_id, opt.xstats);
+
 	if (test->ops.ethdev_destroy)
 		test->ops.ethdev_destroy(test, &opt);
 
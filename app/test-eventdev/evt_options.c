@@ -86,6 +86,38 @@ evt_parse_fwd_latency(struct evt_options *opt, const char *arg __rte_unused)
 	return 0;
 }
 
+static int
+evt_parse_lat_hist(struct evt_options *opt, const char *arg __rte_unused)
+{
+	opt->lat_hist = 1;
+	return 0;
+}
+
+static int
+evt_parse_lat_csv(struct evt_options *opt, const char *arg)
+{
+	opt->lat_hist = 1;
+	opt->lat_csv = arg;
+	return 0;
+}
+
+static int
+evt_parse_xstats(struct evt_options *opt, const char *arg)
+{
+	opt->xstats = arg;
+	return 0;
+}
+
+static int
+evt_parse_prod_rate(struct evt_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint64(&(opt->prod_rate), arg);
+
+	return ret;
+}
+
 static int
 evt_parse_queue_priority(struct evt_options *opt, const char *arg __rte_unused)
 {
@@ -157,6 +189,13 @@ evt_parse_timer_prod_type_burst(struct evt_options *opt,
 	return 0;
 }
 
+static int
+evt_parse_timer_wheel(struct evt_options *opt, const char *arg __rte_unused)
+{
+	opt->timdev_use_wheel = 1;
+	return 0;
+}
+
 static int
 evt_parse_dma_prod_type(struct evt_options *opt,
 			   const char *arg __rte_unused)
@@ -491,6 +530,16 @@ usage(char *program)
 		"\t--nb_pkts          : number of packets to produce\n"
 		"\t--worker_deq_depth : dequeue depth of the worker\n"
 		"\t--fwd_latency      : perform fwd_latency measurement\n"
+		"\t--lat_hist         : report latency percentiles per stage\n"
+		"\t                     and per scheduling type.\n"
+		"\t--lat_csv          : write latency percentiles to the given\n"
+		"\t                     CSV file, implies lat_hist.\n"
+		"\t--prod_rate        : events per second enqueued by synthetic\n"
+		"\t                     producers at a fixed pace, 0 to enqueue\n"
+		"\t                     as fast as possible (default).\n"
+		"\t--xstats           : dump event device and port xstats\n"
+		"\t                     whose name contains the given string\n"
+		"\t                     at the end of the test.\n"
 		"\t--queue_priority   : enable queue priority\n"
 		"\t--deq_tmo_nsec     : global dequeue timeout\n"
 		"\t--prod_type_ethdev : use ethernet device as producer.\n"
@@ -507,6 +556,8 @@ usage(char *program)
 		"\t--timer_tick_nsec  : timer tick interval in ns.\n"
 		"\t--max_tmo_nsec     : max timeout interval in ns.\n"
 		"\t--expiry_nsec      : event timer expiry ns.\n"
+		"\t--timer_wheel      : use timing wheel in software event\n"
+		"\t                     timer adapter.\n"
 		"\t--dma_adptr_mode   : 1 for OP_FORWARD mode (default).\n"
 		"\t--crypto_adptr_mode : 0 for OP_NEW mode (default) and\n"
 		"\t                      1 for OP_FORWARD mode.\n"
@@ -592,6 +643,10 @@ static struct option lgopts[] = {
 	{ EVT_WKR_DEQ_DEP,         1, 0, 0 },
 	{ EVT_SCHED_TYPE_LIST,     1, 0, 0 },
 	{ EVT_FWD_LATENCY,         0, 0, 0 },
+	{ EVT_LAT_HIST,            0, 0, 0 },
+	{ EVT_LAT_CSV,             1, 0, 0 },
+	{ EVT_PROD_RATE,           1, 0, 0 },
+	{ EVT_XSTATS,              1, 0, 0 },
 	{ EVT_QUEUE_PRIORITY,      0, 0, 0 },
 	{ EVT_DEQ_TMO_NSEC,        1, 0, 0 },
 	{ EVT_PROD_ETHDEV,         0, 0, 0 },
@@ -611,6 +666,7 @@ static struct option lgopts[] = {
 	{ EVT_TIMER_TICK_NSEC,     1, 0, 0 },
 	{ EVT_MAX_TMO_NSEC,        1, 0, 0 },
 	{ EVT_EXPIRY_NSEC,         1, 0, 0 },
+	{ EVT_TIMER_WHEEL,         0, 0, 0 },
 	{ EVT_MBUF_SZ,             1, 0, 0 },
 	{ EVT_MAX_PKT_SZ,          1, 0, 0 },
 	{ EVT_PROD_ENQ_BURST_SZ,   1, 0, 0 },
@@ -644,6 +700,10 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_WKR_DEQ_DEP, evt_parse_wkr_deq_dep},
 		{ EVT_SCHED_TYPE_LIST, evt_parse_sched_type_list},
 		{ EVT_FWD_LATENCY, evt_parse_fwd_latency},
+		{ EVT_LAT_HIST, evt_parse_lat_hist},
+		{ EVT_LAT_CSV, evt_parse_lat_csv},
+		{ EVT_PROD_RATE, evt_parse_prod_rate},
+		{ EVT_XSTATS, evt_parse_xstats},
 		{ EVT_QUEUE_PRIORITY, evt_parse_queue_priority},
 		{ EVT_DEQ_TMO_NSEC, evt_parse_deq_tmo_nsec},
 		{ EVT_PROD_ETHDEV, evt_parse_eth_prod_type},
@@ -663,6 +723,7 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_TIMER_TICK_NSEC, evt_parse_timer_tick_nsec},
 		{ EVT_MAX_TMO_NSEC, evt_parse_max_tmo_nsec},
 		{ EVT_EXPIRY_NSEC, evt_parse_expiry_nsec},
+		{ EVT_TIMER_WHEEL, evt_parse_timer_wheel},
 		{ EVT_MBUF_SZ, evt_parse_mbuf_sz},
 		{ EVT_MAX_PKT_SZ, evt_parse_max_pkt_sz},
 		{ EVT_PROD_ENQ_BURST_SZ, evt_parse_prod_enq_burst_sz},
@@ -731,6 +792,8 @@ evt_options_dump(struct evt_options *opt)
 	evt_dump_end;
 	evt_dump_nb_flows(opt);
 	evt_dump_worker_dequeue_depth(opt);
+	if (opt->xstats != NULL)
+		evt_dump("xstats", "%s", opt->xstats);
 	if (opt->ena_vector || opt->prod_type == EVT_PROD_TYPE_EVENT_VECTOR_ADPTR) {
 		evt_dump("vector_sz", "%d", opt->vector_size);
 		evt_dump("vector_tmo_ns", "%"PRIu64, opt->vector_tmo_nsec);
@@ -31,6 +31,10 @@
 #define EVT_NB_STAGES            ("nb_stages")
 #define EVT_SCHED_TYPE_LIST      ("stlist")
 #define EVT_FWD_LATENCY          ("fwd_latency")
+#define EVT_LAT_HIST             ("lat_hist")
+#define EVT_LAT_CSV              ("lat_csv")
+#define EVT_PROD_RATE            ("prod_rate")
+#define EVT_XSTATS               ("xstats")
 #define EVT_QUEUE_PRIORITY       ("queue_priority")
 #define EVT_DEQ_TMO_NSEC         ("deq_tmo_nsec")
 #define EVT_PROD_ETHDEV          ("prod_type_ethdev")
@@ -50,6 +54,7 @@
 #define EVT_TIMER_TICK_NSEC      ("timer_tick_nsec")
 #define EVT_MAX_TMO_NSEC         ("max_tmo_nsec")
 #define EVT_EXPIRY_NSEC          ("expiry_nsec")
+#define EVT_TIMER_WHEEL          ("timer_wheel")
 #define EVT_MBUF_SZ              ("mbuf_sz")
 #define EVT_MAX_PKT_SZ           ("max_pkt_sz")
 #define EVT_PROD_ENQ_BURST_SZ    ("prod_enq_burst_sz")
@@ -219,6 +224,14 @@ evt_dump_fwd_latency(struct evt_options *opt)
 	evt_dump("fwd_latency", "%s", EVT_BOOL_FMT(opt->fwd_latency));
 }
 
+static inline void
+evt_dump_lat_hist(struct evt_options *opt)
+{
+	evt_dump("lat_hist", "%s", EVT_BOOL_FMT(opt->lat_hist));
+	if (opt->lat_csv != NULL)
+		evt_dump("lat_csv", "%s", opt->lat_csv);
+}
+
 static inline void
 evt_dump_queue_priority(struct evt_options *opt)
 {
@@ -298,6 +311,8 @@ evt_dump_producer_type(struct evt_options *opt)
 		evt_dump("nb_timer_adapters", "%d", opt->nb_timer_adptrs);
 		evt_dump("max_tmo_nsec", "%"PRIu64"", opt->max_tmo_nsec);
 		evt_dump("expiry_nsec", "%"PRIu64"", opt->expiry_nsec);
+		evt_dump("timer_wheel", "%s",
+				opt->timdev_use_wheel ? "true" : "false");
 		if (opt->optm_timer_tick_nsec)
 			evt_dump("optm_timer_tick_nsec", "%"PRIu64"",
 					opt->optm_timer_tick_nsec);
@@ -57,7 +57,9 @@ perf_atq_worker(void *arg, const int enable_fwd_latency)
 		}
 
 		stage = ev.sub_event_type % nb_stages;
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency)
+			perf_stage_latency(w, &ev, stage);
+		if (enable_fwd_latency && !prod_tstamp && stage == 0)
 			/* first stage in pipeline, mark ts to compute fwd latency */
 			perf_mark_fwd_latency(prod_type, &ev);
 
@@ -109,7 +111,9 @@ perf_atq_worker_burst(void *arg, const int enable_fwd_latency)
 			}
 
 			stage = ev[i].sub_event_type % nb_stages;
-			if (enable_fwd_latency && !prod_timer_type && stage == 0) {
+			if (enable_fwd_latency)
+				perf_stage_latency(w, &ev[i], stage);
+			if (enable_fwd_latency && !prod_tstamp && stage == 0) {
 				rte_prefetch0(ev[i+1].event_ptr);
 				/* first stage in pipeline.
 				 * mark time stamp to compute fwd latency
@@ -166,7 +170,7 @@ perf_atq_worker_crypto_vector(void *arg, const int enable_fwd_latency)
 
 		stage = ev.sub_event_type % nb_stages;
 		/* First q in pipeline, mark timestamp to compute fwd latency */
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency && !prod_tstamp && stage == 0)
 			pe->timestamp = rte_get_timer_cycles();
 
 		/* Last stage in pipeline */
@@ -197,7 +201,7 @@ perf_atq_worker_vector(void *arg, const int enable_fwd_latency)
 	RTE_SET_USED(pe);
 	RTE_SET_USED(cnt);
 	RTE_SET_USED(prod_type);
-	RTE_SET_USED(prod_timer_type);
+	RTE_SET_USED(prod_tstamp);
 
 	while (t->done == false) {
 		deq = rte_event_dequeue_burst(dev, port, &ev, 1, 0);
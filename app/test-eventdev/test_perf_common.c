@@ -104,6 +104,16 @@ perf_test_result(struct evt_test *test, struct evt_options *opt)
 	struct test_perf *t = evt_test_priv(test);
 	uint8_t is_vec;
 
+	if (opt->lat_hist) {
+		struct evt_lat_hist *lat[EVT_MAX_PORTS];
+
+		for (i = 0; i < t->nb_workers; i++)
+			lat[i] = t->worker[i].lat;
+		if (evt_lat_report(opt, t->sched_type_list, lat,
+				   t->nb_workers) < 0)
+			t->result = EVT_TEST_FAILED;
+	}
+
 	printf("Packet distribution across worker cores :\n");
 	is_vec = (opt->prod_type == EVT_PROD_TYPE_EVENT_VECTOR_ADPTR);
 	for (i = 0; i < t->nb_workers; i++)
@@ -157,16 +167,21 @@ perf_producer(void *arg)
 		for (i = 0; i < BURST_SIZE; i++) {
 			ev.flow_id = flow_counter++ % nb_flows;
 			ev.event_ptr = m[i];
-			if (enable_fwd_latency)
+			if (enable_fwd_latency) {
 				m[i]->timestamp = rte_get_timer_cycles();
+				m[i]->stage_timestamp = m[i]->timestamp;
+			}
 			while (rte_event_enqueue_new_burst(dev_id, port, &ev,
 							   1) != 1) {
 				if (t->done)
 					break;
 				rte_pause();
-				if (enable_fwd_latency)
+				if (enable_fwd_latency) {
 					m[i]->timestamp =
 						rte_get_timer_cycles();
+					m[i]->stage_timestamp =
+						m[i]->timestamp;
+				}
 			}
 		}
 		count += BURST_SIZE;
@@ -218,8 +233,10 @@ perf_producer_burst(void *arg)
 		for (i = 0; i < burst_size; i++) {
 			ev[i].flow_id = flow_counter++ % nb_flows;
 			ev[i].event_ptr = m[i];
-			if (enable_fwd_latency)
+			if (enable_fwd_latency) {
 				m[i]->timestamp = timestamp;
+				m[i]->stage_timestamp = timestamp;
+			}
 		}
 		enq = rte_event_enqueue_new_burst(dev_id, port, ev, burst_size);
 		while (enq < burst_size) {
@@ -230,8 +247,10 @@ perf_producer_burst(void *arg)
 			rte_pause();
 			if (enable_fwd_latency) {
 				timestamp = rte_get_timer_cycles();
-				for (i = enq; i < burst_size; i++)
+				for (i = enq; i < burst_size; i++) {
 					m[i]->timestamp = timestamp;
+					m[i]->stage_timestamp = timestamp;
+				}
 			}
 		}
 		count += burst_size;
@@ -239,6 +258,87 @@ perf_producer_burst(void *arg)
 	return 0;
 }
 
+/*
+ * Open loop synthetic producer: events are enqueued at the pace given by
+ * prod_rate whatever the progress of the workers, and stamped with the time
+ * they were due so that the latency of events held behind a stall is not
+ * hidden.
+ */
+static inline int
+perf_producer_paced(void *arg)
+{
+	uint32_t i;
+	struct prod_data *p  = arg;
+	struct test_perf *t = p->t;
+	struct evt_options *opt = t->opt;
+	const uint8_t dev_id = p->dev_id;
+	const uint8_t port = p->port_id;
+	struct rte_mempool *pool = t->pool;
+	const uint64_t nb_pkts = t->nb_pkts;
+	const uint32_t nb_flows = t->nb_flows;
+	const uint32_t burst_size = RTE_MIN(opt->prod_enq_burst_sz,
+					    (uint32_t)MAX_PROD_ENQ_BURST_SIZE);
+	/* The offered load is shared evenly by the producers */
+	const double cycles_per_ev = (double)rte_get_timer_hz() *
+		evt_nr_active_lcores(opt->plcores) / opt->prod_rate;
+	struct perf_elt *m[MAX_PROD_ENQ_BURST_SIZE];
+	struct rte_event ev[MAX_PROD_ENQ_BURST_SIZE];
+	uint32_t flow_counter = 0;
+	uint64_t count = 0;
+	uint64_t now, due;
+	uint32_t nb, enq;
+	double next;
+
+	if (opt->verbose_level > 1)
+		printf("%s(): lcore %d dev_id %d port=%d queue %d rate %"PRIu64"\n",
+				__func__, rte_lcore_id(), dev_id, port,
+				p->queue_id, opt->prod_rate);
+
+	for (i = 0; i < burst_size; i++) {
+		ev[i].event = 0;
+		ev[i].op = RTE_EVENT_OP_NEW;
+		ev[i].queue_id = p->queue_id;
+		ev[i].sched_type = t->opt->sched_type_list[0];
+		ev[i].priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+		ev[i].event_type =  RTE_EVENT_TYPE_CPU;
+		ev[i].sub_event_type = 0; /* stage 0 */
+	}
+
+	next = rte_get_timer_cycles();
+	while (count < nb_pkts && t->done == false) {
+		now = rte_get_timer_cycles();
+		if (now < (uint64_t)next) {
+			rte_pause();
+			continue;
+		}
+
+		/* Catch up with the events due, a burst at a time */
+		nb = RTE_MIN((uint64_t)((now - next) / cycles_per_ev) + 1,
+			     (uint64_t)burst_size);
+		if (rte_mempool_get_bulk(pool, (void **)m, nb) < 0)
+			continue;
+
+		for (i = 0; i < nb; i++) {
+			due = (uint64_t)(next + i * cycles_per_ev);
+			ev[i].flow_id = flow_counter++ % nb_flows;
+			ev[i].event_ptr = m[i];
+			m[i]->timestamp = due;
+			m[i]->stage_timestamp = due;
+		}
+		next += nb * cycles_per_ev;
+
+		enq = rte_event_enqueue_new_burst(dev_id, port, ev, nb);
+		while (enq < nb && !t->done) {
+			rte_pause();
+			enq += rte_event_enqueue_new_burst(dev_id, port,
+							   ev + enq, nb - enq);
+		}
+		count += nb;
+	}
+
+	return 0;
+}
+
 static inline int
 perf_event_timer_producer(void *arg)
 {
@@ -933,10 +1033,13 @@ perf_producer_wrapper(void *arg)
 				dev_info.max_event_port_enqueue_depth;
 	}
 
-	/* In case of synthetic producer, launch perf_producer or
-	 * perf_producer_burst depending on producer enqueue burst size
+	/* In case of synthetic producer, launch perf_producer_paced when
+	 * producers are paced, otherwise perf_producer or perf_producer_burst
+	 * depending on producer enqueue burst size
 	 */
-	if (t->opt->prod_type == EVT_PROD_TYPE_SYNT &&
+	if (t->opt->prod_type == EVT_PROD_TYPE_SYNT && t->opt->prod_rate)
+		return perf_producer_paced(arg);
+	else if (t->opt->prod_type == EVT_PROD_TYPE_SYNT &&
 			t->opt->prod_enq_burst_sz == 1)
 		return perf_producer(arg);
 	else if (t->opt->prod_type == EVT_PROD_TYPE_SYNT &&
@@ -1193,6 +1296,8 @@ perf_event_timer_adapter_setup(struct test_perf *t)
 
 	if (nb_producers == 1)
 		flags |= RTE_EVENT_TIMER_ADAPTER_F_SP_PUT;
+	if (t->opt->timdev_use_wheel)
+		flags |= RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
 
 	for (i = 0; i < t->opt->nb_timer_adptrs; i++) {
 		struct rte_event_timer_adapter_conf config = {
@@ -1451,6 +1556,14 @@ perf_event_dev_port_setup(struct evt_test *test, struct evt_options *opt,
 		w->t = t;
 		w->processed_pkts = 0;
 		w->latency = 0;
+		if (opt->lat_hist) {
+			w->lat = evt_lat_hist_alloc(opt);
+			if (w->lat == NULL) {
+				evt_err("failed to allocate latency histograms");
+				return -ENOMEM;
+			}
+			w->lat_total = &w->lat[opt->nb_stages];
+		}
 
 		struct rte_event_port_conf conf = *port_conf;
 		conf.event_port_cfg |= RTE_EVENT_PORT_CFG_HINT_WORKER;
@@ -1782,12 +1895,28 @@ perf_opt_check(struct evt_options *opt, uint64_t nb_queues)
 		return -1;
 	}
 
+	if (opt->prod_rate && opt->prod_type != EVT_PROD_TYPE_SYNT) {
+		evt_err("prod_rate is valid with synthetic producers only");
+		return -1;
+	}
+
 	/* Fixups */
+	if (opt->lat_hist && opt->prod_type != EVT_PROD_TYPE_SYNT) {
+		evt_info("lat_hist is valid with synthetic producers only, disabling");
+		opt->lat_hist = 0;
+	}
+
+	if (opt->lat_hist && !opt->fwd_latency) {
+		evt_info("enabled fwd_latency for latency histograms");
+		opt->fwd_latency = 1;
+	}
+
 	if ((opt->nb_stages == 1 &&
-			opt->prod_type != EVT_PROD_TYPE_EVENT_TIMER_ADPTR) &&
-			opt->fwd_latency) {
+			opt->prod_type != EVT_PROD_TYPE_EVENT_TIMER_ADPTR &&
+			!opt->prod_rate) && opt->fwd_latency) {
 		evt_info("fwd_latency is valid when nb_stages > 1, disabling");
 		opt->fwd_latency = 0;
+		opt->lat_hist = 0;
 	}
 
 	if (opt->fwd_latency && !opt->q_priority) {
@@ -1814,6 +1943,9 @@ perf_opt_dump(struct evt_options *opt, uint8_t nb_queues)
 	evt_dump_sched_type_list(opt);
 	evt_dump_producer_type(opt);
 	evt_dump("prod_enq_burst_sz", "%d", opt->prod_enq_burst_sz);
+	if (opt->prod_rate)
+		evt_dump("prod_rate", "%"PRIu64, opt->prod_rate);
+	evt_dump_lat_hist(opt);
 }
 
 static void
@@ -2325,7 +2457,12 @@ perf_test_setup(struct evt_test *test, struct evt_options *opt)
 void
 perf_test_destroy(struct evt_test *test, struct evt_options *opt)
 {
+	struct test_perf *t = evt_test_priv(test);
+	int i;
+
 	RTE_SET_USED(opt);
 
+	for (i = 0; i < t->nb_workers; i++)
+		evt_lat_hist_free(t->worker[i].lat);
 	rte_free(test->test_priv);
 }
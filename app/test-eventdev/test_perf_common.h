@@ -24,6 +24,7 @@
 #include <rte_prefetch.h>
 
 #include "evt_common.h"
+#include "evt_latency.h"
 #include "evt_options.h"
 #include "evt_test.h"
 
@@ -36,6 +37,10 @@ struct __rte_cache_aligned worker_data {
 	uint64_t processed_pkts;
 	uint64_t processed_vecs;
 	uint64_t latency;
+	/* Per stage latency histograms, when enabled */
+	struct evt_lat_hist *lat;
+	/* Forward latency histogram, after the ones of the stages */
+	struct evt_lat_hist *lat_total;
 	uint8_t dev_id;
 	uint8_t port_id;
 	struct test_perf *t;
@@ -95,6 +100,8 @@ struct __rte_cache_aligned perf_elt {
 		struct {
 			char pad[offsetof(struct rte_event_timer, user_meta)];
 			uint64_t timestamp;
+			/* Time the event was enqueued to its current stage */
+			uint64_t stage_timestamp;
 		};
 	};
 };
@@ -108,8 +115,10 @@ struct __rte_cache_aligned perf_elt {
 	struct evt_options *opt = t->opt;\
 	const uint8_t dev = w->dev_id;\
 	const uint8_t port = w->port_id;\
-	const uint8_t prod_timer_type = \
-		opt->prod_type == EVT_PROD_TYPE_EVENT_TIMER_ADPTR;\
+	/* Timer and paced producers stamp events with their due time */\
+	const uint8_t prod_tstamp = \
+		opt->prod_type == EVT_PROD_TYPE_EVENT_TIMER_ADPTR ||\
+		opt->prod_rate != 0;\
 	uint8_t *const sched_type_list = &t->sched_type_list[0];\
 	const enum evt_prod_type prod_type = opt->prod_type;\
 	struct rte_mempool *const pool = t->pool;\
@@ -155,6 +164,22 @@ perf_mark_fwd_latency(enum evt_prod_type prod_type, struct rte_event *const ev)
 	}
 }
 
+/* Record the time an event of a synthetic producer took to reach a stage */
+static __rte_always_inline void
+perf_stage_latency(struct worker_data *const w, struct rte_event *const ev,
+		   const uint8_t stage)
+{
+	struct perf_elt *pe = ev->event_ptr;
+	uint64_t now;
+
+	if (w->lat == NULL)
+		return;
+
+	now = rte_get_timer_cycles();
+	evt_lat_hist_record(&w->lat[stage], now - pe->stage_timestamp);
+	pe->stage_timestamp = now;
+}
+
 static __rte_always_inline int
 perf_handle_crypto_ev(struct rte_event *ev)
 {
@@ -316,6 +341,8 @@ perf_process_last_stage_latency(struct rte_mempool *const pool, enum evt_prod_ty
 
 	latency = rte_get_timer_cycles() - tstamp;
 	w->latency += latency;
+	if (w->lat_total != NULL)
+		evt_lat_hist_record(w->lat_total, latency);
 
 	bufs[count++] = to_free_in_bulk;
 	if (unlikely(count == buf_sz)) {
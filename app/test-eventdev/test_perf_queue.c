@@ -60,7 +60,9 @@ perf_queue_worker(void *arg, const int enable_fwd_latency)
 		}
 
 		stage = ev.queue_id % nb_stages;
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency)
+			perf_stage_latency(w, &ev, stage);
+		if (enable_fwd_latency && !prod_tstamp && stage == 0)
 			/* first q in pipeline, mark timestamp to compute fwd latency */
 			perf_mark_fwd_latency(prod_type, &ev);
 
@@ -111,7 +113,9 @@ perf_queue_worker_burst(void *arg, const int enable_fwd_latency)
 			}
 
 			stage = ev[i].queue_id % nb_stages;
-			if (enable_fwd_latency && !prod_timer_type && stage == 0) {
+			if (enable_fwd_latency)
+				perf_stage_latency(w, &ev[i], stage);
+			if (enable_fwd_latency && !prod_tstamp && stage == 0) {
 				rte_prefetch0(ev[i+1].event_ptr);
 				/* first queue in pipeline.
 				 * mark time stamp to compute fwd latency
@@ -168,7 +172,7 @@ perf_queue_worker_crypto_vector(void *arg, const int enable_fwd_latency)
 
 		stage = ev.queue_id % nb_stages;
 		/* First q in pipeline, mark timestamp to compute fwd latency */
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency && !prod_tstamp && stage == 0)
 			pe->timestamp = rte_get_timer_cycles();
 
 		/* Last stage in pipeline */
@@ -199,7 +203,7 @@ perf_queue_worker_vector(void *arg, const int enable_fwd_latency)
 	RTE_SET_USED(sz);
 	RTE_SET_USED(cnt);
 	RTE_SET_USED(prod_type);
-	RTE_SET_USED(prod_timer_type);
+	RTE_SET_USED(prod_tstamp);
 
 	while (t->done == false) {
 		deq = rte_event_dequeue_burst(dev, port, &ev, 1, 0);
@@ -247,8 +247,10 @@ pipeline_atq_worker_multi_stage_tx(void *arg)
 		}
 
 		cq_id = ev.sub_event_type % nb_stages;
+		pipeline_stage_latency(w, ev.mbuf, cq_id);
 
 		if (cq_id == last_queue) {
+			pipeline_fwd_latency(w, ev.mbuf);
 			enq = pipeline_event_tx(dev, port, &ev, t);
 			w->processed_pkts++;
 			continue;
@@ -279,8 +281,10 @@ pipeline_atq_worker_multi_stage_fwd(void *arg)
 		}
 
 		cq_id = ev.sub_event_type % nb_stages;
+		pipeline_stage_latency(w, ev.mbuf, cq_id);
 
 		if (cq_id == last_queue) {
+			pipeline_fwd_latency(w, ev.mbuf);
 			ev.queue_id = tx_queue[ev.mbuf->port];
 			pipeline_fwd_event(&ev, RTE_SCHED_TYPE_ATOMIC);
 			w->processed_pkts++;
@@ -313,8 +317,10 @@ pipeline_atq_worker_multi_stage_burst_tx(void *arg)
 		for (i = 0; i < nb_rx; i++) {
 			rte_prefetch0(ev[i + 1].mbuf);
 			cq_id = ev[i].sub_event_type % nb_stages;
+			pipeline_stage_latency(w, ev[i].mbuf, cq_id);
 
 			if (cq_id == last_queue) {
+				pipeline_fwd_latency(w, ev[i].mbuf);
 				pipeline_event_tx(dev, port, &ev[i], t);
 				ev[i].op = RTE_EVENT_OP_RELEASE;
 				w->processed_pkts++;
@@ -350,8 +356,10 @@ pipeline_atq_worker_multi_stage_burst_fwd(void *arg)
 		for (i = 0; i < nb_rx; i++) {
 			rte_prefetch0(ev[i + 1].mbuf);
 			cq_id = ev[i].sub_event_type % nb_stages;
+			pipeline_stage_latency(w, ev[i].mbuf, cq_id);
 
 			if (cq_id == last_queue) {
+				pipeline_fwd_latency(w, ev[i].mbuf);
 				w->processed_pkts++;
 				ev[i].queue_id = tx_queue[ev[i].mbuf->port];
 				pipeline_fwd_event(&ev[i],
@@ -12,6 +12,16 @@ pipeline_test_result(struct evt_test *test, struct evt_options *opt)
 	uint64_t total = 0;
 	struct test_pipeline *t = evt_test_priv(test);
 
+	if (opt->lat_hist) {
+		struct evt_lat_hist *lat[EVT_MAX_PORTS];
+
+		for (i = 0; i < t->nb_workers; i++)
+			lat[i] = t->worker[i].lat;
+		if (evt_lat_report(opt, t->sched_type_list, lat,
+				   t->nb_workers) < 0)
+			t->result = EVT_TEST_FAILED;
+	}
+
 	evt_info("Packet distribution across worker cores :");
 	for (i = 0; i < t->nb_workers; i++)
 		total += t->worker[i].processed_pkts;
@@ -41,6 +51,7 @@ pipeline_opt_dump(struct evt_options *opt, uint8_t nb_queues)
 		evt_dump("vector_size", "%d", opt->vector_size);
 		evt_dump("vector_tmo_ns", "%" PRIu64 "", opt->vector_tmo_nsec);
 	}
+	evt_dump_lat_hist(opt);
 }
 
 static inline uint64_t
@@ -298,6 +309,17 @@ pipeline_opt_check(struct evt_options *opt, uint64_t nb_queues)
 	if (evt_has_invalid_sched_type(opt))
 		return -1;
 
+	if (opt->prod_rate) {
+		evt_err("prod_rate is not supported, packets come from ethdev");
+		return -1;
+	}
+
+	/* Fixups */
+	if (opt->lat_hist && (opt->nb_stages == 1 || opt->ena_vector)) {
+		evt_info("lat_hist is valid with nb_stages > 1 and without event vector, disabling");
+		opt->lat_hist = 0;
+	}
+
 	return 0;
 }
 
@@ -441,6 +463,14 @@ pipeline_event_port_setup(struct evt_test *test, struct evt_options *opt,
 		w->port_id = port;
 		w->t = t;
 		w->processed_pkts = 0;
+		if (opt->lat_hist) {
+			w->lat = evt_lat_hist_alloc(opt);
+			if (w->lat == NULL) {
+				evt_err("failed to allocate latency histograms");
+				return -ENOMEM;
+			}
+			w->lat_total = &w->lat[opt->nb_stages];
+		}
 
 		ret = rte_event_port_setup(opt->dev_id, port, &p_conf);
 		if (ret) {
@@ -839,6 +869,22 @@ pipeline_test_setup(struct evt_test *test, struct evt_options *opt)
 	opt->prod_type = EVT_PROD_TYPE_ETH_RX_ADPTR;
 	memcpy(t->sched_type_list, opt->sched_type_list,
 			sizeof(opt->sched_type_list));
+
+	if (opt->lat_hist) {
+		static const struct rte_mbuf_dynfield lat_dynfield_desc = {
+			.name = "test_eventdev_lat_tstamp",
+			.size = sizeof(struct pipeline_lat_tstamp),
+			.align = alignof(struct pipeline_lat_tstamp),
+		};
+
+		t->lat_offset = rte_mbuf_dynfield_register(&lat_dynfield_desc);
+		if (t->lat_offset < 0) {
+			evt_err("failed to register latency mbuf field");
+			rte_free(test_pipeline);
+			test->test_priv = NULL;
+			return -rte_errno;
+		}
+	}
 	return 0;
 nomem:
 	return -ENOMEM;
@@ -847,7 +893,12 @@ pipeline_test_setup(struct evt_test *test, struct evt_options *opt)
 void
 pipeline_test_destroy(struct evt_test *test, struct evt_options *opt)
 {
+	struct test_pipeline *t = evt_test_priv(test);
+	int i;
+
 	RTE_SET_USED(opt);
 
+	for (i = 0; i < t->nb_workers; i++)
+		evt_lat_hist_free(t->worker[i].lat);
 	rte_free(test->test_priv);
 }
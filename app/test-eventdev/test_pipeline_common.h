@@ -17,6 +17,7 @@
 #include <rte_eventdev.h>
 #include <rte_lcore.h>
 #include <rte_malloc.h>
+#include <rte_mbuf_dyn.h>
 #include <rte_mempool.h>
 #include <rte_prefetch.h>
 #include <rte_service.h>
@@ -25,6 +26,7 @@
 #include <rte_udp.h>
 
 #include "evt_common.h"
+#include "evt_latency.h"
 #include "evt_options.h"
 #include "evt_test.h"
 
@@ -32,11 +34,23 @@ struct test_pipeline;
 
 struct __rte_cache_aligned worker_data {
 	uint64_t processed_pkts;
+	/* Per stage latency histograms, when enabled */
+	struct evt_lat_hist *lat;
+	/* Forward latency histogram, after the ones of the stages */
+	struct evt_lat_hist *lat_total;
 	uint8_t dev_id;
 	uint8_t port_id;
 	struct test_pipeline *t;
 };
 
+/* Timestamps of a packet, in a mbuf dynamic field */
+struct pipeline_lat_tstamp {
+	/* Time the packet was dequeued at the first stage */
+	uint64_t first;
+	/* Time the packet was enqueued to its current stage */
+	uint64_t stage;
+};
+
 struct __rte_cache_aligned test_pipeline {
 	/* Don't change the offset of "done". Signal handler use this memory
 	 * to terminate all lcores work.
@@ -44,6 +58,8 @@ struct __rte_cache_aligned test_pipeline {
 	int done;
 	uint8_t nb_workers;
 	uint8_t internal_port;
+	/* Offset of the pipeline_lat_tstamp mbuf dynamic field */
+	int lat_offset;
 	uint8_t tx_evqueue_id[RTE_MAX_ETHPORTS];
 	enum evt_test_result result;
 	uint32_t nb_flows;
@@ -110,6 +126,45 @@ pipeline_fwd_event_vector(struct rte_event *ev, uint8_t sched)
 	ev->sched_type = sched;
 }
 
+static __rte_always_inline struct pipeline_lat_tstamp *
+pipeline_lat_tstamp(struct test_pipeline *t, struct rte_mbuf *m)
+{
+	return RTE_MBUF_DYNFIELD(m, t->lat_offset, struct pipeline_lat_tstamp *);
+}
+
+/* Record the time a packet took to reach a stage, when latency histograms
+ * are enabled. The first stage marks the packet.
+ */
+static __rte_always_inline void
+pipeline_stage_latency(struct worker_data *const w, struct rte_mbuf *m,
+		       const uint8_t stage)
+{
+	struct pipeline_lat_tstamp *ts;
+	uint64_t now;
+
+	if (w->lat == NULL)
+		return;
+
+	ts = pipeline_lat_tstamp(w->t, m);
+	now = rte_get_timer_cycles();
+	if (stage == 0)
+		ts->first = now;
+	else
+		evt_lat_hist_record(&w->lat[stage], now - ts->stage);
+	ts->stage = now;
+}
+
+/* Record the time a packet took from the first stage to transmission */
+static __rte_always_inline void
+pipeline_fwd_latency(struct worker_data *const w, struct rte_mbuf *m)
+{
+	if (w->lat_total == NULL)
+		return;
+
+	evt_lat_hist_record(w->lat_total, rte_get_timer_cycles() -
+			    pipeline_lat_tstamp(w->t, m)->first);
+}
+
 static __rte_always_inline uint8_t
 pipeline_event_tx(const uint8_t dev, const uint8_t port,
 		  struct rte_event *const ev, struct test_pipeline *t)
@@ -279,12 +279,14 @@ pipeline_queue_worker_multi_stage_tx(void *arg)
 		cq_id = ev.queue_id % nb_stages;
 
 		if (ev.queue_id == tx_queue[ev.mbuf->port]) {
+			pipeline_fwd_latency(w, ev.mbuf);
 			enq = pipeline_event_tx(dev, port, &ev, t);
 			ev.op = RTE_EVENT_OP_RELEASE;
 			w->processed_pkts++;
 			continue;
 		}
 
+		pipeline_stage_latency(w, ev.mbuf, cq_id);
 		ev.queue_id++;
 		pipeline_fwd_event(&ev, cq_id != last_queue ?
 				sched_type_list[cq_id] :
@@ -312,8 +314,10 @@ pipeline_queue_worker_multi_stage_fwd(void *arg)
 		}
 
 		cq_id = ev.queue_id % nb_stages;
+		pipeline_stage_latency(w, ev.mbuf, cq_id);
 
 		if (cq_id == last_queue) {
+			pipeline_fwd_latency(w, ev.mbuf);
 			ev.queue_id = tx_queue[ev.mbuf->port];
 			rte_event_eth_tx_adapter_txq_set(ev.mbuf, 0);
 			pipeline_fwd_event(&ev, RTE_SCHED_TYPE_ATOMIC);
@@ -350,12 +354,14 @@ pipeline_queue_worker_multi_stage_burst_tx(void *arg)
 			cq_id = ev[i].queue_id % nb_stages;
 
 			if (ev[i].queue_id == tx_queue[ev[i].mbuf->port]) {
+				pipeline_fwd_latency(w, ev[i].mbuf);
 				pipeline_event_tx(dev, port, &ev[i], t);
 				ev[i].op = RTE_EVENT_OP_RELEASE;
 				w->processed_pkts++;
 				continue;
 			}
 
+			pipeline_stage_latency(w, ev[i].mbuf, cq_id);
 			ev[i].queue_id++;
 			pipeline_fwd_event(&ev[i], cq_id != last_queue ?
 					sched_type_list[cq_id] :
@@ -387,8 +393,10 @@ pipeline_queue_worker_multi_stage_burst_fwd(void *arg)
 		for (i = 0; i < nb_rx; i++) {
 			rte_prefetch0(ev[i + 1].mbuf);
 			cq_id = ev[i].queue_id % nb_stages;
+			pipeline_stage_latency(w, ev[i].mbuf, cq_id);
 
 			if (cq_id == last_queue) {
+				pipeline_fwd_latency(w, ev[i].mbuf);
 				ev[i].queue_id = tx_queue[ev[i].mbuf->port];
 				rte_event_eth_tx_adapter_txq_set(ev[i].mbuf, 0);
 				pipeline_fwd_event(&ev[i],
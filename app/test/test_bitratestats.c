@@ -148,6 +148,72 @@ test_stats_bitrate_calc(void)
 	return TEST_SUCCESS;
 }
 
+/* To test the per queue rate registration */
+static int
+test_stats_bitrate_queue_reg(void)
+{
+	int ret;
+
+	ret = rte_stats_bitrate_queue_reg(NULL, 1);
+	TEST_ASSERT(ret < 0, "Test Failed: rte_stats_bitrate_queue_reg "
+			"succeeded with invalid bit rate data");
+
+	ret = rte_stats_bitrate_queue_reg(bitrate_data,
+			RTE_STATS_BITRATE_MAX_QUEUES + 1);
+	TEST_ASSERT(ret < 0, "Test Failed: rte_stats_bitrate_queue_reg "
+			"succeeded with too many queues");
+
+	ret = rte_stats_bitrate_queue_reg(bitrate_data, 1);
+	TEST_ASSERT(ret >= 0, "Test Failed: rte_stats_bitrate_queue_reg %d", ret);
+
+	return TEST_SUCCESS;
+}
+
+static int test_bit_packet_forward(void);
+
+/* To test the per queue rates after forwarding packets */
+static int
+test_stats_bitrate_queue_calc(void)
+{
+	struct rte_metric_value values[RTE_METRICS_MAX_METRICS];
+	struct rte_metric_name names[RTE_METRICS_MAX_METRICS];
+	int ret, nb, i;
+	bool found = false;
+
+	ret = rte_stats_bitrate_queue_calc(NULL, portid);
+	TEST_ASSERT(ret < 0, "Test Failed: rte_stats_bitrate_queue_calc "
+			"succeeded with invalid bit rate data");
+
+	ret = rte_stats_bitrate_queue_calc(bitrate_data, 31);
+	TEST_ASSERT(ret == -ENODEV, "Test Failed: Expected -%d for "
+			"non-existing portid rte_stats_bitrate_queue_calc ret:%d",
+			ENODEV, ret);
+
+	/* First call records the counters */
+	ret = rte_stats_bitrate_queue_calc(bitrate_data, portid);
+	TEST_ASSERT(ret >= 0, "Test Failed: rte_stats_bitrate_queue_calc %d", ret);
+
+	TEST_ASSERT_SUCCESS(test_bit_packet_forward(), "Packet forwarding failed");
+
+	ret = rte_stats_bitrate_queue_calc(bitrate_data, portid);
+	TEST_ASSERT(ret >= 0, "Test Failed: rte_stats_bitrate_queue_calc %d", ret);
+
+	nb = rte_metrics_get_names(names, RTE_DIM(names));
+	TEST_ASSERT(nb > 0 && nb <= (int)RTE_DIM(names), "Cannot get metrics names");
+	ret = rte_metrics_get_values(portid, values, RTE_DIM(values));
+	TEST_ASSERT(ret == nb, "Cannot get metrics values");
+
+	for (i = 0; i < nb; i++) {
+		if (strcmp(names[values[i].key].name, "rx_q0_packets_peak") == 0) {
+			TEST_ASSERT(values[i].value > 0, "No Rx packet rate");
+			found = true;
+		}
+	}
+	TEST_ASSERT(found, "rx_q0_packets_peak metric not found");
+
+	return TEST_SUCCESS;
+}
+
 static int
 test_bit_packet_forward(void)
 {
@@ -238,7 +304,16 @@ unit_test_suite bitratestats_testsuite  = {
 		 */
 		TEST_CASE_ST(test_bit_packet_forward, NULL,
 				test_stats_bitrate_calc),
-		/* TEST CASE 9: Test to do the cleanup w.r.t create */
+
+		/* TEST CASE 9: Test to register per queue rate metrics */
+		TEST_CASE(test_stats_bitrate_queue_reg),
+
+		/* TEST CASE 10: Test to calculate per queue rate metrics
+		 * before and after forwarding packets
+		 */
+		TEST_CASE(test_stats_bitrate_queue_calc),
+
+		/* TEST CASE 11: Test to do the cleanup w.r.t create */
 		TEST_CASE(test_stats_bitrate_free),
 		TEST_CASES_END()
 	}
@@ -0,0 +1,334 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_dispatcher.h>
+#include <rte_eventdev.h>
+#include <rte_lcore.h>
+#include <rte_mempool.h>
+#include <rte_service.h>
+
+#include "test.h"
+
+#define DSW_VDEV "event_dsw0"
+
+#define NUM_HANDLERS 4
+#define NUM_FLOWS 64
+#define BURST_SIZE 32
+#define VEC_SIZE 16
+#define NUM_BURSTS (1 << 15)
+#define MAX_EVENTS 4096
+
+struct perf_handler {
+	uint32_t id;
+	int reg_id;
+	uint64_t events;
+	uint64_t calls;
+};
+
+struct perf_app {
+	uint8_t event_dev_id;
+	uint8_t port_id;
+	struct rte_dispatcher *dispatcher;
+	uint32_t service_id;
+	struct rte_mempool *vec_pool;
+	struct perf_handler handlers[NUM_HANDLERS];
+	uint64_t total_events;
+};
+
+static struct perf_app app;
+
+static bool
+perf_match(const struct rte_event *event, void *cb_data)
+{
+	const struct perf_handler *handler = cb_data;
+
+	return event->flow_id % NUM_HANDLERS == handler->id;
+}
+
+static void
+perf_process(uint8_t event_dev_id, uint8_t event_port_id,
+	struct rte_event *events, uint16_t num, void *cb_data)
+{
+	struct perf_handler *handler = cb_data;
+	uint16_t i;
+
+	RTE_SET_USED(event_dev_id);
+	RTE_SET_USED(event_port_id);
+
+	for (i = 0; i < num; i++) {
+		struct rte_event *event = &events[i];
+
+		/* Forwarded vectors are owned by the handler */
+		if (event->event_type & RTE_EVENT_TYPE_VECTOR) {
+			handler->events += event->vec->nb_elem;
+			rte_mempool_put(app.vec_pool, event->vec);
+		} else {
+			handler->events++;
+		}
+	}
+
+	handler->calls++;
+}
+
+static int
+perf_setup(void)
+{
+	struct rte_event_dev_config config = {
+		.nb_event_queues = 1,
+		.nb_event_ports = 1,
+		.nb_events_limit = MAX_EVENTS,
+		.nb_event_queue_flows = NUM_FLOWS,
+		.nb_event_port_dequeue_depth = BURST_SIZE,
+		.nb_event_port_enqueue_depth = BURST_SIZE
+	};
+	struct rte_event_queue_conf queue_config = {
+		.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.schedule_type = RTE_SCHED_TYPE_ATOMIC,
+		.nb_atomic_flows = NUM_FLOWS
+	};
+	struct rte_event_port_conf port_config = {
+		.new_event_threshold = MAX_EVENTS,
+		.dequeue_depth = BURST_SIZE,
+		.enqueue_depth = BURST_SIZE
+	};
+	unsigned int i;
+	int rc;
+
+	rc = rte_vdev_init(DSW_VDEV, NULL);
+	if (rc < 0)
+		return TEST_SKIPPED;
+
+	app.event_dev_id = rte_event_dev_get_dev_id(DSW_VDEV);
+	app.port_id = 0;
+
+	rc = rte_event_dev_configure(app.event_dev_id, &config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to configure event device");
+
+	rc = rte_event_queue_setup(app.event_dev_id, 0, &queue_config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to setup queue");
+
+	rc = rte_event_port_setup(app.event_dev_id, app.port_id,
+				  &port_config);
+	TEST_ASSERT_SUCCESS(rc, "Unable to setup port");
+
+	rc = rte_event_port_link(app.event_dev_id, app.port_id, NULL, NULL, 0);
+	TEST_ASSERT_EQUAL(rc, 1, "Unable to link port");
+
+	app.vec_pool = rte_event_vector_pool_create("dispatcher_perf_vec",
+			MAX_EVENTS, 0, VEC_SIZE, rte_socket_id());
+	TEST_ASSERT_NOT_NULL(app.vec_pool, "Unable to create vector pool");
+
+	app.dispatcher = rte_dispatcher_create(app.event_dev_id);
+	TEST_ASSERT_NOT_NULL(app.dispatcher, "Unable to create dispatcher");
+
+	app.service_id = rte_dispatcher_service_id_get(app.dispatcher);
+
+	rc = rte_dispatcher_bind_port_to_lcore(app.dispatcher, app.port_id,
+			BURST_SIZE, 0, rte_lcore_id());
+	TEST_ASSERT_SUCCESS(rc, "Unable to bind port");
+
+	for (i = 0; i < NUM_HANDLERS; i++) {
+		struct perf_handler *handler = &app.handlers[i];
+
+		handler->id = i;
+		handler->reg_id = rte_dispatcher_register(app.dispatcher,
+				perf_match, handler, perf_process, handler);
+		TEST_ASSERT(handler->reg_id >= 0, "Unable to register handler");
+	}
+
+	rc = rte_event_dev_start(app.event_dev_id);
+	TEST_ASSERT_SUCCESS(rc, "Unable to start event device");
+
+	rte_service_set_runstate_mapped_check(app.service_id, 0);
+	rte_service_runstate_set(app.service_id, 1);
+	rte_dispatcher_start(app.dispatcher);
+
+	return TEST_SUCCESS;
+}
+
+static void
+perf_teardown(void)
+{
+	rte_dispatcher_stop(app.dispatcher);
+	rte_service_runstate_set(app.service_id, 0);
+	rte_event_dev_stop(app.event_dev_id);
+	rte_dispatcher_free(app.dispatcher);
+	rte_mempool_free(app.vec_pool);
+	rte_event_dev_close(app.event_dev_id);
+	rte_vdev_uninit(DSW_VDEV);
+}
+
+static int
+perf_configure(const struct rte_dispatcher_handler_conf *conf)
+{
+	unsigned int i;
+
+	for (i = 0; i < NUM_HANDLERS; i++) {
+		struct perf_handler *handler = &app.handlers[i];
+
+		if (rte_dispatcher_handler_conf_set(app.dispatcher,
+				handler->reg_id, conf) < 0)
+			return -1;
+
+		handler->events = 0;
+		handler->calls = 0;
+	}
+
+	rte_dispatcher_stats_reset(app.dispatcher);
+	app.total_events = 0;
+
+	return 0;
+}
+
+static uint64_t
+perf_handled(void)
+{
+	uint64_t events = 0;
+	unsigned int i;
+
+	for (i = 0; i < NUM_HANDLERS; i++)
+		events += app.handlers[i].events;
+
+	return events;
+}
+
+static int
+perf_enqueue_burst(uint32_t seq, bool vectors)
+{
+	struct rte_event events[BURST_SIZE];
+	uint16_t i, j, n;
+
+	for (i = 0; i < BURST_SIZE; i++) {
+		events[i] = (struct rte_event) {
+			.op = RTE_EVENT_OP_NEW,
+			.queue_id = 0,
+			.sched_type = RTE_SCHED_TYPE_ATOMIC,
+			.event_type = RTE_EVENT_TYPE_CPU,
+			/* interleave flows, as a worker port usually sees */
+			.flow_id = (seq * BURST_SIZE + i) % NUM_FLOWS,
+			.u64 = seq
+		};
+
+		if (vectors) {
+			struct rte_event_vector *vec;
+
+			if (rte_mempool_get(app.vec_pool, (void **)&vec) < 0)
+				return -1;
+
+			vec->nb_elem = VEC_SIZE;
+			vec->elem_offset = 0;
+			for (j = 0; j < VEC_SIZE; j++)
+				vec->u64s[j] = seq;
+
+			events[i].event_type = RTE_EVENT_TYPE_CPU_VECTOR;
+			events[i].vec = vec;
+		}
+	}
+
+	n = 0;
+	while (n < BURST_SIZE)
+		n += rte_event_enqueue_new_burst(app.event_dev_id, app.port_id,
+				&events[n], BURST_SIZE - n);
+
+	app.total_events += vectors ? BURST_SIZE * VEC_SIZE : BURST_SIZE;
+
+	return 0;
+}
+
+static int
+perf_run(const char *name, const struct rte_dispatcher_handler_conf *conf,
+	bool vectors)
+{
+	struct rte_dispatcher_handler_stats hstats;
+	struct rte_dispatcher_stats stats;
+	uint64_t handler_cycles = 0;
+	uint64_t process_count = 0;
+	uint64_t start, cycles;
+	uint32_t i;
+
+	TEST_ASSERT_SUCCESS(perf_configure(conf),
+			    "Unable to configure handlers");
+
+	start = rte_rdtsc_precise();
+
+	for (i = 0; i < NUM_BURSTS; i++) {
+		TEST_ASSERT_SUCCESS(perf_enqueue_burst(i, vectors),
+				    "Unable to allocate event vector");
+
+		while (perf_handled() < app.total_events)
+			rte_service_run_iter_on_app_lcore(app.service_id, 0);
+	}
+
+	cycles = rte_rdtsc_precise() - start;
+
+	rte_dispatcher_stats_get(app.dispatcher, &stats);
+
+	for (i = 0; i < NUM_HANDLERS; i++) {
+		TEST_ASSERT_SUCCESS(rte_dispatcher_handler_stats_get(
+				app.dispatcher, app.handlers[i].reg_id, &hstats),
+				"Unable to get handler stats");
+		handler_cycles += hstats.cycles;
+		process_count += hstats.process_count;
+	}
+
+	TEST_ASSERT_EQUAL(handler_cycles, stats.ev_process_cycles,
+			  "Handler cycles do not add up");
+
+	printf("%-28s %8.1f cycles/event, %6.1f events/process call,"
+	       " %5.1f%% in handlers\n", name,
+	       (double)cycles / app.total_events,
+	       (double)app.total_events / process_count,
+	       100.0 * stats.ev_process_cycles / cycles);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_dispatcher_perf(void)
+{
+	const struct {
+		const char *name;
+		struct rte_dispatcher_handler_conf conf;
+		bool vectors;
+	} cases[] = {
+		{ "default", {}, false },
+		{ "group by flow", { .group_by_flow = true }, false },
+		{ "max batch 4", { .max_batch = 4 }, false },
+		{ "vector forward", {}, true },
+		{ "vector unpack",
+		  { .vector_mode = RTE_DISPATCHER_VECTOR_UNPACK }, true },
+		{ "vector unpack, group",
+		  { .vector_mode = RTE_DISPATCHER_VECTOR_UNPACK,
+		    .group_by_flow = true }, true },
+	};
+	unsigned int i;
+	int rc;
+
+	rc = perf_setup();
+	if (rc != TEST_SUCCESS) {
+		if (rc == TEST_SKIPPED)
+			printf("%s not available, skipping test\n", DSW_VDEV);
+		return rc;
+	}
+
+	printf("%u handlers, %u flows, %u events per dequeue burst\n",
+	       NUM_HANDLERS, NUM_FLOWS, BURST_SIZE);
+
+	for (i = 0; i < RTE_DIM(cases); i++) {
+		rc = perf_run(cases[i].name, &cases[i].conf, cases[i].vectors);
+		if (rc != TEST_SUCCESS)
+			break;
+	}
+
+	perf_teardown();
+
+	return rc;
+}
+
+REGISTER_PERF_TEST(dispatcher_perf_autotest, test_dispatcher_perf);
@@ -46,6 +46,7 @@ test_event_crypto_adapter(void)
 #define NB_TEST_PORTS              1
 #define NB_TEST_QUEUES             2
 #define NUM_CORES                  1
+#define TEST_MAX_BATCH             32
 #define CRYPTODEV_NAME_NULL_PMD    crypto_null
 
 #define MBUF_SIZE              (sizeof(struct rte_mbuf) + \
@@ -272,6 +273,78 @@ test_crypto_adapter_stats(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_crypto_adapter_qp_stats(void)
+{
+	struct rte_event_crypto_adapter_queue_pair_stats stats;
+	int ret;
+
+	ret = rte_event_crypto_adapter_queue_pair_stats_get(TEST_ADAPTER_ID,
+			TEST_CDEV_ID, TEST_CDEV_QP_ID, &stats);
+	if (ret == -ENOTSUP)
+		return TEST_SUCCESS;
+	TEST_ASSERT_SUCCESS(ret, "Failed to get queue pair stats\n");
+
+	printf(" + Queue pair %u enqueue count     %" PRIu64 "\n",
+		TEST_CDEV_QP_ID, stats.crypto_enq_count);
+	printf(" + Queue pair %u enqueue bursts    %" PRIu64 "\n",
+		TEST_CDEV_QP_ID, stats.crypto_enq_burst_count);
+	printf(" + Queue pair %u timeout bursts    %" PRIu64 "\n",
+		TEST_CDEV_QP_ID, stats.crypto_enq_timeout_count);
+	printf(" + Queue pair %u dequeue count     %" PRIu64 "\n",
+		TEST_CDEV_QP_ID, stats.crypto_deq_count);
+	printf(" + Queue pair %u skipped polls     %" PRIu64 "\n",
+		TEST_CDEV_QP_ID, stats.crypto_deq_skip_count);
+	printf(" + Queue pair %u batch size        %u\n",
+		TEST_CDEV_QP_ID, stats.batch_sz);
+
+	TEST_ASSERT(stats.crypto_enq_count != 0,
+		    "No crypto op enqueued to queue pair\n");
+	TEST_ASSERT_EQUAL(stats.crypto_enq_count, stats.crypto_deq_count,
+			  "Crypto ops left in queue pair\n");
+	TEST_ASSERT(stats.crypto_enq_burst_count != 0 &&
+		    stats.crypto_enq_burst_count <= stats.crypto_enq_count,
+		    "Invalid enqueue burst count %" PRIu64 "\n",
+		    stats.crypto_enq_burst_count);
+	TEST_ASSERT(stats.crypto_enq_timeout_count <=
+		    stats.crypto_enq_burst_count,
+		    "Invalid timeout burst count %" PRIu64 "\n",
+		    stats.crypto_enq_timeout_count);
+	TEST_ASSERT(stats.crypto_deq_count <=
+		    stats.crypto_deq_poll_count * TEST_MAX_BATCH,
+		    "Invalid queue pair poll count %" PRIu64 "\n",
+		    stats.crypto_deq_poll_count);
+	TEST_ASSERT(stats.batch_sz >= 1 && stats.batch_sz <= TEST_MAX_BATCH,
+		    "Invalid batch size %u\n", stats.batch_sz);
+	TEST_ASSERT(stats.buffer_latency_max_ns <= stats.buffer_latency_ns,
+		    "Maximum buffer latency above the total\n");
+	TEST_ASSERT(stats.buffer_latency_ns <=
+		    stats.buffer_latency_max_ns * stats.crypto_enq_burst_count,
+		    "Total buffer latency above bursts times the maximum\n");
+	/* a single op cannot wait for more than a second in this test */
+	TEST_ASSERT(stats.buffer_latency_max_ns < NS_PER_S,
+		    "Buffer latency %" PRIu64 " ns out of range\n",
+		    stats.buffer_latency_max_ns);
+
+	ret = rte_event_crypto_adapter_queue_pair_stats_reset(TEST_ADAPTER_ID,
+			TEST_CDEV_ID, TEST_CDEV_QP_ID);
+	TEST_ASSERT_SUCCESS(ret, "Failed to reset queue pair stats\n");
+	ret = rte_event_crypto_adapter_queue_pair_stats_get(TEST_ADAPTER_ID,
+			TEST_CDEV_ID, TEST_CDEV_QP_ID, &stats);
+	TEST_ASSERT_SUCCESS(ret, "Failed to get queue pair stats\n");
+	TEST_ASSERT(stats.crypto_enq_count == 0 &&
+		    stats.crypto_enq_burst_count == 0 &&
+		    stats.crypto_enq_timeout_count == 0 &&
+		    stats.crypto_deq_count == 0 &&
+		    stats.crypto_deq_poll_count == 0 &&
+		    stats.crypto_deq_skip_count == 0 &&
+		    stats.buffer_latency_ns == 0 &&
+		    stats.buffer_latency_max_ns == 0,
+		    "Queue pair stats not reset\n");
+
+	return TEST_SUCCESS;
+}
+
 static int
 test_crypto_adapter_params(void)
 {
@@ -377,6 +450,39 @@ test_crypto_adapter_params(void)
 	TEST_ASSERT(in_params.max_nb == out_params.max_nb, "Expected %u got %u",
 		    in_params.max_nb, out_params.max_nb);
 
+	/* Case 7: Set flush_timeout_us = 0 and 200 */
+	in_params.flush_timeout_us = 0;
+
+	err = rte_event_crypto_adapter_runtime_params_set(TEST_ADAPTER_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_crypto_adapter_runtime_params_get(TEST_ADAPTER_ID,
+							  &out_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(out_params.flush_timeout_us == 0, "Expected 0 got %u",
+		    out_params.flush_timeout_us);
+
+	in_params.flush_timeout_us = 200;
+
+	err = rte_event_crypto_adapter_runtime_params_set(TEST_ADAPTER_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_crypto_adapter_runtime_params_get(TEST_ADAPTER_ID,
+							  &out_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(in_params.flush_timeout_us == out_params.flush_timeout_us,
+		    "Expected %u got %u", in_params.flush_timeout_us,
+		    out_params.flush_timeout_us);
+
+	/* Case 8: Set flush_timeout_us above 1s */
+	in_params.flush_timeout_us = 2000000;
+
+	err = rte_event_crypto_adapter_runtime_params_set(TEST_ADAPTER_ID,
+							  &in_params);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
 	rc = TEST_SUCCESS;
 queue_pair_del:
 	err = rte_event_crypto_adapter_queue_pair_del(TEST_ADAPTER_ID,
@@ -474,6 +580,9 @@ test_op_forward_mode(uint8_t session_less)
 
 	test_crypto_adapter_stats();
 
+	ret = test_crypto_adapter_qp_stats();
+	TEST_ASSERT_SUCCESS(ret, "Invalid queue pair stats\n");
+
 	return TEST_SUCCESS;
 }
 
@@ -1066,6 +1066,84 @@ adapter_intr_queue_add_del(void)
 	return TEST_SUCCESS;
 }
 
+static int
+adapter_adaptive_queue_add_del(void)
+{
+	int err;
+	struct rte_event ev;
+	struct rte_event_eth_rx_adapter_queue_conf queue_config = {0};
+
+	if (!default_params.rx_intr_port_inited)
+		return 0;
+
+	ev.queue_id = 0;
+	ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	ev.priority = 0;
+
+	queue_config.rx_queue_flags =
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR;
+	queue_config.ev = ev;
+
+	/* adaptive mode needs a polled queue */
+	queue_config.servicing_weight = 0;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						-1,
+						&queue_config);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	/* add all queues */
+	queue_config.servicing_weight = 1;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						-1,
+						&queue_config);
+	if (err == -EINVAL || err == -ENOTSUP)
+		return TEST_SKIPPED;
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_conf_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(queue_config.rx_queue_flags &
+		    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR,
+		    "Expected adaptive mode flag");
+
+	/* adaptive -> poll mode queue */
+	queue_config.rx_queue_flags = 0;
+	queue_config.servicing_weight = 1;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						-1,
+						&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_conf_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(!(queue_config.rx_queue_flags &
+		      RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR),
+		    "Unexpected adaptive mode flag");
+
+	/* poll -> adaptive mode queue, then delete */
+	queue_config.rx_queue_flags =
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						-1,
+						&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						-1);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	return TEST_SUCCESS;
+}
+
 static int
 adapter_start_stop(void)
 {
@@ -1489,6 +1567,48 @@ adapter_get_set_params(void)
 		    "Expected %u got %u",
 		    in_params.max_nb_rx, out_params.max_nb_rx);
 
+	/* Case 7: Set adaptive mode parameters */
+	in_params.adaptive_window = 256;
+	in_params.adaptive_intr_thresh = 90;
+	in_params.adaptive_holdoff = 2;
+
+	err = rte_event_eth_rx_adapter_runtime_params_set(TEST_INST_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_runtime_params_get(TEST_INST_ID,
+							  &out_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(in_params.adaptive_window == out_params.adaptive_window &&
+		    in_params.adaptive_intr_thresh ==
+				out_params.adaptive_intr_thresh &&
+		    in_params.adaptive_holdoff == out_params.adaptive_holdoff,
+		    "Adaptive mode parameters mismatch");
+
+	/* Case 8: Adaptive mode parameters left to 0 are kept */
+	in_params.adaptive_window = 0;
+	in_params.adaptive_intr_thresh = 0;
+	in_params.adaptive_holdoff = 0;
+
+	err = rte_event_eth_rx_adapter_runtime_params_set(TEST_INST_ID,
+							  &in_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_runtime_params_get(TEST_INST_ID,
+							  &out_params);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(out_params.adaptive_window == 256 &&
+		    out_params.adaptive_intr_thresh == 90 &&
+		    out_params.adaptive_holdoff == 2,
+		    "Adaptive mode parameters not kept");
+
+	/* Case 9: Invalid adaptive mode threshold */
+	in_params.adaptive_intr_thresh = 101;
+
+	err = rte_event_eth_rx_adapter_runtime_params_set(TEST_INST_ID,
+							  &in_params);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
 	rc = TEST_SUCCESS;
 skip:
 	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
@@ -1537,6 +1657,8 @@ static struct unit_test_suite event_eth_rx_intr_tests = {
 			     adapter_intr_queue_add_del),
 		TEST_CASE_ST(adapter_create, adapter_free,
 			     adapter_intrq_instance_get),
+		TEST_CASE_ST(adapter_create, adapter_free,
+			     adapter_adaptive_queue_add_del),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
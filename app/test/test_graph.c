@@ -1062,6 +1062,68 @@ test_print_stats(void)
 	return 0;
 }
 
+static int
+test_graph_ext_stats(void)
+{
+	struct rte_graph_path_trace traces[RTE_GRAPH_PATH_TRACE_NB];
+	rte_graph_t id = rte_graph_from_name("worker0");
+	struct rte_graph *graph = rte_graph_lookup("worker0");
+	uint64_t walks = 0;
+	int i, nb;
+
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	if (!graph) {
+		printf("Graph lookup failed\n");
+		return -1;
+	}
+
+	/* Path tracing is rejected with the dispatch model */
+	if (rte_graph_worker_model_set(RTE_GRAPH_MODEL_MCORE_DISPATCH) ||
+	    rte_graph_path_trace_enable(id, 1) != -ENOTSUP) {
+		printf("Path trace not rejected with dispatch model\n");
+		return -1;
+	}
+
+	if (rte_graph_worker_model_set(RTE_GRAPH_MODEL_RTC) ||
+	    rte_graph_hist_enable(id, true) ||
+	    rte_graph_path_trace_enable(id, 1)) {
+		printf("Unable to enable extended stats\n");
+		return -1;
+	}
+
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		walks -= __rte_graph_ext_stats(graph)->walk_hist[i];
+	for (i = 0; i < 5; i++)
+		rte_graph_walk(graph);
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		walks += __rte_graph_ext_stats(graph)->walk_hist[i];
+
+	rte_graph_path_trace_enable(id, 0);
+	rte_graph_hist_enable(id, false);
+
+	if (walks != 5) {
+		printf("Walk histogram mismatch, expected = 5 got = %"PRIu64"\n", walks);
+		return -1;
+	}
+
+	nb = rte_graph_path_trace_get(id, traces, RTE_DIM(traces));
+	if (nb != 5) {
+		printf("Path trace count mismatch, expected = 5 got = %d\n", nb);
+		return -1;
+	}
+
+	for (i = 0; i < nb; i++) {
+		if (traces[i].nb_nodes == 0) {
+			printf("Path trace %d is empty\n", i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int
 graph_setup(void)
 {
@@ -1140,6 +1202,7 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_graph_ext_stats),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
@@ -22,11 +22,17 @@ test_graph_perf_func(void)
 
 #else
 
+#include <rte_bus_vdev.h>
+#include <rte_ethdev.h>
 #include <rte_graph.h>
 #include <rte_graph_worker.h>
+#include <rte_ip.h>
 #include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_mbuf.h>
+#include <rte_node_eth_api.h>
+#include <rte_node_ip4_api.h>
+#include <rte_udp.h>
 
 #define TEST_GRAPH_PERF_MZ	     "graph_perf_data"
 #define TEST_GRAPH_SRC_NAME	     "test_graph_perf_source"
@@ -705,6 +711,88 @@ graph_hr_4s_1n_1src_1snk(void)
 	return measure_perf();
 }
 
+#define GRAPH_PERF_WALKS 100000
+
+static uint64_t
+graph_walk_cycles_get(struct rte_graph *graph)
+{
+	uint64_t start;
+	int i;
+
+	start = rte_rdtsc_precise();
+	for (i = 0; i < GRAPH_PERF_WALKS; i++)
+		rte_graph_walk(graph);
+
+	return (rte_rdtsc_precise() - start) / GRAPH_PERF_WALKS;
+}
+
+static void
+graph_ext_stats_dump(rte_graph_t graph_id)
+{
+	struct rte_graph_path_trace traces[4];
+	struct rte_graph *graph;
+	uint64_t *walk_hist;
+	int nb, i, j;
+
+	graph = rte_graph_lookup(rte_graph_id_to_name(graph_id));
+	walk_hist = __rte_graph_ext_stats(graph)->walk_hist;
+	printf("Walk cycles histogram:\n");
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		if (walk_hist[i])
+			printf("  < 2^%-2d: %" PRIu64 "\n", i, walk_hist[i]);
+
+	nb = rte_graph_path_trace_get(graph_id, traces, RTE_DIM(traces));
+	for (i = 0; i < nb; i++) {
+		printf("Path trace %d (%" PRIu64 " cycles):", i, traces[i].cycles);
+		for (j = 0; j < RTE_MIN(traces[i].nb_nodes, RTE_GRAPH_PATH_TRACE_NODES); j++)
+			printf(" %s", rte_node_id_to_name(traces[i].nodes[j]));
+		printf("\n");
+	}
+}
+
+/* Overhead of cycle histograms and path tracing on the graph walk */
+static int
+graph_hr_4s_1n_1src_1snk_ext_stats(void)
+{
+	uint64_t base, hist, trace;
+	const struct rte_memzone *mz;
+	struct test_graph_perf *graph_data;
+	struct rte_graph *graph;
+	rte_graph_t graph_id;
+	int rc;
+
+	if (!rte_graph_has_stats_feature())
+		return TEST_SKIPPED;
+
+	mz = rte_memzone_lookup(TEST_GRAPH_PERF_MZ);
+	if (mz == NULL)
+		return -ENOMEM;
+	graph_data = mz->addr;
+	graph_id = graph_data->graph_id;
+	graph = rte_graph_lookup(rte_graph_id_to_name(graph_id));
+
+	base = graph_walk_cycles_get(graph);
+	TEST_ASSERT_SUCCESS(rte_graph_hist_enable(graph_id, true),
+			    "Failed to enable histograms");
+	hist = graph_walk_cycles_get(graph);
+	TEST_ASSERT_SUCCESS(rte_graph_path_trace_enable(graph_id, 1024),
+			    "Failed to enable path trace");
+	trace = graph_walk_cycles_get(graph);
+
+	printf("Cycles/walk: base %" PRIu64 ", histograms %" PRIu64 " (%+.2f%%), "
+	       "histograms + 1/1024 path trace %" PRIu64 " (%+.2f%%)\n",
+	       base, hist, (double)((int64_t)(hist - base) * 100) / base,
+	       trace, (double)((int64_t)(trace - base) * 100) / base);
+
+	/* Cluster stats report the node histograms while enabled */
+	rc = measure_perf();
+	graph_ext_stats_dump(graph_id);
+	rte_graph_path_trace_enable(graph_id, 0);
+	rte_graph_hist_enable(graph_id, false);
+
+	return rc;
+}
+
 static inline int
 graph_hr_4s_1n_1src_1snk_brst_one(void)
 {
@@ -979,6 +1067,206 @@ graph_init_parallel_tree(void)
 			  snk_map, edge_map, 0);
 }
 
+#define FLOW_PERF_VDEV	  "net_null_graph_perf"
+#define FLOW_PERF_GRAPH	  "graph_flow_cache"
+#define FLOW_PERF_SRC_NAME "test_graph_perf_flow_source"
+#define FLOW_PERF_FLOWS	  256
+#define FLOW_PERF_WALKS	  10000
+#define FLOW_PERF_PKT_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr))
+
+enum flow_perf_next {
+	FLOW_PERF_NEXT_FLOW_CACHE,
+	FLOW_PERF_NEXT_PKT_CLS,
+};
+
+static struct flow_perf {
+	struct rte_mempool *mp;
+	rte_graph_t graph_id;
+	uint16_t port;
+	rte_edge_t next;
+	uint32_t seq;
+	uint8_t pkt[FLOW_PERF_PKT_LEN];
+} flow_perf;
+
+/* Generates UDP/IPv4 packets of FLOW_PERF_FLOWS flows routed to the null port */
+static uint16_t
+test_perf_node_flow_source(struct rte_graph *graph, struct rte_node *node,
+			   void **objs, uint16_t nb_objs)
+{
+	struct rte_mbuf **pkts;
+	struct rte_udp_hdr *udp;
+	uint16_t i;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	pkts = (struct rte_mbuf **)rte_node_next_stream_get(graph, node, flow_perf.next,
+							    RTE_GRAPH_BURST_SIZE);
+	if (rte_pktmbuf_alloc_bulk(flow_perf.mp, pkts, RTE_GRAPH_BURST_SIZE))
+		return 0;
+
+	for (i = 0; i < RTE_GRAPH_BURST_SIZE; i++) {
+		rte_memcpy(rte_pktmbuf_mtod(pkts[i], void *), flow_perf.pkt, FLOW_PERF_PKT_LEN);
+		pkts[i]->data_len = FLOW_PERF_PKT_LEN;
+		pkts[i]->pkt_len = FLOW_PERF_PKT_LEN;
+		pkts[i]->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4;
+		pkts[i]->port = flow_perf.port;
+
+		udp = rte_pktmbuf_mtod_offset(pkts[i], struct rte_udp_hdr *,
+					      FLOW_PERF_PKT_LEN - sizeof(*udp));
+		udp->src_port = rte_cpu_to_be_16(flow_perf.seq++ % FLOW_PERF_FLOWS);
+	}
+
+	rte_node_next_stream_put(graph, node, flow_perf.next, RTE_GRAPH_BURST_SIZE);
+
+	return RTE_GRAPH_BURST_SIZE;
+}
+
+static struct rte_node_register test_graph_perf_flow_source = {
+	.name = FLOW_PERF_SRC_NAME,
+	.process = test_perf_node_flow_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 2,
+	.next_nodes = {
+		[FLOW_PERF_NEXT_FLOW_CACHE] = "flow_cache",
+		[FLOW_PERF_NEXT_PKT_CLS] = "pkt_cls",
+	},
+};
+
+RTE_NODE_REGISTER(test_graph_perf_flow_source);
+
+static int
+graph_init_flow_cache(void)
+{
+	const char *patterns[] = {FLOW_PERF_SRC_NAME};
+	struct rte_node_ethdev_config conf = {0};
+	struct rte_graph_param gconf = {0};
+	struct rte_eth_conf eth_conf = {0};
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *udp;
+	uint8_t rewrite[RTE_ETHER_HDR_LEN];
+	int ret;
+
+	flow_perf.graph_id = RTE_GRAPH_ID_INVALID;
+	if (rte_vdev_init(FLOW_PERF_VDEV, NULL) < 0) {
+		printf("Failed to create %s, skipping\n", FLOW_PERF_VDEV);
+		return TEST_SKIPPED;
+	}
+	TEST_ASSERT_SUCCESS(rte_eth_dev_get_port_by_name(FLOW_PERF_VDEV, &flow_perf.port),
+			    "Failed to get port of %s", FLOW_PERF_VDEV);
+
+	flow_perf.mp = rte_pktmbuf_pool_create("graph_flow_perf", 8192, 256,
+					       RTE_CACHE_LINE_SIZE, RTE_MBUF_DEFAULT_BUF_SIZE,
+					       rte_socket_id());
+	TEST_ASSERT_NOT_NULL(flow_perf.mp, "Failed to create mempool");
+
+	ret = rte_eth_dev_configure(flow_perf.port, 1, 1, &eth_conf);
+	TEST_ASSERT_SUCCESS(ret, "Failed to configure port %u", flow_perf.port);
+	ret = rte_eth_rx_queue_setup(flow_perf.port, 0, 256, SOCKET_ID_ANY, NULL, flow_perf.mp);
+	TEST_ASSERT_SUCCESS(ret, "Failed to setup rx queue");
+	ret = rte_eth_tx_queue_setup(flow_perf.port, 0, 256, SOCKET_ID_ANY, NULL);
+	TEST_ASSERT_SUCCESS(ret, "Failed to setup tx queue");
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(flow_perf.port), "Failed to start port");
+
+	conf.port_id = flow_perf.port;
+	conf.num_rx_queues = 1;
+	conf.num_tx_queues = 1;
+	conf.mp = &flow_perf.mp;
+	conf.mp_count = 1;
+	TEST_ASSERT_SUCCESS(rte_node_eth_config(&conf, 1, 1), "Failed to config ethdev nodes");
+
+	gconf.socket_id = rte_socket_id();
+	gconf.nb_node_patterns = RTE_DIM(patterns);
+	gconf.node_patterns = patterns;
+	flow_perf.graph_id = rte_graph_create(FLOW_PERF_GRAPH, &gconf);
+	TEST_ASSERT(flow_perf.graph_id != RTE_GRAPH_ID_INVALID, "Graph creation failed");
+	/* ethdev_tx uses the graph id as Tx queue */
+	TEST_ASSERT_EQUAL(flow_perf.graph_id, 0, "Graph id %u has no Tx queue",
+			  flow_perf.graph_id);
+
+	/* Routes can only be added once lookup nodes created their tables */
+	rte_eth_random_addr(rewrite);
+	rte_eth_macaddr_get(flow_perf.port, (struct rte_ether_addr *)&rewrite[RTE_ETHER_ADDR_LEN]);
+	*(rte_be16_t *)&rewrite[2 * RTE_ETHER_ADDR_LEN] = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+	TEST_ASSERT_SUCCESS(rte_node_ip4_rewrite_add(0, rewrite, sizeof(rewrite), flow_perf.port),
+			    "Failed to add rewrite data");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_route_add(RTE_IPV4(198, 18, 0, 0), 16, 0,
+						   RTE_NODE_IP4_LOOKUP_NEXT_REWRITE),
+			    "Failed to add route");
+
+	eth = (struct rte_ether_hdr *)flow_perf.pkt;
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	udp = (struct rte_udp_hdr *)(ip + 1);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(FLOW_PERF_PKT_LEN - sizeof(*eth));
+	ip->time_to_live = IPDEFTTL;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 19, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+	udp->dst_port = RTE_BE16(9);
+	udp->dgram_len = rte_cpu_to_be_16(sizeof(*udp));
+
+	return 0;
+}
+
+static void
+graph_fini_flow_cache(void)
+{
+	if (flow_perf.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(flow_perf.graph_id);
+	flow_perf.graph_id = RTE_GRAPH_ID_INVALID;
+
+	if (rte_eth_dev_get_port_by_name(FLOW_PERF_VDEV, &flow_perf.port) == 0) {
+		rte_eth_dev_stop(flow_perf.port);
+		rte_eth_dev_close(flow_perf.port);
+		rte_vdev_uninit(FLOW_PERF_VDEV);
+	}
+	rte_mempool_free(flow_perf.mp);
+	flow_perf.mp = NULL;
+}
+
+/* Cycles per packet from source to Tx with and without flow_cache node */
+static int
+graph_flow_cache_ip4_fwd(void)
+{
+	uint64_t base, cached, *xstats;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	double hit_rate;
+
+	graph = rte_graph_lookup(FLOW_PERF_GRAPH);
+	node = rte_graph_node_get_by_name(FLOW_PERF_GRAPH, "flow_cache");
+	TEST_ASSERT_NOT_NULL(node, "flow_cache node not in graph");
+
+	flow_perf.next = FLOW_PERF_NEXT_PKT_CLS;
+	base = graph_walk_cycles_get(graph) / RTE_GRAPH_BURST_SIZE;
+
+	/* Warm up the cache then measure */
+	flow_perf.next = FLOW_PERF_NEXT_FLOW_CACHE;
+	rte_graph_walk(graph);
+	cached = graph_walk_cycles_get(graph) / RTE_GRAPH_BURST_SIZE;
+
+	printf("Cycles/pkt: lookup %" PRIu64 ", flow cache %" PRIu64 " (%+.2f%%)\n",
+	       base, cached, (double)((int64_t)(cached - base) * 100) / base);
+
+	if (!rte_graph_has_stats_feature())
+		return TEST_SUCCESS;
+
+	/* hit, miss, learn, flush, cycles saved */
+	xstats = RTE_PTR_ADD(node, node->xstat_off);
+	hit_rate = (double)xstats[0] * 100 / RTE_MAX(xstats[0] + xstats[1], 1ULL);
+	printf("Flow cache: hit rate %.2f%%, learnt %" PRIu64 ", cycles saved %" PRIu64 "\n",
+	       hit_rate, xstats[2], xstats[4]);
+	TEST_ASSERT(xstats[2] >= FLOW_PERF_FLOWS, "Flows not learnt");
+	TEST_ASSERT(hit_rate > 90, "Low hit rate");
+
+	return TEST_SUCCESS;
+}
+
 /** Graph Creation cheat sheet
  *  edge_map -> dictates graph flow from worker stage 0 to worker stage n-1.
  *  src_map  -> dictates source nodes enqueue percentage to worker stage 0.
@@ -1049,6 +1337,8 @@ static struct unit_test_suite graph_perf_testsuite = {
 	.unit_test_cases = {
 		TEST_CASE_ST(graph_init_hr, graph_fini,
 			     graph_hr_4s_1n_1src_1snk),
+		TEST_CASE_ST(graph_init_hr, graph_fini,
+			     graph_hr_4s_1n_1src_1snk_ext_stats),
 		TEST_CASE_ST(graph_init_hr_brst_one, graph_fini,
 			     graph_hr_4s_1n_1src_1snk_brst_one),
 		TEST_CASE_ST(graph_init_hr_multi_src, graph_fini,
@@ -1061,6 +1351,8 @@ static struct unit_test_suite graph_perf_testsuite = {
 			     graph_reverse_tree_3s_4n_1src_1snk),
 		TEST_CASE_ST(graph_init_parallel_tree, graph_fini,
 			     graph_parallel_tree_5s_4n_4src_4snk),
+		TEST_CASE_ST(graph_init_flow_cache, graph_fini_flow_cache,
+			     graph_flow_cache_ip4_fwd),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
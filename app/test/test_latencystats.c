@@ -14,7 +14,7 @@
 #include "sample_packet_forward.h"
 #include "test.h"
 
-#define NUM_STATS 5
+#define NUM_STATS 9
 #define LATENCY_NUM_PACKETS 10
 #define QUEUE_ID 0
 
@@ -27,6 +27,10 @@ static struct rte_metric_name lat_stats_strings[NUM_STATS] = {
 	{"max_latency_ns"},
 	{"jitter_ns"},
 	{"samples"},
+	{"p50_latency_ns"},
+	{"p90_latency_ns"},
+	{"p99_latency_ns"},
+	{"p999_latency_ns"},
 };
 
 /* Test case for latency init with metrics init */
@@ -198,6 +202,11 @@ static int test_latency_packet_forward(void)
 	TEST_ASSERT(values[0].value < values[1].value, "Min latency > Avg latency");
 	TEST_ASSERT(values[0].value < values[2].value, "Min latency > Max latency");
 	TEST_ASSERT(values[1].value < values[2].value, "Avg latency > Max latency");
+	TEST_ASSERT(values[5].value >= values[0].value, "p50 latency < Min latency");
+	TEST_ASSERT(values[5].value <= values[6].value, "p50 latency > p90 latency");
+	TEST_ASSERT(values[6].value <= values[7].value, "p90 latency > p99 latency");
+	TEST_ASSERT(values[7].value <= values[8].value, "p99 latency > p99.9 latency");
+	TEST_ASSERT(values[8].value <= values[2].value, "p99.9 latency > Max latency");
 
 	rte_eth_dev_stop(portid);
 	test_put_mbuf_to_pool(mp, pbuf);
@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_latencystats.h>
+#include <rte_lcore.h>
+#include <rte_metrics.h>
+
+#include "sample_packet_forward.h"
+#include "test.h"
+
+/*
+ * Cost of the latency stats callbacks when every packet is sampled:
+ * the same packets are looped through a ring port with and without
+ * latency stats, as if received and sent back by a forwarding core.
+ */
+
+#define LATENCY_PERF_ITERATIONS	(1 << 20)
+
+static uint64_t
+latency_perf_forward(uint16_t portid, struct rte_mbuf **pbuf)
+{
+	uint64_t start;
+	unsigned int i, j;
+
+	start = rte_rdtsc_precise();
+	for (i = 0; i < LATENCY_PERF_ITERATIONS; i++) {
+		if (rte_eth_tx_burst(portid, 0, pbuf, NUM_PACKETS) < NUM_PACKETS ||
+				rte_eth_rx_burst(portid, 0, pbuf, NUM_PACKETS) < NUM_PACKETS)
+			return 0;
+		/* Received packets are fresh mbufs for the timestamping */
+		for (j = 0; j < NUM_PACKETS; j++)
+			pbuf[j]->ol_flags = 0;
+	}
+
+	return rte_rdtsc_precise() - start;
+}
+
+static int
+test_latencystats_perf(void)
+{
+	struct rte_mbuf *pbuf[NUM_PACKETS] = { };
+	struct rte_metric_value values[16];
+	char poolname[] = "mbuf_pool";
+	uint64_t base, sampled;
+	struct rte_mempool *mp;
+	struct rte_ring *ring;
+	int ret = TEST_FAILED;
+	uint16_t portid;
+	int nb_values;
+
+	if (test_ring_setup(&ring, &portid) < 0)
+		return TEST_FAILED;
+
+	if (test_get_mbuf_from_pool(&mp, pbuf, poolname) < 0) {
+		printf("allocate mbuf pool Failed\n");
+		goto free_ring;
+	}
+
+	if (test_dev_start(portid, mp) < 0) {
+		printf("test_dev_start(%hu, %p) failed\n", portid, mp);
+		goto free_mbufs;
+	}
+
+	base = latency_perf_forward(portid, pbuf);
+
+	rte_metrics_init(rte_socket_id());
+	if (rte_latencystats_init(0, NULL) < 0) {
+		printf("rte_latencystats_init failed\n");
+		goto stop;
+	}
+	sampled = latency_perf_forward(portid, pbuf);
+
+	if (base == 0 || sampled == 0) {
+		printf("Packet forwarding failed\n");
+		goto uninit;
+	}
+
+	printf("\nwithout latency stats: %.2f cycles/packet\n",
+		(double)base / LATENCY_PERF_ITERATIONS / NUM_PACKETS);
+	printf("100%% sampling:         %.2f cycles/packet\n",
+		(double)sampled / LATENCY_PERF_ITERATIONS / NUM_PACKETS);
+	printf("overhead:              %.2f cycles/packet\n",
+		((double)sampled - base) / LATENCY_PERF_ITERATIONS / NUM_PACKETS);
+
+	nb_values = rte_latencystats_get(values, RTE_DIM(values));
+	if (nb_values < 0 || nb_values > (int)RTE_DIM(values)) {
+		printf("rte_latencystats_get failed\n");
+		goto uninit;
+	}
+	/* Samples counter, packets are sent once more than received */
+	if (values[4].value != (uint64_t)(LATENCY_PERF_ITERATIONS - 1) * NUM_PACKETS) {
+		printf("Expected every packet to be sampled, got %" PRIu64 "\n",
+			values[4].value);
+		goto uninit;
+	}
+
+	ret = TEST_SUCCESS;
+uninit:
+	rte_latencystats_uninit();
+	rte_metrics_deinit();
+stop:
+	rte_eth_dev_stop(portid);
+free_mbufs:
+	test_put_mbuf_to_pool(mp, pbuf);
+free_ring:
+	test_ring_free(ring);
+	test_vdev_uninit("net_ring_net_ringa");
+	return ret;
+}
+
+REGISTER_PERF_TEST(latencystats_perf_autotest, test_latencystats_perf);
@@ -3025,6 +3025,179 @@ test_balance_l34_tx_burst_ipv6_toggle_udp_port(void)
 	return balance_l34_tx_burst(0, 0, 0, 0, 1);
 }
 
+#define TEST_BAL_HASH_BURST_SIZE	(45)
+
+/*
+ * Member index the balance Tx hash selects for a packet, computed one
+ * packet at a time with plain modulo, as a reference for the burst path.
+ */
+static uint16_t
+balance_tx_hash_ref(struct rte_mbuf *m, uint8_t policy, uint16_t member_count)
+{
+	struct rte_ether_hdr *eth = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+	unaligned_uint16_t *dst_words = (unaligned_uint16_t *)&eth->dst_addr;
+	unaligned_uint16_t *src_words = (unaligned_uint16_t *)&eth->src_addr;
+	uint16_t proto = eth->ether_type;
+	uint32_t hash = 0, l3hash = 0, l4hash = 0;
+	struct rte_udp_hdr *udp = NULL;
+	uint8_t *l3 = (uint8_t *)(eth + 1);
+	unsigned int i;
+
+	if (proto == rte_cpu_to_be_16(RTE_ETHER_TYPE_VLAN)) {
+		proto = ((struct rte_vlan_hdr *)l3)->eth_proto;
+		l3 += sizeof(struct rte_vlan_hdr);
+	}
+
+	if (proto == rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4)) {
+		struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)l3;
+
+		l3hash = ip->src_addr ^ ip->dst_addr;
+		udp = (struct rte_udp_hdr *)(ip + 1);
+	} else if (proto == rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6)) {
+		struct rte_ipv6_hdr *ip = (struct rte_ipv6_hdr *)l3;
+		unaligned_uint32_t *src = (unaligned_uint32_t *)&ip->src_addr;
+		unaligned_uint32_t *dst = (unaligned_uint32_t *)&ip->dst_addr;
+
+		for (i = 0; i < 4; i++)
+			l3hash ^= src[i] ^ dst[i];
+		udp = (struct rte_udp_hdr *)(ip + 1);
+	}
+	if (udp != NULL)
+		l4hash = udp->src_port ^ udp->dst_port;
+
+	if (policy != BALANCE_XMIT_POLICY_LAYER34)
+		for (i = 0; i < 3; i++)
+			hash ^= src_words[i] ^ dst_words[i];
+	if (policy == BALANCE_XMIT_POLICY_LAYER23)
+		hash ^= l3hash;
+	else if (policy == BALANCE_XMIT_POLICY_LAYER34)
+		hash = l3hash ^ l4hash;
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash % member_count;
+}
+
+/* Give each packet of a burst its own addresses and source port */
+static void
+balance_tx_hash_vary_burst(struct rte_mbuf **pkts, uint16_t nb_pkts,
+		uint8_t vlan, uint8_t ipv4)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		struct rte_ether_hdr *eth =
+			rte_pktmbuf_mtod(pkts[i], struct rte_ether_hdr *);
+		uint8_t *l3 = (uint8_t *)(eth + 1) +
+			(vlan ? sizeof(struct rte_vlan_hdr) : 0);
+		struct rte_udp_hdr *udp;
+
+		eth->src_addr.addr_bytes[5] = i;
+		eth->dst_addr.addr_bytes[2] = i * 3;
+		if (ipv4) {
+			struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)l3;
+
+			ip->src_addr ^= rte_cpu_to_be_32(i * 7);
+			udp = (struct rte_udp_hdr *)(ip + 1);
+		} else {
+			struct rte_ipv6_hdr *ip = (struct rte_ipv6_hdr *)l3;
+
+			ip->src_addr.a[15] ^= i * 7;
+			ip->dst_addr.a[9] ^= i;
+			udp = (struct rte_udp_hdr *)(ip + 1);
+		}
+		udp->src_port = rte_cpu_to_be_16(1000 + i * 11);
+	}
+}
+
+/*
+ * Send bursts long enough for the vector reduction and its scalar tail,
+ * and check every packet went to the member the reference hash selects.
+ */
+static int
+balance_tx_hash_member_selection(uint8_t policy, uint16_t member_count,
+		uint8_t vlan, uint8_t ipv4)
+{
+	struct rte_mbuf *pkts[TEST_BAL_HASH_BURST_SIZE];
+	struct rte_mbuf *member_pkts[MAX_PKT_BURST];
+	uint16_t expected[TEST_BAL_HASH_BURST_SIZE];
+	uint16_t active[RTE_MAX_ETHPORTS];
+	int nb_active, nb_tx, nb_member_pkts, total = 0;
+	int i, j, k;
+
+	TEST_ASSERT_SUCCESS(initialize_bonding_device_with_members(
+			BONDING_MODE_BALANCE, 0, member_count, 1),
+			"Failed to initialize_bonding_device_with_members.");
+	TEST_ASSERT_SUCCESS(rte_eth_bond_xmit_policy_set(
+			test_params->bonding_port_id, policy),
+			"Failed to set balance xmit policy.");
+	nb_active = rte_eth_bond_active_members_get(test_params->bonding_port_id,
+			active, RTE_DIM(active));
+	TEST_ASSERT_EQUAL(nb_active, member_count,
+			"Active members (%d) not as expected (%u)",
+			nb_active, member_count);
+
+	TEST_ASSERT_EQUAL(generate_test_burst(pkts, TEST_BAL_HASH_BURST_SIZE,
+			vlan, ipv4, 0, 0, 0), TEST_BAL_HASH_BURST_SIZE,
+			"failed to generate packet burst");
+	balance_tx_hash_vary_burst(pkts, TEST_BAL_HASH_BURST_SIZE, vlan, ipv4);
+	for (i = 0; i < TEST_BAL_HASH_BURST_SIZE; i++)
+		expected[i] = active[balance_tx_hash_ref(pkts[i], policy,
+				member_count)];
+
+	nb_tx = rte_eth_tx_burst(test_params->bonding_port_id, 0, pkts,
+			TEST_BAL_HASH_BURST_SIZE);
+	TEST_ASSERT_EQUAL(nb_tx, TEST_BAL_HASH_BURST_SIZE, "tx burst failed");
+
+	for (k = 0; k < nb_active; k++) {
+		nb_member_pkts = virtual_ethdev_get_mbufs_from_tx_queue(active[k],
+				member_pkts, MAX_PKT_BURST);
+		for (j = 0; j < nb_member_pkts; j++) {
+			for (i = 0; i < TEST_BAL_HASH_BURST_SIZE; i++)
+				if (pkts[i] == member_pkts[j])
+					break;
+			TEST_ASSERT(i < TEST_BAL_HASH_BURST_SIZE,
+					"Unknown packet on member %u", active[k]);
+			TEST_ASSERT_EQUAL(expected[i], active[k],
+					"Policy %u, %u members: packet %d sent on member %u, expected %u",
+					policy, member_count, i, active[k], expected[i]);
+		}
+		free_mbufs(member_pkts, nb_member_pkts);
+		total += nb_member_pkts;
+	}
+	TEST_ASSERT_EQUAL(total, TEST_BAL_HASH_BURST_SIZE,
+			"%d packets sent on members, expected %d",
+			total, TEST_BAL_HASH_BURST_SIZE);
+
+	return remove_members_and_stop_bonding_device();
+}
+
+static int
+test_balance_tx_hash_member_selection(void)
+{
+	static const uint8_t policies[] = {
+		BALANCE_XMIT_POLICY_LAYER2,
+		BALANCE_XMIT_POLICY_LAYER23,
+		BALANCE_XMIT_POLICY_LAYER34,
+	};
+	static const uint16_t member_counts[] = { 2, 3, 5 };
+	unsigned int p, c;
+
+	for (p = 0; p < RTE_DIM(policies); p++) {
+		for (c = 0; c < RTE_DIM(member_counts); c++) {
+			TEST_ASSERT_SUCCESS(balance_tx_hash_member_selection(
+					policies[p], member_counts[c], 0, 1),
+					"IPv4 member selection failed");
+			TEST_ASSERT_SUCCESS(balance_tx_hash_member_selection(
+					policies[p], member_counts[c], 1, 0),
+					"VLAN IPv6 member selection failed");
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
 #define TEST_BAL_MEMBER_TX_FAIL_MEMBER_COUNT			(2)
 #define TEST_BAL_MEMBER_TX_FAIL_BURST_SIZE_1			(40)
 #define TEST_BAL_MEMBER_TX_FAIL_BURST_SIZE_2			(20)
@@ -5186,6 +5359,7 @@ static struct unit_test_suite link_bonding_test_suite  = {
 		TEST_CASE(test_balance_l34_tx_burst_ipv6_toggle_ip_addr),
 		TEST_CASE(test_balance_l34_tx_burst_vlan_ipv6_toggle_ip_addr),
 		TEST_CASE(test_balance_l34_tx_burst_ipv6_toggle_udp_port),
+		TEST_CASE(test_balance_tx_hash_member_selection),
 		TEST_CASE(test_balance_tx_burst_member_tx_fail),
 		TEST_CASE(test_balance_rx_burst),
 		TEST_CASE(test_balance_verify_promiscuous_enable_disable),
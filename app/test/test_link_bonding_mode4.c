@@ -421,10 +421,13 @@ test_setup(void)
 		}
 
 		if (port->port_id == INVALID_PORT_ID) {
+			/* Second Tx queue for a dedicated LACP queue, same ring */
+			struct rte_ring *tx_rings[] = { port->tx_queue, port->tx_queue };
+
 			retval = snprintf(name, RTE_DIM(name), MEMBER_DEV_NAME_FMT, i);
 			TEST_ASSERT(retval < (int)RTE_DIM(name) - 1, "Name too long");
 			retval = rte_eth_from_rings(name, &port->rx_queue, 1,
-					&port->tx_queue, 1, socket_id);
+					tx_rings, RTE_DIM(tx_rings), socket_id);
 			TEST_ASSERT(retval >= 0,
 				"Failed to create ring ethdev '%s'\n", name);
 
@@ -1515,6 +1518,203 @@ test_mode4_ext_lacp(void)
 	return TEST_SUCCESS;
 }
 
+/* Packets sent through a member Tx queue, from the ethdev queue xstats */
+static uint64_t
+member_txq_packets(struct member_conf *member, uint16_t queue_id)
+{
+	char name[RTE_ETH_XSTATS_NAME_SIZE];
+	uint64_t id, value = 0;
+
+	snprintf(name, sizeof(name), "tx_q%u_packets", queue_id);
+	if (rte_eth_xstats_get_id_by_name(member->port_id, name, &id) == 0)
+		rte_eth_xstats_get_by_id(member->port_id, &id, &value, 1);
+
+	return value;
+}
+
+/* Stop the bonding device and the dedicated Tx queue, and drain members */
+static int
+dedicated_txq_stop(void)
+{
+	struct rte_mbuf *buf[MAX_PKT_BURST];
+	struct member_conf *member;
+	int nb_pkts;
+	uint8_t i;
+
+	TEST_ASSERT_SUCCESS(rte_eth_dev_stop(test_params.bonding_port_id),
+			"Failed to stop bonding port %u",
+			test_params.bonding_port_id);
+	TEST_ASSERT_SUCCESS(rte_eth_bond_8023ad_dedicated_txq_disable(
+			test_params.bonding_port_id),
+			"Failed to disable dedicated Tx queue");
+
+	/* The periodic callback kept sending until the device stopped */
+	FOR_EACH_MEMBER(i, member) {
+		while ((nb_pkts = member_get_pkts(member, buf, RTE_DIM(buf))) > 0)
+			free_pkts(buf, nb_pkts);
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* Restart the bonding device with a dedicated Tx queue on members */
+static int
+dedicated_txq_start(void)
+{
+	TEST_ASSERT_SUCCESS(rte_eth_dev_stop(test_params.bonding_port_id),
+			"Failed to stop bonding port %u",
+			test_params.bonding_port_id);
+	TEST_ASSERT_SUCCESS(rte_eth_bond_8023ad_dedicated_txq_enable(
+			test_params.bonding_port_id),
+			"Failed to enable dedicated Tx queue");
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(test_params.bonding_port_id),
+			"Failed to start bonding device");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * With only a dedicated Tx queue, LACPDUs are sent by the mode 4 periodic
+ * callback: the handshake completes without calling the bonding Tx burst,
+ * and all slow packets go through the extra member queue.
+ */
+static int
+test_mode4_tx_only(void)
+{
+	struct member_conf *member;
+	struct rte_mbuf *buf[MAX_PKT_BURST];
+	uint64_t txq0[MEMBER_COUNT], txq1[MEMBER_COUNT];
+	uint8_t all_members_done = 0, i, j;
+	const unsigned int delay = bond_get_update_timeout_ms();
+	uint16_t nb_pkts;
+	int retval;
+
+	retval = initialize_bonding_device_with_members(TEST_LACP_MEMBER_COUT, 0);
+	TEST_ASSERT_SUCCESS(retval, "Failed to initialize bonding device");
+	TEST_ASSERT_SUCCESS(dedicated_txq_start(), "Failed to restart bonding device");
+
+	FOR_EACH_MEMBER(i, member) {
+		txq0[i] = member_txq_packets(member, 0);
+		txq1[i] = member_txq_packets(member, 1);
+	}
+
+	for (i = 0; i < 30 && all_members_done == 0; ++i) {
+		rte_delay_ms(delay);
+
+		all_members_done = 1;
+		FOR_EACH_MEMBER(j, member) {
+			if (bond_handshake_reply(member) < 0 ||
+					!bond_handshake_done(member))
+				all_members_done = 0;
+		}
+
+		/* Replies are filtered from Rx, nothing is sent on Tx */
+		nb_pkts = bond_rx(buf, RTE_DIM(buf));
+		free_pkts(buf, nb_pkts);
+		TEST_ASSERT_EQUAL(nb_pkts, 0, "Packets received unexpectedly");
+	}
+	TEST_ASSERT_EQUAL(all_members_done, 1,
+			"Bond handshake failed without Tx burst\n");
+
+	FOR_EACH_MEMBER(i, member) {
+		TEST_ASSERT_EQUAL(member_txq_packets(member, 0), txq0[i],
+				"Member %u sent slow packets on its data queue",
+				member->port_id);
+		TEST_ASSERT(member_txq_packets(member, 1) > txq1[i],
+				"Member %u sent nothing on its dedicated queue",
+				member->port_id);
+	}
+
+	TEST_ASSERT_SUCCESS(dedicated_txq_stop(), "Failed to stop dedicated Tx queue");
+	retval = remove_members_and_stop_bonding_device();
+	TEST_ASSERT_SUCCESS(retval, "Test cleanup failed.");
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * With an external state machine and a dedicated Tx queue, slow packets
+ * given to rte_eth_bond_8023ad_ext_slowtx() are flushed by the periodic
+ * callback through the dedicated queue.
+ */
+static int
+test_mode4_ext_lacp_tx_only(void)
+{
+	struct member_conf *member = NULL;
+	struct rte_mbuf *lacp_tx_buf[MEMBER_COUNT];
+	struct rte_mbuf *buf[MEMBER_COUNT];
+	uint64_t txq1[MEMBER_COUNT];
+	uint8_t sent[MEMBER_COUNT] = { 0 };
+	uint8_t all_members_done = 0, i, j;
+	const unsigned int delay = bond_get_update_timeout_ms();
+	struct rte_ether_addr src_mac, dst_mac;
+	struct lacpdu_header lacpdu = {
+		.lacpdu = {
+			.subtype = SLOW_SUBTYPE_LACP,
+		},
+	};
+	uint16_t nb_pkts;
+	int retval;
+
+	rte_ether_addr_copy(&parnter_system, &src_mac);
+	rte_ether_addr_copy(&slow_protocol_mac_addr, &dst_mac);
+
+	initialize_eth_header(&lacpdu.eth_hdr, &src_mac, &dst_mac,
+			      RTE_ETHER_TYPE_SLOW, 0, 0);
+
+	for (i = 0; i < MEMBER_COUNT; i++) {
+		lacp_tx_buf[i] = rte_pktmbuf_alloc(test_params.mbuf_pool);
+		TEST_ASSERT_NOT_NULL(lacp_tx_buf[i], "Failed to allocate LACPDU");
+		rte_memcpy(rte_pktmbuf_mtod(lacp_tx_buf[i], char *),
+			   &lacpdu, sizeof(lacpdu));
+		rte_pktmbuf_pkt_len(lacp_tx_buf[i]) = sizeof(lacpdu);
+		rte_pktmbuf_data_len(lacp_tx_buf[i]) = sizeof(lacpdu);
+	}
+
+	retval = initialize_bonding_device_with_members(TEST_TX_MEMBER_COUNT, 1);
+	TEST_ASSERT_SUCCESS(retval, "Failed to initialize bonding device");
+	TEST_ASSERT_SUCCESS(dedicated_txq_start(), "Failed to restart bonding device");
+
+	/* Wait for new settings to be applied. */
+	for (i = 0; i < 30; ++i)
+		rte_delay_ms(delay);
+
+	FOR_EACH_MEMBER(i, member) {
+		txq1[i] = member_txq_packets(member, 1);
+		retval = rte_eth_bond_8023ad_ext_slowtx(test_params.bonding_port_id,
+				member->port_id, lacp_tx_buf[i]);
+		TEST_ASSERT_SUCCESS(retval, "Member should allow manual LACP xmit");
+	}
+
+	/* No Tx burst, the periodic callback sends the packets */
+	for (i = 0; i < 30 && all_members_done == 0; ++i) {
+		rte_delay_ms(delay);
+
+		all_members_done = 1;
+		FOR_EACH_MEMBER(j, member) {
+			nb_pkts = member_get_pkts(member, buf, RTE_DIM(buf));
+			free_pkts(buf, nb_pkts);
+			sent[j] += nb_pkts;
+			if (sent[j] == 0)
+				all_members_done = 0;
+		}
+	}
+
+	FOR_EACH_MEMBER(i, member) {
+		TEST_ASSERT_EQUAL(sent[i], 1, "Member %u sent %u LACPDUs, expected 1",
+				member->port_id, sent[i]);
+		TEST_ASSERT_EQUAL(member_txq_packets(member, 1), txq1[i] + 1,
+				"Member %u LACPDU not sent on its dedicated queue",
+				member->port_id);
+	}
+
+	TEST_ASSERT_SUCCESS(dedicated_txq_stop(), "Failed to stop dedicated Tx queue");
+	retval = remove_members_and_stop_bonding_device();
+	TEST_ASSERT_SUCCESS(retval, "Test cleanup failed.");
+
+	return TEST_SUCCESS;
+}
+
 static int
 check_environment(void)
 {
@@ -1648,6 +1848,18 @@ test_mode4_ext_lacp_wrapper(void)
 	return test_mode4_executor(&test_mode4_ext_lacp);
 }
 
+static int
+test_mode4_tx_only_wrapper(void)
+{
+	return test_mode4_executor(&test_mode4_tx_only);
+}
+
+static int
+test_mode4_ext_lacp_tx_only_wrapper(void)
+{
+	return test_mode4_executor(&test_mode4_ext_lacp_tx_only);
+}
+
 static struct unit_test_suite link_bonding_mode4_test_suite  = {
 	.suite_name = "Link Bonding mode 4 Unit Test Suite",
 	.setup = test_setup,
@@ -1664,6 +1876,10 @@ static struct unit_test_suite link_bonding_mode4_test_suite  = {
 				test_mode4_ext_ctrl_wrapper),
 		TEST_CASE_NAMED("test_mode4_ext_lacp",
 				test_mode4_ext_lacp_wrapper),
+		TEST_CASE_NAMED("test_mode4_tx_only",
+				test_mode4_tx_only_wrapper),
+		TEST_CASE_NAMED("test_mode4_ext_lacp_tx_only",
+				test_mode4_ext_lacp_tx_only_wrapper),
 
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
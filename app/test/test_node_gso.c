@@ -0,0 +1,480 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_gso(void)
+{
+	printf("node_gso not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_bus_vdev.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_feature_arc.h>
+#include <rte_graph_feature_arc_worker.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_node_gro_gso_api.h>
+#include <rte_node_ip4_api.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#define GSO_TEST_VDEV		"net_null_node_gso"
+#define GSO_TEST_GRAPH		"node_gso_graph"
+#define GSO_TEST_SRC_NAME	"test_node_gso_source"
+#define GSO_TEST_SINK_NAME	"test_node_gso_sink"
+#define GSO_TEST_SEG_SIZE	256
+#define GSO_TEST_SMALL_PAYLOAD	100
+#define GSO_TEST_BIG_PAYLOAD	1000
+#define GSO_TEST_BURST		32
+#define GSO_TEST_MAX_OUT	512
+
+#define GSO_TEST_HDR_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_tcp_hdr))
+
+static struct gso_test {
+	struct rte_mempool *mp;
+	rte_graph_feature_arc_t arc;
+	rte_graph_t graph_id;
+	uint16_t port;
+	/* Burst generated by the source on next walk */
+	struct rte_mbuf *in[GSO_TEST_BURST];
+	uint16_t nb_in;
+	/* Packets received by the feature after gso, in order */
+	struct rte_mbuf *out[GSO_TEST_MAX_OUT];
+	uint16_t nb_out;
+} gso_test;
+
+static uint16_t
+test_node_gso_source(struct rte_graph *graph, struct rte_node *node,
+		     void **objs, uint16_t nb_objs)
+{
+	uint16_t nb_in = gso_test.nb_in;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (nb_in == 0)
+		return 0;
+
+	rte_node_enqueue(graph, node, 0, (void **)gso_test.in, nb_in);
+	gso_test.nb_in = 0;
+
+	return nb_in;
+}
+
+static struct rte_node_register test_node_gso_source_node = {
+	.name = GSO_TEST_SRC_NAME,
+	.process = test_node_gso_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {
+		[0] = "gso",
+	},
+};
+
+RTE_NODE_REGISTER(test_node_gso_source_node);
+
+static uint16_t
+test_node_gso_sink(struct rte_graph *graph, struct rte_node *node,
+		   void **objs, uint16_t nb_objs)
+{
+	uint16_t i;
+
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	for (i = 0; i < nb_objs; i++) {
+		if (gso_test.nb_out < GSO_TEST_MAX_OUT)
+			gso_test.out[gso_test.nb_out++] = objs[i];
+		else
+			rte_pktmbuf_free(objs[i]);
+	}
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_node_gso_sink_node = {
+	.name = GSO_TEST_SINK_NAME,
+	.process = test_node_gso_sink,
+	.nb_edges = 1,
+	.next_nodes = {
+		[0] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(test_node_gso_sink_node);
+
+/* Feature right after gso, collecting what it outputs */
+static struct rte_graph_feature_register test_node_gso_sink_feature = {
+	.feature_name = GSO_TEST_SINK_NAME,
+	.arc_name = RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+	.feature_process_fn = test_node_gso_sink,
+	.feature_node = &test_node_gso_sink_node,
+	.runs_after = RTE_NODE_GSO_FEATURE_NAME,
+};
+
+/* Payload byte of a packet, unique enough to tell packets of a burst apart */
+static inline uint8_t
+gso_test_payload_byte(uint16_t pkt, uint32_t off)
+{
+	return (uint8_t)(pkt * 31 + off + 1);
+}
+
+static struct rte_mbuf *
+gso_test_pkt_create(uint16_t pkt, uint8_t proto, uint16_t payload_len)
+{
+	struct rte_graph_feature_arc *arc = rte_graph_feature_arc_get(gso_test.arc);
+	struct rte_graph_feature_arc_mbuf_dynfields *mbfields;
+	rte_graph_feature_data_t fdata;
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *mbuf;
+	uint16_t l4_len, edge;
+	uint8_t *payload;
+	uint32_t i;
+
+	mbuf = rte_pktmbuf_alloc(gso_test.mp);
+	if (mbuf == NULL)
+		return NULL;
+
+	l4_len = proto == IPPROTO_TCP ? sizeof(struct rte_tcp_hdr) : sizeof(struct rte_udp_hdr);
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(mbuf,
+			sizeof(*eth) + sizeof(*ip) + l4_len + payload_len);
+	if (eth == NULL) {
+		rte_pktmbuf_free(mbuf);
+		return NULL;
+	}
+	memset(eth, 0, sizeof(*eth) + sizeof(*ip) + l4_len);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + l4_len + payload_len);
+	ip->time_to_live = IPDEFTTL;
+	ip->next_proto_id = proto;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(198, 18, 1, 1));
+
+	if (proto == IPPROTO_TCP) {
+		struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)(ip + 1);
+
+		tcp->src_port = RTE_BE16(1024);
+		tcp->dst_port = RTE_BE16(9);
+		tcp->sent_seq = rte_cpu_to_be_32(pkt * 65536);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+	} else {
+		struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(ip + 1);
+
+		udp->src_port = RTE_BE16(1024);
+		udp->dst_port = RTE_BE16(9);
+		udp->dgram_len = rte_cpu_to_be_16(l4_len + payload_len);
+	}
+
+	payload = RTE_PTR_ADD(ip + 1, l4_len);
+	for (i = 0; i < payload_len; i++)
+		payload[i] = gso_test_payload_byte(pkt, i);
+
+	mbuf->port = gso_test.port;
+
+	/* As done by the arc start node, gso being the first enabled feature */
+	mbfields = rte_graph_feature_arc_mbuf_dynfields_get(mbuf, arc->mbuf_dyn_offset);
+	if (!rte_graph_feature_data_first_feature_get(arc, gso_test.port, &fdata, &edge)) {
+		rte_pktmbuf_free(mbuf);
+		return NULL;
+	}
+	mbfields->feature_data = fdata;
+
+	return mbuf;
+}
+
+static void
+gso_test_out_free(void)
+{
+	rte_pktmbuf_free_bulk(gso_test.out, gso_test.nb_out);
+	gso_test.nb_out = 0;
+}
+
+/* Check TCP segments of big packet pkt, starting at out[*idx] */
+static int
+gso_test_tcp_segs_check(uint16_t pkt, uint16_t *idx)
+{
+	uint8_t buf[GSO_TEST_SEG_SIZE];
+	const struct rte_ipv4_hdr *ip;
+	const struct rte_tcp_hdr *tcp;
+	const uint8_t *payload;
+	uint32_t off = 0, len, i;
+	struct rte_mbuf *seg;
+
+	while (off < GSO_TEST_BIG_PAYLOAD) {
+		TEST_ASSERT(*idx < gso_test.nb_out, "Missing segments of packet %u", pkt);
+		seg = gso_test.out[(*idx)++];
+
+		TEST_ASSERT(rte_pktmbuf_pkt_len(seg) <= GSO_TEST_SEG_SIZE,
+			    "Segment of %u bytes", rte_pktmbuf_pkt_len(seg));
+		TEST_ASSERT(rte_pktmbuf_pkt_len(seg) > GSO_TEST_HDR_LEN,
+			    "Packet %u output out of order", pkt);
+
+		ip = rte_pktmbuf_read(seg, sizeof(struct rte_ether_hdr),
+				      sizeof(*ip) + sizeof(*tcp), buf);
+		tcp = (const struct rte_tcp_hdr *)(ip + 1);
+		TEST_ASSERT_EQUAL(rte_ipv4_cksum(ip), 0, "Bad IPv4 checksum");
+		TEST_ASSERT_SUCCESS(rte_ipv4_udptcp_cksum_mbuf_verify(seg, ip,
+					sizeof(struct rte_ether_hdr) + sizeof(*ip)),
+				    "Bad TCP checksum");
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_32(tcp->sent_seq), pkt * 65536 + off,
+				  "Packet %u segment out of order", pkt);
+
+		len = rte_pktmbuf_pkt_len(seg) - GSO_TEST_HDR_LEN;
+		payload = rte_pktmbuf_read(seg, GSO_TEST_HDR_LEN, len, buf);
+		for (i = 0; i < len; i++)
+			TEST_ASSERT_EQUAL(payload[i], gso_test_payload_byte(pkt, off + i),
+					  "Packet %u payload mismatch at %u", pkt, off + i);
+		off += len;
+	}
+	TEST_ASSERT_EQUAL(off, GSO_TEST_BIG_PAYLOAD, "Packet %u payload length", pkt);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * Walk the graph once with a TCP burst where big[i] tells which packets are
+ * over the segment size, and check gso output keeps the burst order.
+ */
+static int
+gso_test_tcp_burst(const uint8_t *big, uint16_t nb_pkts)
+{
+	uint16_t i, idx = 0;
+	int ret;
+
+	for (i = 0; i < nb_pkts; i++) {
+		gso_test.in[i] = gso_test_pkt_create(i, IPPROTO_TCP,
+				big[i] ? GSO_TEST_BIG_PAYLOAD : GSO_TEST_SMALL_PAYLOAD);
+		TEST_ASSERT_NOT_NULL(gso_test.in[i], "Failed to create packet");
+	}
+	gso_test.nb_in = nb_pkts;
+	gso_test.nb_out = 0;
+
+	rte_graph_walk(rte_graph_lookup(GSO_TEST_GRAPH));
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (!big[i]) {
+			TEST_ASSERT(idx < gso_test.nb_out, "Packet %u missing", i);
+			TEST_ASSERT(gso_test.out[idx] == gso_test.in[i],
+				    "Packet %u out of order", i);
+			idx++;
+			continue;
+		}
+		ret = gso_test_tcp_segs_check(i, &idx);
+		if (ret != TEST_SUCCESS)
+			goto exit;
+	}
+	ret = TEST_SUCCESS;
+	if (idx != gso_test.nb_out) {
+		printf("%u unexpected packets after the burst\n", gso_test.nb_out - idx);
+		ret = TEST_FAILED;
+	}
+
+exit:
+	gso_test_out_free();
+	return ret;
+}
+
+static int
+test_gso_small_pkts(void)
+{
+	uint8_t big[GSO_TEST_BURST] = {0};
+
+	TEST_ASSERT_SUCCESS(gso_test_tcp_burst(big, GSO_TEST_BURST), "Walk failed");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_mixed_pkts(void)
+{
+	uint8_t big[GSO_TEST_BURST] = {0};
+
+	/* Oversized packets after speculated ones, back to back and last */
+	big[3] = 1;
+	big[4] = 1;
+	big[10] = 1;
+	big[GSO_TEST_BURST - 1] = 1;
+
+	/* First walk trains the speculated next, second one takes it */
+	TEST_ASSERT_SUCCESS(gso_test_tcp_burst(big, GSO_TEST_BURST), "First walk failed");
+	TEST_ASSERT_SUCCESS(gso_test_tcp_burst(big, GSO_TEST_BURST), "Second walk failed");
+
+	/* Oversized first packet */
+	memset(big, 0, sizeof(big));
+	big[0] = 1;
+	big[GSO_TEST_BURST / 2] = 1;
+	TEST_ASSERT_SUCCESS(gso_test_tcp_burst(big, GSO_TEST_BURST), "Third walk failed");
+
+	/* Only oversized packets */
+	memset(big, 1, sizeof(big));
+	TEST_ASSERT_SUCCESS(gso_test_tcp_burst(big, 4), "Fourth walk failed");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gso_udp_fragments(void)
+{
+	uint8_t frag[GSO_TEST_SEG_SIZE], udp[sizeof(struct rte_udp_hdr)];
+	const struct rte_ipv4_hdr *ip;
+	const uint8_t *data;
+	uint32_t off = 0, len, i;
+	struct rte_mbuf *seg;
+	uint16_t idx;
+	int ret = TEST_FAILED;
+
+	gso_test.in[0] = gso_test_pkt_create(0, IPPROTO_UDP, GSO_TEST_BIG_PAYLOAD);
+	TEST_ASSERT_NOT_NULL(gso_test.in[0], "Failed to create packet");
+	gso_test.nb_in = 1;
+	gso_test.nb_out = 0;
+	memcpy(udp, rte_pktmbuf_mtod_offset(gso_test.in[0], void *,
+					    sizeof(struct rte_ether_hdr) + sizeof(*ip)),
+	       sizeof(udp));
+
+	rte_graph_walk(rte_graph_lookup(GSO_TEST_GRAPH));
+
+	if (gso_test.nb_out < 2) {
+		printf("Datagram not fragmented\n");
+		goto exit;
+	}
+
+	/* Fragments payload must be the datagram, header included */
+	for (idx = 0; idx < gso_test.nb_out; idx++) {
+		seg = gso_test.out[idx];
+		ip = rte_pktmbuf_read(seg, sizeof(struct rte_ether_hdr), sizeof(*ip), frag);
+		if (rte_ipv4_cksum(ip) != 0) {
+			printf("Bad IPv4 checksum in fragment %u\n", idx);
+			goto exit;
+		}
+		if ((rte_be_to_cpu_16(ip->fragment_offset) & RTE_IPV4_HDR_OFFSET_MASK) * 8 !=
+				off) {
+			printf("Fragment %u at wrong offset\n", idx);
+			goto exit;
+		}
+
+		len = rte_be_to_cpu_16(ip->total_length) - sizeof(*ip);
+		data = rte_pktmbuf_read(seg, sizeof(struct rte_ether_hdr) + sizeof(*ip),
+					len, frag);
+		for (i = 0; i < len; i++, off++) {
+			uint8_t exp = off < sizeof(udp) ? udp[off] :
+				gso_test_payload_byte(0, off - sizeof(udp));
+
+			if (data[i] != exp) {
+				printf("Fragment %u mismatch at %u\n", idx, off);
+				goto exit;
+			}
+		}
+	}
+	if (off != sizeof(udp) + GSO_TEST_BIG_PAYLOAD) {
+		printf("Fragments hold %u bytes\n", off);
+		goto exit;
+	}
+
+	ret = TEST_SUCCESS;
+exit:
+	gso_test_out_free();
+	return ret;
+}
+
+static int
+node_gso_setup(void)
+{
+	const char *patterns[] = {GSO_TEST_SRC_NAME};
+	struct rte_graph_param gconf = {0};
+
+	gso_test.graph_id = RTE_GRAPH_ID_INVALID;
+	if (rte_vdev_init(GSO_TEST_VDEV, NULL) < 0) {
+		printf("Failed to create %s, skipping\n", GSO_TEST_VDEV);
+		return TEST_SKIPPED;
+	}
+	TEST_ASSERT_SUCCESS(rte_eth_dev_get_port_by_name(GSO_TEST_VDEV, &gso_test.port),
+			    "Failed to get port of %s", GSO_TEST_VDEV);
+
+	gso_test.mp = rte_pktmbuf_pool_create("node_gso", 2048, 0, 0,
+					      RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(gso_test.mp, "Failed to create mempool");
+
+	TEST_ASSERT_SUCCESS(rte_graph_feature_arc_init(0), "Failed to init feature arcs");
+	TEST_ASSERT_SUCCESS(rte_graph_feature_arc_lookup_by_name(RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+								 &gso_test.arc),
+			    "ip4 output arc not found");
+	test_node_gso_sink_feature.feature_node_id = test_node_gso_sink_node.id;
+	TEST_ASSERT_SUCCESS(rte_graph_feature_add(&test_node_gso_sink_feature),
+			    "Failed to add sink feature");
+
+	gconf.socket_id = rte_socket_id();
+	gconf.nb_node_patterns = RTE_DIM(patterns);
+	gconf.node_patterns = patterns;
+	gso_test.graph_id = rte_graph_create(GSO_TEST_GRAPH, &gconf);
+	TEST_ASSERT(gso_test.graph_id != RTE_GRAPH_ID_INVALID, "Graph creation failed");
+
+	TEST_ASSERT_SUCCESS(rte_graph_feature_enable(gso_test.arc, gso_test.port,
+						     RTE_NODE_GSO_FEATURE_NAME, 0, NULL),
+			    "Failed to enable gso");
+	TEST_ASSERT_SUCCESS(rte_graph_feature_enable(gso_test.arc, gso_test.port,
+						     GSO_TEST_SINK_NAME, 0, NULL),
+			    "Failed to enable sink feature");
+	TEST_ASSERT_SUCCESS(rte_node_gso_configure(gso_test.port, GSO_TEST_SEG_SIZE),
+			    "Failed to configure gso");
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_gso_teardown(void)
+{
+	if (gso_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(gso_test.graph_id);
+	gso_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	rte_graph_feature_arc_cleanup();
+
+	if (rte_eth_dev_get_port_by_name(GSO_TEST_VDEV, &gso_test.port) == 0) {
+		rte_node_gso_configure(gso_test.port, 0);
+		rte_vdev_uninit(GSO_TEST_VDEV);
+	}
+	rte_mempool_free(gso_test.mp);
+	gso_test.mp = NULL;
+}
+
+static struct unit_test_suite node_gso_testsuite = {
+	.suite_name = "Node gso test suite",
+	.setup = node_gso_setup,
+	.teardown = node_gso_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_gso_mixed_pkts),
+		TEST_CASE(test_gso_small_pkts),
+		TEST_CASE(test_gso_udp_fragments),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_gso(void)
+{
+	return unit_test_suite_runner(&node_gso_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_gso_autotest, NOHUGE_OK, ASAN_OK, test_node_gso);
@@ -0,0 +1,488 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_neigh(void)
+{
+	printf("node_neigh not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_arp.h>
+#include <rte_eth_ring.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_node_eth_api.h>
+#include <rte_node_ip4_api.h>
+#include <rte_node_neigh_api.h>
+#include <rte_ring.h>
+
+#define NEIGH_TEST_PORT_NAME	"net_ring_node_neigh"
+#define NEIGH_TEST_GRAPH	"node_neigh_graph"
+#define NEIGH_TEST_SRC_NAME	"test_node_neigh_source"
+#define NEIGH_TEST_RING_SIZE	256
+#define NEIGH_TEST_BURST	32
+#define NEIGH_TEST_NH		7
+#define NEIGH_TEST_PORT_IP	RTE_IPV4(192, 0, 2, 1)
+#define NEIGH_TEST_NEIGH_IP	RTE_IPV4(198, 51, 100, 1)
+#define NEIGH_TEST_OTHER_IP	RTE_IPV4(198, 51, 100, 2)
+#define NEIGH_TEST_PKT_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + 64)
+
+enum {
+	NEIGH_TEST_NEXT_IP4_LOOKUP,
+	NEIGH_TEST_NEXT_ARP_INPUT,
+};
+
+static struct neigh_test {
+	struct rte_mempool *mp;
+	struct rte_ring *rx_ring;
+	/* Port Tx, where solicitations and resolved packets are checked */
+	struct rte_ring *tx_ring;
+	struct rte_ether_addr port_mac;
+	rte_graph_t graph_id;
+	uint16_t port;
+	/* Burst generated by the source on next walk */
+	struct rte_mbuf *in[NEIGH_TEST_BURST];
+	uint16_t nb_in;
+	rte_edge_t next;
+} neigh_test;
+
+static const struct rte_ether_addr neigh_test_mac1 = {
+	.addr_bytes = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 } };
+static const struct rte_ether_addr neigh_test_mac2 = {
+	.addr_bytes = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 } };
+
+static uint16_t
+test_node_neigh_source(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	uint16_t nb_in = neigh_test.nb_in;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (nb_in == 0)
+		return 0;
+
+	rte_node_enqueue(graph, node, neigh_test.next, (void **)neigh_test.in, nb_in);
+	neigh_test.nb_in = 0;
+
+	return nb_in;
+}
+
+static struct rte_node_register test_node_neigh_source_node = {
+	.name = NEIGH_TEST_SRC_NAME,
+	.process = test_node_neigh_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 2,
+	.next_nodes = {
+		[NEIGH_TEST_NEXT_IP4_LOOKUP] = "ip4_lookup",
+		[NEIGH_TEST_NEXT_ARP_INPUT] = "arp_input",
+	},
+};
+
+RTE_NODE_REGISTER(test_node_neigh_source_node);
+
+static struct rte_mbuf *
+neigh_test_ip4_pkt_create(uint32_t dst)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *mbuf;
+
+	mbuf = rte_pktmbuf_alloc(neigh_test.mp);
+	if (mbuf == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(mbuf, NEIGH_TEST_PKT_LEN);
+	if (eth == NULL) {
+		rte_pktmbuf_free(mbuf);
+		return NULL;
+	}
+	memset(eth, 0, NEIGH_TEST_PKT_LEN);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(NEIGH_TEST_PKT_LEN - sizeof(*eth));
+	ip->time_to_live = IPDEFTTL;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(203, 0, 113, 1));
+	ip->dst_addr = rte_cpu_to_be_32(dst);
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4;
+	mbuf->port = neigh_test.port;
+
+	return mbuf;
+}
+
+static struct rte_mbuf *
+neigh_test_arp_create(uint16_t op, uint32_t sip, const struct rte_ether_addr *sha)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_arp_hdr *arp;
+	struct rte_mbuf *mbuf;
+
+	mbuf = rte_pktmbuf_alloc(neigh_test.mp);
+	if (mbuf == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(mbuf, sizeof(*eth) + sizeof(*arp));
+	if (eth == NULL) {
+		rte_pktmbuf_free(mbuf);
+		return NULL;
+	}
+	rte_ether_addr_copy(&neigh_test.port_mac, &eth->dst_addr);
+	rte_ether_addr_copy(sha, &eth->src_addr);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_ARP);
+
+	arp = (struct rte_arp_hdr *)(eth + 1);
+	arp->arp_hardware = RTE_BE16(RTE_ARP_HRD_ETHER);
+	arp->arp_protocol = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+	arp->arp_hlen = RTE_ETHER_ADDR_LEN;
+	arp->arp_plen = sizeof(rte_be32_t);
+	arp->arp_opcode = rte_cpu_to_be_16(op);
+	rte_ether_addr_copy(sha, &arp->arp_data.arp_sha);
+	arp->arp_data.arp_sip = rte_cpu_to_be_32(sip);
+	rte_ether_addr_copy(&neigh_test.port_mac, &arp->arp_data.arp_tha);
+	arp->arp_data.arp_tip = rte_cpu_to_be_32(NEIGH_TEST_PORT_IP);
+
+	mbuf->packet_type = RTE_PTYPE_L2_ETHER_ARP;
+	mbuf->port = neigh_test.port;
+
+	return mbuf;
+}
+
+/* Walk the graph once with the given packets, return what was sent on the port */
+static int
+neigh_test_walk(struct rte_mbuf **pkts, uint16_t nb_pkts, rte_edge_t next,
+		struct rte_mbuf **out, unsigned int *nb_out)
+{
+	uint16_t i;
+
+	*nb_out = 0;
+	for (i = 0; i < nb_pkts; i++)
+		TEST_ASSERT_NOT_NULL(pkts[i], "Failed to create packet");
+
+	memcpy(neigh_test.in, pkts, nb_pkts * sizeof(pkts[0]));
+	neigh_test.nb_in = nb_pkts;
+	neigh_test.next = next;
+
+	rte_graph_walk(rte_graph_lookup(NEIGH_TEST_GRAPH));
+
+	*nb_out = rte_ring_dequeue_burst(neigh_test.tx_ring, (void **)out,
+					 NEIGH_TEST_BURST, NULL);
+
+	return TEST_SUCCESS;
+}
+
+static int
+neigh_test_ip4_walk(uint16_t nb_pkts, struct rte_mbuf **out, unsigned int *nb_out)
+{
+	struct rte_mbuf *pkts[NEIGH_TEST_BURST];
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++)
+		pkts[i] = neigh_test_ip4_pkt_create(NEIGH_TEST_NEIGH_IP);
+
+	return neigh_test_walk(pkts, nb_pkts, NEIGH_TEST_NEXT_IP4_LOOKUP, out, nb_out);
+}
+
+static int
+neigh_test_arp_walk(uint16_t op, uint32_t sip, const struct rte_ether_addr *sha,
+		    struct rte_mbuf **out, unsigned int *nb_out)
+{
+	struct rte_mbuf *pkt = neigh_test_arp_create(op, sip, sha);
+
+	return neigh_test_walk(&pkt, 1, NEIGH_TEST_NEXT_ARP_INPUT, out, nb_out);
+}
+
+/* Check packets routed to the neighbor are sent to mac */
+static int
+neigh_test_fwd_check(struct rte_mbuf **out, unsigned int nb_out,
+		     const struct rte_ether_addr *mac)
+{
+	const struct rte_ether_hdr *eth;
+	const struct rte_ipv4_hdr *ip;
+	unsigned int i;
+
+	for (i = 0; i < nb_out; i++) {
+		eth = rte_pktmbuf_mtod(out[i], const struct rte_ether_hdr *);
+		ip = (const struct rte_ipv4_hdr *)(eth + 1);
+		TEST_ASSERT_EQUAL(eth->ether_type, RTE_BE16(RTE_ETHER_TYPE_IPV4),
+				  "Packet %u is not IPv4", i);
+		TEST_ASSERT(rte_is_same_ether_addr(&eth->dst_addr, mac),
+			    "Packet %u sent to wrong MAC", i);
+		TEST_ASSERT(rte_is_same_ether_addr(&eth->src_addr, &neigh_test.port_mac),
+			    "Packet %u not sent from port MAC", i);
+		TEST_ASSERT_EQUAL(ip->dst_addr, rte_cpu_to_be_32(NEIGH_TEST_NEIGH_IP),
+				  "Packet %u has wrong destination", i);
+		TEST_ASSERT_EQUAL(rte_ipv4_cksum(ip), 0, "Packet %u bad checksum", i);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+neigh_test_arp_check(struct rte_mbuf *m, uint16_t op, const struct rte_ether_addr *dst)
+{
+	const struct rte_ether_hdr *eth = rte_pktmbuf_mtod(m, const struct rte_ether_hdr *);
+	const struct rte_arp_hdr *arp = (const struct rte_arp_hdr *)(eth + 1);
+
+	TEST_ASSERT_EQUAL(eth->ether_type, RTE_BE16(RTE_ETHER_TYPE_ARP), "Not an ARP packet");
+	TEST_ASSERT_EQUAL(arp->arp_opcode, rte_cpu_to_be_16(op), "Unexpected ARP opcode");
+	TEST_ASSERT(rte_is_same_ether_addr(&eth->dst_addr, dst), "ARP sent to wrong MAC");
+	TEST_ASSERT(rte_is_same_ether_addr(&arp->arp_data.arp_sha, &neigh_test.port_mac),
+		    "ARP sender is not the port MAC");
+	TEST_ASSERT_EQUAL(arp->arp_data.arp_sip, rte_cpu_to_be_32(NEIGH_TEST_PORT_IP),
+			  "ARP sender is not the port address");
+	TEST_ASSERT_EQUAL(arp->arp_data.arp_tip, rte_cpu_to_be_32(NEIGH_TEST_NEIGH_IP),
+			  "ARP target is not the neighbor");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_neigh_ip4_add_del(void)
+{
+	uint16_t port = neigh_test.port;
+
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH, NEIGH_TEST_NEIGH_IP, port),
+			    "Failed to add next hop");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH, NEIGH_TEST_NEIGH_IP, port),
+			    "Failed to add next hop again");
+	TEST_ASSERT_EQUAL(rte_node_ip4_neigh_add(NEIGH_TEST_NH + 1, NEIGH_TEST_NEIGH_IP, port),
+			  -EEXIST, "Same neighbor added to two next hops");
+	TEST_ASSERT_EQUAL(rte_node_ip4_neigh_add(NEIGH_TEST_NH + 1, NEIGH_TEST_OTHER_IP,
+						 RTE_MAX_ETHPORTS - 1),
+			  -EINVAL, "Next hop added on port without Tx node");
+
+	/* Changing the address of a next hop releases the previous one */
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH, NEIGH_TEST_OTHER_IP, port),
+			    "Failed to change next hop address");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH + 1, NEIGH_TEST_NEIGH_IP, port),
+			    "Previous address of next hop still in use");
+
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_del(NEIGH_TEST_NH + 1), "Failed to delete");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH, NEIGH_TEST_NEIGH_IP, port),
+			    "Address of deleted next hop still in use");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_del(NEIGH_TEST_NH), "Failed to delete");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_neigh_ip4_resolve(void)
+{
+	static const struct rte_ether_addr bcast = {
+		.addr_bytes = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+	struct rte_mbuf *out[NEIGH_TEST_BURST];
+	unsigned int nb_out = 0;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_add(NEIGH_TEST_NH, NEIGH_TEST_NEIGH_IP,
+						   neigh_test.port),
+			    "Failed to add next hop");
+
+	/* Packets are held and the neighbor solicited once */
+	if (neigh_test_ip4_walk(4, out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 1 || neigh_test_arp_check(out[0], RTE_ARP_OP_REQUEST, &bcast)) {
+		printf("Expected one ARP request, got %u packets\n", nb_out);
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(out, nb_out);
+
+	if (neigh_test_ip4_walk(4, out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 0) {
+		printf("Neighbor solicited again within retransmit interval\n");
+		goto exit;
+	}
+
+	/* Unknown sender is not learnt */
+	if (neigh_test_arp_walk(RTE_ARP_OP_REPLY, NEIGH_TEST_OTHER_IP, &neigh_test_mac1,
+				out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 0) {
+		printf("Held packets released by unknown neighbor\n");
+		goto exit;
+	}
+
+	/* Answer releases all held packets */
+	if (neigh_test_arp_walk(RTE_ARP_OP_REPLY, NEIGH_TEST_NEIGH_IP, &neigh_test_mac1,
+				out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 8 || neigh_test_fwd_check(out, nb_out, &neigh_test_mac1)) {
+		printf("Expected 8 held packets to neighbor, got %u\n", nb_out);
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(out, nb_out);
+
+	/* Request from the neighbor with a new MAC is answered and learnt in place */
+	if (neigh_test_arp_walk(RTE_ARP_OP_REQUEST, NEIGH_TEST_NEIGH_IP, &neigh_test_mac2,
+				out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 1) {
+		printf("Expected one ARP reply, got %u packets\n", nb_out);
+		goto exit;
+	}
+	/* Reply is the request turned around, target is the neighbor */
+	if (neigh_test_arp_check(out[0], RTE_ARP_OP_REPLY, &neigh_test_mac2))
+		goto exit;
+	rte_pktmbuf_free_bulk(out, nb_out);
+
+	if (neigh_test_ip4_walk(2, out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 2 || neigh_test_fwd_check(out, nb_out, &neigh_test_mac2)) {
+		printf("Packets not sent to the new neighbor MAC\n");
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(out, nb_out);
+
+	/* Deleted next hop drops its packets */
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_del(NEIGH_TEST_NH), "Failed to delete");
+	if (neigh_test_ip4_walk(2, out, &nb_out) != TEST_SUCCESS)
+		goto exit;
+	if (nb_out != 0) {
+		printf("Packets of deleted next hop sent\n");
+		goto exit;
+	}
+
+	ret = TEST_SUCCESS;
+exit:
+	rte_pktmbuf_free_bulk(out, nb_out);
+	rte_node_ip4_neigh_del(NEIGH_TEST_NH);
+	return ret;
+}
+
+static int
+node_neigh_setup(void)
+{
+	const char *patterns[] = {NEIGH_TEST_SRC_NAME};
+	struct rte_node_neigh_cfg ncfg = {
+		.hold_max = 64,
+		.hold_timeout_ms = 60000,
+		.retrans_ms = 60000,
+		.reachable_ms = 60000,
+		.max_probes = 3,
+	};
+	struct rte_node_ethdev_config conf = {0};
+	struct rte_graph_param gconf = {0};
+	struct rte_eth_conf eth_conf = {0};
+	int port, ret;
+
+	neigh_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	neigh_test.mp = rte_pktmbuf_pool_create("node_neigh", 1024, 0, RTE_CACHE_LINE_SIZE,
+						RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(neigh_test.mp, "Failed to create mempool");
+
+	neigh_test.rx_ring = rte_ring_create("node_neigh_rx", NEIGH_TEST_RING_SIZE,
+					     SOCKET_ID_ANY, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	neigh_test.tx_ring = rte_ring_create("node_neigh_tx", NEIGH_TEST_RING_SIZE,
+					     SOCKET_ID_ANY, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	TEST_ASSERT(neigh_test.rx_ring != NULL && neigh_test.tx_ring != NULL,
+		    "Failed to create rings");
+
+	port = rte_eth_from_rings(NEIGH_TEST_PORT_NAME, &neigh_test.rx_ring, 1,
+				  &neigh_test.tx_ring, 1, SOCKET_ID_ANY);
+	TEST_ASSERT(port >= 0, "Failed to create ring port");
+	neigh_test.port = port;
+
+	ret = rte_eth_dev_configure(neigh_test.port, 1, 1, &eth_conf);
+	TEST_ASSERT_SUCCESS(ret, "Failed to configure port %u", neigh_test.port);
+	ret = rte_eth_rx_queue_setup(neigh_test.port, 0, NEIGH_TEST_RING_SIZE, SOCKET_ID_ANY,
+				     NULL, neigh_test.mp);
+	TEST_ASSERT_SUCCESS(ret, "Failed to setup rx queue");
+	ret = rte_eth_tx_queue_setup(neigh_test.port, 0, NEIGH_TEST_RING_SIZE, SOCKET_ID_ANY,
+				     NULL);
+	TEST_ASSERT_SUCCESS(ret, "Failed to setup tx queue");
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(neigh_test.port), "Failed to start port");
+	TEST_ASSERT_SUCCESS(rte_eth_macaddr_get(neigh_test.port, &neigh_test.port_mac),
+			    "Failed to get port MAC");
+
+	conf.port_id = neigh_test.port;
+	conf.num_rx_queues = 1;
+	conf.num_tx_queues = 1;
+	conf.mp = &neigh_test.mp;
+	conf.mp_count = 1;
+	TEST_ASSERT_SUCCESS(rte_node_eth_config(&conf, 1, 1), "Failed to config ethdev nodes");
+
+	ncfg.pool = neigh_test.mp;
+	TEST_ASSERT_SUCCESS(rte_node_neigh_configure(&ncfg), "Failed to configure neighbors");
+	TEST_ASSERT_SUCCESS(rte_node_ip4_neigh_port_addr_set(neigh_test.port,
+							     NEIGH_TEST_PORT_IP),
+			    "Failed to set port address");
+
+	gconf.socket_id = rte_socket_id();
+	gconf.nb_node_patterns = RTE_DIM(patterns);
+	gconf.node_patterns = patterns;
+	neigh_test.graph_id = rte_graph_create(NEIGH_TEST_GRAPH, &gconf);
+	TEST_ASSERT(neigh_test.graph_id != RTE_GRAPH_ID_INVALID, "Graph creation failed");
+	/* ethdev_tx uses the graph id as Tx queue */
+	TEST_ASSERT_EQUAL(neigh_test.graph_id, 0, "Graph id %u has no Tx queue",
+			  neigh_test.graph_id);
+
+	/* Routes can only be added once lookup nodes created their tables */
+	TEST_ASSERT_SUCCESS(rte_node_ip4_route_add(NEIGH_TEST_NEIGH_IP, 32, NEIGH_TEST_NH,
+						   RTE_NODE_IP4_LOOKUP_NEXT_REWRITE),
+			    "Failed to add route");
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_neigh_teardown(void)
+{
+	if (neigh_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(neigh_test.graph_id);
+	neigh_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	if (rte_eth_dev_get_port_by_name(NEIGH_TEST_PORT_NAME, &neigh_test.port) == 0) {
+		rte_eth_dev_stop(neigh_test.port);
+		rte_eth_dev_close(neigh_test.port);
+	}
+	rte_ring_free(neigh_test.rx_ring);
+	rte_ring_free(neigh_test.tx_ring);
+	rte_mempool_free(neigh_test.mp);
+	memset(&neigh_test, 0, sizeof(neigh_test));
+}
+
+static struct unit_test_suite node_neigh_testsuite = {
+	.suite_name = "Node neighbor resolution test suite",
+	.setup = node_neigh_setup,
+	.teardown = node_neigh_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_neigh_ip4_add_del),
+		TEST_CASE(test_neigh_ip4_resolve),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_neigh(void)
+{
+	return unit_test_suite_runner(&node_neigh_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_neigh_autotest, NOHUGE_OK, ASAN_OK, test_node_neigh);
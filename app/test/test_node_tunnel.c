@@ -0,0 +1,322 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_tunnel(void)
+{
+	printf("node_tunnel not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gre.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_node_tunnel_api.h>
+#include <rte_rcu_qsbr.h>
+
+#define TUNNEL_TEST_GRAPH	"node_tunnel_graph"
+#define TUNNEL_TEST_SRC_NAME	"test_node_tunnel_source"
+#define TUNNEL_TEST_ID		3
+#define TUNNEL_TEST_KEY		100
+#define TUNNEL_TEST_LOCAL_IP	RTE_IPV4(192, 0, 2, 1)
+#define TUNNEL_TEST_REMOTE_IP	RTE_IPV4(192, 0, 2, 2)
+#define TUNNEL_TEST_RX_PORT	5
+#define TUNNEL_TEST_OVERLAY	9
+#define TUNNEL_TEST_INNER_LEN	64
+
+#define TUNNEL_TEST_OUTER_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + \
+	 sizeof(struct rte_gre_hdr) + sizeof(struct rte_gre_hdr_opt_key))
+
+static struct tunnel_test {
+	struct rte_mempool *mp;
+	rte_graph_t graph_id;
+	/* Packet generated by the source on next walk */
+	struct rte_mbuf *in;
+} tunnel_test;
+
+static uint16_t
+test_node_tunnel_source(struct rte_graph *graph, struct rte_node *node,
+			void **objs, uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (tunnel_test.in == NULL)
+		return 0;
+
+	rte_node_enqueue_x1(graph, node, 0, tunnel_test.in);
+	tunnel_test.in = NULL;
+
+	return 1;
+}
+
+static struct rte_node_register test_node_tunnel_source_node = {
+	.name = TUNNEL_TEST_SRC_NAME,
+	.process = test_node_tunnel_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {
+		[0] = "ip4_local",
+	},
+};
+
+RTE_NODE_REGISTER(test_node_tunnel_source_node);
+
+static void
+tunnel_test_conf_get(struct rte_node_tunnel_conf *conf, uint32_t key)
+{
+	memset(conf, 0, sizeof(*conf));
+	conf->type = RTE_NODE_TUNNEL_GRE;
+	conf->vni = key;
+	conf->gre_key = true;
+	conf->src_ip = TUNNEL_TEST_LOCAL_IP;
+	conf->dst_ip = TUNNEL_TEST_REMOTE_IP;
+	conf->overlay_port = TUNNEL_TEST_OVERLAY;
+}
+
+/* GRE packet with a key received from the remote end of the tunnel */
+static struct rte_mbuf *
+tunnel_test_gre_create(uint32_t key)
+{
+	struct rte_gre_hdr_opt_key *opt;
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_gre_hdr *gre;
+	struct rte_mbuf *mbuf;
+
+	mbuf = rte_pktmbuf_alloc(tunnel_test.mp);
+	if (mbuf == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(mbuf,
+			TUNNEL_TEST_OUTER_LEN + TUNNEL_TEST_INNER_LEN);
+	if (eth == NULL) {
+		rte_pktmbuf_free(mbuf);
+		return NULL;
+	}
+	memset(eth, 0, TUNNEL_TEST_OUTER_LEN + TUNNEL_TEST_INNER_LEN);
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(rte_pktmbuf_pkt_len(mbuf) - sizeof(*eth));
+	ip->time_to_live = IPDEFTTL;
+	ip->next_proto_id = IPPROTO_GRE;
+	ip->src_addr = rte_cpu_to_be_32(TUNNEL_TEST_REMOTE_IP);
+	ip->dst_addr = rte_cpu_to_be_32(TUNNEL_TEST_LOCAL_IP);
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	gre = (struct rte_gre_hdr *)(ip + 1);
+	gre->k = 1;
+	gre->proto = RTE_BE16(RTE_ETHER_TYPE_TEB);
+	opt = (struct rte_gre_hdr_opt_key *)(gre + 1);
+	opt->key = rte_cpu_to_be_32(key);
+
+	/* Inner frame of a protocol not forwarded any further */
+	eth = (struct rte_ether_hdr *)(opt + 1);
+	eth->ether_type = RTE_BE16(0x88b5);
+
+	mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4;
+	mbuf->port = TUNNEL_TEST_RX_PORT;
+
+	return mbuf;
+}
+
+/*
+ * Walk a GRE packet, with trim bytes cut from its end, through ip4_local
+ * and tell whether it was decapsulated.
+ */
+static int
+tunnel_test_decap(uint32_t key, uint16_t trim, bool *decap)
+{
+	struct rte_mbuf *mbuf = tunnel_test_gre_create(key);
+
+	TEST_ASSERT_NOT_NULL(mbuf, "Failed to create packet");
+	TEST_ASSERT_SUCCESS(rte_pktmbuf_trim(mbuf, trim), "Failed to trim packet");
+
+	/* Keep the packet around once freed by the graph */
+	rte_mbuf_refcnt_update(mbuf, 1);
+	tunnel_test.in = mbuf;
+	rte_graph_walk(rte_graph_lookup(TUNNEL_TEST_GRAPH));
+
+	*decap = mbuf->port == TUNNEL_TEST_OVERLAY;
+	if (*decap && rte_pktmbuf_data_len(mbuf) != TUNNEL_TEST_INNER_LEN - trim) {
+		printf("Decapsulated packet has %u bytes\n", rte_pktmbuf_data_len(mbuf));
+		*decap = false;
+	}
+	if (rte_mbuf_refcnt_read(mbuf) != 1) {
+		printf("Packet still held by the graph\n");
+		*decap = false;
+	}
+	rte_pktmbuf_free(mbuf);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_tunnel_add_del(void)
+{
+	struct rte_node_tunnel_conf conf;
+	struct rte_rcu_qsbr *rcu;
+	size_t sz;
+
+	tunnel_test_conf_get(&conf, TUNNEL_TEST_KEY);
+	TEST_ASSERT_EQUAL(rte_node_tunnel_add(RTE_NODE_TUNNEL_MAX, &conf), -EINVAL,
+			  "Tunnel added with invalid id");
+	TEST_ASSERT_EQUAL(rte_node_tunnel_add(TUNNEL_TEST_ID, NULL), -EINVAL,
+			  "Tunnel added without configuration");
+	conf.type = RTE_NODE_TUNNEL_TYPE_MAX;
+	TEST_ASSERT_EQUAL(rte_node_tunnel_add(TUNNEL_TEST_ID, &conf), -EINVAL,
+			  "Tunnel added with invalid type");
+
+	tunnel_test_conf_get(&conf, TUNNEL_TEST_KEY);
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_add(TUNNEL_TEST_ID, &conf), "Failed to add tunnel");
+
+	/* RCU must be set up before the first tunnel */
+	TEST_ASSERT_EQUAL(rte_node_tunnel_rcu_qsbr_add(NULL), -EINVAL,
+			  "NULL RCU variable registered");
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	rcu = rte_zmalloc("node_tunnel_rcu", sz, RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_NOT_NULL(rcu, "Failed to allocate RCU variable");
+	TEST_ASSERT_SUCCESS(rte_rcu_qsbr_init(rcu, RTE_MAX_LCORE), "Failed to init RCU variable");
+	TEST_ASSERT_EQUAL(rte_node_tunnel_rcu_qsbr_add(rcu), -EBUSY,
+			  "RCU variable registered after tunnels");
+	rte_free(rcu);
+
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_del(TUNNEL_TEST_ID), "Failed to delete tunnel");
+	TEST_ASSERT_EQUAL(rte_node_tunnel_del(TUNNEL_TEST_ID), -ENOENT,
+			  "Tunnel deleted twice");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_tunnel_gre_decap(void)
+{
+	struct rte_node_tunnel_conf conf;
+	bool decap;
+
+	/* No tunnel, packet is dropped as is */
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY, 0, &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet decapsulated without tunnel");
+
+	tunnel_test_conf_get(&conf, TUNNEL_TEST_KEY);
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_add(TUNNEL_TEST_ID, &conf), "Failed to add tunnel");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY, 0, &decap), "Walk failed");
+	TEST_ASSERT(decap, "Packet of the tunnel not decapsulated");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY + 1, 0, &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet with another key decapsulated");
+
+	/* Updating the tunnel replaces its key */
+	tunnel_test_conf_get(&conf, TUNNEL_TEST_KEY + 1);
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_add(TUNNEL_TEST_ID, &conf),
+			    "Failed to update tunnel");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY, 0, &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet with previous key decapsulated");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY + 1, 0, &decap), "Walk failed");
+	TEST_ASSERT(decap, "Packet with new key not decapsulated");
+
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_del(TUNNEL_TEST_ID), "Failed to delete tunnel");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY + 1, 0, &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet of deleted tunnel decapsulated");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_tunnel_gre_truncated(void)
+{
+	struct rte_node_tunnel_conf conf;
+	bool decap;
+
+	tunnel_test_conf_get(&conf, TUNNEL_TEST_KEY);
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_add(TUNNEL_TEST_ID, &conf), "Failed to add tunnel");
+
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY,
+			    TUNNEL_TEST_INNER_LEN + sizeof(struct rte_gre_hdr_opt_key) + 2,
+			    &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet truncated in GRE header decapsulated");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY, TUNNEL_TEST_INNER_LEN + 2,
+			    &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet truncated in GRE key decapsulated");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY,
+			    TUNNEL_TEST_INNER_LEN - RTE_ETHER_HDR_LEN + 2,
+			    &decap), "Walk failed");
+	TEST_ASSERT(!decap, "Packet without inner Ethernet header decapsulated");
+	TEST_ASSERT_SUCCESS(tunnel_test_decap(TUNNEL_TEST_KEY,
+			    TUNNEL_TEST_INNER_LEN - RTE_ETHER_HDR_LEN,
+			    &decap), "Walk failed");
+	TEST_ASSERT(decap, "Packet with inner Ethernet header only not decapsulated");
+
+	TEST_ASSERT_SUCCESS(rte_node_tunnel_del(TUNNEL_TEST_ID), "Failed to delete tunnel");
+
+	return TEST_SUCCESS;
+}
+
+static int
+node_tunnel_setup(void)
+{
+	const char *patterns[] = {TUNNEL_TEST_SRC_NAME};
+	struct rte_graph_param gconf = {0};
+
+	tunnel_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	tunnel_test.mp = rte_pktmbuf_pool_create("node_tunnel", 512, 0, RTE_CACHE_LINE_SIZE,
+						 RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(tunnel_test.mp, "Failed to create mempool");
+
+	gconf.socket_id = rte_socket_id();
+	gconf.nb_node_patterns = RTE_DIM(patterns);
+	gconf.node_patterns = patterns;
+	tunnel_test.graph_id = rte_graph_create(TUNNEL_TEST_GRAPH, &gconf);
+	TEST_ASSERT(tunnel_test.graph_id != RTE_GRAPH_ID_INVALID, "Graph creation failed");
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_tunnel_teardown(void)
+{
+	if (tunnel_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(tunnel_test.graph_id);
+	rte_mempool_free(tunnel_test.mp);
+	memset(&tunnel_test, 0, sizeof(tunnel_test));
+}
+
+static struct unit_test_suite node_tunnel_testsuite = {
+	.suite_name = "Node tunnel test suite",
+	.setup = node_tunnel_setup,
+	.teardown = node_tunnel_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_tunnel_add_del),
+		TEST_CASE(test_tunnel_gre_decap),
+		TEST_CASE(test_tunnel_gre_truncated),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_tunnel(void)
+{
+	return unit_test_suite_runner(&node_tunnel_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_tunnel_autotest, NOHUGE_OK, ASAN_OK, test_node_tunnel);
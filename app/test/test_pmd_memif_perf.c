@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+
+#include "test.h"
+
+/*
+ * Memif loopback throughput: a server and a client port share a socket
+ * in this process, each queue pair is driven by its own worker lcore,
+ * sending on the server and receiving on the client.
+ */
+
+#define MEMIF_PERF_SERVER	"net_memif_perf0"
+#define MEMIF_PERF_CLIENT	"net_memif_perf1"
+/* The listener socket outlives its ports, use one per queue count. */
+#define MEMIF_PERF_ARGS		"id=0,socket=memif_perf%u.sock"
+#define MEMIF_PERF_MAX_QUEUES	8
+#define MEMIF_PERF_RING_SIZE	1024
+#define MEMIF_PERF_NB_MBUF	16383
+#define MEMIF_PERF_CACHE_SIZE	256
+#define MEMIF_PERF_BURST	32
+#define MEMIF_PERF_LINK_WAIT_MS	5000
+#define MEMIF_PERF_RUN_MS	1000
+
+static const uint16_t pkt_sizes[] = { 64, 512, 1500 };
+static const uint16_t queue_counts[] = { 1, 2, 4, 8 };
+
+struct memif_perf_lcore {
+	uint16_t queue_id;
+	uint16_t pkt_len;
+	uint64_t tx_pkts;
+	uint64_t rx_pkts;
+	uint64_t cycles;
+};
+
+static struct rte_mempool *pool;
+static uint16_t server_port;
+static uint16_t client_port;
+static struct memif_perf_lcore lcores[RTE_MAX_LCORE];
+
+static int
+memif_perf_worker(void *arg)
+{
+	struct memif_perf_lcore *lc = arg;
+	struct rte_mbuf *pkts[MEMIF_PERF_BURST];
+	uint64_t start, end;
+	uint16_t i, n;
+
+	start = rte_rdtsc();
+	end = start + rte_get_tsc_hz() * MEMIF_PERF_RUN_MS / 1000;
+	while (rte_rdtsc() < end) {
+		if (rte_pktmbuf_alloc_bulk(pool, pkts, MEMIF_PERF_BURST) == 0) {
+			for (i = 0; i < MEMIF_PERF_BURST; i++) {
+				pkts[i]->data_len = lc->pkt_len;
+				pkts[i]->pkt_len = lc->pkt_len;
+			}
+			n = rte_eth_tx_burst(server_port, lc->queue_id, pkts,
+					MEMIF_PERF_BURST);
+			if (n < MEMIF_PERF_BURST)
+				rte_pktmbuf_free_bulk(pkts + n,
+						MEMIF_PERF_BURST - n);
+			lc->tx_pkts += n;
+		}
+
+		n = rte_eth_rx_burst(client_port, lc->queue_id, pkts,
+				MEMIF_PERF_BURST);
+		rte_pktmbuf_free_bulk(pkts, n);
+		lc->rx_pkts += n;
+	}
+	lc->cycles = rte_rdtsc() - start;
+
+	return 0;
+}
+
+static int
+memif_perf_port_setup(uint16_t port, uint16_t nb_queues)
+{
+	struct rte_eth_conf conf = { 0 };
+	uint16_t q;
+
+	if (rte_eth_dev_configure(port, nb_queues, nb_queues, &conf) < 0)
+		return -1;
+
+	for (q = 0; q < nb_queues; q++) {
+		if (rte_eth_rx_queue_setup(port, q, MEMIF_PERF_RING_SIZE,
+				rte_eth_dev_socket_id(port), NULL, pool) < 0)
+			return -1;
+		if (rte_eth_tx_queue_setup(port, q, MEMIF_PERF_RING_SIZE,
+				rte_eth_dev_socket_id(port), NULL) < 0)
+			return -1;
+	}
+
+	return rte_eth_dev_start(port);
+}
+
+static int
+memif_perf_wait_link(void)
+{
+	struct rte_eth_link server_link, client_link;
+	unsigned int ms;
+
+	for (ms = 0; ms < MEMIF_PERF_LINK_WAIT_MS; ms += 10) {
+		if (rte_eth_link_get_nowait(server_port, &server_link) == 0 &&
+				rte_eth_link_get_nowait(client_port,
+					&client_link) == 0 &&
+				server_link.link_status == RTE_ETH_LINK_UP &&
+				client_link.link_status == RTE_ETH_LINK_UP)
+			return 0;
+		rte_delay_ms(10);
+	}
+
+	return -1;
+}
+
+static void
+memif_perf_ports_release(void)
+{
+	rte_vdev_uninit(MEMIF_PERF_CLIENT);
+	rte_vdev_uninit(MEMIF_PERF_SERVER);
+}
+
+static int
+memif_perf_ports_create(uint16_t nb_queues)
+{
+	char server_args[64], client_args[64];
+
+	snprintf(server_args, sizeof(server_args), "role=server," MEMIF_PERF_ARGS,
+		nb_queues);
+	snprintf(client_args, sizeof(client_args), "role=client," MEMIF_PERF_ARGS,
+		nb_queues);
+
+	if (rte_vdev_init(MEMIF_PERF_SERVER, server_args) < 0 ||
+			rte_vdev_init(MEMIF_PERF_CLIENT, client_args) < 0 ||
+			rte_eth_dev_get_port_by_name(MEMIF_PERF_SERVER,
+				&server_port) != 0 ||
+			rte_eth_dev_get_port_by_name(MEMIF_PERF_CLIENT,
+				&client_port) != 0) {
+		printf("Cannot create memif ports\n");
+		goto error;
+	}
+
+	if (memif_perf_port_setup(server_port, nb_queues) < 0 ||
+			memif_perf_port_setup(client_port, nb_queues) < 0) {
+		printf("Cannot set up %u queues on memif ports\n", nb_queues);
+		goto error;
+	}
+
+	if (memif_perf_wait_link() < 0) {
+		printf("Memif ports did not connect\n");
+		goto error;
+	}
+
+	return 0;
+
+error:
+	memif_perf_ports_release();
+	return -1;
+}
+
+static void
+memif_perf_run(uint16_t nb_queues, uint16_t pkt_len)
+{
+	uint64_t tx_pkts = 0, rx_pkts = 0, cycles = 0;
+	unsigned int lcore_id;
+	uint16_t q = 0;
+	double mpps;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (q == nb_queues)
+			break;
+		lcores[lcore_id] = (struct memif_perf_lcore){
+			.queue_id = q++,
+			.pkt_len = pkt_len,
+		};
+		rte_eal_remote_launch(memif_perf_worker, &lcores[lcore_id],
+				lcore_id);
+	}
+	rte_eal_mp_wait_lcore();
+
+	q = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (q++ == nb_queues)
+			break;
+		tx_pkts += lcores[lcore_id].tx_pkts;
+		rx_pkts += lcores[lcore_id].rx_pkts;
+		cycles = RTE_MAX(cycles, lcores[lcore_id].cycles);
+	}
+
+	mpps = (double)rx_pkts * rte_get_tsc_hz() / cycles / 1e6;
+	printf("%6u %6u %12" PRIu64 " %12" PRIu64 " %10.2f %10.2f %10.2f\n",
+		nb_queues, pkt_len, tx_pkts, rx_pkts, mpps, mpps / nb_queues,
+		mpps * pkt_len * 8 / 1e3);
+}
+
+static int
+test_memif_pmd_perf(void)
+{
+	unsigned int nb_workers = rte_lcore_count() - 1;
+	unsigned int i, j;
+	int ret = TEST_SUCCESS;
+
+	if (nb_workers == 0) {
+		printf("At least one worker lcore is required, skipping\n");
+		return TEST_SKIPPED;
+	}
+
+	pool = rte_pktmbuf_pool_create("memif_perf_pool", MEMIF_PERF_NB_MBUF,
+			MEMIF_PERF_CACHE_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			rte_socket_id());
+	if (pool == NULL) {
+		printf("Cannot create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	printf("\n%6s %6s %12s %12s %10s %10s %10s\n", "queues", "size",
+		"tx pkts", "rx pkts", "Mpps", "Mpps/queue", "Gbps");
+
+	for (i = 0; i < RTE_DIM(queue_counts); i++) {
+		uint16_t nb_queues = queue_counts[i];
+
+		if (nb_queues > nb_workers || nb_queues > MEMIF_PERF_MAX_QUEUES)
+			break;
+
+		if (memif_perf_ports_create(nb_queues) < 0) {
+			ret = TEST_FAILED;
+			break;
+		}
+
+		for (j = 0; j < RTE_DIM(pkt_sizes); j++)
+			memif_perf_run(nb_queues, pkt_sizes[j]);
+
+		rte_eth_dev_stop(client_port);
+		rte_eth_dev_stop(server_port);
+		memif_perf_ports_release();
+	}
+
+	rte_mempool_free(pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(memif_pmd_perf_autotest, test_memif_pmd_perf);
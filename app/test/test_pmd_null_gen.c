@@ -0,0 +1,414 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_thash.h>
+#include <rte_udp.h>
+
+#define NULL_GEN_TEST_VDEV	"net_null_gen_test"
+#define NULL_GEN_TEST_NB_MBUFS	4096
+#define NULL_GEN_TEST_BURST	32
+#define NULL_GEN_TEST_RETA_SIZE	128
+
+static struct null_gen_test {
+	struct rte_mempool *mp;
+	uint16_t port_id;
+	bool port_valid;
+} null_gen_test;
+
+static int
+null_gen_test_port_create(const char *args, uint16_t nb_queues,
+		struct rte_eth_rss_reta_entry64 *reta)
+{
+	struct rte_eth_conf conf = {
+		.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS,
+	};
+	uint16_t q;
+	int ret;
+
+	ret = rte_vdev_init(NULL_GEN_TEST_VDEV, args);
+	TEST_ASSERT(ret == 0, "Cannot create %s with %s", NULL_GEN_TEST_VDEV,
+			args);
+	ret = rte_eth_dev_get_port_by_name(NULL_GEN_TEST_VDEV,
+			&null_gen_test.port_id);
+	TEST_ASSERT(ret == 0, "Cannot find %s", NULL_GEN_TEST_VDEV);
+	null_gen_test.port_valid = true;
+
+	ret = rte_eth_dev_configure(null_gen_test.port_id, nb_queues, nb_queues,
+			&conf);
+	TEST_ASSERT(ret == 0, "Cannot configure port");
+	for (q = 0; q < nb_queues; q++) {
+		ret = rte_eth_rx_queue_setup(null_gen_test.port_id, q, 64,
+				SOCKET_ID_ANY, NULL, null_gen_test.mp);
+		TEST_ASSERT(ret == 0, "Cannot setup Rx queue %u", q);
+		ret = rte_eth_tx_queue_setup(null_gen_test.port_id, q, 64,
+				SOCKET_ID_ANY, NULL);
+		TEST_ASSERT(ret == 0, "Cannot setup Tx queue %u", q);
+	}
+	if (reta != NULL) {
+		/* Flows are spread over the queues at start */
+		ret = rte_eth_dev_rss_reta_update(null_gen_test.port_id, reta,
+				NULL_GEN_TEST_RETA_SIZE);
+		TEST_ASSERT(ret == 0, "Cannot update RETA");
+	}
+
+	ret = rte_eth_dev_start(null_gen_test.port_id);
+	TEST_ASSERT(ret == 0, "Cannot start port");
+
+	return TEST_SUCCESS;
+}
+
+static void
+null_gen_test_port_destroy(void)
+{
+	if (!null_gen_test.port_valid)
+		return;
+	rte_eth_dev_stop(null_gen_test.port_id);
+	rte_eth_dev_close(null_gen_test.port_id);
+	rte_vdev_uninit(NULL_GEN_TEST_VDEV);
+	null_gen_test.port_valid = false;
+}
+
+/* Check headers, lengths and checksums of a generated packet */
+static int
+null_gen_test_check_pkt(const struct rte_mbuf *m, bool ipv4, bool udp)
+{
+	const struct rte_ether_hdr *eth;
+	const void *l4;
+	uint16_t l4_len;
+	uint32_t ptype;
+
+	TEST_ASSERT(m->nb_segs == 1 && m->data_len == m->pkt_len,
+			"Unexpected segmentation");
+	eth = rte_pktmbuf_mtod(m, const struct rte_ether_hdr *);
+
+	if (ipv4) {
+		const struct rte_ipv4_hdr *ip = (const void *)(eth + 1);
+
+		TEST_ASSERT_EQUAL(eth->ether_type,
+				RTE_BE16(RTE_ETHER_TYPE_IPV4), "Not IPv4");
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip->total_length),
+				m->pkt_len - sizeof(*eth), "Bad IPv4 length");
+		TEST_ASSERT_EQUAL(rte_ipv4_cksum(ip), 0, "Bad IPv4 checksum");
+		TEST_ASSERT_EQUAL(ip->next_proto_id,
+				(udp ? IPPROTO_UDP : IPPROTO_TCP), "Bad protocol");
+		l4 = ip + 1;
+		l4_len = m->pkt_len - sizeof(*eth) - sizeof(*ip);
+		TEST_ASSERT(rte_ipv4_udptcp_cksum_verify(ip, l4) == 0,
+				"Bad IPv4 L4 checksum");
+		ptype = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4;
+	} else {
+		const struct rte_ipv6_hdr *ip = (const void *)(eth + 1);
+
+		TEST_ASSERT_EQUAL(eth->ether_type,
+				RTE_BE16(RTE_ETHER_TYPE_IPV6), "Not IPv6");
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(ip->payload_len),
+				m->pkt_len - sizeof(*eth) - sizeof(*ip),
+				"Bad IPv6 length");
+		TEST_ASSERT_EQUAL(ip->proto, (udp ? IPPROTO_UDP : IPPROTO_TCP),
+				"Bad protocol");
+		l4 = ip + 1;
+		l4_len = m->pkt_len - sizeof(*eth) - sizeof(*ip);
+		TEST_ASSERT(rte_ipv6_udptcp_cksum_verify(ip, l4) == 0,
+				"Bad IPv6 L4 checksum");
+		ptype = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6;
+	}
+
+	if (udp) {
+		const struct rte_udp_hdr *uh = l4;
+
+		TEST_ASSERT_EQUAL(rte_be_to_cpu_16(uh->dgram_len), l4_len,
+				"Bad UDP length");
+		TEST_ASSERT(uh->dgram_cksum != 0, "Missing UDP checksum");
+		ptype |= RTE_PTYPE_L4_UDP;
+	} else {
+		ptype |= RTE_PTYPE_L4_TCP;
+	}
+	TEST_ASSERT_EQUAL(m->packet_type, ptype, "Bad packet type %#x",
+			m->packet_type);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_null_gen_types(void)
+{
+	static const struct {
+		const char *name;
+		bool ipv4;
+		bool udp;
+	} types[] = {
+		{ "ipv4-udp", true, true },
+		{ "ipv4-tcp", true, false },
+		{ "ipv6-udp", false, true },
+		{ "ipv6-tcp", false, false },
+	};
+	struct rte_mbuf *pkts[NULL_GEN_TEST_BURST];
+	char args[128];
+	unsigned int t;
+	uint16_t i, nb;
+	int ret;
+
+	for (t = 0; t < RTE_DIM(types); t++) {
+		snprintf(args, sizeof(args), "gen=%s,flows=7,sizes=79/128/1500",
+				types[t].name);
+		ret = null_gen_test_port_create(args, 1, NULL);
+		if (ret != TEST_SUCCESS)
+			return ret;
+
+		nb = rte_eth_rx_burst(null_gen_test.port_id, 0, pkts,
+				NULL_GEN_TEST_BURST);
+		TEST_ASSERT_EQUAL(nb, NULL_GEN_TEST_BURST,
+				"Short burst for %s", types[t].name);
+		ret = TEST_SUCCESS;
+		for (i = 0; i < nb && ret == TEST_SUCCESS; i++)
+			ret = null_gen_test_check_pkt(pkts[i], types[t].ipv4,
+					types[t].udp);
+		rte_pktmbuf_free_bulk(pkts, nb);
+		TEST_ASSERT_SUCCESS(ret, "Bad %s packet %u", types[t].name,
+				i - 1);
+
+		null_gen_test_port_destroy();
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_null_gen_imix(void)
+{
+	static const uint16_t lens[] = { 64, 576, 1500 };
+	static const unsigned int weights[] = { 7, 4, 1 };
+	struct rte_mbuf *pkts[NULL_GEN_TEST_BURST];
+	uint16_t sizes[NULL_GEN_TEST_BURST];
+	unsigned int count[RTE_DIM(lens)] = { 0 };
+	unsigned int i, l, run, max_run;
+	uint16_t nb;
+	int ret;
+
+	ret = null_gen_test_port_create("gen=ipv4-udp,sizes=imix", 1, NULL);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	nb = rte_eth_rx_burst(null_gen_test.port_id, 0, pkts,
+			NULL_GEN_TEST_BURST);
+	TEST_ASSERT_EQUAL(nb, NULL_GEN_TEST_BURST, "Short burst");
+	for (i = 0; i < nb; i++)
+		sizes[i] = pkts[i]->pkt_len;
+	rte_pktmbuf_free_bulk(pkts, nb);
+
+	/* The pattern is 12 long, and has 7, 4 and 1 packets of each size */
+	for (i = 0; i < 12; i++) {
+		TEST_ASSERT_EQUAL(sizes[i], sizes[i + 12],
+				"Pattern does not repeat at %u", i);
+		for (l = 0; l < RTE_DIM(lens); l++)
+			count[l] += sizes[i] == lens[l];
+	}
+	for (l = 0; l < RTE_DIM(lens); l++)
+		TEST_ASSERT_EQUAL(count[l], weights[l],
+				"%u packets of %u bytes, expected %u",
+				count[l], lens[l], weights[l]);
+
+	/* Sizes are interleaved, not in sequence */
+	max_run = run = 1;
+	for (i = 1; i < nb; i++) {
+		run = sizes[i] == sizes[i - 1] ? run + 1 : 1;
+		max_run = RTE_MAX(max_run, run);
+	}
+	TEST_ASSERT(max_run <= 2, "%u packets of the same size in a row",
+			max_run);
+
+	null_gen_test_port_destroy();
+
+	return TEST_SUCCESS;
+}
+
+/* Toeplitz hash of the 5-tuple of an IPv4 generated packet */
+static uint32_t
+null_gen_test_hash(const struct rte_mbuf *m, const uint8_t *key)
+{
+	const struct rte_ether_hdr *eth =
+		rte_pktmbuf_mtod(m, const struct rte_ether_hdr *);
+	const struct rte_ipv4_hdr *ip = (const void *)(eth + 1);
+	const struct rte_udp_hdr *udp = (const void *)(ip + 1);
+	union rte_thash_tuple tuple;
+
+	tuple.v4.src_addr = rte_be_to_cpu_32(ip->src_addr);
+	tuple.v4.dst_addr = rte_be_to_cpu_32(ip->dst_addr);
+	tuple.v4.sport = rte_be_to_cpu_16(udp->src_port);
+	tuple.v4.dport = rte_be_to_cpu_16(udp->dst_port);
+
+	return rte_softrss((uint32_t *)&tuple, RTE_THASH_V4_L4_LEN, key);
+}
+
+static int
+test_null_gen_rss(void)
+{
+	struct rte_eth_rss_reta_entry64 reta[NULL_GEN_TEST_RETA_SIZE /
+		RTE_ETH_RETA_GROUP_SIZE];
+	const uint16_t nb_queues = 3, nb_flows = 24;
+	struct rte_mbuf *pkts[NULL_GEN_TEST_BURST];
+	uint16_t i, q, nb, idx, rq, total = 0;
+	uint8_t key[40];
+	struct rte_eth_rss_conf rss_conf = {
+		.rss_key = key,
+		.rss_key_len = sizeof(key),
+	};
+	int ret;
+
+	/* Uneven table, queue 2 gets half of the hashes */
+	memset(reta, 0, sizeof(reta));
+	for (i = 0; i < NULL_GEN_TEST_RETA_SIZE; i++) {
+		reta[i / RTE_ETH_RETA_GROUP_SIZE].mask = UINT64_MAX;
+		reta[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE] =
+			i % 4 == 3 ? 2 : i % 4;
+	}
+
+	ret = null_gen_test_port_create("gen=ipv4-udp,flows=24,rss=1",
+			nb_queues, reta);
+	if (ret != TEST_SUCCESS)
+		return ret;
+	ret = rte_eth_dev_rss_hash_conf_get(null_gen_test.port_id, &rss_conf);
+	TEST_ASSERT(ret == 0, "Cannot get RSS key");
+
+	/*
+	 * Each queue cycles over its own flows, fewer than a burst, so a
+	 * burst shows them all before the first one comes again.
+	 */
+	for (q = 0; q < nb_queues; q++) {
+		uint16_t nb_queue_flows = 0;
+		uint32_t hash;
+
+		nb = rte_eth_rx_burst(null_gen_test.port_id, q, pkts,
+				NULL_GEN_TEST_BURST);
+		for (i = 0; i < nb; i++) {
+			struct rte_mbuf *m = pkts[i];
+
+			hash = null_gen_test_hash(m, key);
+			TEST_ASSERT(m->ol_flags & RTE_MBUF_F_RX_RSS_HASH,
+					"No RSS hash");
+			TEST_ASSERT_EQUAL(m->hash.rss, hash,
+					"RSS hash %#x, expected %#x",
+					m->hash.rss, hash);
+			idx = hash % NULL_GEN_TEST_RETA_SIZE;
+			rq = reta[idx / RTE_ETH_RETA_GROUP_SIZE]
+				.reta[idx % RTE_ETH_RETA_GROUP_SIZE];
+			TEST_ASSERT_EQUAL(rq, q,
+					"Flow %#x on queue %u, RETA says %u",
+					hash, q, rq);
+			if (nb_queue_flows == 0 || pkts[0]->hash.rss != hash)
+				nb_queue_flows++;
+			else
+				break;
+		}
+		rte_pktmbuf_free_bulk(pkts, nb);
+		total += nb_queue_flows;
+	}
+	TEST_ASSERT_EQUAL(total, nb_flows, "%u flows over all queues, expected %u",
+			total, nb_flows);
+
+	null_gen_test_port_destroy();
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_null_gen_rate(void)
+{
+	/* 64 bytes at 10 Mbit/s is 10^7 / ((64 + 24) * 8) packets/s */
+	const uint64_t pps = 10000000 / ((64 + 24) * 8);
+	struct rte_mbuf *pkts[NULL_GEN_TEST_BURST];
+	uint64_t hz = rte_get_tsc_hz();
+	uint64_t start, end, total = 0, expected;
+	uint16_t nb;
+	int ret;
+
+	ret = null_gen_test_port_create("gen=ipv4-udp,size=64,rate=10", 1,
+			NULL);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	start = rte_rdtsc();
+	end = start + hz / 20;
+	do {
+		nb = rte_eth_rx_burst(null_gen_test.port_id, 0, pkts,
+				NULL_GEN_TEST_BURST);
+		rte_pktmbuf_free_bulk(pkts, nb);
+		total += nb;
+	} while (rte_rdtsc() < end);
+	end = rte_rdtsc();
+
+	/* At most a millisecond of credit, and some slack for slow polling */
+	expected = (end - start) * pps / hz;
+	printf("%"PRIu64" packets in %"PRIu64" ms, %"PRIu64" expected\n",
+			total, (end - start) * 1000 / hz, expected);
+	TEST_ASSERT(total <= expected + pps / 1000 + NULL_GEN_TEST_BURST,
+			"Rate exceeded, %"PRIu64" packets", total);
+	TEST_ASSERT(total >= expected / 2, "Rate too low, %"PRIu64" packets",
+			total);
+
+	null_gen_test_port_destroy();
+
+	return TEST_SUCCESS;
+}
+
+static int
+null_gen_setup(void)
+{
+	null_gen_test.mp = rte_pktmbuf_pool_create("null_gen_test_pool",
+			NULL_GEN_TEST_NB_MBUFS, 0, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			SOCKET_ID_ANY);
+	if (null_gen_test.mp == NULL) {
+		printf("Cannot create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+null_gen_teardown(void)
+{
+	null_gen_test_port_destroy();
+	rte_mempool_free(null_gen_test.mp);
+	null_gen_test.mp = NULL;
+}
+
+static void
+null_gen_ut_teardown(void)
+{
+	null_gen_test_port_destroy();
+}
+
+static struct unit_test_suite null_gen_testsuite = {
+	.suite_name = "null PMD traffic generation test suite",
+	.setup = null_gen_setup,
+	.teardown = null_gen_teardown,
+	.unit_test_cases = {
+		TEST_CASE_ST(NULL, null_gen_ut_teardown, test_null_gen_types),
+		TEST_CASE_ST(NULL, null_gen_ut_teardown, test_null_gen_imix),
+		TEST_CASE_ST(NULL, null_gen_ut_teardown, test_null_gen_rss),
+		TEST_CASE_ST(NULL, null_gen_ut_teardown, test_null_gen_rate),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_pmd_null_gen(void)
+{
+	return unit_test_suite_runner(&null_gen_testsuite);
+}
+
+REGISTER_FAST_TEST(null_gen_autotest, NOHUGE_OK, ASAN_OK, test_pmd_null_gen);
@@ -0,0 +1,591 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_pmd_pcap_replay(void)
+{
+	printf("pcap replay not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <unistd.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_mbuf_dyn.h>
+#include <rte_thash.h>
+#include <rte_udp.h>
+
+#define REPLAY_TEST_DEV		"net_pcap_replay_test"
+#define REPLAY_TEST_NB_PKTS	8
+/* Longer than the headers copied in the Rx mbuf */
+#define REPLAY_TEST_PKT_LEN	192
+#define REPLAY_TEST_BURST	32
+#define REPLAY_TEST_GAP_US	250
+/* Capture timestamps of the packets, in microseconds */
+#define REPLAY_TEST_TS_US(i)	(UINT64_C(1000000) + (i) * REPLAY_TEST_GAP_US)
+#define REPLAY_TEST_TIMEOUT_MS	1000
+
+#define PCAP_MAGIC		0xa1b2c3d4
+#define PCAPNG_SHB		0x0a0d0d0a
+#define PCAPNG_IDB		0x00000001
+#define PCAPNG_EPB		0x00000006
+#define PCAPNG_BOM		0x1a2b3c4d
+#define LINKTYPE_ETHERNET	1
+
+static struct replay_test {
+	struct rte_mempool *mp;
+	int ts_offset;
+} replay_test;
+
+/* Key the driver spreads packets over queues with */
+static const uint8_t replay_test_rss_key[] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+/* IPv4/UDP packet i of the capture */
+static void
+replay_test_pkt(unsigned int i, uint8_t *pkt)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)pkt;
+	struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(eth + 1);
+	struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(ip + 1);
+	uint16_t len = REPLAY_TEST_PKT_LEN - sizeof(*eth);
+
+	memset(pkt, 0, REPLAY_TEST_PKT_LEN);
+	memset(&eth->dst_addr, 0xff, sizeof(eth->dst_addr));
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(len);
+	ip->time_to_live = 64;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(192, 0, 2, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(192, 0, 2, 2));
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	udp->src_port = rte_cpu_to_be_16(1024 + i);
+	udp->dst_port = RTE_BE16(4789);
+	udp->dgram_len = rte_cpu_to_be_16(len - sizeof(*ip));
+	memset(udp + 1, i + 1, REPLAY_TEST_PKT_LEN - sizeof(*eth) -
+	       sizeof(*ip) - sizeof(*udp));
+}
+
+static int
+replay_test_write(FILE *f, const void *data, size_t len)
+{
+	return fwrite(data, len, 1, f) == 1 ? 0 : -1;
+}
+
+/* Classic pcap file with microsecond timestamps */
+static int
+replay_test_write_pcap(FILE *f)
+{
+	const uint32_t magic = PCAP_MAGIC;
+	const uint16_t version[2] = { 2, 4 };
+	const uint32_t hdr[4] = { 0, 0, UINT16_MAX, LINKTYPE_ETHERNET };
+	uint8_t pkt[REPLAY_TEST_PKT_LEN];
+	unsigned int i;
+
+	if (replay_test_write(f, &magic, sizeof(magic)) < 0 ||
+			replay_test_write(f, version, sizeof(version)) < 0 ||
+			replay_test_write(f, hdr, sizeof(hdr)) < 0)
+		return -1;
+
+	for (i = 0; i < REPLAY_TEST_NB_PKTS; i++) {
+		const uint32_t rec[4] = {
+			REPLAY_TEST_TS_US(i) / 1000000,
+			REPLAY_TEST_TS_US(i) % 1000000,
+			REPLAY_TEST_PKT_LEN, REPLAY_TEST_PKT_LEN,
+		};
+
+		replay_test_pkt(i, pkt);
+		if (replay_test_write(f, rec, sizeof(rec)) < 0 ||
+				replay_test_write(f, pkt, sizeof(pkt)) < 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+/* pcapng file with one interface of default microsecond resolution */
+static int
+replay_test_write_pcapng(FILE *f)
+{
+	/* Section of unknown length, version 1.0 */
+	const uint32_t shb_len = 28;
+	const uint32_t shb[3] = { PCAPNG_SHB, shb_len, PCAPNG_BOM };
+	const uint16_t shb_version[2] = { 1, 0 };
+	const uint32_t shb_end[3] = { UINT32_MAX, UINT32_MAX, shb_len };
+	const uint32_t idb_len = 20;
+	const uint32_t idb[2] = { PCAPNG_IDB, idb_len };
+	const uint16_t idb_linktype[2] = { LINKTYPE_ETHERNET, 0 };
+	const uint32_t idb_end[2] = { UINT16_MAX, idb_len };
+	uint8_t pkt[REPLAY_TEST_PKT_LEN];
+	unsigned int i;
+
+	RTE_BUILD_BUG_ON(REPLAY_TEST_PKT_LEN % 4 != 0);
+
+	if (replay_test_write(f, shb, sizeof(shb)) < 0 ||
+			replay_test_write(f, shb_version, sizeof(shb_version)) < 0 ||
+			replay_test_write(f, shb_end, sizeof(shb_end)) < 0 ||
+			replay_test_write(f, idb, sizeof(idb)) < 0 ||
+			replay_test_write(f, idb_linktype, sizeof(idb_linktype)) < 0 ||
+			replay_test_write(f, idb_end, sizeof(idb_end)) < 0)
+		return -1;
+
+	for (i = 0; i < REPLAY_TEST_NB_PKTS; i++) {
+		const uint64_t ts = REPLAY_TEST_TS_US(i);
+		const uint32_t len = 32 + REPLAY_TEST_PKT_LEN;
+		const uint32_t epb[7] = {
+			PCAPNG_EPB, len, 0, ts >> 32, (uint32_t)ts,
+			REPLAY_TEST_PKT_LEN, REPLAY_TEST_PKT_LEN,
+		};
+
+		replay_test_pkt(i, pkt);
+		if (replay_test_write(f, epb, sizeof(epb)) < 0 ||
+				replay_test_write(f, pkt, sizeof(pkt)) < 0 ||
+				replay_test_write(f, &len, sizeof(len)) < 0)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+replay_test_file_create(char *path, int (*write_file)(FILE *f))
+{
+	FILE *f;
+	int fd, ret;
+
+	fd = mkstemps(path, strlen(strrchr(path, '.')));
+	if (fd < 0)
+		return -1;
+
+	f = fdopen(fd, "w");
+	if (f == NULL) {
+		close(fd);
+		unlink(path);
+		return -1;
+	}
+
+	ret = write_file(f);
+	if (fclose(f) != 0)
+		ret = -1;
+	if (ret < 0)
+		unlink(path);
+
+	return ret;
+}
+
+static int
+replay_test_port_start(uint16_t port, uint16_t nb_queues)
+{
+	struct rte_eth_conf conf;
+	uint16_t q;
+
+	memset(&conf, 0, sizeof(conf));
+	TEST_ASSERT_SUCCESS(rte_eth_dev_configure(port, nb_queues, nb_queues, &conf),
+			    "Configure failed");
+	for (q = 0; q < nb_queues; q++) {
+		TEST_ASSERT_SUCCESS(rte_eth_rx_queue_setup(port, q, REPLAY_TEST_BURST,
+							   SOCKET_ID_ANY, NULL, replay_test.mp),
+				    "Rx queue setup failed");
+		TEST_ASSERT_SUCCESS(rte_eth_tx_queue_setup(port, q, REPLAY_TEST_BURST,
+							   SOCKET_ID_ANY, NULL),
+				    "Tx queue setup failed");
+	}
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(port), "Start failed");
+
+	return TEST_SUCCESS;
+}
+
+/* Create a replay port on a capture and start it */
+static int
+replay_test_port_create(const char *path, const char *opts, uint16_t nb_queues,
+			uint16_t *port)
+{
+	char args[PATH_MAX + 64];
+
+	snprintf(args, sizeof(args), "rx_pcap=%s,%s", path, opts);
+	TEST_ASSERT_SUCCESS(rte_vdev_init(REPLAY_TEST_DEV, args), "Failed to create %s",
+			    REPLAY_TEST_DEV);
+	if (rte_eth_dev_get_port_by_name(REPLAY_TEST_DEV, port) != 0 ||
+			replay_test_port_start(*port, nb_queues) != TEST_SUCCESS) {
+		rte_vdev_uninit(REPLAY_TEST_DEV);
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+/* Check a received packet is packet i of the capture */
+static int
+replay_test_pkt_check(const struct rte_mbuf *m, unsigned int i)
+{
+	uint8_t pkt[REPLAY_TEST_PKT_LEN], buf[REPLAY_TEST_PKT_LEN];
+	const void *data;
+
+	replay_test_pkt(i, pkt);
+	if (rte_pktmbuf_pkt_len(m) != sizeof(pkt))
+		return -1;
+	data = rte_pktmbuf_read(m, 0, sizeof(pkt), buf);
+	if (data == NULL || memcmp(data, pkt, sizeof(pkt)) != 0)
+		return -1;
+
+	return 0;
+}
+
+/* Source port of a received packet, which tells its index in the capture */
+static unsigned int
+replay_test_pkt_index(const struct rte_mbuf *m)
+{
+	const struct rte_udp_hdr *udp = rte_pktmbuf_mtod_offset(m,
+			const struct rte_udp_hdr *,
+			sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr));
+
+	return rte_be_to_cpu_16(udp->src_port) - 1024;
+}
+
+/* Replay a capture once and check every packet comes out as captured */
+static int
+replay_test_run(const char *path)
+{
+	struct rte_mbuf *bufs[REPLAY_TEST_BURST];
+	uint16_t port, nb_rx, i;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(replay_test_port_create(path, "replay_speed=0", 1, &port),
+			    "Failed to start %s", REPLAY_TEST_DEV);
+
+	nb_rx = rte_eth_rx_burst(port, 0, bufs, RTE_DIM(bufs));
+	if (nb_rx != REPLAY_TEST_NB_PKTS) {
+		printf("Received %u packets, expected %u\n", nb_rx, REPLAY_TEST_NB_PKTS);
+		rte_pktmbuf_free_bulk(bufs, nb_rx);
+		goto uninit;
+	}
+	for (i = 0; i < nb_rx; i++) {
+		if (replay_test_pkt_check(bufs[i], i) < 0) {
+			printf("Packet %u differs from the capture\n", i);
+			goto free;
+		}
+		/* Headers are copied, the payload is attached to the template */
+		if (!RTE_MBUF_DIRECT(bufs[i]) || bufs[i]->nb_segs != 2 ||
+				!RTE_MBUF_CLONED(bufs[i]->next)) {
+			printf("Packet %u not split between copy and template\n", i);
+			goto free;
+		}
+		if (*RTE_MBUF_DYNFIELD(bufs[i], replay_test.ts_offset,
+				       rte_mbuf_timestamp_t *) != REPLAY_TEST_TS_US(i)) {
+			printf("Packet %u has a wrong timestamp\n", i);
+			goto free;
+		}
+	}
+	if (rte_eth_rx_burst(port, 0, &bufs[nb_rx], RTE_DIM(bufs) - nb_rx) != 0) {
+		printf("Capture replayed more than once\n");
+		goto free;
+	}
+
+	/* Templates are still referenced by the received packets */
+	if (rte_eth_dev_stop(port) != 0 ||
+			rte_eth_rx_queue_setup(port, 0, REPLAY_TEST_BURST, SOCKET_ID_ANY,
+					       NULL, replay_test.mp) != -EBUSY) {
+		printf("Rx queue set up again while replayed packets in use\n");
+		goto free;
+	}
+	rte_pktmbuf_free_bulk(bufs, nb_rx);
+	nb_rx = 0;
+	if (rte_eth_rx_queue_setup(port, 0, REPLAY_TEST_BURST, SOCKET_ID_ANY, NULL,
+				   replay_test.mp) != 0) {
+		printf("Rx queue set up failed once replayed packets freed\n");
+		goto uninit;
+	}
+
+	ret = TEST_SUCCESS;
+free:
+	rte_pktmbuf_free_bulk(bufs, nb_rx);
+uninit:
+	rte_vdev_uninit(REPLAY_TEST_DEV);
+
+	return ret;
+}
+
+static int
+test_replay_pcap(void)
+{
+	char path[] = "/tmp/pcap_replay_test_XXXXXX.pcap";
+	int ret;
+
+	TEST_ASSERT_SUCCESS(replay_test_file_create(path, replay_test_write_pcap),
+			    "Failed to write %s", path);
+	ret = replay_test_run(path);
+	unlink(path);
+
+	return ret;
+}
+
+static int
+test_replay_pcapng(void)
+{
+	char path[] = "/tmp/pcap_replay_test_XXXXXX.pcapng";
+	int ret;
+
+	TEST_ASSERT_SUCCESS(replay_test_file_create(path, replay_test_write_pcapng),
+			    "Failed to write %s", path);
+	ret = replay_test_run(path);
+	unlink(path);
+
+	return ret;
+}
+
+/* Rewrite the headers of the packets of a pass, the next pass is unchanged */
+static int
+test_replay_hdr_write(void)
+{
+	char path[] = "/tmp/pcap_replay_test_XXXXXX.pcap";
+	struct rte_mbuf *bufs[REPLAY_TEST_NB_PKTS];
+	unsigned int pass;
+	uint16_t port, nb_rx, i;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(replay_test_file_create(path, replay_test_write_pcap),
+			    "Failed to write %s", path);
+	if (replay_test_port_create(path, "replay_speed=0,infinite_rx=1", 1,
+				    &port) != TEST_SUCCESS) {
+		unlink(path);
+		return TEST_FAILED;
+	}
+
+	for (pass = 0; pass < 2; pass++) {
+		nb_rx = rte_eth_rx_burst(port, 0, bufs, RTE_DIM(bufs));
+		if (nb_rx != RTE_DIM(bufs)) {
+			printf("Received %u packets in pass %u\n", nb_rx, pass);
+			rte_pktmbuf_free_bulk(bufs, nb_rx);
+			goto uninit;
+		}
+		for (i = 0; i < nb_rx; i++) {
+			struct rte_ether_hdr *eth =
+				rte_pktmbuf_mtod(bufs[i], struct rte_ether_hdr *);
+			struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(eth + 1);
+
+			if (replay_test_pkt_check(bufs[i], i) < 0) {
+				printf("Packet %u of pass %u differs from the capture\n",
+				       i, pass);
+				rte_pktmbuf_free_bulk(bufs, nb_rx);
+				goto uninit;
+			}
+			/* As a router would do */
+			memset(&eth->dst_addr, 0x02, sizeof(eth->dst_addr));
+			ip->time_to_live--;
+		}
+		rte_pktmbuf_free_bulk(bufs, nb_rx);
+	}
+
+	ret = TEST_SUCCESS;
+uninit:
+	rte_vdev_uninit(REPLAY_TEST_DEV);
+	unlink(path);
+
+	return ret;
+}
+
+/* Packets are not delivered before their capture time, scaled by the speed */
+static int
+test_replay_pacing(void)
+{
+	char path[] = "/tmp/pcap_replay_test_XXXXXX.pcap";
+	/* Twice slower than captured */
+	const uint64_t gap = rte_get_timer_hz() * REPLAY_TEST_GAP_US * 2 / US_PER_S;
+	uint64_t start, deadline, now;
+	struct rte_mbuf *m;
+	uint16_t port, nb;
+	unsigned int nb_rx = 0;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(replay_test_file_create(path, replay_test_write_pcap),
+			    "Failed to write %s", path);
+	start = rte_get_timer_cycles();
+	if (replay_test_port_create(path, "replay_speed=0.5", 1, &port) != TEST_SUCCESS) {
+		unlink(path);
+		return TEST_FAILED;
+	}
+
+	deadline = start + rte_get_timer_hz() * REPLAY_TEST_TIMEOUT_MS / MS_PER_S;
+	do {
+		nb = rte_eth_rx_burst(port, 0, &m, 1);
+		/* Read after the burst, the driver checked due times before */
+		now = rte_get_timer_cycles();
+		if (nb == 0)
+			continue;
+		if (replay_test_pkt_index(m) != nb_rx) {
+			printf("Packet %u received out of order\n", nb_rx);
+			rte_pktmbuf_free(m);
+			goto uninit;
+		}
+		rte_pktmbuf_free(m);
+		if (now - start < nb_rx * gap) {
+			printf("Packet %u received %"PRIu64" us after start, due at %"PRIu64"\n",
+			       nb_rx, (now - start) * US_PER_S / rte_get_timer_hz(),
+			       nb_rx * gap * US_PER_S / rte_get_timer_hz());
+			goto uninit;
+		}
+		nb_rx++;
+	} while (nb_rx < REPLAY_TEST_NB_PKTS && now < deadline);
+
+	if (nb_rx != REPLAY_TEST_NB_PKTS) {
+		printf("Received %u packets in %u ms\n", nb_rx, REPLAY_TEST_TIMEOUT_MS);
+		goto uninit;
+	}
+
+	ret = TEST_SUCCESS;
+uninit:
+	rte_vdev_uninit(REPLAY_TEST_DEV);
+	unlink(path);
+
+	return ret;
+}
+
+/* Queue a captured packet is expected on with replay_queues */
+static uint16_t
+replay_test_pkt_queue(unsigned int i, uint16_t nb_queues)
+{
+	union rte_thash_tuple tuple;
+
+	tuple.v4.src_addr = RTE_IPV4(192, 0, 2, 1);
+	tuple.v4.dst_addr = RTE_IPV4(192, 0, 2, 2);
+	tuple.v4.sport = 1024 + i;
+	tuple.v4.dport = 4789;
+
+	return rte_softrss((uint32_t *)&tuple, RTE_THASH_V4_L4_LEN,
+			   replay_test_rss_key) % nb_queues;
+}
+
+/* A capture split over queues by RSS hash, each in capture order */
+static int
+test_replay_queues(void)
+{
+	char path[] = "/tmp/pcap_replay_test_XXXXXX.pcap";
+	const uint16_t nb_queues = 2;
+	struct rte_mbuf *bufs[REPLAY_TEST_BURST];
+	unsigned int total = 0;
+	uint16_t port, q, nb_rx, i;
+	int ret = TEST_FAILED;
+
+	TEST_ASSERT_SUCCESS(replay_test_file_create(path, replay_test_write_pcap),
+			    "Failed to write %s", path);
+	if (replay_test_port_create(path, "replay_speed=0,replay_queues=2", nb_queues,
+				    &port) != TEST_SUCCESS) {
+		unlink(path);
+		return TEST_FAILED;
+	}
+
+	for (q = 0; q < nb_queues; q++) {
+		unsigned int next = 0;
+
+		nb_rx = rte_eth_rx_burst(port, q, bufs, RTE_DIM(bufs));
+		for (i = 0; i < nb_rx; i++) {
+			unsigned int idx = replay_test_pkt_index(bufs[i]);
+
+			/* Next packet of the capture hashing to this queue */
+			while (next < REPLAY_TEST_NB_PKTS &&
+					replay_test_pkt_queue(next, nb_queues) != q)
+				next++;
+			if (idx != next || replay_test_pkt_check(bufs[i], idx) < 0) {
+				printf("Queue %u got packet %u, expected %u\n", q, idx, next);
+				rte_pktmbuf_free_bulk(bufs, nb_rx);
+				goto uninit;
+			}
+			next++;
+		}
+		rte_pktmbuf_free_bulk(bufs, nb_rx);
+		total += nb_rx;
+	}
+	if (total != REPLAY_TEST_NB_PKTS) {
+		printf("Received %u packets over %u queues, expected %u\n",
+		       total, nb_queues, REPLAY_TEST_NB_PKTS);
+		goto uninit;
+	}
+
+	ret = TEST_SUCCESS;
+uninit:
+	rte_vdev_uninit(REPLAY_TEST_DEV);
+	unlink(path);
+
+	return ret;
+}
+
+static int
+test_replay_rx_iface(void)
+{
+	TEST_ASSERT_FAIL(rte_vdev_init(REPLAY_TEST_DEV, "rx_iface=lo,replay_speed=1"),
+			 "Replay accepted from an interface");
+	TEST_ASSERT_FAIL(rte_vdev_init(REPLAY_TEST_DEV, "iface=lo,replay_queues=2"),
+			 "Replay accepted from an interface");
+
+	return TEST_SUCCESS;
+}
+
+static int
+pcap_replay_setup(void)
+{
+	replay_test.mp = rte_pktmbuf_pool_create("pcap_replay_test", 512, 0, 0,
+						 RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(replay_test.mp, "Failed to create mempool");
+
+	/* Registered by the pcap driver, shared with the application */
+	TEST_ASSERT_SUCCESS(rte_mbuf_dyn_rx_timestamp_register(&replay_test.ts_offset, NULL),
+			    "Failed to register Rx timestamp field");
+
+	return TEST_SUCCESS;
+}
+
+static void
+pcap_replay_teardown(void)
+{
+	rte_mempool_free(replay_test.mp);
+	replay_test.mp = NULL;
+}
+
+static struct unit_test_suite pcap_replay_testsuite = {
+	.suite_name = "pcap PMD replay test suite",
+	.setup = pcap_replay_setup,
+	.teardown = pcap_replay_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_replay_pcap),
+		TEST_CASE(test_replay_pcapng),
+		TEST_CASE(test_replay_hdr_write),
+		TEST_CASE(test_replay_pacing),
+		TEST_CASE(test_replay_queues),
+		TEST_CASE(test_replay_rx_iface),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_pmd_pcap_replay(void)
+{
+	return unit_test_suite_runner(&pcap_replay_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(pcap_replay_autotest, NOHUGE_OK, ASAN_OK, test_pmd_pcap_replay);
@@ -0,0 +1,400 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef RTE_EXEC_ENV_LINUX
+static int
+test_pmd_vnet_hdr(void)
+{
+	printf("vnet header offloads are Linux only, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/if_tun.h>
+#include <linux/virtio_net.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_string_fns.h>
+#include <rte_tcp.h>
+
+#define VNET_TEST_KERNEL_IFACE	"dpdkvnet0"
+#define VNET_TEST_TAP_IFACE	"dpdkvnet1"
+#define VNET_TEST_AF_PACKET	"net_af_packet_vnet_test"
+#define VNET_TEST_TAP		"net_tap_vnet_test"
+#define VNET_TEST_PAYLOAD	2400
+#define VNET_TEST_MSS		1000
+#define VNET_TEST_HDRS_LEN	(sizeof(struct rte_ether_hdr) + \
+				 sizeof(struct rte_ipv4_hdr) + \
+				 sizeof(struct rte_tcp_hdr))
+#define VNET_TEST_PKT_LEN	(VNET_TEST_HDRS_LEN + VNET_TEST_PAYLOAD)
+#define VNET_TEST_SPORT		4321
+#define VNET_TEST_TIMEOUT_MS	1000
+
+static struct vnet_hdr_test {
+	struct rte_mempool *mp;
+} vnet_test;
+
+/* IPv4/TCP packet to be segmented in VNET_TEST_MSS sized segments */
+static struct rte_mbuf *
+vnet_test_tso_pkt(void)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+	uint8_t *payload;
+	unsigned int i;
+
+	m = rte_pktmbuf_alloc(vnet_test.mp);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m, VNET_TEST_PKT_LEN);
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(eth, 0, VNET_TEST_HDRS_LEN);
+	memset(&eth->dst_addr, 0xff, sizeof(eth->dst_addr));
+	eth->src_addr.addr_bytes[0] = 0x02;
+	eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(VNET_TEST_PKT_LEN - sizeof(*eth));
+	ip->time_to_live = 64;
+	ip->next_proto_id = IPPROTO_TCP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(192, 0, 2, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(192, 0, 2, 2));
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+	tcp->src_port = RTE_BE16(VNET_TEST_SPORT);
+	tcp->dst_port = RTE_BE16(80);
+	tcp->sent_seq = RTE_BE32(1);
+	tcp->data_off = (sizeof(*tcp) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG | RTE_TCP_PSH_FLAG;
+	tcp->rx_win = RTE_BE16(65535);
+
+	payload = (uint8_t *)(tcp + 1);
+	for (i = 0; i < VNET_TEST_PAYLOAD; i++)
+		payload[i] = i;
+
+	m->l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip);
+	m->l4_len = sizeof(*tcp);
+	m->tso_segsz = VNET_TEST_MSS;
+	m->ol_flags = RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_TCP_SEG |
+		RTE_MBUF_F_TX_TCP_CKSUM;
+	/* as requested by DPDK for TSO: the L4 length is left out */
+	tcp->cksum = rte_ipv4_phdr_cksum(ip, m->ol_flags);
+
+	return m;
+}
+
+/* Return the IPv4 header if frame is part of the test TCP flow */
+static struct rte_ipv4_hdr *
+vnet_test_match(uint8_t *frame, ssize_t len)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)frame;
+	struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(eth + 1);
+	struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)(ip + 1);
+
+	if (len < (ssize_t)VNET_TEST_HDRS_LEN ||
+	    eth->ether_type != RTE_BE16(RTE_ETHER_TYPE_IPV4) ||
+	    ip->next_proto_id != IPPROTO_TCP ||
+	    tcp->src_port != RTE_BE16(VNET_TEST_SPORT))
+		return NULL;
+
+	return ip;
+}
+
+static int
+vnet_test_poll(int fd)
+{
+	struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+	return poll(&pfd, 1, VNET_TEST_TIMEOUT_MS) == 1 ? 0 : -1;
+}
+
+static int
+vnet_test_port_start(const char *name, const char *args, uint16_t *port_id)
+{
+	struct rte_eth_conf conf = {
+		.txmode.offloads = RTE_ETH_TX_OFFLOAD_TCP_TSO |
+			RTE_ETH_TX_OFFLOAD_TCP_CKSUM,
+	};
+	struct rte_eth_dev_info info;
+
+	if (rte_vdev_init(name, args) < 0)
+		return TEST_SKIPPED;
+	TEST_ASSERT_SUCCESS(rte_eth_dev_get_port_by_name(name, port_id),
+			    "%s has no port", name);
+	TEST_ASSERT_SUCCESS(rte_eth_dev_info_get(*port_id, &info),
+			    "Cannot get %s info", name);
+	TEST_ASSERT((info.tx_offload_capa & conf.txmode.offloads) ==
+		    conf.txmode.offloads, "%s does not advertise TSO", name);
+
+	TEST_ASSERT_SUCCESS(rte_eth_dev_configure(*port_id, 1, 1, &conf),
+			    "Cannot configure %s", name);
+	TEST_ASSERT_SUCCESS(rte_eth_rx_queue_setup(*port_id, 0, 64,
+			    rte_eth_dev_socket_id(*port_id), NULL, vnet_test.mp),
+			    "Cannot set up %s Rx queue", name);
+	TEST_ASSERT_SUCCESS(rte_eth_tx_queue_setup(*port_id, 0, 64,
+			    rte_eth_dev_socket_id(*port_id), NULL),
+			    "Cannot set up %s Tx queue", name);
+	TEST_ASSERT_SUCCESS(rte_eth_dev_start(*port_id),
+			    "Cannot start %s", name);
+
+	return TEST_SUCCESS;
+}
+
+static void
+vnet_test_port_stop(const char *name, uint16_t port_id)
+{
+	rte_eth_dev_stop(port_id);
+	rte_eth_dev_close(port_id);
+	rte_vdev_uninit(name);
+}
+
+/* Kernel tap interface without offloads, so the kernel segments towards it */
+static int
+vnet_test_kernel_tap(const char *iface)
+{
+	struct ifreq ifr;
+	int sock;
+	int fd;
+
+	fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+	if (fd < 0)
+		return -1;
+
+	memset(&ifr, 0, sizeof(ifr));
+	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+	strlcpy(ifr.ifr_name, iface, IFNAMSIZ);
+	if (ioctl(fd, TUNSETIFF, &ifr) < 0)
+		goto error;
+
+	sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0)
+		goto error;
+	if (ioctl(sock, SIOCGIFFLAGS, &ifr) < 0) {
+		close(sock);
+		goto error;
+	}
+	ifr.ifr_flags |= IFF_UP;
+	if (ioctl(sock, SIOCSIFFLAGS, &ifr) < 0) {
+		close(sock);
+		goto error;
+	}
+	close(sock);
+
+	return fd;
+error:
+	close(fd);
+	return -1;
+}
+
+/*
+ * af_packet hands a TSO packet to an interface without segmentation
+ * offload: every segment the kernel produces must carry valid checksums.
+ */
+static int
+test_vnet_hdr_af_packet_tso(void)
+{
+	uint8_t frame[RTE_ETHER_MAX_JUMBO_FRAME_LEN];
+	unsigned int payload = 0;
+	unsigned int nb_segs = 0;
+	struct rte_mbuf *m;
+	uint16_t port_id;
+	int ret;
+	int fd;
+
+	fd = vnet_test_kernel_tap(VNET_TEST_KERNEL_IFACE);
+	if (fd < 0) {
+		printf("Cannot create %s: %s, skipping test\n",
+		       VNET_TEST_KERNEL_IFACE, strerror(errno));
+		return TEST_SKIPPED;
+	}
+
+	ret = vnet_test_port_start(VNET_TEST_AF_PACKET,
+				   "iface=" VNET_TEST_KERNEL_IFACE
+				   ",vnet_hdr=1,blocksz=4096,framesz=4096",
+				   &port_id);
+	if (ret != TEST_SUCCESS) {
+		close(fd);
+		return ret;
+	}
+
+	m = vnet_test_tso_pkt();
+	TEST_ASSERT_NOT_NULL(m, "Cannot build TSO packet");
+	TEST_ASSERT_EQUAL(rte_eth_tx_burst(port_id, 0, &m, 1), 1,
+			  "Cannot send TSO packet");
+
+	while (payload < VNET_TEST_PAYLOAD && vnet_test_poll(fd) == 0) {
+		struct rte_ipv4_hdr *ip;
+		ssize_t len;
+
+		len = read(fd, frame, sizeof(frame));
+		ip = vnet_test_match(frame, len);
+		if (ip == NULL)
+			continue;
+
+		TEST_ASSERT(len <= (ssize_t)(VNET_TEST_HDRS_LEN + VNET_TEST_MSS),
+			    "Segment %u of %zd bytes exceeds the MSS",
+			    nb_segs, len);
+		TEST_ASSERT_EQUAL(rte_ipv4_cksum(ip), 0,
+				  "Bad IP checksum in segment %u", nb_segs);
+		TEST_ASSERT_SUCCESS(rte_ipv4_udptcp_cksum_verify(ip, ip + 1),
+				    "Bad TCP checksum in segment %u", nb_segs);
+		payload += len - VNET_TEST_HDRS_LEN;
+		nb_segs++;
+	}
+
+	vnet_test_port_stop(VNET_TEST_AF_PACKET, port_id);
+	close(fd);
+
+	TEST_ASSERT_EQUAL(nb_segs,
+			  RTE_ALIGN_CEIL(VNET_TEST_PAYLOAD, VNET_TEST_MSS) /
+			  VNET_TEST_MSS, "Got %u segments", nb_segs);
+	TEST_ASSERT_EQUAL(payload, VNET_TEST_PAYLOAD,
+			  "Got %u bytes of payload", payload);
+
+	return TEST_SUCCESS;
+}
+
+/*
+ * tap hands a TSO packet to the kernel: once the partial checksum
+ * announced in the vnet header is completed, it must be valid for
+ * the whole packet.
+ */
+static int
+test_vnet_hdr_tap_tso(void)
+{
+	uint8_t buf[sizeof(struct virtio_net_hdr) + VNET_TEST_PKT_LEN + 64];
+	struct virtio_net_hdr *hdr = (struct virtio_net_hdr *)buf;
+	uint8_t *frame = buf + sizeof(*hdr);
+	struct sockaddr_ll sll = {
+		.sll_family = AF_PACKET,
+		.sll_protocol = RTE_BE16(ETH_P_ALL),
+	};
+	struct rte_ipv4_hdr *ip = NULL;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+	uint16_t port_id;
+	ssize_t len = 0;
+	int one = 1;
+	int ret;
+	int fd;
+
+	ret = vnet_test_port_start(VNET_TEST_TAP,
+				   "iface=" VNET_TEST_TAP_IFACE ",vnet_hdr",
+				   &port_id);
+	if (ret != TEST_SUCCESS)
+		return ret;
+
+	/* capture what the kernel receives, with its offload state */
+	fd = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, RTE_BE16(ETH_P_ALL));
+	TEST_ASSERT(fd >= 0, "Cannot open packet socket: %s", strerror(errno));
+	TEST_ASSERT_SUCCESS(setsockopt(fd, SOL_PACKET, PACKET_VNET_HDR,
+				       &one, sizeof(one)),
+			    "Cannot enable PACKET_VNET_HDR");
+	sll.sll_ifindex = if_nametoindex(VNET_TEST_TAP_IFACE);
+	TEST_ASSERT_SUCCESS(bind(fd, (struct sockaddr *)&sll, sizeof(sll)),
+			    "Cannot bind packet socket: %s", strerror(errno));
+
+	m = vnet_test_tso_pkt();
+	TEST_ASSERT_NOT_NULL(m, "Cannot build TSO packet");
+	TEST_ASSERT_EQUAL(rte_eth_tx_burst(port_id, 0, &m, 1), 1,
+			  "Cannot send TSO packet");
+
+	while (ip == NULL && vnet_test_poll(fd) == 0) {
+		len = recv(fd, buf, sizeof(buf), 0);
+		ip = vnet_test_match(frame, len - (ssize_t)sizeof(*hdr));
+	}
+
+	close(fd);
+	vnet_test_port_stop(VNET_TEST_TAP, port_id);
+
+	TEST_ASSERT_NOT_NULL(ip, "TSO packet not received by the kernel");
+	TEST_ASSERT_EQUAL(len, (ssize_t)(sizeof(*hdr) + VNET_TEST_PKT_LEN),
+			  "Got %zd bytes", len);
+	TEST_ASSERT_EQUAL(hdr->gso_type, VIRTIO_NET_HDR_GSO_TCPV4,
+			  "Bad GSO type %u", hdr->gso_type);
+	TEST_ASSERT_EQUAL(hdr->gso_size, VNET_TEST_MSS,
+			  "Bad GSO size %u", hdr->gso_size);
+	TEST_ASSERT(hdr->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM,
+		    "No checksum offload requested");
+	TEST_ASSERT_EQUAL(hdr->csum_start,
+			  sizeof(struct rte_ether_hdr) + sizeof(*ip),
+			  "Bad checksum start %u", hdr->csum_start);
+
+	/* complete the checksum as the kernel does before segmenting */
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+	tcp->cksum = ~rte_raw_cksum(frame + hdr->csum_start,
+				    VNET_TEST_PKT_LEN - hdr->csum_start);
+	TEST_ASSERT_SUCCESS(rte_ipv4_udptcp_cksum_verify(ip, tcp),
+			    "Bad TCP pseudo header checksum");
+
+	return TEST_SUCCESS;
+}
+
+static int
+vnet_hdr_setup(void)
+{
+	vnet_test.mp = rte_pktmbuf_pool_create("vnet_hdr_test_pool", 512, 0, 0,
+					       RTE_PKTMBUF_HEADROOM + 4096,
+					       SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(vnet_test.mp, "Cannot create mbuf pool");
+
+	return TEST_SUCCESS;
+}
+
+static void
+vnet_hdr_teardown(void)
+{
+	rte_mempool_free(vnet_test.mp);
+	vnet_test.mp = NULL;
+}
+
+static struct unit_test_suite vnet_hdr_testsuite = {
+	.suite_name = "vnet header offload test suite",
+	.setup = vnet_hdr_setup,
+	.teardown = vnet_hdr_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_vnet_hdr_af_packet_tso),
+		TEST_CASE(test_vnet_hdr_tap_tso),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_pmd_vnet_hdr(void)
+{
+	return unit_test_suite_runner(&vnet_hdr_testsuite);
+}
+
+#endif /* RTE_EXEC_ENV_LINUX */
+
+REGISTER_FAST_TEST(vnet_hdr_autotest, NOHUGE_OK, ASAN_OK, test_pmd_vnet_hdr);
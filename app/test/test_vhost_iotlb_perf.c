@@ -0,0 +1,451 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+
+#ifndef RTE_EXEC_ENV_LINUX
+static int
+test_vhost_iotlb_perf(void)
+{
+	printf("vhost IOTLB perf not supported on this OS, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <rte_cycles.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_stdatomic.h>
+#include <rte_vhost.h>
+
+/*
+ * IOTLB translation cost seen by the datapath: the test is the vhost-user
+ * frontend of a vIOMMU enabled guest. Each packet buffer page is mapped
+ * by its own IOTLB entry, and rte_vhost_dequeue_burst() fetches packets
+ * from these pages, either walking them in order (as a guest recycling
+ * its buffers) or at random.
+ */
+
+#define IOTLB_PERF_PAGE_SIZE	4096
+/* Leave one cache entry to the rings */
+#define IOTLB_PERF_MAX_ENTRIES	65535
+#define IOTLB_PERF_RING_SIZE	256
+#define IOTLB_PERF_BURST	32
+#define IOTLB_PERF_BURSTS	(1 << 15)
+#define IOTLB_PERF_PKT_LEN	64
+#define IOTLB_PERF_WAIT_MS	5000
+/* Queues of the guest, vhost dequeues from its transmit queue */
+#define IOTLB_PERF_RXQ		0
+#define IOTLB_PERF_TXQ		1
+
+/* Guest memory: the rings of both queues, then the packet buffers */
+#define IOTLB_PERF_RING_PAGES	6
+#define IOTLB_PERF_BUF_PAGES	1024
+#define IOTLB_PERF_MEM_SIZE \
+	((IOTLB_PERF_RING_PAGES + IOTLB_PERF_BUF_PAGES) * IOTLB_PERF_PAGE_SIZE)
+#define IOTLB_PERF_RING_IOVA	0x100000000ULL
+#define IOTLB_PERF_BUF_IOVA	0x200000000ULL
+
+/* The vhost-user messages sent by the test, as per the specification */
+#define VHOST_USER_GET_FEATURES		1
+#define VHOST_USER_SET_FEATURES		2
+#define VHOST_USER_SET_OWNER		3
+#define VHOST_USER_SET_MEM_TABLE	5
+#define VHOST_USER_SET_VRING_NUM	8
+#define VHOST_USER_SET_VRING_ADDR	9
+#define VHOST_USER_SET_VRING_BASE	10
+#define VHOST_USER_SET_VRING_KICK	12
+#define VHOST_USER_SET_VRING_CALL	13
+#define VHOST_USER_IOTLB_MSG		22
+#define VHOST_USER_VERSION		0x1
+#define VHOST_USER_VRING_NOFD		(1 << 8)
+
+struct iotlb_perf_hdr {
+	uint32_t request;
+	uint32_t flags;
+	uint32_t size;
+};
+
+struct iotlb_perf_mem {
+	uint32_t nregions;
+	uint32_t padding;
+	uint64_t guest_phys_addr;
+	uint64_t memory_size;
+	uint64_t userspace_addr;
+	uint64_t mmap_offset;
+};
+
+static const uint32_t entry_counts[] = { 1024, 4096, 16384, IOTLB_PERF_MAX_ENTRIES };
+
+static struct iotlb_perf {
+	char path[64];
+	struct rte_mempool *mp;
+	int mem_fd;
+	uint8_t *mem;
+	int sock;
+	RTE_ATOMIC(int) vid;
+	/* Transmit queue of the guest, dequeued by vhost */
+	struct vring_desc *desc;
+	struct vring_avail *avail;
+	uint16_t avail_idx;
+} iotlb_perf;
+
+static int
+iotlb_perf_new_device(int vid)
+{
+	rte_atomic_store_explicit(&iotlb_perf.vid, vid, rte_memory_order_release);
+	return 0;
+}
+
+static void
+iotlb_perf_destroy_device(int vid __rte_unused)
+{
+	rte_atomic_store_explicit(&iotlb_perf.vid, -1, rte_memory_order_release);
+}
+
+static const struct rte_vhost_device_ops iotlb_perf_ops = {
+	.new_device = iotlb_perf_new_device,
+	.destroy_device = iotlb_perf_destroy_device,
+};
+
+static int
+iotlb_perf_send(uint32_t request, const void *payload, uint32_t size, int fd)
+{
+	uint8_t buf[sizeof(struct iotlb_perf_hdr) + sizeof(struct iotlb_perf_mem)];
+	struct iotlb_perf_hdr hdr = {
+		.request = request,
+		.flags = VHOST_USER_VERSION,
+		.size = size,
+	};
+	char control[CMSG_SPACE(sizeof(fd))];
+	struct msghdr msgh;
+	struct iovec iov;
+
+	RTE_VERIFY(size <= sizeof(buf) - sizeof(hdr));
+	memcpy(buf, &hdr, sizeof(hdr));
+	memcpy(buf + sizeof(hdr), payload, size);
+	iov.iov_base = buf;
+	iov.iov_len = sizeof(hdr) + size;
+
+	memset(&msgh, 0, sizeof(msgh));
+	msgh.msg_iov = &iov;
+	msgh.msg_iovlen = 1;
+	if (fd >= 0) {
+		struct cmsghdr *cmsg;
+
+		memset(control, 0, sizeof(control));
+		msgh.msg_control = control;
+		msgh.msg_controllen = sizeof(control);
+		cmsg = CMSG_FIRSTHDR(&msgh);
+		cmsg->cmsg_len = CMSG_LEN(sizeof(fd));
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		memcpy(CMSG_DATA(cmsg), &fd, sizeof(fd));
+	}
+
+	return sendmsg(iotlb_perf.sock, &msgh, 0) == (ssize_t)iov.iov_len ? 0 : -1;
+}
+
+static int
+iotlb_perf_send_u64(uint32_t request, uint64_t val)
+{
+	return iotlb_perf_send(request, &val, sizeof(val), -1);
+}
+
+static int
+iotlb_perf_get_features(uint64_t *features)
+{
+	struct iotlb_perf_hdr hdr;
+
+	if (iotlb_perf_send(VHOST_USER_GET_FEATURES, NULL, 0, -1) < 0 ||
+			recv(iotlb_perf.sock, &hdr, sizeof(hdr), MSG_WAITALL) != sizeof(hdr) ||
+			hdr.size != sizeof(*features) ||
+			recv(iotlb_perf.sock, features, sizeof(*features), MSG_WAITALL) !=
+				sizeof(*features))
+		return -1;
+
+	return 0;
+}
+
+static int
+iotlb_perf_map(uint64_t iova, uint64_t offset, uint64_t size)
+{
+	struct vhost_iotlb_msg msg = {
+		.iova = iova,
+		.size = size,
+		.uaddr = (uintptr_t)iotlb_perf.mem + offset,
+		.perm = VHOST_ACCESS_RW,
+		.type = VHOST_IOTLB_UPDATE,
+	};
+
+	return iotlb_perf_send(VHOST_USER_IOTLB_MSG, &msg, sizeof(msg), -1);
+}
+
+static uint64_t
+iotlb_perf_buf_iova(uint32_t entry)
+{
+	return IOTLB_PERF_BUF_IOVA + (uint64_t)entry * IOTLB_PERF_PAGE_SIZE;
+}
+
+/* Rings of queue @index use three pages: descriptors, avail and used */
+static int
+iotlb_perf_vring_setup(uint32_t index)
+{
+	uint64_t iova = IOTLB_PERF_RING_IOVA + index * 3 * IOTLB_PERF_PAGE_SIZE;
+	struct vhost_vring_state state = { .index = index };
+	struct vhost_vring_addr addr = {
+		.index = index,
+		.desc_user_addr = iova,
+		.avail_user_addr = iova + IOTLB_PERF_PAGE_SIZE,
+		.used_user_addr = iova + 2 * IOTLB_PERF_PAGE_SIZE,
+	};
+
+	state.num = IOTLB_PERF_RING_SIZE;
+	if (iotlb_perf_send(VHOST_USER_SET_VRING_NUM, &state, sizeof(state), -1) < 0)
+		return -1;
+	state.num = 0;
+	if (iotlb_perf_send(VHOST_USER_SET_VRING_BASE, &state, sizeof(state), -1) < 0 ||
+			iotlb_perf_send(VHOST_USER_SET_VRING_ADDR, &addr, sizeof(addr), -1) < 0 ||
+			iotlb_perf_send_u64(VHOST_USER_SET_VRING_CALL,
+					    index | VHOST_USER_VRING_NOFD) < 0 ||
+			iotlb_perf_send_u64(VHOST_USER_SET_VRING_KICK,
+					    index | VHOST_USER_VRING_NOFD) < 0)
+		return -1;
+
+	return 0;
+}
+
+/* Connect as a guest with @nb_entries buffer pages mapped */
+static int
+iotlb_perf_connect(uint32_t nb_entries)
+{
+	const uint64_t wanted = RTE_BIT64(VIRTIO_F_VERSION_1) |
+		RTE_BIT64(VIRTIO_F_IOMMU_PLATFORM);
+	struct iotlb_perf_mem mem = {
+		.nregions = 1,
+		.memory_size = IOTLB_PERF_MEM_SIZE,
+		.userspace_addr = (uintptr_t)iotlb_perf.mem,
+	};
+	struct sockaddr_un un;
+	uint64_t features;
+	unsigned int ms;
+	uint32_t i;
+
+	memset(iotlb_perf.mem, 0, IOTLB_PERF_MEM_SIZE);
+	iotlb_perf.avail_idx = 0;
+
+	iotlb_perf.sock = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (iotlb_perf.sock < 0)
+		return -1;
+	memset(&un, 0, sizeof(un));
+	un.sun_family = AF_UNIX;
+	strlcpy(un.sun_path, iotlb_perf.path, sizeof(un.sun_path));
+	if (connect(iotlb_perf.sock, (struct sockaddr *)&un, sizeof(un)) < 0)
+		return -1;
+
+	if (iotlb_perf_get_features(&features) < 0 || (features & wanted) != wanted) {
+		printf("vhost does not offer IOMMU support\n");
+		return -1;
+	}
+	if (iotlb_perf_send(VHOST_USER_SET_OWNER, NULL, 0, -1) < 0 ||
+			iotlb_perf_send_u64(VHOST_USER_SET_FEATURES, wanted) < 0 ||
+			iotlb_perf_send(VHOST_USER_SET_MEM_TABLE, &mem, sizeof(mem),
+					iotlb_perf.mem_fd) < 0)
+		return -1;
+
+	if (iotlb_perf_map(IOTLB_PERF_RING_IOVA, 0,
+			   IOTLB_PERF_RING_PAGES * IOTLB_PERF_PAGE_SIZE) < 0)
+		return -1;
+	for (i = 0; i < nb_entries; i++) {
+		uint64_t page = IOTLB_PERF_RING_PAGES + i % IOTLB_PERF_BUF_PAGES;
+
+		if (iotlb_perf_map(iotlb_perf_buf_iova(i), page * IOTLB_PERF_PAGE_SIZE,
+				   IOTLB_PERF_PAGE_SIZE) < 0)
+			return -1;
+	}
+
+	if (iotlb_perf_vring_setup(IOTLB_PERF_RXQ) < 0 || iotlb_perf_vring_setup(IOTLB_PERF_TXQ) < 0)
+		return -1;
+
+	iotlb_perf.desc = (struct vring_desc *)(iotlb_perf.mem +
+			IOTLB_PERF_TXQ * 3 * IOTLB_PERF_PAGE_SIZE);
+	iotlb_perf.avail = (struct vring_avail *)((uint8_t *)iotlb_perf.desc +
+			IOTLB_PERF_PAGE_SIZE);
+
+	for (ms = 0; ms < IOTLB_PERF_WAIT_MS; ms += 10) {
+		if (rte_atomic_load_explicit(&iotlb_perf.vid, rte_memory_order_acquire) >= 0)
+			return 0;
+		rte_delay_ms(10);
+	}
+	printf("vhost device not ready\n");
+
+	return -1;
+}
+
+static void
+iotlb_perf_disconnect(void)
+{
+	unsigned int ms;
+
+	if (iotlb_perf.sock >= 0)
+		close(iotlb_perf.sock);
+	iotlb_perf.sock = -1;
+
+	for (ms = 0; ms < IOTLB_PERF_WAIT_MS; ms += 10) {
+		if (rte_atomic_load_explicit(&iotlb_perf.vid, rte_memory_order_acquire) < 0)
+			return;
+		rte_delay_ms(10);
+	}
+}
+
+/* Dequeue cycles per packet, with buffers in the pages given by @entries */
+static int
+iotlb_perf_dequeue(const uint32_t *entries, double *cycles)
+{
+	struct rte_mbuf *pkts[IOTLB_PERF_BURST];
+	int vid = rte_atomic_load_explicit(&iotlb_perf.vid, rte_memory_order_relaxed);
+	uint64_t start, total = 0;
+	unsigned int i, j;
+	uint16_t nb_rx;
+
+	for (i = 0; i < IOTLB_PERF_BURSTS; i++) {
+		for (j = 0; j < IOTLB_PERF_BURST; j++) {
+			iotlb_perf.desc[j] = (struct vring_desc){
+				.addr = iotlb_perf_buf_iova(entries[i * IOTLB_PERF_BURST + j]),
+				.len = sizeof(struct virtio_net_hdr_mrg_rxbuf) +
+					IOTLB_PERF_PKT_LEN,
+			};
+			iotlb_perf.avail->ring[(iotlb_perf.avail_idx + j) &
+					       (IOTLB_PERF_RING_SIZE - 1)] = j;
+		}
+		iotlb_perf.avail_idx += IOTLB_PERF_BURST;
+		rte_atomic_thread_fence(rte_memory_order_release);
+		iotlb_perf.avail->idx = iotlb_perf.avail_idx;
+
+		start = rte_rdtsc_precise();
+		nb_rx = rte_vhost_dequeue_burst(vid, IOTLB_PERF_TXQ, iotlb_perf.mp, pkts,
+						IOTLB_PERF_BURST);
+		total += rte_rdtsc_precise() - start;
+
+		rte_pktmbuf_free_bulk(pkts, nb_rx);
+		if (nb_rx != IOTLB_PERF_BURST) {
+			printf("Dequeued %u packets out of %u\n", nb_rx, IOTLB_PERF_BURST);
+			return -1;
+		}
+	}
+
+	*cycles = (double)total / (IOTLB_PERF_BURSTS * IOTLB_PERF_BURST);
+
+	return 0;
+}
+
+static int
+iotlb_perf_run(uint32_t nb_entries, uint32_t *entries)
+{
+	double seq, rnd;
+	unsigned int i;
+	int ret;
+
+	if (iotlb_perf_connect(nb_entries) < 0) {
+		printf("Cannot connect to vhost with %u IOTLB entries\n", nb_entries);
+		iotlb_perf_disconnect();
+		return -1;
+	}
+
+	for (i = 0; i < IOTLB_PERF_BURSTS * IOTLB_PERF_BURST; i++)
+		entries[i] = i % nb_entries;
+	ret = iotlb_perf_dequeue(entries, &seq);
+
+	for (i = 0; i < IOTLB_PERF_BURSTS * IOTLB_PERF_BURST; i++)
+		entries[i] = rte_rand_max(nb_entries);
+	if (ret == 0)
+		ret = iotlb_perf_dequeue(entries, &rnd);
+
+	if (ret == 0)
+		printf("%8u %10.2f cycles %10.2f cycles\n", nb_entries, seq, rnd);
+
+	iotlb_perf_disconnect();
+
+	return ret;
+}
+
+static int
+test_vhost_iotlb_perf(void)
+{
+	uint32_t *entries = NULL;
+	int ret = TEST_FAILED;
+	unsigned int i;
+
+	iotlb_perf.sock = -1;
+	iotlb_perf.vid = -1;
+	snprintf(iotlb_perf.path, sizeof(iotlb_perf.path), "/tmp/vhost_iotlb_perf_%d.sock",
+		 getpid());
+
+	iotlb_perf.mem_fd = memfd_create("vhost_iotlb_perf", 0);
+	if (iotlb_perf.mem_fd < 0 || ftruncate(iotlb_perf.mem_fd, IOTLB_PERF_MEM_SIZE) < 0) {
+		printf("Cannot create guest memory\n");
+		goto out;
+	}
+	iotlb_perf.mem = mmap(NULL, IOTLB_PERF_MEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+			      iotlb_perf.mem_fd, 0);
+	if (iotlb_perf.mem == MAP_FAILED) {
+		iotlb_perf.mem = NULL;
+		printf("Cannot map guest memory\n");
+		goto out;
+	}
+
+	entries = malloc(IOTLB_PERF_BURSTS * IOTLB_PERF_BURST * sizeof(*entries));
+	iotlb_perf.mp = rte_pktmbuf_pool_create("vhost_iotlb_perf", 1024, 32, 0,
+						RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (entries == NULL || iotlb_perf.mp == NULL) {
+		printf("Cannot allocate test resources\n");
+		goto out;
+	}
+
+	unlink(iotlb_perf.path);
+	if (rte_vhost_driver_register(iotlb_perf.path, RTE_VHOST_USER_IOMMU_SUPPORT) < 0)
+		goto out;
+	if (rte_vhost_driver_callback_register(iotlb_perf.path, &iotlb_perf_ops) < 0 ||
+			rte_vhost_driver_start(iotlb_perf.path) < 0) {
+		printf("Cannot start vhost driver\n");
+		goto unregister;
+	}
+
+	printf("\nDequeue cost per packet\n%8s %16s %16s\n", "entries", "sequential",
+	       "random");
+
+	for (i = 0; i < RTE_DIM(entry_counts); i++) {
+		if (iotlb_perf_run(entry_counts[i], entries) < 0)
+			goto unregister;
+	}
+
+	ret = TEST_SUCCESS;
+unregister:
+	rte_vhost_driver_unregister(iotlb_perf.path);
+	unlink(iotlb_perf.path);
+out:
+	rte_mempool_free(iotlb_perf.mp);
+	free(entries);
+	if (iotlb_perf.mem != NULL)
+		munmap(iotlb_perf.mem, IOTLB_PERF_MEM_SIZE);
+	if (iotlb_perf.mem_fd >= 0)
+		close(iotlb_perf.mem_fd);
+	memset(&iotlb_perf, 0, sizeof(iotlb_perf));
+
+	return ret;
+}
+
+#endif /* RTE_EXEC_ENV_LINUX */
+
+REGISTER_PERF_TEST(vhost_iotlb_perf_autotest, test_vhost_iotlb_perf);
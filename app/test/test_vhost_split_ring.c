@@ -0,0 +1,389 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_vhost_split_ring(void)
+{
+	printf("vhost not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <unistd.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_mbuf.h>
+
+/*
+ * A vhost port and a virtio-user port connected in this process over
+ * in-order split rings. The vhost Tx path is the split ring enqueue and
+ * its Rx path the split ring dequeue, both of which take batches of
+ * consecutive single descriptors and fall back to the per-packet path
+ * otherwise.
+ */
+#define SPLIT_TEST_VHOST	"net_vhost_split_test"
+#define SPLIT_TEST_VIRTIO	"net_virtio_user_split_test"
+#define SPLIT_TEST_QUEUE_SIZE	64
+#define SPLIT_TEST_NB_MBUF	2048
+#define SPLIT_TEST_BURST	32
+#define SPLIT_TEST_LINK_WAIT_MS	5000
+#define SPLIT_TEST_POLLS	1000
+/* More packets than the 16-bit ring indexes can count */
+#define SPLIT_TEST_NB_PKTS	(UINT16_MAX + 4096)
+/* Larger than the Rx buffers of the receiving side */
+#define SPLIT_TEST_BIG_LEN	3000
+
+/* Burst sizes leaving batches at every offset of the ring */
+static const uint16_t burst_sizes[] = { 32, 7, 4, 1, 13, 31, 2, 16 };
+
+static struct split_test {
+	char sock_path[64];
+	struct rte_mempool *mp;
+	/* Single segments holding SPLIT_TEST_BIG_LEN bytes */
+	struct rte_mempool *big_mp;
+	uint16_t vhost_port;
+	uint16_t virtio_port;
+	uint32_t tx_seq;
+	uint32_t rx_seq;
+} split_test;
+
+enum split_test_pkt {
+	SPLIT_TEST_PKT_SMALL,
+	SPLIT_TEST_PKT_CHAINED,
+	SPLIT_TEST_PKT_BIG,
+};
+
+static uint8_t
+split_test_byte(uint32_t seq, uint32_t off)
+{
+	return (seq * 7 + off) & 0xff;
+}
+
+static uint16_t
+split_test_len(uint32_t seq)
+{
+	return 60 + (seq * 37) % 1400;
+}
+
+/* Packet carrying its sequence number in the first bytes */
+static struct rte_mbuf *
+split_test_pkt_create(uint32_t seq, enum split_test_pkt type)
+{
+	uint16_t len = split_test_len(seq);
+	struct rte_mbuf *m, *seg;
+	uint32_t off = 0;
+
+	if (type == SPLIT_TEST_PKT_BIG) {
+		m = rte_pktmbuf_alloc(split_test.big_mp);
+		len = SPLIT_TEST_BIG_LEN;
+	} else {
+		m = rte_pktmbuf_alloc(split_test.mp);
+	}
+	if (m == NULL)
+		return NULL;
+
+	for (seg = m; seg != NULL; seg = seg->next) {
+		uint16_t seg_len = len - off;
+		uint8_t *data;
+		uint16_t i;
+
+		if (type == SPLIT_TEST_PKT_CHAINED && seg == m)
+			seg_len /= 2;
+		data = (uint8_t *)rte_pktmbuf_append(m, seg_len);
+		if (data == NULL)
+			goto fail;
+		for (i = 0; i < seg_len; i++)
+			data[i] = split_test_byte(seq, off + i);
+		off += seg_len;
+
+		if (off < len) {
+			struct rte_mbuf *next = rte_pktmbuf_alloc(split_test.mp);
+
+			if (next == NULL || rte_pktmbuf_chain(m, next) != 0) {
+				rte_pktmbuf_free(next);
+				goto fail;
+			}
+		}
+	}
+	memcpy(rte_pktmbuf_mtod(m, void *), &seq, sizeof(seq));
+
+	return m;
+
+fail:
+	rte_pktmbuf_free(m);
+	return NULL;
+}
+
+static int
+split_test_pkt_check(struct rte_mbuf *m)
+{
+	uint8_t data[SPLIT_TEST_BIG_LEN];
+	uint32_t seq = split_test.rx_seq;
+	const uint8_t *p;
+	uint32_t i;
+
+	if (m->pkt_len != split_test_len(seq) && m->pkt_len != SPLIT_TEST_BIG_LEN) {
+		printf("Packet %u has length %u\n", seq, m->pkt_len);
+		return -1;
+	}
+
+	p = rte_pktmbuf_read(m, 0, m->pkt_len, data);
+	if (p == NULL || memcmp(p, &seq, sizeof(seq)) != 0) {
+		printf("Packet %u received out of order\n", seq);
+		return -1;
+	}
+	for (i = sizeof(seq); i < m->pkt_len; i++) {
+		if (p[i] != split_test_byte(seq, i)) {
+			printf("Packet %u differs at byte %u\n", seq, i);
+			return -1;
+		}
+	}
+	split_test.rx_seq++;
+
+	return 0;
+}
+
+static int
+split_test_rx(uint16_t port)
+{
+	struct rte_mbuf *pkts[SPLIT_TEST_BURST];
+	uint16_t nb_rx, i;
+	int ret = 0;
+
+	nb_rx = rte_eth_rx_burst(port, 0, pkts, RTE_DIM(pkts));
+	for (i = 0; i < nb_rx && ret == 0; i++)
+		ret = split_test_pkt_check(pkts[i]);
+	rte_pktmbuf_free_bulk(pkts, nb_rx);
+
+	return ret;
+}
+
+/*
+ * Send a burst of packets of the given type from one port to the other
+ * and receive all of them. The type is applied to the packet at
+ * position @odd_pos only, the others are small single segments.
+ */
+static int
+split_test_xfer(uint16_t tx_port, uint16_t rx_port, uint16_t nb_pkts,
+		enum split_test_pkt type, uint16_t odd_pos)
+{
+	struct rte_mbuf *pkts[SPLIT_TEST_BURST];
+	unsigned int polls;
+	uint16_t sent, i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		pkts[i] = split_test_pkt_create(split_test.tx_seq + i,
+				i == odd_pos ? type : SPLIT_TEST_PKT_SMALL);
+		if (pkts[i] == NULL) {
+			printf("Failed to create packet\n");
+			rte_pktmbuf_free_bulk(pkts, i);
+			return -1;
+		}
+	}
+	split_test.tx_seq += nb_pkts;
+
+	sent = 0;
+	for (polls = 0; polls < SPLIT_TEST_POLLS; polls++) {
+		if (sent < nb_pkts)
+			sent += rte_eth_tx_burst(tx_port, 0, &pkts[sent], nb_pkts - sent);
+		if (split_test_rx(rx_port) < 0)
+			break;
+		if (split_test.rx_seq == split_test.tx_seq)
+			return 0;
+	}
+
+	if (sent < nb_pkts)
+		rte_pktmbuf_free_bulk(&pkts[sent], nb_pkts - sent);
+	printf("Received %u packets out of %u\n", split_test.rx_seq, split_test.tx_seq);
+
+	return -1;
+}
+
+static int
+split_test_run(uint16_t tx_port, uint16_t rx_port, enum split_test_pkt type)
+{
+	unsigned int round = 0;
+
+	split_test.tx_seq = 0;
+	split_test.rx_seq = 0;
+
+	while (split_test.tx_seq < SPLIT_TEST_NB_PKTS) {
+		uint16_t nb_pkts = burst_sizes[round % RTE_DIM(burst_sizes)];
+
+		/* Move the odd packet through all positions of the bursts */
+		if (split_test_xfer(tx_port, rx_port, nb_pkts, type,
+				    (round / RTE_DIM(burst_sizes)) % nb_pkts) < 0)
+			return TEST_FAILED;
+		round++;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_split_enqueue(void)
+{
+	return split_test_run(split_test.vhost_port, split_test.virtio_port,
+			      SPLIT_TEST_PKT_SMALL);
+}
+
+static int
+test_split_enqueue_chained(void)
+{
+	return split_test_run(split_test.vhost_port, split_test.virtio_port,
+			      SPLIT_TEST_PKT_CHAINED);
+}
+
+static int
+test_split_enqueue_big(void)
+{
+	/* Spread over several Rx buffers */
+	return split_test_run(split_test.vhost_port, split_test.virtio_port,
+			      SPLIT_TEST_PKT_BIG);
+}
+
+static int
+test_split_dequeue(void)
+{
+	return split_test_run(split_test.virtio_port, split_test.vhost_port,
+			      SPLIT_TEST_PKT_SMALL);
+}
+
+static int
+test_split_dequeue_chained(void)
+{
+	/* Sent as chained descriptors */
+	return split_test_run(split_test.virtio_port, split_test.vhost_port,
+			      SPLIT_TEST_PKT_CHAINED);
+}
+
+static int
+test_split_dequeue_big(void)
+{
+	/* Copied into chained mbufs */
+	return split_test_run(split_test.virtio_port, split_test.vhost_port,
+			      SPLIT_TEST_PKT_BIG);
+}
+
+static int
+split_test_port_start(uint16_t port)
+{
+	struct rte_eth_conf conf;
+
+	memset(&conf, 0, sizeof(conf));
+	if (rte_eth_dev_configure(port, 1, 1, &conf) < 0 ||
+			rte_eth_rx_queue_setup(port, 0, SPLIT_TEST_QUEUE_SIZE, SOCKET_ID_ANY,
+					       NULL, split_test.mp) < 0 ||
+			rte_eth_tx_queue_setup(port, 0, SPLIT_TEST_QUEUE_SIZE, SOCKET_ID_ANY,
+					       NULL) < 0 ||
+			rte_eth_dev_start(port) < 0)
+		return -1;
+
+	return 0;
+}
+
+static int
+split_test_wait_link(void)
+{
+	struct rte_eth_link link;
+	unsigned int ms;
+
+	for (ms = 0; ms < SPLIT_TEST_LINK_WAIT_MS; ms += 10) {
+		if (rte_eth_link_get_nowait(split_test.vhost_port, &link) == 0 &&
+				link.link_status == RTE_ETH_LINK_UP)
+			return 0;
+		rte_delay_ms(10);
+	}
+
+	return -1;
+}
+
+static int
+vhost_split_ring_setup(void)
+{
+	char args[128];
+
+	snprintf(split_test.sock_path, sizeof(split_test.sock_path),
+		 "/tmp/vhost_split_test_%d.sock", getpid());
+
+	split_test.mp = rte_pktmbuf_pool_create("vhost_split_test", SPLIT_TEST_NB_MBUF, 0, 0,
+						RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(split_test.mp, "Failed to create mempool");
+	split_test.big_mp = rte_pktmbuf_pool_create("vhost_split_test_big",
+						    SPLIT_TEST_BURST * 2, 0, 0,
+						    SPLIT_TEST_BIG_LEN + RTE_PKTMBUF_HEADROOM,
+						    SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(split_test.big_mp, "Failed to create mempool");
+
+	snprintf(args, sizeof(args), "iface=%s,queues=1", split_test.sock_path);
+	TEST_ASSERT_SUCCESS(rte_vdev_init(SPLIT_TEST_VHOST, args), "Failed to create %s",
+			    SPLIT_TEST_VHOST);
+	TEST_ASSERT_SUCCESS(rte_eth_dev_get_port_by_name(SPLIT_TEST_VHOST,
+							 &split_test.vhost_port),
+			    "Failed to find %s", SPLIT_TEST_VHOST);
+	TEST_ASSERT_SUCCESS(split_test_port_start(split_test.vhost_port),
+			    "Failed to start %s", SPLIT_TEST_VHOST);
+
+	snprintf(args, sizeof(args),
+		 "path=%s,queues=1,queue_size=%u,packed_vq=0,in_order=1,mrg_rxbuf=1",
+		 split_test.sock_path, SPLIT_TEST_QUEUE_SIZE);
+	TEST_ASSERT_SUCCESS(rte_vdev_init(SPLIT_TEST_VIRTIO, args), "Failed to create %s",
+			    SPLIT_TEST_VIRTIO);
+	TEST_ASSERT_SUCCESS(rte_eth_dev_get_port_by_name(SPLIT_TEST_VIRTIO,
+							 &split_test.virtio_port),
+			    "Failed to find %s", SPLIT_TEST_VIRTIO);
+	TEST_ASSERT_SUCCESS(split_test_port_start(split_test.virtio_port),
+			    "Failed to start %s", SPLIT_TEST_VIRTIO);
+
+	TEST_ASSERT_SUCCESS(split_test_wait_link(), "vhost port did not come up");
+
+	return TEST_SUCCESS;
+}
+
+static void
+vhost_split_ring_teardown(void)
+{
+	rte_eth_dev_stop(split_test.virtio_port);
+	rte_eth_dev_stop(split_test.vhost_port);
+	rte_vdev_uninit(SPLIT_TEST_VIRTIO);
+	rte_vdev_uninit(SPLIT_TEST_VHOST);
+	unlink(split_test.sock_path);
+	rte_mempool_free(split_test.big_mp);
+	rte_mempool_free(split_test.mp);
+	memset(&split_test, 0, sizeof(split_test));
+}
+
+static struct unit_test_suite vhost_split_ring_testsuite = {
+	.suite_name = "vhost split ring test suite",
+	.setup = vhost_split_ring_setup,
+	.teardown = vhost_split_ring_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_split_enqueue),
+		TEST_CASE(test_split_enqueue_chained),
+		TEST_CASE(test_split_enqueue_big),
+		TEST_CASE(test_split_dequeue),
+		TEST_CASE(test_split_dequeue_chained),
+		TEST_CASE(test_split_dequeue_big),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_vhost_split_ring(void)
+{
+	return unit_test_suite_runner(&vhost_split_ring_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(vhost_split_ring_autotest, NOHUGE_OK, ASAN_OK, test_vhost_split_ring);
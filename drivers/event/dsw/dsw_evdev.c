@@ -3,10 +3,12 @@
  */
 
 #include <stdbool.h>
+#include <stdio.h>
 
 #include <rte_cycles.h>
 #include <eventdev_pmd.h>
 #include <eventdev_pmd_vdev.h>
+#include <rte_lcore.h>
 #include <rte_random.h>
 #include <rte_ring_elem.h>
 
@@ -66,6 +68,9 @@ dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 	port->in_ring = in_ring;
 	port->ctl_in_ring = ctl_in_ring;
 
+	rte_atomic_store_explicit(&port->lcore_id, LCORE_ID_ANY,
+				  rte_memory_order_relaxed);
+
 	port->load_update_interval =
 		(DSW_LOAD_UPDATE_INTERVAL * rte_get_timer_hz()) / US_PER_S;
 
@@ -232,6 +237,105 @@ dsw_info_get(struct rte_eventdev *dev __rte_unused,
 	};
 }
 
+#ifdef RTE_EXEC_ENV_LINUX
+static int
+dsw_read_sysfs_int(const char *path, int32_t *value)
+{
+	FILE *f;
+	int rc;
+
+	f = fopen(path, "r");
+	if (f == NULL)
+		return -1;
+
+	rc = fscanf(f, "%" SCNd32, value);
+
+	fclose(f);
+
+	return rc == 1 ? 0 : -1;
+}
+
+/* The id of the highest level cache found is used as the LLC id. */
+static int32_t
+dsw_cpu_llc_id(unsigned int cpu_id)
+{
+	char path[128];
+	int32_t llc_level = 0;
+	int32_t llc_id = -1;
+	unsigned int idx;
+
+	for (idx = 0;; idx++) {
+		int32_t level;
+		int32_t id;
+
+		snprintf(path, sizeof(path),
+			 "/sys/devices/system/cpu/cpu%u/cache/index%u/level",
+			 cpu_id, idx);
+		if (dsw_read_sysfs_int(path, &level) < 0)
+			break;
+
+		if (level < llc_level)
+			continue;
+
+		snprintf(path, sizeof(path),
+			 "/sys/devices/system/cpu/cpu%u/cache/index%u/id",
+			 cpu_id, idx);
+		if (dsw_read_sysfs_int(path, &id) < 0)
+			continue;
+
+		llc_level = level;
+		llc_id = id;
+	}
+
+	return llc_id;
+}
+
+/* An lcore whose CPUs don't all share the same LLC has no LLC id. */
+static int32_t
+dsw_lcore_llc_id(unsigned int lcore_id)
+{
+	rte_cpuset_t cpuset;
+	int32_t llc_id = -1;
+	unsigned int cpu_id;
+
+	if (rte_lcore_has_role(lcore_id, ROLE_OFF))
+		return -1;
+
+	cpuset = rte_lcore_cpuset(lcore_id);
+
+	for (cpu_id = 0; cpu_id < CPU_SETSIZE; cpu_id++) {
+		int32_t cpu_llc_id;
+
+		if (!CPU_ISSET(cpu_id, &cpuset))
+			continue;
+
+		cpu_llc_id = dsw_cpu_llc_id(cpu_id);
+
+		if (cpu_llc_id < 0 || (llc_id >= 0 && cpu_llc_id != llc_id))
+			return -1;
+
+		llc_id = cpu_llc_id;
+	}
+
+	return llc_id;
+}
+#else
+static int32_t
+dsw_lcore_llc_id(unsigned int lcore_id __rte_unused)
+{
+	return -1;
+}
+#endif
+
+static void
+dsw_init_lcore_llc_ids(struct dsw_evdev *dsw)
+{
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		dsw->lcore_llc_ids[lcore_id] = dsw_lcore_llc_id(lcore_id);
+}
+
 static int
 dsw_configure(const struct rte_eventdev *dev)
 {
@@ -249,6 +353,8 @@ dsw_configure(const struct rte_eventdev *dev)
 
 	dsw->max_inflight = RTE_MAX(conf->nb_events_limit, min_max_in_flight);
 
+	dsw_init_lcore_llc_ids(dsw);
+
 	return 0;
 }
 
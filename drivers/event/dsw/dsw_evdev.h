@@ -102,6 +102,23 @@
 
 #define DSW_MAX_FLOWS_PER_MIGRATION (8)
 
+/* Flows migrated to a port served by an lcore in another last level
+ * cache domain, or on another socket, lose their cached state. When
+ * selecting a migration target, each step of topology distance
+ * between the source and target ports' lcores is accounted for as
+ * this much extra target load, so that targets sharing the LLC with
+ * the source port are preferred, then targets on the same socket.
+ */
+#define DSW_TOPO_DISTANCE_PENALTY (DSW_LOAD_FROM_PERCENT(5))
+
+enum dsw_topo_distance {
+	DSW_TOPO_SAME_LLC,
+	/* Also used when the lcore or LLC of either port is unknown. */
+	DSW_TOPO_SAME_SOCKET,
+	DSW_TOPO_REMOTE,
+	DSW_TOPO_NUM_DISTANCES
+};
+
 /* Only one outstanding migration per port is allowed */
 #define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION)
 
@@ -177,6 +194,7 @@ struct __rte_cache_aligned dsw_port {
 	uint64_t emigration_start;
 	uint64_t emigrations;
 	uint64_t emigration_latency;
+	uint64_t distance_emigrations[DSW_TOPO_NUM_DISTANCES];
 
 	uint8_t emigration_target_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	struct dsw_queue_flow
@@ -232,6 +250,8 @@ struct __rte_cache_aligned dsw_port {
 
 	/* Estimate of current port load. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int16_t) load;
+	/* The lcore most recently using this port, or LCORE_ID_ANY. */
+	RTE_ATOMIC(uint32_t) lcore_id;
 	/* Estimate of flows currently migrating to this port. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) immigration_load;
 };
@@ -256,6 +276,9 @@ struct dsw_evdev {
 	uint8_t num_queues;
 	int32_t max_inflight;
 
+	/* Last level cache id of each lcore, or -1 if unknown. */
+	int32_t lcore_llc_ids[RTE_MAX_LCORE];
+
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) credits_on_loan;
 };
 
@@ -179,6 +179,17 @@ dsw_port_load_update(struct dsw_port *port, uint64_t now)
 				  rte_memory_order_relaxed);
 }
 
+static void
+dsw_port_lcore_update(struct dsw_port *port)
+{
+	uint32_t lcore_id = rte_lcore_id();
+
+	if (rte_atomic_load_explicit(&port->lcore_id,
+				     rte_memory_order_relaxed) != lcore_id)
+		rte_atomic_store_explicit(&port->lcore_id, lcore_id,
+					  rte_memory_order_relaxed);
+}
+
 static void
 dsw_port_consider_load_update(struct dsw_port *port, uint64_t now)
 {
@@ -188,6 +199,8 @@ dsw_port_consider_load_update(struct dsw_port *port, uint64_t now)
 	port->next_load_update = now + port->load_update_interval;
 
 	dsw_port_load_update(port, now);
+
+	dsw_port_lcore_update(port);
 }
 
 static void
@@ -453,6 +466,34 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 	return DSW_MAX_LOAD - res_target_load;
 }
 
+static enum dsw_topo_distance
+dsw_topo_distance(struct dsw_evdev *dsw, uint8_t port_id_a, uint8_t port_id_b)
+{
+	uint32_t lcore_id_a =
+		rte_atomic_load_explicit(&dsw->ports[port_id_a].lcore_id,
+					 rte_memory_order_relaxed);
+	uint32_t lcore_id_b =
+		rte_atomic_load_explicit(&dsw->ports[port_id_b].lcore_id,
+					 rte_memory_order_relaxed);
+	int32_t llc_id_a;
+	int32_t llc_id_b;
+
+	if (lcore_id_a >= RTE_MAX_LCORE || lcore_id_b >= RTE_MAX_LCORE)
+		return DSW_TOPO_SAME_SOCKET;
+
+	if (rte_lcore_to_socket_id(lcore_id_a) !=
+	    rte_lcore_to_socket_id(lcore_id_b))
+		return DSW_TOPO_REMOTE;
+
+	llc_id_a = dsw->lcore_llc_ids[lcore_id_a];
+	llc_id_b = dsw->lcore_llc_ids[lcore_id_b];
+
+	if (llc_id_a < 0 || llc_id_a != llc_id_b)
+		return DSW_TOPO_SAME_SOCKET;
+
+	return DSW_TOPO_SAME_LLC;
+}
+
 static bool
 dsw_is_serving_port(struct dsw_evdev *dsw, uint8_t port_id, uint8_t queue_id)
 {
@@ -466,7 +507,8 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 			     struct dsw_port *source_port,
 			     struct dsw_queue_flow_burst *bursts,
 			     uint16_t num_bursts,
-			     int16_t *port_loads, uint16_t num_ports,
+			     int16_t *port_loads,
+			     const int16_t *port_penalties, uint16_t num_ports,
 			     uint8_t *target_port_ids,
 			     struct dsw_queue_flow *target_qfs,
 			     uint8_t *targets_len)
@@ -506,6 +548,13 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 							port_loads[port_id],
 							flow_load);
 
+			/* Among the acceptable targets, prefer those
+			 * topologically close to the source port.
+			 */
+			if (weight >= 0)
+				weight = RTE_MAX(weight -
+						 port_penalties[port_id], 0);
+
 			if (weight > candidate_weight) {
 				candidate_qf = qf;
 				candidate_port_id = port_id;
@@ -549,14 +598,20 @@ dsw_select_emigration_targets(struct dsw_evdev *dsw,
 	struct dsw_queue_flow *target_qfs = source_port->emigration_target_qfs;
 	uint8_t *target_port_ids = source_port->emigration_target_port_ids;
 	uint8_t *targets_len = &source_port->emigration_targets_len;
+	int16_t port_penalties[dsw->num_ports];
 	uint16_t i;
 
+	for (i = 0; i < dsw->num_ports; i++)
+		port_penalties[i] = DSW_TOPO_DISTANCE_PENALTY *
+			dsw_topo_distance(dsw, source_port->id, i);
+
 	for (i = 0; i < DSW_MAX_FLOWS_PER_MIGRATION; i++) {
 		bool found;
 
 		found = dsw_select_emigration_target(dsw, source_port,
 						     bursts, num_bursts,
-						     port_loads, dsw->num_ports,
+						     port_loads, port_penalties,
+						     dsw->num_ports,
 						     target_port_ids,
 						     target_qfs,
 						     targets_len);
@@ -778,6 +833,9 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 		DSW_LOG_DP_PORT_LINE(DEBUG, port->id, "Migration completed for "
 				"queue_id %d flow_hash %d.", queue_id,
 				flow_hash);
+
+		port->distance_emigrations[dsw_topo_distance(dsw, port->id,
+				port->emigration_target_port_ids[i])]++;
 	}
 
 	finished = port->emigration_targets_len - left_qfs_len;
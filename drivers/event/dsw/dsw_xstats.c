@@ -87,6 +87,19 @@ dsw_xstats_port_get_queue_dequeued(struct dsw_evdev *dsw, uint8_t port_id,
 DSW_GEN_PORT_ACCESS_FN(emigrations)
 DSW_GEN_PORT_ACCESS_FN(immigrations)
 
+#define DSW_GEN_PORT_DISTANCE_ACCESS_FN(_name, _distance)		\
+	static uint64_t							\
+	dsw_xstats_port_get_ ## _name ## _emigrations(struct dsw_evdev *dsw, \
+						      uint8_t port_id,	\
+						      uint8_t queue_id __rte_unused) \
+	{								\
+		return dsw->ports[port_id].distance_emigrations[_distance]; \
+	}
+
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(same_llc, DSW_TOPO_SAME_LLC)
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(same_socket, DSW_TOPO_SAME_SOCKET)
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(remote, DSW_TOPO_REMOTE)
+
 static uint64_t
 dsw_xstats_port_get_migration_latency(struct dsw_evdev *dsw, uint8_t port_id,
 				      uint8_t queue_id __rte_unused)
@@ -148,6 +161,12 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	  true },
 	{ "port_%u_emigrations", dsw_xstats_port_get_emigrations,
 	  false },
+	{ "port_%u_same_llc_emigrations",
+	  dsw_xstats_port_get_same_llc_emigrations, false },
+	{ "port_%u_same_socket_emigrations",
+	  dsw_xstats_port_get_same_socket_emigrations, false },
+	{ "port_%u_remote_emigrations",
+	  dsw_xstats_port_get_remote_emigrations, false },
 	{ "port_%u_migration_latency", dsw_xstats_port_get_migration_latency,
 	  false },
 	{ "port_%u_immigrations", dsw_xstats_port_get_immigrations,
@@ -85,6 +85,52 @@ opdl_event_dequeue(void *port,
 	return p->deq(p, ev, 1);
 }
 
+/*
+ * Runtime link of a port back to the load balanced queue it was linked to
+ * when the device started. The port lcore takes its stage instance back on
+ * its next dequeue.
+ */
+static int
+opdl_port_relink(struct rte_eventdev *dev,
+		 struct opdl_port *p,
+		 uint8_t queue_id)
+{
+	struct opdl_queue *q = p->lb_queue;
+	uint8_t req = 1;
+
+	if (q == NULL || queue_id != p->external_qid) {
+		PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
+			     "Attempt to link queue (%u) to port %d while device started,"
+			     " only the queue linked at start can be linked again",
+			     dev->data->dev_id,
+			     queue_id,
+			     p->id);
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	if (p->linked)
+		return 1;
+
+	p->linked = true;
+	q->nb_linked++;
+
+	/* Cancel an unlink the port lcore has not picked up yet */
+	if (rte_atomic_compare_exchange_strong_explicit(&p->unlink_req, &req,
+			0, rte_memory_order_acq_rel,
+			rte_memory_order_relaxed)) {
+		rte_atomic_fetch_sub_explicit(&q->remap_pending, 1,
+				rte_memory_order_relaxed);
+		return 1;
+	}
+
+	rte_atomic_store_explicit(&p->link_req, 1, rte_memory_order_release);
+	rte_atomic_fetch_add_explicit(&q->remap_pending, 1,
+			rte_memory_order_release);
+
+	return 1;
+}
+
 static int
 opdl_port_link(struct rte_eventdev *dev,
 	       void *port,
@@ -98,13 +144,11 @@ opdl_port_link(struct rte_eventdev *dev,
 	RTE_SET_USED(dev);
 
 	if (unlikely(dev->data->dev_started)) {
-		PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
-			     "Attempt to link queue (%u) to port %d while device started",
-			     dev->data->dev_id,
-				queues[0],
-				p->id);
-		rte_errno = EINVAL;
-		return 0;
+		if (num > 1) {
+			rte_errno = EDQUOT;
+			return 0;
+		}
+		return opdl_port_relink(dev, p, queues[0]);
 	}
 
 	/* Max of 1 queue per port */
@@ -156,15 +200,56 @@ opdl_port_unlink(struct rte_eventdev *dev,
 	RTE_SET_USED(nb_unlinks);
 
 	if (unlikely(dev->data->dev_started)) {
-		PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
-			     "Attempt to unlink queue (%u) to port %d while device started",
-			     dev->data->dev_id,
-			     queues[0],
-			     p->id);
-		rte_errno = EINVAL;
-		return 0;
+		struct opdl_queue *q = p->lb_queue;
+
+		if (q == NULL || nb_unlinks != 1 ||
+				queues[0] != p->external_qid) {
+			PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
+				     "Attempt to unlink queue (%u) to port %d while device started,"
+				     " only load balanced queues can be unlinked",
+				     dev->data->dev_id,
+				     queues[0],
+				     p->id);
+			rte_errno = EINVAL;
+			return 0;
+		}
+
+		if (!p->linked)
+			return 1;
+
+		/* Someone has to serve the stage instances of the queue */
+		if (q->nb_linked == 1) {
+			PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
+				     "Attempt to unlink port %d, the last port linked to queue %u",
+				     dev->data->dev_id,
+				     p->id,
+				     queues[0]);
+			rte_errno = EINVAL;
+			return 0;
+		}
+
+		p->linked = false;
+		q->nb_linked--;
+
+		/* Cancel a link the port lcore has not picked up yet, it
+		 * is then left without any instance to release.
+		 */
+		if (rte_atomic_exchange_explicit(&p->link_req, 0,
+				rte_memory_order_seq_cst)) {
+			rte_atomic_fetch_and_explicit(&q->reclaim,
+					~RTE_BIT64(p->instance_id),
+					rte_memory_order_seq_cst);
+			rte_atomic_fetch_sub_explicit(&q->remap_pending, 1,
+					rte_memory_order_relaxed);
+		} else {
+			rte_atomic_store_explicit(&p->unlink_req, 1,
+					rte_memory_order_release);
+			rte_atomic_fetch_add_explicit(&q->remap_pending, 1,
+					rte_memory_order_release);
+		}
+
+		return 1;
 	}
-	RTE_SET_USED(nb_unlinks);
 
 	/* Port Stuff */
 	p->queue_id = OPDL_INVALID_QID;
@@ -175,6 +260,17 @@ opdl_port_unlink(struct rte_eventdev *dev,
 	return 0;
 }
 
+static int
+opdl_port_unlinks_in_progress(struct rte_eventdev *dev, void *port)
+{
+	struct opdl_port *p = port;
+
+	RTE_SET_USED(dev);
+
+	return rte_atomic_load_explicit(&p->unlink_req,
+			rte_memory_order_acquire);
+}
+
 static int
 opdl_port_setup(struct rte_eventdev *dev,
 		uint8_t port_id,
@@ -380,7 +476,8 @@ opdl_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info)
 				 RTE_EVENT_DEV_CAP_ATOMIC |
 				 RTE_EVENT_DEV_CAP_PARALLEL |
 				 RTE_EVENT_DEV_CAP_CARRY_FLOW_ID |
-				 RTE_EVENT_DEV_CAP_MAINTENANCE_FREE,
+				 RTE_EVENT_DEV_CAP_MAINTENANCE_FREE |
+				 RTE_EVENT_DEV_CAP_RUNTIME_PORT_LINK,
 		.max_profiles_per_port = 1,
 	};
 
@@ -469,9 +566,21 @@ static void
 opdl_stop(struct rte_eventdev *dev)
 {
 	struct opdl_evdev *device = opdl_pmd_priv(dev);
+	uint32_t i;
 
 	opdl_xstats_uninit(dev);
 
+	/* Ports unlinked at runtime stay unlinked on the next start */
+	for (i = 0; i < device->nb_ports; i++) {
+		struct opdl_port *p = &device->ports[i];
+
+		if (p->lb_queue != NULL && !p->linked) {
+			p->queue_id = OPDL_INVALID_QID;
+			p->external_qid = OPDL_INVALID_QID;
+		}
+		p->lb_queue = NULL;
+	}
+
 	destroy_queues_and_rings(dev);
 
 
@@ -631,6 +740,7 @@ opdl_probe(struct rte_vdev_device *vdev)
 		.port_release = opdl_port_release,
 		.port_link = opdl_port_link,
 		.port_unlink = opdl_port_unlink,
+		.port_unlinks_in_progress = opdl_port_unlinks_in_progress,
 
 
 		.xstats_get = opdl_xstats_get,
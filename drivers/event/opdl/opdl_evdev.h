@@ -161,6 +161,25 @@ struct opdl_port {
 	/* instance ID of this stage*/
 	uint32_t instance_id;
 
+	/* Load balanced queue served by this port, NULL if none */
+	struct opdl_queue *lb_queue;
+
+	/* Stage instances of lb_queue served by this port, bit per instance */
+	uint64_t owned;
+
+	/* Instance whose stage is currently in enq/deq_stage_inst */
+	uint32_t cur_instance;
+
+	/* Port lcore is serving its own stage instance */
+	bool serving;
+
+	/* Port is linked while the device is started, control path only */
+	bool linked;
+
+	/* Runtime unlink/link requests, completed by the port lcore */
+	RTE_ATOMIC(uint8_t) unlink_req;
+	RTE_ATOMIC(uint8_t) link_req;
+
 	/* track packets in and out of this port */
 	uint64_t port_stat[max_num_port_xstat];
 	uint64_t start_cycles;
@@ -203,6 +222,21 @@ struct opdl_queue {
 
 	/* priority, reserved for future */
 	uint8_t priority;
+
+	/* Stage instances of a load balanced queue, indexed by instance id */
+	struct opdl_stage *stages[OPDL_PORTS_MAX];
+
+	/* Ports currently linked to the queue, control path only */
+	uint32_t nb_linked;
+
+	/* Outstanding runtime link/unlink work, polled on dequeue */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint32_t) remap_pending;
+
+	/* Stage instances waiting to be served by a linked port */
+	RTE_ATOMIC(uint64_t) orphans;
+
+	/* Orphan instances reserved for their re-linked port */
+	RTE_ATOMIC(uint64_t) reclaim;
 };
 
 
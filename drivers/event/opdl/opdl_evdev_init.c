@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include <bus_vdev_driver.h>
+#include <rte_bitops.h>
 #include <rte_errno.h>
 #include <rte_cycles.h>
 #include <rte_memzone.h>
@@ -169,6 +170,159 @@ opdl_tx_error_dequeue(struct opdl_port *p,
 	return 0;
 }
 
+/*
+ * Runtime link/unlink:
+ *
+ * The number of stage instances of a load balanced queue is fixed at
+ * device start, so the flow to instance mapping never changes. Instead
+ * an unlinked port hands its stage instances over to the ports still
+ * linked to the queue, and takes its own instance back once linked
+ * again. Instances only change hands between a disclaim and the next
+ * claim, so each flow is processed by one port at a time and in order.
+ */
+
+static __rte_always_inline void
+opdl_port_serve(struct opdl_port *p, uint32_t instance)
+{
+	p->cur_instance = instance;
+	p->deq_stage_inst = p->lb_queue->stages[instance];
+	if (p->p_type == OPDL_REGULAR_PORT)
+		p->enq_stage_inst = p->deq_stage_inst;
+}
+
+static void
+opdl_port_resources_release(struct opdl_port *p, uint64_t mask)
+{
+	struct opdl_queue *q = p->lb_queue;
+
+	p->owned &= ~mask;
+	rte_atomic_fetch_add_explicit(&q->remap_pending, rte_popcount64(mask),
+			rte_memory_order_relaxed);
+	rte_atomic_fetch_or_explicit(&q->orphans, mask,
+			rte_memory_order_release);
+}
+
+static bool
+opdl_port_adopt(struct opdl_port *p, uint32_t instance)
+{
+	struct opdl_queue *q = p->lb_queue;
+	uint64_t bit = RTE_BIT64(instance);
+
+	if (!(rte_atomic_fetch_and_explicit(&q->orphans, ~bit,
+			rte_memory_order_acquire) & bit))
+		return false;
+
+	p->owned |= bit;
+	rte_atomic_fetch_sub_explicit(&q->remap_pending, 1,
+			rte_memory_order_relaxed);
+	return true;
+}
+
+static void
+opdl_port_remap(struct opdl_port *p)
+{
+	struct opdl_queue *q = p->lb_queue;
+	uint64_t own = RTE_BIT64(p->instance_id);
+	uint8_t req = 1;
+	uint64_t mask;
+
+	RTE_BUILD_BUG_ON(OPDL_PORTS_MAX > 64);
+
+	/* Never hand over a stage instance with slots still claimed */
+	if (p->owned && opdl_stage_get_num_claimed(p->deq_stage_inst) != 0)
+		return;
+
+	if (rte_atomic_compare_exchange_strong_explicit(&p->unlink_req, &req,
+			0, rte_memory_order_acquire,
+			rte_memory_order_relaxed)) {
+		p->serving = false;
+		opdl_port_resources_release(p, p->owned);
+		rte_atomic_fetch_sub_explicit(&q->remap_pending, 1,
+				rte_memory_order_relaxed);
+		return;
+	}
+
+	if (!p->serving && rte_atomic_load_explicit(&p->link_req,
+			rte_memory_order_acquire)) {
+		if (opdl_port_adopt(p, p->instance_id)) {
+			req = 1;
+			if (rte_atomic_compare_exchange_strong_explicit(
+					&p->link_req, &req, 0,
+					rte_memory_order_seq_cst,
+					rte_memory_order_seq_cst)) {
+				rte_atomic_fetch_and_explicit(&q->reclaim,
+						~own, rte_memory_order_seq_cst);
+				p->serving = true;
+				rte_atomic_fetch_sub_explicit(
+						&q->remap_pending, 1,
+						rte_memory_order_relaxed);
+			} else {
+				/* Link cancelled by an unlink meanwhile */
+				opdl_port_resources_release(p, own);
+			}
+		} else {
+			/* Ask the port serving it to hand it back, unless
+			 * the link got cancelled meanwhile.
+			 */
+			rte_atomic_fetch_or_explicit(&q->reclaim, own,
+					rte_memory_order_seq_cst);
+			if (!rte_atomic_load_explicit(&p->link_req,
+					rte_memory_order_seq_cst))
+				rte_atomic_fetch_and_explicit(&q->reclaim,
+						~own, rte_memory_order_seq_cst);
+		}
+	}
+
+	if (!p->serving)
+		return;
+
+	/* Hand back instances reclaimed by their re-linked port */
+	mask = rte_atomic_load_explicit(&q->reclaim,
+			rte_memory_order_acquire) & p->owned & ~own;
+	if (mask)
+		opdl_port_resources_release(p, mask);
+
+	/* Adopt one orphan per call to spread them over the linked ports */
+	mask = rte_atomic_load_explicit(&q->orphans,
+			rte_memory_order_acquire) &
+		~rte_atomic_load_explicit(&q->reclaim,
+			rte_memory_order_relaxed);
+	while (mask && !opdl_port_adopt(p, rte_ctz64(mask)))
+		mask &= mask - 1;
+
+	if (p->owned && !(p->owned & RTE_BIT64(p->cur_instance)))
+		opdl_port_serve(p, rte_ctz64(p->owned));
+}
+
+static __rte_always_inline void
+opdl_port_next_stage(struct opdl_port *p)
+{
+	uint64_t next = p->owned & ((~UINT64_C(0) << p->cur_instance) << 1);
+
+	opdl_port_serve(p, rte_ctz64(next ? next : p->owned));
+}
+
+/* Returns the number of stage instances the port has to poll */
+static __rte_always_inline uint32_t
+opdl_port_stages(struct opdl_port *p)
+{
+	if (unlikely(rte_atomic_load_explicit(&p->lb_queue->remap_pending,
+			rte_memory_order_relaxed)))
+		opdl_port_remap(p);
+
+	if (likely(p->owned == RTE_BIT64(p->instance_id)))
+		return 1;
+
+	if (p->owned == 0)
+		return 0;
+
+	/* Round robin over the served instances between claims */
+	if (opdl_stage_get_num_claimed(p->deq_stage_inst) == 0)
+		opdl_port_next_stage(p);
+
+	return rte_popcount64(p->owned);
+}
+
 /*
  * TX single threaded claim
  *
@@ -211,16 +365,26 @@ opdl_tx_dequeue_multi_inst(struct opdl_port *p,
 			uint16_t num)
 {
 	uint32_t num_events = 0;
-
-	num_events = opdl_stage_claim(p->deq_stage_inst,
-				    (void *)ev,
-				    num,
-				    NULL,
-				    false,
-				    false);
+	uint32_t nb_stages;
+
+	for (nb_stages = opdl_port_stages(p); nb_stages > 0; nb_stages--) {
+		num_events = opdl_stage_claim(p->deq_stage_inst,
+					    (void *)ev,
+					    num,
+					    NULL,
+					    false,
+					    p->atomic_claim);
+		if (num_events)
+			break;
+		if (nb_stages > 1)
+			opdl_port_next_stage(p);
+	}
 
 	update_on_dequeue(p, ev, num, num_events);
 
+	if (!num_events)
+		return 0;
+
 	return opdl_stage_disclaim(p->deq_stage_inst, num_events, false);
 }
 
@@ -234,6 +398,7 @@ static uint16_t
 opdl_claim(struct opdl_port *p, struct rte_event ev[], uint16_t num)
 {
 	uint32_t num_events = 0;
+	uint32_t nb_stages;
 
 	if (unlikely(num > MAX_OPDL_CONS_Q_DEPTH)) {
 		PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
@@ -245,13 +410,18 @@ opdl_claim(struct opdl_port *p, struct rte_event ev[], uint16_t num)
 	}
 
 
-	num_events = opdl_stage_claim(p->deq_stage_inst,
-			(void *)ev,
-			num,
-			NULL,
-			false,
-			p->atomic_claim);
-
+	for (nb_stages = opdl_port_stages(p); nb_stages > 0; nb_stages--) {
+		num_events = opdl_stage_claim(p->deq_stage_inst,
+				(void *)ev,
+				num,
+				NULL,
+				false,
+				p->atomic_claim);
+		if (num_events)
+			break;
+		if (nb_stages > 1)
+			opdl_port_next_stage(p);
+	}
 
 	update_on_dequeue(p, ev, num, num_events);
 
@@ -269,6 +439,12 @@ opdl_disclaim(struct opdl_port *p, const struct rte_event ev[], uint16_t num)
 
 	uint32_t i = 0;
 
+	/* Unlinked at runtime, the stage instance is served by another port */
+	if (unlikely(!p->owned)) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
 	for (i = 0; i < num; i++)
 		opdl_ring_cas_slot(p->enq_stage_inst, &ev[i],
 				i, p->atomic_claim);
@@ -708,10 +884,15 @@ initialise_all_other_ports(struct rte_eventdev *dev)
 		struct opdl_port *port = &device->ports[i];
 		struct opdl_queue *queue = &device->queue[port->queue_id];
 
+		port->lb_queue = NULL;
+		port->linked = false;
+
 		if (port->queue_id == 0) {
 			continue;
 		} else if (queue->q_type != OPDL_Q_TYPE_SINGLE_LINK) {
 
+			port->lb_queue = queue;
+
 			if (queue->q_pos == OPDL_Q_POS_MIDDLE) {
 
 				/* Regular port with claim/disclaim */
@@ -747,10 +928,17 @@ initialise_all_other_ports(struct rte_eventdev *dev)
 				port->enq_stage_inst = NULL;
 				port->p_type = OPDL_PURE_TX_PORT;
 
+				if (queue->q_type == OPDL_Q_TYPE_ATOMIC)
+					port->atomic_claim = true;
+				else
+					port->atomic_claim = false;
+
 				/* Add the port to the queue array of ports */
 				queue->ports[queue->nb_ports] = port;
 				port->instance_id = queue->nb_ports;
 				queue->nb_ports++;
+				opdl_stage_set_queue_id(stage_inst,
+						port->queue_id);
 			} else {
 
 				PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
@@ -852,6 +1040,23 @@ initialise_all_other_ports(struct rte_eventdev *dev)
 				port->num_instance = queue->nb_ports;
 				port->initialized = 1;
 				queue->initialized = 1;
+
+				if (port->lb_queue) {
+					queue->stages[port->instance_id] =
+						port->deq_stage_inst;
+					queue->nb_linked = queue->nb_ports;
+					port->owned =
+						RTE_BIT64(port->instance_id);
+					port->cur_instance = port->instance_id;
+					port->serving = true;
+					port->linked = true;
+					rte_atomic_store_explicit(
+						&port->unlink_req, 0,
+						rte_memory_order_relaxed);
+					rte_atomic_store_explicit(
+						&port->link_req, 0,
+						rte_memory_order_relaxed);
+				}
 			} else {
 				PMD_DRV_LOG(ERR, "DEV_ID:[%02d] : "
 					     "Port:[%u] not configured  invalid"
@@ -489,6 +489,16 @@ opdl_first_entry_id(uint32_t start_seq, uint8_t nb_p_lcores,
 			nb_p_lcores);
 }
 
+/* Map a flow to a stage instance. Multiplicative hashing spreads flow ids
+ * with a common stride (e.g. multiples of the number of instances) evenly,
+ * and the multiply-shift range reduction avoids a division.
+ */
+static __rte_always_inline uint32_t
+opdl_flow_instance(uint32_t flow_id, uint32_t nb_instance)
+{
+	return ((uint64_t)(flow_id * 0x9E3779B1u) * nb_instance) >> 32;
+}
+
 /* Claim slots to process, optimised for single-thread operation */
 static __rte_always_inline uint32_t
 opdl_stage_claim_singlethread(struct opdl_stage *s, void *entries,
@@ -534,7 +544,8 @@ opdl_stage_claim_singlethread(struct opdl_stage *s, void *entries,
 			if (opa_id >= s->queue_id)
 				continue;
 
-			if ((flow_id % s->nb_instance) == s->instance_id) {
+			if (opdl_flow_instance(flow_id, s->nb_instance) ==
+					s->instance_id) {
 				memcpy(entries_offset, ev, t->slot_size);
 				entries_offset += t->slot_size;
 				i++;
@@ -1017,7 +1028,8 @@ opdl_ring_cas_slot(struct opdl_stage *s, const struct rte_event *ev,
 			if (opa_id >= s->queue_id)
 				continue;
 
-			if ((flow_id % s->nb_instance) == s->instance_id) {
+			if (opdl_flow_instance(flow_id, s->nb_instance) ==
+					s->instance_id) {
 				ev_update = s->queue_id;
 				ev_update = (ev_update << OPDL_OPA_OFFSET)
 					| ev->event;
@@ -1188,6 +1200,12 @@ opdl_stage_set_queue_id(struct opdl_stage *s,
 	s->queue_id = queue_id;
 }
 
+uint32_t
+opdl_stage_get_num_claimed(const struct opdl_stage *s)
+{
+	return s->num_claimed;
+}
+
 void
 opdl_ring_dump(const struct opdl_ring *t, FILE *f)
 {
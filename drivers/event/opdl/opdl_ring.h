@@ -532,6 +532,18 @@ void
 opdl_stage_set_queue_id(struct opdl_stage *s,
 		uint32_t queue_id);
 
+/**
+ * Get the number of slots currently claimed by a single-thread stage.
+ *
+ * @param s
+ *   The pointer of  stage instance.
+ *
+ * @return
+ *   Number of slots claimed and not yet disclaimed.
+ */
+uint32_t
+opdl_stage_get_num_claimed(const struct opdl_stage *s);
+
 /**
  * Prints information on opdl_ring instance and all its stages
  *
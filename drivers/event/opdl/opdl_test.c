@@ -470,6 +470,180 @@ atomic_basic(struct test *t)
 
 	return 0;
 }
+static int
+enqueue_flow_pkts(struct test *t, uint8_t port, uint8_t qid,
+		uint32_t flow_id, int num)
+{
+	struct rte_event ev;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		ev = (struct rte_event){0};
+		ev.mbuf = rte_gen_arp(0, t->mbuf_pool);
+		if (!ev.mbuf) {
+			PMD_DRV_LOG(ERR, "%d: gen of pkt failed", __LINE__);
+			return -1;
+		}
+		ev.queue_id = qid;
+		ev.op = RTE_EVENT_OP_NEW;
+		ev.flow_id = flow_id;
+
+		if (rte_event_enqueue_burst(evdev, port, &ev, 1) != 1) {
+			PMD_DRV_LOG(ERR, "%d: Failed to enqueue pkt %d",
+					__LINE__, i);
+			rte_pktmbuf_free(ev.mbuf);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Dequeue from worker ports w_first..w_last and forward to qid, returns
+ * the number of events forwarded by port w_want, or -1 if any other port
+ * got events.
+ */
+static int
+forward_from_worker(struct test *t, uint8_t w_first, uint8_t w_last,
+		uint8_t w_want, uint8_t qid)
+{
+	struct rte_event deq_ev[MAX_OPDL_CONS_Q_DEPTH];
+	int got = 0;
+	uint16_t n;
+	int i, j;
+
+	for (i = w_first; i <= w_last; i++) {
+		n = rte_event_dequeue_burst(evdev, t->port[i], deq_ev,
+				RTE_DIM(deq_ev), 0);
+		if (n == 0)
+			continue;
+		if (i != w_want) {
+			PMD_DRV_LOG(ERR, "%d: port %d got %u events for a flow"
+					" served by port %u", __LINE__, i, n,
+					w_want);
+			return -1;
+		}
+		for (j = 0; j < n; j++) {
+			deq_ev[j].op = RTE_EVENT_OP_FORWARD;
+			deq_ev[j].queue_id = qid;
+		}
+		if (rte_event_enqueue_burst(evdev, t->port[i], deq_ev, n)
+				!= n) {
+			PMD_DRV_LOG(ERR, "%d: port %d failed to forward",
+					__LINE__, i);
+			return -1;
+		}
+		got += n;
+	}
+
+	return got;
+}
+
+static int
+atomic_runtime_link(struct test *t)
+{
+	const uint8_t rx_port = 0;
+	const uint8_t w1_port = 1;
+	const uint8_t w2_port = 2;
+	const uint8_t w3_port = 3;
+	const uint8_t tx_port = 4;
+	/* flow 1 maps to the second instance, i.e. w2_port */
+	const uint32_t flow_id = 1;
+	struct rte_event deq_ev[MAX_OPDL_CONS_Q_DEPTH];
+	uint32_t deq_pkts;
+	int i, err;
+
+	if (init(t, 2, tx_port+1) < 0 ||
+	    create_ports(t, tx_port+1) < 0 ||
+	    create_queues_type(t, 2, OPDL_Q_TYPE_ATOMIC)) {
+		PMD_DRV_LOG(ERR, "%d: Error initializing device", __LINE__);
+		return -1;
+	}
+
+	for (i = w1_port; i <= w3_port; i++) {
+		err = rte_event_port_link(evdev, t->port[i], &t->qid[0], NULL,
+				1);
+		if (err != 1) {
+			PMD_DRV_LOG(ERR, "%d: error mapping lb qid",
+					__LINE__);
+			cleanup(t);
+			return -1;
+		}
+	}
+
+	err = rte_event_port_link(evdev, t->port[tx_port], &t->qid[1], NULL,
+			1);
+	if (err != 1) {
+		PMD_DRV_LOG(ERR, "%d: error mapping TX  qid", __LINE__);
+		cleanup(t);
+		return -1;
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		PMD_DRV_LOG(ERR, "%d: Error with start call", __LINE__);
+		return -1;
+	}
+
+	/* Unlink the port serving the flow, it completes on its next poll */
+	if (rte_event_port_unlink(evdev, t->port[w2_port], &t->qid[0], 1)
+			!= 1) {
+		PMD_DRV_LOG(ERR, "%d: runtime unlink failed", __LINE__);
+		return -1;
+	}
+	if (rte_event_dequeue_burst(evdev, t->port[w2_port], deq_ev, 1, 0)
+			!= 0 ||
+			rte_event_port_unlinks_in_progress(evdev,
+				t->port[w2_port]) != 0) {
+		PMD_DRV_LOG(ERR, "%d: runtime unlink not completed", __LINE__);
+		return -1;
+	}
+
+	/* The flow moves as a whole to the port adopting the instance */
+	if (enqueue_flow_pkts(t, t->port[rx_port], t->qid[0], flow_id, 3) < 0)
+		return -1;
+	if (forward_from_worker(t, w1_port, w3_port, w1_port, t->qid[1])
+			!= 3) {
+		PMD_DRV_LOG(ERR, "%d: flow not adopted by port %u", __LINE__,
+				w1_port);
+		return -1;
+	}
+
+	/* Link it again, the instance is handed back between claims */
+	if (rte_event_port_link(evdev, t->port[w2_port], &t->qid[0], NULL, 1)
+			!= 1) {
+		PMD_DRV_LOG(ERR, "%d: runtime link failed", __LINE__);
+		return -1;
+	}
+	for (i = 0; i < 2; i++) {
+		rte_event_dequeue_burst(evdev, t->port[w2_port], deq_ev, 1, 0);
+		rte_event_dequeue_burst(evdev, t->port[w1_port], deq_ev, 1, 0);
+	}
+
+	if (enqueue_flow_pkts(t, t->port[rx_port], t->qid[0], flow_id, 3) < 0)
+		return -1;
+	if (forward_from_worker(t, w1_port, w3_port, w2_port, t->qid[1])
+			!= 3) {
+		PMD_DRV_LOG(ERR, "%d: flow not served by port %u again",
+				__LINE__, w2_port);
+		return -1;
+	}
+
+	deq_pkts = rte_event_dequeue_burst(evdev, t->port[tx_port], deq_ev,
+			RTE_DIM(deq_ev), 0);
+	if (deq_pkts != 6) {
+		PMD_DRV_LOG(ERR, "%d: expected 6 pkts at tx port got %d",
+			__LINE__, deq_pkts);
+		rte_event_dev_dump(evdev, stdout);
+		return -1;
+	}
+	for (i = 0; i < (int)deq_pkts; i++)
+		rte_pktmbuf_free(deq_ev[i].mbuf);
+
+	cleanup(t);
+
+	return 0;
+}
+
 static __rte_always_inline int
 check_qid_stats(uint64_t id[], int index)
 {
@@ -1033,6 +1207,9 @@ opdl_selftest(void)
 	ret = atomic_basic(t);
 
 
+	PMD_DRV_LOG(ERR, "*** Running Atomic runtime link test...");
+	ret = atomic_runtime_link(t);
+
 	PMD_DRV_LOG(ERR, "*** Running QID  Basic test...");
 	ret = qid_basic(t);
 
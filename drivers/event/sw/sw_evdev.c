@@ -24,6 +24,7 @@
 #define MIN_BURST_SIZE_ARG "min_burst"
 #define DEQ_BURST_SIZE_ARG "deq_burst"
 #define REFIL_ONCE_ARG "refill_once"
+#define SCHED_SHARDS_ARG "sched_shards"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
@@ -52,6 +53,16 @@ sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 			break;
 		}
 
+		/* shards are built from the links at start, a link between
+		 * two shards would let both touch the same history list
+		 */
+		if (sw->started && p->shard != q->shard) {
+			SW_LOG_ERR("Port %d and queue %d are scheduled by different shards",
+					p->id, queues[i]);
+			rte_errno = EINVAL;
+			break;
+		}
+
 		for (j = 0; j < q->cq_num_mapped_cqs; j++) {
 			if (q->cq_map[j] == p->id)
 				break;
@@ -359,7 +370,7 @@ sw_init_qid_iqs(struct sw_evdev *sw)
 			continue;
 
 		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			iq_init(&sw->shards[qid->shard], &qid->iq[j]);
 	}
 }
 
@@ -381,7 +392,7 @@ sw_qids_empty(struct sw_evdev *sw)
 static int
 sw_ports_empty(struct sw_evdev *sw)
 {
-	unsigned int i;
+	unsigned int i, j;
 
 	for (i = 0; i < sw->port_count; i++) {
 		if ((rte_event_ring_count(sw->ports[i].rx_worker_ring)) ||
@@ -389,6 +400,15 @@ sw_ports_empty(struct sw_evdev *sw)
 			return 0;
 	}
 
+	/* events handed over between shards */
+	for (i = 0; i < sw->nb_shards; i++) {
+		for (j = 0; j < sw->nb_shards; j++) {
+			if (sw->shards[i].fwd_ring[j] != NULL &&
+			    rte_event_ring_count(sw->shards[i].fwd_ring[j]))
+				return 0;
+		}
+	}
+
 	return 1;
 }
 
@@ -419,9 +439,9 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_shard *sh,
+		struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -433,7 +453,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(sh, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -447,8 +467,11 @@ sw_drain_queues(struct rte_eventdev *dev)
 	unsigned int i, j;
 
 	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *qid = &sw->qids[i];
+
 		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+			sw_drain_queue(dev, &sw->shards[qid->shard],
+					&qid->iq[j]);
 	}
 }
 
@@ -465,7 +488,8 @@ sw_clean_qid_iqs(struct rte_eventdev *dev)
 		for (j = 0; j < SW_IQS_MAX; j++) {
 			if (!qid->iq[j].head)
 				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
+			iq_free_chunk_list(&sw->shards[qid->shard],
+					qid->iq[j].head);
 			qid->iq[j].head = NULL;
 		}
 	}
@@ -507,20 +531,23 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
-	int num_chunks, i;
+	int num_chunks;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
 	sw->nb_events_limit = conf->nb_events_limit;
 	rte_atomic32_set(&sw->inflights, 0);
 
-	/* Number of chunks sized for worst-case spread of events across IQs */
-	num_chunks = ((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
+	/* Number of chunks sized for worst-case spread of events across IQs,
+	 * as all inflight events may end up in the QIDs of a single shard.
+	 */
+	num_chunks = sw->nb_shards *
+			((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
 			sw->qid_count*SW_IQS_MAX*2;
 
 	/* If this is a reconfiguration, free the previous IQ allocation. All
 	 * IQ chunk references were cleaned out of the QIDs in sw_stop(), and
-	 * will be reinitialized in sw_start().
+	 * chunks are handed out to the shards in sw_start().
 	 */
 	rte_free(sw->chunks);
 
@@ -532,10 +559,6 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	if (!sw->chunks)
 		return -ENOMEM;
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
-
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
 
@@ -623,16 +646,43 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	static const char * const q_type_strings[] = {
 			"Ordered", "Atomic", "Parallel", "Directed"
 	};
+	struct sw_point_stats stats = {0};
+	uint64_t sched_called = 0, sched_cq_qid_called = 0;
+	uint64_t sched_no_iq_enqueues = 0, sched_no_cq_enqueues = 0;
 	uint32_t i;
 	fprintf(f, "EventDev %s: ports %d, qids %d\n",
 		dev->data->name, sw->port_count, sw->qid_count);
 
+	for (i = 0; i < sw->nb_shards; i++) {
+		const struct sw_shard *sh = &sw->shards[i];
+
+		stats.rx_pkts += sh->stats.rx_pkts;
+		stats.rx_dropped += sh->stats.rx_dropped;
+		stats.tx_pkts += sh->stats.tx_pkts;
+		sched_called += sh->sched_called;
+		sched_cq_qid_called += sh->sched_cq_qid_called;
+		sched_no_iq_enqueues += sh->sched_no_iq_enqueues;
+		sched_no_cq_enqueues += sh->sched_no_cq_enqueues;
+	}
+
 	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+		stats.rx_pkts, stats.rx_dropped, stats.tx_pkts);
+	fprintf(f, "\tsched calls: %"PRIu64"\n", sched_called);
+	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sched_cq_qid_called);
+	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sched_no_iq_enqueues);
+	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sched_no_cq_enqueues);
+	if (sw->nb_shards > 1) {
+		for (i = 0; i < sw->nb_shards; i++) {
+			const struct sw_shard *sh = &sw->shards[i];
+
+			fprintf(f, "\tshard %u: ports %u, qids %u, rx %"PRIu64
+				", tx %"PRIu64", fwd %"PRIu64", calls %"PRIu64
+				", idle %"PRIu64"\n", i, sh->port_count,
+				sh->qid_count, sh->stats.rx_pkts,
+				sh->stats.tx_pkts, sh->sched_fwd_pkts,
+				sh->sched_called, sh->sched_idle);
+		}
+	}
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
@@ -762,19 +812,174 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	}
 }
 
+static uint32_t
+sw_shard_root(uint16_t *parent, uint32_t idx)
+{
+	while (parent[idx] != idx) {
+		parent[idx] = parent[parent[idx]];
+		idx = parent[idx];
+	}
+	return idx;
+}
+
+/* Split ports and QIDs between the scheduler shards. A port and the QIDs it
+ * is linked to are scheduled by the same shard, so each group of linked ports
+ * and QIDs goes to the least loaded shard, largest group first.
+ */
+static void
+sw_shards_assign(struct sw_evdev *sw)
+{
+	/* ports first, QIDs after them */
+	uint16_t parent[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint16_t weight[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	int16_t owner[SW_PORTS_MAX + RTE_EVENT_MAX_QUEUES_PER_DEV];
+	uint32_t load[SW_SHARDS_MAX] = {0};
+	unsigned int i, j;
+
+	for (i = 0; i < RTE_DIM(parent); i++) {
+		parent[i] = i;
+		weight[i] = 0;
+		owner[i] = -1;
+	}
+
+	for (i = 0; i < sw->qid_count; i++) {
+		const struct sw_qid *qid = &sw->qids[i];
+
+		for (j = 0; j < qid->cq_num_mapped_cqs; j++)
+			parent[sw_shard_root(parent, SW_PORTS_MAX + i)] =
+				sw_shard_root(parent, qid->cq_map[j]);
+	}
+
+	for (i = 0; i < sw->port_count; i++)
+		weight[sw_shard_root(parent, i)]++;
+	for (i = 0; i < sw->qid_count; i++)
+		weight[sw_shard_root(parent, SW_PORTS_MAX + i)]++;
+
+	for (;;) {
+		uint32_t group = 0, shard = 0;
+		uint16_t max = 0;
+
+		for (i = 0; i < RTE_DIM(weight); i++) {
+			if (owner[i] < 0 && weight[i] > max) {
+				max = weight[i];
+				group = i;
+			}
+		}
+		if (max == 0)
+			break;
+
+		for (j = 1; j < sw->nb_shards; j++)
+			if (load[j] < load[shard])
+				shard = j;
+
+		owner[group] = shard;
+		load[shard] += max;
+	}
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		sw->shards[i].port_count = 0;
+		sw->shards[i].qid_count = 0;
+	}
+
+	for (i = 0; i < sw->port_count; i++) {
+		struct sw_shard *sh =
+			&sw->shards[owner[sw_shard_root(parent, i)]];
+
+		sw->ports[i].shard = sh->id;
+		sh->port_ids[sh->port_count++] = i;
+	}
+
+	for (i = 0; i < sw->qid_count; i++)
+		sw->qids[i].shard =
+			owner[sw_shard_root(parent, SW_PORTS_MAX + i)];
+
+	for (i = 0; i < sw->nb_shards; i++)
+		if (sw->shards[i].port_count == 0)
+			SW_LOG_INFO("Shard %u has no port, more shards than groups of linked ports and queues",
+					i);
+}
+
+static void
+sw_shards_init_chunks(struct sw_evdev *sw)
+{
+	unsigned int i, j, idx = 0;
+
+	/* Hand out the chunks allocated at configure time */
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+		unsigned int num_chunks =
+			((SW_INFLIGHT_EVENTS_TOTAL/SW_EVS_PER_Q_CHUNK)+1) +
+			sh->qid_count*SW_IQS_MAX*2;
+
+		sh->chunk_list_head = NULL;
+		for (j = 0; j < num_chunks; j++)
+			iq_free_chunk(sh, &sw->chunks[idx++]);
+	}
+}
+
+static int
+sw_shards_init_rings(struct rte_eventdev *dev)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	char buf[RTE_RING_NAMESIZE];
+	unsigned int i, j;
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		for (j = 0; j < sw->nb_shards; j++) {
+			if (i == j || sh->fwd_ring[j] != NULL)
+				continue;
+
+			/* sized for all inflight events, never full */
+			snprintf(buf, sizeof(buf), "sw%d_s%u_s%u_fwd_ring",
+					dev->data->dev_id, i, j);
+			sh->fwd_ring[j] = rte_event_ring_create(buf,
+					SW_INFLIGHT_EVENTS_TOTAL,
+					dev->data->socket_id,
+					RING_F_SP_ENQ | RING_F_SC_DEQ |
+					RING_F_EXACT_SZ);
+			if (sh->fwd_ring[j] == NULL) {
+				SW_LOG_ERR("Error creating ring from shard %u to shard %u",
+						i, j);
+				return -ENOMEM;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void
+sw_shards_free_rings(struct sw_evdev *sw)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		for (j = 0; j < sw->nb_shards; j++) {
+			rte_event_ring_free(sw->shards[i].fwd_ring[j]);
+			sw->shards[i].fwd_ring[j] = NULL;
+		}
+	}
+}
+
 static int
 sw_start(struct rte_eventdev *dev)
 {
 	unsigned int i, j;
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 
-	rte_service_component_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->nb_shards; i++) {
+		uint32_t service_id = sw->shards[i].service_id;
+
+		rte_service_component_runstate_set(service_id, 1);
 
-	/* check a service core is mapped to this service */
-	if (!rte_service_runstate_get(sw->service_id)) {
-		SW_LOG_ERR("Warning: No Service core enabled on service %s",
-				sw->service_name);
-		return -ENOENT;
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(service_id)) {
+			SW_LOG_ERR("Warning: No Service core enabled on service %s",
+					rte_service_get_name(service_id));
+			return -ENOENT;
+		}
 	}
 
 	/* check all ports are set up */
@@ -792,22 +997,32 @@ sw_start(struct rte_eventdev *dev)
 			return -ENOLINK;
 		}
 
-	/* build up our prioritized array of qids */
+	sw_shards_assign(sw);
+
+	/* build up the prioritized array of qids of each shard */
 	/* We don't use qsort here, as if all/multiple entries have the same
 	 * priority, the result is non-deterministic. From "man 3 qsort":
 	 * "If two members compare as equal, their order in the sorted
 	 * array is undefined."
 	 */
-	uint32_t qidx = 0;
 	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
 		for (i = 0; i < sw->qid_count; i++) {
 			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
+				struct sw_shard *sh =
+					&sw->shards[sw->qids[i].shard];
+
+				sh->qids_prioritized[sh->qid_count++] =
+					&sw->qids[i];
 			}
 		}
 	}
 
+	if (sw_shards_init_rings(dev) < 0) {
+		sw_shards_free_rings(sw);
+		return -ENOMEM;
+	}
+
+	sw_shards_init_chunks(sw);
 	sw_init_qid_iqs(sw);
 
 	if (sw_xstats_init(sw) < 0)
@@ -823,15 +1038,21 @@ static void
 sw_stop(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int32_t runstate;
+	int32_t runstate[SW_SHARDS_MAX];
+	unsigned int i;
 
 	/* Stop the scheduler if it's running */
-	runstate = rte_service_runstate_get(sw->service_id);
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 0);
+	for (i = 0; i < sw->nb_shards; i++) {
+		uint32_t service_id = sw->shards[i].service_id;
 
-	while (rte_service_may_be_active(sw->service_id))
-		rte_pause();
+		runstate[i] = rte_service_runstate_get(service_id);
+		if (runstate[i] == 1)
+			rte_service_runstate_set(service_id, 0);
+	}
+
+	for (i = 0; i < sw->nb_shards; i++)
+		while (rte_service_may_be_active(sw->shards[i].service_id))
+			rte_pause();
 
 	/* Flush all events out of the device */
 	while (!(sw_qids_empty(sw) && sw_ports_empty(sw))) {
@@ -845,8 +1066,9 @@ sw_stop(struct rte_eventdev *dev)
 	sw->started = 0;
 	rte_smp_wmb();
 
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->nb_shards; i++)
+		if (runstate[i] == 1)
+			rte_service_runstate_set(sw->shards[i].service_id, 1);
 }
 
 static int
@@ -863,11 +1085,18 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		memset(&sh->stats, 0, sizeof(sh->stats));
+		sh->sched_called = 0;
+		sh->sched_idle = 0;
+		sh->sched_fwd_pkts = 0;
+		sh->sched_no_iq_enqueues = 0;
+		sh->sched_no_cq_enqueues = 0;
+		sh->sched_cq_qid_called = 0;
+	}
+	sw_shards_free_rings(sw);
 
 	return 0;
 }
@@ -932,10 +1161,20 @@ set_refill_once(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
+static int
+set_sched_shards(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *nb_shards = opaque;
+	*nb_shards = atoi(value);
+	if (*nb_shards < 1 || *nb_shards > SW_SHARDS_MAX)
+		return -1;
+	return 0;
+}
+
 static int32_t sw_sched_service_func(void *args)
 {
-	struct rte_eventdev *dev = args;
-	return sw_event_schedule(dev);
+	struct sw_shard *sh = args;
+	return sw_shard_schedule(sh);
 }
 
 static int
@@ -980,6 +1219,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		MIN_BURST_SIZE_ARG,
 		DEQ_BURST_SIZE_ARG,
 		REFIL_ONCE_ARG,
+		SCHED_SHARDS_ARG,
 		NULL
 	};
 	const char *name;
@@ -992,6 +1232,8 @@ sw_probe(struct rte_vdev_device *vdev)
 	int min_burst_size = 1;
 	int deq_burst_size = SCHED_DEQUEUE_DEFAULT_BURST_SIZE;
 	int refill_once = 0;
+	int nb_shards = 1;
+	int i;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1063,6 +1305,16 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_SHARDS_ARG,
+					set_sched_shards, &nb_shards);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing sched shards parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
@@ -1070,9 +1322,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	SW_LOG_INFO(
 			"Creating eventdev sw device %s, numa_node=%d, "
 			"sched_quanta=%d, credit_quanta=%d "
-			"min_burst=%d, deq_burst=%d, refill_once=%d",
+			"min_burst=%d, deq_burst=%d, refill_once=%d, "
+			"sched_shards=%d",
 			name, socket_id, sched_quanta, credit_quanta,
-			min_burst_size, deq_burst_size, refill_once);
+			min_burst_size, deq_burst_size, refill_once,
+			nb_shards);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id, vdev);
@@ -1098,22 +1352,42 @@ sw_probe(struct rte_vdev_device *vdev)
 	sw->sched_min_burst_size = min_burst_size;
 	sw->sched_deq_burst_size = deq_burst_size;
 	sw->refill_once_per_iter = refill_once;
+	sw->nb_shards = nb_shards;
 
-	/* register service with EAL */
-	struct rte_service_spec service;
-	memset(&service, 0, sizeof(struct rte_service_spec));
-	snprintf(service.name, sizeof(service.name), "%s_service", name);
+	/* register one service per shard with EAL, the first one keeps the
+	 * name of the single scheduler service
+	 */
+	for (i = 0; i < nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+		struct rte_service_spec service;
+
+		sh->sw = sw;
+		sh->id = i;
+
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		if (i == 0)
+			snprintf(service.name, sizeof(service.name),
+					"%s_service", name);
+		else
+			snprintf(service.name, sizeof(service.name),
+					"%s_service_shard%d", name, i);
+		service.socket_id = socket_id;
+		service.callback = sw_sched_service_func;
+		service.callback_userdata = sh;
+
+		int32_t ret = rte_service_component_register(&service,
+				&sh->service_id);
+		if (ret) {
+			SW_LOG_ERR("service register() failed");
+			while (i-- > 0)
+				rte_service_component_unregister(
+						sw->shards[i].service_id);
+			return -ENOEXEC;
+		}
+	}
 	snprintf(sw->service_name, sizeof(sw->service_name), "%s_service",
 			name);
-	service.socket_id = socket_id;
-	service.callback = sw_sched_service_func;
-	service.callback_userdata = (void *)dev;
-
-	int32_t ret = rte_service_component_register(&service, &sw->service_id);
-	if (ret) {
-		SW_LOG_ERR("service register() failed");
-		return -ENOEXEC;
-	}
+	sw->service_id = sw->shards[0].service_id;
 
 	dev->data->service_inited = 1;
 	dev->data->service_id = sw->service_id;
@@ -1146,5 +1420,5 @@ RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
 		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>"
 		MIN_BURST_SIZE_ARG "=<int>" DEQ_BURST_SIZE_ARG "=<int>"
-		REFIL_ONCE_ARG "=<int>");
+		REFIL_ONCE_ARG "=<int>" SCHED_SHARDS_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(eventdev_sw_log_level, NOTICE);
@@ -21,6 +21,9 @@
 /* allow for lots of over-provisioning */
 #define MAX_SW_PROD_Q_DEPTH 4096
 #define SW_FRAGMENTS_MAX 16
+#define SW_SHARDS_MAX 8
+/* events buffered per destination before handing them to another shard */
+#define SW_SHARD_FWD_BURST 32
 
 /* Should be power-of-two minus one, to leave room for the next pointer */
 #define SW_EVS_PER_Q_CHUNK 255
@@ -133,6 +136,8 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+	/* scheduler shard owning this QID, set at start */
+	uint8_t shard;
 };
 
 struct sw_hist_list_entry {
@@ -207,6 +212,51 @@ struct sw_port {
 	struct rte_event cq_buf[MAX_SW_CONS_Q_DEPTH];
 
 	uint8_t num_qids_mapped;
+	/* scheduler shard pulling from this port, set at start */
+	uint8_t shard;
+};
+
+/* A scheduler shard owns the ports and QIDs of one or more groups of linked
+ * ports and QIDs, so that history lists, flow pinning and reorder buffers are
+ * only ever touched by one service. Events enqueued to a QID of another shard
+ * are handed over through a single producer single consumer ring.
+ */
+struct sw_shard {
+	struct sw_evdev *sw;
+	uint8_t id;
+
+	/* Ports pulled by this shard */
+	uint32_t port_count;
+	uint8_t port_ids[SW_PORTS_MAX];
+
+	/* QIDs owned by this shard, sorted by priority level */
+	uint32_t qid_count;
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+
+	/* IQ chunks available to the QIDs of this shard */
+	struct sw_queue_chunk *chunk_list_head;
+
+	/* Current values */
+	uint32_t sched_flush_count;
+	uint32_t sched_min_burst;
+
+	/* Rings to the other shards, indexed by destination shard */
+	struct rte_event_ring *fwd_ring[SW_SHARDS_MAX];
+	uint16_t fwd_buf_count[SW_SHARDS_MAX];
+	struct rte_event fwd_buf[SW_SHARDS_MAX][SW_SHARD_FWD_BURST];
+
+	/* Stats */
+	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
+	uint64_t sched_called;
+	uint64_t sched_idle;
+	uint64_t sched_fwd_pkts;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+	uint64_t sched_last_iter_bitmask;
+	uint8_t sched_progress_last_iter;
+
+	uint32_t service_id;
 };
 
 struct sw_evdev {
@@ -226,9 +276,6 @@ struct sw_evdev {
 	uint32_t sched_deq_burst_size;
 	/* Refill pp buffers only once per scheduler call*/
 	uint32_t refill_once_per_iter;
-	/* Current values */
-	uint32_t sched_flush_count;
-	uint32_t sched_min_burst;
 
 	/* Contains all ports - load balanced and directed */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_port ports[SW_PORTS_MAX];
@@ -243,24 +290,16 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV];
-	struct sw_queue_chunk *chunk_list_head;
 	struct sw_queue_chunk *chunks;
 
 	/* Cache how many packets are in each cq */
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Scheduler shards, each run by its own service */
+	uint32_t nb_shards;
+	struct sw_shard shards[SW_SHARDS_MAX];
 
-	/* Stats */
-	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-	uint64_t sched_last_iter_bitmask;
-	uint8_t sched_progress_last_iter;
 
 	uint8_t started;
 	uint32_t credit_update_quanta;
@@ -294,6 +333,7 @@ uint16_t sw_event_enqueue_burst(void *port, const struct rte_event ev[],
 uint16_t sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 			uint64_t wait);
 int32_t sw_event_schedule(struct rte_eventdev *dev);
+int32_t sw_shard_schedule(struct sw_shard *sh);
 int sw_xstats_init(struct sw_evdev *dev);
 int sw_xstats_uninit(struct sw_evdev *dev);
 int sw_xstats_get_names(const struct rte_eventdev *dev,
@@ -20,6 +20,7 @@
 #include <rte_ethdev.h>
 #include <rte_cycles.h>
 #include <rte_eventdev.h>
+#include <rte_event_ring.h>
 #include <rte_pause.h>
 #include <rte_service.h>
 #include <rte_service_component.h>
@@ -3303,6 +3304,407 @@ worker_loopback(struct test *t, uint8_t disable_implicit_release)
 	return 0;
 }
 
+#define SHARDS_DEV_NAME "event_sw_shards"
+#define SHARDS_NB_EVENTS (4 * SW_SHARD_FWD_BURST)
+#define SHARDS_SCHED_ROUNDS 256
+
+static struct sw_evdev *
+shards_priv(void)
+{
+	return sw_pmd_priv(rte_event_pmd_get_named_dev(SHARDS_DEV_NAME));
+}
+
+/* run every shard once, as separate service cores would */
+static void
+shards_schedule(void)
+{
+	struct sw_evdev *sw = shards_priv();
+	uint32_t i;
+
+	for (i = 0; i < sw->nb_shards; i++)
+		rte_service_run_iter_on_app_lcore(sw->shards[i].service_id, 1);
+}
+
+/* Ordered QID scheduled by another shard than the producer and the
+ * consumer: the reordered events are handed over to the consumer shard.
+ *
+ *            (shard 0)
+ * rx_port    w1_port
+ * (shard 1) /        \       (shard 1)
+ *      qid0 - w2_port - qid1 - tx_port
+ *           \        /
+ *            w3_port
+ */
+static int
+shards_ordered(struct test *t)
+{
+	const uint8_t rx_port = 0;
+	const uint8_t w1_port = 1;
+	const uint8_t w3_port = 3;
+	const uint8_t tx_port = 4;
+	const uint32_t MAGIC_SEQN = 1234;
+	struct rte_event deq_ev[w3_port + 1];
+	struct sw_evdev *sw = shards_priv();
+	uint32_t deq_pkts = 0, j;
+	int i, round;
+
+	if (init(t, 2, tx_port + 1) < 0 ||
+			create_ports(t, tx_port + 1) < 0 ||
+			create_ordered_qids(t, 1) < 0 ||
+			create_directed_qids(t, 1, &tx_port)) {
+		printf("%d: Error initializing device\n", __LINE__);
+		return -1;
+	}
+
+	for (i = w1_port; i <= w3_port; i++) {
+		if (rte_event_port_link(evdev, t->port[i], &t->qid[0], NULL,
+				1) != 1) {
+			printf("%d: error mapping lb qid\n", __LINE__);
+			goto err;
+		}
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto err;
+	}
+
+	if (sw->qids[t->qid[0]].shard == sw->qids[t->qid[1]].shard ||
+			sw->ports[rx_port].shard == sw->qids[t->qid[0]].shard) {
+		printf("%d: Expected qid0 in its own shard\n", __LINE__);
+		goto err;
+	}
+
+	for (i = 0; i < 3; i++) {
+		struct rte_event ev = {
+			.queue_id = t->qid[0],
+			.op = RTE_EVENT_OP_NEW,
+		};
+
+		ev.mbuf = rte_gen_arp(0, t->mbuf_pool);
+		if (!ev.mbuf) {
+			printf("%d: gen of pkt failed\n", __LINE__);
+			goto err;
+		}
+		*rte_event_pmd_selftest_seqn(ev.mbuf) = MAGIC_SEQN + i;
+		if (rte_event_enqueue_burst(evdev, t->port[rx_port], &ev,
+				1) != 1) {
+			printf("%d: Failed to enqueue pkt %u\n", __LINE__, i);
+			goto err;
+		}
+	}
+
+	/* one event to each worker, takes two rounds to cross the shards */
+	for (i = w1_port; i <= w3_port; i++) {
+		for (round = 0; round < SHARDS_SCHED_ROUNDS; round++) {
+			shards_schedule();
+			if (rte_event_dequeue_burst(evdev, t->port[i],
+					&deq_ev[i], 1, 0) == 1)
+				break;
+		}
+		if (round == SHARDS_SCHED_ROUNDS) {
+			printf("%d: Failed to deq on port %d\n", __LINE__, i);
+			goto err;
+		}
+	}
+
+	/* Enqueue each packet in reverse order */
+	for (i = w3_port; i >= w1_port; i--) {
+		deq_ev[i].op = RTE_EVENT_OP_FORWARD;
+		deq_ev[i].queue_id = t->qid[1];
+		if (rte_event_enqueue_burst(evdev, t->port[i], &deq_ev[i],
+				1) != 1) {
+			printf("%d: Failed to enqueue\n", __LINE__);
+			goto err;
+		}
+	}
+
+	for (round = 0; round < SHARDS_SCHED_ROUNDS && deq_pkts < 3; round++) {
+		shards_schedule();
+		deq_pkts += rte_event_dequeue_burst(evdev, t->port[tx_port],
+				&deq_ev[deq_pkts], 3 - deq_pkts, 0);
+	}
+	if (deq_pkts != 3) {
+		printf("%d: expected 3 pkts at tx port got %d\n",
+				__LINE__, deq_pkts);
+		goto err;
+	}
+
+	for (j = 0; j < deq_pkts; j++) {
+		uint32_t seqn = *rte_event_pmd_selftest_seqn(deq_ev[j].mbuf);
+
+		rte_pktmbuf_free(deq_ev[j].mbuf);
+		if (seqn != MAGIC_SEQN + j) {
+			printf("%d: Incorrect sequence number(%d) from port %d\n",
+					__LINE__, seqn, tx_port);
+			goto err;
+		}
+	}
+
+	cleanup(t);
+	return 0;
+err:
+	rte_event_dev_dump(evdev, stdout);
+	cleanup(t);
+	return -1;
+}
+
+/* Atomic QID scheduled by another shard than the producer and the
+ * consumer. Two flows must each stay on one worker while inflight and keep
+ * their order once handed over to the consumer shard. With fill_ring the
+ * ring between the producer and the atomic QID shards starts full: the
+ * producer port is back-pressured until the ring drains, without losing
+ * any event.
+ */
+static int
+shards_atomic(struct test *t, int fill_ring)
+{
+	const uint8_t rx_port = 0;
+	const uint8_t w1_port = 1;
+	const uint8_t w2_port = 2;
+	const uint8_t tx_port = 3;
+	static struct rte_event deq_ev[SHARDS_NB_EVENTS];
+	static uint8_t deq_port[SHARDS_NB_EVENTS];
+	struct rte_event_ring *ring = NULL;
+	struct sw_evdev *sw = shards_priv();
+	struct test_event_dev_stats stats;
+	uint32_t next_seqn[2] = {0, 1};
+	int flow_port[2] = {-1, -1};
+	uint32_t nb_deq = 0, filled = 0;
+	uint32_t i, n;
+	int round;
+
+	if (init(t, 2, tx_port + 1) < 0 ||
+			create_ports(t, tx_port + 1) < 0 ||
+			create_atomic_qids(t, 1) < 0 ||
+			create_directed_qids(t, 1, &tx_port)) {
+		printf("%d: Error initializing device\n", __LINE__);
+		return -1;
+	}
+
+	if (rte_event_port_link(evdev, t->port[w1_port], &t->qid[0], NULL,
+			1) != 1 ||
+			rte_event_port_link(evdev, t->port[w2_port], &t->qid[0],
+				NULL, 1) != 1) {
+		printf("%d: error mapping lb qid\n", __LINE__);
+		goto err;
+	}
+
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto err;
+	}
+
+	if (sw->qids[t->qid[0]].shard == sw->qids[t->qid[1]].shard ||
+			sw->ports[rx_port].shard == sw->qids[t->qid[0]].shard) {
+		printf("%d: Expected qid0 in its own shard\n", __LINE__);
+		goto err;
+	}
+
+	if (fill_ring) {
+		struct rte_event dummy = {
+			.queue_id = t->qid[0],
+			.op = RTE_EVENT_OP_NEW,
+		};
+
+		ring = sw->shards[sw->ports[rx_port].shard]
+				.fwd_ring[sw->qids[t->qid[0]].shard];
+		while (rte_event_ring_enqueue_burst(ring, &dummy, 1, NULL) == 1)
+			filled++;
+	}
+
+	for (i = 0; i < SHARDS_NB_EVENTS; i++) {
+		struct rte_event ev = {
+			.queue_id = t->qid[0],
+			.op = RTE_EVENT_OP_NEW,
+			.sched_type = RTE_SCHED_TYPE_ATOMIC,
+			.flow_id = i & 1,
+		};
+
+		ev.mbuf = rte_gen_arp(0, t->mbuf_pool);
+		if (!ev.mbuf) {
+			printf("%d: gen of pkt failed\n", __LINE__);
+			goto err;
+		}
+		*rte_event_pmd_selftest_seqn(ev.mbuf) = i;
+		if (rte_event_enqueue_burst(evdev, t->port[rx_port], &ev,
+				1) != 1) {
+			rte_pktmbuf_free(ev.mbuf);
+			printf("%d: Failed to enqueue pkt %u\n", __LINE__, i);
+			goto err;
+		}
+	}
+
+	if (fill_ring) {
+		struct rte_event dummy[SW_SHARD_FWD_BURST];
+		uint32_t shard = sw->ports[rx_port].shard;
+
+		/* only the producer shard runs, nothing drains the ring */
+		for (round = 0; round < 4; round++)
+			rte_service_run_iter_on_app_lcore(
+					sw->shards[shard].service_id, 1);
+
+		test_event_dev_stats_get(evdev, &stats);
+		if (stats.rx_dropped != 0 ||
+				stats.port_rx_pkts[rx_port] >= SHARDS_NB_EVENTS ||
+				rte_event_ring_count(ring) != filled) {
+			printf("%d: Expected the rx port to be back-pressured\n",
+					__LINE__);
+			goto err;
+		}
+
+		while (filled) {
+			n = rte_event_ring_dequeue_burst(ring, dummy,
+					RTE_DIM(dummy), NULL);
+			if (n == 0) {
+				printf("%d: Failed to drain ring\n", __LINE__);
+				goto err;
+			}
+			filled -= n;
+		}
+	}
+
+	/* hold every event, both flows stay pinned to their worker */
+	for (round = 0; round < SHARDS_SCHED_ROUNDS &&
+			nb_deq < SHARDS_NB_EVENTS; round++) {
+		uint8_t p;
+
+		shards_schedule();
+		for (p = w1_port; p <= w2_port; p++) {
+			n = rte_event_dequeue_burst(evdev, t->port[p],
+					&deq_ev[nb_deq],
+					SHARDS_NB_EVENTS - nb_deq, 0);
+			for (i = nb_deq; i < nb_deq + n; i++) {
+				uint32_t flow = deq_ev[i].flow_id;
+
+				if (flow_port[flow] < 0)
+					flow_port[flow] = p;
+				if (flow_port[flow] != p) {
+					printf("%d: flow %u on ports %d and %u\n",
+						__LINE__, flow,
+						flow_port[flow], p);
+					goto err;
+				}
+				deq_port[i] = p;
+			}
+			nb_deq += n;
+		}
+	}
+	if (nb_deq != SHARDS_NB_EVENTS) {
+		printf("%d: expected %u pkts at workers got %u\n", __LINE__,
+				SHARDS_NB_EVENTS, nb_deq);
+		goto err;
+	}
+
+	for (i = 0; i < nb_deq; i++) {
+		deq_ev[i].op = RTE_EVENT_OP_FORWARD;
+		deq_ev[i].queue_id = t->qid[1];
+		if (rte_event_enqueue_burst(evdev, t->port[deq_port[i]],
+				&deq_ev[i], 1) != 1) {
+			printf("%d: Failed to enqueue\n", __LINE__);
+			goto err;
+		}
+	}
+
+	nb_deq = 0;
+	for (round = 0; round < SHARDS_SCHED_ROUNDS &&
+			nb_deq < SHARDS_NB_EVENTS; round++) {
+		shards_schedule();
+		n = rte_event_dequeue_burst(evdev, t->port[tx_port], deq_ev,
+				RTE_DIM(deq_ev), 0);
+		for (i = 0; i < n; i++) {
+			uint32_t flow = deq_ev[i].flow_id;
+			uint32_t seqn =
+				*rte_event_pmd_selftest_seqn(deq_ev[i].mbuf);
+
+			rte_pktmbuf_free(deq_ev[i].mbuf);
+			if (seqn != next_seqn[flow]) {
+				printf("%d: flow %u seqn %u, expected %u\n",
+					__LINE__, flow, seqn, next_seqn[flow]);
+				goto err;
+			}
+			next_seqn[flow] += 2;
+		}
+		nb_deq += n;
+	}
+	if (nb_deq != SHARDS_NB_EVENTS) {
+		printf("%d: expected %u pkts at tx port got %u\n", __LINE__,
+				SHARDS_NB_EVENTS, nb_deq);
+		goto err;
+	}
+
+	test_event_dev_stats_get(evdev, &stats);
+	if (stats.rx_dropped != 0) {
+		printf("%d: %"PRIu64" events dropped\n", __LINE__,
+				stats.rx_dropped);
+		goto err;
+	}
+
+	cleanup(t);
+	return 0;
+err:
+	if (ring != NULL) {
+		struct rte_event dummy;
+
+		while (filled && rte_event_ring_dequeue_burst(ring, &dummy, 1,
+				NULL) == 1)
+			filled--;
+	}
+	rte_event_dev_dump(evdev, stdout);
+	cleanup(t);
+	return -1;
+}
+
+/* Scheduling split between the services of a sched_shards=2 instance */
+static int
+shards_tests(struct test *t)
+{
+	const int main_evdev = evdev;
+	struct sw_evdev *sw;
+	uint32_t i;
+	int ret = -1;
+
+	evdev = rte_event_dev_get_dev_id(SHARDS_DEV_NAME);
+	if (evdev < 0) {
+		if (rte_vdev_init(SHARDS_DEV_NAME, "sched_shards=2") < 0) {
+			printf("Error creating sharded eventdev\n");
+			goto out;
+		}
+		evdev = rte_event_dev_get_dev_id(SHARDS_DEV_NAME);
+		if (evdev < 0) {
+			printf("Error finding sharded eventdev\n");
+			goto out;
+		}
+	}
+
+	sw = shards_priv();
+	for (i = 0; i < sw->nb_shards; i++) {
+		rte_service_runstate_set(sw->shards[i].service_id, 1);
+		rte_service_set_runstate_mapped_check(
+				sw->shards[i].service_id, 0);
+	}
+
+	printf("*** Running Sharded Ordered test...\n");
+	if (shards_ordered(t) != 0) {
+		printf("ERROR - Sharded Ordered test FAILED.\n");
+		goto out;
+	}
+	printf("*** Running Sharded Atomic test...\n");
+	if (shards_atomic(t, 0) != 0) {
+		printf("ERROR - Sharded Atomic test FAILED.\n");
+		goto out;
+	}
+	printf("*** Running Sharded Ring Full test...\n");
+	if (shards_atomic(t, 1) != 0) {
+		printf("ERROR - Sharded Ring Full test FAILED.\n");
+		goto out;
+	}
+	ret = 0;
+out:
+	evdev = main_evdev;
+	return ret;
+}
+
 static struct rte_mempool *eventdev_func_mempool;
 
 int
@@ -3521,6 +3923,9 @@ test_sw_eventdev(void)
 		printf("ERROR - Ordered & Atomic hist-list test FAILED.\n");
 		goto test_fail;
 	}
+	ret = shards_tests(t);
+	if (ret != 0)
+		goto test_fail;
 	if (rte_lcore_count() >= 3) {
 		printf("*** Running Worker loopback test...\n");
 		ret = worker_loopback(t, 0);
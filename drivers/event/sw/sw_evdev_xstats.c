@@ -19,6 +19,11 @@ enum xstats_type {
 	no_cq_enq,
 	sched_last_iter_bitmask,
 	sched_progress_last_iter,
+	/* shard specific */
+	idle,
+	fwd,
+	shard_ports,
+	shard_qids,
 	/* port_specific */
 	rx_used,
 	rx_free,
@@ -49,23 +54,50 @@ struct sw_xstats_entry {
 };
 
 static uint64_t
-get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+get_shard_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
 {
+	const struct sw_shard *sh = &sw->shards[obj_idx];
+
 	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
-	case sched_last_iter_bitmask: return sw->sched_last_iter_bitmask;
-	case sched_progress_last_iter: return sw->sched_progress_last_iter;
+	case rx: return sh->stats.rx_pkts;
+	case tx: return sh->stats.tx_pkts;
+	case dropped: return sh->stats.rx_dropped;
+	case calls: return sh->sched_called;
+	case idle: return sh->sched_idle;
+	case fwd: return sh->sched_fwd_pkts;
+	case no_iq_enq: return sh->sched_no_iq_enqueues;
+	case no_cq_enq: return sh->sched_no_cq_enqueues;
+	case sched_last_iter_bitmask: return sh->sched_last_iter_bitmask;
+	case sched_progress_last_iter: return sh->sched_progress_last_iter;
+	case shard_ports: return sh->port_count;
+	case shard_qids: return sh->qid_count;
 
 	default: return -1;
 	}
 }
 
+static uint64_t
+get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+		enum xstats_type type, int extra_arg)
+{
+	uint64_t val = 0;
+	unsigned int i;
+
+	/* device stats cover all shards */
+	for (i = 0; i < sw->nb_shards; i++) {
+		uint64_t shard_val = get_shard_stat(sw, i, type, extra_arg);
+
+		if (type == sched_last_iter_bitmask ||
+				type == sched_progress_last_iter)
+			val |= shard_val;
+		else
+			val += shard_val;
+	}
+
+	return val;
+}
+
 static uint64_t
 get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
@@ -169,6 +201,7 @@ sw_xstats_init(struct sw_evdev *sw)
 	 * xstats array
 	 * There are multiple set of stats:
 	 *   - device-level,
+	 *   - per-shard, when the scheduler is sharded
 	 *   - per-port,
 	 *   - per-port-dequeue-burst-sizes
 	 *   - per-qid,
@@ -190,6 +223,16 @@ sw_xstats_init(struct sw_evdev *sw)
 	};
 	/* all device stats are allowed to be reset */
 
+	static const char * const shard_stats[] = { "rx", "tx", "drop",
+			"calls", "idle_calls", "fwd", "ports", "qids",
+	};
+	static const enum xstats_type shard_types[] = { rx, tx, dropped,
+			calls, idle, fwd, shard_ports, shard_qids,
+	};
+	static const uint8_t shard_reset_allowed[] = {1, 1, 1,
+			1, 1, 1, 0, 0,
+	};
+
 	static const char * const port_stats[] = {"rx", "tx", "drop",
 			"inflight", "avg_pkt_cycles", "credits",
 			"rx_ring_used", "rx_ring_free",
@@ -238,6 +281,7 @@ sw_xstats_init(struct sw_evdev *sw)
 	 * joined by the compiler.
 	 */
 	RTE_BUILD_BUG_ON(RTE_DIM(dev_stats) != RTE_DIM(dev_types));
+	RTE_BUILD_BUG_ON(RTE_DIM(shard_stats) != RTE_DIM(shard_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(port_stats) != RTE_DIM(port_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_stats) != RTE_DIM(qid_types));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_iq_stats) != RTE_DIM(qid_iq_types));
@@ -246,12 +290,16 @@ sw_xstats_init(struct sw_evdev *sw)
 			RTE_DIM(port_bucket_types));
 
 	RTE_BUILD_BUG_ON(RTE_DIM(port_stats) != RTE_DIM(port_reset_allowed));
+	RTE_BUILD_BUG_ON(RTE_DIM(shard_stats) != RTE_DIM(shard_reset_allowed));
 	RTE_BUILD_BUG_ON(RTE_DIM(qid_stats) != RTE_DIM(qid_reset_allowed));
 
 	/* other vars */
 	const uint32_t cons_bkt_shift =
 		(MAX_SW_CONS_Q_DEPTH >> SW_DEQ_STAT_BUCKET_SHIFT);
+	/* per shard stats only make sense with several shards */
+	const unsigned int nb_shards = sw->nb_shards > 1 ? sw->nb_shards : 0;
 	const unsigned int count = RTE_DIM(dev_stats) +
+			nb_shards * RTE_DIM(shard_stats) +
 			sw->port_count * RTE_DIM(port_stats) +
 			sw->port_count * RTE_DIM(port_bucket_stats) *
 				(cons_bkt_shift + 1) +
@@ -259,7 +307,7 @@ sw_xstats_init(struct sw_evdev *sw)
 			sw->qid_count * SW_IQS_MAX * RTE_DIM(qid_iq_stats) +
 			sw->qid_count * sw->port_count *
 				RTE_DIM(qid_port_stats);
-	unsigned int i, port, qid, iq, bkt, stat = 0;
+	unsigned int i, shard, port, qid, iq, bkt, stat = 0;
 
 	sw->xstats = rte_zmalloc_socket(NULL, sizeof(sw->xstats[0]) * count, 0,
 			sw->data->socket_id);
@@ -276,6 +324,19 @@ sw_xstats_init(struct sw_evdev *sw)
 		};
 		snprintf(sname, sizeof(sname), "dev_%s", dev_stats[i]);
 	}
+	for (shard = 0; shard < nb_shards; shard++) {
+		for (i = 0; i < RTE_DIM(shard_stats); i++, stat++) {
+			sw->xstats[stat] = (struct sw_xstats_entry){
+				.fn = get_shard_stat,
+				.obj_idx = shard,
+				.stat = shard_types[i],
+				.mode = RTE_EVENT_DEV_XSTATS_DEVICE,
+				.reset_allowed = shard_reset_allowed[i],
+			};
+			snprintf(sname, sizeof(sname), "dev_shard_%u_%s",
+					shard, shard_stats[i]);
+		}
+	}
 	sw->xstats_count_mode_dev = stat;
 
 	for (port = 0; port < sw->port_count; port++) {
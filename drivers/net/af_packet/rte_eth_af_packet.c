@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <linux/if_ether.h>
 #include <linux/if_packet.h>
+#include <linux/virtio_net.h>
 #include <arpa/inet.h>
 #include <net/if.h>
 #include <net/if_arp.h>
@@ -37,6 +38,9 @@
 #define ETH_AF_PACKET_FRAMECOUNT_ARG	"framecnt"
 #define ETH_AF_PACKET_QDISC_BYPASS_ARG	"qdisc_bypass"
 #define ETH_AF_PACKET_FANOUT_MODE_ARG	"fanout_mode"
+#define ETH_AF_PACKET_TPACKET_V3_ARG	"tpacket_v3"
+#define ETH_AF_PACKET_BLOCK_TMO_ARG	"block_tmo"
+#define ETH_AF_PACKET_VNET_HDR_ARG	"vnet_hdr"
 
 #define DFLT_FRAME_SIZE		(1 << 11)
 #define DFLT_FRAME_COUNT	(1 << 9)
@@ -52,10 +56,15 @@ struct __rte_cache_aligned pkt_rx_queue {
 	unsigned int framecount;
 	unsigned int framenum;
 
+	/* TPACKET_V3: rd[] holds blocks and framenum is the current block */
+	struct tpacket3_hdr *blk_ppd;
+	uint32_t blk_pkts_left;
+
 	struct rte_mempool *mb_pool;
 	uint16_t in_port;
 	uint8_t vlan_strip;
 	uint8_t timestamp_offloading;
+	uint8_t vnet_hdr;
 
 	volatile unsigned long rx_pkts;
 	volatile unsigned long rx_bytes;
@@ -66,6 +75,7 @@ struct __rte_cache_aligned pkt_rx_queue {
 struct __rte_cache_aligned pkt_tx_queue {
 	int sockfd;
 	unsigned int frame_data_size;
+	uint8_t vnet_hdr;
 
 	struct iovec *rd;
 	uint8_t *map;
@@ -85,6 +95,8 @@ struct pmd_internals {
 	struct rte_ether_addr eth_addr;
 
 	struct tpacket_req req;
+	uint8_t tpacket_v3;
+	uint8_t vnet_hdr;
 
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
@@ -100,6 +112,9 @@ static const char *valid_arguments[] = {
 	ETH_AF_PACKET_FRAMECOUNT_ARG,
 	ETH_AF_PACKET_QDISC_BYPASS_ARG,
 	ETH_AF_PACKET_FANOUT_MODE_ARG,
+	ETH_AF_PACKET_TPACKET_V3_ARG,
+	ETH_AF_PACKET_BLOCK_TMO_ARG,
+	ETH_AF_PACKET_VNET_HDR_ARG,
 	NULL
 };
 
@@ -120,6 +135,89 @@ RTE_LOG_REGISTER_DEFAULT(af_packet_logtype, NOTICE);
 	RTE_LOG_LINE(level, AFPACKET, "%s(): " fmt ":%s", __func__, \
 		## __VA_ARGS__, strerror(errno))
 
+/*
+ * Translate the vnet header the kernel put in front of a received frame
+ * into mbuf offload flags.
+ */
+static inline void
+vnet_hdr_to_mbuf(const uint8_t *pbuf, struct rte_mbuf *mbuf)
+{
+	const struct virtio_net_hdr *hdr =
+		(const struct virtio_net_hdr *)(pbuf - sizeof(*hdr));
+
+	if (hdr->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM)
+		/* locally generated, only the pseudo header sum is present */
+		mbuf->ol_flags |= RTE_MBUF_F_RX_L4_CKSUM_NONE;
+	else if (hdr->flags & VIRTIO_NET_HDR_F_DATA_VALID)
+		mbuf->ol_flags |= RTE_MBUF_F_RX_L4_CKSUM_GOOD;
+
+	if (hdr->gso_type != VIRTIO_NET_HDR_GSO_NONE) {
+		/* coalesced by the kernel */
+		mbuf->ol_flags |= RTE_MBUF_F_RX_LRO;
+		mbuf->tso_segsz = hdr->gso_size;
+	}
+}
+
+/*
+ * Describe the L4 checksum and TCP segmentation offloads of a packet to
+ * the kernel. vlan_len accounts for a VLAN tag inserted in software.
+ */
+static inline void
+mbuf_to_vnet_hdr(const struct rte_mbuf *mbuf, unsigned int vlan_len,
+		 struct virtio_net_hdr *hdr)
+{
+	uint64_t l4_ol_flags = mbuf->ol_flags & RTE_MBUF_F_TX_L4_MASK;
+	uint16_t l4_off = vlan_len + mbuf->l2_len + mbuf->l3_len;
+
+	memset(hdr, 0, sizeof(*hdr));
+
+	if (mbuf->ol_flags & RTE_MBUF_F_TX_TCP_SEG) {
+		/* TCP segmentation implies TCP checksum offload */
+		l4_ol_flags = RTE_MBUF_F_TX_TCP_CKSUM;
+		hdr->gso_type = (mbuf->ol_flags & RTE_MBUF_F_TX_IPV6) ?
+			VIRTIO_NET_HDR_GSO_TCPV6 : VIRTIO_NET_HDR_GSO_TCPV4;
+		hdr->gso_size = mbuf->tso_segsz;
+		hdr->hdr_len = l4_off + mbuf->l4_len;
+	}
+
+	if (l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM) {
+		hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+		hdr->csum_start = l4_off;
+		hdr->csum_offset = offsetof(struct rte_tcp_hdr, cksum);
+	} else if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
+		hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+		hdr->csum_start = l4_off;
+		hdr->csum_offset = offsetof(struct rte_udp_hdr, dgram_cksum);
+	}
+}
+
+/*
+ * DPDK leaves the L4 length out of the pseudo header checksum of a TSO
+ * packet while the kernel expects it to be included, add it to the copy
+ * of the packet in the frame.
+ */
+static inline void
+vnet_hdr_tso_fix_cksum(const struct rte_mbuf *mbuf, unsigned int vlan_len,
+		       uint8_t *frame)
+{
+	uint16_t l4_off = vlan_len + mbuf->l2_len + mbuf->l3_len;
+	struct rte_tcp_hdr *th;
+	uint32_t l4_len;
+	uint32_t tmp;
+
+	if (mbuf->pkt_len < l4_off + sizeof(*th))
+		return;
+
+	th = (struct rte_tcp_hdr *)(frame + l4_off);
+	/* the IP length fields may not hold the whole TSO payload */
+	l4_len = rte_cpu_to_be_32(mbuf->pkt_len - l4_off);
+	tmp = th->cksum;
+	tmp += (l4_len & 0xffff) + (l4_len >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+	th->cksum = tmp;
+}
+
 static uint16_t
 eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -159,6 +257,9 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		pbuf = (uint8_t *) ppd + ppd->tp_mac;
 		memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf, rte_pktmbuf_data_len(mbuf));
 
+		if (pkt_q->vnet_hdr)
+			vnet_hdr_to_mbuf(pbuf, mbuf);
+
 		/* check for vlan info */
 		if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
 			mbuf->vlan_tci = ppd->tp_vlan_tci;
@@ -195,6 +296,125 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
+/*
+ * Hand a fully consumed TPACKET_V3 block back to the kernel and return
+ * the index of the next block.
+ */
+static inline unsigned int
+rx_v3_block_release(struct pkt_rx_queue *pkt_q, struct tpacket_block_desc *pbd,
+		    unsigned int blocknum)
+{
+	/* all reads from the block must be done before the kernel refills it */
+	rte_smp_mb();
+	pbd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+	if (++blocknum >= pkt_q->framecount)
+		blocknum = 0;
+	return blocknum;
+}
+
+/*
+ * With TPACKET_V3 the kernel hands over whole blocks of variable-size
+ * frames. A block is only returned once all of its frames have been
+ * consumed, which may take several bursts.
+ */
+static uint16_t
+eth_af_packet_rx_v3(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct tpacket_block_desc *pbd;
+	struct tpacket3_hdr *ppd;
+	struct rte_mbuf *mbuf;
+	uint8_t *pbuf;
+	struct pkt_rx_queue *pkt_q = queue;
+	uint16_t num_rx = 0;
+	unsigned long num_rx_bytes = 0;
+	unsigned int blocknum;
+	uint32_t pkts_left;
+
+	if (unlikely(nb_pkts == 0))
+		return 0;
+
+	blocknum = pkt_q->framenum;
+	pkts_left = pkt_q->blk_pkts_left;
+	ppd = pkt_q->blk_ppd;
+	pbd = (struct tpacket_block_desc *) pkt_q->rd[blocknum].iov_base;
+	while (num_rx < nb_pkts) {
+		if (pkts_left == 0) {
+			/* take over the next block once the kernel retired it */
+			if ((pbd->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+				break;
+			rte_smp_rmb();
+
+			pkts_left = pbd->hdr.bh1.num_pkts;
+			ppd = (struct tpacket3_hdr *)((uint8_t *) pbd +
+				pbd->hdr.bh1.offset_to_first_pkt);
+			if (unlikely(pkts_left == 0)) {
+				blocknum = rx_v3_block_release(pkt_q, pbd, blocknum);
+				pbd = (struct tpacket_block_desc *)
+					pkt_q->rd[blocknum].iov_base;
+				continue;
+			}
+		}
+
+		/* allocate the next mbuf */
+		mbuf = rte_pktmbuf_alloc(pkt_q->mb_pool);
+		if (unlikely(mbuf == NULL)) {
+			pkt_q->rx_nombuf++;
+			break;
+		}
+
+		/* frames in a block are not bounded by the frame size */
+		if (unlikely(ppd->tp_snaplen > rte_pktmbuf_tailroom(mbuf))) {
+			rte_pktmbuf_free(mbuf);
+			pkt_q->rx_dropped_pkts++;
+			goto next;
+		}
+
+		rte_pktmbuf_pkt_len(mbuf) = rte_pktmbuf_data_len(mbuf) = ppd->tp_snaplen;
+		pbuf = (uint8_t *) ppd + ppd->tp_mac;
+		memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf, rte_pktmbuf_data_len(mbuf));
+
+		if (pkt_q->vnet_hdr)
+			vnet_hdr_to_mbuf(pbuf, mbuf);
+
+		/* check for vlan info */
+		if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
+			mbuf->vlan_tci = ppd->hv1.tp_vlan_tci;
+			mbuf->ol_flags |= (RTE_MBUF_F_RX_VLAN | RTE_MBUF_F_RX_VLAN_STRIPPED);
+
+			if (!pkt_q->vlan_strip && rte_vlan_insert(&mbuf))
+				PMD_LOG(ERR, "Failed to reinsert VLAN tag");
+		}
+
+		/* add kernel provided timestamp when offloading is enabled */
+		if (pkt_q->timestamp_offloading) {
+			*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
+				rte_mbuf_timestamp_t *) =
+					(uint64_t)ppd->tp_sec * 1000000000 + ppd->tp_nsec;
+
+			mbuf->ol_flags |= timestamp_dynflag;
+		}
+
+		mbuf->port = pkt_q->in_port;
+
+		/* account for the receive frame */
+		bufs[num_rx++] = mbuf;
+		num_rx_bytes += mbuf->pkt_len;
+
+next:
+		ppd = (struct tpacket3_hdr *)((uint8_t *) ppd + ppd->tp_next_offset);
+		if (--pkts_left == 0) {
+			blocknum = rx_v3_block_release(pkt_q, pbd, blocknum);
+			pbd = (struct tpacket_block_desc *) pkt_q->rd[blocknum].iov_base;
+		}
+	}
+	pkt_q->framenum = blocknum;
+	pkt_q->blk_pkts_left = pkts_left;
+	pkt_q->blk_ppd = ppd;
+	pkt_q->rx_pkts += num_rx;
+	pkt_q->rx_bytes += num_rx_bytes;
+	return num_rx;
+}
+
 /*
  * Check if there is an available frame in the ring
  */
@@ -225,6 +445,7 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	struct rte_mbuf *mbuf;
 	uint8_t *pbuf;
 	unsigned int framecount, framenum;
+	unsigned int vlan_len, hdr_len;
 	struct pollfd pfd;
 	struct pkt_tx_queue *pkt_q = queue;
 	uint16_t num_tx = 0;
@@ -252,11 +473,13 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		}
 
 		/* insert vlan info if necessary */
+		vlan_len = 0;
 		if (mbuf->ol_flags & RTE_MBUF_F_TX_VLAN) {
 			if (rte_vlan_insert(&mbuf)) {
 				rte_pktmbuf_free(mbuf);
 				continue;
 			}
+			vlan_len = sizeof(struct rte_vlan_hdr);
 		}
 
 		/* point at the next incoming frame */
@@ -290,7 +513,17 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		pbuf = (uint8_t *) ppd + TPACKET2_HDRLEN -
 			sizeof(struct sockaddr_ll);
 
+		/* the vnet header is the start of the frame data */
+		hdr_len = 0;
+		if (pkt_q->vnet_hdr) {
+			mbuf_to_vnet_hdr(mbuf, vlan_len,
+					 (struct virtio_net_hdr *)pbuf);
+			hdr_len = sizeof(struct virtio_net_hdr);
+			pbuf += hdr_len;
+		}
+
 		struct rte_mbuf *tmp_mbuf = mbuf;
+		uint8_t *frame = pbuf;
 		while (tmp_mbuf) {
 			uint16_t data_len = rte_pktmbuf_data_len(tmp_mbuf);
 			memcpy(pbuf, rte_pktmbuf_mtod(tmp_mbuf, void*), data_len);
@@ -298,8 +531,11 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			tmp_mbuf = tmp_mbuf->next;
 		}
 
-		ppd->tp_len = mbuf->pkt_len;
-		ppd->tp_snaplen = mbuf->pkt_len;
+		if (pkt_q->vnet_hdr && (mbuf->ol_flags & RTE_MBUF_F_TX_TCP_SEG))
+			vnet_hdr_tso_fix_cksum(mbuf, vlan_len, frame);
+
+		ppd->tp_len = mbuf->pkt_len + hdr_len;
+		ppd->tp_snaplen = mbuf->pkt_len + hdr_len;
 
 		/* release incoming frame and advance ring buffer */
 		ppd->tp_status = TP_STATUS_SEND_REQUEST;
@@ -400,6 +636,16 @@ eth_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 		RTE_ETH_TX_OFFLOAD_VLAN_INSERT;
 	dev_info->rx_offload_capa = RTE_ETH_RX_OFFLOAD_VLAN_STRIP |
 		RTE_ETH_RX_OFFLOAD_TIMESTAMP;
+	if (internals->vnet_hdr) {
+		dev_info->tx_offload_capa |= RTE_ETH_TX_OFFLOAD_UDP_CKSUM |
+			RTE_ETH_TX_OFFLOAD_TCP_CKSUM |
+			RTE_ETH_TX_OFFLOAD_TCP_TSO;
+		dev_info->rx_offload_capa |= RTE_ETH_RX_OFFLOAD_UDP_CKSUM |
+			RTE_ETH_RX_OFFLOAD_TCP_CKSUM |
+			RTE_ETH_RX_OFFLOAD_TCP_LRO;
+		/* coalesced packets must fit in a single frame */
+		dev_info->max_lro_pkt_size = internals->tx_queue[0].frame_data_size;
+	}
 
 	return 0;
 }
@@ -521,8 +767,15 @@ eth_dev_close(struct rte_eth_dev *dev)
 		internals->rx_queue[q].sockfd = -1;
 		internals->tx_queue[q].sockfd = -1;
 
-		munmap(internals->rx_queue[q].map,
-			2 * req->tp_block_size * req->tp_block_nr);
+		if (internals->tpacket_v3) {
+			munmap(internals->rx_queue[q].map,
+				req->tp_block_size * req->tp_block_nr);
+			munmap(internals->tx_queue[q].map,
+				req->tp_block_size * req->tp_block_nr);
+		} else {
+			munmap(internals->rx_queue[q].map,
+				2 * req->tp_block_size * req->tp_block_nr);
+		}
 		rte_free(internals->rx_queue[q].rd);
 		rte_free(internals->tx_queue[q].rd);
 	}
@@ -586,6 +839,7 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pkt_q->in_port = dev->data->port_id;
 	pkt_q->vlan_strip = internals->vlan_strip;
 	pkt_q->timestamp_offloading = internals->timestamp_offloading;
+	pkt_q->vnet_hdr = internals->vnet_hdr;
 
 	return 0;
 }
@@ -601,6 +855,7 @@ eth_tx_queue_setup(struct rte_eth_dev *dev,
 	struct pmd_internals *internals = dev->data->dev_private;
 
 	dev->data->tx_queues[tx_queue_id] = &internals->tx_queue[tx_queue_id];
+	internals->tx_queue[tx_queue_id].vnet_hdr = internals->vnet_hdr;
 	return 0;
 }
 
@@ -784,6 +1039,115 @@ get_fanout(const char *fanout_mode, int if_index)
 		return PACKET_FANOUT_INVALID;
 }
 
+/*
+ * Set up a TPACKET_V3 Rx ring on a dedicated socket. The kernel fills
+ * whole blocks with variable-size frames and retires a block once it is
+ * full or once the block timeout expires.
+ */
+static int
+setup_rx_ring_v3(const char *name, const char *if_name,
+		 struct pkt_rx_queue *rx_queue,
+		 const struct tpacket_req *req,
+		 unsigned int block_tmo,
+		 int vnet_hdr,
+		 const struct sockaddr_ll *sockaddr,
+		 int fanout_arg,
+		 unsigned int nb_queues,
+		 unsigned int numa_node)
+{
+	struct tpacket_req3 req3;
+	unsigned int i;
+	int rc, tpver;
+
+	rx_queue->sockfd = socket(AF_PACKET, SOCK_RAW, 0);
+	if (rx_queue->sockfd == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not open AF_PACKET socket",
+			name);
+		return -1;
+	}
+
+	tpver = TPACKET_V3;
+	rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_VERSION,
+			&tpver, sizeof(tpver));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not set TPACKET_V3 on AF_PACKET socket for %s",
+			name, if_name);
+		return -1;
+	}
+
+	if (vnet_hdr) {
+		rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_VNET_HDR,
+				&vnet_hdr, sizeof(vnet_hdr));
+		if (rc == -1) {
+			PMD_LOG_ERRNO(ERR,
+				"%s: could not set PACKET_VNET_HDR on AF_PACKET socket for %s",
+				name, if_name);
+			return -1;
+		}
+	}
+
+	memset(&req3, 0, sizeof(req3));
+	req3.tp_block_size = req->tp_block_size;
+	req3.tp_block_nr = req->tp_block_nr;
+	req3.tp_frame_size = req->tp_frame_size;
+	req3.tp_frame_nr = req->tp_frame_nr;
+	req3.tp_retire_blk_tov = block_tmo;
+	rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_RX_RING,
+			&req3, sizeof(req3));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
+			name, if_name);
+		return -1;
+	}
+
+	rx_queue->map = mmap(NULL, req->tp_block_size * req->tp_block_nr,
+			    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+			    rx_queue->sockfd, 0);
+	if (rx_queue->map == MAP_FAILED) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: call to mmap failed on AF_PACKET socket for %s",
+			name, if_name);
+		return -1;
+	}
+
+	/* the Rx ring is walked block by block */
+	rx_queue->rd = rte_zmalloc_socket(name,
+			req->tp_block_nr * sizeof(*(rx_queue->rd)), 0, numa_node);
+	if (rx_queue->rd == NULL)
+		return -1;
+	for (i = 0; i < req->tp_block_nr; ++i) {
+		rx_queue->rd[i].iov_base = rx_queue->map + (i * req->tp_block_size);
+		rx_queue->rd[i].iov_len = req->tp_block_size;
+	}
+	rx_queue->framecount = req->tp_block_nr;
+
+	rc = bind(rx_queue->sockfd, (const struct sockaddr *)sockaddr,
+		  sizeof(*sockaddr));
+	if (rc == -1) {
+		PMD_LOG_ERRNO(ERR,
+			"%s: could not bind AF_PACKET socket to %s",
+			name, if_name);
+		return -1;
+	}
+
+	if (nb_queues > 1) {
+		rc = setsockopt(rx_queue->sockfd, SOL_PACKET, PACKET_FANOUT,
+				&fanout_arg, sizeof(fanout_arg));
+		if (rc == -1) {
+			PMD_LOG_ERRNO(ERR,
+				"%s: could not set PACKET_FANOUT "
+				"on AF_PACKET socket for %s",
+				name, if_name);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int
 rte_pmd_init_internals(struct rte_vdev_device *dev,
                        const int sockfd,
@@ -794,6 +1158,9 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
                        unsigned int framecnt,
 		       unsigned int qdisc_bypass,
 		       const char *fanout_mode,
+		       unsigned int tpacket_v3,
+		       unsigned int block_tmo,
+		       int vnet_hdr,
                        struct pmd_internals **internals,
                        struct rte_eth_dev **eth_dev,
                        struct rte_kvargs *kvlist)
@@ -805,13 +1172,14 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	struct ifreq ifr;
 	size_t ifnamelen;
 	unsigned k_idx;
-	struct sockaddr_ll sockaddr;
+	struct sockaddr_ll sockaddr, tx_sockaddr;
 	struct tpacket_req *req;
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
 	int rc, tpver, discard;
 	int qsockfd = -1;
 	unsigned int i, q, rdsize;
+	uint8_t *map;
 	int fanout_arg;
 
 	for (k_idx = 0; k_idx < kvlist->count; k_idx++) {
@@ -856,6 +1224,8 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	}
 
 	req = &((*internals)->req);
+	(*internals)->tpacket_v3 = tpacket_v3;
+	(*internals)->vnet_hdr = vnet_hdr;
 
 	req->tp_block_size = blocksize;
 	req->tp_block_nr = blockcnt;
@@ -893,6 +1263,14 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	sockaddr.sll_protocol = htons(ETH_P_ALL);
 	sockaddr.sll_ifindex = (*internals)->if_index;
 
+	/*
+	 * A TPACKET_V3 Rx ring lives on its own socket, the Tx socket then
+	 * binds without a protocol so that it does not receive any traffic.
+	 */
+	tx_sockaddr = sockaddr;
+	if (tpacket_v3)
+		tx_sockaddr.sll_protocol = 0;
+
 	fanout_arg = get_fanout(fanout_mode, (*internals)->if_index);
 	if (fanout_arg == PACKET_FANOUT_INVALID) {
 		PMD_LOG(ERR, "Invalid fanout mode: %s", fanout_mode);
@@ -929,6 +1307,18 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
+		/* must be set before the rings */
+		if (vnet_hdr) {
+			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_VNET_HDR,
+					&vnet_hdr, sizeof(vnet_hdr));
+			if (rc == -1) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: could not set PACKET_VNET_HDR on AF_PACKET socket for %s",
+					name, pair->value);
+				goto error;
+			}
+		}
+
 		if (qdisc_bypass) {
 #if defined(PACKET_QDISC_BYPASS)
 			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_QDISC_BYPASS,
@@ -942,12 +1332,15 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 #endif
 		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, sizeof(*req));
-		if (rc == -1) {
-			PMD_LOG_ERRNO(ERR,
-				"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
-				name, pair->value);
-			goto error;
+		if (!tpacket_v3) {
+			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING,
+					req, sizeof(*req));
+			if (rc == -1) {
+				PMD_LOG_ERRNO(ERR,
+					"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
+					name, pair->value);
+				goto error;
+			}
 		}
 
 		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, req, sizeof(*req));
@@ -959,12 +1352,14 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		}
 
 		rx_queue = &((*internals)->rx_queue[q]);
-		rx_queue->framecount = req->tp_frame_nr;
+		tx_queue = &((*internals)->tx_queue[q]);
 
-		rx_queue->map = mmap(NULL, 2 * req->tp_block_size * req->tp_block_nr,
-				    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
-				    qsockfd, 0);
-		if (rx_queue->map == MAP_FAILED) {
+		/* the Tx socket only maps its Tx ring in TPACKET_V3 mode */
+		map = mmap(NULL, (tpacket_v3 ? 1 : 2) *
+			   req->tp_block_size * req->tp_block_nr,
+			   PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED,
+			   qsockfd, 0);
+		if (map == MAP_FAILED) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: call to mmap failed on AF_PACKET socket for %s",
 				name, pair->value);
@@ -974,22 +1369,31 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		/* rdsize is same for both Tx and Rx */
 		rdsize = req->tp_frame_nr * sizeof(*(rx_queue->rd));
 
-		rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
-		if (rx_queue->rd == NULL)
-			goto error;
-		for (i = 0; i < req->tp_frame_nr; ++i) {
-			rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
-			rx_queue->rd[i].iov_len = req->tp_frame_size;
+		if (tpacket_v3) {
+			tx_queue->map = map;
+		} else {
+			rx_queue->framecount = req->tp_frame_nr;
+			rx_queue->map = map;
+
+			rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
+			if (rx_queue->rd == NULL)
+				goto error;
+			for (i = 0; i < req->tp_frame_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
+				rx_queue->rd[i].iov_len = req->tp_frame_size;
+			}
+			rx_queue->sockfd = qsockfd;
+
+			tx_queue->map = rx_queue->map +
+				req->tp_block_size * req->tp_block_nr;
 		}
-		rx_queue->sockfd = qsockfd;
 
-		tx_queue = &((*internals)->tx_queue[q]);
 		tx_queue->framecount = req->tp_frame_nr;
 		tx_queue->frame_data_size = req->tp_frame_size;
 		tx_queue->frame_data_size -= TPACKET2_HDRLEN -
 			sizeof(struct sockaddr_ll);
-
-		tx_queue->map = rx_queue->map + req->tp_block_size * req->tp_block_nr;
+		if (vnet_hdr)
+			tx_queue->frame_data_size -= sizeof(struct virtio_net_hdr);
 
 		tx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
 		if (tx_queue->rd == NULL)
@@ -1000,7 +1404,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		}
 		tx_queue->sockfd = qsockfd;
 
-		rc = bind(qsockfd, (const struct sockaddr*)&sockaddr, sizeof(sockaddr));
+		rc = bind(qsockfd, (const struct sockaddr*)&tx_sockaddr, sizeof(tx_sockaddr));
 		if (rc == -1) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: could not bind AF_PACKET socket to %s",
@@ -1008,7 +1412,12 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		if (nb_queues > 1) {
+		if (tpacket_v3) {
+			if (setup_rx_ring_v3(name, pair->value, rx_queue, req,
+					     block_tmo, vnet_hdr, &sockaddr, fanout_arg,
+					     nb_queues, numa_node) < 0)
+				goto error;
+		} else if (nb_queues > 1) {
 			rc = setsockopt(qsockfd, SOL_PACKET, PACKET_FANOUT,
 					&fanout_arg, sizeof(fanout_arg));
 			if (rc == -1) {
@@ -1054,13 +1463,22 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	for (q = 0; q < nb_queues; q++) {
 		if ((*internals)->rx_queue[q].map != MAP_FAILED)
 			munmap((*internals)->rx_queue[q].map,
-			       2 * req->tp_block_size * req->tp_block_nr);
+			       (tpacket_v3 ? 1 : 2) *
+			       req->tp_block_size * req->tp_block_nr);
+		if (tpacket_v3 && (*internals)->tx_queue[q].map != MAP_FAILED)
+			munmap((*internals)->tx_queue[q].map,
+			       req->tp_block_size * req->tp_block_nr);
 
 		rte_free((*internals)->rx_queue[q].rd);
 		rte_free((*internals)->tx_queue[q].rd);
 		if (((*internals)->rx_queue[q].sockfd >= 0) &&
 			((*internals)->rx_queue[q].sockfd != qsockfd))
 			close((*internals)->rx_queue[q].sockfd);
+		if (((*internals)->tx_queue[q].sockfd >= 0) &&
+			((*internals)->tx_queue[q].sockfd != qsockfd) &&
+			((*internals)->tx_queue[q].sockfd !=
+			 (*internals)->rx_queue[q].sockfd))
+			close((*internals)->tx_queue[q].sockfd);
 	}
 free_internals:
 	rte_free((*internals)->rx_queue);
@@ -1087,6 +1505,9 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	unsigned int qpairs = 1;
 	unsigned int qdisc_bypass = 1;
 	const char *fanout_mode = NULL;
+	unsigned int tpacket_v3 = 0;
+	unsigned int block_tmo = 0;
+	int vnet_hdr = 0;
 
 	/* do some parameter checking */
 	if (*sockfd < 0)
@@ -1153,6 +1574,40 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 			fanout_mode = pair->value;
 			continue;
 		}
+		if (strstr(pair->key, ETH_AF_PACKET_TPACKET_V3_ARG) != NULL) {
+			tpacket_v3 = atoi(pair->value);
+			if (tpacket_v3 > 1) {
+				PMD_LOG(ERR,
+					"%s: invalid tpacket_v3 value",
+					name);
+				return -1;
+			}
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_BLOCK_TMO_ARG) != NULL) {
+			block_tmo = atoi(pair->value);
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_VNET_HDR_ARG) != NULL) {
+			vnet_hdr = atoi(pair->value);
+			if (vnet_hdr < 0 || vnet_hdr > 1) {
+				PMD_LOG(ERR,
+					"%s: invalid vnet_hdr value",
+					name);
+				return -1;
+			}
+			continue;
+		}
+	}
+
+	/*
+	 * The qdisc bypass path drops packets which the kernel would have to
+	 * segment in software, as requested through the vnet header.
+	 */
+	if (vnet_hdr && qdisc_bypass) {
+		PMD_LOG(NOTICE, "%s: qdisc bypass disabled by vnet header",
+			name);
+		qdisc_bypass = 0;
 	}
 
 	if (framesize > blocksize) {
@@ -1179,17 +1634,26 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 		PMD_LOG(DEBUG, "%s:\tfanout mode %s", name, fanout_mode);
 	else
 		PMD_LOG(DEBUG, "%s:\tfanout mode %s", name, "default PACKET_FANOUT_HASH");
+	PMD_LOG(DEBUG, "%s:\trx ring version %s", name,
+		tpacket_v3 ? "TPACKET_V3" : "TPACKET_V2");
+	if (tpacket_v3)
+		PMD_LOG(DEBUG, "%s:\tblock timeout %u ms", name, block_tmo);
+	PMD_LOG(DEBUG, "%s:\tvnet header %d", name, vnet_hdr);
 
 	if (rte_pmd_init_internals(dev, *sockfd, qpairs,
 				   blocksize, blockcount,
 				   framesize, framecount,
 				   qdisc_bypass,
 				   fanout_mode,
+				   tpacket_v3, block_tmo, vnet_hdr,
 				   &internals, &eth_dev,
 				   kvlist) < 0)
 		return -1;
 
-	eth_dev->rx_pkt_burst = eth_af_packet_rx;
+	if (tpacket_v3)
+		eth_dev->rx_pkt_burst = eth_af_packet_rx_v3;
+	else
+		eth_dev->rx_pkt_burst = eth_af_packet_rx;
 	eth_dev->tx_pkt_burst = eth_af_packet_tx;
 
 	rte_eth_dev_probing_finish(eth_dev);
@@ -1282,4 +1746,7 @@ RTE_PMD_REGISTER_PARAM_STRING(net_af_packet,
 	"framesz=<int> "
 	"framecnt=<int> "
 	"qdisc_bypass=<0|1> "
-	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm>");
+	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm> "
+	"tpacket_v3=<0|1> "
+	"block_tmo=<int> "
+	"vnet_hdr=<0|1>");
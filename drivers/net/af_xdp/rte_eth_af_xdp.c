@@ -81,6 +81,13 @@ RTE_LOG_REGISTER_DEFAULT(af_xdp_logtype, NOTICE);
 
 #define ETH_AF_XDP_ETH_OVERHEAD		(RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN)
 
+/* Buffers per packet accepted by the kernel, MAX_SKB_FRAGS + 1 */
+#define ETH_AF_XDP_MAX_SEGS		18
+
+#ifndef XDP_PKT_CONTD
+#define XDP_PKT_CONTD			0
+#endif
+
 #define ETH_AF_XDP_MP_KEY "afxdp_mp_send_fds"
 
 #define DP_BASE_PATH			"/tmp/afxdp_dp"
@@ -144,6 +151,10 @@ struct pkt_rx_queue {
 	struct pollfd fds[1];
 	int xsk_queue_idx;
 	int busy_budget;
+
+	/* packet being assembled from multi-buffer descriptors */
+	struct rte_mbuf *pkt_first_seg;
+	struct rte_mbuf *pkt_last_seg;
 };
 
 struct tx_stats {
@@ -160,6 +171,7 @@ struct pkt_tx_queue {
 
 	struct pkt_rx_queue *pair;
 	int xsk_queue_idx;
+	bool use_sg;
 };
 
 struct pmd_internals {
@@ -174,6 +186,7 @@ struct pmd_internals {
 	char prog_path[PATH_MAX];
 	bool custom_prog_configured;
 	bool force_copy;
+	bool use_sg;
 	bool use_cni;
 	bool use_pinned_map;
 	char dp_path[PATH_MAX];
@@ -330,6 +343,40 @@ reserve_fill_queue(struct xsk_umem_info *umem, uint16_t reserve_size,
 #endif
 }
 
+/*
+ * Link a received buffer to the packet being assembled on the queue.
+ * Return the packet once its last buffer is seen, NULL otherwise.
+ */
+static inline struct rte_mbuf *
+rx_chain_seg(struct pkt_rx_queue *rxq, struct rte_mbuf *seg,
+	     const struct xdp_desc *desc)
+{
+#if defined(XDP_USE_SG)
+	struct rte_mbuf *head = rxq->pkt_first_seg;
+
+	if (head != NULL) {
+		rxq->pkt_last_seg->next = seg;
+		head->nb_segs++;
+		head->pkt_len += seg->data_len;
+	} else {
+		head = seg;
+	}
+
+	if (desc->options & XDP_PKT_CONTD) {
+		rxq->pkt_first_seg = head;
+		rxq->pkt_last_seg = seg;
+		return NULL;
+	}
+
+	rxq->pkt_first_seg = NULL;
+	return head;
+#else
+	RTE_SET_USED(rxq);
+	RTE_SET_USED(desc);
+	return seg;
+#endif
+}
+
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
 static uint16_t
 af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
@@ -340,10 +387,12 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	struct xsk_umem_info *umem = rxq->umem;
 	uint32_t idx_rx = 0;
 	unsigned long rx_bytes = 0;
+	uint16_t nb_rx = 0;
 	int i;
 	struct rte_mbuf *fq_bufs[ETH_AF_XDP_RX_BATCH_SIZE];
 	struct rte_eth_dev *dev = &rte_eth_devices[rxq->port];
 
+	/* from here on nb_pkts counts descriptors, i.e. buffers */
 	nb_pkts = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
 
 	if (nb_pkts == 0) {
@@ -377,6 +426,7 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 	for (i = 0; i < nb_pkts; i++) {
 		const struct xdp_desc *desc;
+		struct rte_mbuf *mbuf;
 		uint64_t addr;
 		uint32_t len;
 		uint64_t offset;
@@ -388,27 +438,31 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		offset = xsk_umem__extract_offset(addr);
 		addr = xsk_umem__extract_addr(addr);
 
-		bufs[i] = (struct rte_mbuf *)
+		mbuf = (struct rte_mbuf *)
 				xsk_umem__get_data(umem->buffer, addr +
 					umem->mb_pool->header_size);
-		bufs[i]->data_off = offset - sizeof(struct rte_mbuf) -
+		mbuf->data_off = offset - sizeof(struct rte_mbuf) -
 			rte_pktmbuf_priv_size(umem->mb_pool) -
 			umem->mb_pool->header_size;
-		bufs[i]->port = rxq->port;
+		mbuf->port = rxq->port;
 
-		rte_pktmbuf_pkt_len(bufs[i]) = len;
-		rte_pktmbuf_data_len(bufs[i]) = len;
+		rte_pktmbuf_pkt_len(mbuf) = len;
+		rte_pktmbuf_data_len(mbuf) = len;
 		rx_bytes += len;
+
+		mbuf = rx_chain_seg(rxq, mbuf, desc);
+		if (mbuf != NULL)
+			bufs[nb_rx++] = mbuf;
 	}
 
 	xsk_ring_cons__release(rx, nb_pkts);
 	(void)reserve_fill_queue(umem, nb_pkts, fq_bufs, fq);
 
 	/* statistics */
-	rxq->stats.rx_pkts += nb_pkts;
+	rxq->stats.rx_pkts += nb_rx;
 	rxq->stats.rx_bytes += rx_bytes;
 
-	return nb_pkts;
+	return nb_rx;
 }
 #else
 static uint16_t
@@ -420,6 +474,7 @@ af_xdp_rx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	struct xsk_ring_prod *fq = &rxq->fq;
 	uint32_t idx_rx = 0;
 	unsigned long rx_bytes = 0;
+	uint16_t nb_rx = 0;
 	int i;
 	uint32_t free_thresh = fq->size >> 1;
 	struct rte_mbuf *mbufs[ETH_AF_XDP_RX_BATCH_SIZE];
@@ -428,6 +483,7 @@ af_xdp_rx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	if (xsk_prod_nb_free(fq, free_thresh) >= free_thresh)
 		(void)reserve_fill_queue(umem, nb_pkts, NULL, fq);
 
+	/* from here on nb_pkts counts descriptors, i.e. buffers */
 	nb_pkts = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
 	if (nb_pkts == 0) {
 #if defined(XDP_USE_NEED_WAKEUP)
@@ -462,17 +518,20 @@ af_xdp_rx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		rte_pktmbuf_pkt_len(mbufs[i]) = len;
 		rte_pktmbuf_data_len(mbufs[i]) = len;
 		rx_bytes += len;
-		bufs[i] = mbufs[i];
-		bufs[i]->port = rxq->port;
+		mbufs[i]->port = rxq->port;
+
+		mbufs[i] = rx_chain_seg(rxq, mbufs[i], desc);
+		if (mbufs[i] != NULL)
+			bufs[nb_rx++] = mbufs[i];
 	}
 
 	xsk_ring_cons__release(rx, nb_pkts);
 
 	/* statistics */
-	rxq->stats.rx_pkts += nb_pkts;
+	rxq->stats.rx_pkts += nb_rx;
 	rxq->stats.rx_bytes += rx_bytes;
 
-	return nb_pkts;
+	return nb_rx;
 }
 #endif
 
@@ -558,19 +617,14 @@ kick_tx(struct pkt_tx_queue *txq, struct xsk_ring_cons *cq)
 		}
 }
 
-static inline struct xdp_desc *
-reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
-		 struct xsk_umem_info *umem, void **pkt_ptr)
+static inline void
+fill_desc(struct xdp_desc *desc, struct rte_mbuf *mbuf,
+	  struct xsk_umem_info *umem, void **pkt_ptr)
 {
-	struct xdp_desc *desc = NULL;
 	uint64_t addr, offset;
-	uint32_t idx_tx;
 
-	if (!xsk_ring_prod__reserve(&txq->tx, 1, &idx_tx))
-		goto out;
-
-	desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx);
-	desc->len = mbuf->pkt_len;
+	desc->len = mbuf->data_len;
+	desc->options = 0;
 
 	addr = (uint64_t)mbuf - (uint64_t)umem->buffer
 		- umem->mb_pool->header_size;
@@ -582,11 +636,102 @@ reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
 
 	offset = offset << XSK_UNALIGNED_BUF_OFFSET_SHIFT;
 	desc->addr = addr | offset;
+}
+
+static inline struct xdp_desc *
+reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
+		 struct xsk_umem_info *umem, void **pkt_ptr)
+{
+	struct xdp_desc *desc = NULL;
+	uint32_t idx_tx;
+
+	if (!xsk_ring_prod__reserve(&txq->tx, 1, &idx_tx))
+		goto out;
+
+	desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx);
+	fill_desc(desc, mbuf, umem, pkt_ptr);
 
 out:
 	return desc;
 }
 
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG) && defined(XDP_USE_SG)
+/*
+ * Hand a packet spanning several UMEM buffers to the kernel, one
+ * descriptor per buffer, all but the last flagged XDP_PKT_CONTD.
+ * Segments outside the UMEM are copied into UMEM buffers first.
+ * Return 0 on success, -ENOSPC when out of buffers or descriptors
+ * and -EINVAL when the packet needs too many buffers.
+ */
+static inline int
+tx_zc_multi_buf(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
+		uint16_t buf_size, uint32_t *nb_descs)
+{
+	struct xsk_umem_info *umem = txq->umem;
+	struct xsk_ring_cons *cq = &txq->pair->cq;
+	struct rte_mbuf *segs[ETH_AF_XDP_MAX_SEGS];
+	struct rte_mbuf *seg;
+	uint32_t idx_tx, off, len, i, n;
+	bool copy = mbuf->nb_segs > ETH_AF_XDP_MAX_SEGS;
+	const void *src;
+	void *dst;
+
+	for (seg = mbuf; seg != NULL && !copy; seg = seg->next)
+		copy = seg->pool != umem->mb_pool;
+
+	if (copy) {
+		n = RTE_MAX(1U, (mbuf->pkt_len + buf_size - 1) / buf_size);
+		if (n > ETH_AF_XDP_MAX_SEGS)
+			return -EINVAL;
+		if (rte_pktmbuf_alloc_bulk(umem->mb_pool, segs, n))
+			return -ENOSPC;
+
+		for (i = 0, off = 0; i < n; i++, off += len) {
+			len = RTE_MIN((uint32_t)buf_size, mbuf->pkt_len - off);
+			dst = rte_pktmbuf_mtod(segs[i], void *);
+			src = rte_pktmbuf_read(mbuf, off, len, dst);
+			if (src != dst)
+				rte_memcpy(dst, src, len);
+			segs[i]->data_len = len;
+			segs[i]->pkt_len = len;
+		}
+	} else {
+		n = mbuf->nb_segs;
+		for (i = 0, seg = mbuf; i < n; i++, seg = seg->next)
+			segs[i] = seg;
+	}
+
+	if (xsk_ring_prod__reserve(&txq->tx, n, &idx_tx) != n) {
+		kick_tx(txq, cq);
+		if (xsk_ring_prod__reserve(&txq->tx, n, &idx_tx) != n) {
+			if (copy)
+				rte_pktmbuf_free_bulk(segs, n);
+			return -ENOSPC;
+		}
+	}
+
+	for (i = 0; i < n; i++) {
+		struct xdp_desc *desc;
+
+		desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx + i);
+		fill_desc(desc, segs[i], umem, NULL);
+		if (i < n - 1)
+			desc->options = XDP_PKT_CONTD;
+
+		/* each buffer is freed on its own on completion */
+		segs[i]->next = NULL;
+		segs[i]->nb_segs = 1;
+	}
+
+	if (copy)
+		rte_pktmbuf_free(mbuf);
+
+	*nb_descs += n;
+
+	return 0;
+}
+#endif
+
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
 static uint16_t
 af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
@@ -597,9 +742,15 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	unsigned long tx_bytes = 0;
 	int i;
 	uint16_t count = 0;
+	uint16_t nb_drop = 0;
+	uint32_t nb_descs = 0;
 	struct xdp_desc *desc;
 	struct xsk_ring_cons *cq = &txq->pair->cq;
 	uint32_t free_thresh = cq->size >> 1;
+#if defined(XDP_USE_SG)
+	uint16_t buf_size = rte_pktmbuf_data_room_size(umem->mb_pool) -
+		RTE_PKTMBUF_HEADROOM;
+#endif
 	void *pkt;
 
 	if (xsk_cons_nb_avail(cq, free_thresh) >= free_thresh)
@@ -608,6 +759,26 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	for (i = 0; i < nb_pkts; i++) {
 		mbuf = bufs[i];
 
+#if defined(XDP_USE_SG)
+		if (txq->use_sg &&
+		    (mbuf->nb_segs > 1 || mbuf->pkt_len > buf_size)) {
+			uint32_t len = mbuf->pkt_len;
+			int ret;
+
+			ret = tx_zc_multi_buf(txq, mbuf, buf_size, &nb_descs);
+			if (ret == -ENOSPC)
+				goto out;
+			if (ret < 0) {
+				rte_pktmbuf_free(mbuf);
+				nb_drop++;
+			} else {
+				tx_bytes += len;
+			}
+			count++;
+			continue;
+		}
+#endif
+
 		if (mbuf->pool == umem->mb_pool) {
 			desc = reserve_and_fill(txq, mbuf, umem, NULL);
 			if (!desc) {
@@ -619,6 +790,7 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 			tx_bytes += desc->len;
 			count++;
+			nb_descs++;
 		} else {
 			local_mbuf = rte_pktmbuf_alloc(umem->mb_pool);
 			if (!local_mbuf)
@@ -636,16 +808,17 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			rte_pktmbuf_free(mbuf);
 			tx_bytes += desc->len;
 			count++;
+			nb_descs++;
 		}
 	}
 
 out:
-	xsk_ring_prod__submit(&txq->tx, count);
+	xsk_ring_prod__submit(&txq->tx, nb_descs);
 	kick_tx(txq, cq);
 
-	txq->stats.tx_pkts += count;
+	txq->stats.tx_pkts += count - nb_drop;
 	txq->stats.tx_bytes += tx_bytes;
-	txq->stats.tx_dropped += nb_pkts - count;
+	txq->stats.tx_dropped += nb_pkts - count + nb_drop;
 
 	return count;
 }
@@ -659,39 +832,64 @@ af_xdp_tx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	void *addrs[ETH_AF_XDP_TX_BATCH_SIZE];
 	unsigned long tx_bytes = 0;
 	int i;
-	uint32_t idx_tx;
+	uint32_t idx_tx, nb_descs, d;
+	uint32_t buf_size = UINT32_MAX;
 	struct xsk_ring_cons *cq = &txq->pair->cq;
 
 	pull_umem_cq(umem, nb_pkts, cq);
 
-	nb_pkts = rte_ring_dequeue_bulk(umem->buf_ring, addrs,
-					nb_pkts, NULL);
-	if (nb_pkts == 0)
+	/* in multi-buffer mode a packet takes one frame per buffer */
+	if (txq->use_sg)
+		buf_size = ETH_AF_XDP_FRAME_SIZE;
+
+	nb_descs = 0;
+	for (i = 0; i < nb_pkts; i++) {
+		d = 1;
+		if (bufs[i]->pkt_len > buf_size)
+			d = (bufs[i]->pkt_len + buf_size - 1) / buf_size;
+		if (nb_descs + d > ETH_AF_XDP_TX_BATCH_SIZE)
+			break;
+		nb_descs += d;
+	}
+	nb_pkts = i;
+
+	if (nb_descs == 0 || rte_ring_dequeue_bulk(umem->buf_ring, addrs,
+						   nb_descs, NULL) == 0)
 		return 0;
 
-	if (xsk_ring_prod__reserve(&txq->tx, nb_pkts, &idx_tx) != nb_pkts) {
+	if (xsk_ring_prod__reserve(&txq->tx, nb_descs, &idx_tx) != nb_descs) {
 		kick_tx(txq, cq);
-		rte_ring_enqueue_bulk(umem->buf_ring, addrs, nb_pkts, NULL);
+		rte_ring_enqueue_bulk(umem->buf_ring, addrs, nb_descs, NULL);
 		return 0;
 	}
 
+	d = 0;
 	for (i = 0; i < nb_pkts; i++) {
-		struct xdp_desc *desc;
-		void *pkt;
+		uint32_t off = 0;
 
-		desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx + i);
 		mbuf = bufs[i];
-		desc->len = mbuf->pkt_len;
+		do {
+			struct xdp_desc *desc;
+			const void *src;
+			void *pkt;
+
+			desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx + d);
+			desc->len = RTE_MIN(mbuf->pkt_len - off, buf_size);
+			desc->addr = (uint64_t)addrs[d++];
+			pkt = xsk_umem__get_data(umem->mz->addr,
+						 desc->addr);
+			src = rte_pktmbuf_read(mbuf, off, desc->len, pkt);
+			if (src != pkt)
+				rte_memcpy(pkt, src, desc->len);
+			off += desc->len;
+			desc->options = off < mbuf->pkt_len ? XDP_PKT_CONTD : 0;
+		} while (off < mbuf->pkt_len);
 
-		desc->addr = (uint64_t)addrs[i];
-		pkt = xsk_umem__get_data(umem->mz->addr,
-					 desc->addr);
-		rte_memcpy(pkt, rte_pktmbuf_mtod(mbuf, void *), desc->len);
 		tx_bytes += mbuf->pkt_len;
 		rte_pktmbuf_free(mbuf);
 	}
 
-	xsk_ring_prod__submit(&txq->tx, nb_pkts);
+	xsk_ring_prod__submit(&txq->tx, nb_descs);
 
 	kick_tx(txq, cq);
 
@@ -796,15 +994,40 @@ find_internal_resource(struct pmd_internals *port_int)
 	return list;
 }
 
+/* Largest frame fitting in a single UMEM buffer */
+static inline uint32_t
+eth_af_xdp_buf_pktlen(void)
+{
+#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
+	return getpagesize() - sizeof(struct rte_mempool_objhdr) -
+		sizeof(struct rte_mbuf) - RTE_PKTMBUF_HEADROOM -
+		XDP_PACKET_HEADROOM;
+#else
+	return ETH_AF_XDP_FRAME_SIZE - XDP_PACKET_HEADROOM;
+#endif
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev)
 {
 	struct pmd_internals *internal = dev->data->dev_private;
+	struct rte_eth_conf *conf = &dev->data->dev_conf;
 
 	/* rx/tx must be paired */
 	if (dev->data->nb_rx_queues != dev->data->nb_tx_queues)
 		return -EINVAL;
 
+	/* frames larger than one buffer need multi-buffer sockets */
+	internal->use_sg =
+		!!(conf->rxmode.offloads & RTE_ETH_RX_OFFLOAD_SCATTER) ||
+		!!(conf->txmode.offloads & RTE_ETH_TX_OFFLOAD_MULTI_SEGS);
+	if (!internal->use_sg && conf->rxmode.mtu + ETH_AF_XDP_ETH_OVERHEAD >
+			eth_af_xdp_buf_pktlen()) {
+		AF_XDP_LOG_LINE(ERR, "MTU %u needs Rx scatter offload",
+				conf->rxmode.mtu);
+		return -EINVAL;
+	}
+
 	if (internal->shared_umem) {
 		struct internal_list *list = NULL;
 		const char *name = dev->device->name;
@@ -871,13 +1094,12 @@ eth_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	dev_info->max_tx_queues = internals->queue_cnt;
 
 	dev_info->min_mtu = RTE_ETHER_MIN_MTU;
-#if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
-	dev_info->max_rx_pktlen = getpagesize() -
-				  sizeof(struct rte_mempool_objhdr) -
-				  sizeof(struct rte_mbuf) -
-				  RTE_PKTMBUF_HEADROOM - XDP_PACKET_HEADROOM;
+#if defined(XDP_USE_SG)
+	dev_info->rx_offload_capa = RTE_ETH_RX_OFFLOAD_SCATTER;
+	dev_info->tx_offload_capa = RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+	dev_info->max_rx_pktlen = RTE_ETHER_MAX_JUMBO_FRAME_LEN;
 #else
-	dev_info->max_rx_pktlen = ETH_AF_XDP_FRAME_SIZE - XDP_PACKET_HEADROOM;
+	dev_info->max_rx_pktlen = eth_af_xdp_buf_pktlen();
 #endif
 	dev_info->max_mtu = dev_info->max_rx_pktlen - ETH_AF_XDP_ETH_OVERHEAD;
 
@@ -1065,6 +1287,7 @@ eth_dev_close(struct rte_eth_dev *dev)
 		if (rxq->umem == NULL)
 			break;
 		xsk_socket__delete(rxq->xsk);
+		rte_pktmbuf_free(rxq->pkt_first_seg);
 
 		if (rte_atomic_fetch_sub_explicit(&rxq->umem->refcnt, 1,
 				rte_memory_order_acquire) - 1 == 0)
@@ -1725,6 +1948,13 @@ xsk_configure(struct pmd_internals *internals, struct pkt_rx_queue *rxq,
 	cfg.bind_flags |= XDP_USE_NEED_WAKEUP;
 #endif
 
+#if defined(XDP_USE_SG)
+	/* Let frames span several UMEM buffers */
+	if (internals->use_sg)
+		cfg.bind_flags |= XDP_USE_SG;
+#endif
+	txq->use_sg = internals->use_sg;
+
 	/* Disable libbpf from loading XDP program */
 	if (internals->use_cni || internals->use_pinned_map)
 		cfg.libbpf_flags |= XSK_LIBBPF_FLAGS__INHIBIT_PROG_LOAD;
@@ -1907,6 +2137,10 @@ eth_dev_mtu_set(struct rte_eth_dev *dev, uint16_t mtu)
 	int ret;
 	int s;
 
+	if (!internals->use_sg &&
+	    mtu + ETH_AF_XDP_ETH_OVERHEAD > eth_af_xdp_buf_pktlen())
+		return -EINVAL;
+
 	s = socket(PF_INET, SOCK_DGRAM, 0);
 	if (s < 0)
 		return -EINVAL;
@@ -109,8 +109,16 @@ static void cmd_set_bonding_lacp_dedicated_queues_parsed(void *parsed_result,
 		else
 			printf("Enabling dedicate queues for LACP control "
 					"packets on port %d failed\n", port_id);
+	} else if (!strcmp(res->mode, "tx_only")) {
+		if (rte_eth_bond_8023ad_dedicated_txq_enable(port_id) == 0)
+			printf("Dedicated Tx queue for LACP control packets"
+					" enabled\n");
+		else
+			printf("Enabling dedicated Tx queue for LACP control "
+					"packets on port %d failed\n", port_id);
 	} else if (!strcmp(res->mode, "disable")) {
-		if (rte_eth_bond_8023ad_dedicated_queues_disable(port_id) == 0)
+		if (rte_eth_bond_8023ad_dedicated_queues_disable(port_id) == 0 &&
+				rte_eth_bond_8023ad_dedicated_txq_disable(port_id) == 0)
 			printf("Dedicated queues for LACP control packets "
 					"disabled\n");
 		else
@@ -136,12 +144,12 @@ static cmdline_parse_token_num_t cmd_setbonding_lacp_dedicated_queues_port_id =
 		port_id, RTE_UINT16);
 static cmdline_parse_token_string_t cmd_setbonding_lacp_dedicated_queues_mode =
 	TOKEN_STRING_INITIALIZER(struct cmd_set_bonding_lacp_dedicated_queues_result,
-		mode, "enable#disable");
+		mode, "enable#disable#tx_only");
 
 static cmdline_parse_inst_t cmd_set_lacp_dedicated_queues = {
 	.f = cmd_set_bonding_lacp_dedicated_queues_parsed,
 	.help_str = "set bonding lacp dedicated_queues <port_id> "
-		"enable|disable: "
+		"enable|disable|tx_only: "
 		"Enable/disable dedicated queues for LACP control traffic for port_id",
 	.data = NULL,
 	.tokens = {
@@ -741,7 +749,7 @@ static struct testpmd_driver_commands bonding_cmds = {
 	},
 	{
 		&cmd_set_lacp_dedicated_queues,
-		"set bonding lacp dedicated_queues <port_id> (enable|disable)\n"
+		"set bonding lacp dedicated_queues <port_id> (enable|disable|tx_only)\n"
 		"	Enable/disable dedicated queues for LACP control traffic.\n",
 	},
 	{
@@ -5,6 +5,7 @@
 #ifndef _ETH_BOND_8023AD_PRIVATE_H_
 #define _ETH_BOND_8023AD_PRIVATE_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <rte_ether.h>
@@ -171,6 +172,12 @@ struct mode8023ad_private {
 	 */
 	struct {
 		uint8_t enabled;
+		/**
+		 * Only the Tx queue is reserved: slow packets are still
+		 * filtered in software on Rx, but are sent by the mode 4
+		 * alarm callback instead of the data path.
+		 */
+		uint8_t tx_only;
 
 		struct rte_flow *flow[RTE_MAX_ETHPORTS];
 
@@ -308,4 +315,17 @@ bond_ethdev_8023ad_flow_set(struct rte_eth_dev *bond_dev, uint16_t member_port);
 int
 bond_8023ad_slow_pkt_hw_filter_supported(uint16_t port_id);
 
+/**
+ * @internal
+ *
+ * Check whether members have an additional Tx queue reserved for slow
+ * packets, either alone or together with a filtered Rx queue.
+ */
+static inline bool
+bond_mode_8023ad_dedicated_txq(const struct mode8023ad_private *mode4)
+{
+	return mode4->dedicated_queues.enabled == 1 ||
+		mode4->dedicated_queues.tx_only == 1;
+}
+
 #endif /* _ETH_BOND_8023AD_H_ */
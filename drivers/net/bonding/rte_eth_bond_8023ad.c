@@ -859,6 +859,30 @@ bond_mode_8023ad_dedicated_rxq_process(struct bond_dev_private *internals,
 	}
 }
 
+static void
+bond_mode_8023ad_dedicated_txq_flush(struct bond_dev_private *internals,
+			uint16_t member_id)
+{
+	struct port *port = &bond_mode_8023ad_ports[member_id];
+	struct rte_mbuf *pkts[DEDICATED_QUEUE_BURST_SIZE];
+	unsigned int nb_pkts;
+	uint16_t tx_count;
+
+	nb_pkts = rte_ring_dequeue_burst(port->tx_ring, (void **)pkts,
+			DEDICATED_QUEUE_BURST_SIZE, NULL);
+	if (nb_pkts == 0)
+		return;
+
+	tx_count = rte_eth_tx_prepare(member_id,
+			internals->mode4.dedicated_queues.tx_qid, pkts, nb_pkts);
+	tx_count = rte_eth_tx_burst(member_id,
+			internals->mode4.dedicated_queues.tx_qid, pkts, tx_count);
+	if (tx_count < nb_pkts) {
+		rte_pktmbuf_free_bulk(&pkts[tx_count], nb_pkts - tx_count);
+		set_warning_flags(port, WRN_TX_QUEUE_FULL);
+	}
+}
+
 static void
 bond_mode_8023ad_periodic_cb(void *arg)
 {
@@ -954,6 +978,10 @@ bond_mode_8023ad_periodic_cb(void *arg)
 		tx_machine(internals, member_id);
 		selection_logic(internals, member_id);
 
+		if (internals->mode4.dedicated_queues.tx_only == 1)
+			bond_mode_8023ad_dedicated_txq_flush(internals,
+					member_id);
+
 		SM_FLAG_CLR(port, BEGIN);
 		show_warnings(member_id);
 	}
@@ -1261,6 +1289,7 @@ bond_mode_8023ad_conf_assign(struct mode8023ad_private *mode4,
 	mode4->update_timeout_us = conf->update_timeout_ms * 1000;
 
 	mode4->dedicated_queues.enabled = 0;
+	mode4->dedicated_queues.tx_only = 0;
 	mode4->dedicated_queues.rx_qid = UINT16_MAX;
 	mode4->dedicated_queues.tx_qid = UINT16_MAX;
 }
@@ -1717,6 +1746,10 @@ bond_mode_8023ad_ext_periodic_cb(void *arg)
 			 */
 			mode4->slowrx_cb(member_id, lacp_pkt);
 		}
+
+		if (bond_mode_8023ad_dedicated_txq(mode4))
+			bond_mode_8023ad_dedicated_txq_flush(internals,
+					member_id);
 	}
 
 	rte_eal_alarm_set(internals->mode4.update_timeout_us,
@@ -1745,6 +1778,7 @@ rte_eth_bond_8023ad_dedicated_queues_enable(uint16_t port)
 		return -1;
 
 	internals->mode4.dedicated_queues.enabled = 1;
+	internals->mode4.dedicated_queues.tx_only = 0;
 
 	bond_ethdev_mode_set(dev, internals->mode);
 	return retval;
@@ -1774,3 +1808,61 @@ rte_eth_bond_8023ad_dedicated_queues_disable(uint16_t port)
 
 	return retval;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_bond_8023ad_dedicated_txq_enable, 26.03)
+int
+rte_eth_bond_8023ad_dedicated_txq_enable(uint16_t port)
+{
+	struct rte_eth_dev *dev;
+	struct bond_dev_private *internals;
+	struct rte_eth_dev_info member_info;
+	uint16_t idx;
+
+	if (valid_bonding_port_id(port) != 0)
+		return -EINVAL;
+
+	dev = &rte_eth_devices[port];
+	internals = dev->data->dev_private;
+
+	/* Device must be stopped to set up slow queue */
+	if (dev->data->dev_started)
+		return -1;
+
+	/* Members need room for one more Tx queue, no flow rule is used */
+	for (idx = 0; idx < internals->member_count; idx++) {
+		if (rte_eth_dev_info_get(internals->members[idx].port_id,
+				&member_info) != 0 ||
+				member_info.max_tx_queues <=
+					dev->data->nb_tx_queues)
+			return -1;
+	}
+
+	internals->mode4.dedicated_queues.enabled = 0;
+	internals->mode4.dedicated_queues.tx_only = 1;
+
+	bond_ethdev_mode_set(dev, internals->mode);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_bond_8023ad_dedicated_txq_disable, 26.03)
+int
+rte_eth_bond_8023ad_dedicated_txq_disable(uint16_t port)
+{
+	struct rte_eth_dev *dev;
+	struct bond_dev_private *internals;
+
+	if (valid_bonding_port_id(port) != 0)
+		return -EINVAL;
+
+	dev = &rte_eth_devices[port];
+	internals = dev->data->dev_private;
+
+	/* Device must be stopped to set up slow queue */
+	if (dev->data->dev_started)
+		return -1;
+
+	internals->mode4.dedicated_queues.tx_only = 0;
+
+	bond_ethdev_mode_set(dev, internals->mode);
+	return 0;
+}
@@ -5,6 +5,7 @@
 #ifndef RTE_ETH_BOND_8023AD_H_
 #define RTE_ETH_BOND_8023AD_H_
 
+#include <rte_compat.h>
 #include <rte_ether.h>
 
 #ifdef __cplusplus
@@ -311,6 +312,53 @@ rte_eth_bond_8023ad_dedicated_queues_enable(uint16_t port_id);
 int
 rte_eth_bond_8023ad_dedicated_queues_disable(uint16_t port_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Enable a dedicated tx queue for 802.3ad control plane traffic on members
+ *
+ * This function creates an additional tx queue on each member, through which
+ * the LACP state machine sends LACPDUs and marker responses from the mode 4
+ * periodic callback. Unlike rte_eth_bond_8023ad_dedicated_queues_enable(),
+ * no flow filtering rule is required: slow packets are still removed from
+ * the rx burst in software, but the bonding tx burst no longer polls the
+ * control packet rings of the members, and does not need to be called
+ * periodically for LACP to make progress.
+ *
+ * To use this feature all members must have enough tx queues that one can be
+ * reserved for the LACP state machines control packets. Enabling it disables
+ * the dedicated rx and tx queues if they were enabled.
+ *
+ * Bonding port must be stopped to change this configuration.
+ *
+ * @param port_id      Bonding device id
+ *
+ * @return
+ *   0 on success, negative value otherwise.
+ */
+__rte_experimental
+int
+rte_eth_bond_8023ad_dedicated_txq_enable(uint16_t port_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Disable the dedicated tx queue on members
+ *
+ * Bonding port must be stopped to change this configuration.
+ *
+ * @see rte_eth_bond_8023ad_dedicated_txq_enable
+ *
+ * @param port_id      Bonding device id
+ * @return
+ *   0 on success, negative value otherwise.
+ */
+__rte_experimental
+int
+rte_eth_bond_8023ad_dedicated_txq_disable(uint16_t port_id);
+
 /*
  * Get aggregator mode for 8023ad
  * @param port_id Bonding device id
@@ -19,7 +19,9 @@
 #include <bus_vdev_driver.h>
 #include <rte_alarm.h>
 #include <rte_cycles.h>
+#include <rte_reciprocal.h>
 #include <rte_string_fns.h>
+#include <rte_vect.h>
 
 #include "rte_eth_bond.h"
 #include "eth_bond_private.h"
@@ -668,17 +670,37 @@ bond_ethdev_tx_burst_active_backup(void *queue,
 			bufs, nb_prep_pkts);
 }
 
+/* Number of packets hashed before their members are resolved at once. */
+#define BOND_HASH_BURST 32
+/* Distance, in packets, at which headers are prefetched while hashing. */
+#define BOND_HASH_PREFETCH 4
+
+static inline void
+bond_hash_prefetch(struct rte_mbuf **buf, uint16_t nb_pkts)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts && i < BOND_HASH_PREFETCH; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(buf[i], void *));
+}
+
+/*
+ * XOR of the six 16-bit words of the destination and source addresses,
+ * folded from one 64-bit and one 32-bit load in either byte order.
+ */
 static inline uint16_t
 ether_hash(struct rte_ether_hdr *eth_hdr)
 {
-	unaligned_uint16_t *word_src_addr =
-		(unaligned_uint16_t *)eth_hdr->src_addr.addr_bytes;
-	unaligned_uint16_t *word_dst_addr =
-		(unaligned_uint16_t *)eth_hdr->dst_addr.addr_bytes;
+	uint64_t x;
+	uint32_t y;
 
-	return (word_src_addr[0] ^ word_dst_addr[0]) ^
-			(word_src_addr[1] ^ word_dst_addr[1]) ^
-			(word_src_addr[2] ^ word_dst_addr[2]);
+	memcpy(&x, eth_hdr, sizeof(x));
+	memcpy(&y, &eth_hdr->src_addr.addr_bytes[2], sizeof(y));
+	x ^= y;
+	x ^= x >> 32;
+	x ^= x >> 16;
+
+	return (uint16_t)x;
 }
 
 static inline uint32_t
@@ -690,6 +712,23 @@ ipv4_hash(struct rte_ipv4_hdr *ipv4_hdr)
 static inline uint32_t
 ipv6_hash(struct rte_ipv6_hdr *ipv6_hdr)
 {
+#if defined(RTE_ARCH_X86)
+	__m128i x = _mm_xor_si128(
+		_mm_loadu_si128((const __m128i *)&ipv6_hdr->src_addr),
+		_mm_loadu_si128((const __m128i *)&ipv6_hdr->dst_addr));
+
+	x = _mm_xor_si128(x, _mm_srli_si128(x, 8));
+	x = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+
+	return _mm_cvtsi128_si32(x);
+#elif defined(__ARM_NEON)
+	uint32x4_t x = veorq_u32(
+		vreinterpretq_u32_u8(vld1q_u8((const uint8_t *)&ipv6_hdr->src_addr)),
+		vreinterpretq_u32_u8(vld1q_u8((const uint8_t *)&ipv6_hdr->dst_addr)));
+	uint32x2_t y = veor_u32(vget_low_u32(x), vget_high_u32(x));
+
+	return vget_lane_u32(y, 0) ^ vget_lane_u32(y, 1);
+#else
 	unaligned_uint32_t *word_src_addr = (unaligned_uint32_t *)&ipv6_hdr->src_addr;
 	unaligned_uint32_t *word_dst_addr = (unaligned_uint32_t *)&ipv6_hdr->dst_addr;
 
@@ -697,138 +736,248 @@ ipv6_hash(struct rte_ipv6_hdr *ipv6_hdr)
 			(word_src_addr[1] ^ word_dst_addr[1]) ^
 			(word_src_addr[2] ^ word_dst_addr[2]) ^
 			(word_src_addr[3] ^ word_dst_addr[3]);
+#endif
 }
 
+static inline uint16_t
+hash_to_member(uint32_t hash, uint16_t member_count)
+{
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
 
-void
-burst_xmit_l2_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+	return hash % member_count;
+}
+
+/*
+ * Fold the raw hashes of a burst and reduce them modulo the member count.
+ * The division is replaced by a multiplication with the reciprocal of the
+ * member count, so several packets are resolved per vector operation;
+ * the selected members are the same as with hash_to_member().
+ */
+static inline void
+hashes_to_members(const uint32_t *hashes, uint16_t nb_pkts,
 		uint16_t member_count, uint16_t *members)
 {
-	struct rte_ether_hdr *eth_hdr;
-	uint32_t hash;
-	int i;
+	uint16_t i = 0;
 
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-
-		hash = ether_hash(eth_hdr);
+	if (member_count == 1) {
+		memset(members, 0, sizeof(members[0]) * nb_pkts);
+		return;
+	}
 
-		members[i] = (hash ^= hash >> 8) % member_count;
+#if (defined(RTE_ARCH_X86) && defined(__SSE4_1__)) || defined(__ARM_NEON)
+	if (nb_pkts >= 8) {
+		const struct rte_reciprocal r = rte_reciprocal_value(member_count);
+#if defined(RTE_ARCH_X86)
+		const __m128i m = _mm_set1_epi32(r.m);
+		const __m128i d = _mm_set1_epi32(member_count);
+		const __m128i sh1 = _mm_cvtsi32_si128(r.sh1);
+		const __m128i sh2 = _mm_cvtsi32_si128(r.sh2);
+		__m128i h[2], t;
+		int j;
+
+		for (; i + 8 <= nb_pkts; i += 8) {
+			for (j = 0; j < 2; j++) {
+				h[j] = _mm_loadu_si128((const __m128i *)&hashes[i + 4 * j]);
+				h[j] = _mm_xor_si128(h[j], _mm_srli_epi32(h[j], 16));
+				h[j] = _mm_xor_si128(h[j], _mm_srli_epi32(h[j], 8));
+
+				/* t = (h * m) >> 32, even and odd lanes apart */
+				t = _mm_blend_epi16(
+					_mm_srli_epi64(_mm_mul_epu32(h[j], m), 32),
+					_mm_mul_epu32(_mm_srli_epi64(h[j], 32), m),
+					0xcc);
+				/* q = (t + ((h - t) >> sh1)) >> sh2 */
+				t = _mm_add_epi32(t,
+					_mm_srl_epi32(_mm_sub_epi32(h[j], t), sh1));
+				t = _mm_srl_epi32(t, sh2);
+				/* h - q * d */
+				h[j] = _mm_sub_epi32(h[j], _mm_mullo_epi32(t, d));
+			}
+			_mm_storeu_si128((__m128i *)&members[i],
+					_mm_packus_epi32(h[0], h[1]));
+		}
+#else
+		const uint32x2_t m = vdup_n_u32(r.m);
+		const int32x4_t sh1 = vdupq_n_s32(-(int32_t)r.sh1);
+		const int32x4_t sh2 = vdupq_n_s32(-(int32_t)r.sh2);
+		uint32x4_t h[2], t;
+		int j;
+
+		for (; i + 8 <= nb_pkts; i += 8) {
+			for (j = 0; j < 2; j++) {
+				h[j] = vld1q_u32(&hashes[i + 4 * j]);
+				h[j] = veorq_u32(h[j], vshrq_n_u32(h[j], 16));
+				h[j] = veorq_u32(h[j], vshrq_n_u32(h[j], 8));
+
+				/* t = (h * m) >> 32 */
+				t = vcombine_u32(
+					vshrn_n_u64(vmull_u32(vget_low_u32(h[j]), m), 32),
+					vshrn_n_u64(vmull_u32(vget_high_u32(h[j]), m), 32));
+				/* q = (t + ((h - t) >> sh1)) >> sh2 */
+				t = vaddq_u32(t, vshlq_u32(vsubq_u32(h[j], t), sh1));
+				t = vshlq_u32(t, sh2);
+				/* h - q * d */
+				h[j] = vmlsq_n_u32(h[j], t, member_count);
+			}
+			vst1q_u16(&members[i],
+				vcombine_u16(vmovn_u32(h[0]), vmovn_u32(h[1])));
+		}
+#endif
 	}
+#endif
+
+	for (; i < nb_pkts; i++)
+		members[i] = hash_to_member(hashes[i], member_count);
 }
 
-void
-burst_xmit_l23_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+l2_hash(struct rte_mbuf *buf)
+{
+	return ether_hash(rte_pktmbuf_mtod(buf, struct rte_ether_hdr *));
+}
+
+static inline uint32_t
+l23_hash(struct rte_mbuf *buf)
 {
-	uint16_t i;
 	struct rte_ether_hdr *eth_hdr;
 	uint16_t proto;
 	size_t vlan_offset;
-	uint32_t hash, l3hash;
-
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-		l3hash = 0;
+	uint32_t hash, l3hash = 0;
 
-		proto = eth_hdr->ether_type;
-		hash = ether_hash(eth_hdr);
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
 
-		vlan_offset = get_vlan_offset(eth_hdr, &proto);
+	proto = eth_hdr->ether_type;
+	hash = ether_hash(eth_hdr);
 
-		if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
-			struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv4_hash(ipv4_hdr);
+	vlan_offset = get_vlan_offset(eth_hdr, &proto);
 
-		} else if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
-			struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv6_hash(ipv6_hdr);
-		}
-
-		hash = hash ^ l3hash;
-		hash ^= hash >> 16;
-		hash ^= hash >> 8;
+	if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
+		struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv4_hash(ipv4_hdr);
 
-		members[i] = hash % member_count;
+	} else if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
+		struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv6_hash(ipv6_hdr);
 	}
+
+	return hash ^ l3hash;
 }
 
-void
-burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+l34_hash(struct rte_mbuf *buf)
 {
 	struct rte_ether_hdr *eth_hdr;
 	uint16_t proto;
 	size_t vlan_offset;
-	int i;
 
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_tcp_hdr *tcp_hdr;
-	uint32_t hash, l3hash, l4hash;
-
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-		size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf[i]);
-		proto = eth_hdr->ether_type;
-		vlan_offset = get_vlan_offset(eth_hdr, &proto);
-		l3hash = 0;
-		l4hash = 0;
-
-		if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
-			struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			size_t ip_hdr_offset;
-
-			l3hash = ipv4_hash(ipv4_hdr);
-
-			/* there is no L4 header in fragmented packet */
-			if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr)
-								== 0)) {
-				ip_hdr_offset = (ipv4_hdr->version_ihl
-					& RTE_IPV4_HDR_IHL_MASK) *
-					RTE_IPV4_IHL_MULTIPLIER;
-
-				if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
-					tcp_hdr = (struct rte_tcp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
-							<= pkt_end)
-						l4hash = HASH_L4_PORTS(tcp_hdr);
-				} else if (ipv4_hdr->next_proto_id ==
-								IPPROTO_UDP) {
-					udp_hdr = (struct rte_udp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)udp_hdr + sizeof(*udp_hdr)
-							< pkt_end)
-						l4hash = HASH_L4_PORTS(udp_hdr);
-				}
-			}
-		} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
-			struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv6_hash(ipv6_hdr);
-
-			if (ipv6_hdr->proto == IPPROTO_TCP) {
-				tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(tcp_hdr);
-			} else if (ipv6_hdr->proto == IPPROTO_UDP) {
-				udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(udp_hdr);
+	uint32_t l3hash = 0, l4hash = 0;
+
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
+	size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf);
+	proto = eth_hdr->ether_type;
+	vlan_offset = get_vlan_offset(eth_hdr, &proto);
+
+	if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
+		struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		size_t ip_hdr_offset;
+
+		l3hash = ipv4_hash(ipv4_hdr);
+
+		/* there is no L4 header in fragmented packet */
+		if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr) == 0)) {
+			ip_hdr_offset = (ipv4_hdr->version_ihl
+				& RTE_IPV4_HDR_IHL_MASK) *
+				RTE_IPV4_IHL_MULTIPLIER;
+
+			if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
+				tcp_hdr = (struct rte_tcp_hdr *)
+					((char *)ipv4_hdr + ip_hdr_offset);
+				if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
+						<= pkt_end)
+					l4hash = HASH_L4_PORTS(tcp_hdr);
+			} else if (ipv4_hdr->next_proto_id == IPPROTO_UDP) {
+				udp_hdr = (struct rte_udp_hdr *)
+					((char *)ipv4_hdr + ip_hdr_offset);
+				if ((size_t)udp_hdr + sizeof(*udp_hdr)
+						< pkt_end)
+					l4hash = HASH_L4_PORTS(udp_hdr);
 			}
 		}
+	} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
+		struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv6_hash(ipv6_hdr);
+
+		if (ipv6_hdr->proto == IPPROTO_TCP) {
+			tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(tcp_hdr);
+		} else if (ipv6_hdr->proto == IPPROTO_UDP) {
+			udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(udp_hdr);
+		}
+	}
 
-		hash = l3hash ^ l4hash;
-		hash ^= hash >> 16;
-		hash ^= hash >> 8;
+	return l3hash ^ l4hash;
+}
 
-		members[i] = hash % member_count;
+/*
+ * Hash the packets of a burst in chunks: headers of upcoming packets are
+ * prefetched while the current ones are parsed, then the members of the
+ * whole chunk are resolved together.
+ *
+ * Parsing stays per packet: header offsets differ with VLAN tags, IPv4
+ * options and fragments, so gathering fields into vector lanes would take
+ * more loads than it saves. Within a packet the address folds use wide
+ * loads, and the reduction of the chunk to members is vectorized.
+ */
+static __rte_always_inline void
+burst_xmit_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members,
+		uint32_t (*pkt_hash)(struct rte_mbuf *buf))
+{
+	uint32_t hashes[BOND_HASH_BURST];
+	uint16_t i, j, n;
+
+	bond_hash_prefetch(buf, nb_pkts);
+	for (i = 0; i < nb_pkts; i += n) {
+		n = RTE_MIN(nb_pkts - i, BOND_HASH_BURST);
+		for (j = 0; j < n; j++) {
+			if (i + j + BOND_HASH_PREFETCH < nb_pkts)
+				rte_prefetch0(rte_pktmbuf_mtod(
+					buf[i + j + BOND_HASH_PREFETCH], void *));
+			hashes[j] = pkt_hash(buf[i + j]);
+		}
+		hashes_to_members(hashes, n, member_count, &members[i]);
 	}
 }
 
+void
+burst_xmit_l2_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	burst_xmit_hash(buf, nb_pkts, member_count, members, l2_hash);
+}
+
+void
+burst_xmit_l23_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	burst_xmit_hash(buf, nb_pkts, member_count, members, l23_hash);
+}
+
+void
+burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	burst_xmit_hash(buf, nb_pkts, member_count, members, l34_hash);
+}
+
 struct bwg_member {
 	uint64_t bwg_left_int;
 	uint64_t bwg_left_remainder;
@@ -1622,7 +1771,15 @@ bond_ethdev_mode_set(struct rte_eth_dev *eth_dev, uint8_t mode)
 		if (bond_mode_8023ad_enable(eth_dev) != 0)
 			return -1;
 
-		if (internals->mode4.dedicated_queues.enabled == 0) {
+		if (internals->mode4.dedicated_queues.tx_only == 1) {
+			/* Control packets are sent by the mode 4 callback */
+			eth_dev->rx_pkt_burst = bond_ethdev_rx_burst_8023ad;
+			eth_dev->tx_pkt_burst =
+					bond_ethdev_tx_burst_8023ad_fast_queue;
+			RTE_BOND_LOG(WARNING,
+				"Using mode 4, it is necessary to do RX burst "
+				"at least every 100ms.");
+		} else if (internals->mode4.dedicated_queues.enabled == 0) {
 			eth_dev->rx_pkt_burst = bond_ethdev_rx_burst_8023ad;
 			eth_dev->tx_pkt_burst = bond_ethdev_tx_burst_8023ad;
 			RTE_BOND_LOG(WARNING,
@@ -1683,7 +1840,7 @@ member_configure_slow_queue(struct rte_eth_dev *bonding_eth_dev,
 		}
 	}
 
-	if (internals->mode4.dedicated_queues.enabled == 1) {
+	if (bond_mode_8023ad_dedicated_txq(&internals->mode4)) {
 		struct rte_eth_dev_info member_info = {};
 		uint16_t nb_rx_desc = SLOW_RX_QUEUE_HW_DEFAULT_SIZE;
 		uint16_t nb_tx_desc = SLOW_TX_QUEUE_HW_DEFAULT_SIZE;
@@ -1701,18 +1858,20 @@ member_configure_slow_queue(struct rte_eth_dev *bonding_eth_dev,
 		if (member_info.rx_desc_lim.nb_min != 0)
 			nb_rx_desc = member_info.rx_desc_lim.nb_min;
 
-		/* Configure slow Rx queue */
-		errval = rte_eth_rx_queue_setup(member_eth_dev->data->port_id,
+		/* Configure slow Rx queue, unless only Tx is dedicated */
+		if (internals->mode4.dedicated_queues.enabled == 1) {
+			errval = rte_eth_rx_queue_setup(member_eth_dev->data->port_id,
 				internals->mode4.dedicated_queues.rx_qid, nb_rx_desc,
 				rte_eth_dev_socket_id(member_eth_dev->data->port_id),
 				NULL, port->slow_pool);
-		if (errval != 0) {
-			RTE_BOND_LOG(ERR,
+			if (errval != 0) {
+				RTE_BOND_LOG(ERR,
 					"rte_eth_rx_queue_setup: port=%d queue_id %d, err (%d)",
 					member_eth_dev->data->port_id,
 					internals->mode4.dedicated_queues.rx_qid,
 					errval);
-			return errval;
+				return errval;
+			}
 		}
 
 		if (member_info.tx_desc_lim.nb_min != 0)
@@ -1790,10 +1949,10 @@ member_configure(struct rte_eth_dev *bonding_eth_dev,
 	nb_tx_queues = bonding_eth_dev->data->nb_tx_queues;
 
 	if (internals->mode == BONDING_MODE_8023AD) {
-		if (internals->mode4.dedicated_queues.enabled == 1) {
+		if (internals->mode4.dedicated_queues.enabled == 1)
 			nb_rx_queues++;
+		if (bond_mode_8023ad_dedicated_txq(&internals->mode4))
 			nb_tx_queues++;
-		}
 	}
 
 	/* Configure device */
@@ -1861,11 +2020,14 @@ member_start(struct rte_eth_dev *bonding_eth_dev,
 	}
 
 	if (internals->mode == BONDING_MODE_8023AD &&
-			internals->mode4.dedicated_queues.enabled == 1) {
+			bond_mode_8023ad_dedicated_txq(&internals->mode4)) {
 		if (member_configure_slow_queue(bonding_eth_dev, member_eth_dev)
 				!= 0)
 			return errval;
+	}
 
+	if (internals->mode == BONDING_MODE_8023AD &&
+			internals->mode4.dedicated_queues.enabled == 1) {
 		errval = bond_ethdev_8023ad_flow_verify(bonding_eth_dev,
 				member_port_id);
 		if (errval != 0) {
@@ -2056,7 +2218,7 @@ bond_ethdev_start(struct rte_eth_dev *eth_dev)
 	}
 
 	if (internals->mode == BONDING_MODE_8023AD) {
-		if (internals->mode4.dedicated_queues.enabled == 1) {
+		if (bond_mode_8023ad_dedicated_txq(&internals->mode4)) {
 			internals->mode4.dedicated_queues.rx_qid =
 					eth_dev->data->nb_rx_queues;
 			internals->mode4.dedicated_queues.tx_qid =
@@ -2341,10 +2503,11 @@ bond_ethdev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	 * If dedicated hw queues enabled for link bonding device in LACP mode
 	 * then we need to reduce the maximum number of data path queues by 1.
 	 */
-	if (internals->mode == BONDING_MODE_8023AD &&
-		internals->mode4.dedicated_queues.enabled == 1) {
-		dev_info->max_rx_queues--;
-		dev_info->max_tx_queues--;
+	if (internals->mode == BONDING_MODE_8023AD) {
+		if (internals->mode4.dedicated_queues.enabled == 1)
+			dev_info->max_rx_queues--;
+		if (bond_mode_8023ad_dedicated_txq(&internals->mode4))
+			dev_info->max_tx_queues--;
 	}
 
 	dev_info->min_rx_bufsize = 0;
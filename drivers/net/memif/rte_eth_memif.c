@@ -251,6 +251,19 @@ memif_get_buffer(struct pmd_process_private *proc_private, memif_desc_t *d)
 	return ((uint8_t *)proc_private->regions[d->region]->addr + d->offset);
 }
 
+/* Prefetch the packet buffers of 'n' slots starting at 'slot' */
+static __rte_always_inline void
+memif_prefetch_buffers(struct pmd_process_private *proc_private,
+		       memif_ring_t *ring, uint16_t slot, uint16_t mask,
+		       uint16_t n)
+{
+	uint16_t i;
+
+	for (i = 0; i < n; i++)
+		rte_prefetch0(memif_get_buffer(proc_private,
+					       &ring->desc[(slot + i) & mask]));
+}
+
 /* Free mbufs received by server */
 static void
 memif_free_stored_mbufs(struct pmd_process_private *proc_private, struct memif_queue *mq)
@@ -301,7 +314,7 @@ eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		rte_eth_devices[mq->in_port].process_private;
 	memif_ring_t *ring = memif_get_ring_from_queue(proc_private, mq);
 	uint16_t cur_slot, last_slot, n_slots, ring_size, mask, s0;
-	uint16_t pkts, rx_pkts, n_rx_pkts = 0;
+	uint16_t i, pkts, rx_pkts, n_rx_pkts = 0;
 	uint16_t mbuf_size = rte_pktmbuf_data_room_size(mq->mempool) -
 		RTE_PKTMBUF_HEADROOM;
 	uint16_t src_len, src_off, dst_len, dst_off, cp_len;
@@ -355,6 +368,45 @@ eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 		rx_pkts = 0;
 		pkts = nb_pkts < MAX_PKT_BURST ? nb_pkts : MAX_PKT_BURST;
+
+		/* Start fetching the whole burst before copying anything. */
+		memif_prefetch_buffers(proc_private, ring, cur_slot, mask,
+				       RTE_MIN(n_slots, pkts));
+		for (i = 0; i < pkts; i++)
+			rte_prefetch0(rte_pktmbuf_mtod(mbufs[i], void *));
+
+		/* Single-segment packets are copied in batches. */
+		while (n_slots >= MEMIF_COPY_BATCH &&
+		       rx_pkts + MEMIF_COPY_BATCH <= pkts) {
+			memif_desc_t *d[MEMIF_COPY_BATCH];
+			uint16_t flags = 0;
+
+			for (i = 0; i < MEMIF_COPY_BATCH; i++) {
+				d[i] = &ring->desc[(cur_slot + i) & mask];
+				flags |= d[i]->flags;
+			}
+			if (flags & MEMIF_DESC_FLAG_NEXT)
+				break;
+
+			for (i = 0; i < MEMIF_COPY_BATCH; i++) {
+				mbuf = mbufs[rx_pkts + i];
+				cp_len = d[i]->length;
+
+				mbuf->port = mq->in_port;
+				rte_pktmbuf_data_len(mbuf) = cp_len;
+				rte_pktmbuf_pkt_len(mbuf) = cp_len;
+				rte_memcpy(rte_pktmbuf_mtod(mbuf, void *),
+					memif_get_buffer(proc_private, d[i]), cp_len);
+				mq->n_bytes += cp_len;
+				*bufs++ = mbuf;
+			}
+
+			cur_slot += MEMIF_COPY_BATCH;
+			n_slots -= MEMIF_COPY_BATCH;
+			rx_pkts += MEMIF_COPY_BATCH;
+			n_rx_pkts += MEMIF_COPY_BATCH;
+		}
+
 		while (n_slots && rx_pkts < pkts) {
 			mbuf_head = mbufs[rx_pkts];
 			mbuf = mbuf_head;
@@ -705,6 +757,40 @@ eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	uint16_t mbuf_size = rte_pktmbuf_data_room_size(mp) - RTE_PKTMBUF_HEADROOM;
 	if (i == nb_pkts && pmd->cfg.pkt_buffer_size >= mbuf_size) {
 		buf_tmp = bufs;
+
+		/* Start fetching the whole burst before copying anything. */
+		memif_prefetch_buffers(proc_private, ring, slot, mask,
+				       RTE_MIN(n_free, nb_pkts));
+		for (i = 0; i < nb_pkts; i++)
+			rte_prefetch0(rte_pktmbuf_mtod(bufs[i], void *));
+
+		/* Single-segment packets are copied in batches. */
+		while (n_tx_pkts + MEMIF_COPY_BATCH <= nb_pkts &&
+		       n_free >= MEMIF_COPY_BATCH) {
+			uint16_t segs = 0;
+
+			for (i = 0; i < MEMIF_COPY_BATCH; i++)
+				segs |= bufs[i]->nb_segs;
+			if (segs != 1)
+				break;
+
+			for (i = 0; i < MEMIF_COPY_BATCH; i++) {
+				d0 = &ring->desc[(slot + i) & mask];
+				cp_len = rte_pktmbuf_data_len(bufs[i]);
+
+				rte_memcpy(memif_get_buffer(proc_private, d0),
+					rte_pktmbuf_mtod(bufs[i], void *), cp_len);
+				d0->length = cp_len;
+				d0->flags = 0;
+				mq->n_bytes += cp_len;
+			}
+
+			bufs += MEMIF_COPY_BATCH;
+			slot += MEMIF_COPY_BATCH;
+			n_free -= MEMIF_COPY_BATCH;
+			n_tx_pkts += MEMIF_COPY_BATCH;
+		}
+
 		while (n_tx_pkts < nb_pkts && n_free) {
 			mbuf_head = *bufs++;
 			nb_segs = mbuf_head->nb_segs;
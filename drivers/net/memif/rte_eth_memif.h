@@ -26,6 +26,7 @@
 #define ETH_MEMIF_SECRET_SIZE			24
 
 #define MAX_PKT_BURST				32
+#define MEMIF_COPY_BATCH			4
 
 extern int memif_logtype;
 #define RTE_LOGTYPE_MEMIF memif_logtype
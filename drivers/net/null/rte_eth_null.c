@@ -4,7 +4,11 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
 #include <rte_mbuf.h>
 #include <ethdev_driver.h>
 #include <ethdev_vdev.h>
@@ -13,10 +17,43 @@
 #include <bus_vdev_driver.h>
 #include <rte_kvargs.h>
 #include <rte_spinlock.h>
+#include <rte_tcp.h>
+#include <rte_thash.h>
+#include <rte_udp.h>
 
 #define ETH_NULL_PACKET_SIZE_ARG	"size"
 #define ETH_NULL_PACKET_COPY_ARG	"copy"
 #define ETH_NULL_PACKET_NO_RX_ARG	"no-rx"
+#define ETH_NULL_GEN_ARG		"gen"
+#define ETH_NULL_GEN_FLOWS_ARG		"flows"
+#define ETH_NULL_GEN_SIZES_ARG		"sizes"
+#define ETH_NULL_GEN_RSS_ARG		"rss"
+#define ETH_NULL_GEN_RATE_ARG		"rate"
+
+/* Maximum length of the expanded packet size pattern */
+#define NULL_GEN_MAX_SIZES	64
+/* Headers of the largest generated packet: Ethernet, IPv6 and TCP */
+#define NULL_GEN_MAX_HDR_LEN	(sizeof(struct rte_ether_hdr) + \
+		sizeof(struct rte_ipv6_hdr) + sizeof(struct rte_tcp_hdr))
+/* Preamble, inter-frame gap and FCS accounted for by the rate limiter */
+#define NULL_GEN_WIRE_OVERHEAD	24
+/* Simple IMIX: 7 x 64, 4 x 576 and 1 x 1500 bytes */
+#define NULL_GEN_IMIX		"64:7/576:4/1500:1"
+
+enum null_gen_type {
+	NULL_GEN_NONE,
+	NULL_GEN_IPV4_UDP,
+	NULL_GEN_IPV4_TCP,
+	NULL_GEN_IPV6_UDP,
+	NULL_GEN_IPV6_TCP,
+};
+
+static const char * const null_gen_names[] = {
+	[NULL_GEN_IPV4_UDP] = "ipv4-udp",
+	[NULL_GEN_IPV4_TCP] = "ipv4-tcp",
+	[NULL_GEN_IPV6_UDP] = "ipv6-udp",
+	[NULL_GEN_IPV6_TCP] = "ipv6-tcp",
+};
 
 static unsigned int default_packet_size = 64;
 static unsigned int default_packet_copy;
@@ -26,17 +63,38 @@ static const char *valid_arguments[] = {
 	ETH_NULL_PACKET_SIZE_ARG,
 	ETH_NULL_PACKET_COPY_ARG,
 	ETH_NULL_PACKET_NO_RX_ARG,
+	ETH_NULL_GEN_ARG,
+	ETH_NULL_GEN_FLOWS_ARG,
+	ETH_NULL_GEN_SIZES_ARG,
+	ETH_NULL_GEN_RSS_ARG,
+	ETH_NULL_GEN_RATE_ARG,
 	NULL
 };
 
 struct pmd_internals;
 
+/* Generated flow, the rest of the 5-tuple is taken from the template */
+struct null_gen_flow {
+	rte_be32_t src_addr;
+	rte_be16_t src_port;
+	uint32_t hash;
+	/* Raw sum of the L4 checksummed fields, length fields excluded */
+	uint32_t l4_sum;
+};
+
 struct null_queue {
 	struct pmd_internals *internals;
 
 	struct rte_mempool *mb_pool;
 	void *dummy_packet;
 
+	/* Flows steered to this queue in traffic generation mode */
+	struct null_gen_flow *flows;
+	uint32_t nb_flows;
+	uint32_t next_flow;
+	uint32_t next_size;
+	uint64_t next_tsc;
+
 	uint64_t rx_pkts;
 	uint64_t rx_bytes;
 
@@ -44,10 +102,21 @@ struct null_queue {
 	RTE_ATOMIC(uint64_t) tx_bytes;
 };
 
+struct null_gen_options {
+	enum null_gen_type type;
+	unsigned int nb_flows;
+	unsigned int rss;
+	/* Rate limit of each queue in Mbit/s, 0 for unlimited */
+	unsigned int rate;
+	uint16_t nb_sizes;
+	uint16_t sizes[NULL_GEN_MAX_SIZES];
+};
+
 struct pmd_options {
 	unsigned int packet_copy;
 	unsigned int packet_size;
 	unsigned int no_rx;
+	struct null_gen_options gen;
 };
 
 struct pmd_internals {
@@ -56,6 +125,15 @@ struct pmd_internals {
 	unsigned int no_rx;
 	uint16_t port_id;
 
+	/* Traffic generation mode */
+	struct null_gen_options gen;
+	/* TSC cycles each entry of the size pattern takes on the wire */
+	uint64_t gen_cycles[NULL_GEN_MAX_SIZES];
+	/* Raw sum of the L4 length fields of each entry of the size pattern */
+	uint32_t gen_len_sum[NULL_GEN_MAX_SIZES];
+	uint16_t gen_hdr_len;
+	uint8_t gen_hdr[NULL_GEN_MAX_HDR_LEN];
+
 	struct null_queue rx_null_queues[RTE_MAX_QUEUES_PER_PORT];
 	struct null_queue tx_null_queues[RTE_MAX_QUEUES_PER_PORT];
 
@@ -141,6 +219,138 @@ eth_null_no_rx(void *q __rte_unused, struct rte_mbuf **bufs __rte_unused,
 	return 0;
 }
 
+static inline bool
+null_gen_is_ipv4(enum null_gen_type type)
+{
+	return type == NULL_GEN_IPV4_UDP || type == NULL_GEN_IPV4_TCP;
+}
+
+static inline bool
+null_gen_is_udp(enum null_gen_type type)
+{
+	return type == NULL_GEN_IPV4_UDP || type == NULL_GEN_IPV6_UDP;
+}
+
+static uint16_t
+null_gen_hdr_len(enum null_gen_type type)
+{
+	return sizeof(struct rte_ether_hdr) +
+		(null_gen_is_ipv4(type) ? sizeof(struct rte_ipv4_hdr) :
+		 sizeof(struct rte_ipv6_hdr)) +
+		(null_gen_is_udp(type) ? sizeof(struct rte_udp_hdr) :
+		 sizeof(struct rte_tcp_hdr));
+}
+
+static inline void
+null_gen_fill(const struct pmd_internals *internals, struct rte_mbuf *m,
+		const struct null_gen_flow *flow, uint32_t size_idx)
+{
+	enum null_gen_type type = internals->gen.type;
+	uint8_t *pkt = rte_pktmbuf_mtod(m, uint8_t *);
+	uint16_t len = internals->gen.sizes[size_idx];
+	uint16_t l3_off = sizeof(struct rte_ether_hdr);
+	uint16_t l4_off, cksum;
+
+	rte_memcpy(pkt, internals->gen_hdr, internals->gen_hdr_len);
+	/* The L4 checksums account for a zero payload */
+	memset(pkt + internals->gen_hdr_len, 0, len - internals->gen_hdr_len);
+	cksum = ~__rte_raw_cksum_reduce(flow->l4_sum +
+			internals->gen_len_sum[size_idx]);
+
+	if (null_gen_is_ipv4(type)) {
+		struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(pkt + l3_off);
+
+		ip->total_length = rte_cpu_to_be_16(len - l3_off);
+		ip->src_addr = flow->src_addr;
+		ip->hdr_checksum = rte_ipv4_cksum(ip);
+		l4_off = l3_off + sizeof(*ip);
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4;
+	} else {
+		struct rte_ipv6_hdr *ip = (struct rte_ipv6_hdr *)(pkt + l3_off);
+
+		ip->payload_len = rte_cpu_to_be_16(len - l3_off - sizeof(*ip));
+		memcpy(&ip->src_addr.a[12], &flow->src_addr,
+				sizeof(flow->src_addr));
+		l4_off = l3_off + sizeof(*ip);
+		m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6;
+	}
+
+	if (null_gen_is_udp(type)) {
+		struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(pkt + l4_off);
+
+		udp->src_port = flow->src_port;
+		udp->dgram_len = rte_cpu_to_be_16(len - l4_off);
+		udp->dgram_cksum = cksum == 0 ? 0xffff : cksum;
+		m->packet_type |= RTE_PTYPE_L4_UDP;
+	} else {
+		struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)(pkt + l4_off);
+
+		tcp->src_port = flow->src_port;
+		tcp->cksum = cksum;
+		m->packet_type |= RTE_PTYPE_L4_TCP;
+	}
+
+	m->data_len = len;
+	m->pkt_len = len;
+	m->port = internals->port_id;
+	if (internals->gen.rss) {
+		m->hash.rss = flow->hash;
+		m->ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+	}
+}
+
+static uint16_t
+eth_null_gen_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct null_queue *h = q;
+	const struct pmd_internals *internals = h->internals;
+	const struct null_gen_options *gen = &internals->gen;
+	uint64_t next_tsc = h->next_tsc;
+	uint32_t next_size = h->next_size;
+	uint64_t bytes = 0;
+	uint16_t i;
+
+	if (unlikely(h->nb_flows == 0))
+		return 0;
+
+	if (gen->rate != 0) {
+		uint64_t now = rte_rdtsc();
+
+		/* Do not make up for more than a millisecond of idle time. */
+		if (next_tsc + rte_get_tsc_hz() / 1000 < now)
+			next_tsc = now;
+
+		for (i = 0; i < nb_bufs && next_tsc <= now; i++) {
+			next_tsc += internals->gen_cycles[next_size];
+			if (++next_size == gen->nb_sizes)
+				next_size = 0;
+		}
+		if (i == 0)
+			return 0;
+		nb_bufs = i;
+		next_size = h->next_size;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(h->mb_pool, bufs, nb_bufs) != 0)
+		return 0;
+
+	for (i = 0; i < nb_bufs; i++) {
+		null_gen_fill(internals, bufs[i], &h->flows[h->next_flow], next_size);
+		bytes += gen->sizes[next_size];
+
+		if (++next_size == gen->nb_sizes)
+			next_size = 0;
+		if (++h->next_flow == h->nb_flows)
+			h->next_flow = 0;
+	}
+
+	h->next_size = next_size;
+	h->next_tsc = next_tsc;
+	h->rx_pkts += nb_bufs;
+	h->rx_bytes += bytes;
+	return nb_bufs;
+}
+
 static uint16_t
 eth_null_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
@@ -179,19 +389,237 @@ eth_null_copy_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 }
 
 static int
-eth_dev_configure(struct rte_eth_dev *dev __rte_unused)
+eth_dev_configure(struct rte_eth_dev *dev)
 {
+	struct pmd_internals *internals = dev->data->dev_private;
+	uint16_t nb_queues = RTE_MAX(dev->data->nb_rx_queues, 1);
+	uint16_t i;
+
+	/* Default redirection table spreading hashes round-robin */
+	rte_spinlock_lock(&internals->rss_lock);
+	for (i = 0; i < internals->reta_size; i++) {
+		struct rte_eth_rss_reta_entry64 *reta_conf =
+			&internals->reta_conf[i / RTE_ETH_RETA_GROUP_SIZE];
+
+		reta_conf->mask = UINT64_MAX;
+		reta_conf->reta[i % RTE_ETH_RETA_GROUP_SIZE] = i % nb_queues;
+	}
+	rte_spinlock_unlock(&internals->rss_lock);
+
+	return 0;
+}
+
+/* Base addresses of the generated flows, from the benchmarking ranges */
+#define NULL_GEN_IPV4_SRC	RTE_IPV4(198, 18, 0, 1)
+#define NULL_GEN_IPV4_DST	RTE_IPV4(198, 19, 0, 1)
+#define NULL_GEN_IPV6_SRC	RTE_IPV6(0x2001, 0x2, 0, 0, 0, 0, 0, 1)
+#define NULL_GEN_IPV6_DST	RTE_IPV6(0x2001, 0x2, 0, 1, 0, 0, 0, 1)
+#define NULL_GEN_SRC_PORT	1024
+#define NULL_GEN_DST_PORT	9
+
+static void
+null_gen_build_hdr(struct pmd_internals *internals)
+{
+	static const struct rte_ether_addr src_mac = {
+		.addr_bytes = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 }
+	};
+	enum null_gen_type type = internals->gen.type;
+	uint8_t *hdr = internals->gen_hdr;
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)hdr;
+	uint16_t off = sizeof(*eth);
+	uint8_t proto;
+
+	memset(hdr, 0, sizeof(internals->gen_hdr));
+	proto = null_gen_is_udp(type) ? IPPROTO_UDP : IPPROTO_TCP;
+
+	rte_ether_addr_copy(&internals->eth_addr, &eth->dst_addr);
+	rte_ether_addr_copy(&src_mac, &eth->src_addr);
+
+	if (null_gen_is_ipv4(type)) {
+		struct rte_ipv4_hdr *ip = (struct rte_ipv4_hdr *)(hdr + off);
+
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+		ip->version_ihl = RTE_IPV4_VHL_DEF;
+		ip->time_to_live = 64;
+		ip->next_proto_id = proto;
+		ip->src_addr = RTE_BE32(NULL_GEN_IPV4_SRC);
+		ip->dst_addr = RTE_BE32(NULL_GEN_IPV4_DST);
+		off += sizeof(*ip);
+	} else {
+		struct rte_ipv6_hdr *ip = (struct rte_ipv6_hdr *)(hdr + off);
+		const struct rte_ipv6_addr src = NULL_GEN_IPV6_SRC;
+		const struct rte_ipv6_addr dst = NULL_GEN_IPV6_DST;
+
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV6);
+		ip->vtc_flow = RTE_BE32(6 << 28);
+		ip->proto = proto;
+		ip->hop_limits = 64;
+		ip->src_addr = src;
+		ip->dst_addr = dst;
+		off += sizeof(*ip);
+	}
+
+	if (null_gen_is_udp(type)) {
+		struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(hdr + off);
+
+		udp->dst_port = RTE_BE16(NULL_GEN_DST_PORT);
+		off += sizeof(*udp);
+	} else {
+		struct rte_tcp_hdr *tcp = (struct rte_tcp_hdr *)(hdr + off);
+
+		tcp->dst_port = RTE_BE16(NULL_GEN_DST_PORT);
+		tcp->sent_seq = RTE_BE32(1);
+		tcp->data_off = (sizeof(*tcp) / 4) << 4;
+		tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+		tcp->rx_win = RTE_BE16(UINT16_MAX);
+		off += sizeof(*tcp);
+	}
+
+	internals->gen_hdr_len = off;
+}
+
+static void
+null_gen_flow_init(const struct pmd_internals *internals, uint32_t id,
+		struct null_gen_flow *flow)
+{
+	const uint8_t *l3 = internals->gen_hdr + sizeof(struct rte_ether_hdr);
+	enum null_gen_type type = internals->gen.type;
+	union rte_thash_tuple tuple;
+	uint32_t tuple_len, sum;
+	const uint8_t *l4;
+	uint16_t l4_len;
+	uint16_t dport;
+
+	/* Flows differ by source address and port. */
+	if (null_gen_is_ipv4(type))
+		flow->src_addr = rte_cpu_to_be_32(NULL_GEN_IPV4_SRC + id);
+	else
+		flow->src_addr = rte_cpu_to_be_32(1 + id);
+	flow->src_port = rte_cpu_to_be_16(NULL_GEN_SRC_PORT +
+			id % (UINT16_MAX + 1 - NULL_GEN_SRC_PORT));
+	dport = NULL_GEN_DST_PORT;
+
+	if (null_gen_is_ipv4(type)) {
+		const struct rte_ipv4_hdr *ip = (const struct rte_ipv4_hdr *)l3;
+
+		tuple.v4.src_addr = rte_be_to_cpu_32(flow->src_addr);
+		tuple.v4.dst_addr = rte_be_to_cpu_32(ip->dst_addr);
+		tuple.v4.sport = rte_be_to_cpu_16(flow->src_port);
+		tuple.v4.dport = dport;
+		tuple_len = RTE_THASH_V4_L4_LEN;
+	} else {
+		const struct rte_ipv6_hdr *ip = (const struct rte_ipv6_hdr *)l3;
+		uint32_t *words = (uint32_t *)&tuple.v6;
+		unsigned int i;
+
+		tuple.v6.src_addr = ip->src_addr;
+		memcpy(&tuple.v6.src_addr.a[12], &flow->src_addr,
+				sizeof(flow->src_addr));
+		tuple.v6.dst_addr = ip->dst_addr;
+		for (i = 0; i < RTE_THASH_V6_L3_LEN; i++)
+			words[i] = rte_be_to_cpu_32(words[i]);
+		tuple.v6.sport = rte_be_to_cpu_16(flow->src_port);
+		tuple.v6.dport = dport;
+		tuple_len = RTE_THASH_V6_L4_LEN;
+	}
+
+	flow->hash = rte_softrss((uint32_t *)&tuple, tuple_len,
+			internals->rss_key);
+
+	/* Pseudo header addresses and protocol, then L4 header of the
+	 * template with zero lengths and checksum.
+	 */
+	if (null_gen_is_ipv4(type)) {
+		const struct rte_ipv4_hdr *ip = (const struct rte_ipv4_hdr *)l3;
+
+		sum = rte_raw_cksum(&flow->src_addr, sizeof(flow->src_addr)) +
+			rte_raw_cksum(&ip->dst_addr, sizeof(ip->dst_addr)) +
+			rte_cpu_to_be_16(ip->next_proto_id);
+		l4 = l3 + sizeof(*ip);
+	} else {
+		const struct rte_ipv6_hdr *ip = (const struct rte_ipv6_hdr *)l3;
+
+		sum = rte_raw_cksum(&ip->src_addr, 12) +
+			rte_raw_cksum(&flow->src_addr, sizeof(flow->src_addr)) +
+			rte_raw_cksum(&ip->dst_addr, sizeof(ip->dst_addr)) +
+			rte_cpu_to_be_16(ip->proto);
+		l4 = l3 + sizeof(*ip);
+	}
+	l4_len = internals->gen_hdr_len - (l4 - internals->gen_hdr);
+	/* Source port first in both UDP and TCP headers */
+	sum += rte_raw_cksum(&flow->src_port, sizeof(flow->src_port)) +
+		rte_raw_cksum(l4 + sizeof(flow->src_port),
+			l4_len - sizeof(flow->src_port));
+	flow->l4_sum = __rte_raw_cksum_reduce(sum);
+}
+
+/*
+ * Spread the flows over the Rx queues. With RSS the flows are steered by
+ * the redirection table, else round-robin.
+ */
+static int
+null_gen_flows_init(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	uint16_t nb_queues = dev->data->nb_rx_queues;
+	uint32_t nb_flows = internals->gen.nb_flows;
+	struct null_gen_flow flow;
+	uint16_t q;
+	uint32_t i;
+
+	for (q = 0; q < nb_queues; q++) {
+		struct null_queue *h = &internals->rx_null_queues[q];
+
+		rte_free(h->flows);
+		h->flows = rte_malloc_socket(NULL, nb_flows * sizeof(flow), 0,
+				dev->data->numa_node);
+		if (h->flows == NULL)
+			return -ENOMEM;
+		h->nb_flows = 0;
+		h->next_flow = 0;
+		/* Queues start at different sizes of the pattern. */
+		h->next_size = q % internals->gen.nb_sizes;
+		h->next_tsc = 0;
+	}
+
+	rte_spinlock_lock(&internals->rss_lock);
+	for (i = 0; i < nb_flows; i++) {
+		struct null_queue *h;
+		uint16_t idx;
+
+		null_gen_flow_init(internals, i, &flow);
+		if (internals->gen.rss) {
+			idx = flow.hash % internals->reta_size;
+			q = internals->reta_conf[idx / RTE_ETH_RETA_GROUP_SIZE]
+				.reta[idx % RTE_ETH_RETA_GROUP_SIZE];
+		} else {
+			q = i % nb_queues;
+		}
+		h = &internals->rx_null_queues[q];
+		h->flows[h->nb_flows++] = flow;
+	}
+	rte_spinlock_unlock(&internals->rss_lock);
+
 	return 0;
 }
 
 static int
 eth_dev_start(struct rte_eth_dev *dev)
 {
+	struct pmd_internals *internals;
 	uint16_t i;
 
 	if (dev == NULL)
 		return -EINVAL;
 
+	internals = dev->data->dev_private;
+	if (internals->gen.type != NULL_GEN_NONE) {
+		int ret = null_gen_flows_init(dev);
+
+		if (ret < 0)
+			return ret;
+	}
+
 	dev->data->dev_link.link_status = RTE_ETH_LINK_UP;
 
 	for (i = 0; i < dev->data->nb_rx_queues; i++)
@@ -241,6 +669,20 @@ eth_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
 
 	packet_size = internals->packet_size;
 
+	if (internals->gen.type != NULL_GEN_NONE) {
+		uint16_t max_len = 0;
+		uint16_t i;
+
+		for (i = 0; i < internals->gen.nb_sizes; i++)
+			max_len = RTE_MAX(max_len, internals->gen.sizes[i]);
+		if (max_len > rte_pktmbuf_data_room_size(mb_pool) -
+				RTE_PKTMBUF_HEADROOM) {
+			PMD_LOG(ERR, "Mbufs too small for %u bytes packets",
+				max_len);
+			return -EINVAL;
+		}
+	}
+
 	internals->rx_null_queues[rx_queue_id].mb_pool = mb_pool;
 	dev->data->rx_queues[rx_queue_id] =
 		&internals->rx_null_queues[rx_queue_id];
@@ -387,6 +829,9 @@ eth_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	rte_free(nq->dummy_packet);
+	rte_free(nq->flows);
+	nq->flows = NULL;
+	nq->nb_flows = 0;
 }
 
 static void
@@ -574,6 +1019,28 @@ eth_dev_null_create(struct rte_vdev_device *dev, struct pmd_options *args)
 	internals->port_id = eth_dev->data->port_id;
 	rte_eth_random_addr(internals->eth_addr.addr_bytes);
 
+	internals->gen = args->gen;
+	if (internals->gen.type != NULL_GEN_NONE) {
+		unsigned int i;
+
+		null_gen_build_hdr(internals);
+		for (i = 0; i < internals->gen.nb_sizes; i++) {
+			uint16_t l4_len = internals->gen.sizes[i] -
+				sizeof(struct rte_ether_hdr) -
+				(null_gen_is_ipv4(internals->gen.type) ?
+				 sizeof(struct rte_ipv4_hdr) :
+				 sizeof(struct rte_ipv6_hdr));
+
+			/* Pseudo header length, and UDP header length */
+			internals->gen_len_sum[i] = rte_cpu_to_be_16(l4_len) *
+				(null_gen_is_udp(internals->gen.type) ? 2 : 1);
+			if (internals->gen.rate != 0)
+				internals->gen_cycles[i] = (uint64_t)(internals->gen.sizes[i] +
+						NULL_GEN_WIRE_OVERHEAD) * CHAR_BIT *
+					rte_get_tsc_hz() / internals->gen.rate / 1000000;
+		}
+	}
+
 	internals->flow_type_rss_offloads =  RTE_ETH_RSS_PROTO_MASK;
 	internals->reta_size = RTE_DIM(internals->reta_conf) * RTE_ETH_RETA_GROUP_SIZE;
 
@@ -591,7 +1058,10 @@ eth_dev_null_create(struct rte_vdev_device *dev, struct pmd_options *args)
 	eth_dev->dev_ops = &ops;
 
 	/* finally assign rx and tx ops */
-	if (internals->packet_copy) {
+	if (internals->gen.type != NULL_GEN_NONE) {
+		eth_dev->rx_pkt_burst = eth_null_gen_rx;
+		eth_dev->tx_pkt_burst = eth_null_tx;
+	} else if (internals->packet_copy) {
 		eth_dev->rx_pkt_burst = eth_null_copy_rx;
 		eth_dev->tx_pkt_burst = eth_null_copy_tx;
 	} else if (internals->no_rx) {
@@ -658,6 +1128,196 @@ get_packet_no_rx_arg(const char *key __rte_unused,
 	return 0;
 }
 
+static int
+get_gen_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	enum null_gen_type *type = extra_args;
+	unsigned int i;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	for (i = 0; i < RTE_DIM(null_gen_names); i++) {
+		if (null_gen_names[i] != NULL &&
+				strcmp(value, null_gen_names[i]) == 0) {
+			*type = i;
+			return 0;
+		}
+	}
+
+	PMD_LOG(ERR, "Unknown traffic type %s", value);
+	return -1;
+}
+
+static int
+get_uint_arg(const char *key, const char *value, void *extra_args)
+{
+	unsigned long v;
+	char *end;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	errno = 0;
+	v = strtoul(value, &end, 0);
+	if (errno != 0 || *end != '\0' || v > UINT_MAX) {
+		PMD_LOG(ERR, "Invalid %s value %s", key, value);
+		return -1;
+	}
+
+	*(unsigned int *)extra_args = v;
+	return 0;
+}
+
+/*
+ * Parse "<len>[:<weight>][/<len>[:<weight>]...]" and expand it to a
+ * pattern interleaving sizes by smooth weighted round-robin.
+ */
+static int
+get_gen_sizes_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	struct null_gen_options *gen = extra_args;
+	unsigned int weights[NULL_GEN_MAX_SIZES];
+	uint16_t lens[NULL_GEN_MAX_SIZES];
+	int current[NULL_GEN_MAX_SIZES] = { 0 };
+	unsigned int i, n = 0, total = 0;
+	const char *p;
+
+	if (value == NULL || extra_args == NULL)
+		return -EINVAL;
+
+	if (strcmp(value, "imix") == 0)
+		value = NULL_GEN_IMIX;
+
+	for (p = value; *p != '\0'; p++) {
+		unsigned long len, weight = 1;
+		char *end;
+
+		if (n == NULL_GEN_MAX_SIZES)
+			goto error;
+		len = strtoul(p, &end, 10);
+		if (end == p || len == 0 || len > UINT16_MAX)
+			goto error;
+		p = end;
+		if (*p == ':') {
+			weight = strtoul(p + 1, &end, 10);
+			if (end == p + 1 || weight == 0)
+				goto error;
+			p = end;
+		}
+		if (*p != '/' && *p != '\0')
+			goto error;
+
+		total += RTE_MIN(weight, NULL_GEN_MAX_SIZES + 1UL);
+		if (total > NULL_GEN_MAX_SIZES)
+			goto error;
+		lens[n] = len;
+		weights[n] = weight;
+		n++;
+		if (*p == '\0')
+			break;
+	}
+	if (n == 0)
+		goto error;
+
+	for (gen->nb_sizes = 0; gen->nb_sizes < total; gen->nb_sizes++) {
+		unsigned int best = 0;
+
+		for (i = 0; i < n; i++) {
+			current[i] += weights[i];
+			if (current[i] > current[best])
+				best = i;
+		}
+		current[best] -= total;
+		gen->sizes[gen->nb_sizes] = lens[best];
+	}
+
+	return 0;
+
+error:
+	PMD_LOG(ERR, "Invalid packet sizes %s, at most %u weighted sizes",
+		value, NULL_GEN_MAX_SIZES);
+	return -1;
+}
+
+static int
+null_gen_args_process(struct rte_kvargs *kvlist, struct pmd_options *args)
+{
+	struct null_gen_options *gen = &args->gen;
+	uint16_t hdr_len;
+	unsigned int i;
+	int ret;
+
+	ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_ARG, &get_gen_arg,
+			&gen->type);
+	if (ret < 0)
+		return ret;
+	ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_FLOWS_ARG, &get_uint_arg,
+			&gen->nb_flows);
+	if (ret < 0)
+		return ret;
+	ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_SIZES_ARG,
+			&get_gen_sizes_arg, gen);
+	if (ret < 0)
+		return ret;
+	ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_RSS_ARG, &get_uint_arg,
+			&gen->rss);
+	if (ret < 0)
+		return ret;
+	ret = rte_kvargs_process(kvlist, ETH_NULL_GEN_RATE_ARG, &get_uint_arg,
+			&gen->rate);
+	if (ret < 0)
+		return ret;
+
+	if (gen->type == NULL_GEN_NONE) {
+		if (rte_kvargs_count(kvlist, ETH_NULL_GEN_FLOWS_ARG) +
+				rte_kvargs_count(kvlist, ETH_NULL_GEN_SIZES_ARG) +
+				rte_kvargs_count(kvlist, ETH_NULL_GEN_RSS_ARG) +
+				rte_kvargs_count(kvlist, ETH_NULL_GEN_RATE_ARG) != 0) {
+			PMD_LOG(ERR, "Traffic arguments need %s",
+				ETH_NULL_GEN_ARG);
+			return -1;
+		}
+		return 0;
+	}
+
+	if (args->packet_copy || args->no_rx) {
+		PMD_LOG(ERR, "%s can't be used with %s or %s",
+			ETH_NULL_GEN_ARG, ETH_NULL_PACKET_COPY_ARG,
+			ETH_NULL_PACKET_NO_RX_ARG);
+		return -1;
+	}
+
+	if (gen->nb_flows == 0 || gen->nb_flows > UINT16_MAX + 1) {
+		PMD_LOG(ERR, "Number of flows must be within 1 and %u",
+			UINT16_MAX + 1);
+		return -1;
+	}
+
+	/* Without a size pattern, all packets have the configured size. */
+	if (gen->nb_sizes == 0) {
+		if (args->packet_size > UINT16_MAX) {
+			PMD_LOG(ERR, "Packet size %u too large",
+				args->packet_size);
+			return -1;
+		}
+		gen->sizes[gen->nb_sizes++] = args->packet_size;
+	}
+
+	hdr_len = null_gen_hdr_len(gen->type);
+	for (i = 0; i < gen->nb_sizes; i++) {
+		if (gen->sizes[i] < hdr_len) {
+			PMD_LOG(ERR, "%s packets need at least %u bytes",
+				null_gen_names[gen->type], hdr_len);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int
 rte_pmd_null_probe(struct rte_vdev_device *dev)
 {
@@ -666,6 +1326,10 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 		.packet_copy = default_packet_copy,
 		.packet_size = default_packet_size,
 		.no_rx = default_no_rx,
+		.gen = {
+			.type = NULL_GEN_NONE,
+			.nb_flows = 1,
+		},
 	};
 	struct rte_kvargs *kvlist = NULL;
 	struct rte_eth_dev *eth_dev;
@@ -689,7 +1353,10 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 		eth_dev->dev_ops = &ops;
 		eth_dev->device = &dev->device;
 		internals = eth_dev->data->dev_private;
-		if (internals->packet_copy) {
+		if (internals->gen.type != NULL_GEN_NONE) {
+			eth_dev->rx_pkt_burst = eth_null_gen_rx;
+			eth_dev->tx_pkt_burst = eth_null_tx;
+		} else if (internals->packet_copy) {
 			eth_dev->rx_pkt_burst = eth_null_copy_rx;
 			eth_dev->tx_pkt_burst = eth_null_copy_tx;
 		} else if (internals->no_rx) {
@@ -734,6 +1401,10 @@ rte_pmd_null_probe(struct rte_vdev_device *dev)
 				ETH_NULL_PACKET_NO_RX_ARG);
 			goto free_kvlist;
 		}
+
+		ret = null_gen_args_process(kvlist, &args);
+		if (ret < 0)
+			goto free_kvlist;
 	}
 
 	PMD_LOG(INFO, "Configure pmd_null: packet size is %d, "
@@ -776,4 +1447,9 @@ RTE_PMD_REGISTER_ALIAS(net_null, eth_null);
 RTE_PMD_REGISTER_PARAM_STRING(net_null,
 	"size=<int> "
 	"copy=<int> "
-	ETH_NULL_PACKET_NO_RX_ARG "=0|1");
+	ETH_NULL_PACKET_NO_RX_ARG "=0|1 "
+	ETH_NULL_GEN_ARG "=ipv4-udp|ipv4-tcp|ipv6-udp|ipv6-tcp "
+	ETH_NULL_GEN_FLOWS_ARG "=<int> "
+	ETH_NULL_GEN_SIZES_ARG "=imix|<len>[:<weight>][/...] "
+	ETH_NULL_GEN_RSS_ARG "=0|1 "
+	ETH_NULL_GEN_RATE_ARG "=<Mbps>");
@@ -4,6 +4,7 @@
  * All rights reserved.
  */
 
+#include <errno.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -20,6 +21,7 @@
 #include <rte_os_shim.h>
 
 #include "pcap_osdep.h"
+#include "pcap_replay.h"
 
 #define RTE_ETH_PCAP_SNAPSHOT_LEN 65535
 #define RTE_ETH_PCAP_SNAPLEN RTE_ETHER_MAX_JUMBO_FRAME_LEN
@@ -34,6 +36,8 @@
 #define ETH_PCAP_IFACE_ARG    "iface"
 #define ETH_PCAP_PHY_MAC_ARG  "phy_mac"
 #define ETH_PCAP_INFINITE_RX_ARG  "infinite_rx"
+#define ETH_PCAP_REPLAY_SPEED_ARG "replay_speed"
+#define ETH_PCAP_REPLAY_QUEUES_ARG "replay_queues"
 
 #define ETH_PCAP_ARG_MAXLEN	64
 
@@ -75,6 +79,9 @@ struct pcap_rx_queue {
 
 	/* Contains pre-generated packets to be looped through */
 	struct rte_ring *pkts;
+
+	/* Packets replayed from the mmap'ed file */
+	struct pcap_replay *replay;
 };
 
 struct pcap_tx_queue {
@@ -94,6 +101,9 @@ struct pmd_internals {
 	int single_iface;
 	int phy_mac;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	unsigned int replay_queues;
+	double replay_speed;
 };
 
 struct pmd_process_private {
@@ -122,6 +132,9 @@ struct pmd_devargs_all {
 	unsigned int is_rx_pcap;
 	unsigned int is_rx_iface;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	unsigned int replay_queues;
+	double replay_speed;
 };
 
 static const char *valid_arguments[] = {
@@ -133,6 +146,8 @@ static const char *valid_arguments[] = {
 	ETH_PCAP_IFACE_ARG,
 	ETH_PCAP_PHY_MAC_ARG,
 	ETH_PCAP_INFINITE_RX_ARG,
+	ETH_PCAP_REPLAY_SPEED_ARG,
+	ETH_PCAP_REPLAY_QUEUES_ARG,
 	NULL
 };
 
@@ -270,6 +285,98 @@ eth_pcap_rx_infinite(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return i;
 }
 
+static uint16_t
+eth_pcap_rx_replay(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pcap_rx_queue *pcap_q = queue;
+	struct pcap_replay *replay = pcap_q->replay;
+	struct rte_mbuf *tails[PCAP_REPLAY_MAX_BURST];
+	uint32_t idx = replay->next;
+	uint32_t next = replay->next;
+	uint64_t base = replay->base;
+	uint64_t now = 0;
+	uint32_t rx_bytes = 0;
+	uint16_t i, nb_rx = 0, nb_tails = 0;
+
+	if (unlikely(nb_pkts == 0 || replay->nb_pkts == 0))
+		return 0;
+	nb_pkts = RTE_MIN(nb_pkts, PCAP_REPLAY_MAX_BURST);
+
+	if (replay->paced)
+		now = rte_get_timer_cycles();
+
+	/* Count the packets that are due, wrapping around in infinite mode. */
+	while (nb_rx < nb_pkts) {
+		if (next == replay->nb_pkts) {
+			if (!replay->loop)
+				break;
+			next = 0;
+			base += replay->period;
+		}
+		if (replay->paced && base + replay->pkts[next].due > now)
+			break;
+		if (replay->pkts[next].mbuf->data_len > PCAP_REPLAY_HDR_LEN)
+			nb_tails++;
+		next++;
+		nb_rx++;
+	}
+
+	if (nb_rx == 0)
+		return 0;
+
+	if (rte_pktmbuf_alloc_bulk(pcap_q->mb_pool, bufs, nb_rx) != 0) {
+		pcap_q->rx_stat.rx_nombuf += nb_rx;
+		return 0;
+	}
+	if (nb_tails != 0 &&
+			rte_pktmbuf_alloc_bulk(pcap_q->mb_pool, tails, nb_tails) != 0) {
+		rte_pktmbuf_free_bulk(bufs, nb_rx);
+		pcap_q->rx_stat.rx_nombuf += nb_rx;
+		return 0;
+	}
+
+	/*
+	 * Copy the headers, and attach the rest of longer packets to their
+	 * template so that the payload is not copied.
+	 */
+	nb_tails = 0;
+	for (i = 0; i < nb_rx; i++) {
+		struct pcap_replay_pkt *pkt;
+		struct rte_mbuf *m = bufs[i];
+		uint16_t len;
+
+		if (idx == replay->nb_pkts)
+			idx = 0;
+		pkt = &replay->pkts[idx++];
+
+		len = RTE_MIN(pkt->mbuf->data_len, PCAP_REPLAY_HDR_LEN);
+		rte_memcpy(rte_pktmbuf_mtod(m, void *),
+				rte_pktmbuf_mtod(pkt->mbuf, void *), len);
+		m->data_len = len;
+		m->pkt_len = pkt->mbuf->data_len;
+		if (len < pkt->mbuf->data_len) {
+			struct rte_mbuf *tail = tails[nb_tails++];
+
+			rte_pktmbuf_attach(tail, pkt->mbuf);
+			rte_pktmbuf_adj(tail, len);
+			m->next = tail;
+			m->nb_segs = 2;
+		}
+		m->port = pcap_q->port_id;
+		*RTE_MBUF_DYNFIELD(m, timestamp_dynfield_offset,
+				rte_mbuf_timestamp_t *) = pkt->ts_us;
+		m->ol_flags |= timestamp_rx_dynflag;
+		rx_bytes += m->pkt_len;
+	}
+	replay->next = next;
+	replay->base = base;
+
+	pcap_q->rx_stat.pkts += nb_rx;
+	pcap_q->rx_stat.bytes += rx_bytes;
+
+	return nb_rx;
+}
+
 static uint16_t
 eth_pcap_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -644,6 +751,19 @@ eth_dev_start(struct rte_eth_dev *dev)
 		}
 	}
 
+	/* Replayed queues share a common start to stay in step */
+	if (internals->replay) {
+		uint64_t now = rte_get_timer_cycles();
+
+		for (i = 0; i < dev->data->nb_rx_queues; i++) {
+			rx = &internals->rx_queue[i];
+			if (rx->replay != NULL)
+				pcap_replay_start(rx->replay, now);
+		}
+
+		goto status_up;
+	}
+
 	/* If not open already, open rx pcaps */
 	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		rx = &internals->rx_queue[i];
@@ -863,6 +983,16 @@ eth_dev_close(struct rte_eth_dev *dev)
 		}
 	}
 
+	/* Templates still in use by the application are left allocated. */
+	if (internals->replay) {
+		for (i = 0; i < dev->data->nb_rx_queues; i++) {
+			struct pcap_rx_queue *pcap_q = &internals->rx_queue[i];
+
+			pcap_replay_free(pcap_q->replay);
+			pcap_q->replay = NULL;
+		}
+	}
+
 	if (internals->phy_mac == 0)
 		/* not dynamically allocated, must not be freed */
 		dev->data->mac_addrs = NULL;
@@ -881,7 +1011,7 @@ static int
 eth_rx_queue_setup(struct rte_eth_dev *dev,
 		uint16_t rx_queue_id,
 		uint16_t nb_rx_desc __rte_unused,
-		unsigned int socket_id __rte_unused,
+		unsigned int socket_id,
 		const struct rte_eth_rxconf *rx_conf __rte_unused,
 		struct rte_mempool *mb_pool)
 {
@@ -893,7 +1023,38 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pcap_q->queue_id = rx_queue_id;
 	dev->data->rx_queues[rx_queue_id] = pcap_q;
 
-	if (internals->infinite_rx) {
+	if (internals->replay) {
+		char name[RTE_MEMPOOL_NAMESIZE];
+		int ret;
+
+		if (rte_pktmbuf_data_room_size(mb_pool) <
+				RTE_PKTMBUF_HEADROOM + PCAP_REPLAY_HDR_LEN) {
+			PMD_LOG(ERR, "Replay needs mbufs of at least %u bytes",
+				RTE_PKTMBUF_HEADROOM + PCAP_REPLAY_HDR_LEN);
+			return -EINVAL;
+		}
+
+		ret = pcap_replay_free(pcap_q->replay);
+		if (ret < 0)
+			return ret;
+		pcap_q->replay = NULL;
+
+		snprintf(name, sizeof(name), "pcap_replay_%u_%u",
+				pcap_q->port_id, rx_queue_id);
+		/* With replay_queues the file is split, else each has its own. */
+		if (internals->replay_queues > 1)
+			ret = pcap_replay_load(&pcap_q->replay, pcap_q->name,
+					internals->replay_speed, rx_queue_id,
+					internals->replay_queues, name, socket_id);
+		else
+			ret = pcap_replay_load(&pcap_q->replay, pcap_q->name,
+					internals->replay_speed, 0, 1, name,
+					socket_id);
+		if (ret < 0)
+			return ret;
+
+		pcap_q->replay->loop = internals->infinite_rx;
+	} else if (internals->infinite_rx) {
 		struct pmd_process_private *pp;
 		char ring_name[RTE_RING_NAMESIZE];
 		static uint32_t ring_number;
@@ -1185,6 +1346,43 @@ select_phy_mac(const char *key __rte_unused, const char *value,
 	return 0;
 }
 
+static int
+get_replay_speed_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	double *speed = extra_args;
+	char *end;
+
+	errno = 0;
+	*speed = strtod(value, &end);
+	if (errno != 0 || *end != '\0' || !(*speed >= 0)) {
+		PMD_LOG(ERR, "Invalid replay speed: %s", value);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int
+get_replay_queues_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	unsigned int *nb_queues = extra_args;
+	char *end;
+	unsigned long n;
+
+	errno = 0;
+	n = strtoul(value, &end, 0);
+	if (errno != 0 || *end != '\0' || n == 0 ||
+			n > RTE_PMD_PCAP_MAX_QUEUES) {
+		PMD_LOG(ERR, "Invalid number of replay queues: %s", value);
+		return -EINVAL;
+	}
+	*nb_queues = n;
+
+	return 0;
+}
+
 static int
 get_infinite_rx_arg(const char *key __rte_unused,
 		const char *value, void *extra_args)
@@ -1358,8 +1556,13 @@ eth_from_pcaps(struct rte_vdev_device *vdev,
 	}
 
 	internals->infinite_rx = infinite_rx;
+	internals->replay = devargs_all->replay;
+	internals->replay_queues = devargs_all->replay_queues;
+	internals->replay_speed = devargs_all->replay_speed;
 	/* Assign rx ops. */
-	if (infinite_rx)
+	if (devargs_all->replay)
+		eth_dev->rx_pkt_burst = eth_pcap_rx_replay;
+	else if (infinite_rx)
 		eth_dev->rx_pkt_burst = eth_pcap_rx_infinite;
 	else if (devargs_all->is_rx_pcap || devargs_all->is_rx_iface ||
 			single_iface)
@@ -1457,6 +1660,20 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 			return -1;
 	}
 
+	/* Replay is only supported from a capture file */
+	if ((rte_kvargs_count(kvlist, ETH_PCAP_REPLAY_SPEED_ARG) ||
+	     rte_kvargs_count(kvlist, ETH_PCAP_REPLAY_QUEUES_ARG)) &&
+	    (rte_kvargs_count(kvlist, ETH_PCAP_RX_PCAP_ARG) == 0 ||
+	     rte_kvargs_count(kvlist, ETH_PCAP_IFACE_ARG) ||
+	     rte_kvargs_count(kvlist, ETH_PCAP_RX_IFACE_ARG) ||
+	     rte_kvargs_count(kvlist, ETH_PCAP_RX_IFACE_IN_ARG))) {
+		PMD_LOG(ERR, "%s and %s need %s and no Rx interface",
+			ETH_PCAP_REPLAY_SPEED_ARG, ETH_PCAP_REPLAY_QUEUES_ARG,
+			ETH_PCAP_RX_PCAP_ARG);
+		ret = -EINVAL;
+		goto free_kvlist;
+	}
+
 	/*
 	 * If iface argument is passed we open the NICs and use them for
 	 * reading / writing
@@ -1525,8 +1742,47 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 					"for %s", name);
 		}
 
+		/*
+		 * Replay from memory is enabled by either of its arguments,
+		 * unpaced unless a speed is given.
+		 */
+		if (rte_kvargs_count(kvlist, ETH_PCAP_REPLAY_SPEED_ARG) == 1) {
+			ret = rte_kvargs_process(kvlist,
+					ETH_PCAP_REPLAY_SPEED_ARG,
+					&get_replay_speed_arg,
+					&devargs_all.replay_speed);
+			if (ret < 0)
+				goto free_kvlist;
+			devargs_all.replay = 1;
+		}
+		if (rte_kvargs_count(kvlist, ETH_PCAP_REPLAY_QUEUES_ARG) == 1) {
+			ret = rte_kvargs_process(kvlist,
+					ETH_PCAP_REPLAY_QUEUES_ARG,
+					&get_replay_queues_arg,
+					&devargs_all.replay_queues);
+			if (ret < 0)
+				goto free_kvlist;
+			devargs_all.replay = 1;
+		}
+
 		ret = rte_kvargs_process(kvlist, ETH_PCAP_RX_PCAP_ARG,
 				&open_rx_pcap, &pcaps);
+
+		/* Spread a single file over several queues by RSS hash. */
+		if (ret == 0 && devargs_all.replay_queues > 1) {
+			unsigned int i;
+
+			if (pcaps.num_of_queue != 1) {
+				PMD_LOG(ERR, "%s needs a single %s",
+					ETH_PCAP_REPLAY_QUEUES_ARG,
+					ETH_PCAP_RX_PCAP_ARG);
+				ret = -EINVAL;
+				goto free_kvlist;
+			}
+			for (i = 1; i < devargs_all.replay_queues; i++)
+				add_queue(&pcaps, pcaps.queue[0].name,
+					pcaps.queue[0].type, NULL, NULL);
+		}
 	} else if (devargs_all.is_rx_iface) {
 		ret = rte_kvargs_process(kvlist, NULL,
 				&rx_iface_args_process, &pcaps);
@@ -1665,4 +1921,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_pcap,
 	ETH_PCAP_TX_IFACE_ARG "=<ifc> "
 	ETH_PCAP_IFACE_ARG "=<ifc> "
 	ETH_PCAP_PHY_MAC_ARG "=<int>"
-	ETH_PCAP_INFINITE_RX_ARG "=<0|1>");
+	ETH_PCAP_INFINITE_RX_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_SPEED_ARG "=<float> "
+	ETH_PCAP_REPLAY_QUEUES_ARG "=<int>");
@@ -0,0 +1,563 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <unistd.h>
+#endif
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_os_shim.h>
+#include <rte_thash.h>
+
+#include "pcap_osdep.h"
+#include "pcap_replay.h"
+
+/* Classic pcap magics, as read in host order. */
+#define PCAP_MAGIC_US		0xa1b2c3d4
+#define PCAP_MAGIC_NS		0xa1b23c4d
+#define PCAP_FILE_HDR_LEN	24
+#define PCAP_PKT_HDR_LEN	16
+
+/* pcapng block types and options. */
+#define PCAPNG_SHB		0x0a0d0d0a
+#define PCAPNG_IDB		0x00000001
+#define PCAPNG_OPB		0x00000002
+#define PCAPNG_SPB		0x00000003
+#define PCAPNG_EPB		0x00000006
+#define PCAPNG_BOM		0x1a2b3c4d
+#define PCAPNG_OPT_END		0
+#define PCAPNG_OPT_TSRESOL	9
+#define PCAPNG_TSRESOL_DEFAULT	6
+#define PCAPNG_MAX_IFACES	64
+
+/* Same key as the one most NICs come up with. */
+static const uint8_t replay_rss_key[RTE_THASH_V6_L4_LEN * 4 + 4] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+typedef int (*replay_pkt_cb)(void *arg, const uint8_t *data, uint32_t len,
+		uint64_t ts_ns);
+
+struct replay_ctx {
+	uint16_t queue_id;
+	uint16_t nb_queues;
+	uint32_t max_len;
+
+	/* Filled by the counting pass. */
+	uint64_t nb_total;
+	uint64_t first_ns;
+	uint64_t last_ns;
+	uint32_t nb_pkts;
+	uint32_t max_caplen;
+
+	/* Used by the building pass. */
+	struct pcap_replay *replay;
+	double cycles_per_ns;
+};
+
+static inline uint32_t
+replay_read32(const uint8_t *p, bool swap)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return swap ? rte_bswap32(v) : v;
+}
+
+static inline uint16_t
+replay_read16(const uint8_t *p, bool swap)
+{
+	uint16_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return swap ? rte_bswap16(v) : v;
+}
+
+/*
+ * Pick the queue of a packet the way a NIC would, using a Toeplitz hash
+ * of its IP addresses and ports. Non-IP packets go to the first queue.
+ */
+static uint16_t
+replay_pkt_queue(const uint8_t *data, uint32_t len, uint16_t nb_queues)
+{
+	union rte_thash_tuple tuple;
+	uint32_t off = 2 * RTE_ETHER_ADDR_LEN;
+	uint32_t tuple_len, l4_off;
+	uint16_t ether_type;
+	uint8_t proto;
+	unsigned int i;
+
+	if (nb_queues <= 1 || len < sizeof(struct rte_ether_hdr))
+		return 0;
+
+	ether_type = rte_be_to_cpu_16(*(const unaligned_uint16_t *)(data + off));
+	off += sizeof(ether_type);
+	for (i = 0; i < 2; i++) {
+		if (ether_type != RTE_ETHER_TYPE_VLAN &&
+				ether_type != RTE_ETHER_TYPE_QINQ)
+			break;
+		if (len < off + sizeof(struct rte_vlan_hdr))
+			return 0;
+		ether_type = rte_be_to_cpu_16(*(const unaligned_uint16_t *)
+				(data + off + 2));
+		off += sizeof(struct rte_vlan_hdr);
+	}
+
+	if (ether_type == RTE_ETHER_TYPE_IPV4) {
+		struct rte_ipv4_hdr ip;
+
+		if (len < off + sizeof(ip))
+			return 0;
+		memcpy(&ip, data + off, sizeof(ip));
+		tuple.v4.src_addr = rte_be_to_cpu_32(ip.src_addr);
+		tuple.v4.dst_addr = rte_be_to_cpu_32(ip.dst_addr);
+		tuple_len = RTE_THASH_V4_L3_LEN;
+		proto = ip.next_proto_id;
+		l4_off = off + rte_ipv4_hdr_len(&ip);
+		if (rte_be_to_cpu_16(ip.fragment_offset) &
+				(RTE_IPV4_HDR_OFFSET_MASK | RTE_IPV4_HDR_MF_FLAG))
+			proto = 0;
+	} else if (ether_type == RTE_ETHER_TYPE_IPV6) {
+		struct rte_ipv6_hdr ip;
+		uint32_t *words = (uint32_t *)&tuple.v6;
+
+		if (len < off + sizeof(ip))
+			return 0;
+		memcpy(&ip, data + off, sizeof(ip));
+		tuple.v6.src_addr = ip.src_addr;
+		tuple.v6.dst_addr = ip.dst_addr;
+		for (i = 0; i < RTE_THASH_V6_L3_LEN; i++)
+			words[i] = rte_be_to_cpu_32(words[i]);
+		tuple_len = RTE_THASH_V6_L3_LEN;
+		proto = ip.proto;
+		l4_off = off + sizeof(ip);
+	} else {
+		return 0;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP ||
+			proto == IPPROTO_SCTP) && len >= l4_off + 4) {
+		uint16_t sport = rte_be_to_cpu_16(*(const unaligned_uint16_t *)
+				(data + l4_off));
+		uint16_t dport = rte_be_to_cpu_16(*(const unaligned_uint16_t *)
+				(data + l4_off + 2));
+
+		if (ether_type == RTE_ETHER_TYPE_IPV4) {
+			tuple.v4.sport = sport;
+			tuple.v4.dport = dport;
+			tuple_len = RTE_THASH_V4_L4_LEN;
+		} else {
+			tuple.v6.sport = sport;
+			tuple.v6.dport = dport;
+			tuple_len = RTE_THASH_V6_L4_LEN;
+		}
+	}
+
+	return rte_softrss((uint32_t *)&tuple, tuple_len, replay_rss_key) %
+		nb_queues;
+}
+
+static int
+replay_walk_pcap(const uint8_t *p, size_t size, replay_pkt_cb cb, void *arg)
+{
+	uint32_t magic = replay_read32(p, false);
+	size_t off = PCAP_FILE_HDR_LEN;
+	bool swap, nsec;
+	int ret;
+
+	swap = magic == rte_bswap32(PCAP_MAGIC_US) ||
+		magic == rte_bswap32(PCAP_MAGIC_NS);
+	if (swap)
+		magic = rte_bswap32(magic);
+	nsec = magic == PCAP_MAGIC_NS;
+
+	while (off + PCAP_PKT_HDR_LEN <= size) {
+		uint64_t sec = replay_read32(p + off, swap);
+		uint64_t frac = replay_read32(p + off + 4, swap);
+		uint32_t caplen = replay_read32(p + off + 8, swap);
+
+		off += PCAP_PKT_HDR_LEN;
+		if (caplen > size - off) {
+			PMD_LOG(WARNING, "Truncated packet at offset %zu", off);
+			break;
+		}
+
+		ret = cb(arg, p + off, caplen,
+			sec * NS_PER_S + (nsec ? frac : frac * 1000));
+		if (ret < 0)
+			return ret;
+		off += caplen;
+	}
+
+	return 0;
+}
+
+/* Convert a pcapng timestamp to nanoseconds according to if_tsresol. */
+static uint64_t
+replay_pcapng_ts(uint64_t ts, uint8_t tsresol)
+{
+	unsigned int exp = tsresol & 0x7f;
+	uint64_t mult = 1;
+	unsigned int i;
+
+	if (tsresol & 0x80) {
+		uint64_t frac;
+
+		if (exp >= 64)
+			return 0;
+		frac = ts & (RTE_BIT64(exp) - 1);
+		ts >>= exp;
+		/* Keep the fraction product within 64 bits. */
+		if (exp > 30) {
+			frac >>= exp - 30;
+			exp = 30;
+		}
+		return ts * NS_PER_S + ((frac * NS_PER_S) >> exp);
+	}
+
+	if (exp <= 9) {
+		for (i = exp; i < 9; i++)
+			mult *= 10;
+		return ts * mult;
+	}
+	if (exp > 28)
+		return 0;
+	for (i = 9; i < exp; i++)
+		mult *= 10;
+	return ts / mult;
+}
+
+static uint8_t
+replay_pcapng_tsresol(const uint8_t *opt, size_t len, bool swap)
+{
+	while (len >= 4) {
+		uint16_t code = replay_read16(opt, swap);
+		uint16_t olen = replay_read16(opt + 2, swap);
+
+		if (code == PCAPNG_OPT_END || olen > len - 4)
+			break;
+		if (code == PCAPNG_OPT_TSRESOL && olen >= 1)
+			return opt[4];
+		olen = RTE_ALIGN_CEIL(olen, 4);
+		if (olen > len - 4)
+			break;
+		opt += 4 + olen;
+		len -= 4 + olen;
+	}
+
+	return PCAPNG_TSRESOL_DEFAULT;
+}
+
+static int
+replay_walk_pcapng(const uint8_t *p, size_t size, replay_pkt_cb cb, void *arg)
+{
+	struct {
+		uint32_t snaplen;
+		uint8_t tsresol;
+	} ifaces[PCAPNG_MAX_IFACES];
+	unsigned int nb_ifaces = 0;
+	uint64_t last_ns = 0;
+	bool swap = false;
+	size_t off = 0;
+	int ret;
+
+	while (off + 12 <= size) {
+		uint32_t type = replay_read32(p + off, swap);
+		const uint8_t *body = p + off + 8;
+		uint32_t caplen, ifid, len;
+		size_t body_len;
+		uint64_t ts;
+
+		if (type == PCAPNG_SHB) {
+			uint32_t bom = replay_read32(body, false);
+
+			if (bom == rte_bswap32(PCAPNG_BOM))
+				swap = true;
+			else if (bom == PCAPNG_BOM)
+				swap = false;
+			else
+				return -EINVAL;
+			/* A new section starts with no interfaces. */
+			nb_ifaces = 0;
+		}
+
+		len = replay_read32(p + off + 4, swap);
+		if (len < 12 || (len & 3) != 0 || len > size - off) {
+			PMD_LOG(WARNING, "Truncated block at offset %zu", off);
+			break;
+		}
+		body_len = len - 12;
+
+		switch (type) {
+		case PCAPNG_IDB:
+			if (body_len < 8)
+				break;
+			if (nb_ifaces < PCAPNG_MAX_IFACES) {
+				ifaces[nb_ifaces].snaplen =
+					replay_read32(body + 4, swap);
+				ifaces[nb_ifaces].tsresol =
+					replay_pcapng_tsresol(body + 8,
+						body_len - 8, swap);
+			}
+			nb_ifaces++;
+			break;
+		case PCAPNG_EPB:
+		case PCAPNG_OPB:
+			if (body_len < 20)
+				break;
+			if (type == PCAPNG_EPB)
+				ifid = replay_read32(body, swap);
+			else
+				ifid = replay_read16(body, swap);
+			ts = (uint64_t)replay_read32(body + 4, swap) << 32 |
+				replay_read32(body + 8, swap);
+			caplen = replay_read32(body + 12, swap);
+			if (caplen > body_len - 20)
+				return -EINVAL;
+			last_ns = replay_pcapng_ts(ts, ifid < nb_ifaces &&
+					ifid < PCAPNG_MAX_IFACES ?
+					ifaces[ifid].tsresol :
+					PCAPNG_TSRESOL_DEFAULT);
+			ret = cb(arg, body + 20, caplen, last_ns);
+			if (ret < 0)
+				return ret;
+			break;
+		case PCAPNG_SPB:
+			/* No timestamp, the packet is due with the previous one. */
+			if (body_len < 4)
+				break;
+			caplen = RTE_MIN(replay_read32(body, swap),
+					body_len - 4);
+			if (nb_ifaces > 0 && ifaces[0].snaplen != 0)
+				caplen = RTE_MIN(caplen, ifaces[0].snaplen);
+			ret = cb(arg, body + 4, caplen, last_ns);
+			if (ret < 0)
+				return ret;
+			break;
+		default:
+			break;
+		}
+
+		off += len;
+	}
+
+	return 0;
+}
+
+static int
+replay_walk(const uint8_t *p, size_t size, replay_pkt_cb cb, void *arg)
+{
+	uint32_t magic;
+
+	if (size < PCAP_FILE_HDR_LEN)
+		return -EINVAL;
+
+	magic = replay_read32(p, false);
+	if (magic == PCAPNG_SHB)
+		return replay_walk_pcapng(p, size, cb, arg);
+	if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+			magic == rte_bswap32(PCAP_MAGIC_US) ||
+			magic == rte_bswap32(PCAP_MAGIC_NS))
+		return replay_walk_pcap(p, size, cb, arg);
+
+	return -EINVAL;
+}
+
+static int
+replay_count_cb(void *arg, const uint8_t *data, uint32_t len, uint64_t ts_ns)
+{
+	struct replay_ctx *ctx = arg;
+
+	if (ctx->nb_total++ == 0)
+		ctx->first_ns = ts_ns;
+	ctx->last_ns = RTE_MAX(ctx->last_ns, ts_ns);
+
+	if (replay_pkt_queue(data, len, ctx->nb_queues) != ctx->queue_id)
+		return 0;
+
+	if (ctx->nb_pkts == UINT32_MAX)
+		return -E2BIG;
+	ctx->nb_pkts++;
+	ctx->max_caplen = RTE_MAX(ctx->max_caplen, RTE_MIN(len, ctx->max_len));
+
+	return 0;
+}
+
+static int
+replay_build_cb(void *arg, const uint8_t *data, uint32_t len, uint64_t ts_ns)
+{
+	struct replay_ctx *ctx = arg;
+	struct pcap_replay *replay = ctx->replay;
+	struct pcap_replay_pkt *pkt;
+	struct rte_mbuf *m;
+
+	if (replay_pkt_queue(data, len, ctx->nb_queues) != ctx->queue_id)
+		return 0;
+
+	m = rte_pktmbuf_alloc(replay->pool);
+	if (m == NULL)
+		return -ENOMEM;
+
+	len = RTE_MIN(len, ctx->max_len);
+	memcpy(rte_pktmbuf_mtod(m, void *), data, len);
+	m->data_len = len;
+	m->pkt_len = len;
+
+	pkt = &replay->pkts[replay->nb_pkts++];
+	pkt->mbuf = m;
+	pkt->ts_us = ts_ns / 1000;
+	/* Timestamps going backwards are delivered right away. */
+	if (ts_ns > ctx->first_ns)
+		pkt->due = (uint64_t)((ts_ns - ctx->first_ns) * ctx->cycles_per_ns);
+	else
+		pkt->due = 0;
+
+	return 0;
+}
+
+static int
+replay_map(const char *filename, const uint8_t **data, size_t *size)
+{
+	struct stat st;
+	void *addr;
+	int fd;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		PMD_LOG(ERR, "Couldn't open %s: %s", filename, strerror(errno));
+		return -errno;
+	}
+
+	if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+		PMD_LOG(ERR, "Couldn't get the size of %s", filename);
+		close(fd);
+		return -EINVAL;
+	}
+
+	addr = rte_mem_map(NULL, st.st_size, RTE_PROT_READ, RTE_MAP_SHARED,
+			fd, 0);
+	close(fd);
+	if (addr == NULL) {
+		PMD_LOG(ERR, "Couldn't map %s: %s", filename,
+			rte_strerror(rte_errno));
+		return -rte_errno;
+	}
+
+	*data = addr;
+	*size = st.st_size;
+	return 0;
+}
+
+int
+pcap_replay_free(struct pcap_replay *replay)
+{
+	uint32_t i;
+
+	if (replay == NULL)
+		return 0;
+
+	/* Each Rx mbuf handed out holds a reference on its template. */
+	for (i = 0; i < replay->nb_pkts; i++) {
+		if (rte_mbuf_refcnt_read(replay->pkts[i].mbuf) > 1) {
+			PMD_LOG(ERR, "Replayed mbufs of %s still in use",
+				replay->pool->name);
+			return -EBUSY;
+		}
+	}
+
+	for (i = 0; i < replay->nb_pkts; i++)
+		rte_pktmbuf_free(replay->pkts[i].mbuf);
+	rte_mempool_free(replay->pool);
+	rte_free(replay);
+
+	return 0;
+}
+
+int
+pcap_replay_load(struct pcap_replay **replay, const char *filename,
+		double speed, uint16_t queue_id, uint16_t nb_queues,
+		const char *name, int socket_id)
+{
+	struct replay_ctx ctx = {
+		.queue_id = queue_id,
+		.nb_queues = nb_queues,
+		.max_len = UINT16_MAX - RTE_PKTMBUF_HEADROOM,
+	};
+	struct pcap_replay *r;
+	const uint8_t *data = NULL;
+	uint64_t duration;
+	size_t size = 0;
+	int ret;
+
+	ret = replay_map(filename, &data, &size);
+	if (ret < 0)
+		return ret;
+
+	/* First pass sizes the template pool, second one fills it. */
+	ret = replay_walk(data, size, replay_count_cb, &ctx);
+	if (ret < 0) {
+		PMD_LOG(ERR, "Couldn't parse %s", filename);
+		goto unmap;
+	}
+
+	r = rte_zmalloc_socket(name, sizeof(*r) +
+			ctx.nb_pkts * sizeof(r->pkts[0]), 0, socket_id);
+	if (r == NULL) {
+		ret = -ENOMEM;
+		goto unmap;
+	}
+
+	r->paced = speed > 0;
+	if (r->paced) {
+		ctx.cycles_per_ns = (double)rte_get_timer_hz() / NS_PER_S / speed;
+		/* Leave the average gap between the last and the first packet. */
+		duration = ctx.last_ns - ctx.first_ns;
+		if (ctx.nb_total > 1)
+			duration += duration / (ctx.nb_total - 1);
+		r->period = (uint64_t)(duration * ctx.cycles_per_ns);
+	}
+
+	if (ctx.nb_pkts != 0) {
+		r->pool = rte_pktmbuf_pool_create(name, ctx.nb_pkts, 0, 0,
+				RTE_PKTMBUF_HEADROOM + ctx.max_caplen, socket_id);
+		if (r->pool == NULL) {
+			PMD_LOG(ERR, "Couldn't allocate %u templates for %s",
+				ctx.nb_pkts, filename);
+			ret = -rte_errno;
+			rte_free(r);
+			goto unmap;
+		}
+
+		ctx.replay = r;
+		ret = replay_walk(data, size, replay_build_cb, &ctx);
+		if (ret < 0) {
+			pcap_replay_free(r);
+			goto unmap;
+		}
+	}
+
+	PMD_LOG(INFO, "Replaying %u of %" PRIu64 " packets from %s",
+		r->nb_pkts, ctx.nb_total, filename);
+	*replay = r;
+	ret = 0;
+
+unmap:
+	rte_mem_unmap((void *)(uintptr_t)data, size);
+	return ret;
+}
@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef _PCAP_REPLAY_H_
+#define _PCAP_REPLAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+
+/*
+ * Bytes of a packet copied into the Rx mbuf, so that applications can
+ * rewrite headers in place. Longer packets get the rest chained from
+ * their template, which is shared and must be left untouched.
+ */
+#define PCAP_REPLAY_HDR_LEN	128
+/* Most packets delivered by one Rx burst. */
+#define PCAP_REPLAY_MAX_BURST	64
+
+/* A captured packet, ready to be handed out by the Rx burst. */
+struct pcap_replay_pkt {
+	/* Template holding the packet data, Rx tails are attached to it. */
+	struct rte_mbuf *mbuf;
+	/* Due time relative to the start of a pass, in timer cycles. */
+	uint64_t due;
+	/* Original capture timestamp in microseconds. */
+	uint64_t ts_us;
+};
+
+/* Packets of one Rx queue, parsed from an mmap'ed pcap/pcapng file. */
+struct pcap_replay {
+	/* Pool the templates are allocated from. */
+	struct rte_mempool *pool;
+	/* Timer cycles at which the current pass started. */
+	uint64_t base;
+	/* Length of one pass through the file, in timer cycles. */
+	uint64_t period;
+	/* Deliver packets according to their due time. */
+	bool paced;
+	/* Start over once the last packet was delivered. */
+	bool loop;
+	/* Index of the next packet to deliver. */
+	uint32_t next;
+	uint32_t nb_pkts;
+	struct pcap_replay_pkt pkts[];
+};
+
+/*
+ * Load the packets of 'filename' hashing to 'queue_id' out of 'nb_queues'.
+ * A 'speed' of 0 disables pacing, otherwise inter-packet gaps of the
+ * capture are divided by it.
+ */
+int pcap_replay_load(struct pcap_replay **replay, const char *filename,
+		double speed, uint16_t queue_id, uint16_t nb_queues,
+		const char *name, int socket_id);
+/*
+ * Free the templates, unless Rx mbufs still attached to one of them:
+ * -EBUSY is returned and the replay is left untouched.
+ */
+int pcap_replay_free(struct pcap_replay *replay);
+
+static inline void
+pcap_replay_start(struct pcap_replay *replay, uint64_t now)
+{
+	replay->next = 0;
+	replay->base = now;
+}
+
+#endif /* _PCAP_REPLAY_H_ */
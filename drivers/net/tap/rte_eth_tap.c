@@ -25,6 +25,7 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <errno.h>
+#include <limits.h>
 #include <signal.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -41,6 +42,7 @@
 #include <tap_flow.h>
 #include <tap_netlink.h>
 #include <tap_tcmsgs.h>
+#include <tap_uring.h>
 
 /* Linux based path to the TUN device */
 #define TUN_TAP_DEV_PATH        "/dev/net/tun"
@@ -52,6 +54,9 @@
 #define ETH_TAP_MAC_ARG         "mac"
 #define ETH_TAP_MAC_FIXED       "fixed"
 #define ETH_TAP_PERSIST_ARG     "persist"
+#define ETH_TAP_VNET_HDR_ARG    "vnet_hdr"
+#define ETH_TAP_IO_URING_ARG    "io_uring"
+#define ETH_TAP_SQPOLL_ARG      "sqpoll"
 
 #define ETH_TAP_USR_MAC_FMT     "xx:xx:xx:xx:xx:xx"
 #define ETH_TAP_CMP_MAC_FMT     "0123456789ABCDEFabcdef"
@@ -68,6 +73,9 @@
 #define TAP_MP_REQ_START_RXTX "tap_mp_req_start_rxtx"
 
 static_assert(RTE_PMD_TAP_MAX_QUEUES <= RTE_MP_MAX_FD_NUM, "TAP max queues exceeds MP fd limit");
+static_assert(sizeof(struct tap_pkt_hdr) ==
+	      sizeof(struct tun_pi) + sizeof(struct virtio_net_hdr),
+	      "TAP packet header must not be padded");
 
 #define TAP_IOV_DEFAULT_MAX 1024
 
@@ -93,6 +101,9 @@ static const char *valid_arguments[] = {
 	ETH_TAP_REMOTE_ARG,
 	ETH_TAP_MAC_ARG,
 	ETH_TAP_PERSIST_ARG,
+	ETH_TAP_VNET_HDR_ARG,
+	ETH_TAP_IO_URING_ARG,
+	ETH_TAP_SQPOLL_ARG,
 	NULL
 };
 
@@ -156,6 +167,9 @@ tun_alloc(struct pmd_internals *pmd, int is_keepalive, int persistent)
 	 */
 	ifr.ifr_flags = (pmd->type == ETH_TUNTAP_TYPE_TAP) ?
 		IFF_TAP : IFF_TUN | IFF_POINTOPOINT;
+	/* Flags are device wide, all queues must agree on the vnet header */
+	if (pmd->vnet_hdr)
+		ifr.ifr_flags |= IFF_VNET_HDR;
 	strlcpy(ifr.ifr_name, pmd->name, IFNAMSIZ);
 
 	fd = open(TUN_TAP_DEV_PATH, O_RDWR);
@@ -172,6 +186,12 @@ tun_alloc(struct pmd_internals *pmd, int is_keepalive, int persistent)
 	}
 	TAP_LOG(DEBUG, "%s Features %08x", TUN_TAP_DEV_PATH, features);
 
+	if (pmd->vnet_hdr && !(features & IFF_VNET_HDR)) {
+		TAP_LOG(ERR, "%s does not support IFF_VNET_HDR",
+			TUN_TAP_DEV_PATH);
+		goto error;
+	}
+
 	if (features & IFF_MULTI_QUEUE) {
 		TAP_LOG(DEBUG, "  Multi-queue support for %d queues",
 			RTE_PMD_TAP_MAX_QUEUES);
@@ -395,6 +415,97 @@ tap_verify_csum(struct rte_mbuf *mbuf)
 	}
 }
 
+/*
+ * Translate the vnet header of a received packet into mbuf offload flags.
+ * Return true if the header settles the L4 checksum status.
+ */
+static bool
+tap_vnet_hdr_to_mbuf(const struct virtio_net_hdr *hdr, struct rte_mbuf *mbuf)
+{
+	bool l4_cksum_known = true;
+
+	if (hdr->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM)
+		/* locally generated, only the pseudo header sum is present */
+		mbuf->ol_flags |= RTE_MBUF_F_RX_L4_CKSUM_NONE;
+	else if (hdr->flags & VIRTIO_NET_HDR_F_DATA_VALID)
+		mbuf->ol_flags |= RTE_MBUF_F_RX_L4_CKSUM_GOOD;
+	else
+		l4_cksum_known = false;
+
+	if (hdr->gso_type != VIRTIO_NET_HDR_GSO_NONE) {
+		/* coalesced by the kernel */
+		mbuf->ol_flags |= RTE_MBUF_F_RX_LRO;
+		mbuf->tso_segsz = hdr->gso_size;
+	}
+
+	return l4_cksum_known;
+}
+
+/*
+ * Describe the L4 checksum and TCP segmentation offloads of a packet
+ * to the kernel.
+ */
+static void
+tap_mbuf_to_vnet_hdr(const struct rte_mbuf *mbuf, struct virtio_net_hdr *hdr)
+{
+	uint64_t l4_ol_flags = mbuf->ol_flags & RTE_MBUF_F_TX_L4_MASK;
+
+	if (l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM) {
+		hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+		hdr->csum_start = mbuf->l2_len + mbuf->l3_len;
+		hdr->csum_offset = offsetof(struct rte_tcp_hdr, cksum);
+	} else if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
+		hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+		hdr->csum_start = mbuf->l2_len + mbuf->l3_len;
+		hdr->csum_offset = offsetof(struct rte_udp_hdr, dgram_cksum);
+	}
+
+	if (mbuf->ol_flags & RTE_MBUF_F_TX_TCP_SEG) {
+		hdr->gso_type = (mbuf->ol_flags & RTE_MBUF_F_TX_IPV6) ?
+			VIRTIO_NET_HDR_GSO_TCPV6 : VIRTIO_NET_HDR_GSO_TCPV4;
+		hdr->gso_size = mbuf->tso_segsz;
+		hdr->hdr_len = mbuf->l2_len + mbuf->l3_len + mbuf->l4_len;
+	}
+}
+
+/*
+ * DPDK leaves the L4 length out of the pseudo header checksum of a TSO
+ * packet while the kernel expects it to be included, add it.
+ */
+static void
+tap_tso_fix_cksum(struct rte_mbuf *mbuf)
+{
+	struct rte_tcp_hdr *th;
+	uint32_t l4_len;
+	uint32_t tmp;
+
+	th = rte_pktmbuf_mtod_offset(mbuf, struct rte_tcp_hdr *,
+				     mbuf->l2_len + mbuf->l3_len);
+	/* the IP length fields may not hold the whole TSO payload */
+	l4_len = rte_cpu_to_be_32(rte_pktmbuf_pkt_len(mbuf) - mbuf->l2_len -
+				  mbuf->l3_len);
+	tmp = th->cksum;
+	tmp += (l4_len & 0xffff) + (l4_len >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+	tmp = (tmp & 0xffff) + (tmp >> 16);
+	th->cksum = tmp;
+}
+
+/* Fill in packet type and offload flags of a received packet */
+void
+tap_rx_offload(struct rx_queue *rxq, const struct tap_pkt_hdr *hdr,
+	       struct rte_mbuf *mbuf)
+{
+	bool l4_cksum_known = false;
+
+	mbuf->packet_type = rte_net_get_ptype(mbuf, NULL, RTE_PTYPE_ALL_MASK);
+	if (rxq->hdr_len > sizeof(struct tun_pi))
+		l4_cksum_known = tap_vnet_hdr_to_mbuf(&hdr->vnet, mbuf);
+	if (!l4_cksum_known &&
+	    (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM))
+		tap_verify_csum(mbuf);
+}
+
 static void
 tap_rxq_pool_free(struct rte_mbuf *pool)
 {
@@ -439,16 +550,16 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			*rxq->iovecs,
 			1 + (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_SCATTER ?
 			     rxq->nb_rx_desc : 1));
-		if (len < (int)sizeof(struct tun_pi))
+		if (len < (int)rxq->hdr_len)
 			break;
 
 		/* Packet couldn't fit in the provided mbuf */
-		if (unlikely(rxq->pi.flags & TUN_PKT_STRIP)) {
+		if (unlikely(rxq->hdr.pi.flags & TUN_PKT_STRIP)) {
 			rxq->stats.ierrors++;
 			continue;
 		}
 
-		len -= sizeof(struct tun_pi);
+		len -= rxq->hdr_len;
 
 		mbuf->pkt_len = len;
 		mbuf->port = rxq->in_port;
@@ -491,10 +602,7 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			data_off = 0;
 		}
 		seg->next = NULL;
-		mbuf->packet_type = rte_net_get_ptype(mbuf, NULL,
-						      RTE_PTYPE_ALL_MASK);
-		if (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM)
-			tap_verify_csum(mbuf);
+		tap_rx_offload(rxq, &rxq->hdr, mbuf);
 
 		/* account for the receive frame */
 		bufs[num_rx++] = mbuf;
@@ -523,9 +631,10 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 	for (i = 0; i < num_mbufs; i++) {
 		struct rte_mbuf *mbuf = pmbufs[i];
 		struct iovec iovecs[mbuf->nb_segs + 2];
-		struct tun_pi pi = { .flags = 0, .proto = 0x00 };
+		struct tap_pkt_hdr hdr = { .pi = { .flags = 0, .proto = 0x00 } };
 		struct rte_mbuf *seg = mbuf;
 		uint64_t l4_ol_flags;
+		bool tso;
 		int proto;
 		int n;
 		int j;
@@ -544,7 +653,7 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 			 */
 			char *buff_data = rte_pktmbuf_mtod(seg, void *);
 			proto = (*buff_data & 0xf0);
-			pi.proto = (proto == 0x40) ?
+			hdr.pi.proto = (proto == 0x40) ?
 				rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) :
 				((proto == 0x60) ?
 					rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) :
@@ -552,19 +661,25 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 		}
 
 		k = 0;
-		iovecs[k].iov_base = &pi;
-		iovecs[k].iov_len = sizeof(pi);
+		iovecs[k].iov_base = &hdr;
+		iovecs[k].iov_len = txq->vnet_hdr ? sizeof(hdr) : sizeof(hdr.pi);
 		k++;
 
+		/* With a vnet header, the kernel completes L4 checksums */
 		l4_ol_flags = mbuf->ol_flags & RTE_MBUF_F_TX_L4_MASK;
-		if (txq->csum && (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM ||
-				l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM ||
-				l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)) {
+		tso = txq->vnet_hdr && (mbuf->ol_flags & RTE_MBUF_F_TX_TCP_SEG);
+		if (tso ||
+		    (txq->csum && (mbuf->ol_flags & RTE_MBUF_F_TX_IP_CKSUM ||
+				(!txq->vnet_hdr &&
+				 (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM ||
+				  l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM))))) {
 			unsigned int hdrlens = mbuf->l2_len + mbuf->l3_len;
 			uint16_t *l4_cksum;
 			void *l3_hdr;
 
-			if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM)
+			if (tso)
+				hdrlens += mbuf->l4_len;
+			else if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM)
 				hdrlens += sizeof(struct rte_udp_hdr);
 			else if (l4_ol_flags == RTE_MBUF_F_TX_TCP_CKSUM)
 				hdrlens += sizeof(struct rte_tcp_hdr);
@@ -596,7 +711,11 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 				iph->hdr_checksum = rte_ipv4_cksum(iph);
 			}
 
-			if (l4_ol_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
+			if (tso)
+				tap_tso_fix_cksum(mbuf);
+
+			if (txq->vnet_hdr ||
+			    l4_ol_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
 				goto skip_l4_cksum;
 
 			if (l4_ol_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
@@ -624,6 +743,10 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 		}
 
 skip_l4_cksum:
+		if (txq->vnet_hdr && (txq->csum ||
+				      mbuf->ol_flags & RTE_MBUF_F_TX_TCP_SEG))
+			tap_mbuf_to_vnet_hdr(mbuf, &hdr.vnet);
+
 		for (j = 0; j < mbuf->nb_segs; j++) {
 			iovecs[k].iov_len = rte_pktmbuf_data_len(seg);
 			iovecs[k].iov_base = rte_pktmbuf_mtod(seg, void *);
@@ -632,7 +755,11 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 		}
 
 		/* copy the tx frame data */
-		n = writev(process_private->fds[txq->queue_id], iovecs, k);
+		if (txq->uring != NULL)
+			n = tap_uring_write(txq, mbuf, iovecs, k);
+		else
+			n = writev(process_private->fds[txq->queue_id],
+				   iovecs, k);
 		if (n <= 0)
 			return -1;
 
@@ -671,8 +798,6 @@ pmd_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 		tso = mbuf_in->ol_flags & RTE_MBUF_F_TX_TCP_SEG;
 		if (tso) {
-			struct rte_gso_ctx *gso_ctx = &txq->gso_ctx;
-
 			/* TCP segmentation implies TCP checksum offload */
 			mbuf_in->ol_flags |= RTE_MBUF_F_TX_TCP_CKSUM;
 
@@ -685,6 +810,11 @@ pmd_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 				txq->stats.errs++;
 				break;
 			}
+		}
+
+		if (tso && !txq->vnet_hdr) {
+			struct rte_gso_ctx *gso_ctx = &txq->gso_ctx;
+
 			gso_ctx->gso_size = tso_segsz;
 			/* 'mbuf_in' packet to segment */
 			num_tso_mbufs = rte_gso_segment(mbuf_in,
@@ -707,8 +837,12 @@ pmd_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 				num_mbufs = 1;
 			}
 		} else {
-			/* stats.errs will be incremented */
-			if (rte_pktmbuf_pkt_len(mbuf_in) > max_size)
+			/*
+			 * stats.errs will be incremented.
+			 * With a vnet header, TSO packets are segmented
+			 * by the kernel.
+			 */
+			if (!tso && rte_pktmbuf_pkt_len(mbuf_in) > max_size)
 				break;
 
 			/* ret 0 indicates no new mbufs were created */
@@ -738,6 +872,10 @@ pmd_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		}
 	}
 
+	/* submit the writes queued for the whole burst at once */
+	if (txq->uring != NULL)
+		tap_uring_tx_flush(txq);
+
 	txq->stats.opackets += num_packets;
 	txq->stats.errs += nb_pkts - num_tx;
 	txq->stats.obytes += num_tx_bytes;
@@ -891,6 +1029,43 @@ tap_dev_configure(struct rte_eth_dev *dev)
 	TAP_LOG(INFO, "%s: %s: RX configured queues number: %u",
 		dev->device->name, pmd->name, dev->data->nb_rx_queues);
 
+	/* io_uring reads whole packets into single mbufs */
+	if (pmd->io_uring &&
+	    (dev->data->dev_conf.rxmode.offloads &
+	     (RTE_ETH_RX_OFFLOAD_SCATTER | RTE_ETH_RX_OFFLOAD_TCP_LRO) ||
+	     dev->data->dev_conf.intr_conf.rxq)) {
+		TAP_LOG(ERR,
+			"%s: Rx scatter, LRO and interrupts are not supported with io_uring",
+			dev->device->name);
+		return -ENOTSUP;
+	}
+
+	if (pmd->vnet_hdr) {
+		uint64_t offloads = dev->data->dev_conf.rxmode.offloads;
+		unsigned int tun_offloads = 0;
+
+		/* coalesced packets are larger than a single mbuf */
+		if ((offloads & RTE_ETH_RX_OFFLOAD_TCP_LRO) &&
+		    !(offloads & RTE_ETH_RX_OFFLOAD_SCATTER)) {
+			TAP_LOG(ERR, "%s: LRO requires Rx scatter",
+				dev->device->name);
+			return -EINVAL;
+		}
+
+		/* Let the kernel skip checksums and segmentation towards us */
+		if (offloads & (RTE_ETH_RX_OFFLOAD_UDP_CKSUM |
+				RTE_ETH_RX_OFFLOAD_TCP_CKSUM))
+			tun_offloads |= TUN_F_CSUM;
+		if (offloads & RTE_ETH_RX_OFFLOAD_TCP_LRO)
+			tun_offloads |= TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6;
+
+		if (ioctl(pmd->ka_fd, TUNSETOFFLOAD, tun_offloads) < 0) {
+			TAP_LOG(ERR, "%s: Unable to set TUNSETOFFLOAD: %s",
+				pmd->name, strerror(errno));
+			return -errno;
+		}
+	}
+
 	return 0;
 }
 
@@ -941,6 +1116,10 @@ tap_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	dev_info->min_rx_bufsize = 0;
 	dev_info->speed_capa = tap_dev_speed_capa();
 	dev_info->rx_queue_offload_capa = TAP_RX_OFFLOAD;
+	if (internals->vnet_hdr) {
+		dev_info->rx_queue_offload_capa |= RTE_ETH_RX_OFFLOAD_TCP_LRO;
+		dev_info->max_lro_pkt_size = UINT16_MAX;
+	}
 	dev_info->rx_offload_capa = dev_info->rx_queue_offload_capa;
 	dev_info->tx_queue_offload_capa = TAP_TX_OFFLOAD;
 	dev_info->tx_offload_capa = dev_info->tx_queue_offload_capa;
@@ -1062,6 +1241,8 @@ tap_dev_close(struct rte_eth_dev *dev)
 	for (i = 0; i < RTE_PMD_TAP_MAX_QUEUES; i++) {
 		struct rx_queue *rxq = &internals->rxq[i];
 
+		tap_uring_rxq_release(rxq);
+		tap_uring_txq_release(&internals->txq[i]);
 		tap_queue_close(process_private, i);
 
 		tap_rxq_pool_free(rxq->pool);
@@ -1124,6 +1305,7 @@ tap_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 
 	process_private = rte_eth_devices[rxq->in_port].process_private;
 
+	tap_uring_rxq_release(rxq);
 	tap_rxq_pool_free(rxq->pool);
 	rte_free(rxq->iovecs);
 	rxq->pool = NULL;
@@ -1143,6 +1325,7 @@ tap_tx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	process_private = rte_eth_devices[txq->out_port].process_private;
+	tap_uring_txq_release(txq);
 	if (dev->data->rx_queues[qid] == NULL)
 		tap_queue_close(process_private, qid);
 }
@@ -1556,8 +1739,22 @@ tap_rx_queue_setup(struct rte_eth_dev *dev,
 		goto error;
 	}
 
-	(*rxq->iovecs)[0].iov_len = sizeof(struct tun_pi);
-	(*rxq->iovecs)[0].iov_base = &rxq->pi;
+	rxq->hdr_len = internals->vnet_hdr ?
+		sizeof(rxq->hdr) : sizeof(rxq->hdr.pi);
+	(*rxq->iovecs)[0].iov_len = rxq->hdr_len;
+	(*rxq->iovecs)[0].iov_base = &rxq->hdr;
+
+	if (internals->io_uring) {
+		/* reads are posted with their own mbufs */
+		ret = tap_uring_rxq_setup(rxq, fd, nb_rx_desc,
+					  internals->sqpoll_idle, socket_id);
+		if (ret < 0) {
+			TAP_LOG(ERR, "%s: Unable to set up io_uring for queue %d",
+				dev->device->name, rx_queue_id);
+			goto error;
+		}
+		nb_desc = 0;
+	}
 
 	for (i = 1; i <= nb_desc; i++) {
 		*tmp = rte_pktmbuf_alloc(rxq->mp);
@@ -1587,6 +1784,7 @@ tap_rx_queue_setup(struct rte_eth_dev *dev,
 	return 0;
 
 error:
+	tap_uring_rxq_release(rxq);
 	tap_rxq_pool_free(rxq->pool);
 	rxq->pool = NULL;
 	rte_free(rxq->iovecs);
@@ -1597,8 +1795,8 @@ tap_rx_queue_setup(struct rte_eth_dev *dev,
 static int
 tap_tx_queue_setup(struct rte_eth_dev *dev,
 		   uint16_t tx_queue_id,
-		   uint16_t nb_tx_desc __rte_unused,
-		   unsigned int socket_id __rte_unused,
+		   uint16_t nb_tx_desc,
+		   unsigned int socket_id,
 		   const struct rte_eth_txconf *tx_conf)
 {
 	struct pmd_internals *internals = dev->data->dev_private;
@@ -1619,10 +1817,21 @@ tap_tx_queue_setup(struct rte_eth_dev *dev,
 			(RTE_ETH_TX_OFFLOAD_IPV4_CKSUM |
 			 RTE_ETH_TX_OFFLOAD_UDP_CKSUM |
 			 RTE_ETH_TX_OFFLOAD_TCP_CKSUM));
+	txq->vnet_hdr = !!internals->vnet_hdr;
 
 	ret = tap_setup_queue(dev, internals, tx_queue_id, 0);
 	if (ret == -1)
 		return -1;
+
+	if (internals->io_uring) {
+		ret = tap_uring_txq_setup(txq, ret, nb_tx_desc,
+					  internals->sqpoll_idle, socket_id);
+		if (ret < 0) {
+			TAP_LOG(ERR, "%s: Unable to set up io_uring for queue %d",
+				dev->device->name, tx_queue_id);
+			return ret;
+		}
+	}
 	TAP_LOG(DEBUG,
 		"  TX TUNTAP device name %s, qid %d on fd %d csum %s",
 		internals->name, tx_queue_id,
@@ -2009,7 +2218,8 @@ static const struct eth_dev_ops ops = {
 static int
 eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 		   char *remote_iface, struct rte_ether_addr *mac_addr,
-		   enum rte_tuntap_type type, int persist)
+		   enum rte_tuntap_type type, int persist, int vnet_hdr,
+		   int io_uring, int sqpoll_idle)
 {
 	int numa_node = rte_socket_id();
 	struct rte_eth_dev *dev;
@@ -2040,6 +2250,9 @@ eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 	pmd->dev = dev;
 	strlcpy(pmd->name, tap_name, sizeof(pmd->name));
 	pmd->type = type;
+	pmd->vnet_hdr = vnet_hdr;
+	pmd->io_uring = io_uring;
+	pmd->sqpoll_idle = sqpoll_idle;
 	pmd->ka_fd = -1;
 	pmd->nlsk_fd = -1;
 	pmd->gso_ctx_mp = NULL;
@@ -2065,7 +2278,7 @@ eth_dev_tap_create(struct rte_vdev_device *vdev, const char *tap_name,
 	data->nb_tx_queues = 0;
 
 	dev->dev_ops = &ops;
-	dev->rx_pkt_burst = pmd_rx_burst;
+	dev->rx_pkt_burst = io_uring ? tap_uring_rx_burst : pmd_rx_burst;
 	dev->tx_pkt_burst = pmd_tx_burst;
 
 	rte_intr_type_set(pmd->intr_handle, RTE_INTR_HANDLE_EXT);
@@ -2324,6 +2537,26 @@ set_mac_type(const char *key __rte_unused,
 	return -1;
 }
 
+static int
+set_sqpoll_idle(const char *key __rte_unused,
+		const char *value,
+		void *extra_args)
+{
+	int *sqpoll_idle = extra_args;
+	char *end;
+	long ms;
+
+	errno = 0;
+	ms = strtol(value, &end, 10);
+	if (errno != 0 || *end != '\0' || ms < 0 || ms > INT_MAX) {
+		TAP_LOG(ERR, "TAP invalid SQPOLL idle time (%s)", value);
+		return -1;
+	}
+
+	*sqpoll_idle = ms;
+	return 0;
+}
+
 /*
  * Open a TUN interface device. TUN PMD
  * 1) sets tap_type as false
@@ -2381,7 +2614,7 @@ rte_pmd_tun_probe(struct rte_vdev_device *dev)
 	TAP_LOG(DEBUG, "Initializing pmd_tun for %s", name);
 
 	ret = eth_dev_tap_create(dev, tun_name, remote_iface, 0,
-				 ETH_TUNTAP_TYPE_TUN, 0);
+				 ETH_TUNTAP_TYPE_TUN, 0, 0, 0, -1);
 
 leave:
 	if (ret == -1) {
@@ -2461,6 +2694,12 @@ tap_mp_sync_queues(const struct rte_mp_msg *request, const void *peer)
 	}
 	process_private = dev->process_private;
 
+	if (((struct pmd_internals *)dev->data->dev_private)->io_uring) {
+		TAP_LOG(ERR, "%s: io_uring mode does not support secondary processes",
+			request_param->port_name);
+		return -1;
+	}
+
 	/* Fill file descriptors for all queues */
 	reply.num_fds = 0;
 	reply_param->q_count = 0;
@@ -2505,6 +2744,9 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 	struct rte_eth_dev *eth_dev;
 	int tap_devices_count_increased = 0;
 	int persist = 0;
+	int vnet_hdr = 0;
+	int io_uring = 0;
+	int sqpoll_idle = -1;
 
 	name = rte_vdev_device_name(dev);
 	params = rte_vdev_device_args(dev);
@@ -2515,6 +2757,15 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 			TAP_LOG(ERR, "Failed to probe %s", name);
 			return -1;
 		}
+		/* io_uring rings are mapped in the primary process only
+		 * and its posted reads would race with secondary Rx
+		 */
+		if (((struct pmd_internals *)eth_dev->data->dev_private)->io_uring) {
+			TAP_LOG(ERR, "%s: io_uring mode does not support secondary processes",
+				name);
+			rte_eth_dev_release_port(eth_dev);
+			return -ENOTSUP;
+		}
 		eth_dev->dev_ops = &ops;
 		eth_dev->device = &dev->device;
 		eth_dev->rx_pkt_burst = pmd_rx_burst;
@@ -2588,6 +2839,30 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 
 			if (rte_kvargs_count(kvlist, ETH_TAP_PERSIST_ARG) == 1)
 				persist = 1;
+
+			if (rte_kvargs_count(kvlist, ETH_TAP_VNET_HDR_ARG) == 1)
+				vnet_hdr = 1;
+
+			if (rte_kvargs_count(kvlist, ETH_TAP_IO_URING_ARG) == 1)
+				io_uring = 1;
+
+			if (rte_kvargs_count(kvlist, ETH_TAP_SQPOLL_ARG) == 1) {
+				ret = rte_kvargs_process(kvlist,
+							 ETH_TAP_SQPOLL_ARG,
+							 &set_sqpoll_idle,
+							 &sqpoll_idle);
+				if (ret == -1)
+					goto leave;
+				io_uring = 1;
+			}
+
+#ifndef HAVE_LIBURING
+			if (io_uring) {
+				TAP_LOG(ERR, "TAP built without io_uring support");
+				ret = -1;
+				goto leave;
+			}
+#endif
 		}
 	}
 	pmd_link.link_speed = speed;
@@ -2606,7 +2881,8 @@ rte_pmd_tap_probe(struct rte_vdev_device *dev)
 	tap_devices_count++;
 	tap_devices_count_increased = 1;
 	ret = eth_dev_tap_create(dev, tap_name, remote_iface, &user_mac,
-				 ETH_TUNTAP_TYPE_TAP, persist);
+				 ETH_TUNTAP_TYPE_TAP, persist, vnet_hdr,
+				 io_uring, sqpoll_idle);
 
 leave:
 	if (ret == -1) {
@@ -2659,5 +2935,8 @@ RTE_PMD_REGISTER_PARAM_STRING(net_tun,
 RTE_PMD_REGISTER_PARAM_STRING(net_tap,
 			      ETH_TAP_IFACE_ARG "=<string> "
 			      ETH_TAP_MAC_ARG "=" ETH_TAP_MAC_ARG_FMT " "
-			      ETH_TAP_REMOTE_ARG "=<string>");
+			      ETH_TAP_REMOTE_ARG "=<string> "
+			      ETH_TAP_IO_URING_ARG " "
+			      ETH_TAP_SQPOLL_ARG "=<ms> "
+			      ETH_TAP_VNET_HDR_ARG);
 RTE_LOG_REGISTER_DEFAULT(tap_logtype, NOTICE);
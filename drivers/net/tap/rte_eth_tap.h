@@ -12,6 +12,7 @@
 #include <net/if.h>
 
 #include <linux/if_tun.h>
+#include <linux/virtio_net.h>
 
 #include <ethdev_driver.h>
 #include <rte_ether.h>
@@ -43,6 +44,14 @@ struct pkt_stats {
 	uint64_t rx_nombuf;             /* Nb of RX mbuf alloc failures */
 };
 
+/* Header preceding the packet data on a queue fd */
+struct tap_pkt_hdr {
+	struct tun_pi pi;               /* packet info, always present */
+	struct virtio_net_hdr vnet;     /* only present with IFF_VNET_HDR */
+};
+
+struct tap_uring;
+
 struct rx_queue {
 	struct rte_mempool *mp;         /* Mempool for RX packets */
 	uint32_t trigger_seen;          /* Last seen Rx trigger value */
@@ -53,17 +62,21 @@ struct rx_queue {
 	struct rte_eth_rxmode *rxmode;  /* RX features */
 	struct rte_mbuf *pool;          /* mbufs pool for this queue */
 	struct iovec (*iovecs)[];       /* descriptors for this queue */
-	struct tun_pi pi;               /* packet info for iovecs */
+	struct tap_pkt_hdr hdr;         /* packet info for iovecs */
+	uint16_t hdr_len;               /* length of hdr read from the fd */
+	struct tap_uring *uring;        /* io_uring datapath, if enabled */
 };
 
 struct tx_queue {
 	int type;                       /* Type field - TUN|TAP */
 	uint16_t *mtu;                  /* Pointer to MTU from dev_data */
 	uint16_t csum:1;                /* Enable checksum offloading */
+	uint16_t vnet_hdr:1;            /* Offloads handed to the kernel */
 	struct pkt_stats stats;         /* Stats for this TX queue */
 	struct rte_gso_ctx gso_ctx;     /* GSO context */
 	uint16_t out_port;              /* Port ID */
 	uint16_t queue_id;		/* queue ID*/
+	struct tap_uring *uring;        /* io_uring datapath, if enabled */
 };
 
 struct pmd_internals {
@@ -72,6 +85,9 @@ struct pmd_internals {
 	char name[RTE_ETH_NAME_MAX_LEN];  /* Internal Tap device name */
 	int type;                         /* Type field - TUN|TAP */
 	int persist;			  /* 1 if keep link up, else 0 */
+	int vnet_hdr;			  /* 1 if IFF_VNET_HDR is set, else 0 */
+	int io_uring;			  /* 1 if queues use io_uring, else 0 */
+	int sqpoll_idle;		  /* SQPOLL idle time (ms), -1 if off */
 	struct rte_ether_addr eth_addr;   /* Mac address of the device port */
 	unsigned int remote_initial_flags;/* Remote netdevice flags on init */
 	int remote_if_index;              /* remote netdevice IF_INDEX */
@@ -99,6 +115,11 @@ struct pmd_process_private {
 	int fds[RTE_PMD_TAP_MAX_QUEUES];
 };
 
+/* rte_eth_tap.c */
+
+void tap_rx_offload(struct rx_queue *rxq, const struct tap_pkt_hdr *hdr,
+		    struct rte_mbuf *mbuf);
+
 /* tap_intr.c */
 
 int tap_rx_intr_vec_set(struct rte_eth_dev *dev, int set);
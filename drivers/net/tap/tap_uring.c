@@ -0,0 +1,460 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+/**
+ * @file
+ * io_uring based datapath for tap driver.
+ *
+ * Rx keeps one read posted per descriptor, each into a free mbuf, so that
+ * a burst only harvests completions from the shared ring and re-posts the
+ * consumed buffers with a single submission. Tx queues one writev per
+ * packet and submits the whole burst at once. With SQPOLL a kernel thread
+ * picks up submissions, and the datapath makes no system call at all.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <liburing.h>
+
+#include <rte_eth_tap.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+
+#include "tap_uring.h"
+
+#define TAP_URING_MAX_BUFS	64	/* registered mempool memory chunks */
+#define TAP_URING_MAX_SEGS	16	/* Tx segments per queued request */
+#define TAP_URING_RX_BURST	64	/* completions harvested at once */
+#define TAP_URING_DRAIN_MS	100	/* wait for cancelled requests */
+#define TAP_URING_MAX_ENTRIES	32768	/* kernel IORING_MAX_ENTRIES */
+
+/* Tx request in flight, owning a reference on its mbuf */
+struct tap_uring_slot {
+	struct rte_mbuf *mbuf;
+	struct tap_pkt_hdr hdr;
+	struct iovec iov[TAP_URING_MAX_SEGS + 1];
+};
+
+struct tap_uring {
+	struct io_uring ring;
+	int fd;                         /* queue fd */
+	uint32_t inflight;              /* requests owned by the kernel */
+	uint16_t nb_bufs;               /* registered buffers, 0 if none */
+	struct iovec bufs[TAP_URING_MAX_BUFS];
+	uint16_t nb_slots;              /* Tx slots */
+	uint16_t nb_free;               /* Tx slots not in flight */
+	struct tap_uring_slot **free;   /* stack of free Tx slots */
+	struct tap_uring_slot slots[];
+};
+
+static void
+tap_uring_mem_cb(struct rte_mempool *mp __rte_unused, void *opaque,
+		 struct rte_mempool_memhdr *memhdr, unsigned int mem_idx)
+{
+	struct tap_uring *u = opaque;
+
+	if (mem_idx < TAP_URING_MAX_BUFS) {
+		u->bufs[mem_idx].iov_base = memhdr->addr;
+		u->bufs[mem_idx].iov_len = memhdr->len;
+	}
+}
+
+/* Register the memory of a mempool, so the kernel pins it only once */
+static void
+tap_uring_register_pool(struct tap_uring *u, struct rte_mempool *mp)
+{
+	unsigned int n;
+	int ret;
+
+	n = rte_mempool_mem_iter(mp, tap_uring_mem_cb, u);
+	if (n > TAP_URING_MAX_BUFS) {
+		TAP_LOG(DEBUG, "%s: %u memory chunks, buffers not registered",
+			mp->name, n);
+		return;
+	}
+
+	ret = io_uring_register_buffers(&u->ring, u->bufs, n);
+	if (ret < 0) {
+		TAP_LOG(DEBUG, "%s: cannot register buffers: %s",
+			mp->name, strerror(-ret));
+		return;
+	}
+
+	u->nb_bufs = n;
+}
+
+static inline int
+tap_uring_buf_index(const struct tap_uring *u, const void *addr)
+{
+	uint16_t i;
+
+	for (i = 0; i < u->nb_bufs; i++) {
+		uintptr_t base = (uintptr_t)u->bufs[i].iov_base;
+
+		if ((uintptr_t)addr - base < u->bufs[i].iov_len)
+			return i;
+	}
+
+	return -1;
+}
+
+static struct tap_uring *
+tap_uring_create(int fd, uint16_t nb_desc, uint16_t nb_slots,
+		 int sqpoll_idle, unsigned int socket_id)
+{
+	struct io_uring_params params;
+	struct tap_uring *u;
+	size_t size;
+	int flags;
+	int ret;
+	uint16_t i;
+
+	nb_desc = RTE_MIN(nb_desc, TAP_URING_MAX_ENTRIES);
+	nb_slots = RTE_MIN(nb_slots, nb_desc);
+
+	/* io_uring waits for packets itself, it must not see EAGAIN */
+	flags = fcntl(fd, F_GETFL);
+	if (flags < 0 ||
+	    fcntl(fd, F_SETFL, flags & ~(O_NONBLOCK | O_ASYNC)) < 0) {
+		TAP_LOG(ERR, "Unable to set fd %d blocking: %s",
+			fd, strerror(errno));
+		return NULL;
+	}
+
+	size = sizeof(*u) + nb_slots *
+		(sizeof(struct tap_uring_slot) + sizeof(struct tap_uring_slot *));
+	u = rte_zmalloc_socket("tap_uring", size, RTE_CACHE_LINE_SIZE,
+			       socket_id);
+	if (u == NULL)
+		return NULL;
+
+	memset(&params, 0, sizeof(params));
+	if (sqpoll_idle >= 0) {
+		params.flags |= IORING_SETUP_SQPOLL;
+		params.sq_thread_idle = sqpoll_idle;
+	}
+
+	ret = io_uring_queue_init_params(nb_desc, &u->ring, &params);
+	if (ret < 0) {
+		TAP_LOG(ERR, "Unable to create io_uring of %u entries: %s",
+			nb_desc, strerror(-ret));
+		rte_free(u);
+		return NULL;
+	}
+
+	u->fd = fd;
+	u->nb_slots = nb_slots;
+	u->nb_free = nb_slots;
+	u->free = (struct tap_uring_slot **)&u->slots[nb_slots];
+	for (i = 0; i < nb_slots; i++)
+		u->free[i] = &u->slots[i];
+
+	return u;
+}
+
+/*
+ * Cancel the requests still owned by the kernel and wait for them, so
+ * that no buffer is written once the ring is gone.
+ */
+static void
+tap_uring_destroy(struct tap_uring *u, bool rx)
+{
+	struct __kernel_timespec ts = {
+		.tv_nsec = TAP_URING_DRAIN_MS * 1000 * 1000,
+	};
+	struct io_uring_sqe *sqe;
+	struct io_uring_cqe *cqe;
+
+	sqe = io_uring_get_sqe(&u->ring);
+	if (sqe != NULL) {
+		io_uring_prep_cancel(sqe, NULL, IORING_ASYNC_CANCEL_ANY);
+		io_uring_sqe_set_data(sqe, u);
+		io_uring_submit(&u->ring);
+	}
+
+	while (u->inflight > 0 &&
+	       io_uring_wait_cqe_timeout(&u->ring, &cqe, &ts) == 0) {
+		void *data = io_uring_cqe_get_data(cqe);
+
+		io_uring_cqe_seen(&u->ring, cqe);
+		if (data == u)
+			continue;
+
+		u->inflight--;
+		if (rx)
+			rte_pktmbuf_free(data);
+		else
+			rte_pktmbuf_free(((struct tap_uring_slot *)data)->mbuf);
+	}
+
+	if (u->inflight > 0)
+		TAP_LOG(WARNING, "fd %d: %u io_uring requests not completed",
+			u->fd, u->inflight);
+
+	io_uring_queue_exit(&u->ring);
+	rte_free(u);
+}
+
+/* Post a read of a whole packet, its tap header going to the headroom */
+static inline int
+tap_uring_rx_post(struct tap_uring *u, struct rte_mbuf *mbuf,
+		  uint16_t hdr_len)
+{
+	struct io_uring_sqe *sqe;
+	char *buf;
+	unsigned int len;
+	int idx;
+
+	sqe = io_uring_get_sqe(&u->ring);
+	if (unlikely(sqe == NULL))
+		return -1;
+
+	buf = rte_pktmbuf_mtod(mbuf, char *) - hdr_len;
+	len = hdr_len + rte_pktmbuf_tailroom(mbuf);
+
+	idx = tap_uring_buf_index(u, buf);
+	if (idx >= 0)
+		io_uring_prep_read_fixed(sqe, u->fd, buf, len, 0, idx);
+	else
+		io_uring_prep_read(sqe, u->fd, buf, len, 0);
+	io_uring_sqe_set_data(sqe, mbuf);
+	u->inflight++;
+
+	return 0;
+}
+
+int
+tap_uring_rxq_setup(struct rx_queue *rxq, int fd, uint16_t nb_desc,
+		    int sqpoll_idle, unsigned int socket_id)
+{
+	struct tap_uring *u;
+	struct rte_mbuf *mbuf;
+	unsigned int i;
+
+	if (rxq->hdr_len > RTE_PKTMBUF_HEADROOM)
+		return -EINVAL;
+
+	u = tap_uring_create(fd, nb_desc, 0, sqpoll_idle, socket_id);
+	if (u == NULL)
+		return -ENOMEM;
+
+	tap_uring_register_pool(u, rxq->mp);
+
+	for (i = 0; i < u->ring.sq.ring_entries; i++) {
+		mbuf = rte_pktmbuf_alloc(rxq->mp);
+		if (mbuf == NULL)
+			break;
+		if (tap_uring_rx_post(u, mbuf, rxq->hdr_len) < 0) {
+			rte_pktmbuf_free(mbuf);
+			break;
+		}
+	}
+	io_uring_submit(&u->ring);
+
+	if (u->inflight == 0) {
+		tap_uring_destroy(u, true);
+		return -ENOMEM;
+	}
+
+	rxq->uring = u;
+
+	return 0;
+}
+
+void
+tap_uring_rxq_release(struct rx_queue *rxq)
+{
+	if (rxq->uring == NULL)
+		return;
+
+	tap_uring_destroy(rxq->uring, true);
+	rxq->uring = NULL;
+}
+
+uint16_t
+tap_uring_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct rx_queue *rxq = queue;
+	struct tap_uring *u = rxq->uring;
+	struct io_uring_cqe *cqes[TAP_URING_RX_BURST];
+	struct rte_mbuf *fresh[TAP_URING_RX_BURST];
+	unsigned long num_rx_bytes = 0;
+	uint16_t hdr_len = rxq->hdr_len;
+	uint16_t num_rx = 0;
+	unsigned int nb, i;
+	bool refill = true;
+
+	nb = io_uring_peek_batch_cqe(&u->ring, cqes,
+				     RTE_MIN(nb_pkts, TAP_URING_RX_BURST));
+	if (nb == 0)
+		return 0;
+
+	/* Without replacement buffers, received ones are posted again */
+	if (unlikely(rte_pktmbuf_alloc_bulk(rxq->mp, fresh, nb) != 0)) {
+		rxq->stats.rx_nombuf += nb;
+		refill = false;
+	}
+
+	for (i = 0; i < nb; i++) {
+		struct rte_mbuf *mbuf = io_uring_cqe_get_data(cqes[i]);
+		const struct tap_pkt_hdr *hdr;
+		int len = cqes[i]->res;
+
+		u->inflight--;
+		hdr = (const void *)(rte_pktmbuf_mtod(mbuf, char *) - hdr_len);
+
+		if (unlikely(!refill || len < (int)hdr_len ||
+			     (hdr->pi.flags & TUN_PKT_STRIP))) {
+			/* Packet couldn't fit in the provided mbuf */
+			if (len >= (int)hdr_len)
+				rxq->stats.ierrors++;
+			tap_uring_rx_post(u, mbuf, hdr_len);
+			if (refill)
+				rte_pktmbuf_free(fresh[i]);
+			continue;
+		}
+
+		len -= hdr_len;
+		mbuf->data_len = len;
+		mbuf->pkt_len = len;
+		mbuf->port = rxq->in_port;
+		tap_rx_offload(rxq, hdr, mbuf);
+
+		bufs[num_rx++] = mbuf;
+		num_rx_bytes += len;
+
+		tap_uring_rx_post(u, fresh[i], hdr_len);
+	}
+
+	io_uring_cq_advance(&u->ring, nb);
+	io_uring_submit(&u->ring);
+
+	rxq->stats.ipackets += num_rx;
+	rxq->stats.ibytes += num_rx_bytes;
+
+	return num_rx;
+}
+
+int
+tap_uring_txq_setup(struct tx_queue *txq, int fd, uint16_t nb_desc,
+		    int sqpoll_idle, unsigned int socket_id)
+{
+	struct tap_uring *u;
+
+	u = tap_uring_create(fd, nb_desc, nb_desc, sqpoll_idle, socket_id);
+	if (u == NULL)
+		return -ENOMEM;
+
+	txq->uring = u;
+
+	return 0;
+}
+
+void
+tap_uring_txq_release(struct tx_queue *txq)
+{
+	if (txq->uring == NULL)
+		return;
+
+	tap_uring_destroy(txq->uring, false);
+	txq->uring = NULL;
+}
+
+/* Release the slots of completed writes */
+static inline void
+tap_uring_tx_reap(struct tx_queue *txq)
+{
+	struct tap_uring *u = txq->uring;
+	struct io_uring_cqe *cqe;
+	unsigned int head, nb = 0;
+
+	io_uring_for_each_cqe(&u->ring, head, cqe) {
+		struct tap_uring_slot *slot = io_uring_cqe_get_data(cqe);
+
+		if (unlikely(cqe->res < 0))
+			txq->stats.errs++;
+		rte_pktmbuf_free(slot->mbuf);
+		u->free[u->nb_free++] = slot;
+		nb++;
+	}
+
+	io_uring_cq_advance(&u->ring, nb);
+	u->inflight -= nb;
+}
+
+/*
+ * Queue the write of a packet, described by iov, the first entry being
+ * the tap header. The mbuf stays referenced until the write completes.
+ * Return the number of bytes queued, -1 on error.
+ */
+int
+tap_uring_write(struct tx_queue *txq, struct rte_mbuf *mbuf,
+		const struct iovec *iov, int iovcnt)
+{
+	struct tap_uring *u = txq->uring;
+	struct tap_uring_slot *slot;
+	struct io_uring_sqe *sqe;
+	struct rte_mbuf *seg;
+	ssize_t len = 0;
+	int i;
+
+	if (unlikely(iovcnt > TAP_URING_MAX_SEGS + 1)) {
+		/* Keep ordering with writes still queued */
+		while (u->inflight > 0) {
+			io_uring_submit_and_wait(&u->ring, 1);
+			tap_uring_tx_reap(txq);
+		}
+		return writev(u->fd, iov, iovcnt);
+	}
+
+	if (u->nb_free == 0) {
+		tap_uring_tx_reap(txq);
+		if (u->nb_free == 0) {
+			io_uring_submit_and_wait(&u->ring, 1);
+			tap_uring_tx_reap(txq);
+		}
+	}
+
+	sqe = io_uring_get_sqe(&u->ring);
+	if (unlikely(sqe == NULL)) {
+		io_uring_submit(&u->ring);
+		sqe = io_uring_get_sqe(&u->ring);
+	}
+	if (unlikely(sqe == NULL || u->nb_free == 0))
+		return -1;
+
+	slot = u->free[--u->nb_free];
+	memcpy(&slot->hdr, iov[0].iov_base, iov[0].iov_len);
+	slot->iov[0].iov_base = &slot->hdr;
+	slot->iov[0].iov_len = iov[0].iov_len;
+	for (i = 0; i < iovcnt; i++) {
+		if (i > 0)
+			slot->iov[i] = iov[i];
+		len += iov[i].iov_len;
+	}
+
+	/* the caller frees the packet after queuing it */
+	for (seg = mbuf; seg != NULL; seg = seg->next)
+		rte_mbuf_refcnt_update(seg, 1);
+	slot->mbuf = mbuf;
+
+	io_uring_prep_writev(sqe, u->fd, slot->iov, iovcnt, 0);
+	io_uring_sqe_set_data(sqe, slot);
+	u->inflight++;
+
+	return len;
+}
+
+void
+tap_uring_tx_flush(struct tx_queue *txq)
+{
+	io_uring_submit(&txq->uring->ring);
+	tap_uring_tx_reap(txq);
+}
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef _TAP_URING_H_
+#define _TAP_URING_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <rte_eth_tap.h>
+
+#ifdef HAVE_LIBURING
+
+int tap_uring_rxq_setup(struct rx_queue *rxq, int fd, uint16_t nb_desc,
+			int sqpoll_idle, unsigned int socket_id);
+void tap_uring_rxq_release(struct rx_queue *rxq);
+uint16_t tap_uring_rx_burst(void *queue, struct rte_mbuf **bufs,
+			    uint16_t nb_pkts);
+
+int tap_uring_txq_setup(struct tx_queue *txq, int fd, uint16_t nb_desc,
+			int sqpoll_idle, unsigned int socket_id);
+void tap_uring_txq_release(struct tx_queue *txq);
+int tap_uring_write(struct tx_queue *txq, struct rte_mbuf *mbuf,
+		    const struct iovec *iov, int iovcnt);
+void tap_uring_tx_flush(struct tx_queue *txq);
+
+#else
+
+static inline int
+tap_uring_rxq_setup(struct rx_queue *rxq __rte_unused, int fd __rte_unused,
+		    uint16_t nb_desc __rte_unused, int sqpoll_idle __rte_unused,
+		    unsigned int socket_id __rte_unused)
+{
+	return -ENOTSUP;
+}
+
+static inline void
+tap_uring_rxq_release(struct rx_queue *rxq __rte_unused)
+{
+}
+
+static inline uint16_t
+tap_uring_rx_burst(void *queue __rte_unused, struct rte_mbuf **bufs __rte_unused,
+		   uint16_t nb_pkts __rte_unused)
+{
+	return 0;
+}
+
+static inline int
+tap_uring_txq_setup(struct tx_queue *txq __rte_unused, int fd __rte_unused,
+		    uint16_t nb_desc __rte_unused, int sqpoll_idle __rte_unused,
+		    unsigned int socket_id __rte_unused)
+{
+	return -ENOTSUP;
+}
+
+static inline void
+tap_uring_txq_release(struct tx_queue *txq __rte_unused)
+{
+}
+
+static inline int
+tap_uring_write(struct tx_queue *txq __rte_unused,
+		struct rte_mbuf *mbuf __rte_unused,
+		const struct iovec *iov __rte_unused, int iovcnt __rte_unused)
+{
+	return -1;
+}
+
+static inline void
+tap_uring_tx_flush(struct tx_queue *txq __rte_unused)
+{
+}
+
+#endif /* HAVE_LIBURING */
+
+#endif /* _TAP_URING_H_ */
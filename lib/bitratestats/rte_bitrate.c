@@ -2,11 +2,19 @@
  * Copyright(c) 2017 Intel Corporation
  */
 
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <eal_export.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_ethdev.h>
 #include <rte_malloc.h>
 #include <rte_metrics.h>
+#include <rte_telemetry.h>
 #include <rte_bitrate.h>
 
 /*
@@ -24,11 +32,73 @@ struct rte_stats_bitrate {
 	uint64_t ewma_obits;
 };
 
+/* Per queue counters, as found in the queue xstats. */
+enum bitrate_queue_counter {
+	BITRATE_RX_PACKETS,
+	BITRATE_RX_BYTES,
+	BITRATE_TX_PACKETS,
+	BITRATE_TX_BYTES,
+	BITRATE_QUEUE_COUNTERS
+};
+
+static const struct {
+	const char *dir;
+	const char *xstat;
+} bitrate_queue_xstats[BITRATE_QUEUE_COUNTERS] = {
+	{ "rx", "packets" }, { "rx", "bytes" }, { "tx", "packets" }, { "tx", "bytes" },
+};
+
+/*
+ * Rates are averaged over each window with an exponential decay, as load
+ * averages: a sample taken dt seconds after the previous one is weighted
+ * by 1 - exp(-dt / window), whatever the period rates are computed at.
+ */
+static const struct {
+	const char *name;
+	double seconds;
+} bitrate_windows[] = {
+	{ "1s", 1 },
+	{ "10s", 10 },
+	{ "60s", 60 },
+};
+
+#define BITRATE_NB_WINDOWS RTE_DIM(bitrate_windows)
+
+/* Rates of a counter: one per window, then the peak of the shortest one. */
+#define BITRATE_NB_RATES (BITRATE_NB_WINDOWS + 1)
+
+/* Metrics registered per queue: packets and bits, for Rx and Tx. */
+#define BITRATE_QUEUE_METRICS (BITRATE_QUEUE_COUNTERS * BITRATE_NB_RATES)
+
+struct rte_stats_bitrate_queue {
+	uint64_t last[BITRATE_QUEUE_COUNTERS];
+	/* In packets or bits per second */
+	double rates[BITRATE_QUEUE_COUNTERS][BITRATE_NB_RATES];
+};
+
+struct rte_stats_bitrate_queues {
+	uint64_t last_tsc;
+	uint16_t nb_rxq;
+	uint16_t nb_txq;
+	/* Number of valid entries in ids, grouped by queue */
+	uint16_t nb_ids;
+	uint64_t ids[RTE_STATS_BITRATE_MAX_QUEUES * BITRATE_QUEUE_COUNTERS];
+	uint64_t values[RTE_STATS_BITRATE_MAX_QUEUES * BITRATE_QUEUE_COUNTERS];
+	struct rte_stats_bitrate_queue queues[RTE_STATS_BITRATE_MAX_QUEUES];
+};
+
 struct rte_stats_bitrates {
 	struct rte_stats_bitrate port_stats[RTE_MAX_ETHPORTS];
 	uint16_t id_stats_set;
+	uint16_t id_queue_stats_set;
+	uint16_t nb_reg_queues;
+	/* Allocated on the first rte_stats_bitrate_queue_calc() of a port */
+	struct rte_stats_bitrate_queues *queue_stats[RTE_MAX_ETHPORTS];
 };
 
+/* Stats reported by telemetry, the last ones registered per queue. */
+static struct rte_stats_bitrates *telemetry_bitrates;
+
 RTE_EXPORT_SYMBOL(rte_stats_bitrate_create)
 struct rte_stats_bitrates *
 rte_stats_bitrate_create(void)
@@ -41,6 +111,16 @@ RTE_EXPORT_SYMBOL(rte_stats_bitrate_free)
 void
 rte_stats_bitrate_free(struct rte_stats_bitrates *bitrate_data)
 {
+	uint16_t port_id;
+
+	if (bitrate_data == NULL)
+		return;
+
+	if (telemetry_bitrates == bitrate_data)
+		telemetry_bitrates = NULL;
+
+	for (port_id = 0; port_id < RTE_MAX_ETHPORTS; port_id++)
+		rte_free(bitrate_data->queue_stats[port_id]);
 	rte_free(bitrate_data);
 }
 
@@ -143,3 +223,303 @@ rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 
 	return 0;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_stats_bitrate_queue_reg, 26.03)
+int
+rte_stats_bitrate_queue_reg(struct rte_stats_bitrates *bitrate_data,
+			    uint16_t nb_queues)
+{
+	static const char * const dirs[] = { "rx", "tx" };
+	static const char * const units[] = { "packets", "bits" };
+	char names[RTE_STATS_BITRATE_MAX_QUEUES * BITRATE_QUEUE_METRICS]
+		[RTE_METRICS_MAX_NAME_LEN];
+	const char *ptr_names[RTE_STATS_BITRATE_MAX_QUEUES * BITRATE_QUEUE_METRICS];
+	unsigned int q, d, u, w, n = 0;
+	int ret;
+
+	if (bitrate_data == NULL || nb_queues == 0 ||
+			nb_queues > RTE_STATS_BITRATE_MAX_QUEUES)
+		return -EINVAL;
+
+	/* Same order as the values published by rte_stats_bitrate_queue_calc() */
+	for (q = 0; q < nb_queues; q++) {
+		for (d = 0; d < RTE_DIM(dirs); d++) {
+			for (u = 0; u < RTE_DIM(units); u++) {
+				for (w = 0; w < BITRATE_NB_RATES; w++) {
+					snprintf(names[n], sizeof(names[n]), "%s_q%u_%s_%s",
+						dirs[d], q, units[u],
+						w < BITRATE_NB_WINDOWS ?
+							bitrate_windows[w].name : "peak");
+					ptr_names[n] = names[n];
+					n++;
+				}
+			}
+		}
+	}
+
+	ret = rte_metrics_reg_names(ptr_names, n);
+	if (ret < 0)
+		return ret;
+
+	bitrate_data->id_queue_stats_set = ret;
+	bitrate_data->nb_reg_queues = nb_queues;
+	telemetry_bitrates = bitrate_data;
+
+	return 0;
+}
+
+/* Look up the ids of the queue counters in the port xstats. */
+static int
+bitrate_queue_ids(struct rte_stats_bitrate_queues *qstats, uint16_t port_id,
+		  uint16_t nb_rxq, uint16_t nb_txq)
+{
+	uint16_t nb_queues = RTE_MAX(nb_rxq, nb_txq);
+	struct rte_eth_xstat_name *xstats_names;
+	char name[RTE_ETH_XSTATS_NAME_SIZE];
+	int nb_xstats, ret = 0;
+	unsigned int q, c, i;
+
+	memset(qstats, 0, sizeof(*qstats));
+
+	nb_xstats = rte_eth_xstats_get_names(port_id, NULL, 0);
+	if (nb_xstats < 0)
+		return nb_xstats;
+
+	xstats_names = calloc(nb_xstats, sizeof(xstats_names[0]));
+	if (xstats_names == NULL)
+		return -ENOMEM;
+
+	if (rte_eth_xstats_get_names(port_id, xstats_names, nb_xstats) != nb_xstats) {
+		ret = -EIO;
+		goto out;
+	}
+
+	for (q = 0; q < nb_queues; q++) {
+		for (c = 0; c < BITRATE_QUEUE_COUNTERS; c++) {
+			uint64_t *id = &qstats->ids[q * BITRATE_QUEUE_COUNTERS + c];
+			bool rx = c < BITRATE_TX_PACKETS;
+
+			/* A direction with less queues reads any counter, unused */
+			if ((rx && q >= nb_rxq) || (!rx && q >= nb_txq))
+				continue;
+
+			snprintf(name, sizeof(name), "%s_q%u_%s",
+				bitrate_queue_xstats[c].dir, q, bitrate_queue_xstats[c].xstat);
+			for (i = 0; i < (unsigned int)nb_xstats; i++) {
+				if (strcmp(xstats_names[i].name, name) == 0)
+					break;
+			}
+			if (i == (unsigned int)nb_xstats) {
+				ret = -ENOTSUP;
+				goto out;
+			}
+			*id = i;
+		}
+	}
+
+	qstats->nb_rxq = nb_rxq;
+	qstats->nb_txq = nb_txq;
+	qstats->nb_ids = nb_queues * BITRATE_QUEUE_COUNTERS;
+
+out:
+	free(xstats_names);
+	return ret;
+}
+
+static void
+bitrate_queue_update(struct rte_stats_bitrate_queue *queue, const uint64_t *values,
+		     const double *decay, double seconds)
+{
+	unsigned int c, w;
+
+	for (c = 0; c < BITRATE_QUEUE_COUNTERS; c++) {
+		double *rates = queue->rates[c];
+		uint64_t delta;
+		double rate;
+
+		/* Counters restart from 0 when the port stats are reset */
+		delta = values[c] >= queue->last[c] ? values[c] - queue->last[c] : values[c];
+		queue->last[c] = values[c];
+		rate = (double)delta / seconds;
+		if (c == BITRATE_RX_BYTES || c == BITRATE_TX_BYTES)
+			rate *= 8;
+
+		for (w = 0; w < BITRATE_NB_WINDOWS; w++)
+			rates[w] = rate + (rates[w] - rate) * decay[w];
+		rates[BITRATE_NB_WINDOWS] = RTE_MAX(rates[BITRATE_NB_WINDOWS], rates[0]);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_stats_bitrate_queue_calc, 26.03)
+int
+rte_stats_bitrate_queue_calc(struct rte_stats_bitrates *bitrate_data,
+			     uint16_t port_id)
+{
+	uint64_t values[RTE_STATS_BITRATE_MAX_QUEUES * BITRATE_QUEUE_METRICS] = { 0 };
+	double decay[BITRATE_NB_WINDOWS];
+	struct rte_stats_bitrate_queues *qstats;
+	struct rte_eth_dev_info dev_info;
+	uint16_t nb_rxq, nb_txq;
+	unsigned int q, c, w;
+	uint64_t now;
+	double seconds;
+	int ret;
+
+	if (bitrate_data == NULL)
+		return -EINVAL;
+
+	ret = rte_eth_dev_info_get(port_id, &dev_info);
+	if (ret != 0)
+		return ret;
+
+	qstats = bitrate_data->queue_stats[port_id];
+	if (qstats == NULL) {
+		qstats = rte_zmalloc(NULL, sizeof(*qstats), RTE_CACHE_LINE_SIZE);
+		if (qstats == NULL)
+			return -ENOMEM;
+		bitrate_data->queue_stats[port_id] = qstats;
+	}
+
+	/* Queue xstats ids change with the number of queues */
+	nb_rxq = RTE_MIN(dev_info.nb_rx_queues, RTE_STATS_BITRATE_MAX_QUEUES);
+	nb_txq = RTE_MIN(dev_info.nb_tx_queues, RTE_STATS_BITRATE_MAX_QUEUES);
+	if (qstats->nb_ids == 0 || nb_rxq != qstats->nb_rxq || nb_txq != qstats->nb_txq) {
+		ret = bitrate_queue_ids(qstats, port_id, nb_rxq, nb_txq);
+		if (ret != 0)
+			return ret;
+	}
+	if (qstats->nb_ids == 0)
+		return 0;
+
+	/* A single query for all the queue counters */
+	ret = rte_eth_xstats_get_by_id(port_id, qstats->ids, qstats->values,
+				       qstats->nb_ids);
+	if (ret < 0)
+		return ret;
+	if (ret != qstats->nb_ids)
+		return -EIO;
+
+	now = rte_get_tsc_cycles();
+	if (qstats->last_tsc == 0) {
+		/* First sample, only record the counters */
+		for (q = 0; q < qstats->nb_ids / BITRATE_QUEUE_COUNTERS; q++)
+			memcpy(qstats->queues[q].last,
+			       &qstats->values[q * BITRATE_QUEUE_COUNTERS],
+			       sizeof(qstats->queues[q].last));
+		qstats->last_tsc = now;
+		return 0;
+	}
+	if (now == qstats->last_tsc)
+		return 0;
+
+	seconds = (double)(now - qstats->last_tsc) / rte_get_tsc_hz();
+	qstats->last_tsc = now;
+	for (w = 0; w < BITRATE_NB_WINDOWS; w++)
+		decay[w] = exp(-seconds / bitrate_windows[w].seconds);
+
+	for (q = 0; q < qstats->nb_ids / BITRATE_QUEUE_COUNTERS; q++)
+		bitrate_queue_update(&qstats->queues[q],
+				     &qstats->values[q * BITRATE_QUEUE_COUNTERS],
+				     decay, seconds);
+
+	if (bitrate_data->nb_reg_queues == 0)
+		return 0;
+
+	for (q = 0; q < bitrate_data->nb_reg_queues; q++) {
+		for (c = 0; c < BITRATE_QUEUE_COUNTERS; c++) {
+			bool rx = c < BITRATE_TX_PACKETS;
+
+			/* Rates of a missing queue are left at 0 */
+			if ((rx && q >= nb_rxq) || (!rx && q >= nb_txq))
+				continue;
+			for (w = 0; w < BITRATE_NB_RATES; w++)
+				values[(q * BITRATE_QUEUE_COUNTERS + c) * BITRATE_NB_RATES + w] =
+					llround(qstats->queues[q].rates[c][w]);
+		}
+	}
+
+	ret = rte_metrics_update_values(port_id, bitrate_data->id_queue_stats_set,
+		values, bitrate_data->nb_reg_queues * BITRATE_QUEUE_METRICS);
+	if (ret < 0)
+		return ret;
+
+	return 0;
+}
+
+static int
+bitrate_handle_queues(const char *cmd __rte_unused, const char *params,
+		      struct rte_tel_data *d)
+{
+	static const char * const counter_names[BITRATE_QUEUE_COUNTERS] = {
+		"packets", "bits", "packets", "bits",
+	};
+	struct rte_stats_bitrates *bitrate_data = telemetry_bitrates;
+	struct rte_stats_bitrate_queues *qstats;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	unsigned long port_id;
+	unsigned int q, c, w;
+	char *end_param;
+
+	if (bitrate_data == NULL || params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	port_id = strtoul(params, &end_param, 0);
+	if (*end_param != '\0' || port_id >= RTE_MAX_ETHPORTS)
+		return -EINVAL;
+
+	qstats = bitrate_data->queue_stats[port_id];
+	if (qstats == NULL)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+	for (q = 0; q < RTE_MAX(qstats->nb_rxq, qstats->nb_txq); q++) {
+		struct rte_tel_data *rx = NULL, *tx = NULL;
+
+		if (q < qstats->nb_rxq) {
+			rx = rte_tel_data_alloc();
+			if (rx == NULL)
+				return -ENOMEM;
+			rte_tel_data_start_dict(rx);
+		}
+		if (q < qstats->nb_txq) {
+			tx = rte_tel_data_alloc();
+			if (tx == NULL) {
+				rte_tel_data_free(rx);
+				return -ENOMEM;
+			}
+			rte_tel_data_start_dict(tx);
+		}
+
+		for (c = 0; c < BITRATE_QUEUE_COUNTERS; c++) {
+			struct rte_tel_data *dir = c < BITRATE_TX_PACKETS ? rx : tx;
+
+			if (dir == NULL)
+				continue;
+			for (w = 0; w < BITRATE_NB_RATES; w++) {
+				snprintf(name, sizeof(name), "%s_%s", counter_names[c],
+					w < BITRATE_NB_WINDOWS ?
+						bitrate_windows[w].name : "peak");
+				rte_tel_data_add_dict_uint(dir, name,
+					llround(qstats->queues[q].rates[c][w]));
+			}
+		}
+
+		if (rx != NULL) {
+			snprintf(name, sizeof(name), "rx_q%u", q);
+			rte_tel_data_add_dict_container(d, name, rx, 0);
+		}
+		if (tx != NULL) {
+			snprintf(name, sizeof(name), "tx_q%u", q);
+			rte_tel_data_add_dict_container(d, name, tx, 0);
+		}
+	}
+
+	return 0;
+}
+
+RTE_INIT(bitrate_init_telemetry)
+{
+	rte_telemetry_register_cmd("/bitratestats/queues", bitrate_handle_queues,
+		"Returns packet and bit rates of each queue over 1s, 10s and 60s, "
+		"with their peak. Parameters: int port_id");
+}
@@ -8,11 +8,15 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Maximum number of queues of a port with rates computed. */
+#define RTE_STATS_BITRATE_MAX_QUEUES 16
+
 /**
  *  Bitrate statistics data structure.
  *  This data structure is intentionally opaque.
@@ -68,6 +72,59 @@ int rte_stats_bitrate_reg(struct rte_stats_bitrates *bitrate_data);
 int rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 			   uint16_t port_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register per queue rate statistics with the metric library.
+ *
+ * For each of the first nb_queues Rx and Tx queues, packet and bit rates
+ * averaged over 1, 10 and 60 seconds are registered, along with the peak
+ * of the 1 second rate, e.g. "rx_q0_packets_1s", "tx_q3_bits_peak".
+ * The rates of all the queues of a port are also reported by the
+ * /bitratestats/queues telemetry command.
+ *
+ * @param bitrate_data
+ *   Pointer allocated by rte_stats_bitrate_create()
+ * @param nb_queues
+ *   Number of queues for which metrics are registered,
+ *   up to RTE_STATS_BITRATE_MAX_QUEUES.
+ *
+ * @return
+ *   Zero on success
+ *   Negative on error
+ */
+__rte_experimental
+int rte_stats_bitrate_queue_reg(struct rte_stats_bitrates *bitrate_data,
+				uint16_t nb_queues);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Update the per queue rate statistics of a port.
+ *
+ * Rates are computed from the rx_q<N>_packets, rx_q<N>_bytes,
+ * tx_q<N>_packets and tx_q<N>_bytes extended statistics, which are read
+ * with a single query. They are averaged over each window with an
+ * exponential decay, so this function may be called at any period,
+ * shorter than the windows for the rates to be meaningful.
+ * The first call only records the counters.
+ *
+ * @param bitrate_data
+ *   Bitrate statistics data pointer
+ * @param port_id
+ *   Port id to calculate statistics for
+ *
+ * @return
+ *  - Zero on success
+ *  - -ENOTSUP if the port does not report per queue extended statistics
+ *  - Negative value on other errors
+ */
+__rte_experimental
+int rte_stats_bitrate_queue_calc(struct rte_stats_bitrates *bitrate_data,
+				 uint16_t port_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,7 +8,9 @@
 #include <eal_export.h>
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_lcore.h>
+#include <rte_mempool.h>
 #include <rte_random.h>
 #include <rte_service_component.h>
 
@@ -34,6 +36,8 @@ struct rte_dispatcher_handler {
 	void *match_data;
 	rte_dispatcher_process_t process_fun;
 	void *process_data;
+	struct rte_dispatcher_handler_conf conf;
+	struct rte_dispatcher_handler_stats stats;
 };
 
 struct rte_dispatcher_finalizer {
@@ -96,7 +100,7 @@ evd_prioritize_handler(struct rte_dispatcher_lcore *lcore,
 
 static inline void
 evd_consider_prioritize_handler(struct rte_dispatcher_lcore *lcore,
-	int handler_idx, uint16_t handler_events)
+	int handler_idx, uint32_t handler_events)
 {
 	lcore->prio_count -= handler_events;
 
@@ -113,6 +117,101 @@ evd_consider_prioritize_handler(struct rte_dispatcher_lcore *lcore,
 	}
 }
 
+static inline uint32_t
+evd_flow_key(const struct rte_event *event)
+{
+	return (uint32_t)event->queue_id << 20 | event->flow_id;
+}
+
+/* Stable insertion sort, handler bursts are short and often grouped. */
+static void
+evd_group_by_flow(struct rte_event *events, uint16_t num)
+{
+	uint16_t i, j;
+
+	for (i = 1; i < num; i++) {
+		struct rte_event event = events[i];
+		uint32_t key = evd_flow_key(&event);
+
+		for (j = i; j > 0 && evd_flow_key(&events[j - 1]) > key; j--)
+			events[j] = events[j - 1];
+
+		events[j] = event;
+	}
+}
+
+static void
+evd_deliver(struct rte_dispatcher *dispatcher,
+	struct rte_dispatcher_lcore *lcore,
+	struct rte_dispatcher_lcore_port *port,
+	struct rte_dispatcher_handler *handler,
+	struct rte_event *events, uint16_t num)
+{
+	uint16_t max_batch = handler->conf.max_batch;
+	uint64_t start;
+	uint64_t cycles;
+	uint16_t n;
+
+	if (handler->conf.group_by_flow)
+		evd_group_by_flow(events, num);
+
+	if (max_batch == 0)
+		max_batch = num;
+
+	handler->stats.ev_count += num;
+
+	start = rte_rdtsc();
+
+	for (; num > 0; num -= n, events += n) {
+		n = RTE_MIN(num, max_batch);
+
+		handler->process_fun(dispatcher->event_dev_id, port->port_id,
+				     events, n, handler->process_data);
+
+		handler->stats.process_count++;
+	}
+
+	cycles = rte_rdtsc() - start;
+
+	handler->stats.cycles += cycles;
+	lcore->stats.ev_process_cycles += cycles;
+}
+
+static uint16_t
+evd_unpack_vector(struct rte_dispatcher *dispatcher,
+	struct rte_dispatcher_lcore *lcore,
+	struct rte_dispatcher_lcore_port *port,
+	struct rte_dispatcher_handler *handler,
+	struct rte_event *burst, uint16_t *burst_len, uint16_t burst_size,
+	const struct rte_event *event)
+{
+	struct rte_event_vector *vec = event->vec;
+	struct rte_event element = *event;
+	uint16_t nb_elem = vec->nb_elem;
+	uint16_t i;
+
+	element.event_type &= ~RTE_EVENT_TYPE_VECTOR;
+
+	for (i = 0; i < nb_elem; i++) {
+		element.u64 = vec->u64s[vec->elem_offset + i];
+
+		burst[(*burst_len)++] = element;
+
+		/* Deliver early, vectors may hold more events than a batch */
+		if (*burst_len == burst_size) {
+			evd_deliver(dispatcher, lcore, port, handler, burst,
+				    burst_size);
+			*burst_len = 0;
+		}
+	}
+
+	handler->stats.vec_unpack_count++;
+
+	rte_mempool_put(rte_mempool_from_obj(vec), vec);
+
+	return nb_elem;
+}
+
 static inline void
 evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	struct rte_dispatcher_lcore *lcore,
@@ -122,13 +221,16 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	int i;
 	struct rte_event bursts[EVD_MAX_HANDLERS][num_events];
 	uint16_t burst_lens[EVD_MAX_HANDLERS] = { 0 };
+	uint32_t handler_events[EVD_MAX_HANDLERS] = { 0 };
 	uint16_t drop_count = 0;
-	uint16_t dispatch_count;
-	uint16_t dispatched = 0;
+	uint32_t dispatch_count = 0;
+	uint32_t dispatched = 0;
 
 	for (i = 0; i < num_events; i++) {
 		struct rte_event *event = &events[i];
+		struct rte_dispatcher_handler *handler;
 		int handler_idx;
+		uint16_t n = 1;
 
 		handler_idx = evd_lookup_handler_idx(lcore, event);
 
@@ -137,11 +239,20 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 			continue;
 		}
 
-		bursts[handler_idx][burst_lens[handler_idx]] = *event;
-		burst_lens[handler_idx]++;
-	}
+		handler = &lcore->handlers[handler_idx];
 
-	dispatch_count = num_events - drop_count;
+		if (unlikely(event->event_type & RTE_EVENT_TYPE_VECTOR) &&
+		    handler->conf.vector_mode == RTE_DISPATCHER_VECTOR_UNPACK)
+			n = evd_unpack_vector(dispatcher, lcore, port, handler,
+					      bursts[handler_idx],
+					      &burst_lens[handler_idx],
+					      num_events, event);
+		else
+			bursts[handler_idx][burst_lens[handler_idx]++] = *event;
+
+		handler_events[handler_idx] += n;
+		dispatch_count += n;
+	}
 
 	for (i = 0; i < lcore->num_handlers &&
 		 dispatched < dispatch_count; i++) {
@@ -149,19 +260,20 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 			&lcore->handlers[i];
 		uint16_t len = burst_lens[i];
 
-		if (len == 0)
+		if (handler_events[i] == 0)
 			continue;
 
-		handler->process_fun(dispatcher->event_dev_id, port->port_id,
-				     bursts[i], len, handler->process_data);
+		if (len > 0)
+			evd_deliver(dispatcher, lcore, port, handler,
+				    bursts[i], len);
 
-		dispatched += len;
+		dispatched += handler_events[i];
 
 		/*
 		 * Safe, since any reshuffling will only involve
 		 * already-processed handlers.
 		 */
-		evd_consider_prioritize_handler(lcore, i, len);
+		evd_consider_prioritize_handler(lcore, i, handler_events[i]);
 	}
 
 	lcore->stats.ev_batch_count++;
@@ -529,6 +641,35 @@ evd_uninstall_handler(struct rte_dispatcher *dispatcher, int handler_id)
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_handler_conf_set, 26.03)
+int
+rte_dispatcher_handler_conf_set(struct rte_dispatcher *dispatcher,
+	int handler_id, const struct rte_dispatcher_handler_conf *conf)
+{
+	unsigned int lcore_id;
+
+	if (conf == NULL ||
+	    (conf->vector_mode != RTE_DISPATCHER_VECTOR_FORWARD &&
+	     conf->vector_mode != RTE_DISPATCHER_VECTOR_UNPACK))
+		return -EINVAL;
+
+	if (evd_lcore_get_handler_by_id(&dispatcher->lcores[0],
+					handler_id) == NULL) {
+		RTE_EDEV_LOG_ERR("Invalid handler id %d", handler_id);
+		return -EINVAL;
+	}
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct rte_dispatcher_handler *handler =
+			evd_lcore_get_handler_by_id(
+				&dispatcher->lcores[lcore_id], handler_id);
+
+		handler->conf = *conf;
+	}
+
+	return 0;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_unregister, 23.11)
 int
 rte_dispatcher_unregister(struct rte_dispatcher *dispatcher, int handler_id)
@@ -675,6 +816,7 @@ evd_aggregate_stats(struct rte_dispatcher_stats *result,
 	result->ev_batch_count += part->ev_batch_count;
 	result->ev_dispatch_count += part->ev_dispatch_count;
 	result->ev_drop_count += part->ev_drop_count;
+	result->ev_process_cycles += part->ev_process_cycles;
 }
 
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_stats_get, 23.11)
@@ -694,16 +836,56 @@ rte_dispatcher_stats_get(const struct rte_dispatcher *dispatcher,
 	}
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_handler_stats_get, 26.03)
+int
+rte_dispatcher_handler_stats_get(const struct rte_dispatcher *dispatcher,
+	int handler_id, struct rte_dispatcher_handler_stats *stats)
+{
+	unsigned int lcore_id;
+	uint16_t i;
+	bool found = false;
+
+	*stats = (struct rte_dispatcher_handler_stats) {};
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		const struct rte_dispatcher_lcore *lcore =
+			&dispatcher->lcores[lcore_id];
+
+		for (i = 0; i < lcore->num_handlers; i++) {
+			const struct rte_dispatcher_handler *handler =
+				&lcore->handlers[i];
+
+			if (handler->id != handler_id)
+				continue;
+
+			stats->process_count += handler->stats.process_count;
+			stats->ev_count += handler->stats.ev_count;
+			stats->vec_unpack_count +=
+				handler->stats.vec_unpack_count;
+			stats->cycles += handler->stats.cycles;
+			found = true;
+			break;
+		}
+	}
+
+	return found ? 0 : -EINVAL;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_stats_reset, 23.11)
 void
 rte_dispatcher_stats_reset(struct rte_dispatcher *dispatcher)
 {
 	unsigned int lcore_id;
+	uint16_t i;
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
 		struct rte_dispatcher_lcore *lcore =
 			&dispatcher->lcores[lcore_id];
 
 		lcore->stats = (struct rte_dispatcher_stats) {};
+
+		for (i = 0; i < lcore->num_handlers; i++)
+			lcore->handlers[i].stats =
+				(struct rte_dispatcher_handler_stats) {};
 	}
 }
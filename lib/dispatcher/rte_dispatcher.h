@@ -114,6 +114,59 @@ struct rte_dispatcher_stats {
 	uint64_t ev_dispatch_count;
 	/** Number of events dropped because no handler was found. */
 	uint64_t ev_drop_count;
+	/** Number of TSC cycles spent in handler process callbacks. */
+	uint64_t ev_process_cycles;
+};
+
+/**
+ * Per-handler statistics
+ */
+struct rte_dispatcher_handler_stats {
+	/** Number of process callback invocations. */
+	uint64_t process_count;
+	/** Number of events delivered to the handler. */
+	uint64_t ev_count;
+	/** Number of event vectors unpacked for the handler. */
+	uint64_t vec_unpack_count;
+	/** Number of TSC cycles spent in the handler's process callback. */
+	uint64_t cycles;
+};
+
+/**
+ * Delivery of event vectors to a handler.
+ *
+ * @see rte_dispatcher_handler_conf
+ */
+enum rte_dispatcher_vector_mode {
+	/** Deliver event vectors as-is, one event per vector. */
+	RTE_DISPATCHER_VECTOR_FORWARD,
+	/**
+	 * Unpack event vectors into one event per vector element,
+	 * carrying the vector event's attributes, and return the
+	 * vector to its mempool.
+	 */
+	RTE_DISPATCHER_VECTOR_UNPACK,
+};
+
+/**
+ * Per-handler delivery configuration
+ *
+ * @see rte_dispatcher_handler_conf_set()
+ */
+struct rte_dispatcher_handler_conf {
+	/**
+	 * Maximum number of events per process callback invocation.
+	 * 0 means no limit other than the dequeue batch size.
+	 */
+	uint16_t max_batch;
+	/** How event vectors matched by the handler are delivered. */
+	enum rte_dispatcher_vector_mode vector_mode;
+	/**
+	 * Deliver events sorted by queue id and flow id. The sort is
+	 * stable, so the relative order of events of the same flow is
+	 * kept.
+	 */
+	bool group_by_flow;
 };
 
 /**
@@ -317,6 +370,40 @@ __rte_experimental
 int
 rte_dispatcher_unregister(struct rte_dispatcher *dispatcher, int handler_id);
 
+/**
+ * Configure how events are delivered to a handler.
+ *
+ * By default, a handler is delivered all its events of a dequeue
+ * batch in one process callback invocation, in dequeue order, with
+ * event vectors delivered as-is.
+ *
+ * Event vectors are matched as a single event, using the vector
+ * event. Unpacked vectors count as one event per element in the
+ * dispatcher statistics.
+ *
+ * This function may be called by any thread (including unregistered
+ * non-EAL threads), but not while the dispatcher is running on
+ * any service lcore.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @param handler_id
+ *  The handler registration id returned by the original
+ *  rte_dispatcher_register() call.
+ *
+ * @param conf
+ *  The delivery configuration.
+ *
+ * @return
+ *  - 0: Success
+ *  - -EINVAL: The @c handler_id or @c conf parameter was invalid.
+ */
+__rte_experimental
+int
+rte_dispatcher_handler_conf_set(struct rte_dispatcher *dispatcher,
+	int handler_id, const struct rte_dispatcher_handler_conf *conf);
+
 /**
  * Register a finalize callback function.
  *
@@ -436,7 +523,31 @@ rte_dispatcher_stats_get(const struct rte_dispatcher *dispatcher,
 	struct rte_dispatcher_stats *stats);
 
 /**
- * Reset statistics for a dispatcher instance.
+ * Retrieve statistics for a handler, accumulated over all lcores.
+ *
+ * This function is MT safe and may be called by any thread
+ * (including unregistered non-EAL threads).
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ * @param handler_id
+ *  The handler registration id returned by the original
+ *  rte_dispatcher_register() call.
+ * @param[out] stats
+ *   A pointer to a structure to fill with statistics.
+ *
+ * @return
+ *  - 0: Success
+ *  - -EINVAL: The @c handler_id parameter was invalid.
+ */
+__rte_experimental
+int
+rte_dispatcher_handler_stats_get(const struct rte_dispatcher *dispatcher,
+	int handler_id, struct rte_dispatcher_handler_stats *stats);
+
+/**
+ * Reset statistics for a dispatcher instance, including the
+ * per-handler statistics.
  *
  * This function may be called by any thread (including unregistered
  * non-EAL threads), but may not produce the correct result if the
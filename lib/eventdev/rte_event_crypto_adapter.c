@@ -7,6 +7,7 @@
 #include <stdbool.h>
 #include <eal_export.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <dev_driver.h>
 #include <rte_errno.h>
 #include <rte_cryptodev.h>
@@ -41,6 +42,17 @@
  */
 #define CRYPTO_ENQ_FLUSH_THRESHOLD 1024
 
+/* Default time a crypto op may wait in a queue pair buffer before being
+ * flushed to the cryptodev
+ */
+#define CRYPTO_DEFAULT_FLUSH_TIMEOUT_US 50
+
+/* Poll a forward mode queue pair with no crypto op in flight once every
+ * CRYPTO_DEQ_IDLE_POLL_INTERVAL iterations, to still pick up the crypto ops
+ * enqueued to it by the application
+ */
+#define CRYPTO_DEQ_IDLE_POLL_INTERVAL 64
+
 #define ECA_ADAPTER_ARRAY "crypto_adapter_array"
 
 struct __rte_cache_aligned crypto_ops_circular_buffer {
@@ -99,6 +111,13 @@ struct __rte_cache_aligned event_crypto_adapter {
 	uint16_t nb_qps;
 	/* Adapter mode */
 	enum rte_event_crypto_adapter_mode mode;
+	/* Time a crypto op may wait in a queue pair buffer, 0 if queue
+	 * pairs use batches of BATCH_SIZE
+	 */
+	uint32_t flush_timeout_us;
+	uint64_t flush_cycles;
+	/* Earliest flush deadline of the queue pair buffers */
+	uint64_t next_flush_tsc;
 };
 
 /* Per crypto device information */
@@ -125,8 +144,18 @@ struct __rte_cache_aligned crypto_device_info {
 struct __rte_cache_aligned crypto_queue_pair_info {
 	/* Set to indicate queue pair is enabled */
 	bool qp_enabled;
+	/* Number of crypto ops buffered before enqueue to cdev */
+	uint16_t batch_sz;
+	/* Crypto ops enqueued to cdev and not dequeued yet */
+	uint32_t inflight;
+	/* Polls skipped since the last poll of the idle queue pair */
+	uint16_t idle_skips;
+	/* TSC at which the oldest buffered crypto op was added */
+	uint64_t first_tsc;
 	/* Circular buffer for batching crypto ops to cdev */
 	struct crypto_ops_circular_buffer cbuf;
+	/* Queue pair stats, buffer latencies in cycles */
+	struct rte_event_crypto_adapter_queue_pair_stats stats;
 };
 
 static struct event_crypto_adapter **event_crypto_adapter;
@@ -210,9 +239,10 @@ eca_memzone_lookup(void)
 }
 
 static inline bool
-eca_circular_buffer_batch_ready(struct crypto_ops_circular_buffer *bufp)
+eca_circular_buffer_batch_ready(struct crypto_ops_circular_buffer *bufp,
+				uint16_t batch_sz)
 {
-	return bufp->count >= BATCH_SIZE;
+	return bufp->count >= batch_sz;
 }
 
 static inline bool
@@ -305,6 +335,54 @@ eca_circular_buffer_flush_to_cdev(struct crypto_ops_circular_buffer *bufp,
 	return *nb_ops_flushed == n ? 0 : -1;
 }
 
+static inline int
+eca_qp_flush_to_cdev(struct event_crypto_adapter *adapter,
+		     struct crypto_queue_pair_info *qp_info, uint8_t cdev_id,
+		     uint16_t qp_id, uint64_t now, bool timeout,
+		     uint16_t *nb_ops_flushed)
+{
+	struct rte_event_crypto_adapter_queue_pair_stats *qp_stats;
+	uint16_t count = qp_info->cbuf.count;
+	uint64_t wait;
+	int ret;
+
+	ret = eca_circular_buffer_flush_to_cdev(&qp_info->cbuf, cdev_id, qp_id,
+						nb_ops_flushed);
+	if (*nb_ops_flushed == 0)
+		return ret;
+
+	qp_stats = &qp_info->stats;
+	qp_info->inflight += *nb_ops_flushed;
+	qp_stats->crypto_enq_count += *nb_ops_flushed;
+	qp_stats->crypto_enq_burst_count++;
+	if (adapter->flush_cycles == 0)
+		return ret;
+
+	wait = now - qp_info->first_tsc;
+	qp_stats->buffer_latency_ns += wait;
+	qp_stats->buffer_latency_max_ns =
+		RTE_MAX(qp_stats->buffer_latency_max_ns, wait);
+
+	/* Grow the batch while it fills up in time, shrink it to
+	 * what could be buffered otherwise.
+	 */
+	if (timeout) {
+		qp_stats->crypto_enq_timeout_count++;
+		qp_info->batch_sz = RTE_MIN(count, BATCH_SIZE);
+	} else if (qp_info->batch_sz < BATCH_SIZE) {
+		qp_info->batch_sz = RTE_MIN(qp_info->batch_sz * 2, BATCH_SIZE);
+	}
+
+	return ret;
+}
+
+/* Convert without overflowing the intermediate product */
+static inline uint64_t
+eca_cycles_to_ns(uint64_t cycles, uint64_t hz)
+{
+	return (cycles / hz) * NS_PER_S + (cycles % hz) * NS_PER_S / hz;
+}
+
 static inline struct event_crypto_adapter *
 eca_id_to_adapter(uint8_t id)
 {
@@ -417,6 +495,10 @@ rte_event_crypto_adapter_create_ext(uint8_t id, uint8_t dev_id,
 	adapter->conf_cb = conf_cb;
 	adapter->conf_arg = conf_arg;
 	adapter->mode = mode;
+	adapter->flush_timeout_us = CRYPTO_DEFAULT_FLUSH_TIMEOUT_US;
+	adapter->flush_cycles = CRYPTO_DEFAULT_FLUSH_TIMEOUT_US *
+		rte_get_tsc_hz() / US_PER_S;
+	adapter->next_flush_tsc = UINT64_MAX;
 	strcpy(adapter->mem_name, mem_name);
 	adapter->cdevs = rte_zmalloc_socket(adapter->mem_name,
 					rte_cryptodev_count() *
@@ -506,12 +588,16 @@ eca_enq_to_cryptodev(struct event_crypto_adapter *adapter, struct rte_event *ev,
 	struct rte_crypto_op *crypto_op;
 	unsigned int i, n;
 	uint16_t qp_id, nb_enqueued = 0;
+	uint16_t batch_sz = BATCH_SIZE;
+	uint64_t now = 0;
 	uint8_t cdev_id;
 	int ret;
 
 	ret = 0;
 	n = 0;
 	stats->event_deq_count += cnt;
+	if (adapter->flush_cycles)
+		now = rte_get_tsc_cycles();
 
 	for (i = 0; i < cnt; i++) {
 		crypto_op = ev[i].event_ptr;
@@ -553,11 +639,20 @@ eca_enq_to_cryptodev(struct event_crypto_adapter *adapter, struct rte_event *ev,
 		}
 		eca_circular_buffer_add(&qp_info->cbuf, crypto_op);
 
-		if (eca_circular_buffer_batch_ready(&qp_info->cbuf)) {
-			ret = eca_circular_buffer_flush_to_cdev(&qp_info->cbuf,
-								cdev_id,
-								qp_id,
-								&nb_enqueued);
+		if (adapter->flush_cycles) {
+			if (qp_info->cbuf.count == 1) {
+				qp_info->first_tsc = now;
+				adapter->next_flush_tsc =
+					RTE_MIN(adapter->next_flush_tsc,
+						now + adapter->flush_cycles);
+			}
+			batch_sz = qp_info->batch_sz;
+		}
+
+		if (eca_circular_buffer_batch_ready(&qp_info->cbuf, batch_sz)) {
+			ret = eca_qp_flush_to_cdev(adapter, qp_info, cdev_id,
+						   qp_id, now, false,
+						   &nb_enqueued);
 			stats->crypto_enq_count += nb_enqueued;
 			n += nb_enqueued;
 
@@ -584,10 +679,16 @@ eca_crypto_cdev_flush(struct event_crypto_adapter *adapter,
 	struct crypto_queue_pair_info *curr_queue;
 	struct rte_cryptodev *dev;
 	uint16_t nb = 0, nb_enqueued = 0;
+	uint64_t now = 0;
 	uint16_t qp;
 
 	curr_dev = &adapter->cdevs[cdev_id];
 	dev = rte_cryptodev_pmd_get_dev(cdev_id);
+	if (curr_dev->qpairs == NULL)
+		return 0;
+
+	if (adapter->flush_cycles)
+		now = rte_get_tsc_cycles();
 
 	for (qp = 0; qp < dev->data->nb_queue_pairs; qp++) {
 
@@ -595,10 +696,8 @@ eca_crypto_cdev_flush(struct event_crypto_adapter *adapter,
 		if (unlikely(curr_queue == NULL || !curr_queue->qp_enabled))
 			continue;
 
-		eca_circular_buffer_flush_to_cdev(&curr_queue->cbuf,
-						  cdev_id,
-						  qp,
-						  &nb_enqueued);
+		eca_qp_flush_to_cdev(adapter, curr_queue, cdev_id, qp, now,
+				     false, &nb_enqueued);
 		*nb_ops_flushed += curr_queue->cbuf.count;
 		nb += nb_enqueued;
 	}
@@ -631,6 +730,53 @@ eca_crypto_enq_flush(struct event_crypto_adapter *adapter)
 	return nb_enqueued;
 }
 
+/* Flush the queue pair buffers holding crypto ops for longer than the
+ * flush timeout, and find the next deadline.
+ */
+static unsigned int
+eca_crypto_enq_timeout_flush(struct event_crypto_adapter *adapter,
+			     uint64_t now)
+{
+	struct rte_event_crypto_adapter_stats *stats = &adapter->crypto_stats;
+	struct crypto_queue_pair_info *qp_info;
+	struct crypto_device_info *dev_info;
+	uint16_t num_cdev = rte_cryptodev_count();
+	uint64_t next_flush_tsc = UINT64_MAX;
+	uint16_t nb_enqueued, qp;
+	unsigned int nb = 0;
+	uint64_t deadline;
+	uint8_t cdev_id;
+
+	for (cdev_id = 0; cdev_id < num_cdev; cdev_id++) {
+		dev_info = &adapter->cdevs[cdev_id];
+		if (dev_info->qpairs == NULL)
+			continue;
+
+		for (qp = 0; qp < dev_info->dev->data->nb_queue_pairs; qp++) {
+			qp_info = &dev_info->qpairs[qp];
+			if (!qp_info->qp_enabled || qp_info->cbuf.count == 0)
+				continue;
+
+			deadline = qp_info->first_tsc + adapter->flush_cycles;
+			if (now >= deadline) {
+				eca_qp_flush_to_cdev(adapter, qp_info, cdev_id,
+						     qp, now, true,
+						     &nb_enqueued);
+				nb += nb_enqueued;
+			}
+
+			if (qp_info->cbuf.count != 0)
+				next_flush_tsc = RTE_MIN(next_flush_tsc,
+							 deadline);
+		}
+	}
+
+	adapter->next_flush_tsc = next_flush_tsc;
+	stats->crypto_enq_count += nb;
+
+	return nb;
+}
+
 static int
 eca_crypto_adapter_enq_run(struct event_crypto_adapter *adapter,
 			   unsigned int max_enq)
@@ -665,6 +811,14 @@ eca_crypto_adapter_enq_run(struct event_crypto_adapter *adapter,
 		nb_enqueued += eca_enq_to_cryptodev(adapter, ev, n);
 	}
 
+	if (adapter->flush_cycles) {
+		uint64_t now = rte_get_tsc_cycles();
+
+		if (now >= adapter->next_flush_tsc)
+			nb_enqueued += eca_crypto_enq_timeout_flush(adapter,
+								    now);
+	}
+
 	if ((++adapter->transmit_loop_count &
 		(CRYPTO_ENQ_FLUSH_THRESHOLD - 1)) == 0) {
 		nb_enqueued += eca_crypto_enq_flush(adapter);
@@ -820,6 +974,22 @@ eca_crypto_adapter_deq_run(struct event_crypto_adapter *adapter,
 				    !curr_queue->qp_enabled))
 					continue;
 
+				/* In forward mode, the crypto ops on the
+				 * queue pair are normally enqueued by the
+				 * adapter, only poll an idle one once in a
+				 * while.
+				 */
+				if (adapter->mode ==
+				    RTE_EVENT_CRYPTO_ADAPTER_OP_FORWARD &&
+				    curr_queue->inflight == 0 &&
+				    ++curr_queue->idle_skips <
+				    CRYPTO_DEQ_IDLE_POLL_INTERVAL) {
+					curr_queue->stats.crypto_deq_skip_count++;
+					continue;
+				}
+
+				curr_queue->idle_skips = 0;
+				curr_queue->stats.crypto_deq_poll_count++;
 				n = rte_cryptodev_dequeue_burst(cdev_id, qp,
 					ops, BATCH_SIZE);
 				if (!n)
@@ -828,6 +998,9 @@ eca_crypto_adapter_deq_run(struct event_crypto_adapter *adapter,
 				done = false;
 				nb_enqueued = 0;
 
+				curr_queue->inflight -=
+					RTE_MIN(curr_queue->inflight, n);
+				curr_queue->stats.crypto_deq_count += n;
 				stats->crypto_deq_count += n;
 
 				if (unlikely(!adapter->ebuf.count))
@@ -1001,6 +1174,21 @@ eca_update_qp_info(struct event_crypto_adapter *adapter,
 	}
 }
 
+static void
+eca_free_queue_pairs(struct crypto_device_info *dev_info)
+{
+	uint16_t i;
+
+	if (dev_info->qpairs == NULL)
+		return;
+
+	for (i = 0; i < dev_info->dev->data->nb_queue_pairs; i++)
+		eca_circular_buffer_free(&dev_info->qpairs[i].cbuf);
+
+	rte_free(dev_info->qpairs);
+	dev_info->qpairs = NULL;
+}
+
 static int
 eca_add_queue_pair(struct event_crypto_adapter *adapter, uint8_t cdev_id,
 		   int queue_pair_id)
@@ -1020,13 +1208,16 @@ eca_add_queue_pair(struct event_crypto_adapter *adapter, uint8_t cdev_id,
 
 		qpairs = dev_info->qpairs;
 
-		if (eca_circular_buffer_init("eca_cdev_circular_buffer",
-					     &qpairs->cbuf,
-					     CRYPTO_ADAPTER_OPS_BUFFER_SZ)) {
-			RTE_EDEV_LOG_ERR("Failed to get memory for cryptodev "
-					 "buffer");
-			rte_free(qpairs);
-			return -ENOMEM;
+		for (i = 0; i < dev_info->dev->data->nb_queue_pairs; i++) {
+			if (eca_circular_buffer_init("eca_cdev_circular_buffer",
+						     &qpairs[i].cbuf,
+						     CRYPTO_ADAPTER_OPS_BUFFER_SZ)) {
+				RTE_EDEV_LOG_ERR("Failed to get memory for "
+						 "cryptodev buffer");
+				eca_free_queue_pairs(dev_info);
+				return -ENOMEM;
+			}
+			qpairs[i].batch_sz = BATCH_SIZE;
 		}
 	}
 
@@ -1266,10 +1457,8 @@ rte_event_crypto_adapter_queue_pair_del(uint8_t id, uint8_t cdev_id,
 						(uint16_t)queue_pair_id, 0);
 		}
 
-		if (dev_info->num_qpairs == 0) {
-			rte_free(dev_info->qpairs);
-			dev_info->qpairs = NULL;
-		}
+		if (dev_info->num_qpairs == 0)
+			eca_free_queue_pairs(dev_info);
 
 		rte_spinlock_unlock(&adapter->lock);
 		rte_service_component_runstate_set(adapter->service_id,
@@ -1430,6 +1619,95 @@ rte_event_crypto_adapter_stats_reset(uint8_t id)
 	return 0;
 }
 
+static int
+eca_qp_info_get(uint8_t id, uint8_t cdev_id, uint16_t queue_pair_id,
+		struct event_crypto_adapter **adapterp,
+		struct crypto_queue_pair_info **qp_infop)
+{
+	struct event_crypto_adapter *adapter;
+	struct crypto_device_info *dev_info;
+	struct crypto_queue_pair_info *qp_info;
+
+	if (eca_memzone_lookup())
+		return -ENOMEM;
+
+	EVENT_CRYPTO_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+
+	if (!rte_cryptodev_is_valid_dev(cdev_id)) {
+		RTE_EDEV_LOG_ERR("Invalid dev_id=%" PRIu8, cdev_id);
+		return -EINVAL;
+	}
+
+	adapter = eca_id_to_adapter(id);
+	if (adapter == NULL)
+		return -EINVAL;
+
+	dev_info = &adapter->cdevs[cdev_id];
+	if (dev_info->qpairs == NULL ||
+	    queue_pair_id >= dev_info->dev->data->nb_queue_pairs) {
+		RTE_EDEV_LOG_ERR("Invalid queue_pair_id %" PRIu16,
+				 queue_pair_id);
+		return -EINVAL;
+	}
+
+	qp_info = &dev_info->qpairs[queue_pair_id];
+	if (!qp_info->qp_enabled)
+		return -EINVAL;
+
+	if (dev_info->internal_event_port || qp_info->cbuf.op_buffer == NULL)
+		return -ENOTSUP;
+
+	*adapterp = adapter;
+	*qp_infop = qp_info;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_crypto_adapter_queue_pair_stats_get, 26.03)
+int
+rte_event_crypto_adapter_queue_pair_stats_get(uint8_t id, uint8_t cdev_id,
+		uint16_t queue_pair_id,
+		struct rte_event_crypto_adapter_queue_pair_stats *stats)
+{
+	struct event_crypto_adapter *adapter;
+	struct crypto_queue_pair_info *qp_info;
+	uint64_t tsc_hz = rte_get_tsc_hz();
+	int ret;
+
+	if (stats == NULL)
+		return -EINVAL;
+
+	ret = eca_qp_info_get(id, cdev_id, queue_pair_id, &adapter, &qp_info);
+	if (ret)
+		return ret;
+
+	*stats = qp_info->stats;
+	stats->buffer_latency_ns =
+		eca_cycles_to_ns(stats->buffer_latency_ns, tsc_hz);
+	stats->buffer_latency_max_ns =
+		eca_cycles_to_ns(stats->buffer_latency_max_ns, tsc_hz);
+	stats->batch_sz = adapter->flush_cycles ? qp_info->batch_sz :
+		BATCH_SIZE;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_crypto_adapter_queue_pair_stats_reset, 26.03)
+int
+rte_event_crypto_adapter_queue_pair_stats_reset(uint8_t id, uint8_t cdev_id,
+		uint16_t queue_pair_id)
+{
+	struct event_crypto_adapter *adapter;
+	struct crypto_queue_pair_info *qp_info;
+	int ret;
+
+	ret = eca_qp_info_get(id, cdev_id, queue_pair_id, &adapter, &qp_info);
+	if (ret)
+		return ret;
+
+	memset(&qp_info->stats, 0, sizeof(qp_info->stats));
+	return 0;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_crypto_adapter_runtime_params_init, 23.03)
 int
 rte_event_crypto_adapter_runtime_params_init(
@@ -1440,6 +1718,7 @@ rte_event_crypto_adapter_runtime_params_init(
 
 	memset(params, 0, sizeof(*params));
 	params->max_nb = DEFAULT_MAX_NB;
+	params->flush_timeout_us = CRYPTO_DEFAULT_FLUSH_TIMEOUT_US;
 
 	return 0;
 }
@@ -1495,8 +1774,19 @@ rte_event_crypto_adapter_runtime_params_set(uint8_t id,
 	if (ret)
 		return ret;
 
+	if (params->flush_timeout_us > US_PER_S) {
+		RTE_EDEV_LOG_ERR("Invalid flush timeout %" PRIu32 " us",
+				 params->flush_timeout_us);
+		return -EINVAL;
+	}
+
 	rte_spinlock_lock(&adapter->lock);
 	adapter->max_nb = params->max_nb;
+	adapter->flush_timeout_us = params->flush_timeout_us;
+	adapter->flush_cycles = (uint64_t)params->flush_timeout_us *
+		rte_get_tsc_hz() / US_PER_S;
+	/* Check the deadlines of the ops already buffered */
+	adapter->next_flush_tsc = 0;
 	rte_spinlock_unlock(&adapter->lock);
 
 	return 0;
@@ -1530,6 +1820,7 @@ rte_event_crypto_adapter_runtime_params_get(uint8_t id,
 		return ret;
 
 	params->max_nb = adapter->max_nb;
+	params->flush_timeout_us = adapter->flush_timeout_us;
 
 	return 0;
 }
@@ -277,7 +277,22 @@ struct rte_event_crypto_adapter_runtime_params {
 	 * RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_FWD or
 	 * RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_NEW capability.
 	 */
-	uint32_t rsvd[15];
+	uint32_t flush_timeout_us;
+	/**< Maximum time in microseconds a crypto operation dequeued from the
+	 * event device may wait in the adapter for more operations to the same
+	 * queue pair before being enqueued to the cryptodev.
+	 *
+	 * Each queue pair then enqueues batches of a size adapted to its load:
+	 * the batch size grows when batches fill up before the timeout, and
+	 * shrinks to the number of operations buffered when the timeout
+	 * expires. A value of 0 enqueues batches of a fixed size, flushed
+	 * periodically.
+	 *
+	 * This is valid in RTE_EVENT_CRYPTO_ADAPTER_OP_FORWARD mode for the
+	 * devices without RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_FWD
+	 * capability.
+	 */
+	uint32_t rsvd[14];
 	/**< Reserved fields for future expansion */
 };
 
@@ -402,6 +417,38 @@ struct rte_event_crypto_adapter_stats {
 	/**< Event enqueue fail count */
 };
 
+/**
+ * A structure used to retrieve statistics for a queue pair of an event crypto
+ * adapter service.
+ */
+struct rte_event_crypto_adapter_queue_pair_stats {
+	uint64_t crypto_enq_count;
+	/**< Crypto operations enqueued to the queue pair */
+	uint64_t crypto_enq_burst_count;
+	/**< Bursts of crypto operations enqueued to the queue pair */
+	uint64_t crypto_enq_timeout_count;
+	/**< Bursts enqueued as the flush timeout expired */
+	uint64_t crypto_deq_count;
+	/**< Crypto operations dequeued from the queue pair */
+	uint64_t crypto_deq_poll_count;
+	/**< Queue pair poll count */
+	uint64_t crypto_deq_skip_count;
+	/**< Polls skipped as no crypto operation enqueued by the adapter was
+	 * in flight on the queue pair, in RTE_EVENT_CRYPTO_ADAPTER_OP_FORWARD
+	 * mode
+	 */
+	uint64_t buffer_latency_ns;
+	/**< Total time the first crypto operation of each burst waited in the
+	 * adapter before being enqueued to the queue pair
+	 */
+	uint64_t buffer_latency_max_ns;
+	/**< Maximum time the first crypto operation of a burst waited in the
+	 * adapter before being enqueued to the queue pair
+	 */
+	uint16_t batch_sz;
+	/**< Current batch size of the queue pair */
+};
+
 /**
  * Create a new event crypto adapter with the specified identifier.
  *
@@ -601,6 +648,62 @@ rte_event_crypto_adapter_stats_get(uint8_t id,
 int
 rte_event_crypto_adapter_stats_reset(uint8_t id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Retrieve statistics for a queue pair of an adapter. Statistics are
+ * maintained by the adapter service, for queue pairs it transfers crypto
+ * operations of.
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param cdev_id
+ *  Cryptodev identifier.
+ *
+ * @param queue_pair_id
+ *  Cryptodev queue pair identifier.
+ *
+ * @param [out] stats
+ *  A pointer to structure used to retrieve statistics for the queue pair.
+ *
+ * @return
+ *  - 0: Success, retrieved successfully.
+ *  - -EINVAL: Invalid parameters or queue pair not added to the adapter.
+ *  - -ENOTSUP: Queue pair not served by the adapter service.
+ */
+__rte_experimental
+int
+rte_event_crypto_adapter_queue_pair_stats_get(uint8_t id, uint8_t cdev_id,
+		uint16_t queue_pair_id,
+		struct rte_event_crypto_adapter_queue_pair_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Reset statistics for a queue pair of an adapter.
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param cdev_id
+ *  Cryptodev identifier.
+ *
+ * @param queue_pair_id
+ *  Cryptodev queue pair identifier.
+ *
+ * @return
+ *  - 0: Success, statistics reset successfully.
+ *  - -EINVAL: Invalid parameters or queue pair not added to the adapter.
+ *  - -ENOTSUP: Queue pair not served by the adapter service.
+ */
+__rte_experimental
+int
+rte_event_crypto_adapter_queue_pair_stats_reset(uint8_t id, uint8_t cdev_id,
+		uint16_t queue_pair_id);
+
 /**
  * Retrieve the service ID of an adapter. If the adapter doesn't use
  * a rte_service function, this function returns -ESRCH.
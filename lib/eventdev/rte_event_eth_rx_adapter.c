@@ -39,6 +39,9 @@
 #define MIN_VECTOR_NS		1E5
 
 #define RXA_NB_RX_WORK_DEFAULT 128
+#define RXA_ADAPTIVE_WINDOW_DEFAULT 4096
+#define RXA_ADAPTIVE_INTR_THRESH_DEFAULT 99
+#define RXA_ADAPTIVE_HOLDOFF_DEFAULT 4
 
 #define ETH_RX_ADAPTER_SERVICE_NAME_LEN	32
 #define ETH_RX_ADAPTER_MEM_NAME_LEN	32
@@ -141,6 +144,9 @@ struct __rte_cache_aligned event_eth_rx_adapter {
 	struct eth_rx_vector_data_list vector_list;
 	/* Per adapter stats */
 	struct rte_event_eth_rx_adapter_stats stats;
+	/* Mode switches of adaptive queues, reported through telemetry */
+	uint64_t rx_poll_to_intr_count;
+	uint64_t rx_intr_to_poll_count;
 	/* Block count, counts up to BLOCK_CNT_THRESHOLD */
 	uint16_t enq_block_count;
 	/* Block start ts */
@@ -149,6 +155,14 @@ struct __rte_cache_aligned event_eth_rx_adapter {
 	int epd;
 	/* Num of interrupt driven interrupt queues */
 	uint32_t num_rx_intr;
+	/* Num of polled queues switching to interrupt mode when idle */
+	uint32_t num_rx_adaptive;
+	/* Polls per empty poll ratio computation of adaptive queues */
+	uint32_t adaptive_window;
+	/* Empty poll percentage moving an adaptive queue to interrupt mode */
+	uint8_t adaptive_intr_thresh;
+	/* Windows an adaptive queue stays polled after an Rx interrupt */
+	uint16_t adaptive_holdoff;
 	/* Used to send <dev id, queue id> of interrupting Rx queues from
 	 * the interrupt thread to the Rx thread
 	 */
@@ -241,13 +255,28 @@ struct eth_device_info {
 	int shared_intr_enabled;
 };
 
+/* Mode of an adaptive Rx queue */
+enum rxa_adaptive_mode {
+	/* Polled as per its servicing weight */
+	RXA_ADAPTIVE_POLL,
+	/* Rx interrupt enabled, polled once more to catch racing packets */
+	RXA_ADAPTIVE_ARMED,
+	/* Skipped by the poll loop until an Rx interrupt is received */
+	RXA_ADAPTIVE_INTR,
+};
+
 /* Per Rx queue */
 struct eth_rx_queue_info {
 	int queue_enabled;	/* True if added */
 	int intr_enabled;
 	uint8_t ena_vector;
+	uint8_t adaptive;	/* True if switching between poll and intr */
+	uint8_t adaptive_mode;	/* enum rxa_adaptive_mode */
 	uint16_t wt;		/* Polling weight */
 	uint32_t flow_id_mask;	/* Set to ~0 if app provides flow id else 0 */
+	uint32_t nb_polls;	/* Polls in the current adaptive window */
+	uint32_t nb_empty_polls;/* Empty polls in the current adaptive window */
+	uint16_t holdoff;	/* Windows left before the queue may sleep */
 	uint64_t event;
 	struct eth_rx_vector_data vector_data;
 	struct eth_event_enqueue_buffer *event_buf;
@@ -1157,6 +1186,83 @@ rxa_intr_ring_del_entries(struct event_eth_rx_adapter *rx_adapter,
 	rte_spinlock_unlock(&rx_adapter->intr_ring_lock);
 }
 
+/* Move an adaptive Rx queue back to poll mode, the Rx interrupt is left
+ * disabled until the queue goes idle again
+ */
+static void
+rxa_adaptive_wake(struct event_eth_rx_adapter *rx_adapter,
+		  struct eth_rx_queue_info *queue_info,
+		  uint16_t port_id, uint16_t queue_id)
+{
+	if (queue_info->adaptive_mode == RXA_ADAPTIVE_POLL)
+		return;
+
+	rte_spinlock_lock(&rx_adapter->intr_ring_lock);
+	if (queue_info->intr_enabled) {
+		queue_info->intr_enabled = 0;
+		rte_eth_dev_rx_intr_disable(port_id, queue_id);
+	}
+	rte_spinlock_unlock(&rx_adapter->intr_ring_lock);
+
+	queue_info->adaptive_mode = RXA_ADAPTIVE_POLL;
+	queue_info->nb_polls = 0;
+	queue_info->nb_empty_polls = 0;
+	queue_info->holdoff = rx_adapter->adaptive_holdoff;
+	rx_adapter->rx_intr_to_poll_count++;
+}
+
+/* Account a poll of an adaptive Rx queue and move the queue to interrupt
+ * mode once the empty poll ratio of a window reaches the threshold
+ */
+static void
+rxa_adaptive_update(struct event_eth_rx_adapter *rx_adapter,
+		    struct eth_rx_queue_info *queue_info,
+		    uint16_t port_id, uint16_t queue_id,
+		    uint32_t nb_rx, int rxq_empty)
+{
+	uint32_t nb_polls;
+
+	/* Event buffer full, the Rx queue hasn't been polled */
+	if (nb_rx == 0 && !rxq_empty)
+		return;
+
+	if (queue_info->adaptive_mode == RXA_ADAPTIVE_ARMED) {
+		if (nb_rx == 0)
+			queue_info->adaptive_mode = RXA_ADAPTIVE_INTR;
+		else
+			rxa_adaptive_wake(rx_adapter, queue_info, port_id,
+					  queue_id);
+		return;
+	}
+
+	queue_info->nb_empty_polls += nb_rx == 0;
+	nb_polls = ++queue_info->nb_polls;
+	if (nb_polls < rx_adapter->adaptive_window)
+		return;
+
+	queue_info->nb_polls = 0;
+	if (queue_info->holdoff) {
+		queue_info->holdoff--;
+		queue_info->nb_empty_polls = 0;
+		return;
+	}
+
+	if ((uint64_t)queue_info->nb_empty_polls * 100 <
+			(uint64_t)nb_polls * rx_adapter->adaptive_intr_thresh) {
+		queue_info->nb_empty_polls = 0;
+		return;
+	}
+	queue_info->nb_empty_polls = 0;
+
+	rte_spinlock_lock(&rx_adapter->intr_ring_lock);
+	if (rte_eth_dev_rx_intr_enable(port_id, queue_id) == 0) {
+		queue_info->intr_enabled = 1;
+		queue_info->adaptive_mode = RXA_ADAPTIVE_ARMED;
+		rx_adapter->rx_poll_to_intr_count++;
+	}
+	rte_spinlock_unlock(&rx_adapter->intr_ring_lock);
+}
+
 /* thread callback handling interrupt mode receive queues
  * After receiving an Rx interrupt, it enqueues the port id and queue id of the
  * interrupting queue to the adapter's ring buffer for interrupt events.
@@ -1200,7 +1306,7 @@ rxa_intr_ring_dequeue(struct event_eth_rx_adapter *rx_adapter)
 	uint8_t max_done = 0;
 	bool work = false;
 
-	if (rx_adapter->num_rx_intr == 0)
+	if (rx_adapter->num_rx_intr == 0 && rx_adapter->num_rx_adaptive == 0)
 		return work;
 
 	if (rte_ring_count(rx_adapter->intr_ring) == 0
@@ -1239,15 +1345,22 @@ rxa_intr_ring_dequeue(struct event_eth_rx_adapter *rx_adapter)
 
 			port = qd.port;
 			queue = qd.queue;
+			dev_info = &rx_adapter->eth_devices[port];
+			queue_info = &dev_info->rx_queue[queue];
+			if (queue_info->adaptive) {
+				/* Packets are received by the poll loop */
+				rte_spinlock_unlock(ring_lock);
+				rxa_adaptive_wake(rx_adapter, queue_info, port,
+						  queue);
+				work = true;
+				continue;
+			}
 			rx_adapter->qd = qd;
 			rx_adapter->qd_valid = 1;
-			dev_info = &rx_adapter->eth_devices[port];
 			if (rxa_shared_intr(dev_info, queue))
 				dev_info->shared_intr_enabled = 1;
-			else {
-				queue_info = &dev_info->rx_queue[queue];
+			else
 				queue_info->intr_enabled = 1;
-			}
 			rte_eth_dev_rx_intr_enable(port, queue);
 			rte_spinlock_unlock(ring_lock);
 		} else {
@@ -1340,6 +1453,18 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 		unsigned int poll_idx = rx_adapter->wrr_sched[wrr_pos];
 		uint16_t qid = rx_adapter->eth_rx_poll[poll_idx].eth_rx_qid;
 		uint16_t d = rx_adapter->eth_rx_poll[poll_idx].eth_dev_id;
+		struct eth_rx_queue_info *queue_info = NULL;
+		int rxq_empty;
+		uint32_t n;
+
+		if (unlikely(rx_adapter->num_rx_adaptive)) {
+			queue_info = &rx_adapter->eth_devices[d].rx_queue[qid];
+			if (!queue_info->adaptive)
+				queue_info = NULL;
+			else if (queue_info->adaptive_mode ==
+					RXA_ADAPTIVE_INTR)
+				goto poll_next_entry;
+		}
 
 		buf = rxa_event_buf_get(rx_adapter, d, qid, &stats);
 
@@ -1363,8 +1488,12 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 			}
 		}
 
-		nb_rx += rxa_eth_rx(rx_adapter, d, qid, nb_rx, max_nb_rx,
-				NULL, buf, stats);
+		n = rxa_eth_rx(rx_adapter, d, qid, nb_rx, max_nb_rx,
+			       queue_info ? &rxq_empty : NULL, buf, stats);
+		if (queue_info)
+			rxa_adaptive_update(rx_adapter, queue_info, d, qid, n,
+					    rxq_empty);
+		nb_rx += n;
 		if (nb_rx > max_nb_rx) {
 			rx_adapter->wrr_pos =
 				    (wrr_pos + 1) % rx_adapter->wrr_len;
@@ -1664,7 +1793,8 @@ rxa_free_intr_resources(struct event_eth_rx_adapter *rx_adapter)
 {
 	int ret;
 
-	if (rx_adapter->num_rx_intr == 0)
+	/* Interrupt thread is also used by adaptive mode queues */
+	if (rx_adapter->intr_ring == NULL)
 		return 0;
 
 	ret = rxa_destroy_intr_thread(rx_adapter);
@@ -1903,6 +2033,137 @@ rxa_add_intr_queue(struct event_eth_rx_adapter *rx_adapter,
 	return err;
 }
 
+/* Register the Rx interrupt of a polled queue with the interrupt thread,
+ * the interrupt is enabled only while the queue is idle
+ */
+static int
+rxa_adaptive_add(struct event_eth_rx_adapter *rx_adapter,
+		 struct eth_device_info *dev_info, int rx_queue_id)
+{
+	struct eth_rx_queue_info *queue_info;
+	uint16_t eth_dev_id = dev_info->dev->data->port_id;
+	union queue_data qd;
+	int init_fd;
+	int err, err1;
+	int i;
+
+	if (rx_queue_id == -1) {
+		for (i = 0; i < dev_info->dev->data->nb_rx_queues; i++) {
+			err = rxa_adaptive_add(rx_adapter, dev_info, i);
+			if (err)
+				return err;
+		}
+		return 0;
+	}
+
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+	if (queue_info->adaptive)
+		return 0;
+
+	if (rxa_shared_intr(dev_info, rx_queue_id)) {
+		RTE_EDEV_LOG_ERR("Adaptive mode not supported for Rx queue %d"
+				 " using a shared interrupt", rx_queue_id);
+		return -ENOTSUP;
+	}
+
+	err = rxa_intr_ring_check_avail(rx_adapter, 1);
+	if (err)
+		return err;
+
+	init_fd = rx_adapter->epd;
+	err = rxa_init_epd(rx_adapter);
+	if (err)
+		return err;
+
+	qd.port = eth_dev_id;
+	qd.queue = rx_queue_id;
+
+	err = rte_eth_dev_rx_intr_ctl_q(eth_dev_id, rx_queue_id,
+					rx_adapter->epd,
+					RTE_INTR_EVENT_ADD,
+					qd.ptr);
+	if (err) {
+		RTE_EDEV_LOG_ERR("Failed to add interrupt event for"
+			" Rx Queue %u err %d", rx_queue_id, err);
+		goto err_del_fd;
+	}
+
+	err = rxa_create_intr_thread(rx_adapter);
+	if (err)
+		goto err_del_event;
+
+	queue_info->adaptive = 1;
+	queue_info->adaptive_mode = RXA_ADAPTIVE_POLL;
+	queue_info->intr_enabled = 0;
+	queue_info->nb_polls = 0;
+	queue_info->nb_empty_polls = 0;
+	queue_info->holdoff = 0;
+	rx_adapter->num_rx_adaptive++;
+	rx_adapter->num_intr_vec++;
+	return 0;
+
+err_del_event:
+	err1 = rte_eth_dev_rx_intr_ctl_q(eth_dev_id, rx_queue_id,
+					rx_adapter->epd,
+					RTE_INTR_EVENT_DEL,
+					0);
+	if (err1) {
+		RTE_EDEV_LOG_ERR("Could not delete event for"
+				" Rx Queue %u err %d", rx_queue_id, err1);
+	}
+err_del_fd:
+	if (init_fd == INIT_FD) {
+		close(rx_adapter->epd);
+		rx_adapter->epd = INIT_FD;
+	}
+
+	return err;
+}
+
+static void
+rxa_adaptive_del(struct event_eth_rx_adapter *rx_adapter,
+		 struct eth_device_info *dev_info, int rx_queue_id)
+{
+	struct eth_rx_queue_info *queue_info;
+	uint16_t eth_dev_id = dev_info->dev->data->port_id;
+	int err;
+	int i;
+
+	if (rx_adapter->num_rx_adaptive == 0 || dev_info->rx_queue == NULL)
+		return;
+
+	if (rx_queue_id == -1) {
+		for (i = 0; i < dev_info->dev->data->nb_rx_queues; i++)
+			rxa_adaptive_del(rx_adapter, dev_info, i);
+		return;
+	}
+
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+	if (!queue_info->adaptive)
+		return;
+
+	rte_spinlock_lock(&rx_adapter->intr_ring_lock);
+	if (queue_info->intr_enabled) {
+		queue_info->intr_enabled = 0;
+		rte_eth_dev_rx_intr_disable(eth_dev_id, rx_queue_id);
+	}
+	rte_spinlock_unlock(&rx_adapter->intr_ring_lock);
+
+	err = rte_eth_dev_rx_intr_ctl_q(eth_dev_id, rx_queue_id,
+					rx_adapter->epd,
+					RTE_INTR_EVENT_DEL,
+					0);
+	if (err)
+		RTE_EDEV_LOG_ERR("Interrupt event deletion failed %d", err);
+
+	rxa_intr_ring_del_entries(rx_adapter, dev_info, rx_queue_id);
+
+	queue_info->adaptive = 0;
+	queue_info->adaptive_mode = RXA_ADAPTIVE_POLL;
+	rx_adapter->num_rx_adaptive--;
+	rx_adapter->num_intr_vec--;
+}
+
 static int
 rxa_init_service(struct event_eth_rx_adapter *rx_adapter, uint8_t id)
 {
@@ -2210,6 +2471,21 @@ rxa_sw_add(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 	int num_intr_vec;
 	uint16_t wt;
 
+	if (queue_conf->rx_queue_flags &
+	    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR) {
+		struct rte_eth_dev_data *data = dev_info->dev->data;
+
+		if (queue_conf->servicing_weight == 0 ||
+		    !data->dev_conf.intr_conf.rxq ||
+		    rx_adapter->use_queue_event_buf) {
+			RTE_EDEV_LOG_ERR("Adaptive mode needs a polled queue,"
+					 " Rx interrupts and no queue level"
+					 " event buffer dev_id: %d queue_id: %d",
+					 eth_dev_id, rx_queue_id);
+			return -EINVAL;
+		}
+	}
+
 	if (queue_conf->servicing_weight == 0) {
 		struct rte_eth_dev_data *data = dev_info->dev->data;
 
@@ -2287,7 +2563,15 @@ rxa_sw_add(struct event_eth_rx_adapter *rx_adapter, uint16_t eth_dev_id,
 		}
 	}
 
-	if (nb_rx_intr == 0) {
+	rxa_adaptive_del(rx_adapter, dev_info, rx_queue_id);
+	if (queue_conf->rx_queue_flags &
+	    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR) {
+		ret = rxa_adaptive_add(rx_adapter, dev_info, rx_queue_id);
+		if (ret)
+			goto err_free_rxqueue;
+	}
+
+	if (nb_rx_intr == 0 && rx_adapter->num_rx_adaptive == 0) {
 		ret = rxa_free_intr_resources(rx_adapter);
 		if (ret)
 			goto err_free_rxqueue;
@@ -2433,6 +2717,9 @@ rxa_create(uint8_t id, uint8_t dev_id,
 	rx_adapter->conf_cb = conf_cb;
 	rx_adapter->conf_arg = conf_arg;
 	rx_adapter->id = id;
+	rx_adapter->adaptive_window = RXA_ADAPTIVE_WINDOW_DEFAULT;
+	rx_adapter->adaptive_intr_thresh = RXA_ADAPTIVE_INTR_THRESH_DEFAULT;
+	rx_adapter->adaptive_holdoff = RXA_ADAPTIVE_HOLDOFF_DEFAULT;
 	TAILQ_INIT(&rx_adapter->vector_list);
 	strcpy(rx_adapter->mem_name, mem_name);
 	rx_adapter->eth_devices = rte_zmalloc_socket(rx_adapter->mem_name,
@@ -3049,7 +3336,9 @@ rte_event_eth_rx_adapter_queue_del(uint8_t id, uint16_t eth_dev_id,
 				goto unlock_ret;
 		}
 
-		if (nb_rx_intr == 0) {
+		rxa_adaptive_del(rx_adapter, dev_info, rx_queue_id);
+
+		if (nb_rx_intr == 0 && rx_adapter->num_rx_adaptive == 0) {
 			ret = rxa_free_intr_resources(rx_adapter);
 			if (ret)
 				goto unlock_ret;
@@ -3349,6 +3638,8 @@ rte_event_eth_rx_adapter_stats_reset(uint8_t id)
 	}
 
 	memset(&rx_adapter->stats, 0, sizeof(rx_adapter->stats));
+	rx_adapter->rx_poll_to_intr_count = 0;
+	rx_adapter->rx_intr_to_poll_count = 0;
 
 	return 0;
 }
@@ -3554,6 +3845,9 @@ rte_event_eth_rx_adapter_queue_conf_get(uint8_t id,
 	if (queue_info->flow_id_mask != 0)
 		queue_conf->rx_queue_flags |=
 			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_FLOW_ID_VALID;
+	if (queue_info->adaptive)
+		queue_conf->rx_queue_flags |=
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR;
 	queue_conf->servicing_weight = queue_info->wt;
 
 	queue_conf->ev.event = queue_info->event;
@@ -3694,6 +3988,9 @@ rte_event_eth_rx_adapter_runtime_params_init(
 
 	memset(params, 0, sizeof(struct rte_event_eth_rx_adapter_runtime_params));
 	params->max_nb_rx = RXA_NB_RX_WORK_DEFAULT;
+	params->adaptive_window = RXA_ADAPTIVE_WINDOW_DEFAULT;
+	params->adaptive_intr_thresh = RXA_ADAPTIVE_INTR_THRESH_DEFAULT;
+	params->adaptive_holdoff = RXA_ADAPTIVE_HOLDOFF_DEFAULT;
 
 	return 0;
 }
@@ -3720,8 +4017,23 @@ rte_event_eth_rx_adapter_runtime_params_set(uint8_t id,
 	if (ret)
 		return ret;
 
+	if (params->adaptive_intr_thresh > 100) {
+		RTE_EDEV_LOG_ERR("Invalid adaptive mode threshold %u",
+				 params->adaptive_intr_thresh);
+		return -EINVAL;
+	}
+
+	/* Adaptive mode parameters left to 0, e.g. by applications predating
+	 * them, keep their current value
+	 */
 	rte_spinlock_lock(&rxa->rx_lock);
 	rxa->max_nb_rx = params->max_nb_rx;
+	if (params->adaptive_window)
+		rxa->adaptive_window = params->adaptive_window;
+	if (params->adaptive_intr_thresh)
+		rxa->adaptive_intr_thresh = params->adaptive_intr_thresh;
+	if (params->adaptive_holdoff)
+		rxa->adaptive_holdoff = params->adaptive_holdoff;
 	rte_spinlock_unlock(&rxa->rx_lock);
 
 	return 0;
@@ -3750,6 +4062,9 @@ rte_event_eth_rx_adapter_runtime_params_get(uint8_t id,
 		return ret;
 
 	params->max_nb_rx = rxa->max_nb_rx;
+	params->adaptive_window = rxa->adaptive_window;
+	params->adaptive_intr_thresh = rxa->adaptive_intr_thresh;
+	params->adaptive_holdoff = rxa->adaptive_holdoff;
 
 	return 0;
 }
@@ -3764,6 +4079,7 @@ handle_rxa_stats(const char *cmd __rte_unused,
 {
 	uint8_t rx_adapter_id;
 	struct rte_event_eth_rx_adapter_stats rx_adptr_stats;
+	struct event_eth_rx_adapter *rx_adapter;
 
 	if (params == NULL || strlen(params) == 0 || !isdigit(*params))
 		return -1;
@@ -3795,6 +4111,13 @@ handle_rxa_stats(const char *cmd __rte_unused,
 	RXA_ADD_DICT(rx_adptr_stats, rx_event_buf_count);
 	RXA_ADD_DICT(rx_adptr_stats, rx_event_buf_size);
 
+	/* Not part of the adapter stats structure, to keep its ABI */
+	rx_adapter = rxa_id_to_adapter(rx_adapter_id);
+	rte_tel_data_add_dict_uint(d, "rx_poll_to_intr_count",
+				   rx_adapter->rx_poll_to_intr_count);
+	rte_tel_data_add_dict_uint(d, "rx_intr_to_poll_count",
+				   rx_adapter->rx_intr_to_poll_count);
+
 	return 0;
 }
 
@@ -109,6 +109,15 @@ extern "C" {
 /**< This flag indicates that mbufs arriving on the queue need to be vectorized
  * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
  */
+#define RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR	0x4
+/**< This flag indicates that the polled Rx queue is moved to interrupt mode
+ * when it is mostly found empty, and back to poll mode on the next Rx
+ * interrupt. The queue needs a non zero servicing weight and the ethernet
+ * device needs Rx queue interrupts enabled. Not supported with queue level
+ * event buffers or for queues using a shared interrupt.
+ * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
+ * @see rte_event_eth_rx_adapter_runtime_params::adaptive_window
+ */
 
 /**
  * Adapter configuration structure that the adapter configuration callback
@@ -326,7 +335,26 @@ struct rte_event_eth_rx_adapter_runtime_params {
 	 * This is valid for the devices without
 	 * RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT capability.
 	 */
-	uint32_t rsvd[15];
+	uint32_t adaptive_window;
+	/**< Number of polls of an adaptive Rx queue over which its empty poll
+	 * ratio is computed. A value of 0 keeps the current value.
+	 * @see RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE_INTR
+	 */
+	uint8_t adaptive_intr_thresh;
+	/**< Percentage of empty polls in a window at or above which an adaptive
+	 * Rx queue is moved to interrupt mode, in the range [1, 100].
+	 * A value of 0 keeps the current value.
+	 */
+	uint8_t rsvd8;
+	/**< Reserved field for future use */
+	uint16_t adaptive_holdoff;
+	/**< Number of windows an adaptive Rx queue stays in poll mode after
+	 * being woken up by an Rx interrupt, before its empty poll ratio is
+	 * considered again. This hysteresis avoids switching modes on every
+	 * packet for queues with sparse traffic. A value of 0 keeps the
+	 * current value.
+	 */
+	uint32_t rsvd[13];
 	/**< Reserved fields for future use */
 };
 
@@ -17,6 +17,7 @@
 #include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_common.h>
+#include <rte_spinlock.h>
 #include <rte_timer.h>
 #include <rte_service_component.h>
 #include <rte_telemetry.h>
@@ -41,6 +42,7 @@ RTE_LOG_REGISTER_SUFFIX(evtim_svc_logtype, adapter.timer.svc, NOTICE);
 static struct rte_event_timer_adapter *adapters;
 
 static const struct event_timer_adapter_ops swtim_ops;
+static const struct event_timer_adapter_ops swtim_wheel_ops;
 
 #define EVTIM_LOG(level, logtype, ...) \
 	RTE_LOG_LINE_PREFIX(level, logtype, \
@@ -69,6 +71,14 @@ get_timer_type(const struct rte_event_timer_adapter *adapter)
 			PERIODICAL : SINGLE;
 }
 
+static inline const struct event_timer_adapter_ops *
+get_swtim_ops(const struct rte_event_timer_adapter *adapter)
+{
+	return (adapter->data->conf.flags &
+			RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL) ?
+			&swtim_wheel_ops : &swtim_ops;
+}
+
 static int
 default_port_conf_cb(uint16_t id, uint8_t event_dev_id, uint8_t *event_port_id,
 		     void *conf_arg)
@@ -241,7 +251,7 @@ rte_event_timer_adapter_create_ext(
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = get_swtim_ops(adapter);
 
 	/* Allow driver to do some setup */
 	FUNC_PTR_OR_NULL_RET_WITH_ERRNO(adapter->ops->init, ENOTSUP);
@@ -390,7 +400,7 @@ rte_event_timer_adapter_lookup(uint16_t adapter_id)
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = get_swtim_ops(adapter);
 
 	/* Set fast-path function pointers */
 	adapter->arm_burst = adapter->ops->arm_burst;
@@ -619,6 +629,134 @@ event_buffer_flush(struct event_buffer *bufp, uint8_t dev_id, uint8_t port_id,
 	bufp->tail = bufp->tail + *nb_events_flushed + *nb_events_inv;
 }
 
+/*
+ * Software event timer adapter timing wheel
+ *
+ * Each lcore arming timers owns a hierarchical timing wheel, locked once per
+ * burst by the arming lcore and once per adapter tick by the service. Timers
+ * are inserted in the level matching how far they expire, and moved down one
+ * level at a time as the wheel turns, so that arming and cancelling a timer
+ * cost the same whatever the number of armed timers.
+ */
+#define SWTIM_WHEEL_LEVELS 4
+#define SWTIM_WHEEL_BITS 6
+#define SWTIM_WHEEL_SLOTS (1 << SWTIM_WHEEL_BITS)
+#define SWTIM_WHEEL_MASK (SWTIM_WHEEL_SLOTS - 1)
+/* Timers expiring further than this are cascaded more than once */
+#define SWTIM_WHEEL_RANGE (1ULL << (SWTIM_WHEEL_LEVELS * SWTIM_WHEEL_BITS))
+
+struct swtim_wheel_tim {
+	struct swtim_wheel_tim *next;
+	struct swtim_wheel_tim **pprev;
+	/* Adapter tick at which the timer expires */
+	uint64_t expire_tick;
+	/* Ticks between expiries of a periodic timer, 0 otherwise */
+	uint64_t period_ticks;
+	struct rte_event_timer *evtim;
+	/* Lcore owning the wheel the timer is in */
+	uint16_t lcore_id;
+};
+
+struct __rte_cache_aligned swtim_wheel {
+	rte_spinlock_t lock;
+	/* Last adapter tick processed */
+	uint64_t cur_tick;
+	/* Number of timers in the wheel, including expired ones */
+	uint32_t nb_timers;
+	/* Timers whose expiry event is yet to be buffered */
+	struct swtim_wheel_tim *expired;
+	struct swtim_wheel_tim *slots[SWTIM_WHEEL_LEVELS][SWTIM_WHEEL_SLOTS];
+};
+
+static inline void
+swtim_wheel_link(struct swtim_wheel_tim **head, struct swtim_wheel_tim *tim)
+{
+	tim->next = *head;
+	if (tim->next != NULL)
+		tim->next->pprev = &tim->next;
+	tim->pprev = head;
+	*head = tim;
+}
+
+static inline void
+swtim_wheel_unlink(struct swtim_wheel_tim *tim)
+{
+	*tim->pprev = tim->next;
+	if (tim->next != NULL)
+		tim->next->pprev = tim->pprev;
+	tim->pprev = NULL;
+}
+
+static inline void
+swtim_wheel_insert(struct swtim_wheel *w, struct swtim_wheel_tim *tim)
+{
+	uint64_t expire = tim->expire_tick;
+	unsigned int level;
+	uint64_t delta;
+
+	if (expire <= w->cur_tick) {
+		swtim_wheel_link(&w->expired, tim);
+		return;
+	}
+
+	delta = expire - w->cur_tick;
+	if (delta >= SWTIM_WHEEL_RANGE) {
+		expire = w->cur_tick + SWTIM_WHEEL_RANGE - 1;
+		delta = SWTIM_WHEEL_RANGE - 1;
+	}
+
+	for (level = 0; level < SWTIM_WHEEL_LEVELS - 1; level++)
+		if (delta < (1ULL << ((level + 1) * SWTIM_WHEEL_BITS)))
+			break;
+
+	swtim_wheel_link(&w->slots[level][(expire >> (level * SWTIM_WHEEL_BITS)) &
+			 SWTIM_WHEEL_MASK], tim);
+}
+
+/* Turn the wheel up to now_tick, moving the timers which expired to the
+ * expired list.
+ */
+static void
+swtim_wheel_advance(struct swtim_wheel *w, uint64_t now_tick)
+{
+	struct swtim_wheel_tim *tim, *next;
+	unsigned int level;
+	uint64_t tick;
+
+	while (w->cur_tick < now_tick) {
+		if (w->nb_timers == 0) {
+			w->cur_tick = now_tick;
+			break;
+		}
+
+		tick = ++w->cur_tick;
+
+		/* Move down the timers of the upper levels slots reached */
+		for (level = SWTIM_WHEEL_LEVELS - 1; level > 0; level--) {
+			struct swtim_wheel_tim **slot;
+
+			if (tick & ((1ULL << (level * SWTIM_WHEEL_BITS)) - 1))
+				continue;
+
+			slot = &w->slots[level][(tick >> (level * SWTIM_WHEEL_BITS)) &
+						SWTIM_WHEEL_MASK];
+			tim = *slot;
+			*slot = NULL;
+			for (; tim != NULL; tim = next) {
+				next = tim->next;
+				swtim_wheel_insert(w, tim);
+			}
+		}
+
+		tim = w->slots[0][tick & SWTIM_WHEEL_MASK];
+		w->slots[0][tick & SWTIM_WHEEL_MASK] = NULL;
+		for (; tim != NULL; tim = next) {
+			next = tim->next;
+			swtim_wheel_link(&w->expired, tim);
+		}
+	}
+}
+
 /*
  * Software event timer adapter implementation
  */
@@ -652,9 +790,15 @@ struct swtim {
 	/* The number of lists that should be polled */
 	RTE_ATOMIC(int) n_poll_lcores;
 	/* Timers which have expired and can be returned to a mempool */
-	struct rte_timer *expired_timers[EXP_TIM_BUF_SZ];
+	void *expired_timers[EXP_TIM_BUF_SZ];
 	/* The number of timers that can be returned to a mempool */
 	size_t n_expired_timers;
+	/* Timing wheel of each lcore, when RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL
+	 * is set
+	 */
+	struct swtim_wheel *wheels;
+	/* Timer cycles per adapter tick */
+	uint64_t cycles_per_tick;
 };
 
 static inline struct swtim *
@@ -888,6 +1032,116 @@ swtim_service_func(void *arg)
 	return prior_enq_count == sw->stats.ev_enq_count ? -EAGAIN : 0;
 }
 
+/* Buffer the expiry events of the timers which expired in a wheel */
+static void
+swtim_wheel_expire(struct rte_event_timer_adapter *adapter, struct swtim *sw,
+		   struct swtim_wheel *w)
+{
+	struct swtim_wheel_tim *tim;
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+
+	while ((tim = w->expired) != NULL) {
+		struct rte_event_timer *evtim = tim->evtim;
+
+		if (event_buffer_add(&sw->buffer, &evtim->ev) < 0) {
+			if (tim->period_ticks == 0) {
+				/* Leave it expired, to process it again on
+				 * the next tick.
+				 */
+				sw->stats.evtim_retry_count++;
+				break;
+			}
+			sw->stats.evtim_drop_count++;
+		} else {
+			sw->stats.evtim_exp_count++;
+		}
+
+		swtim_wheel_unlink(tim);
+		if (tim->period_ticks == 0) {
+			w->nb_timers--;
+			if (unlikely(sw->n_expired_timers == EXP_TIM_BUF_SZ)) {
+				rte_mempool_put_bulk(sw->tim_pool,
+						     sw->expired_timers,
+						     sw->n_expired_timers);
+				sw->n_expired_timers = 0;
+			}
+			sw->expired_timers[sw->n_expired_timers++] = tim;
+			rte_atomic_store_explicit(&evtim->state,
+					RTE_EVENT_TIMER_NOT_ARMED,
+					rte_memory_order_release);
+		} else {
+			/* Skip the periods missed, if any */
+			tim->expire_tick += tim->period_ticks;
+			if (tim->expire_tick <= w->cur_tick)
+				tim->expire_tick = w->cur_tick + 1;
+			swtim_wheel_insert(w, tim);
+		}
+
+		if (event_buffer_batch_ready(&sw->buffer)) {
+			event_buffer_flush(&sw->buffer,
+					   adapter->data->event_dev_id,
+					   adapter->data->event_port_id,
+					   &nb_evs_flushed,
+					   &nb_evs_invalid);
+
+			sw->stats.ev_enq_count += nb_evs_flushed;
+			sw->stats.ev_inv_count += nb_evs_invalid;
+		}
+	}
+}
+
+static int
+swtim_wheel_service_func(void *arg)
+{
+	struct rte_event_timer_adapter *adapter = arg;
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+	const uint64_t prior_enq_count = sw->stats.ev_enq_count;
+
+	if (swtim_did_tick(sw)) {
+		uint64_t now_tick = rte_get_timer_cycles() /
+				sw->cycles_per_tick;
+		int i, n_lcores;
+
+		n_lcores = rte_atomic_load_explicit(&sw->n_poll_lcores,
+				rte_memory_order_relaxed);
+		for (i = 0; i < n_lcores; i++) {
+			unsigned int lcore = rte_atomic_load_explicit(
+					&sw->poll_lcores[i],
+					rte_memory_order_relaxed);
+			struct swtim_wheel *w = &sw->wheels[lcore];
+
+			rte_spinlock_lock(&w->lock);
+			swtim_wheel_advance(w, now_tick);
+			swtim_wheel_expire(adapter, sw, w);
+			rte_spinlock_unlock(&w->lock);
+		}
+
+		/* Return expired timer objects back to mempool */
+		rte_mempool_put_bulk(sw->tim_pool, sw->expired_timers,
+				     sw->n_expired_timers);
+		sw->n_expired_timers = 0;
+
+		sw->stats.adapter_tick_count++;
+	}
+
+	event_buffer_flush(&sw->buffer,
+			   adapter->data->event_dev_id,
+			   adapter->data->event_port_id,
+			   &nb_evs_flushed,
+			   &nb_evs_invalid);
+
+	sw->stats.ev_enq_count += nb_evs_flushed;
+	sw->stats.ev_inv_count += nb_evs_invalid;
+
+	rte_event_maintain(adapter->data->event_dev_id,
+			   adapter->data->event_port_id, 0);
+
+	return prior_enq_count == sw->stats.ev_enq_count ? -EAGAIN : 0;
+}
+
 /* The adapter initialization function rounds the mempool size up to the next
  * power of 2, so we can take the difference between that value and what the
  * user requested, and use the space for caches.  This avoids a scenario where a
@@ -925,6 +1179,9 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	struct swtim *sw;
 	unsigned int flags;
 	struct rte_service_spec service;
+	const bool wheel = !!(adapter->data->conf.flags &
+			      RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL);
+	size_t tim_size;
 
 	/* Allocate storage for private data area */
 #define SWTIM_NAMESIZE 32
@@ -956,8 +1213,10 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	int cache_size = compute_msg_mempool_cache_size(
 				adapter->data->conf.nb_timers, nb_timers);
 	flags = 0; /* pool is multi-producer, multi-consumer */
+	tim_size = wheel ? sizeof(struct swtim_wheel_tim) :
+			   sizeof(struct rte_timer);
 	sw->tim_pool = rte_mempool_create(pool_name, pool_size,
-			sizeof(struct rte_timer), cache_size, 0, NULL, NULL,
+			tim_size, cache_size, 0, NULL, NULL,
 			NULL, NULL, adapter->data->socket_id, flags);
 	if (sw->tim_pool == NULL) {
 		EVTIM_LOG_ERR("failed to create timer object mempool");
@@ -969,6 +1228,24 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	for (i = 0; i < RTE_MAX_LCORE; i++)
 		sw->in_use[i].v = 0;
 
+	if (wheel) {
+		sw->wheels = rte_zmalloc_socket(NULL,
+				sizeof(struct swtim_wheel) * RTE_MAX_LCORE,
+				RTE_CACHE_LINE_SIZE, adapter->data->socket_id);
+		if (sw->wheels == NULL) {
+			EVTIM_LOG_ERR("failed to allocate timing wheels");
+			rte_errno = ENOMEM;
+			goto free_mempool;
+		}
+		for (i = 0; i < RTE_MAX_LCORE; i++)
+			rte_spinlock_init(&sw->wheels[i].lock);
+
+		sw->cycles_per_tick = RTE_MAX((uint64_t)1, (uint64_t)
+				(sw->timer_tick_ns *
+				 (rte_get_timer_hz() / NSECPERSEC)));
+		goto init_buffer;
+	}
+
 	/* Initialize the timer subsystem and allocate timer data instance */
 	ret = rte_timer_subsystem_init();
 	if (ret < 0) {
@@ -986,6 +1263,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 		goto free_mempool;
 	}
 
+init_buffer:
 	/* Initialize timer event buffer */
 	event_buffer_init(&sw->buffer);
 
@@ -996,7 +1274,8 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	snprintf(service.name, RTE_SERVICE_NAME_MAX,
 		 "swtim_svc_%"PRIu8, adapter->data->id);
 	service.socket_id = adapter->data->socket_id;
-	service.callback = swtim_service_func;
+	service.callback = wheel ? swtim_wheel_service_func :
+				   swtim_service_func;
 	service.callback_userdata = adapter;
 	service.capabilities &= ~(RTE_SERVICE_CAP_MT_SAFE);
 	ret = rte_service_component_register(&service, &sw->service_id);
@@ -1006,7 +1285,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 			      ret);
 
 		rte_errno = ENOSPC;
-		goto free_mempool;
+		goto free_timer_data;
 	}
 
 	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
@@ -1016,6 +1295,11 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	adapter->data->service_inited = 1;
 
 	return 0;
+free_timer_data:
+	if (wheel)
+		rte_free(sw->wheels);
+	else
+		rte_timer_data_dealloc(sw->timer_data_id);
 free_mempool:
 	rte_mempool_free(sw->tim_pool);
 free_alloc:
@@ -1040,6 +1324,10 @@ swtim_uninit(struct rte_event_timer_adapter *adapter)
 	int ret;
 	struct swtim *sw = swtim_pmd_priv(adapter);
 
+	/* Outstanding timers of the wheels go away with the mempool */
+	if (sw->wheels != NULL)
+		goto unregister;
+
 	/* Free outstanding timers */
 	rte_timer_stop_all(sw->timer_data_id,
 			   (unsigned int *)(uintptr_t)sw->poll_lcores,
@@ -1053,6 +1341,7 @@ swtim_uninit(struct rte_event_timer_adapter *adapter)
 		return ret;
 	}
 
+unregister:
 	ret = rte_service_component_unregister(sw->service_id);
 	if (ret < 0) {
 		EVTIM_LOG_ERR("failed to unregister service component");
@@ -1060,6 +1349,7 @@ swtim_uninit(struct rte_event_timer_adapter *adapter)
 	}
 
 	rte_mempool_free(sw->tim_pool);
+	rte_free(sw->wheels);
 	rte_free(sw);
 	adapter->data->adapter_priv = NULL;
 
@@ -1180,29 +1470,14 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 	return 0;
 }
 
-static uint16_t
-__swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
-		struct rte_event_timer **evtims,
-		uint16_t nb_evtims)
+/* Return the lcore whose timer list the calling thread arms timers in */
+static inline uint32_t
+swtim_arm_lcore_get(struct swtim *sw)
 {
-	int i, ret;
-	struct swtim *sw = swtim_pmd_priv(adapter);
 	uint32_t lcore_id = rte_lcore_id();
-	struct rte_timer *tim, *tims[nb_evtims];
-	uint64_t cycles;
-	int n_lcores;
 	/* Timer list for this lcore is not in use. */
 	uint16_t exp_state = 0;
-	enum rte_event_timer_state n_state;
-	enum rte_timer_type type = SINGLE;
-
-#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
-	/* Check that the service is running. */
-	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
-		rte_errno = EINVAL;
-		return 0;
-	}
-#endif
+	int n_lcores;
 
 	/* Adjust lcore_id if non-EAL thread. Arbitrarily pick the timer list of
 	 * the highest lcore to insert such timers into
@@ -1227,6 +1502,32 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 				rte_memory_order_relaxed);
 	}
 
+	return lcore_id;
+}
+
+static uint16_t
+__swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer **evtims,
+		uint16_t nb_evtims)
+{
+	int i, ret;
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	uint32_t lcore_id;
+	struct rte_timer *tim, *tims[nb_evtims];
+	uint64_t cycles;
+	enum rte_event_timer_state n_state;
+	enum rte_timer_type type = SINGLE;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	lcore_id = swtim_arm_lcore_get(sw);
+
 	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims,
 				   nb_evtims);
 	if (ret < 0) {
@@ -1382,6 +1683,239 @@ swtim_arm_tmo_tick_burst(const struct rte_event_timer_adapter *adapter,
 	return __swtim_arm_burst(adapter, evtims, nb_evtims);
 }
 
+static int
+swtim_wheel_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
+				const struct rte_event_timer *evtim,
+				uint64_t *ticks_remaining)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel_tim *tim;
+	uint64_t now_tick;
+
+	/* Check that timer is armed */
+	n_state = rte_atomic_load_explicit(&evtim->state, rte_memory_order_acquire);
+	if (n_state != RTE_EVENT_TIMER_ARMED)
+		return -EINVAL;
+
+	tim = (struct swtim_wheel_tim *)(uintptr_t)evtim->impl_opaque[0];
+	/* Count the ticks the same way as when arming the timer */
+	now_tick = (rte_get_timer_cycles() + sw->cycles_per_tick - 1) /
+		   sw->cycles_per_tick;
+
+	*ticks_remaining = tim->expire_tick > now_tick ?
+			   tim->expire_tick - now_tick : 0;
+
+	return 0;
+}
+
+static uint16_t
+__swtim_wheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+			struct rte_event_timer **evtims,
+			uint16_t nb_evtims)
+{
+	int i, ret;
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	struct swtim_wheel_tim *tim, *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	uint64_t cycles, now_tick;
+	struct swtim_wheel *w;
+	uint32_t lcore_id;
+	bool periodic;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	lcore_id = swtim_arm_lcore_get(sw);
+	w = &sw->wheels[lcore_id];
+
+	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims,
+				   nb_evtims);
+	if (ret < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	periodic = get_timer_type(adapter) == PERIODICAL;
+
+	/* Timers expire on the first tick boundary after their timeout */
+	cycles = rte_get_timer_cycles();
+	now_tick = (cycles + sw->cycles_per_tick - 1) / sw->cycles_per_tick;
+
+	/* The whole burst is inserted at once */
+	rte_spinlock_lock(&w->lock);
+
+	/* Catch up with the current tick if the wheel did not turn */
+	if (w->nb_timers == 0)
+		w->cur_tick = cycles / sw->cycles_per_tick;
+
+	for (i = 0; i < nb_evtims; i++) {
+		uint64_t timeout_ticks = evtims[i]->timeout_ticks;
+
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtims[i],
+							   adapter) < 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(timeout_ticks * sw->timer_tick_ns >
+			     sw->max_tmo_ns)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(timeout_ticks == 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = tims[i];
+		tim->expire_tick = now_tick + timeout_ticks;
+		tim->period_ticks = periodic ? timeout_ticks : 0;
+		tim->evtim = evtims[i];
+		tim->lcore_id = lcore_id;
+
+		evtims[i]->impl_opaque[0] = (uintptr_t)tim;
+		evtims[i]->impl_opaque[1] = (uintptr_t)adapter;
+
+		swtim_wheel_insert(w, tim);
+		w->nb_timers++;
+
+		EVTIM_LOG_DBG("armed an event timer");
+		/* RELEASE ordering guarantees the adapter specific value
+		 * changes observed before the update of state.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				rte_memory_order_release);
+	}
+
+	rte_spinlock_unlock(&w->lock);
+
+	if (i < nb_evtims)
+		rte_mempool_put_bulk(sw->tim_pool,
+				     (void **)&tims[i], nb_evtims - i);
+
+	return i;
+}
+
+static uint16_t
+swtim_wheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+		      struct rte_event_timer **evtims,
+		      uint16_t nb_evtims)
+{
+	return __swtim_wheel_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static uint16_t
+swtim_wheel_arm_tmo_tick_burst(const struct rte_event_timer_adapter *adapter,
+			       struct rte_event_timer **evtims,
+			       uint64_t timeout_ticks,
+			       uint16_t nb_evtims)
+{
+	int i;
+
+	for (i = 0; i < nb_evtims; i++)
+		evtims[i]->timeout_ticks = timeout_ticks;
+
+	return __swtim_wheel_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static uint16_t
+swtim_wheel_cancel_burst(const struct rte_event_timer_adapter *adapter,
+			 struct rte_event_timer **evtims,
+			 uint16_t nb_evtims)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel *w = NULL;
+	struct swtim_wheel_tim *tim;
+	void *tims[nb_evtims];
+	int i;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	for (i = 0; i < nb_evtims; i++) {
+		/* ACQUIRE ordering guarantees the access of implementation
+		 * specific opaque data under the correct state.
+		 */
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = (struct swtim_wheel_tim *)(uintptr_t)evtims[i]->impl_opaque[0];
+		RTE_ASSERT(tim != NULL);
+
+		/* Keep the lock while the timers are in the same wheel */
+		if (w != &sw->wheels[tim->lcore_id]) {
+			if (w != NULL)
+				rte_spinlock_unlock(&w->lock);
+			w = &sw->wheels[tim->lcore_id];
+			rte_spinlock_lock(&w->lock);
+		}
+
+		/* The timer may have expired since its state was read */
+		n_state = rte_atomic_load_explicit(&evtims[i]->state,
+				rte_memory_order_acquire);
+		if (n_state != RTE_EVENT_TIMER_ARMED ||
+		    w != &sw->wheels[tim->lcore_id]) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		swtim_wheel_unlink(tim);
+		w->nb_timers--;
+		tims[i] = tim;
+
+		/* The RELEASE ordering here pairs with atomic ordering
+		 * to make sure the state update data observed between
+		 * threads.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				rte_memory_order_release);
+	}
+
+	if (w != NULL)
+		rte_spinlock_unlock(&w->lock);
+
+	if (i > 0)
+		rte_mempool_put_bulk(sw->tim_pool, tims, i);
+
+	return i;
+}
+
 static const struct event_timer_adapter_ops swtim_ops = {
 	.init = swtim_init,
 	.uninit = swtim_uninit,
@@ -1396,6 +1930,20 @@ static const struct event_timer_adapter_ops swtim_ops = {
 	.remaining_ticks_get = swtim_remaining_ticks_get,
 };
 
+static const struct event_timer_adapter_ops swtim_wheel_ops = {
+	.init = swtim_init,
+	.uninit = swtim_uninit,
+	.start = swtim_start,
+	.stop = swtim_stop,
+	.get_info = swtim_get_info,
+	.stats_get = swtim_stats_get,
+	.stats_reset = swtim_stats_reset,
+	.arm_burst = swtim_wheel_arm_burst,
+	.arm_tmo_tick_burst = swtim_wheel_arm_tmo_tick_burst,
+	.cancel_burst = swtim_wheel_cancel_burst,
+	.remaining_ticks_get = swtim_wheel_remaining_ticks_get,
+};
+
 static int
 handle_ta_info(const char *cmd __rte_unused, const char *params,
 		struct rte_tel_data *d)
@@ -157,6 +157,16 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL	(1ULL << 3)
+/**< Flag to keep the timers of a software event timer adapter in per lcore
+ * hierarchical timing wheels instead of rte_timer skip lists. Arming and
+ * cancelling a timer take constant time regardless of the number of armed
+ * timers, at the cost of expiring timers on the service core at the
+ * granularity of the adapter resolution. Ignored by hardware adapters.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
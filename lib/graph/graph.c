@@ -877,6 +877,100 @@ rte_graph_list_dump(FILE *f)
 	graph_scan_dump(f, 0, true);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_hist_enable, 26.03)
+int
+rte_graph_hist_enable(rte_graph_t id, bool enable)
+{
+	struct rte_graph *graph;
+	struct graph *_graph;
+	int rc = 0;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	graph_spinlock_lock();
+	_graph = graph_from_id(id);
+	if (_graph == NULL)
+		SET_ERR_JMP(EINVAL, fail, "Graph id %u not found", id);
+
+	graph = _graph->graph;
+	if (enable)
+		graph->stats_flags |= RTE_GRAPH_STATS_F_HIST;
+	else
+		graph->stats_flags &= ~RTE_GRAPH_STATS_F_HIST;
+	goto done;
+fail:
+	rc = -rte_errno;
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_path_trace_enable, 26.03)
+int
+rte_graph_path_trace_enable(rte_graph_t id, uint32_t sample_rate)
+{
+	struct graph_path_trace *trace;
+	struct rte_graph *graph;
+	struct graph *_graph;
+	int rc = 0;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	graph_spinlock_lock();
+	_graph = graph_from_id(id);
+	if (_graph == NULL)
+		SET_ERR_JMP(EINVAL, fail, "Graph id %u not found", id);
+
+	graph = _graph->graph;
+	if (sample_rate != 0 && graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
+		SET_ERR_JMP(ENOTSUP, fail, "Graph %u uses mcore dispatch model", id);
+
+	trace = graph_path_trace_state(graph);
+	graph->stats_flags &= ~RTE_GRAPH_STATS_F_PATH_TRACE;
+	if (sample_rate != 0) {
+		trace->active = false;
+		trace->sample_rate = sample_rate;
+		trace->countdown = sample_rate;
+		rte_atomic_thread_fence(rte_memory_order_release);
+		graph->stats_flags |= RTE_GRAPH_STATS_F_PATH_TRACE;
+	}
+	goto done;
+fail:
+	rc = -rte_errno;
+done:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_path_trace_get, 26.03)
+int
+rte_graph_path_trace_get(rte_graph_t id, struct rte_graph_path_trace *traces,
+			 uint16_t nb_traces)
+{
+	struct graph *graph;
+	int rc;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	if (traces == NULL && nb_traces != 0)
+		return -EINVAL;
+
+	graph_spinlock_lock();
+	graph = graph_from_id(id);
+	if (graph == NULL)
+		SET_ERR_JMP(EINVAL, fail, "Graph id %u not found", id);
+
+	rc = graph_path_trace_get(graph->graph, traces, nb_traces);
+	graph_spinlock_unlock();
+	return rc;
+fail:
+	graph_spinlock_unlock();
+	return -rte_errno;
+}
+
 RTE_EXPORT_SYMBOL(rte_graph_max_count)
 rte_graph_t
 rte_graph_max_count(void)
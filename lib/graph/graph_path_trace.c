@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include "graph_private.h"
+
+static bool
+path_trace_is_entry(const struct graph_path_trace *trace, rte_graph_off_t off)
+{
+	rte_node_t i;
+
+	for (i = 0; i < trace->nb_entries; i++)
+		if (trace->entries[i] == off)
+			return true;
+
+	return false;
+}
+
+void
+graph_path_trace_populate(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+	struct graph_path_trace *trace = graph_path_trace_state(graph);
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+	rte_edge_t i;
+
+	memset(trace, 0, sizeof(*trace));
+
+	/* Objects are sampled when entering the nodes fed by source nodes */
+	rte_graph_foreach_node(count, off, graph, node) {
+		struct node *n = node_from_name(node->name);
+
+		if (n == NULL || !(n->flags & RTE_NODE_SOURCE_F))
+			continue;
+
+		for (i = 0; i < node->nb_edges; i++) {
+			if (path_trace_is_entry(trace, node->nodes[i]->off))
+				continue;
+			trace->entries[trace->nb_entries++] = node->nodes[i]->off;
+		}
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_graph_path_trace_node, 26.03)
+void
+__rte_graph_path_trace_node(struct rte_graph *graph, struct rte_node *node,
+			    void **objs, uint16_t nb_objs)
+{
+	struct graph_path_trace *trace = graph_path_trace_state(graph);
+	uint16_t i;
+
+	/* Objects move between the graphs of the lcores in dispatch model */
+	if (unlikely(graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH))
+		return;
+
+	if (!trace->active) {
+		if (nb_objs == 0 || !path_trace_is_entry(trace, node->off))
+			return;
+
+		if (trace->countdown > nb_objs) {
+			trace->countdown -= nb_objs;
+			return;
+		}
+
+		trace->active = true;
+		trace->obj = objs[trace->countdown - 1];
+		trace->countdown = trace->sample_rate;
+		trace->cur.ts = rte_rdtsc();
+		trace->cur.nb_nodes = 0;
+	} else {
+		for (i = 0; i < nb_objs; i++)
+			if (objs[i] == trace->obj)
+				break;
+		if (i == nb_objs)
+			return;
+	}
+
+	if (trace->cur.nb_nodes < RTE_GRAPH_PATH_TRACE_NODES)
+		trace->cur.nodes[trace->cur.nb_nodes] = node->id;
+	trace->cur.nb_nodes++;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_graph_path_trace_walk_end, 26.03)
+void
+__rte_graph_path_trace_walk_end(struct rte_graph *graph)
+{
+	struct graph_path_trace *trace = graph_path_trace_state(graph);
+	uint32_t nb_traces;
+
+	if (!trace->active)
+		return;
+
+	trace->cur.cycles = rte_rdtsc() - trace->cur.ts;
+	nb_traces = rte_atomic_load_explicit(&trace->nb_traces, rte_memory_order_relaxed);
+	trace->traces[nb_traces % RTE_GRAPH_PATH_TRACE_NB] = trace->cur;
+	rte_atomic_store_explicit(&trace->nb_traces, nb_traces + 1, rte_memory_order_release);
+	trace->active = false;
+}
+
+int
+graph_path_trace_get(struct rte_graph *graph, struct rte_graph_path_trace *traces,
+		     uint16_t nb_traces)
+{
+	struct graph_path_trace *trace = graph_path_trace_state(graph);
+	uint32_t total, first, i;
+
+	total = rte_atomic_load_explicit(&trace->nb_traces, rte_memory_order_acquire);
+	nb_traces = RTE_MIN(nb_traces, RTE_MIN(total, (uint32_t)RTE_GRAPH_PATH_TRACE_NB));
+	first = total - nb_traces;
+	for (i = 0; i < nb_traces; i++)
+		traces[i] = trace->traces[(first + i) % RTE_GRAPH_PATH_TRACE_NB];
+
+	return nb_traces;
+}
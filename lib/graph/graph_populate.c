@@ -20,6 +20,9 @@ graph_fp_mem_calc_size(struct graph *graph)
 
 	/* Graph header */
 	sz = sizeof(struct rte_graph);
+	/* Extended stats */
+	if (rte_graph_has_stats_feature())
+		sz += sizeof(struct rte_graph_ext_stats);
 	/* Source nodes list */
 	sz += sizeof(rte_graph_off_t) * graph->src_node_count;
 	/* Circular buffer for pending streams of size number of nodes */
@@ -38,6 +41,9 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz += sizeof(struct rte_node);
 		/* Pointer to next nodes(edges) */
 		sz += sizeof(struct rte_node *) * graph_node->node->nb_edges;
+		/* Cycles histogram */
+		if (rte_graph_has_stats_feature())
+			sz += sizeof(uint64_t) * RTE_GRAPH_HIST_BUCKETS;
 	}
 	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 	graph->xstats_start = sz;
@@ -48,6 +54,13 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 		sz += sizeof(uint64_t) * graph_node->node->xstats->nb_xstats;
 	}
+	if (rte_graph_has_stats_feature()) {
+		/* Object path trace state with an entry slot per node */
+		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+		graph->path_trace_start = sz;
+		sz += sizeof(struct graph_path_trace);
+		sz += sizeof(rte_graph_off_t) * graph->node_count;
+	}
 
 	graph->mem_sz = sz;
 	return sz;
@@ -67,6 +80,12 @@ graph_header_popluate(struct graph *_graph)
 	graph->socket = _graph->socket;
 	graph->id = _graph->id;
 	memcpy(graph->name, _graph->name, RTE_GRAPH_NAMESIZE);
+	if (rte_graph_has_stats_feature()) {
+		struct rte_graph_ext_stats *ext_stats = __rte_graph_ext_stats(graph);
+
+		memset(ext_stats, 0, sizeof(*ext_stats));
+		ext_stats->path_trace_off = _graph->path_trace_start;
+	}
 	graph->fence = RTE_GRAPH_FENCE;
 }
 
@@ -121,6 +140,10 @@ graph_nodes_populate(struct graph *_graph)
 		}
 
 		off += sizeof(struct rte_node *) * nb_edges;
+		if (rte_graph_has_stats_feature()) {
+			memset(__rte_node_hist(node), 0, sizeof(uint64_t) * RTE_GRAPH_HIST_BUCKETS);
+			off += sizeof(uint64_t) * RTE_GRAPH_HIST_BUCKETS;
+		}
 		off = RTE_ALIGN(off, RTE_CACHE_LINE_SIZE);
 		node->next = off;
 		__rte_node_stream_alloc(graph, node);
@@ -215,6 +238,8 @@ graph_fp_mem_populate(struct graph *graph)
 	graph_nodes_populate(graph);
 	rc = graph_node_nexts_populate(graph);
 	rc |= graph_src_nodes_offset_populate(graph);
+	if (rc == 0 && rte_graph_has_stats_feature())
+		graph_path_trace_populate(graph);
 
 	return rc;
 }
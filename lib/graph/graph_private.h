@@ -85,6 +85,38 @@ struct graph_node {
 	struct graph_node *adjacency_list[]; /**< Adjacency list of the node. */
 };
 
+/**
+ * @internal
+ *
+ * Structure that holds the object path trace state of a graph.
+ */
+struct graph_path_trace {
+	uint32_t sample_rate; /**< Trace one object out of sample_rate. */
+	uint32_t countdown;   /**< Objects left to skip before next sample. */
+	bool active;	      /**< Trace in progress. */
+	void *obj;	      /**< Object being traced. */
+	RTE_ATOMIC(uint32_t) nb_traces; /**< Number of traces stored so far. */
+	struct rte_graph_path_trace cur; /**< Trace in progress. */
+	struct rte_graph_path_trace traces[RTE_GRAPH_PATH_TRACE_NB];
+	/**< Ring of stored traces. */
+	rte_node_t nb_entries; /**< Number of entry nodes. */
+	rte_graph_off_t entries[]; /**< Offsets of the nodes fed by source nodes. */
+};
+
+/**
+ * @internal
+ *
+ * Get the object path trace state of a graph.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static inline struct graph_path_trace *
+graph_path_trace_state(struct rte_graph *graph)
+{
+	return RTE_PTR_ADD(graph, __rte_graph_ext_stats(graph)->path_trace_off);
+}
+
 /**
  * @internal
  *
@@ -101,6 +133,8 @@ struct graph {
 	/**< Node memory start offset in graph reel. */
 	rte_graph_off_t xstats_start;
 	/**< Node xstats memory start offset in graph reel. */
+	rte_graph_off_t path_trace_start;
+	/**< Object path trace memory start offset in graph reel. */
 	rte_node_t src_node_count;
 	/**< Number of source nodes in a graph. */
 	struct rte_graph *graph;
@@ -378,6 +412,34 @@ int graph_fp_mem_create(struct graph *graph);
  */
 int graph_fp_mem_destroy(struct graph *graph);
 
+/**
+ * @internal
+ *
+ * Initialize the object path trace state of the graph.
+ *
+ * @param graph
+ *   Pointer to the internal graph object.
+ */
+void graph_path_trace_populate(struct graph *graph);
+
+/**
+ * @internal
+ *
+ * Copy the most recent object path traces of the graph.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param traces
+ *   Array to fill with traces, oldest first.
+ * @param nb_traces
+ *   Size of the traces array.
+ *
+ * @return
+ *   Number of traces copied.
+ */
+int graph_path_trace_get(struct rte_graph *graph, struct rte_graph_path_trace *traces,
+			 uint16_t nb_traces);
+
 /* Lookup functions */
 /**
  * @internal
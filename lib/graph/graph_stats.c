@@ -24,6 +24,7 @@ struct cluster {
 /* Capture same node ID across cluster  */
 struct cluster_node {
 	struct rte_graph_cluster_node_stats stat;
+	uint64_t hist[RTE_GRAPH_HIST_BUCKETS]; /* Aggregated cycles histogram */
 	rte_node_t nb_nodes;
 
 	struct rte_node *nodes[];
@@ -37,6 +38,8 @@ struct __rte_cache_aligned rte_graph_cluster_stats {
 	int socket_id;
 	bool dispatch;
 	void *cookie;
+	rte_graph_t nb_graphs;
+	struct rte_graph **graphs; /* Graphs of the cluster for walk stats */
 
 	struct cluster_node clusters[];
 };
@@ -140,10 +143,51 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+static uint64_t
+hist_total(const uint64_t *hist)
+{
+	uint64_t total = 0;
+	unsigned int i;
+
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		total += hist[i];
+
+	return total;
+}
+
+/* Upper bound in cycles of the histogram bucket holding the given per mille */
+static uint64_t
+hist_percentile(const uint64_t *hist, unsigned int permille)
+{
+	uint64_t total = hist_total(hist), count = 0;
+	unsigned int i;
+
+	if (total == 0)
+		return 0;
+
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS - 1; i++) {
+		count += hist[i];
+		if (count * 1000 >= total * permille)
+			break;
+	}
+
+	return i ? RTE_BIT64(i) - 1 : 0;
+}
+
+static inline void
+print_hist(FILE *f, const uint64_t *hist)
+{
+	fprintf(f, "|\t%-24s|cycles/call p50 <= %" PRIu64 ", p90 <= %" PRIu64
+		", p99 <= %" PRIu64 ", p99.9 <= %" PRIu64 "\n", "histogram",
+		hist_percentile(hist, 500), hist_percentile(hist, 900),
+		hist_percentile(hist, 990), hist_percentile(hist, 999));
+}
+
 static int
 graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
 {
+	const uint64_t *hist;
 	FILE *f = cookie;
 
 	if (unlikely(is_first))
@@ -152,6 +196,12 @@ graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		print_node(f, stat, dispatch);
 		if (stat->xstat_cntrs)
 			print_xstat(f, stat, dispatch);
+		/* The default callback is passed the stats of a cluster node,
+		 * its first member.
+		 */
+		hist = ((const struct cluster_node *)stat)->hist;
+		if (hist_total(hist))
+			print_hist(f, hist);
 	}
 	if (unlikely(is_last)) {
 		if (dispatch)
@@ -426,12 +476,18 @@ rte_graph_cluster_stats_create(const struct rte_graph_cluster_stats_param *prm)
 	if (stats == NULL)
 		SET_ERR_JMP(ENOMEM, bad_pattern, "Failed rte_malloc for stats memory");
 
+	stats->graphs = rte_zmalloc_socket(NULL, sizeof(struct rte_graph *) * cluster.nb_graphs,
+					   0, stats->socket_id);
+	if (stats->graphs == NULL)
+		SET_ERR_JMP(ENOMEM, realloc_fail, "Failed rte_malloc for stats graphs");
+
 	/* Iterate over M(Graph) x N (Nodes in graph) */
 	for (i = 0; i < cluster.nb_graphs; i++) {
 		struct graph_node *graph_node;
 		struct graph *graph;
 
 		graph = cluster.graphs[i];
+		stats->graphs[stats->nb_graphs++] = graph->graph;
 		STAILQ_FOREACH(graph_node, &graph->node_list, next) {
 			struct rte_graph *graph_fp = graph->graph;
 			if (stats_mem_populate(stats, graph_fp, graph_node))
@@ -470,6 +526,7 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
+	rte_free(stat->graphs);
 	return rte_free(stat);
 }
 
@@ -482,13 +539,22 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	struct rte_node *node;
 	rte_node_t count;
 	uint64_t *xstat;
+	uint64_t *hist;
 	uint8_t i;
 
 	if (stat->xstat_cntrs != 0)
 		memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	if (rte_graph_has_stats_feature())
+		memset(cluster->hist, 0, sizeof(cluster->hist));
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
+		if (rte_graph_has_stats_feature()) {
+			hist = __rte_node_hist(node);
+			for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+				cluster->hist[i] += hist[i];
+		}
+
 		if (dispatch) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
@@ -576,6 +642,67 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->realloc_count = 0;
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
+		memset(cluster->hist, 0, sizeof(cluster->hist));
+		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_cluster_stats_walk_hist_get, 26.03)
+int
+rte_graph_cluster_stats_walk_hist_get(struct rte_graph_cluster_stats *stat,
+				      uint64_t *hist)
+{
+	const uint64_t *walk_hist;
+	rte_graph_t count;
+	unsigned int i;
+
+	if (stat == NULL || hist == NULL)
+		return -EINVAL;
+
+	memset(hist, 0, sizeof(uint64_t) * RTE_GRAPH_HIST_BUCKETS);
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	for (count = 0; count < stat->nb_graphs; count++) {
+		walk_hist = __rte_graph_ext_stats(stat->graphs[count])->walk_hist;
+		for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+			hist[i] += walk_hist[i];
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_cluster_stats_node_hist_get, 26.03)
+int
+rte_graph_cluster_stats_node_hist_get(struct rte_graph_cluster_stats *stat,
+				      rte_node_t id, uint64_t *hist)
+{
+	struct cluster_node *cluster;
+	rte_node_t count, n;
+	unsigned int i;
+
+	if (stat == NULL || hist == NULL)
+		return -EINVAL;
+
+	cluster = stat->clusters;
+	for (count = 0; count < stat->max_nodes; count++) {
+		if (cluster->stat.id == id)
+			break;
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
+	if (count == stat->max_nodes)
+		return -ENOENT;
+
+	memset(hist, 0, sizeof(uint64_t) * RTE_GRAPH_HIST_BUCKETS);
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	for (n = 0; n < cluster->nb_nodes; n++) {
+		const uint64_t *node_hist = __rte_node_hist(cluster->nodes[n]);
+
+		for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+			hist[i] += node_hist[i];
+	}
+
+	return 0;
 }
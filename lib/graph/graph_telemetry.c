@@ -0,0 +1,155 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+
+#include "graph_private.h"
+
+static int
+graph_handle_list(const char *cmd __rte_unused, const char *params __rte_unused,
+		  struct rte_tel_data *d)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+static void
+graph_tel_hist(struct rte_tel_data *d, const uint64_t *hist)
+{
+	unsigned int i;
+
+	rte_tel_data_start_array(d, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		rte_tel_data_add_array_uint(d, hist[i]);
+}
+
+static int
+graph_handle_walk_hist(const char *cmd __rte_unused, const char *params,
+		       struct rte_tel_data *d)
+{
+	struct rte_graph *graph;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	graph = rte_graph_lookup(params);
+	if (graph == NULL)
+		return -EINVAL;
+
+	graph_tel_hist(d, __rte_graph_ext_stats(graph)->walk_hist);
+
+	return 0;
+}
+
+static int
+graph_handle_node_hist(const char *cmd __rte_unused, const char *params,
+		       struct rte_tel_data *d)
+{
+	char graph_name[RTE_GRAPH_NAMESIZE];
+	const char *node_name;
+	struct rte_node *node;
+	size_t len;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	node_name = strchr(params, ',');
+	if (node_name == NULL)
+		return -EINVAL;
+
+	len = node_name - params;
+	if (len >= sizeof(graph_name))
+		return -EINVAL;
+	memcpy(graph_name, params, len);
+	graph_name[len] = '\0';
+
+	node = rte_graph_node_get_by_name(graph_name, node_name + 1);
+	if (node == NULL)
+		return -EINVAL;
+
+	graph_tel_hist(d, __rte_node_hist(node));
+
+	return 0;
+}
+
+static int
+graph_handle_path_trace(const char *cmd __rte_unused, const char *params,
+			struct rte_tel_data *d)
+{
+	struct rte_graph_path_trace traces[RTE_GRAPH_PATH_TRACE_NB];
+	char key[RTE_TEL_MAX_STRING_LEN];
+	struct rte_tel_data *cycles;
+	rte_graph_t id;
+	int nb, i, j;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	id = rte_graph_from_name(params);
+	if (id == RTE_GRAPH_ID_INVALID)
+		return -EINVAL;
+
+	nb = rte_graph_path_trace_get(id, traces, RTE_DIM(traces));
+	if (nb < 0)
+		return nb;
+
+	cycles = rte_tel_data_alloc();
+	if (cycles == NULL)
+		return -ENOMEM;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_start_array(cycles, RTE_TEL_UINT_VAL);
+	for (i = 0; i < nb; i++)
+		rte_tel_data_add_array_uint(cycles, traces[i].cycles);
+	rte_tel_data_add_dict_container(d, "cycles", cycles, 0);
+
+	for (i = 0; i < nb; i++) {
+		struct rte_tel_data *path = rte_tel_data_alloc();
+		uint16_t nb_nodes;
+
+		if (path == NULL)
+			return -ENOMEM;
+
+		rte_tel_data_start_array(path, RTE_TEL_STRING_VAL);
+		nb_nodes = RTE_MIN(traces[i].nb_nodes, RTE_GRAPH_PATH_TRACE_NODES);
+		for (j = 0; j < nb_nodes; j++)
+			rte_tel_data_add_array_string(path,
+					rte_node_id_to_name(traces[i].nodes[j]));
+		snprintf(key, sizeof(key), "path_%d", i);
+		rte_tel_data_add_dict_container(d, key, path, 0);
+	}
+
+	return 0;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/list", graph_handle_list,
+		"Returns list of available graphs. Takes no parameters");
+	rte_telemetry_register_cmd("/graph/walk_hist", graph_handle_walk_hist,
+		"Returns graph walk cycles histogram. Parameters: graph_name");
+	rte_telemetry_register_cmd("/graph/node_hist", graph_handle_node_hist,
+		"Returns node cycles per call histogram. Parameters: graph_name,node_name");
+	rte_telemetry_register_cmd("/graph/path_trace", graph_handle_path_trace,
+		"Returns sampled object paths through a graph. Parameters: graph_name");
+}
@@ -32,6 +32,9 @@ extern "C" {
 #define RTE_NODE_NAMESIZE 64  /**< Max length of node name. */
 #define RTE_NODE_XSTAT_DESC_SIZE 64  /**< Max length of node xstat description. */
 #define RTE_GRAPH_PCAP_FILE_SZ 64 /**< Max length of pcap file name. */
+#define RTE_GRAPH_HIST_BUCKETS 32 /**< Number of log2 buckets in cycle histograms. */
+#define RTE_GRAPH_PATH_TRACE_NODES 16 /**< Max nodes recorded per traced object. */
+#define RTE_GRAPH_PATH_TRACE_NB 64 /**< Number of path traces kept per graph. */
 #define RTE_GRAPH_OFF_INVALID UINT32_MAX /**< Invalid graph offset. */
 #define RTE_NODE_ID_INVALID UINT32_MAX   /**< Invalid node id. */
 #define RTE_EDGE_ID_INVALID UINT16_MAX   /**< Invalid edge id. */
@@ -245,6 +248,19 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
 };
 
+/**
+ * Path of a sampled object through a graph.
+ *
+ * @see rte_graph_path_trace_enable()
+ */
+struct rte_graph_path_trace {
+	uint64_t ts;	 /**< Timestamp at which the object was sampled. */
+	uint64_t cycles; /**< Cycles from sampling to the end of the graph walk. */
+	uint16_t nb_nodes; /**< Number of nodes visited by the object. */
+	/** Ids of the visited nodes in visit order, truncated to the array size. */
+	rte_node_t nodes[RTE_GRAPH_PATH_TRACE_NODES];
+};
+
 /**
  * Create Graph.
  *
@@ -478,6 +494,112 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
  */
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+/**
+ * Get the aggregated cycles per call histogram of a node in a cluster.
+ *
+ * Bucket n holds the number of calls to the node in all graphs of the cluster
+ * that took [2^(n-1), 2^n) cycles, the last bucket also holds longer calls.
+ *
+ * @param stat
+ *   Valid cluster stats pointer.
+ * @param id
+ *   Node id.
+ * @param[out] hist
+ *   Array of RTE_GRAPH_HIST_BUCKETS entries to fill.
+ *
+ * @return
+ *   0 on success, -ENOENT if the node is not in the cluster,
+ *   error otherwise.
+ *
+ * @see rte_graph_hist_enable()
+ */
+__rte_experimental
+int rte_graph_cluster_stats_node_hist_get(struct rte_graph_cluster_stats *stat,
+					  rte_node_t id, uint64_t *hist);
+
+/**
+ * Get the aggregated graph walk histogram of a cluster.
+ *
+ * Each bucket holds the number of rte_graph_walk() calls of all graphs in the
+ * cluster whose duration fell in the bucket, using the same log2 bucketing
+ * as rte_graph_cluster_stats_node_hist_get().
+ *
+ * @param stat
+ *   Valid cluster stats pointer.
+ * @param[out] hist
+ *   Array of RTE_GRAPH_HIST_BUCKETS entries to fill.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ *
+ * @see rte_graph_hist_enable()
+ */
+__rte_experimental
+int rte_graph_cluster_stats_walk_hist_get(struct rte_graph_cluster_stats *stat,
+					  uint64_t *hist);
+
+/**
+ * Enable or disable cycle histograms of a graph.
+ *
+ * When enabled, the cycles spent in each node call and in each graph walk are
+ * accounted in log2 buckets, reported through the cluster stats and
+ * telemetry. Histograms are not reset when disabled.
+ * Can be called while the graph is being walked.
+ *
+ * @param id
+ *   Graph id.
+ * @param enable
+ *   true to enable histograms, false to disable.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_hist_enable(rte_graph_t id, bool enable);
+
+/**
+ * Enable or disable object path tracing on a graph.
+ *
+ * One in every sample_rate objects entering the graph from a source node is
+ * followed through the nodes it visits until the end of the graph walk and
+ * its path is stored in a ring of RTE_GRAPH_PATH_TRACE_NB records.
+ * Objects handed over to another graph are not followed beyond it.
+ * Can be called while the graph is being walked, a trace in progress
+ * is then discarded.
+ * Objects are only traced by graph walks built with ALLOW_EXPERIMENTAL_API,
+ * and not with the mcore dispatch model, which disables tracing when set.
+ *
+ * @param id
+ *   Graph id.
+ * @param sample_rate
+ *   Trace one object out of sample_rate, 0 to disable tracing.
+ *
+ * @return
+ *   0 on success, -ENOTSUP if the graph uses the mcore dispatch model,
+ *   error otherwise.
+ */
+__rte_experimental
+int rte_graph_path_trace_enable(rte_graph_t id, uint32_t sample_rate);
+
+/**
+ * Get the most recent object path traces of a graph.
+ *
+ * Records are best effort when read while the graph is being walked.
+ *
+ * @param id
+ *   Graph id.
+ * @param[out] traces
+ *   Array to fill with traces, oldest first.
+ * @param nb_traces
+ *   Size of the traces array.
+ *
+ * @return
+ *   Number of traces filled on success, negative errno otherwise.
+ */
+__rte_experimental
+int rte_graph_path_trace_get(rte_graph_t id, struct rte_graph_path_trace *traces,
+			     uint16_t nb_traces);
+
 /**
  * Structure defines the number of xstats a given node has and each xstat
  * description.
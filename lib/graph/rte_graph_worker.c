@@ -26,8 +26,12 @@ rte_graph_worker_model_set(uint8_t model)
 	if (!rte_graph_model_is_valid(model))
 		return -EINVAL;
 
-	STAILQ_FOREACH(graph, graph_head, next)
-			graph->graph->model = model;
+	STAILQ_FOREACH(graph, graph_head, next) {
+		/* Object path tracing is not supported by dispatch model */
+		if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
+			graph->graph->stats_flags &= ~RTE_GRAPH_STATS_F_PATH_TRACE;
+		graph->graph->model = model;
+	}
 
 	return 0;
 }
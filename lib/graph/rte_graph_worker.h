@@ -25,6 +25,11 @@ extern "C" {
 static inline void
 rte_graph_walk(struct rte_graph *graph)
 {
+	const uint8_t stats_flags = __rte_graph_stats_flags(graph);
+	uint64_t start = 0;
+
+	if (unlikely(stats_flags))
+		start = rte_rdtsc();
 #if defined(RTE_GRAPH_MODEL_SELECT) && (RTE_GRAPH_MODEL_SELECT == RTE_GRAPH_MODEL_RTC)
 	rte_graph_walk_rtc(graph);
 #elif defined(RTE_GRAPH_MODEL_SELECT) && (RTE_GRAPH_MODEL_SELECT == RTE_GRAPH_MODEL_MCORE_DISPATCH)
@@ -38,6 +43,8 @@ rte_graph_walk(struct rte_graph *graph)
 		rte_graph_walk_rtc(graph);
 	}
 #endif
+	if (unlikely(stats_flags))
+		__rte_graph_walk_stats_update(graph, stats_flags, start);
 }
 
 #ifdef __cplusplus
@@ -16,6 +16,7 @@
 #include <stdalign.h>
 #include <stddef.h>
 
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_prefetch.h>
@@ -35,6 +36,10 @@ extern "C" {
 /**< Dispatch model to support cross-core dispatching within core affinity. */
 #define RTE_GRAPH_MODEL_DEFAULT RTE_GRAPH_MODEL_RTC /**< Default graph model. */
 
+/** Graph extended stats flags */
+#define RTE_GRAPH_STATS_F_HIST RTE_BIT32(0) /**< Cycle histograms enabled. */
+#define RTE_GRAPH_STATS_F_PATH_TRACE RTE_BIT32(1) /**< Object path tracing enabled. */
+
 /**
  * @internal
  *
@@ -56,7 +61,7 @@ struct __rte_cache_aligned rte_graph {
 	rte_graph_off_t *cir_start;  /**< Pointer to circular buffer. */
 	rte_graph_off_t nodes_start; /**< Offset at which node memory starts. */
 	uint8_t model;		     /**< graph model */
-	uint8_t reserved1;	     /**< Reserved for future use. */
+	uint8_t stats_flags;	     /**< Extended stats flags. */
 	uint16_t reserved2;	     /**< Reserved for future use. */
 	union {
 		/* Fast schedule area for mcore dispatch model */
@@ -151,6 +156,46 @@ struct __rte_cache_aligned rte_node {
 static_assert(offsetof(struct rte_node, nodes) - offsetof(struct rte_node, ctx)
 	== RTE_CACHE_LINE_MIN_SIZE, "rte_node fast path area must fit in 64 bytes");
 
+/**
+ * @internal
+ *
+ * Extended stats of a graph, right after struct rte_graph in the graph reel
+ * when the stats feature is enabled.
+ */
+struct __rte_cache_aligned rte_graph_ext_stats {
+	uint64_t walk_hist[RTE_GRAPH_HIST_BUCKETS]; /**< Graph walk cycles histogram. */
+	rte_graph_off_t path_trace_off; /**< Offset to object path trace state. */
+};
+
+/**
+ * @internal
+ *
+ * Get the extended stats of a graph.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static __rte_always_inline struct rte_graph_ext_stats *
+__rte_graph_ext_stats(struct rte_graph *graph)
+{
+	return (struct rte_graph_ext_stats *)(graph + 1);
+}
+
+/**
+ * @internal
+ *
+ * Get the cycles histogram of a node, right after its next nodes in the
+ * graph reel when the stats feature is enabled.
+ *
+ * @param node
+ *   Pointer to the node object.
+ */
+static __rte_always_inline uint64_t *
+__rte_node_hist(struct rte_node *node)
+{
+	return (uint64_t *)&node->nodes[node->nb_edges];
+}
+
 /**
  * @internal
  *
@@ -184,6 +229,93 @@ void __rte_node_stream_alloc_size(struct rte_graph *graph,
 
 /* Fast path helper functions */
 
+/**
+ * @internal
+ *
+ * Record the visit of the traced object to a node, or sample a new object
+ * to trace when node is an entry node and no trace is in progress.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ * @param objs
+ *   Objects about to be processed by the node.
+ * @param nb_objs
+ *   Number of objects.
+ */
+__rte_experimental
+void __rte_graph_path_trace_node(struct rte_graph *graph, struct rte_node *node,
+				 void **objs, uint16_t nb_objs);
+
+/**
+ * @internal
+ *
+ * Store the trace in progress, if any, at the end of a graph walk.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+__rte_experimental
+void __rte_graph_path_trace_walk_end(struct rte_graph *graph);
+
+/**
+ * @internal
+ *
+ * Account cycles in a log2 histogram.
+ *
+ * @param hist
+ *   Histogram of RTE_GRAPH_HIST_BUCKETS entries.
+ * @param cycles
+ *   Number of cycles to account.
+ */
+static __rte_always_inline void
+__rte_graph_hist_update(uint64_t *hist, uint64_t cycles)
+{
+	hist[RTE_MIN(rte_fls_u64(cycles), (uint32_t)RTE_GRAPH_HIST_BUCKETS - 1)]++;
+}
+
+/**
+ * @internal
+ *
+ * Get the extended stats flags of a graph, zero when stats are compiled out.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ */
+static __rte_always_inline uint8_t
+__rte_graph_stats_flags(const struct rte_graph *graph)
+{
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	return graph->stats_flags;
+}
+
+/**
+ * @internal
+ *
+ * Update the graph walk extended stats.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param flags
+ *   Extended stats flags sampled at the start of the walk.
+ * @param start
+ *   Timestamp at the start of the walk.
+ */
+static __rte_always_inline void
+__rte_graph_walk_stats_update(struct rte_graph *graph, uint8_t flags, uint64_t start)
+{
+	if (flags & RTE_GRAPH_STATS_F_HIST)
+		__rte_graph_hist_update(__rte_graph_ext_stats(graph)->walk_hist,
+					rte_rdtsc() - start);
+#ifdef ALLOW_EXPERIMENTAL_API
+	if (flags & RTE_GRAPH_STATS_F_PATH_TRACE)
+		__rte_graph_path_trace_walk_end(graph);
+#endif
+}
+
 /**
  * @internal
  *
@@ -206,11 +338,21 @@ __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 	rte_prefetch0(objs);
 
 	if (rte_graph_has_stats_feature()) {
+		const uint8_t flags = __rte_graph_stats_flags(graph);
+		uint64_t cycles;
+
+#ifdef ALLOW_EXPERIMENTAL_API
+		if (unlikely(flags & RTE_GRAPH_STATS_F_PATH_TRACE))
+			__rte_graph_path_trace_node(graph, node, objs, node->idx);
+#endif
 		start = rte_rdtsc();
 		rc = node->process(graph, node, objs, node->idx);
-		node->total_cycles += rte_rdtsc() - start;
+		cycles = rte_rdtsc() - start;
+		node->total_cycles += cycles;
 		node->total_calls++;
 		node->total_objs += rc;
+		if (unlikely(flags & RTE_GRAPH_STATS_F_HIST))
+			__rte_graph_hist_update(__rte_node_hist(node), cycles);
 	} else {
 		node->process(graph, node, objs, node->idx);
 	}
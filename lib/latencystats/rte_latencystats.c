@@ -23,6 +23,7 @@
 #include <rte_spinlock.h>
 #include <rte_string_fns.h>
 #include <rte_stdatomic.h>
+#include <rte_telemetry.h>
 
 #include "rte_latencystats.h"
 
@@ -57,20 +58,43 @@ static inline bool tsc_after(uint64_t t0, uint64_t t1)
 static const char *MZ_RTE_LATENCY_STATS = "rte_latencystats";
 static int latency_stats_index;
 
-static rte_spinlock_t sample_lock = RTE_SPINLOCK_INITIALIZER;
 static uint64_t samp_intvl;
 static RTE_ATOMIC(uint64_t) next_tsc;
 
 #define LATENCY_AVG_SCALE     4
 #define LATENCY_JITTER_SCALE 16
 
+/*
+ * Latencies are recorded in log-linear (HDR style) histograms: each power
+ * of two range of cycles is split in 2^LATENCY_HIST_SUB_BITS buckets,
+ * bounding the error of reported percentiles to 1/2^LATENCY_HIST_SUB_BITS.
+ * Latencies above 2^LATENCY_HIST_MAX_BITS cycles land in the last bucket.
+ */
+#define LATENCY_HIST_SUB_BITS 4
+#define LATENCY_HIST_MAX_BITS 40
+#define LATENCY_HIST_BUCKETS \
+	((LATENCY_HIST_MAX_BITS - LATENCY_HIST_SUB_BITS + 1) << LATENCY_HIST_SUB_BITS)
+
+/*
+ * Stats of the packets sent on one Tx queue. A Tx queue is only used by
+ * one thread at a time, so the stats have a single writer and are read
+ * without locking by the threads merging them.
+ */
+struct __rte_cache_aligned latency_queue_stats {
+	RTE_ATOMIC(uint64_t) samples;     /**< Number of latency samples */
+	RTE_ATOMIC(uint64_t) min_latency; /**< Minimum latency */
+	RTE_ATOMIC(uint64_t) avg_latency; /**< Average latency */
+	RTE_ATOMIC(uint64_t) max_latency; /**< Maximum latency */
+	RTE_ATOMIC(uint64_t) jitter;      /**< Latency variation */
+	uint64_t prev_latency;
+	RTE_ATOMIC(uint64_t) hist[LATENCY_HIST_BUCKETS];
+};
+
 struct rte_latency_stats {
-	uint64_t min_latency; /**< Minimum latency */
-	uint64_t avg_latency; /**< Average latency */
-	uint64_t max_latency; /**< Maximum latency */
-	uint64_t jitter; /** Latency variation */
-	uint64_t samples;    /** Number of latency samples */
-	rte_spinlock_t lock; /** Latency calculation lock */
+	uint32_t nb_queues; /**< Number of queue stats */
+	uint16_t nb_txq[RTE_MAX_ETHPORTS]; /**< Tx queues of each port */
+	uint32_t first_txq[RTE_MAX_ETHPORTS]; /**< Index of port first queue */
+	struct latency_queue_stats queues[];
 };
 
 static struct rte_latency_stats *glob_stats;
@@ -82,6 +106,19 @@ struct rxtx_cbs {
 static struct rxtx_cbs rx_cbs[RTE_MAX_ETHPORTS][RTE_MAX_QUEUES_PER_PORT];
 static struct rxtx_cbs tx_cbs[RTE_MAX_ETHPORTS][RTE_MAX_QUEUES_PER_PORT];
 
+/* Stats of some queues merged together, in cycles. */
+struct latency_summary {
+	uint64_t min_latency;
+	uint64_t avg_latency;
+	uint64_t max_latency;
+	uint64_t jitter;
+	uint64_t samples;
+	uint64_t p50_latency;
+	uint64_t p90_latency;
+	uint64_t p99_latency;
+	uint64_t p999_latency;
+};
+
 struct latency_stats_nameoff {
 	char name[RTE_ETH_XSTATS_NAME_SIZE];
 	unsigned int offset;
@@ -89,23 +126,138 @@ struct latency_stats_nameoff {
 };
 
 static const struct latency_stats_nameoff lat_stats_strings[] = {
-	{"min_latency_ns", offsetof(struct rte_latency_stats, min_latency), 1},
-	{"avg_latency_ns", offsetof(struct rte_latency_stats, avg_latency), LATENCY_AVG_SCALE},
-	{"max_latency_ns", offsetof(struct rte_latency_stats, max_latency), 1},
-	{"jitter_ns", offsetof(struct rte_latency_stats, jitter), LATENCY_JITTER_SCALE},
-	{"samples", offsetof(struct rte_latency_stats, samples), 0},
+	{"min_latency_ns", offsetof(struct latency_summary, min_latency), 1},
+	{"avg_latency_ns", offsetof(struct latency_summary, avg_latency), LATENCY_AVG_SCALE},
+	{"max_latency_ns", offsetof(struct latency_summary, max_latency), 1},
+	{"jitter_ns", offsetof(struct latency_summary, jitter), LATENCY_JITTER_SCALE},
+	{"samples", offsetof(struct latency_summary, samples), 0},
+	{"p50_latency_ns", offsetof(struct latency_summary, p50_latency), 1},
+	{"p90_latency_ns", offsetof(struct latency_summary, p90_latency), 1},
+	{"p99_latency_ns", offsetof(struct latency_summary, p99_latency), 1},
+	{"p999_latency_ns", offsetof(struct latency_summary, p999_latency), 1},
 };
 
 #define NUM_LATENCY_STATS RTE_DIM(lat_stats_strings)
 
+static inline unsigned int
+latency_hist_bucket(uint64_t latency)
+{
+	unsigned int msb, shift;
+
+	if (latency < RTE_BIT64(LATENCY_HIST_SUB_BITS))
+		return latency;
+
+	msb = 63 - rte_clz64(latency);
+	if (unlikely(msb >= LATENCY_HIST_MAX_BITS))
+		return LATENCY_HIST_BUCKETS - 1;
+
+	shift = msb - LATENCY_HIST_SUB_BITS;
+	return ((shift + 1) << LATENCY_HIST_SUB_BITS) +
+		((latency >> shift) & (RTE_BIT64(LATENCY_HIST_SUB_BITS) - 1));
+}
+
+/* Highest latency recorded in a bucket. */
+static uint64_t
+latency_hist_value(unsigned int bucket)
+{
+	unsigned int shift;
+	uint64_t sub;
+
+	if (bucket < RTE_BIT32(LATENCY_HIST_SUB_BITS))
+		return bucket;
+
+	shift = (bucket >> LATENCY_HIST_SUB_BITS) - 1;
+	sub = RTE_BIT64(LATENCY_HIST_SUB_BITS) + (bucket & (RTE_BIT32(LATENCY_HIST_SUB_BITS) - 1));
+	return ((sub + 1) << shift) - 1;
+}
+
+static inline uint64_t
+stat_load(const RTE_ATOMIC(uint64_t) *stat)
+{
+	return rte_atomic_load_explicit(stat, rte_memory_order_relaxed);
+}
+
+/* Only used by the single writer of a queue stats, no atomic RMW needed. */
+static inline void
+stat_store(RTE_ATOMIC(uint64_t) *stat, uint64_t val)
+{
+	rte_atomic_store_explicit(stat, val, rte_memory_order_relaxed);
+}
+
+/* Merge the stats of queues [first, first + nb) into a summary. */
 static void
-latencystats_collect(uint64_t values[])
+latencystats_merge(uint32_t first, uint32_t nb, struct latency_summary *sum)
+{
+	static const struct {
+		unsigned int offset;
+		unsigned int permil;
+	} percentiles[] = {
+		{ offsetof(struct latency_summary, p50_latency), 500 },
+		{ offsetof(struct latency_summary, p90_latency), 900 },
+		{ offsetof(struct latency_summary, p99_latency), 990 },
+		{ offsetof(struct latency_summary, p999_latency), 999 },
+	};
+	uint64_t hist[LATENCY_HIST_BUCKETS] = { 0 };
+	uint64_t avg = 0, jitter = 0;
+	uint64_t count, rank;
+	unsigned int b, p;
+	uint32_t q;
+
+	memset(sum, 0, sizeof(*sum));
+
+	for (q = first; q < first + nb; q++) {
+		struct latency_queue_stats *qs = &glob_stats->queues[q];
+		uint64_t samples = stat_load(&qs->samples);
+
+		if (samples == 0)
+			continue;
+
+		if (sum->samples == 0 || stat_load(&qs->min_latency) < sum->min_latency)
+			sum->min_latency = stat_load(&qs->min_latency);
+		sum->max_latency = RTE_MAX(sum->max_latency, stat_load(&qs->max_latency));
+		/* Queues moving averages are weighted by their samples */
+		avg += stat_load(&qs->avg_latency) * samples;
+		jitter += stat_load(&qs->jitter) * samples;
+		sum->samples += samples;
+
+		for (b = 0; b < LATENCY_HIST_BUCKETS; b++)
+			hist[b] += stat_load(&qs->hist[b]);
+	}
+
+	if (sum->samples == 0)
+		return;
+
+	sum->avg_latency = avg / sum->samples;
+	sum->jitter = jitter / sum->samples;
+
+	/*
+	 * Histograms are read while being updated, rank percentiles against
+	 * what was actually read rather than the samples counters.
+	 */
+	count = 0;
+	for (b = 0; b < LATENCY_HIST_BUCKETS; b++)
+		count += hist[b];
+
+	b = 0;
+	rank = hist[0];
+	for (p = 0; p < RTE_DIM(percentiles); p++) {
+		uint64_t target = (count * percentiles[p].permil + 999) / 1000;
+		uint64_t *value = RTE_PTR_ADD(sum, percentiles[p].offset);
+
+		while (rank < target && b < LATENCY_HIST_BUCKETS - 1)
+			rank += hist[++b];
+		*value = RTE_MIN(latency_hist_value(b), sum->max_latency);
+	}
+}
+
+static void
+latencystats_convert(const struct latency_summary *sum, uint64_t values[])
 {
 	unsigned int i, scale;
 	const uint64_t *stats;
 
 	for (i = 0; i < NUM_LATENCY_STATS; i++) {
-		stats = RTE_PTR_ADD(glob_stats, lat_stats_strings[i].offset);
+		stats = RTE_PTR_ADD(sum, lat_stats_strings[i].offset);
 		scale = lat_stats_strings[i].scale;
 
 		/* used to mark samples which are not a time interval */
@@ -116,6 +268,31 @@ latencystats_collect(uint64_t values[])
 	}
 }
 
+static void
+latencystats_collect(uint64_t values[])
+{
+	struct latency_summary sum;
+
+	latencystats_merge(0, glob_stats->nb_queues, &sum);
+	latencystats_convert(&sum, values);
+}
+
+/* Attach to the stats reserved by rte_latencystats_init(), possibly by another process. */
+static int
+latencystats_lookup(void)
+{
+	const struct rte_memzone *mz;
+
+	mz = rte_memzone_lookup(MZ_RTE_LATENCY_STATS);
+	if (mz == NULL)
+		return -ENOENT;
+
+	glob_stats = mz->addr;
+	cycles_per_ns = (double)rte_get_tsc_hz() / NS_PER_SEC;
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_latencystats_update)
 int32_t
 rte_latencystats_update(void)
@@ -148,6 +325,13 @@ rte_latencystats_fill_values(struct rte_metric_value *metrics)
 	}
 }
 
+static inline void
+time_stamp(struct rte_mbuf *m, uint64_t now)
+{
+	m->ol_flags |= timestamp_dynflag;
+	*timestamp_dynfield(m) = now;
+}
+
 static uint16_t
 add_time_stamps(uint16_t pid __rte_unused,
 		uint16_t qid __rte_unused,
@@ -158,28 +342,36 @@ add_time_stamps(uint16_t pid __rte_unused,
 {
 	unsigned int i;
 	uint64_t now = rte_rdtsc();
+	uint64_t next;
 
-	/* Check without locking */
-	if (likely(tsc_before(now, rte_atomic_load_explicit(&next_tsc,
-							    rte_memory_order_relaxed))))
-		return nb_pkts;
-
-	/* Try and get sample, skip if sample is being done by other core. */
-	if (likely(rte_spinlock_trylock(&sample_lock))) {
+	/* Sample every packet, no need to synchronize with other cores. */
+	if (samp_intvl == 0) {
 		for (i = 0; i < nb_pkts; i++) {
-			struct rte_mbuf *m = pkts[i];
-
 			/* skip if already timestamped */
-			if (unlikely(m->ol_flags & timestamp_dynflag))
-				continue;
-
-			m->ol_flags |= timestamp_dynflag;
-			*timestamp_dynfield(m) = now;
-			rte_atomic_store_explicit(&next_tsc, now + samp_intvl,
-						  rte_memory_order_relaxed);
-			break;
+			if (likely(!(pkts[i]->ol_flags & timestamp_dynflag)))
+				time_stamp(pkts[i], now);
 		}
-		rte_spinlock_unlock(&sample_lock);
+		return nb_pkts;
+	}
+
+	/* Check without claiming the sample */
+	next = rte_atomic_load_explicit(&next_tsc, rte_memory_order_relaxed);
+	if (likely(tsc_before(now, next)))
+		return nb_pkts;
+
+	for (i = 0; i < nb_pkts; i++) {
+		struct rte_mbuf *m = pkts[i];
+
+		/* skip if already timestamped */
+		if (unlikely(m->ol_flags & timestamp_dynflag))
+			continue;
+
+		/* Skip if sample is being done by other core. */
+		if (rte_atomic_compare_exchange_strong_explicit(&next_tsc, &next,
+				now + samp_intvl, rte_memory_order_relaxed,
+				rte_memory_order_relaxed))
+			time_stamp(m, now);
+		break;
 	}
 
 	return nb_pkts;
@@ -190,34 +382,38 @@ calc_latency(uint16_t pid __rte_unused,
 		uint16_t qid __rte_unused,
 		struct rte_mbuf **pkts,
 		uint16_t nb_pkts,
-		void *_ __rte_unused)
+		void *user_cb)
 {
+	struct latency_queue_stats *qs = user_cb;
 	unsigned int i;
-	uint64_t now, latency;
+	uint64_t now, latency, samples;
 	uint64_t ts_flags = 0;
-	static uint64_t prev_latency;
+	unsigned int bucket;
 
 	for (i = 0; i < nb_pkts; i++)
 		ts_flags |= (pkts[i]->ol_flags & timestamp_dynflag);
 
-	/* no samples in this burst, skip locking */
+	/* no samples in this burst */
 	if (likely(ts_flags == 0))
 		return nb_pkts;
 
 	now = rte_rdtsc();
-	rte_spinlock_lock(&glob_stats->lock);
+	samples = stat_load(&qs->samples);
 	for (i = 0; i < nb_pkts; i++) {
 		if (!(pkts[i]->ol_flags & timestamp_dynflag))
 			continue;
 
 		latency = now - *timestamp_dynfield(pkts[i]);
 
-		if (glob_stats->samples++ == 0) {
-			glob_stats->min_latency = latency;
-			glob_stats->max_latency = latency;
-			glob_stats->avg_latency = latency * 4;
+		bucket = latency_hist_bucket(latency);
+		stat_store(&qs->hist[bucket], stat_load(&qs->hist[bucket]) + 1);
+
+		if (samples++ == 0) {
+			stat_store(&qs->min_latency, latency);
+			stat_store(&qs->max_latency, latency);
+			stat_store(&qs->avg_latency, latency * LATENCY_AVG_SCALE);
 			/* start ad if previous sample had 0 latency */
-			glob_stats->jitter = latency / LATENCY_JITTER_SCALE;
+			stat_store(&qs->jitter, latency / LATENCY_JITTER_SCALE);
 		} else {
 			/*
 			 * The jitter is calculated as statistical mean of interpacket
@@ -230,14 +426,16 @@ calc_latency(uint16_t pid __rte_unused,
 			 * Reference: Calculated as per RFC 5481, sec 4.1,
 			 * RFC 3393 sec 4.5, RFC 1889 sec.
 			 */
-			long long delta = prev_latency - latency;
-			glob_stats->jitter += llabs(delta)
-				- glob_stats->jitter / LATENCY_JITTER_SCALE;
-
-			if (latency < glob_stats->min_latency)
-				glob_stats->min_latency = latency;
-			if (latency > glob_stats->max_latency)
-				glob_stats->max_latency = latency;
+			long long delta = qs->prev_latency - latency;
+			uint64_t jitter = stat_load(&qs->jitter);
+
+			stat_store(&qs->jitter, jitter + llabs(delta)
+				- jitter / LATENCY_JITTER_SCALE);
+
+			if (latency < stat_load(&qs->min_latency))
+				stat_store(&qs->min_latency, latency);
+			if (latency > stat_load(&qs->max_latency))
+				stat_store(&qs->max_latency, latency);
 			/*
 			 * The average latency is measured using exponential moving
 			 * average, i.e. using EWMA
@@ -245,13 +443,13 @@ calc_latency(uint16_t pid __rte_unused,
 			 *
 			 * Alpha is .25, avg_latency is scaled by 4.
 			 */
-			glob_stats->avg_latency += latency
-				- glob_stats->avg_latency / LATENCY_AVG_SCALE;
+			stat_store(&qs->avg_latency, stat_load(&qs->avg_latency) + latency
+				- stat_load(&qs->avg_latency) / LATENCY_AVG_SCALE);
 		}
 
-		prev_latency = latency;
+		qs->prev_latency = latency;
 	}
-	rte_spinlock_unlock(&glob_stats->lock);
+	stat_store(&qs->samples, samples);
 
 	return nb_pkts;
 }
@@ -268,6 +466,9 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 	const char *ptr_strings[NUM_LATENCY_STATS] = {0};
 	const struct rte_memzone *mz = NULL;
 	const unsigned int flags = 0;
+	uint16_t nb_txq[RTE_MAX_ETHPORTS] = { 0 };
+	uint32_t nb_queues = 0;
+	size_t size;
 	int ret;
 
 	if (rte_memzone_lookup(MZ_RTE_LATENCY_STATS))
@@ -277,9 +478,20 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 	if (user_cb != NULL)
 		return -ENOTSUP;
 
+	/* Each Tx queue gets its own stats, written by the queue user only */
+	RTE_ETH_FOREACH_DEV(pid) {
+		struct rte_eth_dev_info dev_info;
+
+		if (rte_eth_dev_info_get(pid, &dev_info) != 0)
+			continue;
+		nb_txq[pid] = dev_info.nb_tx_queues;
+		nb_queues += nb_txq[pid];
+	}
+
 	/** Allocate stats in shared memory fo multi process support */
-	mz = rte_memzone_reserve(MZ_RTE_LATENCY_STATS, sizeof(*glob_stats),
-					rte_socket_id(), flags);
+	size = sizeof(*glob_stats) + nb_queues * sizeof(glob_stats->queues[0]);
+	mz = rte_memzone_reserve_aligned(MZ_RTE_LATENCY_STATS, size,
+					rte_socket_id(), flags, RTE_CACHE_LINE_SIZE);
 	if (mz == NULL) {
 		LATENCY_STATS_LOG(ERR, "Cannot reserve memory: %s:%d",
 			__func__, __LINE__);
@@ -289,7 +501,14 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 	cycles_per_ns = (double)rte_get_tsc_hz() / NS_PER_SEC;
 
 	glob_stats = mz->addr;
-	rte_spinlock_init(&glob_stats->lock);
+	memset(glob_stats, 0, size);
+	glob_stats->nb_queues = nb_queues;
+	nb_queues = 0;
+	for (pid = 0; pid < RTE_MAX_ETHPORTS; pid++) {
+		glob_stats->nb_txq[pid] = nb_txq[pid];
+		glob_stats->first_txq[pid] = nb_queues;
+		nb_queues += nb_txq[pid];
+	}
 	samp_intvl = (uint64_t)(app_samp_intvl * cycles_per_ns);
 	next_tsc = rte_rdtsc();
 
@@ -336,10 +555,10 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 					"Failed to register Rx callback for pid=%u, qid=%u",
 					pid, qid);
 		}
-		for (qid = 0; qid < dev_info.nb_tx_queues; qid++) {
+		for (qid = 0; qid < RTE_MIN(dev_info.nb_tx_queues, nb_txq[pid]); qid++) {
 			cbs = &tx_cbs[pid][qid];
-			cbs->cb =  rte_eth_add_tx_callback(pid, qid,
-					calc_latency, NULL);
+			cbs->cb =  rte_eth_add_tx_callback(pid, qid, calc_latency,
+					&glob_stats->queues[glob_stats->first_txq[pid] + qid]);
 			if (!cbs->cb)
 				LATENCY_STATS_LOG(NOTICE,
 					"Failed to register Tx callback for pid=%u, qid=%u",
@@ -419,15 +638,11 @@ rte_latencystats_get(struct rte_metric_value *values, uint16_t size)
 	if (size < NUM_LATENCY_STATS || values == NULL)
 		return NUM_LATENCY_STATS;
 
-	if (rte_eal_process_type() == RTE_PROC_SECONDARY) {
-		const struct rte_memzone *mz;
-		mz = rte_memzone_lookup(MZ_RTE_LATENCY_STATS);
-		if (mz == NULL) {
-			LATENCY_STATS_LOG(ERR,
-				"Latency stats memzone not found");
-			return -ENOMEM;
-		}
-		glob_stats =  mz->addr;
+	if (rte_eal_process_type() == RTE_PROC_SECONDARY &&
+			latencystats_lookup() != 0) {
+		LATENCY_STATS_LOG(ERR,
+			"Latency stats memzone not found");
+		return -ENOMEM;
 	}
 
 	/* Retrieve latency stats */
@@ -435,3 +650,54 @@ rte_latencystats_get(struct rte_metric_value *values, uint16_t size)
 
 	return NUM_LATENCY_STATS;
 }
+
+static int
+latencystats_handle_stats(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	uint64_t values[NUM_LATENCY_STATS];
+	struct latency_summary sum;
+	unsigned long port_id, queue_id;
+	uint32_t first, nb;
+	char *end_param;
+	unsigned int i;
+
+	if (latencystats_lookup() != 0)
+		return -EINVAL;
+
+	first = 0;
+	nb = glob_stats->nb_queues;
+	if (params != NULL && strlen(params) != 0) {
+		port_id = strtoul(params, &end_param, 0);
+		if (port_id >= RTE_MAX_ETHPORTS)
+			return -EINVAL;
+		first = glob_stats->first_txq[port_id];
+		nb = glob_stats->nb_txq[port_id];
+
+		if (*end_param == ',') {
+			queue_id = strtoul(end_param + 1, &end_param, 0);
+			if (queue_id >= nb)
+				return -EINVAL;
+			first += queue_id;
+			nb = 1;
+		}
+		if (*end_param != '\0')
+			return -EINVAL;
+	}
+
+	latencystats_merge(first, nb, &sum);
+	latencystats_convert(&sum, values);
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < NUM_LATENCY_STATS; i++)
+		rte_tel_data_add_dict_uint(d, lat_stats_strings[i].name, values[i]);
+
+	return 0;
+}
+
+RTE_INIT(latencystats_init_telemetry)
+{
+	rte_telemetry_register_cmd("/latencystats/stats", latencystats_handle_stats,
+		"Returns latency stats of packets sent on all ports. "
+		"Parameters: none, port_id or port_id,queue_id");
+}
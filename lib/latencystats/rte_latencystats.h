@@ -43,9 +43,13 @@ typedef uint16_t (*rte_latency_stats_flow_type_fn)(struct rte_mbuf *pkt,
 /**
  *  Registers Rx/Tx callbacks for each active port, queue.
  *
+ * Latencies are recorded per Tx queue in histograms, from which
+ * percentiles are reported along with the minimum, average and maximum.
+ * The ports and queues must be configured before calling this function.
+ *
  * @param samp_intvl
  *  Sampling time period in nano seconds, at which packet
- *  should be marked with time stamp.
+ *  should be marked with time stamp. If 0, all packets are marked.
  * @param user_cb
  *  Note: This param is for future flow based latency stats
  *  implementation.
@@ -63,8 +67,8 @@ int rte_latencystats_init(uint64_t samp_intvl,
 			rte_latency_stats_flow_type_fn user_cb);
 
 /**
- * Calculates the latency and jitter values internally, exposing the updated
- * values via *rte_latencystats_get* or the rte_metrics API.
+ * Calculates the latency, jitter and latency percentiles values internally,
+ * exposing the updated values via *rte_latencystats_get* or the rte_metrics API.
  * @return:
  *  0      : on Success
  *  < 0    : Error in updating values.
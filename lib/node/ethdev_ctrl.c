@@ -13,9 +13,11 @@
 
 #include "ethdev_rx_priv.h"
 #include "ethdev_tx_priv.h"
+#include "flow_cache_priv.h"
 #include "ip4_rewrite_priv.h"
 #include "ip6_rewrite_priv.h"
 #include "interface_tx_feature_priv.h"
+#include "neigh_priv.h"
 #include "node_private.h"
 
 static struct ethdev_ctrl {
@@ -28,6 +30,7 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 		    uint16_t nb_graphs)
 {
 	struct rte_node_register *if_tx_feature_node;
+	struct rte_node_register *flow_cache_node;
 	struct rte_node_register *ip4_rewrite_node;
 	struct rte_node_register *ip6_rewrite_node;
 	struct ethdev_tx_node_main *tx_node_data;
@@ -40,6 +43,7 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 	uint32_t id;
 
 	if_tx_feature_node = if_tx_feature_node_get();
+	flow_cache_node = flow_cache_node_get();
 	ip4_rewrite_node = ip4_rewrite_node_get();
 	ip6_rewrite_node = ip6_rewrite_node_get();
 	tx_node_data = ethdev_tx_node_data_get();
@@ -135,6 +139,21 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 				     &next_nodes, 1);
 		rc = if_tx_feature_node_set_next(port_id,
 						 rte_node_edge_count(if_tx_feature_node->id) - 1);
+		if (rc < 0)
+			return rc;
+
+		/* Add this tx port node as next to flow_cache_node */
+		rte_node_edge_update(flow_cache_node->id, RTE_EDGE_ID_INVALID,
+				     &next_nodes, 1);
+		rc = flow_cache_set_next(port_id,
+					 rte_node_edge_count(flow_cache_node->id) - 1);
+		if (rc < 0)
+			return rc;
+
+		/* Add this tx port node to neighbor resolution nodes */
+		rc = neigh_port_edge_add(port_id, next_nodes);
+		if (rc < 0)
+			return rc;
 	}
 
 	ctrl.nb_graphs = nb_graphs;
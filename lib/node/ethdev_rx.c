@@ -59,6 +59,8 @@ l3_ptype(uint16_t etype, uint32_t ptype)
 		ptype |= RTE_PTYPE_L3_IPV4_EXT_UNKNOWN;
 	else if (etype == rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6))
 		ptype |= RTE_PTYPE_L3_IPV6_EXT_UNKNOWN;
+	else if (etype == rte_cpu_to_be_16(RTE_ETHER_TYPE_ARP))
+		ptype = (ptype & ~RTE_PTYPE_L2_MASK) | RTE_PTYPE_L2_ETHER_ARP;
 	return ptype;
 }
 
@@ -0,0 +1,498 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_mbuf_dyn.h>
+#include <rte_per_lcore.h>
+#include <rte_stdatomic.h>
+
+#include "rte_node_flow_cache_api.h"
+
+#include "flow_cache_priv.h"
+#include "node_private.h"
+
+#define FLOW_CACHE_DEFAULT_ENTRIES 4096
+#define FLOW_CACHE_HDR_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + 2 * sizeof(rte_be16_t))
+
+enum flow_cache_xstat {
+	FLOW_CACHE_XSTAT_HIT,
+	FLOW_CACHE_XSTAT_MISS,
+	FLOW_CACHE_XSTAT_LEARN,
+	FLOW_CACHE_XSTAT_FLUSH,
+	FLOW_CACHE_XSTAT_CYCLES_SAVED,
+	FLOW_CACHE_XSTAT_MAX,
+};
+
+/* Nodes skipped by cache hits, for the cycles saved estimate */
+static const char * const flow_cache_bypass_names[] = {
+	"pkt_cls", "ip4_lookup", "ip4_lookup_fib", "ip4_rewrite",
+};
+
+struct flow_cache_key {
+	rte_be32_t src;
+	rte_be32_t dst;
+	rte_be16_t sport;
+	rte_be16_t dport;
+	uint8_t proto;
+	uint8_t rsvd;
+	uint16_t port;
+};
+
+/* Cached decision, indexed by the position of the key in the table */
+struct __rte_cache_aligned flow_cache_entry {
+	uint16_t next;
+	uint16_t rewrite_len;
+	uint8_t rewrite_data[RTE_GRAPH_IP4_REWRITE_MAX_LEN];
+};
+
+/* Per graph flow cache */
+struct flow_cache {
+	struct rte_hash *h;
+	/* Graph owning the table */
+	const struct rte_graph *graph;
+	/* flow_cache node of the graph, for learn stats */
+	struct rte_node *node;
+	struct rte_node *bypass[RTE_DIM(flow_cache_bypass_names)];
+	/* Generation the table content belongs to */
+	uint32_t gen;
+	struct flow_cache_entry entries[];
+};
+
+struct flow_cache_node_ctx {
+	struct flow_cache *fc;
+	/* Cached next index */
+	uint16_t next_index;
+};
+
+#define FLOW_CACHE_NODE_DATA(ctx) \
+	(((struct flow_cache_node_ctx *)ctx)->fc)
+
+#define FLOW_CACHE_NODE_LAST_NEXT(ctx) \
+	(((struct flow_cache_node_ctx *)ctx)->next_index)
+
+static struct flow_cache_main {
+	RTE_ATOMIC(uint32_t) gen;
+	/**< Bumped on forwarding state changes. */
+	uint32_t nb_entries;
+	uint16_t next_index[RTE_MAX_ETHPORTS];
+	/**< Next index of each configured port. */
+} flow_cache_main = {
+	.nb_entries = FLOW_CACHE_DEFAULT_ENTRIES,
+};
+
+uint64_t flow_cache_learn_flag;
+
+/* Flow cache of the graph walked by this thread, for ip4_rewrite to learn into */
+static RTE_DEFINE_PER_LCORE(struct flow_cache *, flow_cache_cur);
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_flow_cache_configure, 26.03)
+int
+rte_node_flow_cache_configure(const struct rte_node_flow_cache_cfg *cfg)
+{
+	if (cfg == NULL || cfg->nb_entries == 0)
+		return -EINVAL;
+
+	flow_cache_main.nb_entries = cfg->nb_entries;
+
+	return 0;
+}
+
+void
+flow_cache_invalidate(void)
+{
+	rte_atomic_fetch_add_explicit(&flow_cache_main.gen, 1, rte_memory_order_release);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_flow_cache_invalidate, 26.03)
+void
+rte_node_flow_cache_invalidate(void)
+{
+	flow_cache_invalidate();
+}
+
+int
+flow_cache_set_next(uint16_t port_id, uint16_t next_index)
+{
+	if (port_id >= RTE_MAX_ETHPORTS)
+		return -EINVAL;
+
+	flow_cache_main.next_index[port_id] = next_index;
+
+	return 0;
+}
+
+/* Returns false for packets not cached: non first fragments, options or not TCP/UDP */
+static __rte_always_inline bool
+flow_cache_key_get(struct flow_cache_key *key, const struct rte_ipv4_hdr *ip, uint16_t port)
+{
+	const rte_be16_t *l4 = (const rte_be16_t *)(ip + 1);
+
+	if (ip->version_ihl != RTE_IPV4_VHL_DEF ||
+	    (ip->fragment_offset & RTE_BE16(RTE_IPV4_HDR_MF_FLAG | RTE_IPV4_HDR_OFFSET_MASK)) ||
+	    (ip->next_proto_id != IPPROTO_TCP && ip->next_proto_id != IPPROTO_UDP))
+		return false;
+
+	key->src = ip->src_addr;
+	key->dst = ip->dst_addr;
+	key->sport = l4[0];
+	key->dport = l4[1];
+	key->proto = ip->next_proto_id;
+	key->rsvd = 0;
+	key->port = port;
+
+	return true;
+}
+
+static __rte_always_inline hash_sig_t
+flow_cache_sig(const struct flow_cache *fc, const struct rte_mbuf *mbuf,
+	       const struct flow_cache_key *key)
+{
+	/* Same key always comes with the same RSS hash on a given port */
+	if (mbuf->ol_flags & RTE_MBUF_F_RX_RSS_HASH)
+		return mbuf->hash.rss;
+
+	return rte_hash_hash(fc->h, key);
+}
+
+/* Drop the table content once forwarding state changed */
+static __rte_always_inline void
+flow_cache_gen_check(struct flow_cache *fc, struct rte_node *node)
+{
+	uint32_t gen = rte_atomic_load_explicit(&flow_cache_main.gen, rte_memory_order_acquire);
+
+	if (likely(fc->gen == gen))
+		return;
+
+	rte_hash_reset(fc->h);
+	fc->gen = gen;
+	NODE_INCREMENT_XSTAT_ID(node, FLOW_CACHE_XSTAT_FLUSH, true, 1);
+}
+
+/* Average cycles the skipped nodes spend per packet */
+static __rte_always_inline uint64_t
+flow_cache_bypass_cycles(const struct flow_cache *fc)
+{
+	const struct rte_node *n;
+	uint64_t cycles = 0;
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(fc->bypass); i++) {
+		n = fc->bypass[i];
+		if (n != NULL && n->total_objs)
+			cycles += n->total_cycles / n->total_objs;
+	}
+
+	return cycles;
+}
+
+/* Do what ip4_lookup and ip4_rewrite would, returns the Tx edge */
+static __rte_always_inline uint16_t
+flow_cache_hit(const struct flow_cache *fc, struct rte_mbuf *mbuf, int32_t pos)
+{
+	const struct flow_cache_entry *e = &fc->entries[pos];
+	struct rte_ipv4_hdr *ip;
+	uint32_t cksum;
+	uint8_t ttl;
+	void *d;
+
+	d = rte_pktmbuf_mtod(mbuf, void *);
+	ip = (struct rte_ipv4_hdr *)((uint8_t *)d + sizeof(struct rte_ether_hdr));
+
+	/* Decrement ttl, incremental checksum update */
+	ttl = ip->time_to_live - 1;
+	cksum = rte_be_to_cpu_16(ip->hdr_checksum) + 0x0100;
+	cksum = (cksum & 0xffff) + (cksum >> 16);
+
+	rte_memcpy(d, e->rewrite_data, e->rewrite_len);
+
+	ip->time_to_live = ttl;
+	ip->hdr_checksum = rte_cpu_to_be_16(cksum);
+
+	return e->next;
+}
+
+static uint16_t
+flow_cache_node_process(struct rte_graph *graph, struct rte_node *node,
+			void **objs, uint16_t nb_objs)
+{
+	struct flow_cache *fc = FLOW_CACHE_NODE_DATA(node->ctx);
+	struct flow_cache_key keys[RTE_HASH_LOOKUP_BULK_MAX];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_mbuf **pkts = (struct rte_mbuf **)objs;
+	hash_sig_t sigs[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t pos[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t res[RTE_HASH_LOOKUP_BULK_MAX];
+	uint8_t slot[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t next_index, next = 0, off, nb, n, i;
+	uint16_t held = 0, last_spec = 0, hits = 0;
+	const struct rte_ether_hdr *eth;
+	struct rte_mbuf *mbuf;
+	void **to_next, **from;
+
+	flow_cache_gen_check(fc, node);
+	RTE_PER_LCORE(flow_cache_cur) = fc;
+
+	/* Speculative next as last next */
+	next_index = FLOW_CACHE_NODE_LAST_NEXT(node->ctx);
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	from = objs;
+
+	for (off = 0; off < nb_objs; off += nb) {
+		nb = RTE_MIN(nb_objs - off, RTE_HASH_LOOKUP_BULK_MAX);
+
+		/* Extract keys of cacheable packets */
+		for (i = 0, n = 0; i < nb; i++) {
+			mbuf = pkts[off + i];
+			eth = rte_pktmbuf_mtod(mbuf, const struct rte_ether_hdr *);
+			res[i] = -EINVAL;
+
+			if (unlikely(rte_pktmbuf_data_len(mbuf) < FLOW_CACHE_HDR_LEN ||
+				     eth->ether_type != RTE_BE16(RTE_ETHER_TYPE_IPV4)))
+				continue;
+
+			if (!flow_cache_key_get(&keys[n], (const struct rte_ipv4_hdr *)(eth + 1),
+						mbuf->port))
+				continue;
+
+			key_ptrs[n] = &keys[n];
+			sigs[n] = flow_cache_sig(fc, mbuf, &keys[n]);
+			slot[n++] = i;
+		}
+
+		if (n) {
+			rte_hash_lookup_with_hash_bulk(fc->h, key_ptrs, sigs, n, pos);
+			for (i = 0; i < n; i++)
+				res[slot[i]] = pos[i];
+		}
+
+		for (i = 0; i < nb; i++) {
+			mbuf = pkts[off + i];
+
+			if (res[i] >= 0) {
+				next = flow_cache_hit(fc, mbuf, res[i]);
+				hits++;
+			} else {
+				/* Let ip4_rewrite cache the decision */
+				if (res[i] == -ENOENT)
+					mbuf->ol_flags |= flow_cache_learn_flag;
+				next = RTE_NODE_FLOW_CACHE_NEXT_PKT_CLS;
+			}
+
+			if (unlikely(next_index ^ next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, FLOW_CACHE_XSTAT_HIT, hits, hits);
+	NODE_INCREMENT_XSTAT_ID(node, FLOW_CACHE_XSTAT_MISS, hits != nb_objs, nb_objs - hits);
+	NODE_INCREMENT_XSTAT_ID(node, FLOW_CACHE_XSTAT_CYCLES_SAVED, hits,
+				hits * flow_cache_bypass_cycles(fc));
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+	/* Save the last next used */
+	FLOW_CACHE_NODE_LAST_NEXT(node->ctx) = next;
+
+	return nb_objs;
+}
+
+void
+flow_cache_ip4_learn(const struct rte_graph *graph, struct rte_mbuf *mbuf,
+		     const struct ip4_rewrite_nh_header *nh, uint16_t port)
+{
+	struct flow_cache *fc = RTE_PER_LCORE(flow_cache_cur);
+	struct flow_cache_entry *e;
+	struct flow_cache_key key;
+	uint16_t next;
+	int32_t pos;
+
+	mbuf->ol_flags &= ~flow_cache_learn_flag;
+
+	/* Only cache into the table of the graph the packet came from */
+	if (fc == NULL || fc->graph != graph || port >= RTE_MAX_ETHPORTS)
+		return;
+
+	/* Forwarding state changed since the lookup, table is dropped on next walk */
+	if (fc->gen != rte_atomic_load_explicit(&flow_cache_main.gen, rte_memory_order_acquire))
+		return;
+
+	next = flow_cache_main.next_index[port];
+	if (next == 0 || rte_pktmbuf_data_len(mbuf) < FLOW_CACHE_HDR_LEN)
+		return;
+
+	if (!flow_cache_key_get(&key, rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+							      sizeof(struct rte_ether_hdr)),
+				mbuf->port))
+		return;
+
+	pos = rte_hash_add_key_with_hash(fc->h, &key, flow_cache_sig(fc, mbuf, &key));
+	if (unlikely(pos == -ENOSPC)) {
+		/* Table full, start over with the active flows */
+		rte_hash_reset(fc->h);
+		NODE_INCREMENT_XSTAT_ID(fc->node, FLOW_CACHE_XSTAT_FLUSH, true, 1);
+		pos = rte_hash_add_key_with_hash(fc->h, &key, flow_cache_sig(fc, mbuf, &key));
+	}
+	if (unlikely(pos < 0))
+		return;
+
+	e = &fc->entries[pos];
+	memcpy(e->rewrite_data, nh->rewrite_data, nh->rewrite_len);
+	e->rewrite_len = nh->rewrite_len;
+	e->next = next;
+
+	NODE_INCREMENT_XSTAT_ID(fc->node, FLOW_CACHE_XSTAT_LEARN, true, 1);
+}
+
+static struct rte_node *
+flow_cache_graph_node_get(const struct rte_graph *graph, const char *name)
+{
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+
+	rte_graph_foreach_node(count, off, graph, node) {
+		if (!strncmp(node->name, name, RTE_NODE_NAMESIZE))
+			return node;
+	}
+
+	return NULL;
+}
+
+static int
+flow_cache_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	uint32_t nb_entries = flow_cache_main.nb_entries;
+	struct rte_hash_parameters params = {0};
+	static const struct rte_mbuf_dynflag learn_flag = {
+		.name = "rte_node_flow_cache_learn",
+	};
+	char name[RTE_HASH_NAMESIZE];
+	struct flow_cache *fc;
+	unsigned int i;
+	int bit;
+
+	RTE_BUILD_BUG_ON(sizeof(struct flow_cache_node_ctx) > RTE_NODE_CTX_SZ);
+
+	bit = rte_mbuf_dynflag_register(&learn_flag);
+	if (bit < 0) {
+		node_err("flow_cache", "Failed to register mbuf dynflag");
+		return -rte_errno;
+	}
+
+	fc = rte_zmalloc_socket("flow_cache", sizeof(*fc) + nb_entries * sizeof(fc->entries[0]),
+				RTE_CACHE_LINE_SIZE, graph->socket);
+	if (fc == NULL) {
+		node_err("flow_cache", "Failed to allocate flow cache on graph %s", graph->name);
+		return -ENOMEM;
+	}
+
+	/* Each graph clone owns its table, no locking needed */
+	snprintf(name, sizeof(name), "flow_cache_%u", graph->id);
+	params.name = name;
+	params.entries = nb_entries;
+	params.key_len = sizeof(struct flow_cache_key);
+	params.hash_func = rte_hash_crc;
+	params.socket_id = graph->socket;
+	fc->h = rte_hash_create(&params);
+	if (fc->h == NULL) {
+		node_err("flow_cache", "Failed to create flow table on graph %s", graph->name);
+		rte_free(fc);
+		return -rte_errno;
+	}
+
+	for (i = 0; i < RTE_DIM(flow_cache_bypass_names); i++)
+		fc->bypass[i] = flow_cache_graph_node_get(graph, flow_cache_bypass_names[i]);
+	fc->graph = graph;
+	fc->node = node;
+	fc->gen = rte_atomic_load_explicit(&flow_cache_main.gen, rte_memory_order_acquire);
+
+	flow_cache_learn_flag = RTE_BIT64(bit);
+	FLOW_CACHE_NODE_DATA(node->ctx) = fc;
+	/* By default, set cached next node to pkt_cls */
+	FLOW_CACHE_NODE_LAST_NEXT(node->ctx) = RTE_NODE_FLOW_CACHE_NEXT_PKT_CLS;
+
+	node_dbg("flow_cache", "Initialized flow_cache node on graph %s", graph->name);
+
+	return 0;
+}
+
+static void
+flow_cache_node_fini(const struct rte_graph *graph __rte_unused, struct rte_node *node)
+{
+	struct flow_cache *fc = FLOW_CACHE_NODE_DATA(node->ctx);
+
+	if (fc == NULL)
+		return;
+
+	if (RTE_PER_LCORE(flow_cache_cur) == fc)
+		RTE_PER_LCORE(flow_cache_cur) = NULL;
+
+	rte_hash_free(fc->h);
+	rte_free(fc);
+	FLOW_CACHE_NODE_DATA(node->ctx) = NULL;
+}
+
+static struct rte_node_xstats flow_cache_xstats = {
+	.nb_xstats = FLOW_CACHE_XSTAT_MAX,
+	.xstat_desc = {
+		[FLOW_CACHE_XSTAT_HIT] = "flow_cache_hit",
+		[FLOW_CACHE_XSTAT_MISS] = "flow_cache_miss",
+		[FLOW_CACHE_XSTAT_LEARN] = "flow_cache_learn",
+		[FLOW_CACHE_XSTAT_FLUSH] = "flow_cache_flush",
+		[FLOW_CACHE_XSTAT_CYCLES_SAVED] = "flow_cache_cycles_saved",
+	},
+};
+
+static struct rte_node_register flow_cache_node = {
+	.process = flow_cache_node_process,
+	.name = "flow_cache",
+
+	.init = flow_cache_node_init,
+	.fini = flow_cache_node_fini,
+	.xstats = &flow_cache_xstats,
+
+	.nb_edges = RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_FLOW_CACHE_NEXT_PKT_CLS] = "pkt_cls",
+		[RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+flow_cache_node_get(void)
+{
+	return &flow_cache_node;
+}
+
+RTE_NODE_REGISTER(flow_cache_node);
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+#ifndef __INCLUDE_FLOW_CACHE_PRIV_H__
+#define __INCLUDE_FLOW_CACHE_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_flow_cache_api.h"
+
+#include "ip4_rewrite_priv.h"
+
+/**
+ * @internal
+ *
+ * Mbuf flag of packets missed by flow_cache, for ip4_rewrite to cache
+ * their next hop. Zero until flow_cache node is part of a graph.
+ */
+extern uint64_t flow_cache_learn_flag;
+
+/**
+ * @internal
+ *
+ * Cache the next hop a packet missed by flow_cache is sent to.
+ *
+ * @param graph
+ *   Graph the packet is walking.
+ * @param mbuf
+ *   Packet rewritten by ip4_rewrite, its flow_cache_learn_flag is cleared.
+ * @param nh
+ *   Next hop of the packet.
+ * @param port
+ *   Tx port of the next hop.
+ */
+void flow_cache_ip4_learn(const struct rte_graph *graph, struct rte_mbuf *mbuf,
+			  const struct ip4_rewrite_nh_header *nh, uint16_t port);
+
+/**
+ * @internal
+ *
+ * Drop cached flows after a change of routes or rewrite data.
+ */
+void flow_cache_invalidate(void);
+
+/**
+ * @internal
+ *
+ * Set the edge index of a given port_id.
+ *
+ * @param port_id
+ *   Ethernet port identifier.
+ * @param next_index
+ *   Edge index of the Tx node of the port.
+ */
+int flow_cache_set_next(uint16_t port_id, uint16_t next_index);
+
+/**
+ * @internal
+ *
+ * Get the flow_cache node.
+ */
+struct rte_node_register *flow_cache_node_get(void);
+
+#endif /* __INCLUDE_FLOW_CACHE_PRIV_H__ */
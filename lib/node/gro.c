@@ -0,0 +1,208 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <eal_export.h>
+#include <rte_cycles.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_net.h>
+
+#include "rte_node_gro_gso_api.h"
+
+#include "node_private.h"
+
+#define GRO_DEFAULT_MAX_FLOW_NUM 64
+#define GRO_DEFAULT_MAX_ITEM_PER_FLOW 32
+#define GRO_DEFAULT_TIMEOUT_US 100
+#define GRO_PREFETCH_AHEAD 4
+
+/* Per graph GRO data */
+struct gro_node_data {
+	/* GRO context holding the reassembly tables */
+	void *gro_ctx;
+	/* GRO types reassembled and flushed */
+	uint64_t gro_types;
+	/* Max age of held packets */
+	uint64_t timeout_cycles;
+	/* Burst size below which all packets are flushed */
+	uint16_t flush_thresh;
+};
+
+struct gro_node_ctx {
+	struct gro_node_data *data;
+};
+
+#define GRO_NODE_DATA(ctx) \
+	(((struct gro_node_ctx *)ctx)->data)
+
+static struct rte_node_gro_cfg gro_cfg = {
+	.gro_types = RTE_GRO_TCP_IPV4 | RTE_GRO_UDP_IPV4,
+	.max_flow_num = GRO_DEFAULT_MAX_FLOW_NUM,
+	.max_item_per_flow = GRO_DEFAULT_MAX_ITEM_PER_FLOW,
+	.timeout_us = GRO_DEFAULT_TIMEOUT_US,
+	.flush_thresh = RTE_GRAPH_BURST_SIZE,
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_gro_configure, 26.03)
+int
+rte_node_gro_configure(const struct rte_node_gro_cfg *cfg)
+{
+	if (cfg == NULL || cfg->gro_types == 0 || cfg->max_flow_num == 0 ||
+	    cfg->max_item_per_flow == 0)
+		return -EINVAL;
+
+	gro_cfg = *cfg;
+
+	return 0;
+}
+
+static __rte_always_inline void
+gro_pkt_parse(struct rte_mbuf *mbuf)
+{
+	struct rte_net_hdr_lens hdr_lens;
+
+	/* GRO needs L4 packet type and header lengths which Rx may not provide */
+	mbuf->packet_type = rte_net_get_ptype(mbuf, &hdr_lens,
+			RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK);
+	mbuf->l2_len = hdr_lens.l2_len;
+	mbuf->l3_len = hdr_lens.l3_len;
+	mbuf->l4_len = hdr_lens.l4_len;
+}
+
+/* GRO updates the length of merged packets but not their IPv4 checksum */
+static __rte_always_inline void
+gro_pkts_ip_cksum_fix(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	struct rte_ipv4_hdr *ip;
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (pkts[i]->nb_segs == 1 || !RTE_ETH_IS_IPV4_HDR(pkts[i]->packet_type))
+			continue;
+
+		ip = rte_pktmbuf_mtod_offset(pkts[i], struct rte_ipv4_hdr *, pkts[i]->l2_len);
+		ip->hdr_checksum = 0;
+		ip->hdr_checksum = rte_ipv4_cksum(ip);
+	}
+}
+
+static uint16_t
+gro_node_process(struct rte_graph *graph, struct rte_node *node,
+		 void **objs, uint16_t nb_objs)
+{
+	struct gro_node_data *gd = GRO_NODE_DATA(node->ctx);
+	struct rte_mbuf **pkts = (struct rte_mbuf **)objs;
+	uint16_t nb_pkts, nb_held, i;
+	uint64_t timeout;
+	void **to_next;
+
+	for (i = 0; i < GRO_PREFETCH_AHEAD && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
+	for (i = 0; i < nb_objs; i++) {
+		if (likely(i + GRO_PREFETCH_AHEAD < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + GRO_PREFETCH_AHEAD], void *));
+		gro_pkt_parse(pkts[i]);
+	}
+
+	/* Packets not held for merging are left at the start of pkts */
+	nb_pkts = rte_gro_reassemble(pkts, nb_objs, gd->gro_ctx);
+	nb_held = RTE_MIN(rte_gro_get_pkt_count(gd->gro_ctx),
+			  (uint64_t)(UINT16_MAX - nb_pkts));
+
+	/* Flush everything once the Rx stream runs dry, else only aged packets */
+	timeout = (nb_objs < gd->flush_thresh) ? 0 : gd->timeout_cycles;
+
+	to_next = rte_node_next_stream_get(graph, node, RTE_NODE_GRO_NEXT_PKT_CLS,
+					   nb_pkts + nb_held);
+	rte_memcpy(to_next, pkts, nb_pkts * sizeof(pkts[0]));
+	if (nb_held) {
+		nb_held = rte_gro_timeout_flush(gd->gro_ctx, timeout, gd->gro_types,
+						(struct rte_mbuf **)&to_next[nb_pkts], nb_held);
+		gro_pkts_ip_cksum_fix((struct rte_mbuf **)&to_next[nb_pkts], nb_held);
+		nb_pkts += nb_held;
+	}
+	rte_node_next_stream_put(graph, node, RTE_NODE_GRO_NEXT_PKT_CLS, nb_pkts);
+
+	return nb_objs;
+}
+
+static int
+gro_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct rte_gro_param param = {0};
+	struct gro_node_data *gd;
+
+	RTE_BUILD_BUG_ON(sizeof(struct gro_node_ctx) > RTE_NODE_CTX_SZ);
+
+	gd = rte_zmalloc_socket("gro_node_data", sizeof(*gd), RTE_CACHE_LINE_SIZE,
+				graph->socket);
+	if (gd == NULL) {
+		node_err("gro", "Failed to allocate GRO data on graph %s", graph->name);
+		return -ENOMEM;
+	}
+
+	param.gro_types = gro_cfg.gro_types;
+	param.max_flow_num = gro_cfg.max_flow_num;
+	param.max_item_per_flow = gro_cfg.max_item_per_flow;
+	param.socket_id = graph->socket == SOCKET_ID_ANY ? 0 : graph->socket;
+
+	/* Each graph clone owns its reassembly tables */
+	gd->gro_ctx = rte_gro_ctx_create(&param);
+	if (gd->gro_ctx == NULL) {
+		node_err("gro", "Failed to create GRO context on graph %s", graph->name);
+		rte_free(gd);
+		return -ENOMEM;
+	}
+
+	gd->gro_types = gro_cfg.gro_types;
+	gd->timeout_cycles = (rte_get_timer_hz() * gro_cfg.timeout_us) / US_PER_S;
+	gd->flush_thresh = gro_cfg.flush_thresh;
+	GRO_NODE_DATA(node->ctx) = gd;
+
+	node_dbg("gro", "Initialized gro node on graph %s", graph->name);
+
+	return 0;
+}
+
+static void
+gro_node_fini(const struct rte_graph *graph __rte_unused, struct rte_node *node)
+{
+	struct gro_node_data *gd = GRO_NODE_DATA(node->ctx);
+	struct rte_mbuf *pkts[RTE_GRAPH_BURST_SIZE];
+	uint16_t nb_pkts;
+
+	if (gd == NULL)
+		return;
+
+	/* Release packets still held in the reassembly tables */
+	do {
+		nb_pkts = rte_gro_timeout_flush(gd->gro_ctx, 0, gd->gro_types, pkts,
+						RTE_DIM(pkts));
+		rte_pktmbuf_free_bulk(pkts, nb_pkts);
+	} while (nb_pkts);
+
+	rte_gro_ctx_destroy(gd->gro_ctx);
+	rte_free(gd);
+	GRO_NODE_DATA(node->ctx) = NULL;
+}
+
+static struct rte_node_register gro_node = {
+	.process = gro_node_process,
+	.name = "gro",
+
+	.init = gro_node_init,
+	.fini = gro_node_fini,
+
+	.nb_edges = RTE_NODE_GRO_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_GRO_NEXT_PKT_CLS] = "pkt_cls",
+		[RTE_NODE_GRO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gro_node);
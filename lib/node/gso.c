@@ -0,0 +1,310 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <eal_export.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_feature_arc_worker.h>
+#include <rte_graph_worker.h>
+#include <rte_gso.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_net.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#include "rte_node_gro_gso_api.h"
+#include "rte_node_ip4_api.h"
+
+#include "node_private.h"
+
+#define GSO_MAX_SEGS 64
+
+enum gso_next {
+	GSO_NEXT_PKT_DROP,
+	GSO_NEXT_MAX,
+};
+
+/* Per port GSO configuration */
+struct gso_node_main {
+	uint16_t gso_size[RTE_MAX_ETHPORTS];
+	uint8_t tso[RTE_MAX_ETHPORTS];
+};
+
+struct gso_node_ctx {
+	/* Cached feature arc handle */
+	rte_graph_feature_arc_t out_arc;
+	/* Cached next index */
+	uint16_t last_index;
+};
+
+#define GSO_FEATURE_ARC(ctx) \
+	(((struct gso_node_ctx *)ctx)->out_arc)
+
+#define GSO_LAST_NEXT_INDEX(ctx) \
+	(((struct gso_node_ctx *)ctx)->last_index)
+
+static struct gso_node_main *gso_nm;
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_gso_configure, 26.03)
+int
+rte_node_gso_configure(uint16_t port_id, uint16_t gso_size)
+{
+	struct rte_eth_conf conf;
+	int rc;
+
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return -EINVAL;
+
+	if (gso_size && gso_size < RTE_GSO_SEG_SIZE_MIN)
+		return -EINVAL;
+
+	rc = rte_eth_dev_conf_get(port_id, &conf);
+	if (rc)
+		return rc;
+
+	if (gso_nm == NULL) {
+		gso_nm = rte_zmalloc("gso_nm", sizeof(struct gso_node_main),
+				     RTE_CACHE_LINE_SIZE);
+		if (gso_nm == NULL)
+			return -ENOMEM;
+	}
+
+	gso_nm->tso[port_id] = !!(conf.txmode.offloads & RTE_ETH_TX_OFFLOAD_TCP_TSO);
+	gso_nm->gso_size[port_id] = gso_size;
+
+	return 0;
+}
+
+/* GSO neither checks nor updates checksums of output packets */
+static __rte_always_inline void
+gso_seg_cksum(struct rte_mbuf *seg)
+{
+	struct rte_ipv4_hdr *ip;
+
+	ip = rte_pktmbuf_mtod_offset(seg, struct rte_ipv4_hdr *, seg->l2_len);
+	ip->hdr_checksum = 0;
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	/* UDP is segmented in IP fragments, only the first one has its header */
+	if (ip->fragment_offset & rte_cpu_to_be_16(RTE_IPV4_HDR_OFFSET_MASK))
+		return;
+
+	if (ip->next_proto_id == IPPROTO_TCP) {
+		struct rte_tcp_hdr *tcp = RTE_PTR_ADD(ip, seg->l3_len);
+
+		tcp->cksum = 0;
+		tcp->cksum = rte_ipv4_udptcp_cksum_mbuf(seg, ip, seg->l2_len + seg->l3_len);
+	} else {
+		struct rte_udp_hdr *udp = RTE_PTR_ADD(ip, seg->l3_len);
+
+		udp->dgram_cksum = 0;
+	}
+}
+
+/* Returns number of packets written to segs, 0 if mbuf must be dropped */
+static __rte_always_inline uint16_t
+gso_pkt_segment(struct rte_mbuf *mbuf, uint16_t gso_size, uint8_t tso,
+		struct rte_mbuf **segs)
+{
+	struct rte_net_hdr_lens hdr_lens;
+	struct rte_gso_ctx gso_ctx;
+	uint32_t ptype, l4;
+	int nb_segs, i;
+
+	ptype = rte_net_get_ptype(mbuf, &hdr_lens,
+				  RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK);
+	l4 = ptype & RTE_PTYPE_L4_MASK;
+	if (!RTE_ETH_IS_IPV4_HDR(ptype) || (l4 != RTE_PTYPE_L4_TCP && l4 != RTE_PTYPE_L4_UDP)) {
+		segs[0] = mbuf;
+		return 1;
+	}
+
+	mbuf->l2_len = hdr_lens.l2_len;
+	mbuf->l3_len = hdr_lens.l3_len;
+	mbuf->l4_len = hdr_lens.l4_len;
+
+	if (tso && l4 == RTE_PTYPE_L4_TCP) {
+		struct rte_ipv4_hdr *ip;
+		struct rte_tcp_hdr *tcp;
+
+		/* Leave segmentation to the port */
+		ip = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *, mbuf->l2_len);
+		tcp = RTE_PTR_ADD(ip, mbuf->l3_len);
+		mbuf->ol_flags |= RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM |
+				  RTE_MBUF_F_TX_TCP_SEG;
+		mbuf->tso_segsz = gso_size - mbuf->l2_len - mbuf->l3_len - mbuf->l4_len;
+		ip->hdr_checksum = 0;
+		tcp->cksum = rte_ipv4_phdr_cksum(ip, mbuf->ol_flags);
+		segs[0] = mbuf;
+		return 1;
+	}
+
+	/* Direct header and indirect payload mbufs come from the packet's own pool */
+	gso_ctx.direct_pool = mbuf->pool;
+	gso_ctx.indirect_pool = mbuf->pool;
+	gso_ctx.flag = 0;
+	gso_ctx.gso_types = RTE_ETH_TX_OFFLOAD_TCP_TSO | RTE_ETH_TX_OFFLOAD_UDP_TSO;
+	gso_ctx.gso_size = gso_size;
+
+	mbuf->ol_flags |= RTE_MBUF_F_TX_IPV4 |
+		(l4 == RTE_PTYPE_L4_TCP ? RTE_MBUF_F_TX_TCP_SEG : RTE_MBUF_F_TX_UDP_SEG);
+
+	nb_segs = rte_gso_segment(mbuf, &gso_ctx, segs, GSO_MAX_SEGS);
+	if (unlikely(nb_segs < 0)) {
+		rte_pktmbuf_free(mbuf);
+		return 0;
+	}
+
+	if (nb_segs == 0) {
+		segs[0] = mbuf;
+		return 1;
+	}
+
+	/* Segments hold a reference to the payload of the input packet */
+	rte_pktmbuf_free(mbuf);
+	for (i = 0; i < nb_segs; i++)
+		gso_seg_cksum(segs[i]);
+
+	return nb_segs;
+}
+
+static uint16_t
+gso_node_process(struct rte_graph *graph, struct rte_node *node,
+		 void **objs, uint16_t nb_objs)
+{
+	struct rte_graph_feature_arc *arc =
+		rte_graph_feature_arc_get(GSO_FEATURE_ARC(node->ctx));
+	struct rte_graph_feature_arc_mbuf_dynfields *mbfields;
+	struct rte_mbuf *segs[GSO_MAX_SEGS], *mbuf;
+	rte_graph_feature_data_t feature_data;
+	uint16_t last_spec = 0, held = 0;
+	uint16_t next = 0, nb_segs, i, j;
+	void **to_next, **from;
+	rte_edge_t next_index;
+
+	/* Speculative next */
+	next_index = GSO_LAST_NEXT_INDEX(node->ctx);
+
+	from = objs;
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (i = 0; i < nb_objs; i++) {
+		uint16_t gso_size, port;
+
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(objs[i + 1]);
+
+		/* Send mbuf to next enabled feature */
+		mbfields = rte_graph_feature_arc_mbuf_dynfields_get(mbuf, arc->mbuf_dyn_offset);
+		rte_graph_feature_data_next_feature_get(arc, &mbfields->feature_data, &next);
+
+		gso_size = gso_nm ? gso_nm->gso_size[mbuf->port] : 0;
+		if (likely(gso_size == 0 || rte_pktmbuf_pkt_len(mbuf) <= gso_size)) {
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+			continue;
+		}
+
+		/* Oversized packet, flush speculated ones and enqueue its segments */
+		rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+		from += last_spec;
+		to_next += last_spec;
+		held += last_spec;
+		last_spec = 0;
+		from += 1;
+
+		feature_data = mbfields->feature_data;
+		port = mbuf->port;
+		nb_segs = gso_pkt_segment(mbuf, gso_size, gso_nm->tso[port], segs);
+		if (unlikely(nb_segs == 0))
+			continue;
+
+		for (j = 0; j < nb_segs; j++) {
+			segs[j]->port = port;
+			rte_graph_feature_arc_mbuf_dynfields_get(segs[j],
+					arc->mbuf_dyn_offset)->feature_data = feature_data;
+		}
+
+		if (next == next_index) {
+			/* Segments may not fit in the speculated stream */
+			rte_node_next_stream_put(graph, node, next_index, held);
+			held = 0;
+			rte_node_enqueue(graph, node, next, (void **)segs, nb_segs);
+			to_next = rte_node_next_stream_get(graph, node, next_index,
+							   nb_objs - i - 1);
+		} else {
+			rte_node_enqueue(graph, node, next, (void **)segs, nb_segs);
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	GSO_LAST_NEXT_INDEX(node->ctx) = next;
+
+	return nb_objs;
+}
+
+static int
+gso_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	rte_graph_feature_arc_t arc;
+	int rc;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct gso_node_ctx) > RTE_NODE_CTX_SZ);
+
+	rc = rte_graph_feature_arc_lookup_by_name(RTE_IP4_OUTPUT_FEATURE_ARC_NAME, &arc);
+	if (rc) {
+		node_err("gso", "Failed to find ip4 output arc, rc=%d", rc);
+		return rc;
+	}
+
+	GSO_FEATURE_ARC(node->ctx) = arc;
+	/* pkt_drop */
+	GSO_LAST_NEXT_INDEX(node->ctx) = GSO_NEXT_PKT_DROP;
+
+	node_dbg("gso", "Initialized gso node");
+
+	return 0;
+}
+
+static struct rte_node_register gso_node = {
+	.process = gso_node_process,
+	.init = gso_node_init,
+	.name = "gso",
+	.nb_edges = GSO_NEXT_MAX,
+	.next_nodes = {
+		[GSO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gso_node);
+
+static struct rte_graph_feature_register gso_feature = {
+	.feature_name = RTE_NODE_GSO_FEATURE_NAME,
+	.arc_name = RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+	.feature_process_fn = gso_node_process,
+	.feature_node = &gso_node,
+};
+
+RTE_GRAPH_FEATURE_REGISTER(gso_feature);
@@ -43,9 +43,17 @@ ip4_local_node_process_scalar(struct rte_graph *graph, struct rte_node *node,
 		mbuf = (struct rte_mbuf *)objs[i];
 		l4 = mbuf->packet_type & RTE_PTYPE_L4_MASK;
 
-		next = (l4 == RTE_PTYPE_L4_UDP)
-				? next_index
-				: RTE_NODE_IP4_LOCAL_NEXT_PKT_DROP;
+		if (likely(l4 == RTE_PTYPE_L4_UDP)) {
+			next = next_index;
+		} else {
+			struct rte_ipv4_hdr *ip;
+
+			ip = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+						     sizeof(struct rte_ether_hdr));
+			next = (ip->next_proto_id == IPPROTO_GRE)
+					? RTE_NODE_IP4_LOCAL_NEXT_GRE_DECAP
+					: RTE_NODE_IP4_LOCAL_NEXT_PKT_DROP;
+		}
 
 		if (unlikely(next_index != next)) {
 			/* Copy things successfully speculated till now */
@@ -77,10 +85,11 @@ static struct rte_node_register ip4_local_node = {
 	.process = ip4_local_node_process_scalar,
 	.name = "ip4_local",
 
-	.nb_edges = RTE_NODE_IP4_LOCAL_NEXT_PKT_DROP + 1,
+	.nb_edges = RTE_NODE_IP4_LOCAL_NEXT_GRE_DECAP + 1,
 	.next_nodes = {
 		[RTE_NODE_IP4_LOCAL_NEXT_UDP4_INPUT] = "udp4_input",
 		[RTE_NODE_IP4_LOCAL_NEXT_PKT_DROP] = "pkt_drop",
+		[RTE_NODE_IP4_LOCAL_NEXT_GRE_DECAP] = "gre_decap",
 	},
 };
 
@@ -15,6 +15,7 @@
 
 #include "rte_node_ip4_api.h"
 
+#include "flow_cache_priv.h"
 #include "node_private.h"
 
 #define IPV4_L3FWD_LPM_MAX_RULES 1024
@@ -150,6 +151,9 @@ rte_node_ip4_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
 		}
 	}
 
+	/* Cached flows may now take another route */
+	flow_cache_invalidate();
+
 	return 0;
 }
 
@@ -14,6 +14,7 @@
 
 #include "rte_node_ip4_api.h"
 
+#include "flow_cache_priv.h"
 #include "node_private.h"
 
 /* IP4 Lookup global data struct */
@@ -245,6 +246,9 @@ rte_node_ip4_fib_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
 		}
 	}
 
+	/* Cached flows may now take another route */
+	flow_cache_invalidate();
+
 	return 0;
 }
 
@@ -0,0 +1,244 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <rte_arp.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_mbuf.h>
+
+#include "neigh_priv.h"
+#include "node_private.h"
+
+static uint16_t
+ip4_neigh_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	struct neigh_hold_q *q = NEIGH_HOLD_Q(node->ctx);
+	const int dyn = NEIGH_PRIV1_OFF(node->ctx);
+	struct neigh_node_main *nm = neigh_nm;
+	uint16_t held = 0, dropped, solicited = 0;
+	struct rte_mbuf *mbuf, *req;
+	uint64_t now = rte_rdtsc();
+	struct neigh_entry *e;
+	uint16_t i, nh;
+	uint8_t state;
+
+	neigh_hold_release(graph, node, q, nm->ip4, NEIGH_NEXT_IP4_REWRITE);
+	dropped = neigh_hold_expire(graph, node, q, now);
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		nh = node_mbuf_priv1(mbuf, dyn)->nh;
+		e = &nm->ip4[nh];
+		state = neigh_state_get(e);
+
+		/* Resolved while the packet was in flight */
+		if (unlikely(neigh_state_usable(state))) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_IP4_REWRITE, mbuf);
+			continue;
+		}
+
+		if (unlikely(state == NEIGH_STATE_NONE || neigh_hold(q, mbuf, nh, now))) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			dropped++;
+			continue;
+		}
+		held++;
+
+		/* One graph solicits per retransmit interval */
+		if (!neigh_solicit_claim(e, now))
+			continue;
+
+		req = neigh_arp_request(e, nm->pool ? nm->pool : mbuf->pool, false);
+		if (unlikely(req == NULL))
+			continue;
+
+		rte_node_enqueue_x1(graph, node, nm->tx_next[e->port], req);
+		solicited++;
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, held, held);
+	NODE_INCREMENT_XSTAT_ID(node, 1, dropped, dropped);
+	NODE_INCREMENT_XSTAT_ID(node, 2, solicited, solicited);
+
+	return nb_objs;
+}
+
+static int
+ip4_neigh_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	int dyn;
+
+	RTE_BUILD_BUG_ON(sizeof(struct neigh_node_ctx) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("ip4_neigh", "Failed to register mbuf dynfield");
+		return -rte_errno;
+	}
+
+	NEIGH_HOLD_Q(node->ctx) = neigh_hold_q_create(graph);
+	if (NEIGH_HOLD_Q(node->ctx) == NULL) {
+		node_err("ip4_neigh", "Failed to allocate hold queue on graph %s", graph->name);
+		return -ENOMEM;
+	}
+	NEIGH_PRIV1_OFF(node->ctx) = dyn;
+
+	node_dbg("ip4_neigh", "Initialized ip4_neigh node on graph %s", graph->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats ip4_neigh_xstats = {
+	.nb_xstats = 3,
+	.xstat_desc = {
+		[0] = "neigh_held",
+		[1] = "neigh_hold_drop",
+		[2] = "neigh_solicit",
+	},
+};
+
+static struct rte_node_register ip4_neigh_node = {
+	.process = ip4_neigh_node_process,
+	.name = "ip4_neigh",
+
+	.init = ip4_neigh_node_init,
+	.fini = neigh_node_fini,
+	.xstats = &ip4_neigh_xstats,
+
+	.nb_edges = NEIGH_NEXT_MAX,
+	.next_nodes = {
+		[NEIGH_NEXT_PKT_DROP] = "pkt_drop",
+		[NEIGH_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[NEIGH_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+struct rte_node_register *
+ip4_neigh_node_get(void)
+{
+	return &ip4_neigh_node;
+}
+
+RTE_NODE_REGISTER(ip4_neigh_node);
+
+static __rte_always_inline bool
+arp_input_valid(struct rte_mbuf *mbuf, const struct rte_arp_hdr *arp)
+{
+	return rte_pktmbuf_data_len(mbuf) >= sizeof(struct rte_ether_hdr) + sizeof(*arp) &&
+	       arp->arp_hardware == RTE_BE16(RTE_ARP_HRD_ETHER) &&
+	       arp->arp_protocol == RTE_BE16(RTE_ETHER_TYPE_IPV4) &&
+	       arp->arp_hlen == RTE_ETHER_ADDR_LEN &&
+	       arp->arp_plen == sizeof(rte_be32_t);
+}
+
+static uint16_t
+arp_input_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	struct rte_node *neigh = NEIGH_INPUT_NEIGH_NODE(node->ctx);
+	struct neigh_node_main *nm = neigh_nm;
+	uint16_t i, port, learnt = 0, replied = 0;
+	uint64_t now = rte_rdtsc();
+	const struct neigh_port *p;
+	struct rte_ether_hdr *eth;
+	struct rte_arp_hdr *arp;
+	struct rte_mbuf *mbuf;
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod((struct rte_mbuf *)objs[i + 1], void *));
+
+		eth = rte_pktmbuf_mtod(mbuf, struct rte_ether_hdr *);
+		arp = (struct rte_arp_hdr *)(eth + 1);
+		port = mbuf->port;
+		p = &nm->port[port];
+
+		if (unlikely(!arp_input_valid(mbuf, arp))) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		/* Both requests and replies refresh the next hop of the sender */
+		learnt += neigh_ip4_answer(arp->arp_data.arp_sip, port, &arp->arp_data.arp_sha,
+					   now);
+
+		if (arp->arp_opcode != RTE_BE16(RTE_ARP_OP_REQUEST) || p->ip4 == 0 ||
+		    arp->arp_data.arp_tip != p->ip4) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		/* Answer in place */
+		arp->arp_opcode = RTE_BE16(RTE_ARP_OP_REPLY);
+		rte_ether_addr_copy(&arp->arp_data.arp_sha, &arp->arp_data.arp_tha);
+		arp->arp_data.arp_tip = arp->arp_data.arp_sip;
+		rte_ether_addr_copy(&p->mac, &arp->arp_data.arp_sha);
+		arp->arp_data.arp_sip = p->ip4;
+		rte_ether_addr_copy(&eth->src_addr, &eth->dst_addr);
+		rte_ether_addr_copy(&p->mac, &eth->src_addr);
+
+		rte_node_enqueue_x1(graph, node, nm->tx_next[port], mbuf);
+		replied++;
+	}
+
+	if (learnt && neigh != NULL)
+		neigh_hold_release(graph, node, NEIGH_HOLD_Q(neigh->ctx), nm->ip4,
+				   NEIGH_NEXT_IP4_REWRITE);
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, learnt, learnt);
+	NODE_INCREMENT_XSTAT_ID(node, 1, replied, replied);
+
+	return nb_objs;
+}
+
+static int
+arp_input_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_BUILD_BUG_ON(sizeof(struct neigh_input_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (neigh_nm_get() == NULL)
+		return -ENOMEM;
+
+	NEIGH_INPUT_NEIGH_NODE(node->ctx) = neigh_graph_node_get(graph, "ip4_neigh");
+
+	node_dbg("arp_input", "Initialized arp_input node on graph %s", graph->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats arp_input_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[0] = "neigh_learn",
+		[1] = "arp_reply",
+	},
+};
+
+static struct rte_node_register arp_input_node = {
+	.process = arp_input_node_process,
+	.name = "arp_input",
+
+	.init = arp_input_node_init,
+	.xstats = &arp_input_xstats,
+
+	.nb_edges = NEIGH_NEXT_MAX,
+	.next_nodes = {
+		[NEIGH_NEXT_PKT_DROP] = "pkt_drop",
+		[NEIGH_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[NEIGH_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+struct rte_node_register *
+arp_input_node_get(void)
+{
+	return &arp_input_node;
+}
+
+RTE_NODE_REGISTER(arp_input_node);
@@ -13,6 +13,7 @@
 
 #include "rte_node_ip4_api.h"
 
+#include "flow_cache_priv.h"
 #include "ip4_rewrite_priv.h"
 #include "node_private.h"
 #include "interface_tx_feature_priv.h"
@@ -52,6 +53,15 @@ static int port_to_next_index_diff = -1;
 #define IP4_REWRITE_NODE_LAST_TX_IF(ctx) \
 	(((struct ip4_rewrite_node_ctx *)ctx)->last_tx_if)
 
+/* Cache the next hop of packets missed by flow_cache node */
+static __rte_always_inline void
+ip4_rewrite_flow_cache_learn(struct rte_graph *graph, struct rte_mbuf *mbuf,
+			     const struct ip4_rewrite_nh_header *nh, uint16_t next)
+{
+	if (unlikely(mbuf->ol_flags & flow_cache_learn_flag) && next >= IP4_REWRITE_NEXT_MAX)
+		flow_cache_ip4_learn(graph, mbuf, nh, next - port_to_next_index_diff);
+}
+
 static __rte_always_inline void
 check_output_feature_arc_x1(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 			    struct rte_mbuf *mbuf0, uint16_t *next0,
@@ -61,8 +71,8 @@ check_output_feature_arc_x1(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 	struct rte_graph_feature_arc_mbuf_dynfields *d0 = NULL;
 	uint16_t port0;
 
-	/* make sure packets are not being sent to pkt_drop node */
-	if (likely(*next0 >= port_to_next_index_diff)) {
+	/* make sure packets are not being sent to pkt_drop or ip4_neigh node */
+	if (likely(*next0 >= IP4_REWRITE_NEXT_MAX)) {
 
 		port0 = (*next0) - port_to_next_index_diff;
 
@@ -117,13 +127,13 @@ check_output_feature_arc_x4(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 
 	if (xor) {
 		/* packets tx ports are not same, check first feature for each mbuf
-		 * make sure next0 != 0 which is pkt_drop
+		 * make sure nextX is a port edge, not pkt_drop or ip4_neigh
 		 */
 		port0 = (*next0) - port_to_next_index_diff;
 		port1 = (*next1) - port_to_next_index_diff;
 		port2 = (*next2) - port_to_next_index_diff;
 		port3 = (*next3) - port_to_next_index_diff;
-		if (unlikely((*next0 >= port_to_next_index_diff) &&
+		if (unlikely((*next0 >= IP4_REWRITE_NEXT_MAX) &&
 			     rte_graph_feature_data_first_feature_get(arc, port0,
 								      &d0->feature_data,
 								      next0))) {
@@ -131,21 +141,21 @@ check_output_feature_arc_x4(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 			mbuf0->port = port0;
 		}
 
-		if (unlikely((*next1 >= port_to_next_index_diff) &&
+		if (unlikely((*next1 >= IP4_REWRITE_NEXT_MAX) &&
 			     rte_graph_feature_data_first_feature_get(arc, port1,
 								      &d1->feature_data,
 								      next1))) {
 			mbuf1->port = port1;
 		}
 
-		if (unlikely((*next2 >= port_to_next_index_diff) &&
+		if (unlikely((*next2 >= IP4_REWRITE_NEXT_MAX) &&
 			     rte_graph_feature_data_first_feature_get(arc, port2,
 								      &d2->feature_data,
 								      next2))) {
 			mbuf2->port = port2;
 		}
 
-		if (unlikely((*next3 >= port_to_next_index_diff) &&
+		if (unlikely((*next3 >= IP4_REWRITE_NEXT_MAX) &&
 			     rte_graph_feature_data_first_feature_get(arc, port3,
 								      &d3->feature_data,
 								      next3))) {
@@ -309,6 +319,16 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		ip3->time_to_live = priv23.u16[5] - 1;
 		ip3->hdr_checksum = priv23.u16[6] + priv23.u16[7];
 
+		/* Features may change the Tx port, only cache plain forwarding */
+		if (!check_enabled_features &&
+		    unlikely((mbuf0->ol_flags | mbuf1->ol_flags | mbuf2->ol_flags |
+			      mbuf3->ol_flags) & flow_cache_learn_flag)) {
+			ip4_rewrite_flow_cache_learn(graph, mbuf0, &nh[priv01.u16[0]], next0);
+			ip4_rewrite_flow_cache_learn(graph, mbuf1, &nh[priv01.u16[4]], next1);
+			ip4_rewrite_flow_cache_learn(graph, mbuf2, &nh[priv23.u16[0]], next2);
+			ip4_rewrite_flow_cache_learn(graph, mbuf3, &nh[priv23.u16[4]], next3);
+		}
+
 		/* Once all mbufs are updated with next hop data.
 		 * check if any feature is enabled to override
 		 * next edges
@@ -412,6 +432,10 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		ip0->hdr_checksum = chksum;
 		ip0->time_to_live = node_mbuf_priv1(mbuf0, dyn)->ttl - 1;
 
+		if (!check_enabled_features)
+			ip4_rewrite_flow_cache_learn(graph, mbuf0,
+						     &nh[node_mbuf_priv1(mbuf0, dyn)->nh], next0);
+
 		if (check_enabled_features)
 			check_output_feature_arc_x1(out_feature_arc, &last_tx_if,
 						    mbuf0, &next0, &last_next_index,
@@ -577,10 +601,60 @@ rte_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 	nh = &ip4_rewrite_nm->nh[next_hop];
 
 	memcpy(nh->rewrite_data, rewrite_data, rewrite_len);
-	nh->tx_node = ip4_rewrite_nm->next_index[dst_port];
 	nh->rewrite_len = rewrite_len;
+	/* Graph walk may be in progress, publish rewrite data before the edge */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	nh->tx_node = ip4_rewrite_nm->next_index[dst_port];
 	nh->enabled = true;
 
+	flow_cache_invalidate();
+
+	return 0;
+}
+
+int
+ip4_rewrite_nh_unresolve(uint16_t next_hop, enum ip4_rewrite_next next)
+{
+	struct ip4_rewrite_nh_header *nh;
+
+	if (next_hop >= RTE_GRAPH_IP4_REWRITE_MAX_NH || next >= IP4_REWRITE_NEXT_MAX)
+		return -EINVAL;
+
+	if (ip4_rewrite_nm == NULL)
+		return -EINVAL;
+
+	nh = &ip4_rewrite_nm->nh[next_hop];
+
+	nh->enabled = false;
+	nh->tx_node = next;
+	rte_atomic_thread_fence(rte_memory_order_release);
+	nh->rewrite_len = 0;
+
+	flow_cache_invalidate();
+
+	return 0;
+}
+
+int
+ip4_rewrite_nh_dst_update(uint16_t next_hop, const struct rte_ether_addr *dst)
+{
+	struct ip4_rewrite_nh_header *nh;
+	uint64_t head;
+
+	if (next_hop >= RTE_GRAPH_IP4_REWRITE_MAX_NH || ip4_rewrite_nm == NULL)
+		return -EINVAL;
+
+	nh = &ip4_rewrite_nm->nh[next_hop];
+	if (!nh->enabled || nh->rewrite_len < sizeof(head))
+		return -EINVAL;
+
+	/* Single store so that no graph walk copies a half updated address */
+	head = rte_atomic_load_explicit(&nh->dst_head, rte_memory_order_relaxed);
+	memcpy(&head, dst, sizeof(*dst));
+	rte_atomic_store_explicit(&nh->dst_head, head, rte_memory_order_relaxed);
+
+	flow_cache_invalidate();
+
 	return 0;
 }
 
@@ -588,9 +662,10 @@ static struct rte_node_register ip4_rewrite_node = {
 	.process = ip4_rewrite_node_process,
 	.name = "ip4_rewrite",
 	/* Default edge i.e '0' is pkt drop */
-	.nb_edges = 1,
+	.nb_edges = IP4_REWRITE_NEXT_MAX,
 	.next_nodes = {
-		[0] = "pkt_drop",
+		[IP4_REWRITE_NEXT_PKT_DROP] = "pkt_drop",
+		[IP4_REWRITE_NEXT_NEIGH] = "ip4_neigh",
 	},
 	.init = ip4_rewrite_node_init,
 };
@@ -0,0 +1,288 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip6.h>
+#include <rte_mbuf.h>
+
+#include "neigh_priv.h"
+#include "node_private.h"
+
+/* Neighbor discovery message without link-layer address option */
+#define ND_MSG_MIN_LEN offsetof(struct neigh_nd_msg, opt_type)
+
+#define ND_PKT_LEN \
+	(sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr) + sizeof(struct neigh_nd_msg))
+
+static uint16_t
+ip6_neigh_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	struct neigh_hold_q *q = NEIGH_HOLD_Q(node->ctx);
+	const int dyn = NEIGH_PRIV1_OFF(node->ctx);
+	struct neigh_node_main *nm = neigh_nm;
+	uint16_t held = 0, dropped, solicited = 0;
+	struct rte_mbuf *mbuf, *req;
+	uint64_t now = rte_rdtsc();
+	struct neigh_entry *e;
+	uint16_t i, nh;
+	uint8_t state;
+
+	neigh_hold_release(graph, node, q, nm->ip6, NEIGH_NEXT_IP6_REWRITE);
+	dropped = neigh_hold_expire(graph, node, q, now);
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		nh = node_mbuf_priv1(mbuf, dyn)->nh;
+		e = &nm->ip6[nh];
+		state = neigh_state_get(e);
+
+		/* Resolved while the packet was in flight */
+		if (unlikely(neigh_state_usable(state))) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_IP6_REWRITE, mbuf);
+			continue;
+		}
+
+		if (unlikely(state == NEIGH_STATE_NONE || neigh_hold(q, mbuf, nh, now))) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			dropped++;
+			continue;
+		}
+		held++;
+
+		/* One graph solicits per retransmit interval */
+		if (!neigh_solicit_claim(e, now))
+			continue;
+
+		req = neigh_nd_solicit(e, nm->pool ? nm->pool : mbuf->pool, false);
+		if (unlikely(req == NULL))
+			continue;
+
+		rte_node_enqueue_x1(graph, node, nm->tx_next[e->port], req);
+		solicited++;
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, held, held);
+	NODE_INCREMENT_XSTAT_ID(node, 1, dropped, dropped);
+	NODE_INCREMENT_XSTAT_ID(node, 2, solicited, solicited);
+
+	return nb_objs;
+}
+
+static int
+ip6_neigh_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	int dyn;
+
+	RTE_BUILD_BUG_ON(sizeof(struct neigh_node_ctx) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("ip6_neigh", "Failed to register mbuf dynfield");
+		return -rte_errno;
+	}
+
+	NEIGH_HOLD_Q(node->ctx) = neigh_hold_q_create(graph);
+	if (NEIGH_HOLD_Q(node->ctx) == NULL) {
+		node_err("ip6_neigh", "Failed to allocate hold queue on graph %s", graph->name);
+		return -ENOMEM;
+	}
+	NEIGH_PRIV1_OFF(node->ctx) = dyn;
+
+	node_dbg("ip6_neigh", "Initialized ip6_neigh node on graph %s", graph->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats ip6_neigh_xstats = {
+	.nb_xstats = 3,
+	.xstat_desc = {
+		[0] = "neigh_held",
+		[1] = "neigh_hold_drop",
+		[2] = "neigh_solicit",
+	},
+};
+
+static struct rte_node_register ip6_neigh_node = {
+	.process = ip6_neigh_node_process,
+	.name = "ip6_neigh",
+
+	.init = ip6_neigh_node_init,
+	.fini = neigh_node_fini,
+	.xstats = &ip6_neigh_xstats,
+
+	.nb_edges = NEIGH_NEXT_MAX,
+	.next_nodes = {
+		[NEIGH_NEXT_PKT_DROP] = "pkt_drop",
+		[NEIGH_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[NEIGH_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+struct rte_node_register *
+ip6_neigh_node_get(void)
+{
+	return &ip6_neigh_node;
+}
+
+RTE_NODE_REGISTER(ip6_neigh_node);
+
+/* Turn a solicitation for a port address into an advertisement, false if not for us */
+static __rte_always_inline bool
+nd_input_advertise(struct rte_mbuf *mbuf, struct rte_ether_hdr *eth,
+		   struct rte_ipv6_hdr *ip, struct neigh_nd_msg *nd,
+		   const struct neigh_port *p)
+{
+	uint16_t len = rte_pktmbuf_pkt_len(mbuf);
+
+	/* Duplicate address detection is not answered */
+	if (rte_ipv6_addr_is_unspec(&ip->src_addr))
+		return false;
+
+	if (len > ND_PKT_LEN)
+		rte_pktmbuf_trim(mbuf, len - ND_PKT_LEN);
+	else if (len < ND_PKT_LEN && rte_pktmbuf_append(mbuf, ND_PKT_LEN - len) == NULL)
+		return false;
+
+	rte_ether_addr_copy(&eth->src_addr, &eth->dst_addr);
+	rte_ether_addr_copy(&p->mac, &eth->src_addr);
+
+	ip->dst_addr = ip->src_addr;
+	ip->src_addr = p->ip6;
+	ip->payload_len = rte_cpu_to_be_16(sizeof(*nd));
+
+	nd->icmp.type = NEIGH_ND_NA;
+	nd->icmp.checksum = 0;
+	nd->flags = NEIGH_ND_NA_FLAG_SOLICITED | NEIGH_ND_NA_FLAG_OVERRIDE;
+	nd->opt_type = NEIGH_ND_OPT_TGT_LLADDR;
+	nd->opt_len = 1;
+	rte_ether_addr_copy(&p->mac, &nd->lladdr);
+	nd->icmp.checksum = rte_ipv6_udptcp_cksum(ip, nd);
+
+	return true;
+}
+
+static uint16_t
+nd_input_node_process(struct rte_graph *graph, struct rte_node *node,
+		      void **objs, uint16_t nb_objs)
+{
+	struct rte_node *neigh = NEIGH_INPUT_NEIGH_NODE(node->ctx);
+	struct neigh_node_main *nm = neigh_nm;
+	uint16_t i, port, nd_len, learnt = 0, replied = 0;
+	uint64_t now = rte_rdtsc();
+	const struct neigh_port *p;
+	struct rte_ether_hdr *eth;
+	struct rte_ipv6_hdr *ip;
+	struct neigh_nd_msg *nd;
+	struct rte_mbuf *mbuf;
+	bool lladdr;
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod((struct rte_mbuf *)objs[i + 1], void *));
+
+		eth = rte_pktmbuf_mtod(mbuf, struct rte_ether_hdr *);
+		ip = (struct rte_ipv6_hdr *)(eth + 1);
+		nd = (struct neigh_nd_msg *)(ip + 1);
+		port = mbuf->port;
+		p = &nm->port[port];
+		nd_len = rte_be_to_cpu_16(ip->payload_len);
+
+		/* Only link local messages without extension headers are accepted */
+		if (unlikely(rte_pktmbuf_data_len(mbuf) <
+			     sizeof(*eth) + sizeof(*ip) + ND_MSG_MIN_LEN ||
+			     ip->proto != IPPROTO_ICMPV6 || ip->hop_limits != 255 ||
+			     nd_len < ND_MSG_MIN_LEN || nd->icmp.code != 0)) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		lladdr = nd_len >= sizeof(*nd) && nd->opt_len == 1 &&
+			 rte_pktmbuf_data_len(mbuf) >= ND_PKT_LEN;
+
+		if (nd->icmp.type == NEIGH_ND_NA) {
+			if (lladdr && nd->opt_type == NEIGH_ND_OPT_TGT_LLADDR)
+				learnt += neigh_ip6_answer(&nd->target, port, &nd->lladdr, now);
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		if (nd->icmp.type != NEIGH_ND_NS || rte_ipv6_addr_is_unspec(&p->ip6) ||
+		    !rte_ipv6_addr_eq(&nd->target, &p->ip6)) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		if (lladdr && nd->opt_type == NEIGH_ND_OPT_SRC_LLADDR)
+			learnt += neigh_ip6_answer(&ip->src_addr, port, &nd->lladdr, now);
+
+		if (!nd_input_advertise(mbuf, eth, ip, nd, p)) {
+			rte_node_enqueue_x1(graph, node, NEIGH_NEXT_PKT_DROP, mbuf);
+			continue;
+		}
+
+		rte_node_enqueue_x1(graph, node, nm->tx_next[port], mbuf);
+		replied++;
+	}
+
+	if (learnt && neigh != NULL)
+		neigh_hold_release(graph, node, NEIGH_HOLD_Q(neigh->ctx), nm->ip6,
+				   NEIGH_NEXT_IP6_REWRITE);
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, learnt, learnt);
+	NODE_INCREMENT_XSTAT_ID(node, 1, replied, replied);
+
+	return nb_objs;
+}
+
+static int
+nd_input_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_BUILD_BUG_ON(sizeof(struct neigh_input_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (neigh_nm_get() == NULL)
+		return -ENOMEM;
+
+	NEIGH_INPUT_NEIGH_NODE(node->ctx) = neigh_graph_node_get(graph, "ip6_neigh");
+
+	node_dbg("nd_input", "Initialized nd_input node on graph %s", graph->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats nd_input_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[0] = "neigh_learn",
+		[1] = "nd_advert",
+	},
+};
+
+static struct rte_node_register nd_input_node = {
+	.process = nd_input_node_process,
+	.name = "nd_input",
+
+	.init = nd_input_node_init,
+	.xstats = &nd_input_xstats,
+
+	.nb_edges = NEIGH_NEXT_MAX,
+	.next_nodes = {
+		[NEIGH_NEXT_PKT_DROP] = "pkt_drop",
+		[NEIGH_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[NEIGH_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+struct rte_node_register *
+nd_input_node_get(void)
+{
+	return &nd_input_node;
+}
+
+RTE_NODE_REGISTER(nd_input_node);
@@ -302,20 +302,65 @@ rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 	nh = &ip6_rewrite_nm->nh[next_hop];
 
 	memcpy(nh->rewrite_data, rewrite_data, rewrite_len);
-	nh->tx_node = ip6_rewrite_nm->next_index[dst_port];
 	nh->rewrite_len = rewrite_len;
+	/* Graph walk may be in progress, publish rewrite data before the edge */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	nh->tx_node = ip6_rewrite_nm->next_index[dst_port];
 	nh->enabled = true;
 
 	return 0;
 }
 
+int
+ip6_rewrite_nh_unresolve(uint16_t next_hop, enum ip6_rewrite_next next)
+{
+	struct ip6_rewrite_nh_header *nh;
+
+	if (next_hop >= RTE_GRAPH_IP6_REWRITE_MAX_NH || next >= IP6_REWRITE_NEXT_MAX)
+		return -EINVAL;
+
+	if (ip6_rewrite_nm == NULL)
+		return -EINVAL;
+
+	nh = &ip6_rewrite_nm->nh[next_hop];
+
+	nh->enabled = false;
+	nh->tx_node = next;
+	rte_atomic_thread_fence(rte_memory_order_release);
+	nh->rewrite_len = 0;
+
+	return 0;
+}
+
+int
+ip6_rewrite_nh_dst_update(uint16_t next_hop, const struct rte_ether_addr *dst)
+{
+	struct ip6_rewrite_nh_header *nh;
+	uint64_t head;
+
+	if (next_hop >= RTE_GRAPH_IP6_REWRITE_MAX_NH || ip6_rewrite_nm == NULL)
+		return -EINVAL;
+
+	nh = &ip6_rewrite_nm->nh[next_hop];
+	if (!nh->enabled || nh->rewrite_len < sizeof(head))
+		return -EINVAL;
+
+	/* Single store so that no graph walk copies a half updated address */
+	head = rte_atomic_load_explicit(&nh->dst_head, rte_memory_order_relaxed);
+	memcpy(&head, dst, sizeof(*dst));
+	rte_atomic_store_explicit(&nh->dst_head, head, rte_memory_order_relaxed);
+
+	return 0;
+}
+
 static struct rte_node_register ip6_rewrite_node = {
 	.process = ip6_rewrite_node_process,
 	.name = "ip6_rewrite",
 	/* Default edge i.e '0' is pkt drop */
-	.nb_edges = 1,
+	.nb_edges = IP6_REWRITE_NEXT_MAX,
 	.next_nodes = {
-		[0] = "pkt_drop",
+		[IP6_REWRITE_NEXT_PKT_DROP] = "pkt_drop",
+		[IP6_REWRITE_NEXT_NEIGH] = "ip6_neigh",
 	},
 	.init = ip6_rewrite_node_init,
 };
@@ -9,6 +9,17 @@
 #define RTE_GRAPH_IP6_REWRITE_MAX_NH 64
 #define RTE_GRAPH_IP6_REWRITE_MAX_LEN 56
 
+/**
+ * @internal
+ *
+ * Static edges of IPv6 rewrite node, Tx edges of ports follow.
+ */
+enum ip6_rewrite_next {
+	IP6_REWRITE_NEXT_PKT_DROP,
+	IP6_REWRITE_NEXT_NEIGH,
+	IP6_REWRITE_NEXT_MAX,
+};
+
 /**
  * @internal
  *
@@ -29,6 +40,8 @@ struct ip6_rewrite_nh_header {
 		};
 		uint8_t rewrite_data[RTE_GRAPH_IP6_REWRITE_MAX_LEN];
 		/**< Generic rewrite data */
+		RTE_ATOMIC(uint64_t) dst_head;
+		/**< Destination mac address with the first bytes of the source one. */
 	};
 };
 
@@ -66,4 +79,30 @@ struct rte_node_register *ip6_rewrite_node_get(void);
  */
 int ip6_rewrite_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * @internal
+ *
+ * Send packets of a next hop to a static edge instead of a port, without
+ * rewriting their header.
+ *
+ * @param next_hop
+ *   Next hop id.
+ * @param next
+ *   Static edge, IP6_REWRITE_NEXT_PKT_DROP or IP6_REWRITE_NEXT_NEIGH.
+ */
+int ip6_rewrite_nh_unresolve(uint16_t next_hop, enum ip6_rewrite_next next);
+
+/**
+ * @internal
+ *
+ * Change the destination mac address of a next hop in use, graph walks
+ * read either the previous or the new address.
+ *
+ * @param next_hop
+ *   Next hop id.
+ * @param dst
+ *   New destination mac address.
+ */
+int ip6_rewrite_nh_dst_update(uint16_t next_hop, const struct rte_ether_addr *dst);
+
 #endif /* __INCLUDE_IP6_REWRITE_PRIV_H__ */
@@ -0,0 +1,847 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <arpa/inet.h>
+
+#include <eal_export.h>
+#include <rte_arp.h>
+#include <rte_cycles.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_hash.h>
+#include <rte_ip6.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip4_api.h"
+#include "rte_node_ip6_api.h"
+#include "rte_node_neigh_api.h"
+
+#include "neigh_priv.h"
+#include "node_private.h"
+
+#define NEIGH_DEFAULT_HOLD_MAX 256
+#define NEIGH_DEFAULT_HOLD_TIMEOUT_MS 3000
+#define NEIGH_DEFAULT_RETRANS_MS 1000
+#define NEIGH_DEFAULT_REACHABLE_MS 30000
+#define NEIGH_DEFAULT_MAX_PROBES 3
+
+struct neigh_timer_node_ctx {
+	/* ip4_neigh and ip6_neigh nodes of the graph */
+	struct rte_node *ip4_neigh;
+	struct rte_node *ip6_neigh;
+};
+
+#define NEIGH_TIMER_IP4_NODE(ctx) \
+	(((struct neigh_timer_node_ctx *)ctx)->ip4_neigh)
+
+#define NEIGH_TIMER_IP6_NODE(ctx) \
+	(((struct neigh_timer_node_ctx *)ctx)->ip6_neigh)
+
+struct neigh_node_main *neigh_nm;
+
+static struct rte_node_register neigh_timer_node;
+
+static struct rte_hash *
+neigh_hash_create(const char *name, uint32_t entries, uint32_t key_len)
+{
+	struct rte_hash_parameters params = {
+		.name = name,
+		.entries = entries,
+		.key_len = key_len,
+		.socket_id = SOCKET_ID_ANY,
+		/* Looked up by graphs while the control path adds next hops */
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+
+	return rte_hash_create(&params);
+}
+
+struct neigh_node_main *
+neigh_nm_get(void)
+{
+	uint64_t ms = rte_get_timer_hz() / MS_PER_S;
+	struct neigh_node_main *nm;
+
+	if (neigh_nm != NULL)
+		return neigh_nm;
+
+	nm = rte_zmalloc("neigh_nm", sizeof(struct neigh_node_main), RTE_CACHE_LINE_SIZE);
+	if (nm == NULL)
+		return NULL;
+
+	nm->ip4_hash = neigh_hash_create("neigh_ip4", RTE_GRAPH_IP4_REWRITE_MAX_NH,
+					 sizeof(struct neigh_ip4_key));
+	nm->ip6_hash = neigh_hash_create("neigh_ip6", RTE_GRAPH_IP6_REWRITE_MAX_NH,
+					 sizeof(struct neigh_ip6_key));
+	if (nm->ip4_hash == NULL || nm->ip6_hash == NULL) {
+		rte_hash_free(nm->ip4_hash);
+		rte_hash_free(nm->ip6_hash);
+		rte_free(nm);
+		return NULL;
+	}
+
+	neigh_nm = nm;
+	rte_spinlock_init(&neigh_nm->lock);
+	neigh_nm->hold_max = NEIGH_DEFAULT_HOLD_MAX;
+	neigh_nm->max_probes = NEIGH_DEFAULT_MAX_PROBES;
+	neigh_nm->hold_timeout = NEIGH_DEFAULT_HOLD_TIMEOUT_MS * ms;
+	neigh_nm->retrans = NEIGH_DEFAULT_RETRANS_MS * ms;
+	neigh_nm->reachable = NEIGH_DEFAULT_REACHABLE_MS * ms;
+
+	return neigh_nm;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_neigh_configure, 26.03)
+int
+rte_node_neigh_configure(const struct rte_node_neigh_cfg *cfg)
+{
+	uint64_t ms = rte_get_timer_hz() / MS_PER_S;
+	struct neigh_node_main *nm;
+
+	if (cfg == NULL || cfg->hold_max == 0 || cfg->retrans_ms == 0 || cfg->reachable_ms == 0)
+		return -EINVAL;
+
+	nm = neigh_nm_get();
+	if (nm == NULL)
+		return -ENOMEM;
+
+	rte_spinlock_lock(&nm->lock);
+	nm->pool = cfg->pool;
+	nm->hold_max = cfg->hold_max;
+	nm->max_probes = cfg->max_probes;
+	nm->hold_timeout = cfg->hold_timeout_ms * ms;
+	nm->retrans = cfg->retrans_ms * ms;
+	nm->reachable = cfg->reachable_ms * ms;
+	rte_spinlock_unlock(&nm->lock);
+
+	return 0;
+}
+
+static int
+neigh_port_mac_set(struct neigh_node_main *nm, uint16_t port_id)
+{
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return -EINVAL;
+
+	return rte_eth_macaddr_get(port_id, &nm->port[port_id].mac);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_neigh_port_addr_set, 26.03)
+int
+rte_node_ip4_neigh_port_addr_set(uint16_t port_id, uint32_t ip)
+{
+	struct neigh_node_main *nm;
+	int rc;
+
+	nm = neigh_nm_get();
+	if (nm == NULL)
+		return -ENOMEM;
+
+	rc = neigh_port_mac_set(nm, port_id);
+	if (rc)
+		return rc;
+
+	nm->port[port_id].ip4 = htonl(ip);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_neigh_port_addr_set, 26.03)
+int
+rte_node_ip6_neigh_port_addr_set(uint16_t port_id, const struct rte_ipv6_addr *ip)
+{
+	struct neigh_node_main *nm;
+	int rc;
+
+	if (ip == NULL)
+		return -EINVAL;
+
+	nm = neigh_nm_get();
+	if (nm == NULL)
+		return -ENOMEM;
+
+	rc = neigh_port_mac_set(nm, port_id);
+	if (rc)
+		return rc;
+
+	nm->port[port_id].ip6 = *ip;
+
+	return 0;
+}
+
+/* Reset an entry for a new neighbor, out of use until its state is set */
+static void
+neigh_entry_reset(struct neigh_entry *e, uint16_t port_id)
+{
+	neigh_state_set(e, NEIGH_STATE_NONE);
+	memset(&e->mac, 0, sizeof(e->mac));
+	e->port = port_id;
+	e->probes = 0;
+	e->confirmed = 0;
+	rte_atomic_store_explicit(&e->solicited, 0, rte_memory_order_relaxed);
+}
+
+/*
+ * Keys of deleted next hops are freed right away: graphs check the entry
+ * they found under the lock, so a reused slot is harmless.
+ */
+static void
+neigh_key_del(struct rte_hash *h, const void *key)
+{
+	int32_t pos;
+
+	pos = rte_hash_del_key(h, key);
+	if (pos >= 0)
+		rte_hash_free_key_with_position(h, pos);
+}
+
+/* Index a next hop by port and address, in place of its previous key */
+static int
+neigh_key_add(struct rte_hash *h, const void *key, const void *old_key, uint16_t nh)
+{
+	void *data;
+	int rc;
+
+	if (rte_hash_lookup_data(h, key, &data) >= 0)
+		return (uintptr_t)data == nh ? 0 : -EEXIST;
+
+	rc = rte_hash_add_key_data(h, key, (void *)(uintptr_t)nh);
+	if (rc == 0 && old_key != NULL)
+		neigh_key_del(h, old_key);
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_neigh_add, 26.03)
+int
+rte_node_ip4_neigh_add(uint16_t next_hop, uint32_t ip, uint16_t port_id)
+{
+	struct neigh_ip4_key key = { .ip = htonl(ip), .port = port_id };
+	struct neigh_ip4_key old = { 0 };
+	struct neigh_entry *e;
+	int rc;
+
+	if (next_hop >= RTE_GRAPH_IP4_REWRITE_MAX_NH)
+		return -EINVAL;
+
+	if (neigh_nm_get() == NULL)
+		return -ENOMEM;
+
+	if (port_id >= RTE_MAX_ETHPORTS || !neigh_nm->tx_next[port_id])
+		return -EINVAL;
+
+	rte_spinlock_lock(&neigh_nm->lock);
+	e = &neigh_nm->ip4[next_hop];
+	old.ip = e->ip4;
+	old.port = e->port;
+	rc = neigh_key_add(neigh_nm->ip4_hash, &key, e->state != NEIGH_STATE_NONE ? &old : NULL,
+			   next_hop);
+	if (rc)
+		goto exit;
+
+	neigh_entry_reset(e, port_id);
+	e->ip4 = key.ip;
+	rc = ip4_rewrite_nh_unresolve(next_hop, IP4_REWRITE_NEXT_NEIGH);
+	if (rc) {
+		neigh_key_del(neigh_nm->ip4_hash, &key);
+		goto exit;
+	}
+	neigh_state_set(e, NEIGH_STATE_INCOMPLETE);
+exit:
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_neigh_del, 26.03)
+int
+rte_node_ip4_neigh_del(uint16_t next_hop)
+{
+	struct neigh_ip4_key key = { 0 };
+	struct neigh_entry *e;
+	int rc;
+
+	if (next_hop >= RTE_GRAPH_IP4_REWRITE_MAX_NH || neigh_nm == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&neigh_nm->lock);
+	e = &neigh_nm->ip4[next_hop];
+	if (e->state != NEIGH_STATE_NONE) {
+		neigh_state_set(e, NEIGH_STATE_NONE);
+		key.ip = e->ip4;
+		key.port = e->port;
+		neigh_key_del(neigh_nm->ip4_hash, &key);
+	}
+	rc = ip4_rewrite_nh_unresolve(next_hop, IP4_REWRITE_NEXT_PKT_DROP);
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_neigh_add, 26.03)
+int
+rte_node_ip6_neigh_add(uint16_t next_hop, const struct rte_ipv6_addr *ip, uint16_t port_id)
+{
+	struct neigh_ip6_key key = { .port = port_id };
+	struct neigh_ip6_key old = { 0 };
+	struct neigh_entry *e;
+	int rc;
+
+	if (next_hop >= RTE_GRAPH_IP6_REWRITE_MAX_NH || ip == NULL)
+		return -EINVAL;
+
+	if (neigh_nm_get() == NULL)
+		return -ENOMEM;
+
+	if (port_id >= RTE_MAX_ETHPORTS || !neigh_nm->tx_next[port_id])
+		return -EINVAL;
+
+	key.ip = *ip;
+	rte_spinlock_lock(&neigh_nm->lock);
+	e = &neigh_nm->ip6[next_hop];
+	old.ip = e->ip6;
+	old.port = e->port;
+	rc = neigh_key_add(neigh_nm->ip6_hash, &key, e->state != NEIGH_STATE_NONE ? &old : NULL,
+			   next_hop);
+	if (rc)
+		goto exit;
+
+	neigh_entry_reset(e, port_id);
+	e->ip6 = key.ip;
+	rc = ip6_rewrite_nh_unresolve(next_hop, IP6_REWRITE_NEXT_NEIGH);
+	if (rc) {
+		neigh_key_del(neigh_nm->ip6_hash, &key);
+		goto exit;
+	}
+	neigh_state_set(e, NEIGH_STATE_INCOMPLETE);
+exit:
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_neigh_del, 26.03)
+int
+rte_node_ip6_neigh_del(uint16_t next_hop)
+{
+	struct neigh_ip6_key key = { 0 };
+	struct neigh_entry *e;
+	int rc;
+
+	if (next_hop >= RTE_GRAPH_IP6_REWRITE_MAX_NH || neigh_nm == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&neigh_nm->lock);
+	e = &neigh_nm->ip6[next_hop];
+	if (e->state != NEIGH_STATE_NONE) {
+		neigh_state_set(e, NEIGH_STATE_NONE);
+		key.ip = e->ip6;
+		key.port = e->port;
+		neigh_key_del(neigh_nm->ip6_hash, &key);
+	}
+	rc = ip6_rewrite_nh_unresolve(next_hop, IP6_REWRITE_NEXT_PKT_DROP);
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return rc;
+}
+
+int
+neigh_port_edge_add(uint16_t port_id, const char *tx_node_name)
+{
+	struct rte_node_register *nodes[] = {
+		ip4_neigh_node_get(), arp_input_node_get(),
+		ip6_neigh_node_get(), nd_input_node_get(),
+		&neigh_timer_node,
+	};
+	struct neigh_node_main *nm;
+	unsigned int i;
+
+	nm = neigh_nm_get();
+	if (nm == NULL)
+		return -ENOMEM;
+
+	for (i = 0; i < RTE_DIM(nodes); i++)
+		rte_node_edge_update(nodes[i]->id, RTE_EDGE_ID_INVALID, &tx_node_name, 1);
+
+	/* Static edges being the same, the Tx edge has the same index in all */
+	nm->tx_next[port_id] = rte_node_edge_count(nodes[0]->id) - 1;
+
+	return 0;
+}
+
+/*
+ * Packets of a usable next hop are forwarded while it is learnt again,
+ * its rewrite data is only written as a whole when it was not in use.
+ * Must be called with the lock held.
+ */
+static void
+neigh_ip4_learn(uint16_t nh, const struct rte_ether_addr *mac, uint64_t now)
+{
+	struct neigh_entry *e = &neigh_nm->ip4[nh];
+	bool usable = neigh_state_usable(e->state);
+	struct rte_ether_hdr eth;
+
+	if (!usable) {
+		rte_ether_addr_copy(mac, &eth.dst_addr);
+		rte_ether_addr_copy(&neigh_nm->port[e->port].mac, &eth.src_addr);
+		eth.ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		if (rte_node_ip4_rewrite_add(nh, (uint8_t *)&eth, sizeof(eth), e->port))
+			return;
+	} else if (!rte_is_same_ether_addr(&e->mac, mac)) {
+		if (ip4_rewrite_nh_dst_update(nh, mac))
+			return;
+	}
+	rte_ether_addr_copy(mac, &e->mac);
+
+	e->confirmed = now;
+	e->probes = 0;
+	neigh_state_set(e, NEIGH_STATE_REACHABLE);
+	if (!usable)
+		rte_atomic_fetch_add_explicit(&neigh_nm->resolve_gen, 1, rte_memory_order_release);
+}
+
+static void
+neigh_ip6_learn(uint16_t nh, const struct rte_ether_addr *mac, uint64_t now)
+{
+	struct neigh_entry *e = &neigh_nm->ip6[nh];
+	bool usable = neigh_state_usable(e->state);
+	struct rte_ether_hdr eth;
+
+	if (!usable) {
+		rte_ether_addr_copy(mac, &eth.dst_addr);
+		rte_ether_addr_copy(&neigh_nm->port[e->port].mac, &eth.src_addr);
+		eth.ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		if (rte_node_ip6_rewrite_add(nh, (uint8_t *)&eth, sizeof(eth), e->port))
+			return;
+	} else if (!rte_is_same_ether_addr(&e->mac, mac)) {
+		if (ip6_rewrite_nh_dst_update(nh, mac))
+			return;
+	}
+	rte_ether_addr_copy(mac, &e->mac);
+
+	e->confirmed = now;
+	e->probes = 0;
+	neigh_state_set(e, NEIGH_STATE_REACHABLE);
+	if (!usable)
+		rte_atomic_fetch_add_explicit(&neigh_nm->resolve_gen, 1, rte_memory_order_release);
+}
+
+bool
+neigh_ip4_answer(rte_be32_t ip, uint16_t port, const struct rte_ether_addr *mac, uint64_t now)
+{
+	struct neigh_ip4_key key = { .ip = ip, .port = port };
+	struct neigh_entry *e;
+	bool learnt = false;
+	void *data;
+	uint16_t nh;
+
+	if (rte_hash_lookup_data(neigh_nm->ip4_hash, &key, &data) < 0)
+		return false;
+
+	nh = (uintptr_t)data;
+	e = &neigh_nm->ip4[nh];
+
+	/* Next hop may have been changed since the lookup */
+	rte_spinlock_lock(&neigh_nm->lock);
+	if (e->state != NEIGH_STATE_NONE && e->port == port && e->ip4 == ip) {
+		neigh_ip4_learn(nh, mac, now);
+		learnt = true;
+	}
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return learnt;
+}
+
+bool
+neigh_ip6_answer(const struct rte_ipv6_addr *ip, uint16_t port,
+		 const struct rte_ether_addr *mac, uint64_t now)
+{
+	struct neigh_ip6_key key = { .ip = *ip, .port = port };
+	struct neigh_entry *e;
+	bool learnt = false;
+	void *data;
+	uint16_t nh;
+
+	if (rte_hash_lookup_data(neigh_nm->ip6_hash, &key, &data) < 0)
+		return false;
+
+	nh = (uintptr_t)data;
+	e = &neigh_nm->ip6[nh];
+
+	/* Next hop may have been changed since the lookup */
+	rte_spinlock_lock(&neigh_nm->lock);
+	if (e->state != NEIGH_STATE_NONE && e->port == port && rte_ipv6_addr_eq(&e->ip6, ip)) {
+		neigh_ip6_learn(nh, mac, now);
+		learnt = true;
+	}
+	rte_spinlock_unlock(&neigh_nm->lock);
+
+	return learnt;
+}
+
+bool
+neigh_solicit_claim(struct neigh_entry *e, uint64_t now)
+{
+	uint64_t solicited;
+
+	solicited = rte_atomic_load_explicit(&e->solicited, rte_memory_order_relaxed);
+	if (now - solicited < neigh_nm->retrans)
+		return false;
+
+	return rte_atomic_compare_exchange_strong_explicit(&e->solicited, &solicited, now,
+							   rte_memory_order_relaxed,
+							   rte_memory_order_relaxed);
+}
+
+struct rte_mbuf *
+neigh_arp_request(const struct neigh_entry *e, struct rte_mempool *mp, bool unicast)
+{
+	const struct neigh_port *p = &neigh_nm->port[e->port];
+	struct rte_ether_hdr *eth;
+	struct rte_arp_hdr *arp;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(mp);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m, sizeof(*eth) + sizeof(*arp));
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+
+	if (unicast)
+		rte_ether_addr_copy(&e->mac, &eth->dst_addr);
+	else
+		memset(&eth->dst_addr, 0xff, RTE_ETHER_ADDR_LEN);
+	rte_ether_addr_copy(&p->mac, &eth->src_addr);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_ARP);
+
+	arp = (struct rte_arp_hdr *)(eth + 1);
+	arp->arp_hardware = rte_cpu_to_be_16(RTE_ARP_HRD_ETHER);
+	arp->arp_protocol = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	arp->arp_hlen = RTE_ETHER_ADDR_LEN;
+	arp->arp_plen = sizeof(rte_be32_t);
+	arp->arp_opcode = rte_cpu_to_be_16(RTE_ARP_OP_REQUEST);
+	rte_ether_addr_copy(&p->mac, &arp->arp_data.arp_sha);
+	arp->arp_data.arp_sip = p->ip4;
+	memset(&arp->arp_data.arp_tha, 0, RTE_ETHER_ADDR_LEN);
+	arp->arp_data.arp_tip = e->ip4;
+
+	m->port = e->port;
+
+	return m;
+}
+
+struct rte_mbuf *
+neigh_nd_solicit(const struct neigh_entry *e, struct rte_mempool *mp, bool unicast)
+{
+	const struct neigh_port *p = &neigh_nm->port[e->port];
+	struct rte_ether_hdr *eth;
+	struct neigh_nd_msg *nd;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(mp);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m, sizeof(*eth) + sizeof(*ip) +
+							 sizeof(*nd));
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+
+	ip = (struct rte_ipv6_hdr *)(eth + 1);
+	nd = (struct neigh_nd_msg *)(ip + 1);
+
+	/* Probes of a known neighbor are unicast, else to its solicited-node group */
+	if (unicast) {
+		rte_ether_addr_copy(&e->mac, &eth->dst_addr);
+		ip->dst_addr = e->ip6;
+	} else {
+		rte_ipv6_solnode_from_addr(&ip->dst_addr, &e->ip6);
+		rte_ether_mcast_from_ipv6(&eth->dst_addr, &ip->dst_addr);
+	}
+	rte_ether_addr_copy(&p->mac, &eth->src_addr);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+
+	ip->vtc_flow = RTE_BE32(0x60000000);
+	ip->payload_len = rte_cpu_to_be_16(sizeof(*nd));
+	ip->proto = IPPROTO_ICMPV6;
+	ip->hop_limits = 255;
+	ip->src_addr = p->ip6;
+
+	nd->icmp.type = NEIGH_ND_NS;
+	nd->icmp.code = 0;
+	nd->icmp.checksum = 0;
+	nd->flags = 0;
+	nd->target = e->ip6;
+	nd->opt_type = NEIGH_ND_OPT_SRC_LLADDR;
+	nd->opt_len = 1;
+	rte_ether_addr_copy(&p->mac, &nd->lladdr);
+	nd->icmp.checksum = rte_ipv6_udptcp_cksum(ip, nd);
+
+	m->port = e->port;
+
+	return m;
+}
+
+struct neigh_hold_q *
+neigh_hold_q_create(const struct rte_graph *graph)
+{
+	struct neigh_hold_q *q;
+	uint16_t size;
+
+	if (neigh_nm_get() == NULL)
+		return NULL;
+
+	size = neigh_nm->hold_max;
+	q = rte_zmalloc_socket("neigh_hold_q",
+			       sizeof(*q) + size * sizeof(struct neigh_hold_elem),
+			       RTE_CACHE_LINE_SIZE, graph->socket);
+	if (q == NULL)
+		return NULL;
+
+	q->size = size;
+	q->gen = rte_atomic_load_explicit(&neigh_nm->resolve_gen, rte_memory_order_relaxed);
+
+	return q;
+}
+
+void
+neigh_hold_q_free(struct neigh_hold_q *q)
+{
+	uint16_t i;
+
+	if (q == NULL)
+		return;
+
+	for (i = 0; i < q->count; i++)
+		rte_pktmbuf_free(q->elem[i].mbuf);
+	rte_free(q);
+}
+
+void
+neigh_node_fini(const struct rte_graph *graph __rte_unused, struct rte_node *node)
+{
+	neigh_hold_q_free(NEIGH_HOLD_Q(node->ctx));
+	NEIGH_HOLD_Q(node->ctx) = NULL;
+}
+
+struct rte_node *
+neigh_graph_node_get(const struct rte_graph *graph, const char *name)
+{
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+
+	rte_graph_foreach_node(count, off, graph, node) {
+		if (!strncmp(node->name, name, RTE_NODE_NAMESIZE))
+			return node;
+	}
+
+	return NULL;
+}
+
+int
+neigh_hold(struct neigh_hold_q *q, struct rte_mbuf *mbuf, uint16_t nh, uint64_t now)
+{
+	struct neigh_hold_elem *elem;
+
+	if (unlikely(q->count == q->size))
+		return -ENOSPC;
+
+	elem = &q->elem[q->count++];
+	elem->mbuf = mbuf;
+	elem->expire = now + neigh_nm->hold_timeout;
+	elem->nh = nh;
+
+	return 0;
+}
+
+uint16_t
+neigh_hold_release(struct rte_graph *graph, struct rte_node *node, struct neigh_hold_q *q,
+		   const struct neigh_entry *tbl, rte_edge_t next)
+{
+	uint16_t i, nb = 0, kept = 0;
+	void **to_next;
+	uint32_t gen;
+
+	gen = rte_atomic_load_explicit(&neigh_nm->resolve_gen, rte_memory_order_acquire);
+	if (likely(q->gen == gen))
+		return 0;
+
+	q->gen = gen;
+	if (q->count == 0)
+		return 0;
+
+	to_next = rte_node_next_stream_get(graph, node, next, q->count);
+	for (i = 0; i < q->count; i++) {
+		if (neigh_state_usable(neigh_state_get(&tbl[q->elem[i].nh])))
+			to_next[nb++] = q->elem[i].mbuf;
+		else
+			q->elem[kept++] = q->elem[i];
+	}
+	q->count = kept;
+	rte_node_next_stream_put(graph, node, next, nb);
+
+	return nb;
+}
+
+uint16_t
+neigh_hold_expire(struct rte_graph *graph, struct rte_node *node, struct neigh_hold_q *q,
+		  uint64_t now)
+{
+	uint16_t i, nb = 0;
+	void **to_next;
+
+	/* Packets are held in arrival order, expired ones are at the front */
+	while (nb < q->count && q->elem[nb].expire <= now)
+		nb++;
+
+	if (nb == 0)
+		return 0;
+
+	to_next = rte_node_next_stream_get(graph, node, NEIGH_NEXT_PKT_DROP, nb);
+	for (i = 0; i < nb; i++)
+		to_next[i] = q->elem[i].mbuf;
+	rte_node_next_stream_put(graph, node, NEIGH_NEXT_PKT_DROP, nb);
+
+	q->count -= nb;
+	memmove(q->elem, &q->elem[nb], q->count * sizeof(q->elem[0]));
+
+	return nb;
+}
+
+/* Returns number of probes sent */
+static uint16_t
+neigh_entry_age(struct rte_graph *graph, struct rte_node *node, struct neigh_entry *e,
+		uint16_t nh, bool ip6, uint64_t now)
+{
+	struct neigh_node_main *nm = neigh_nm;
+	struct rte_mbuf *m;
+
+	switch (e->state) {
+	case NEIGH_STATE_REACHABLE:
+		if (now - e->confirmed < nm->reachable)
+			return 0;
+		e->probes = 0;
+		rte_atomic_store_explicit(&e->solicited, 0, rte_memory_order_relaxed);
+		neigh_state_set(e, NEIGH_STATE_STALE);
+		/* fall through */
+	case NEIGH_STATE_STALE:
+		if (e->probes >= nm->max_probes) {
+			/* Neighbor is gone, hold its packets and solicit it again */
+			e->probes = 0;
+			neigh_state_set(e, NEIGH_STATE_INCOMPLETE);
+			if (ip6)
+				ip6_rewrite_nh_unresolve(nh, IP6_REWRITE_NEXT_NEIGH);
+			else
+				ip4_rewrite_nh_unresolve(nh, IP4_REWRITE_NEXT_NEIGH);
+			return 0;
+		}
+
+		if (!neigh_solicit_claim(e, now))
+			return 0;
+
+		e->probes++;
+		if (nm->pool == NULL)
+			return 0;
+
+		m = ip6 ? neigh_nd_solicit(e, nm->pool, true) :
+			  neigh_arp_request(e, nm->pool, true);
+		if (m == NULL)
+			return 0;
+
+		rte_node_enqueue_x1(graph, node, nm->tx_next[e->port], m);
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+static uint16_t
+neigh_timer_node_process(struct rte_graph *graph, struct rte_node *node,
+			 void **objs, uint16_t nb_objs)
+{
+	struct rte_node *ip4_neigh = NEIGH_TIMER_IP4_NODE(node->ctx);
+	struct rte_node *ip6_neigh = NEIGH_TIMER_IP6_NODE(node->ctx);
+	struct neigh_node_main *nm = neigh_nm;
+	uint64_t now = rte_rdtsc();
+	uint16_t nb = 0, i;
+	uint64_t next;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	/* Held packets belong to this graph, next hops may be resolved by another */
+	if (ip4_neigh != NULL) {
+		nb += neigh_hold_release(graph, node, NEIGH_HOLD_Q(ip4_neigh->ctx), nm->ip4,
+					 NEIGH_NEXT_IP4_REWRITE);
+		nb += neigh_hold_expire(graph, node, NEIGH_HOLD_Q(ip4_neigh->ctx), now);
+	}
+	if (ip6_neigh != NULL) {
+		nb += neigh_hold_release(graph, node, NEIGH_HOLD_Q(ip6_neigh->ctx), nm->ip6,
+					 NEIGH_NEXT_IP6_REWRITE);
+		nb += neigh_hold_expire(graph, node, NEIGH_HOLD_Q(ip6_neigh->ctx), now);
+	}
+
+	/* Neighbors are shared, the first graph past the deadline ages them */
+	next = rte_atomic_load_explicit(&nm->next_scan, rte_memory_order_relaxed);
+	if (likely(now < next))
+		return nb;
+
+	if (!rte_atomic_compare_exchange_strong_explicit(&nm->next_scan, &next,
+							 now + nm->retrans,
+							 rte_memory_order_relaxed,
+							 rte_memory_order_relaxed))
+		return nb;
+
+	rte_spinlock_lock(&nm->lock);
+	for (i = 0; i < RTE_GRAPH_IP4_REWRITE_MAX_NH; i++)
+		nb += neigh_entry_age(graph, node, &nm->ip4[i], i, false, now);
+	for (i = 0; i < RTE_GRAPH_IP6_REWRITE_MAX_NH; i++)
+		nb += neigh_entry_age(graph, node, &nm->ip6[i], i, true, now);
+	rte_spinlock_unlock(&nm->lock);
+
+	return nb;
+}
+
+static int
+neigh_timer_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_BUILD_BUG_ON(sizeof(struct neigh_timer_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (neigh_nm_get() == NULL)
+		return -ENOMEM;
+
+	NEIGH_TIMER_IP4_NODE(node->ctx) = neigh_graph_node_get(graph, "ip4_neigh");
+	NEIGH_TIMER_IP6_NODE(node->ctx) = neigh_graph_node_get(graph, "ip6_neigh");
+
+	node_dbg("neigh_timer", "Initialized neigh_timer node on graph %s", graph->name);
+
+	return 0;
+}
+
+static struct rte_node_register neigh_timer_node = {
+	.process = neigh_timer_node_process,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = "neigh_timer",
+
+	.init = neigh_timer_node_init,
+
+	.nb_edges = NEIGH_NEXT_MAX,
+	.next_nodes = {
+		[NEIGH_NEXT_PKT_DROP] = "pkt_drop",
+		[NEIGH_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[NEIGH_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+RTE_NODE_REGISTER(neigh_timer_node);
@@ -0,0 +1,351 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+#ifndef __INCLUDE_NEIGH_PRIV_H__
+#define __INCLUDE_NEIGH_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_hash.h>
+#include <rte_icmp.h>
+#include <rte_ip6.h>
+#include <rte_spinlock.h>
+
+#include "rte_node_neigh_api.h"
+
+#include "ip4_rewrite_priv.h"
+#include "ip6_rewrite_priv.h"
+
+#define NEIGH_ND_NS 135
+#define NEIGH_ND_NA 136
+#define NEIGH_ND_OPT_SRC_LLADDR 1
+#define NEIGH_ND_OPT_TGT_LLADDR 2
+#define NEIGH_ND_NA_FLAG_SOLICITED RTE_BE32(0x40000000)
+#define NEIGH_ND_NA_FLAG_OVERRIDE RTE_BE32(0x20000000)
+
+/**
+ * @internal
+ *
+ * Static edges of neigh nodes. All neigh nodes share this layout so that
+ * the per port Tx edges appended after it get the same index in each.
+ */
+enum neigh_next {
+	NEIGH_NEXT_PKT_DROP,
+	NEIGH_NEXT_IP4_REWRITE,
+	NEIGH_NEXT_IP6_REWRITE,
+	NEIGH_NEXT_MAX,
+};
+
+enum neigh_state {
+	NEIGH_STATE_NONE,
+	/**< Next hop not resolved by neigh nodes. */
+	NEIGH_STATE_INCOMPLETE,
+	/**< Solicited, waiting for an answer. */
+	NEIGH_STATE_REACHABLE,
+	/**< Recently confirmed. */
+	NEIGH_STATE_STALE,
+	/**< In use while being probed. */
+};
+
+/**
+ * @internal
+ *
+ * Neighbor entry, indexed by next hop id.
+ *
+ * Entries are updated under the lock. Graphs read state and claim
+ * solicitations without it, address and port only change while the
+ * state is NEIGH_STATE_NONE.
+ */
+struct neigh_entry {
+	union {
+		rte_be32_t ip4;
+		struct rte_ipv6_addr ip6;
+	};
+	struct rte_ether_addr mac;
+	uint16_t port;
+	RTE_ATOMIC(uint8_t) state;
+	uint8_t probes;
+	uint64_t confirmed;
+	/**< TSC of the last answer from the neighbor. */
+	RTE_ATOMIC(uint64_t) solicited;
+	/**< TSC of the last solicitation sent. */
+};
+
+/**
+ * @internal
+ *
+ * Keys of the next hop hash tables.
+ */
+struct neigh_ip4_key {
+	rte_be32_t ip;
+	uint16_t port;
+	uint16_t rsvd;
+};
+
+struct neigh_ip6_key {
+	struct rte_ipv6_addr ip;
+	uint16_t port;
+	uint16_t rsvd;
+};
+
+/**
+ * @internal
+ *
+ * Addresses owned by a port.
+ */
+struct neigh_port {
+	rte_be32_t ip4;
+	struct rte_ipv6_addr ip6;
+	struct rte_ether_addr mac;
+};
+
+/**
+ * @internal
+ *
+ * Neighbor node main data structure.
+ */
+struct neigh_node_main {
+	rte_spinlock_t lock;
+	/**< Serializes entry updates between graphs and control path. */
+	struct rte_hash *ip4_hash;
+	struct rte_hash *ip6_hash;
+	/**< Next hop of a port and neighbor address, looked up lock free. */
+	struct rte_mempool *pool;
+	uint16_t hold_max;
+	uint8_t max_probes;
+	uint64_t hold_timeout;
+	uint64_t retrans;
+	uint64_t reachable;
+	/**< Timers in TSC cycles. */
+	RTE_ATOMIC(uint64_t) next_scan;
+	/**< TSC of the next aging scan, claimed by one graph at a time. */
+	RTE_ATOMIC(uint32_t) resolve_gen;
+	/**< Bumped when a next hop gets resolved, to rescan hold queues. */
+	struct neigh_entry ip4[RTE_GRAPH_IP4_REWRITE_MAX_NH];
+	struct neigh_entry ip6[RTE_GRAPH_IP6_REWRITE_MAX_NH];
+	struct neigh_port port[RTE_MAX_ETHPORTS];
+	uint16_t tx_next[RTE_MAX_ETHPORTS];
+	/**< Tx edge of each configured port. */
+};
+
+/**
+ * @internal
+ *
+ * Packet waiting for resolution of its next hop.
+ */
+struct neigh_hold_elem {
+	struct rte_mbuf *mbuf;
+	uint64_t expire;
+	uint16_t nh;
+};
+
+/**
+ * @internal
+ *
+ * Per graph queue of packets waiting for resolution, in arrival order.
+ */
+struct neigh_hold_q {
+	uint16_t count;
+	uint16_t size;
+	uint32_t gen;
+	/**< Resolve generation at the last release scan. */
+	struct neigh_hold_elem elem[];
+};
+
+/**
+ * @internal
+ *
+ * Context of ip4_neigh and ip6_neigh nodes.
+ */
+struct neigh_node_ctx {
+	/* Packets held by this graph */
+	struct neigh_hold_q *q;
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+#define NEIGH_HOLD_Q(ctx) \
+	(((struct neigh_node_ctx *)ctx)->q)
+
+#define NEIGH_PRIV1_OFF(ctx) \
+	(((struct neigh_node_ctx *)ctx)->mbuf_priv1_off)
+
+/**
+ * @internal
+ *
+ * Context of arp_input and nd_input nodes, holding the ip4_neigh or
+ * ip6_neigh node of the same graph to release packets from its queue.
+ */
+struct neigh_input_node_ctx {
+	struct rte_node *neigh;
+};
+
+#define NEIGH_INPUT_NEIGH_NODE(ctx) \
+	(((struct neigh_input_node_ctx *)ctx)->neigh)
+
+/**
+ * @internal
+ *
+ * Neighbor discovery message with a link-layer address option.
+ */
+struct __rte_aligned(2) __rte_packed_begin neigh_nd_msg {
+	struct rte_icmp_base_hdr icmp;
+	rte_be32_t flags;
+	struct rte_ipv6_addr target;
+	uint8_t opt_type;
+	uint8_t opt_len;
+	struct rte_ether_addr lladdr;
+} __rte_packed_end;
+
+extern struct neigh_node_main *neigh_nm;
+
+/**
+ * @internal
+ *
+ * Get neighbor node main data, allocated with default configuration on
+ * first use.
+ */
+struct neigh_node_main *neigh_nm_get(void);
+
+/**
+ * @internal
+ *
+ * Allocate a hold queue for a graph.
+ */
+struct neigh_hold_q *neigh_hold_q_create(const struct rte_graph *graph);
+
+/**
+ * @internal
+ *
+ * Free a hold queue and the packets it holds.
+ */
+void neigh_hold_q_free(struct neigh_hold_q *q);
+
+/**
+ * @internal
+ *
+ * Fini of ip4_neigh and ip6_neigh nodes, freeing their hold queue.
+ */
+void neigh_node_fini(const struct rte_graph *graph, struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Find a node of the same graph.
+ */
+struct rte_node *neigh_graph_node_get(const struct rte_graph *graph, const char *name);
+
+/**
+ * @internal
+ *
+ * Hold a packet of a next hop.
+ *
+ * @return
+ *   0 on success, -ENOSPC if the queue is full.
+ */
+int neigh_hold(struct neigh_hold_q *q, struct rte_mbuf *mbuf, uint16_t nh, uint64_t now);
+
+/**
+ * @internal
+ *
+ * Send held packets whose next hop got resolved to a rewrite edge.
+ * The queue is only scanned when a next hop got resolved since the last call.
+ *
+ * @return
+ *   Number of packets released.
+ */
+uint16_t neigh_hold_release(struct rte_graph *graph, struct rte_node *node,
+			    struct neigh_hold_q *q, const struct neigh_entry *tbl,
+			    rte_edge_t next);
+
+/**
+ * @internal
+ *
+ * Send held packets older than the hold timeout to pkt_drop.
+ *
+ * @return
+ *   Number of packets dropped.
+ */
+uint16_t neigh_hold_expire(struct rte_graph *graph, struct rte_node *node,
+			   struct neigh_hold_q *q, uint64_t now);
+
+/**
+ * @internal
+ *
+ * Build an ARP request for an entry, broadcast unless unicast is set.
+ * Unicast requests must be built with the lock held.
+ */
+struct rte_mbuf *neigh_arp_request(const struct neigh_entry *e, struct rte_mempool *mp,
+				   bool unicast);
+
+/**
+ * @internal
+ *
+ * Build a neighbor solicitation for an entry, multicast unless unicast is
+ * set. Unicast solicitations must be built with the lock held.
+ */
+struct rte_mbuf *neigh_nd_solicit(const struct neigh_entry *e, struct rte_mempool *mp,
+				  bool unicast);
+
+/**
+ * @internal
+ *
+ * Record a neighbor answer into the next hop of its port and address,
+ * if any. The lock is only taken when a next hop matches.
+ *
+ * @return
+ *   True if a next hop was refreshed.
+ */
+bool neigh_ip4_answer(rte_be32_t ip, uint16_t port, const struct rte_ether_addr *mac,
+		      uint64_t now);
+bool neigh_ip6_answer(const struct rte_ipv6_addr *ip, uint16_t port,
+		      const struct rte_ether_addr *mac, uint64_t now);
+
+/**
+ * @internal
+ *
+ * Claim the solicitation of an unresolved entry, so that only one graph
+ * sends it per retransmission interval.
+ *
+ * @return
+ *   True if the caller must send the solicitation.
+ */
+bool neigh_solicit_claim(struct neigh_entry *e, uint64_t now);
+
+/**
+ * @internal
+ *
+ * Append the Tx node of a port as next to all neigh nodes.
+ */
+int neigh_port_edge_add(uint16_t port_id, const char *tx_node_name);
+
+/**
+ * @internal
+ *
+ * Get neigh nodes.
+ */
+struct rte_node_register *ip4_neigh_node_get(void);
+struct rte_node_register *arp_input_node_get(void);
+struct rte_node_register *ip6_neigh_node_get(void);
+struct rte_node_register *nd_input_node_get(void);
+
+static __rte_always_inline bool
+neigh_state_usable(uint8_t state)
+{
+	return state == NEIGH_STATE_REACHABLE || state == NEIGH_STATE_STALE;
+}
+
+static __rte_always_inline uint8_t
+neigh_state_get(const struct neigh_entry *e)
+{
+	return rte_atomic_load_explicit(&e->state, rte_memory_order_acquire);
+}
+
+static __rte_always_inline void
+neigh_state_set(struct neigh_entry *e, uint8_t state)
+{
+	rte_atomic_store_explicit(&e->state, state, rte_memory_order_release);
+}
+
+#endif /* __INCLUDE_NEIGH_PRIV_H__ */
@@ -40,6 +40,8 @@ static const alignas(RTE_CACHE_LINE_SIZE) uint8_t p_nxt[256] = {
 
 	[RTE_PTYPE_L3_IPV6_EXT_UNKNOWN | RTE_PTYPE_L2_ETHER] =
 		RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP,
+
+	[RTE_PTYPE_L2_ETHER_ARP] = RTE_NODE_PKT_CLS_NEXT_ARP_INPUT,
 };
 
 static uint16_t
@@ -235,6 +237,7 @@ struct rte_node_register pkt_cls_node = {
 		[RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP] = "ip6_lookup",
 		[RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB] = "ip4_lookup_fib",
 		[RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP_FIB] = "ip6_lookup_fib",
+		[RTE_NODE_PKT_CLS_NEXT_ARP_INPUT] = "arp_input",
 	},
 };
 RTE_NODE_REGISTER(pkt_cls_node);
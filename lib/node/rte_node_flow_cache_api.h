@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__
+#define __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__
+
+/**
+ * @file rte_node_flow_cache_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of flow_cache node.
+ *
+ * flow_cache node is placed after ethdev_rx using
+ * rte_node_ethdev_rx_next_update(). It looks up the 5-tuple of TCP/IPv4 and
+ * UDP/IPv4 packets in an exact match table owned by each graph, reusing the
+ * RSS hash of the packet when present. Packets of cached flows get their
+ * Ethernet header rewritten and are sent to ethdev_tx directly, skipping
+ * pkt_cls, ip4_lookup and ip4_rewrite. Other packets are sent to pkt_cls
+ * and the decision taken by ip4_rewrite for them is cached.
+ *
+ * Cached decisions are dropped when routes or rewrite data are changed through
+ * the node API. rte_node_flow_cache_invalidate() must be called when the
+ * forwarding state is changed by other means.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Flow cache next nodes, ethdev_tx nodes of configured ports follow.
+ */
+enum rte_node_flow_cache_next {
+	RTE_NODE_FLOW_CACHE_NEXT_PKT_CLS,
+	/**< Packet classification node. */
+	RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Flow cache node configuration.
+ * @see rte_node_flow_cache_configure
+ */
+struct rte_node_flow_cache_cfg {
+	uint32_t nb_entries;
+	/**< Maximum number of flows cached per graph. The table is emptied
+	 * when full.
+	 */
+};
+
+/**
+ * Configure flow_cache node.
+ *
+ * Takes effect for graphs created after this call.
+ *
+ * @param cfg
+ *   Flow cache configuration.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_flow_cache_configure(const struct rte_node_flow_cache_cfg *cfg);
+
+/**
+ * Drop all cached flows of all graphs.
+ *
+ * Graphs empty their table the next time flow_cache node runs.
+ */
+__rte_experimental
+void rte_node_flow_cache_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__ */
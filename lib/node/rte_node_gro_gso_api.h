@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef __INCLUDE_RTE_NODE_GRO_GSO_API_H__
+#define __INCLUDE_RTE_NODE_GRO_GSO_API_H__
+
+/**
+ * @file rte_node_gro_gso_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of gro and gso nodes.
+ *
+ * gro node reassembles TCP/IPv4 and UDP/IPv4 packets. It is placed after
+ * ethdev_rx using rte_node_ethdev_rx_next_update() and forwards packets to
+ * pkt_cls. Every graph holds its own GRO context, created when the graph is
+ * created, so no synchronization is needed between graph clones.
+ *
+ * gso node is a feature of the ip4 output feature arc
+ * (RTE_IP4_OUTPUT_FEATURE_ARC_NAME). Enabled on an interface, it segments
+ * TCP/IPv4 and UDP/IPv4 packets larger than the configured size in software,
+ * unless TSO is enabled on the port in which case segmentation is left to it.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include <rte_graph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** GSO feature on ip4 output arc */
+#define RTE_NODE_GSO_FEATURE_NAME "rte_gso_feature"
+
+/**
+ * GRO next nodes.
+ */
+enum rte_node_gro_next {
+	RTE_NODE_GRO_NEXT_PKT_CLS,
+	/**< Packet classification node. */
+	RTE_NODE_GRO_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * GRO node configuration.
+ * @see rte_node_gro_configure
+ */
+struct rte_node_gro_cfg {
+	uint64_t gro_types;
+	/**< RTE_GRO_* types to reassemble. */
+	uint16_t max_flow_num;
+	/**< Maximum number of flows per graph. */
+	uint16_t max_item_per_flow;
+	/**< Maximum number of packets held per flow. */
+	uint32_t timeout_us;
+	/**< Packets held longer than this are flushed. */
+	uint16_t flush_thresh;
+	/**< All packets are flushed when a burst smaller than this is
+	 * received, i.e. when the Rx stream runs dry. The default of
+	 * RTE_GRAPH_BURST_SIZE flushes on any partial burst, so packets
+	 * are merged within a burst only. A lower value lets packets be
+	 * merged across bursts, but they are then held until a burst below
+	 * it or past the timeout is received, as the node only runs when
+	 * packets come in.
+	 */
+};
+
+/**
+ * Configure gro node.
+ *
+ * Takes effect for graphs created after this call.
+ *
+ * @param cfg
+ *   GRO configuration.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_gro_configure(const struct rte_node_gro_cfg *cfg);
+
+/**
+ * Configure gso node for a port.
+ *
+ * @param port_id
+ *   Ethdev port identifier.
+ * @param gso_size
+ *   Maximum length of output packets including headers, 0 to let packets
+ *   through untouched.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_gso_configure(uint16_t port_id, uint16_t gso_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_GRO_GSO_API_H__ */
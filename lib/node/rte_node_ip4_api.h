@@ -49,6 +49,8 @@ enum rte_node_ip4_local_next {
 	/**< ip4 Local node. */
 	RTE_NODE_IP4_LOCAL_NEXT_PKT_DROP,
 	/**< Packet drop node. */
+	RTE_NODE_IP4_LOCAL_NEXT_GRE_DECAP,
+	/**< GRE decap node. */
 };
 
 /**
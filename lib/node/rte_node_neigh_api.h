@@ -0,0 +1,176 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef __INCLUDE_RTE_NODE_NEIGH_API_H__
+#define __INCLUDE_RTE_NODE_NEIGH_API_H__
+
+/**
+ * @file rte_node_neigh_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of neighbor resolution nodes
+ * like ip4_neigh, arp_input, ip6_neigh, nd_input and neigh_timer.
+ *
+ * A next hop registered with rte_node_ip4_neigh_add() or
+ * rte_node_ip6_neigh_add() is resolved by the graph itself instead of having
+ * its rewrite data filled by the application. Until resolved, ip4_rewrite
+ * and ip6_rewrite send its packets to ip4_neigh and ip6_neigh which hold them
+ * in a bounded per graph queue and solicit the neighbor. arp_input (fed by
+ * pkt_cls) and nd_input (fed by ip6_lookup through routes to the local and
+ * solicited-node multicast addresses) answer solicitations for the port
+ * addresses, learn the neighbor MAC address into the rewrite tables and
+ * release the held packets to the rewrite nodes.
+ *
+ * Learned neighbors are aged by the neigh_timer source node, which must be
+ * part of at least one graph for neighbors to be re-validated.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_ip6.h>
+#include <rte_mempool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Neighbor resolution configuration.
+ * @see rte_node_neigh_configure
+ */
+struct rte_node_neigh_cfg {
+	struct rte_mempool *pool;
+	/**< Pool to allocate solicitations from. When NULL, solicitations
+	 * are allocated from the pool of the packet waiting for resolution
+	 * and neighbors are not probed before expiring.
+	 */
+	uint16_t hold_max;
+	/**< Maximum number of packets held per graph and address family. */
+	uint32_t hold_timeout_ms;
+	/**< Held packets are dropped after this time. */
+	uint32_t retrans_ms;
+	/**< Minimum interval between solicitations of a neighbor. */
+	uint32_t reachable_ms;
+	/**< Time a neighbor is used without being confirmed. */
+	uint8_t max_probes;
+	/**< Unanswered probes after which a neighbor is resolved again. */
+};
+
+/**
+ * Configure neighbor resolution.
+ *
+ * The hold queue size takes effect for graphs created after this call.
+ *
+ * @param cfg
+ *   Neighbor resolution configuration.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_neigh_configure(const struct rte_node_neigh_cfg *cfg);
+
+/**
+ * Set the IPv4 address of a port.
+ *
+ * Used as source of ARP requests and answered in ARP replies.
+ *
+ * @param port_id
+ *   Ethdev port identifier.
+ * @param ip
+ *   IPv4 address in host order, 0 to stop answering ARP requests.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip4_neigh_port_addr_set(uint16_t port_id, uint32_t ip);
+
+/**
+ * Resolve an IPv4 next hop.
+ *
+ * Packets routed to the next hop are held until the neighbor answers.
+ *
+ * @param next_hop
+ *   Next hop id as used in rte_node_ip4_route_add().
+ * @param ip
+ *   IPv4 address of the neighbor in host order.
+ * @param port_id
+ *   Ethdev port the neighbor is reachable on.
+ *
+ * @return
+ *   0 on success, -EEXIST if another next hop resolves the same address on
+ *   this port, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip4_neigh_add(uint16_t next_hop, uint32_t ip, uint16_t port_id);
+
+/**
+ * Stop resolving an IPv4 next hop, its packets are dropped.
+ *
+ * @param next_hop
+ *   Next hop id.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip4_neigh_del(uint16_t next_hop);
+
+/**
+ * Set the IPv6 address of a port.
+ *
+ * Used as source of neighbor solicitations and answered in neighbor
+ * advertisements.
+ *
+ * @param port_id
+ *   Ethdev port identifier.
+ * @param ip
+ *   IPv6 address, unspecified address to stop answering solicitations.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_neigh_port_addr_set(uint16_t port_id, const struct rte_ipv6_addr *ip);
+
+/**
+ * Resolve an IPv6 next hop.
+ *
+ * Packets routed to the next hop are held until the neighbor answers.
+ *
+ * @param next_hop
+ *   Next hop id as used in rte_node_ip6_route_add().
+ * @param ip
+ *   IPv6 address of the neighbor.
+ * @param port_id
+ *   Ethdev port the neighbor is reachable on.
+ *
+ * @return
+ *   0 on success, -EEXIST if another next hop resolves the same address on
+ *   this port, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_neigh_add(uint16_t next_hop, const struct rte_ipv6_addr *ip,
+			   uint16_t port_id);
+
+/**
+ * Stop resolving an IPv6 next hop, its packets are dropped.
+ *
+ * @param next_hop
+ *   Next hop id.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_neigh_del(uint16_t next_hop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_NEIGH_API_H__ */
@@ -29,6 +29,7 @@ enum rte_node_pkt_cls_next {
 	RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP,
 	RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB,
 	RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP_FIB,
+	RTE_NODE_PKT_CLS_NEXT_ARP_INPUT,
 	RTE_NODE_PKT_CLS_NEXT_MAX,
 };
 
@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#ifndef __INCLUDE_RTE_NODE_TUNNEL_API_H__
+#define __INCLUDE_RTE_NODE_TUNNEL_API_H__
+
+/**
+ * @file rte_node_tunnel_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of tunnel nodes
+ * like vxlan_decap, geneve_decap, gre_decap and their encap counterparts.
+ *
+ * Decap nodes terminate L2 overlay tunnels over IPv4. vxlan_decap and
+ * geneve_decap are fed by udp4_input and must be attached to it using
+ * rte_node_udp4_usr_node_add() and rte_node_udp4_dst_port_add().
+ * gre_decap is fed by ip4_local. Decapsulated packets are sent to pkt_cls
+ * with mbuf->port set to the overlay port of the tunnel.
+ *
+ * Encap nodes are features of the ip4 output feature arc
+ * (RTE_IP4_OUTPUT_FEATURE_ARC_NAME). A tunnel is bound to an overlay
+ * interface by enabling the corresponding encap feature on that interface
+ * index with the tunnel id as app_cookie in rte_graph_feature_enable().
+ *
+ * Tunnels can be added, updated and deleted while graphs are walked if the
+ * graph workers report their quiescent states to an RCU QSBR variable
+ * registered with rte_node_tunnel_rcu_qsbr_add(). Otherwise no graph using
+ * tunnel nodes may be walked during these updates.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_ether.h>
+
+#include <rte_graph.h>
+#include <rte_rcu_qsbr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of tunnels. */
+#define RTE_NODE_TUNNEL_MAX 1024
+
+/** VXLAN encap feature on ip4 output arc */
+#define RTE_NODE_VXLAN_ENCAP_FEATURE_NAME "rte_vxlan_encap_feature"
+/** GENEVE encap feature on ip4 output arc */
+#define RTE_NODE_GENEVE_ENCAP_FEATURE_NAME "rte_geneve_encap_feature"
+/** GRE encap feature on ip4 output arc */
+#define RTE_NODE_GRE_ENCAP_FEATURE_NAME "rte_gre_encap_feature"
+
+/**
+ * Tunnel types.
+ */
+enum rte_node_tunnel_type {
+	RTE_NODE_TUNNEL_VXLAN,
+	/**< VXLAN over UDP/IPv4. */
+	RTE_NODE_TUNNEL_GENEVE,
+	/**< GENEVE over UDP/IPv4, without options on encap. */
+	RTE_NODE_TUNNEL_GRE,
+	/**< Transparent Ethernet bridging over GRE/IPv4. */
+	RTE_NODE_TUNNEL_TYPE_MAX,
+	/**< Number of tunnel types. */
+};
+
+/**
+ * Tunnel decap next nodes.
+ */
+enum rte_node_tunnel_decap_next {
+	RTE_NODE_TUNNEL_DECAP_NEXT_PKT_CLS,
+	/**< Packet classification node. */
+	RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Tunnel configuration.
+ * @see rte_node_tunnel_add
+ */
+struct rte_node_tunnel_conf {
+	enum rte_node_tunnel_type type;
+	/**< Tunnel type. */
+	uint32_t vni;
+	/**< VNI for VXLAN and GENEVE, key for GRE. */
+	bool gre_key;
+	/**< Carry vni as GRE key. Ignored for other tunnel types. */
+	uint32_t src_ip;
+	/**< Local outer IPv4 address in host order. */
+	uint32_t dst_ip;
+	/**< Remote outer IPv4 address in host order. */
+	struct rte_ether_addr src_mac;
+	/**< Outer source MAC address. */
+	struct rte_ether_addr dst_mac;
+	/**< Outer destination MAC address. */
+	uint16_t underlay_port;
+	/**< Ethdev port encapsulated packets are sent on. */
+	uint16_t overlay_port;
+	/**< Port set in mbuf->port of decapsulated packets. */
+	uint8_t ttl;
+	/**< Outer IPv4 TTL, 0 selects 64. */
+	uint8_t tos;
+	/**< Outer IPv4 type of service. */
+};
+
+/**
+ * Add or update a tunnel.
+ *
+ * The outer header template of the tunnel is built once here and
+ * copied in front of every encapsulated packet by the encap nodes.
+ * An update is built aside and replaces the tunnel at once, so
+ * packets are processed with either the previous or the new
+ * configuration.
+ *
+ * @param tunnel_id
+ *   Tunnel identifier, less than RTE_NODE_TUNNEL_MAX.
+ * @param conf
+ *   Tunnel configuration.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_tunnel_add(uint16_t tunnel_id, const struct rte_node_tunnel_conf *conf);
+
+/**
+ * Delete a tunnel.
+ *
+ * @param tunnel_id
+ *   Tunnel identifier.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_tunnel_del(uint16_t tunnel_id);
+
+/**
+ * Register the RCU QSBR variable of the graph workers.
+ *
+ * Tunnel updates then wait for the graph workers to report a quiescent
+ * state before reusing memory they may still read. Graph workers must
+ * report a quiescent state between graph walks.
+ *
+ * Must be called before any tunnel is added.
+ *
+ * @param v
+ *   RCU QSBR variable.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_tunnel_rcu_qsbr_add(struct rte_rcu_qsbr *v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_TUNNEL_API_H__ */
@@ -0,0 +1,380 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_gre.h>
+#include <rte_hash.h>
+#include <rte_ip.h>
+#include <rte_jhash.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "rte_node_tunnel_api.h"
+
+#include "node_private.h"
+#include "tunnel_priv.h"
+
+#define TUNNEL_HASH_TBL_SIZE (2 * RTE_NODE_TUNNEL_MAX)
+#define TUNNEL_DEFAULT_TTL 64
+
+struct tunnel_node_main *tunnel_nm;
+
+static int
+tunnel_hash_rcu_add(struct rte_hash *hash)
+{
+	struct rte_hash_rcu_config cfg = {
+		.v = tunnel_nm->rcu,
+		.mode = RTE_HASH_QSBR_MODE_SYNC,
+	};
+
+	if (rte_hash_rcu_qsbr_add(hash, &cfg))
+		return -rte_errno;
+
+	return 0;
+}
+
+static int
+tunnel_hash_setup(int socket)
+{
+	struct rte_hash_parameters params = {
+		.entries = TUNNEL_HASH_TBL_SIZE,
+		.key_len = sizeof(struct tunnel_key),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+	char s[RTE_HASH_NAMESIZE];
+	struct rte_hash *hash;
+	int rc;
+
+	/* One hash table per socket */
+	if (tunnel_nm->hash_tbl[socket])
+		return 0;
+
+	snprintf(s, sizeof(s), "TUNNEL_HASH_%d", socket);
+	params.name = s;
+	params.socket_id = socket;
+	hash = rte_hash_create(&params);
+	if (hash == NULL)
+		return -rte_errno;
+
+	if (tunnel_nm->rcu) {
+		rc = tunnel_hash_rcu_add(hash);
+		if (rc) {
+			rte_hash_free(hash);
+			return rc;
+		}
+	}
+
+	/* Decap nodes pick the table up on their next run */
+	rte_atomic_store_explicit(&tunnel_nm->hash_tbl[socket], hash,
+				  rte_memory_order_release);
+
+	return 0;
+}
+
+/* Decap lookup tables are only needed once a tunnel is configured */
+static int
+tunnel_hash_init(void)
+{
+	unsigned int lcore_id;
+	int socket, rc;
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		socket = rte_lcore_to_socket_id(lcore_id);
+		rc = tunnel_hash_setup(socket);
+		if (rc) {
+			node_err("tunnel", "Failed to setup hash tbl for sock %d, rc=%d",
+				 socket, rc);
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int
+tunnel_node_main_init(void)
+{
+	if (tunnel_nm == NULL) {
+		tunnel_nm = rte_zmalloc("tunnel_nm", sizeof(struct tunnel_node_main),
+					RTE_CACHE_LINE_SIZE);
+		if (tunnel_nm == NULL)
+			return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/* Wait for graph workers to be done with unpublished tunnel entries */
+static void
+tunnel_synchronize(void)
+{
+	if (tunnel_nm->rcu)
+		rte_rcu_qsbr_synchronize(tunnel_nm->rcu, RTE_QSBR_THRID_INVALID);
+}
+
+static void
+tunnel_key_del(const struct tunnel_key *key)
+{
+	struct rte_hash *hash;
+	uint8_t socket;
+	int32_t pos;
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		hash = tunnel_nm->hash_tbl[socket];
+		if (!hash)
+			continue;
+
+		pos = rte_hash_del_key(hash, key);
+		/* Without RCU, graph workers are quiescent during updates */
+		if (pos >= 0 && tunnel_nm->rcu == NULL)
+			rte_hash_free_key_with_position(hash, pos);
+	}
+}
+
+static void
+tunnel_key_get(const struct tunnel_entry *t, struct tunnel_key *key)
+{
+	const struct rte_ipv4_hdr *ip;
+
+	ip = (const struct rte_ipv4_hdr *)(t->hdr + sizeof(struct rte_ether_hdr));
+
+	memset(key, 0, sizeof(*key));
+	/* Received packets are addressed to the local end of the tunnel */
+	key->dst_ip = ip->src_addr;
+	key->vni = t->vni;
+	key->type = t->type;
+}
+
+static int
+tunnel_hdr_build(struct tunnel_entry *t, const struct rte_node_tunnel_conf *conf)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)t->hdr;
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *udp;
+	uint16_t len;
+
+	memset(t->hdr, 0, sizeof(t->hdr));
+
+	rte_ether_addr_copy(&conf->dst_mac, &eth->dst_addr);
+	rte_ether_addr_copy(&conf->src_mac, &eth->src_addr);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->type_of_service = conf->tos;
+	ip->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip->time_to_live = conf->ttl ? conf->ttl : TUNNEL_DEFAULT_TTL;
+	ip->src_addr = rte_cpu_to_be_32(conf->src_ip);
+	ip->dst_addr = rte_cpu_to_be_32(conf->dst_ip);
+	len = sizeof(*eth) + sizeof(*ip);
+
+	switch (conf->type) {
+	case RTE_NODE_TUNNEL_VXLAN: {
+		struct rte_vxlan_hdr *vxlan;
+
+		if (conf->vni > RTE_BIT32(24) - 1)
+			return -EINVAL;
+
+		ip->next_proto_id = IPPROTO_UDP;
+		udp = (struct rte_udp_hdr *)(ip + 1);
+		udp->dst_port = rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT);
+		vxlan = (struct rte_vxlan_hdr *)(udp + 1);
+		vxlan->flag_i = 1;
+		vxlan->vx_vni = rte_cpu_to_be_32(conf->vni << 8);
+		len += sizeof(*udp) + sizeof(*vxlan);
+		t->vni = conf->vni;
+		break;
+	}
+	case RTE_NODE_TUNNEL_GENEVE: {
+		struct rte_geneve_hdr *geneve;
+
+		if (conf->vni > RTE_BIT32(24) - 1)
+			return -EINVAL;
+
+		ip->next_proto_id = IPPROTO_UDP;
+		udp = (struct rte_udp_hdr *)(ip + 1);
+		udp->dst_port = rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT);
+		geneve = (struct rte_geneve_hdr *)(udp + 1);
+		geneve->proto = rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH);
+		geneve->vni[0] = (conf->vni >> 16) & 0xff;
+		geneve->vni[1] = (conf->vni >> 8) & 0xff;
+		geneve->vni[2] = conf->vni & 0xff;
+		len += sizeof(*udp) + sizeof(*geneve);
+		t->vni = conf->vni;
+		break;
+	}
+	case RTE_NODE_TUNNEL_GRE: {
+		struct rte_gre_hdr *gre;
+
+		ip->next_proto_id = IPPROTO_GRE;
+		gre = (struct rte_gre_hdr *)(ip + 1);
+		gre->proto = rte_cpu_to_be_16(RTE_ETHER_TYPE_TEB);
+		len += sizeof(*gre);
+		t->vni = 0;
+		if (conf->gre_key) {
+			struct rte_gre_hdr_opt_key *key;
+
+			gre->k = 1;
+			key = (struct rte_gre_hdr_opt_key *)(gre + 1);
+			key->key = rte_cpu_to_be_32(conf->vni);
+			len += sizeof(*key);
+			t->vni = conf->vni;
+		}
+		break;
+	}
+	default:
+		return -EINVAL;
+	}
+
+	t->hdr_len = len;
+	/* Total length is patched per packet, keep the partial sum of the rest */
+	t->ip_csum = rte_raw_cksum(ip, sizeof(*ip));
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_tunnel_add, 26.03)
+int
+rte_node_tunnel_add(uint16_t tunnel_id, const struct rte_node_tunnel_conf *conf)
+{
+	struct tunnel_key key, old_key;
+	struct tunnel_entry *t, *old;
+	uint8_t socket;
+	int rc;
+
+	if (tunnel_id >= RTE_NODE_TUNNEL_MAX || conf == NULL ||
+	    conf->type >= RTE_NODE_TUNNEL_TYPE_MAX)
+		return -EINVAL;
+
+	if (conf->underlay_port >= RTE_MAX_ETHPORTS)
+		return -EINVAL;
+
+	rc = tunnel_node_main_init();
+	if (rc)
+		return rc;
+
+	rc = tunnel_hash_init();
+	if (rc)
+		return rc;
+
+	/* Graph workers may still use the current entry, fill the other one */
+	old = tunnel_entry_get(tunnel_id);
+	t = &tunnel_nm->entries[tunnel_id][old == &tunnel_nm->entries[tunnel_id][0]];
+
+	memset(t, 0, sizeof(*t));
+	t->type = conf->type;
+	rc = tunnel_hdr_build(t, conf);
+	if (rc)
+		return rc;
+
+	t->underlay_port = conf->underlay_port;
+	t->overlay_port = conf->overlay_port;
+
+	tunnel_key_get(t, &key);
+
+	/* Decap nodes read the tunnel as soon as its key is found */
+	rte_atomic_store_explicit(&tunnel_nm->tunnels[tunnel_id], t,
+				  rte_memory_order_release);
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!tunnel_nm->hash_tbl[socket])
+			continue;
+
+		rc = rte_hash_add_key_data(tunnel_nm->hash_tbl[socket], &key,
+					   (void *)(uintptr_t)tunnel_id);
+		if (rc < 0) {
+			node_err("tunnel", "Failed to add key for sock %u, rc=%d",
+				 socket, rc);
+			goto rollback;
+		}
+	}
+
+	if (old) {
+		tunnel_key_get(old, &old_key);
+		if (memcmp(&key, &old_key, sizeof(key)))
+			tunnel_key_del(&old_key);
+	}
+
+	tunnel_synchronize();
+
+	return 0;
+
+rollback:
+	/* An unchanged key still maps to the tunnel, leave it in place */
+	if (old) {
+		tunnel_key_get(old, &old_key);
+		if (!memcmp(&key, &old_key, sizeof(key)))
+			socket = 0;
+	}
+	while (socket-- > 0) {
+		if (tunnel_nm->hash_tbl[socket])
+			rte_hash_del_key(tunnel_nm->hash_tbl[socket], &key);
+	}
+	rte_atomic_store_explicit(&tunnel_nm->tunnels[tunnel_id], old,
+				  rte_memory_order_release);
+	tunnel_synchronize();
+
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_tunnel_del, 26.03)
+int
+rte_node_tunnel_del(uint16_t tunnel_id)
+{
+	struct tunnel_entry *t;
+	struct tunnel_key key;
+
+	if (tunnel_id >= RTE_NODE_TUNNEL_MAX || tunnel_nm == NULL)
+		return -EINVAL;
+
+	t = tunnel_entry_get(tunnel_id);
+	if (t == NULL)
+		return -ENOENT;
+
+	tunnel_key_get(t, &key);
+	tunnel_key_del(&key);
+
+	rte_atomic_store_explicit(&tunnel_nm->tunnels[tunnel_id], NULL,
+				  rte_memory_order_release);
+	tunnel_synchronize();
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_tunnel_rcu_qsbr_add, 26.03)
+int
+rte_node_tunnel_rcu_qsbr_add(struct rte_rcu_qsbr *v)
+{
+	uint8_t socket;
+	int rc;
+
+	if (v == NULL)
+		return -EINVAL;
+
+	rc = tunnel_node_main_init();
+	if (rc)
+		return rc;
+
+	if (tunnel_nm->rcu)
+		return -EEXIST;
+
+	/* Lookup tables are registered with the variable on creation */
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (tunnel_nm->hash_tbl[socket])
+			return -EBUSY;
+	}
+
+	tunnel_nm->rcu = v;
+
+	return 0;
+}
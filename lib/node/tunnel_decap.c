@@ -0,0 +1,311 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gre.h>
+#include <rte_hash.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_net.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "rte_node_tunnel_api.h"
+
+#include "node_private.h"
+#include "tunnel_priv.h"
+
+#define TUNNEL_DECAP_PREFETCH_AHEAD 4
+
+struct tunnel_decap_node_ctx {
+	/* Socket of the graph, its hash table comes with the first tunnel */
+	int socket;
+};
+
+#define TUNNEL_DECAP_NODE_SOCKET(ctx) \
+	(((struct tunnel_decap_node_ctx *)ctx)->socket)
+
+static __rte_always_inline void
+tunnel_decap_prefetch(void *obj)
+{
+	struct rte_mbuf *mbuf = (struct rte_mbuf *)obj;
+
+	rte_prefetch0(rte_pktmbuf_mtod_offset(mbuf, void *, sizeof(struct rte_ether_hdr)));
+}
+
+/* Returns the outer header length to strip, 0 if packet is not decapsulable */
+static __rte_always_inline uint16_t
+tunnel_decap_parse(struct rte_mbuf *mbuf, const int type, struct tunnel_key *key)
+{
+	uint16_t data_len = rte_pktmbuf_data_len(mbuf);
+	struct rte_ipv4_hdr *ip;
+	uint16_t off;
+	uint8_t *l4;
+
+	/* Outer headers must be in the first segment */
+	if (unlikely(data_len < sizeof(struct rte_ether_hdr) + sizeof(*ip)))
+		return 0;
+
+	ip = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+				     sizeof(struct rte_ether_hdr));
+	off = sizeof(struct rte_ether_hdr) + rte_ipv4_hdr_len(ip);
+	l4 = rte_pktmbuf_mtod_offset(mbuf, uint8_t *, off);
+
+	key->dst_ip = ip->dst_addr;
+	key->type = type;
+
+	switch (type) {
+	case RTE_NODE_TUNNEL_VXLAN: {
+		struct rte_vxlan_hdr *vxlan;
+
+		if (unlikely(off + sizeof(struct rte_udp_hdr) + sizeof(*vxlan) > data_len))
+			return 0;
+		vxlan = (struct rte_vxlan_hdr *)(l4 + sizeof(struct rte_udp_hdr));
+		if (unlikely(!vxlan->flag_i))
+			return 0;
+		key->vni = rte_be_to_cpu_32(vxlan->vx_vni) >> 8;
+		off += sizeof(struct rte_udp_hdr) + sizeof(*vxlan);
+		break;
+	}
+	case RTE_NODE_TUNNEL_GENEVE: {
+		struct rte_geneve_hdr *geneve;
+
+		if (unlikely(off + sizeof(struct rte_udp_hdr) + sizeof(*geneve) > data_len))
+			return 0;
+		geneve = (struct rte_geneve_hdr *)(l4 + sizeof(struct rte_udp_hdr));
+		if (unlikely(geneve->ver ||
+			     geneve->proto != rte_cpu_to_be_16(RTE_GENEVE_TYPE_ETH)))
+			return 0;
+		key->vni = (geneve->vni[0] << 16) | (geneve->vni[1] << 8) | geneve->vni[2];
+		off += sizeof(struct rte_udp_hdr) + sizeof(*geneve) + (geneve->opt_len << 2);
+		break;
+	}
+	default: {
+		struct rte_gre_hdr *gre = (struct rte_gre_hdr *)l4;
+		uint8_t *opt = (uint8_t *)(gre + 1);
+
+		if (unlikely(off + sizeof(*gre) > data_len))
+			return 0;
+		if (unlikely(gre->ver || gre->proto != rte_cpu_to_be_16(RTE_ETHER_TYPE_TEB)))
+			return 0;
+		/* Optional fields are in checksum, key, sequence order */
+		if (gre->c)
+			opt += sizeof(struct rte_gre_hdr_opt_checksum_rsvd);
+		key->vni = 0;
+		if (gre->k) {
+			if (unlikely(off + (opt - l4) + sizeof(struct rte_gre_hdr_opt_key) >
+				     data_len))
+				return 0;
+			key->vni = rte_be_to_cpu_32(((struct rte_gre_hdr_opt_key *)opt)->key);
+			opt += sizeof(struct rte_gre_hdr_opt_key);
+		}
+		if (gre->s)
+			opt += sizeof(struct rte_gre_hdr_opt_sequence);
+		off += opt - l4;
+		break;
+	}
+	}
+
+	if (unlikely(off + RTE_ETHER_HDR_LEN > data_len))
+		return 0;
+
+	return off;
+}
+
+static __rte_always_inline uint16_t
+tunnel_decap_node_process(struct rte_graph *graph, struct rte_node *node,
+			  void **objs, uint16_t nb_objs, const int type)
+{
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	struct tunnel_key keys[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t strip[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint16_t last_spec = 0, held = 0;
+	uint16_t base, n, i, dropped = 0;
+	void **to_next, **from;
+	rte_edge_t next_index;
+	struct rte_hash *hash;
+	struct rte_mbuf *mbuf;
+	uint64_t hit_mask;
+
+	hash = rte_atomic_load_explicit(&tunnel_nm->hash_tbl[TUNNEL_DECAP_NODE_SOCKET(node->ctx)],
+					rte_memory_order_acquire);
+	if (unlikely(hash == NULL)) {
+		/* No tunnel configured yet */
+		rte_node_enqueue(graph, node, RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP, objs, nb_objs);
+		NODE_INCREMENT_XSTAT_ID(node, 0, true, nb_objs);
+		return nb_objs;
+	}
+
+	/* Speculative next */
+	next_index = RTE_NODE_TUNNEL_DECAP_NEXT_PKT_CLS;
+
+	for (i = 0; i < TUNNEL_DECAP_PREFETCH_AHEAD && i < nb_objs; i++)
+		tunnel_decap_prefetch(objs[i]);
+
+	from = objs;
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (base = 0; base < nb_objs; base += n) {
+		n = RTE_MIN(nb_objs - base, RTE_HASH_LOOKUP_BULK_MAX);
+
+		/* Parse outer headers of the whole chunk, then look it up at once */
+		for (i = 0; i < n; i++) {
+			if (likely(base + i + TUNNEL_DECAP_PREFETCH_AHEAD < nb_objs))
+				tunnel_decap_prefetch(objs[base + i + TUNNEL_DECAP_PREFETCH_AHEAD]);
+
+			strip[i] = tunnel_decap_parse(objs[base + i], type, &keys[i]);
+			key_ptrs[i] = &keys[i];
+		}
+
+		hit_mask = 0;
+		rte_hash_lookup_bulk_data(hash, key_ptrs, n, &hit_mask, data);
+
+		for (i = 0; i < n; i++) {
+			rte_edge_t next = RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP;
+			struct tunnel_entry *t = NULL;
+
+			mbuf = (struct rte_mbuf *)objs[base + i];
+			if (likely((hit_mask & RTE_BIT64(i)) && strip[i]))
+				t = tunnel_entry_get((uintptr_t)data[i]);
+			if (likely(t != NULL)) {
+				rte_pktmbuf_adj(mbuf, strip[i]);
+				mbuf->port = t->overlay_port;
+				mbuf->packet_type = rte_net_get_ptype(mbuf, NULL,
+						RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK);
+				next = next_index;
+			}
+
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+				dropped++;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, dropped, dropped);
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	return nb_objs;
+}
+
+static uint16_t
+vxlan_decap_node_process(struct rte_graph *graph, struct rte_node *node,
+			 void **objs, uint16_t nb_objs)
+{
+	return tunnel_decap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_VXLAN);
+}
+
+static uint16_t
+geneve_decap_node_process(struct rte_graph *graph, struct rte_node *node,
+			  void **objs, uint16_t nb_objs)
+{
+	return tunnel_decap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_GENEVE);
+}
+
+static uint16_t
+gre_decap_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	return tunnel_decap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_GRE);
+}
+
+static int
+tunnel_decap_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	int rc;
+
+	RTE_BUILD_BUG_ON(sizeof(struct tunnel_decap_node_ctx) > RTE_NODE_CTX_SZ);
+
+	rc = tunnel_node_main_init();
+	if (rc) {
+		node_err("tunnel_decap", "Failed to init tunnel tables, rc=%d", rc);
+		return rc;
+	}
+
+	TUNNEL_DECAP_NODE_SOCKET(node->ctx) = graph->socket == SOCKET_ID_ANY ?
+		(int)rte_lcore_to_socket_id(rte_get_main_lcore()) : graph->socket;
+
+	node_dbg("tunnel_decap", "Initialized %s node", node->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats tunnel_decap_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "tunnel_decap_drop",
+	},
+};
+
+static struct rte_node_register vxlan_decap_node = {
+	.process = vxlan_decap_node_process,
+	.name = "vxlan_decap",
+
+	.init = tunnel_decap_node_init,
+	.xstats = &tunnel_decap_xstats,
+
+	.nb_edges = RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_CLS] = "pkt_cls",
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(vxlan_decap_node);
+
+static struct rte_node_register geneve_decap_node = {
+	.process = geneve_decap_node_process,
+	.name = "geneve_decap",
+
+	.init = tunnel_decap_node_init,
+	.xstats = &tunnel_decap_xstats,
+
+	.nb_edges = RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_CLS] = "pkt_cls",
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(geneve_decap_node);
+
+static struct rte_node_register gre_decap_node = {
+	.process = gre_decap_node_process,
+	.name = "gre_decap",
+
+	.init = tunnel_decap_node_init,
+	.xstats = &tunnel_decap_xstats,
+
+	.nb_edges = RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_CLS] = "pkt_cls",
+		[RTE_NODE_TUNNEL_DECAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gre_decap_node);
@@ -0,0 +1,344 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_feature_arc_worker.h>
+#include <rte_graph_worker.h>
+#include <rte_hash_crc.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+
+#include "rte_node_ip4_api.h"
+#include "rte_node_tunnel_api.h"
+
+#include "node_private.h"
+#include "tunnel_priv.h"
+
+/* UDP source port range carrying inner flow entropy, RFC 7348 */
+#define TUNNEL_ENCAP_SPORT_BASE 0xc000
+#define TUNNEL_ENCAP_SPORT_MASK 0x3fff
+
+enum tunnel_encap_next {
+	TUNNEL_ENCAP_NEXT_PKT_DROP,
+	TUNNEL_ENCAP_NEXT_MAX,
+};
+
+struct tunnel_encap_node_ctx {
+	/* Cached feature arc handle */
+	rte_graph_feature_arc_t out_arc;
+	/* Cached next index */
+	uint16_t last_index;
+};
+
+#define TUNNEL_ENCAP_FEATURE_ARC(ctx) \
+	(((struct tunnel_encap_node_ctx *)ctx)->out_arc)
+
+#define TUNNEL_ENCAP_LAST_NEXT_INDEX(ctx) \
+	(((struct tunnel_encap_node_ctx *)ctx)->last_index)
+
+static __rte_always_inline uint16_t
+tunnel_encap_sport(const struct rte_mbuf *mbuf, const struct rte_ipv4_hdr *inner)
+{
+	uint32_t hash;
+
+	if (mbuf->ol_flags & RTE_MBUF_F_RX_RSS_HASH)
+		hash = mbuf->hash.rss;
+	else
+		hash = rte_hash_crc_4byte(inner->dst_addr,
+					  rte_hash_crc_4byte(inner->src_addr, 0));
+
+	return TUNNEL_ENCAP_SPORT_BASE | (hash & TUNNEL_ENCAP_SPORT_MASK);
+}
+
+static __rte_always_inline uint16_t
+tunnel_encap_x1(struct rte_graph_feature_arc *arc, struct rte_mbuf *mbuf, const int type)
+{
+	struct rte_graph_feature_arc_mbuf_dynfields *mbfields;
+	struct rte_ipv4_hdr *ip, *inner;
+	struct tunnel_entry *t;
+	uint32_t len, csum;
+	uint16_t id, next;
+	uint8_t *hdr;
+
+	/* Tunnel id is the app_cookie of this feature on the tx interface */
+	mbfields = rte_graph_feature_arc_mbuf_dynfields_get(mbuf, arc->mbuf_dyn_offset);
+	id = rte_graph_feature_data_app_cookie_get(arc, mbfields->feature_data);
+	rte_graph_feature_data_next_feature_get(arc, &mbfields->feature_data, &next);
+
+	if (unlikely(id >= RTE_NODE_TUNNEL_MAX))
+		return TUNNEL_ENCAP_NEXT_PKT_DROP;
+
+	t = tunnel_entry_get(id);
+	if (unlikely(t == NULL || t->type != type))
+		return TUNNEL_ENCAP_NEXT_PKT_DROP;
+
+	len = rte_pktmbuf_pkt_len(mbuf);
+	hdr = (uint8_t *)rte_pktmbuf_prepend(mbuf, t->hdr_len);
+	if (unlikely(hdr == NULL))
+		return TUNNEL_ENCAP_NEXT_PKT_DROP;
+
+	rte_memcpy(hdr, t->hdr, t->hdr_len);
+
+	ip = (struct rte_ipv4_hdr *)(hdr + sizeof(struct rte_ether_hdr));
+	len += t->hdr_len - sizeof(struct rte_ether_hdr);
+	ip->total_length = rte_cpu_to_be_16(len);
+	csum = t->ip_csum + ip->total_length;
+	csum = (csum & 0xffff) + (csum >> 16);
+	ip->hdr_checksum = (csum == 0xffff) ? csum : (uint16_t)~csum;
+
+	if (type != RTE_NODE_TUNNEL_GRE) {
+		struct rte_udp_hdr *udp = (struct rte_udp_hdr *)(ip + 1);
+
+		inner = (struct rte_ipv4_hdr *)(hdr + t->hdr_len + sizeof(struct rte_ether_hdr));
+		udp->dgram_len = rte_cpu_to_be_16(len - sizeof(struct rte_ipv4_hdr));
+		udp->src_port = rte_cpu_to_be_16(tunnel_encap_sport(mbuf, inner));
+		mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 | RTE_PTYPE_L4_UDP |
+			(type == RTE_NODE_TUNNEL_VXLAN ? RTE_PTYPE_TUNNEL_VXLAN :
+							 RTE_PTYPE_TUNNEL_GENEVE);
+	} else {
+		mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+			RTE_PTYPE_TUNNEL_GRE;
+	}
+
+	/* Encapsulated packet leaves through the underlay interface */
+	mbuf->port = t->underlay_port;
+
+	return next;
+}
+
+static __rte_always_inline uint16_t
+tunnel_encap_node_process(struct rte_graph *graph, struct rte_node *node,
+			  void **objs, uint16_t nb_objs, const int type)
+{
+	struct rte_graph_feature_arc *arc =
+		rte_graph_feature_arc_get(TUNNEL_ENCAP_FEATURE_ARC(node->ctx));
+	uint16_t next0 = 0, next1 = 0, next2 = 0, next3 = 0;
+	uint16_t last_spec = 0, fix_spec = 0, held = 0;
+	struct rte_mbuf **pkts;
+	void **to_next, **from;
+	rte_edge_t next_index;
+	uint16_t n_left_from;
+
+	/* Speculative next */
+	next_index = TUNNEL_ENCAP_LAST_NEXT_INDEX(node->ctx);
+
+	from = objs;
+	n_left_from = nb_objs;
+	pkts = (struct rte_mbuf **)objs;
+
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	while (n_left_from > 4) {
+		if (likely(n_left_from > 7)) {
+			/* Prefetch next mbuf */
+			rte_prefetch0(objs[4]);
+			rte_prefetch0(objs[5]);
+			rte_prefetch0(objs[6]);
+			rte_prefetch0(objs[7]);
+		}
+
+		next0 = tunnel_encap_x1(arc, pkts[0], type);
+		next1 = tunnel_encap_x1(arc, pkts[1], type);
+		next2 = tunnel_encap_x1(arc, pkts[2], type);
+		next3 = tunnel_encap_x1(arc, pkts[3], type);
+		pkts += 4;
+		n_left_from -= 4;
+
+		fix_spec = (next_index ^ next0) | (next_index ^ next1) |
+			(next_index ^ next2) | (next_index ^ next3);
+
+		if (unlikely(fix_spec)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			if (next0 == next_index) {
+				to_next[0] = from[0];
+				to_next++;
+				held++;
+			} else {
+				rte_node_enqueue_x1(graph, node, next0, from[0]);
+			}
+
+			if (next1 == next_index) {
+				to_next[0] = from[1];
+				to_next++;
+				held++;
+			} else {
+				rte_node_enqueue_x1(graph, node, next1, from[1]);
+			}
+
+			if (next2 == next_index) {
+				to_next[0] = from[2];
+				to_next++;
+				held++;
+			} else {
+				rte_node_enqueue_x1(graph, node, next2, from[2]);
+			}
+
+			if (next3 == next_index) {
+				to_next[0] = from[3];
+				to_next++;
+				held++;
+			} else {
+				rte_node_enqueue_x1(graph, node, next3, from[3]);
+			}
+			from += 4;
+		} else {
+			last_spec += 4;
+		}
+	}
+
+	while (n_left_from > 0) {
+		next0 = tunnel_encap_x1(arc, pkts[0], type);
+		pkts += 1;
+		n_left_from -= 1;
+
+		if (unlikely(next0 != next_index)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			rte_node_enqueue_x1(graph, node, next0, from[0]);
+			from += 1;
+		} else {
+			last_spec += 1;
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	TUNNEL_ENCAP_LAST_NEXT_INDEX(node->ctx) = next0;
+
+	return nb_objs;
+}
+
+static uint16_t
+vxlan_encap_node_process(struct rte_graph *graph, struct rte_node *node,
+			 void **objs, uint16_t nb_objs)
+{
+	return tunnel_encap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_VXLAN);
+}
+
+static uint16_t
+geneve_encap_node_process(struct rte_graph *graph, struct rte_node *node,
+			  void **objs, uint16_t nb_objs)
+{
+	return tunnel_encap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_GENEVE);
+}
+
+static uint16_t
+gre_encap_node_process(struct rte_graph *graph, struct rte_node *node,
+		       void **objs, uint16_t nb_objs)
+{
+	return tunnel_encap_node_process(graph, node, objs, nb_objs,
+					 RTE_NODE_TUNNEL_GRE);
+}
+
+static int
+tunnel_encap_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	rte_graph_feature_arc_t arc;
+	int rc;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct tunnel_encap_node_ctx) > RTE_NODE_CTX_SZ);
+
+	rc = tunnel_node_main_init();
+	if (rc) {
+		node_err("tunnel_encap", "Failed to init tunnel tables, rc=%d", rc);
+		return rc;
+	}
+
+	rc = rte_graph_feature_arc_lookup_by_name(RTE_IP4_OUTPUT_FEATURE_ARC_NAME, &arc);
+	if (rc) {
+		node_err("tunnel_encap", "Failed to find ip4 output arc, rc=%d", rc);
+		return rc;
+	}
+
+	TUNNEL_ENCAP_FEATURE_ARC(node->ctx) = arc;
+	/* pkt_drop */
+	TUNNEL_ENCAP_LAST_NEXT_INDEX(node->ctx) = TUNNEL_ENCAP_NEXT_PKT_DROP;
+
+	node_dbg("tunnel_encap", "Initialized %s node", node->name);
+
+	return 0;
+}
+
+static struct rte_node_register vxlan_encap_node = {
+	.process = vxlan_encap_node_process,
+	.init = tunnel_encap_node_init,
+	.name = "vxlan_encap",
+	.nb_edges = TUNNEL_ENCAP_NEXT_MAX,
+	.next_nodes = {
+		[TUNNEL_ENCAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(vxlan_encap_node);
+
+static struct rte_node_register geneve_encap_node = {
+	.process = geneve_encap_node_process,
+	.init = tunnel_encap_node_init,
+	.name = "geneve_encap",
+	.nb_edges = TUNNEL_ENCAP_NEXT_MAX,
+	.next_nodes = {
+		[TUNNEL_ENCAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(geneve_encap_node);
+
+static struct rte_node_register gre_encap_node = {
+	.process = gre_encap_node_process,
+	.init = tunnel_encap_node_init,
+	.name = "gre_encap",
+	.nb_edges = TUNNEL_ENCAP_NEXT_MAX,
+	.next_nodes = {
+		[TUNNEL_ENCAP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gre_encap_node);
+
+/* Encap features on ip4 output arc, tunnel id is passed as app_cookie */
+static struct rte_graph_feature_register vxlan_encap_feature = {
+	.feature_name = RTE_NODE_VXLAN_ENCAP_FEATURE_NAME,
+	.arc_name = RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+	.feature_process_fn = vxlan_encap_node_process,
+	.feature_node = &vxlan_encap_node,
+};
+
+static struct rte_graph_feature_register geneve_encap_feature = {
+	.feature_name = RTE_NODE_GENEVE_ENCAP_FEATURE_NAME,
+	.arc_name = RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+	.feature_process_fn = geneve_encap_node_process,
+	.feature_node = &geneve_encap_node,
+};
+
+static struct rte_graph_feature_register gre_encap_feature = {
+	.feature_name = RTE_NODE_GRE_ENCAP_FEATURE_NAME,
+	.arc_name = RTE_IP4_OUTPUT_FEATURE_ARC_NAME,
+	.feature_process_fn = gre_encap_node_process,
+	.feature_node = &gre_encap_node,
+};
+
+RTE_GRAPH_FEATURE_REGISTER(vxlan_encap_feature);
+RTE_GRAPH_FEATURE_REGISTER(geneve_encap_feature);
+RTE_GRAPH_FEATURE_REGISTER(gre_encap_feature);
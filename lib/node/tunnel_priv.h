@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 The DPDK contributors
+ */
+#ifndef __INCLUDE_TUNNEL_PRIV_H__
+#define __INCLUDE_TUNNEL_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_hash.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_stdatomic.h>
+
+#include "rte_node_tunnel_api.h"
+
+#define TUNNEL_HDR_MAX_LEN 64
+
+/**
+ * @internal
+ *
+ * Tunnel lookup key used by decap nodes.
+ */
+struct tunnel_key {
+	uint32_t dst_ip; /**< Outer destination IPv4 in network order. */
+	uint32_t vni;    /**< VNI or GRE key in host order. */
+	uint32_t type;   /**< Tunnel type. */
+};
+
+/**
+ * @internal
+ *
+ * Tunnel data structure. Holds the prebuilt outer header copied by encap
+ * nodes and the overlay port used by decap nodes.
+ */
+struct __rte_cache_aligned tunnel_entry {
+	uint8_t hdr[TUNNEL_HDR_MAX_LEN];
+	/**< Outer header template: Ethernet, IPv4 and tunnel headers. */
+	uint32_t vni;
+	/**< VNI or GRE key, 0 for GRE without key. */
+	uint16_t hdr_len;
+	/**< Outer header template length. */
+	uint16_t ip_csum;
+	/**< Outer IPv4 checksum with zero total length, not complemented. */
+	uint16_t underlay_port;
+	/**< Ethdev port encapsulated packets are sent on. */
+	uint16_t overlay_port;
+	/**< Port set in mbuf->port of decapsulated packets. */
+	uint8_t type;
+	/**< Tunnel type. */
+};
+
+/**
+ * @internal
+ *
+ * Tunnel nodes main data structure.
+ */
+struct tunnel_node_main {
+	struct tunnel_entry entries[RTE_NODE_TUNNEL_MAX][2];
+	/**< Two entries per tunnel, updates are built in the unused one. */
+	RTE_ATOMIC(struct tunnel_entry *) tunnels[RTE_NODE_TUNNEL_MAX];
+	/**< Entry in use per tunnel, NULL if the tunnel is not configured. */
+	RTE_ATOMIC(struct rte_hash *) hash_tbl[RTE_MAX_NUMA_NODES];
+	/**< Per socket decap lookup table, created with the first tunnel. */
+	struct rte_rcu_qsbr *rcu;
+	/**< RCU QSBR variable of the graph workers, NULL if none. */
+};
+
+extern struct tunnel_node_main *tunnel_nm;
+
+/**
+ * @internal
+ *
+ * Allocate tunnel main data.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int tunnel_node_main_init(void);
+
+/**
+ * @internal
+ *
+ * Get the entry in use of a tunnel.
+ *
+ * @param tunnel_id
+ *   Tunnel identifier, less than RTE_NODE_TUNNEL_MAX.
+ *
+ * @return
+ *   Tunnel entry, NULL if the tunnel is not configured.
+ */
+static __rte_always_inline struct tunnel_entry *
+tunnel_entry_get(uint16_t tunnel_id)
+{
+	return rte_atomic_load_explicit(&tunnel_nm->tunnels[tunnel_id],
+					rte_memory_order_acquire);
+}
+
+#endif /* __INCLUDE_TUNNEL_PRIV_H__ */
@@ -24,6 +24,7 @@ struct vhost_iotlb_entry {
 };
 
 #define IOTLB_CACHE_SIZE 2048
+#define IOTLB_CACHE_MAX_SIZE 65536
 
 static void
 vhost_user_iotlb_remove_notify(struct virtio_net *dev, struct vhost_iotlb_entry *entry)
@@ -84,6 +85,55 @@ vhost_user_iotlb_clear_dump(struct virtio_net *dev, struct vhost_iotlb_entry *no
 			RTE_BIT64(node->page_shift));
 }
 
+static int
+vhost_user_iotlb_socket(struct virtio_net *dev)
+{
+	int socket = 0;
+
+#ifdef RTE_LIBRTE_VHOST_NUMA
+	if (get_mempolicy(&socket, NULL, 0, dev, MPOL_F_NODE | MPOL_F_ADDR) != 0)
+		socket = 0;
+#else
+	RTE_SET_USED(dev);
+#endif
+
+	return socket;
+}
+
+/* Index of the last entry starting at or below iova, -1 if there is none. */
+static __rte_always_inline int32_t
+vhost_user_iotlb_cache_search(const struct virtio_net *dev, uint64_t iova)
+{
+	const struct vhost_iotlb_entry *cache = dev->iotlb_cache;
+	uint32_t low = 0, high = dev->iotlb_cache_nr;
+
+	while (low < high) {
+		uint32_t mid = (low + high) / 2;
+
+		if (cache[mid].iova <= iova)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	return (int32_t)low - 1;
+}
+
+static void
+vhost_user_iotlb_cache_entry_remove(struct virtio_net *dev, uint32_t idx)
+{
+	struct vhost_iotlb_entry *cache = dev->iotlb_cache;
+
+	vhost_user_iotlb_clear_dump(dev, &cache[idx],
+			idx > 0 ? &cache[idx - 1] : NULL,
+			idx + 1 < dev->iotlb_cache_nr ? &cache[idx + 1] : NULL);
+	vhost_user_iotlb_remove_notify(dev, &cache[idx]);
+
+	memmove(&cache[idx], &cache[idx + 1],
+			(dev->iotlb_cache_nr - idx - 1) * sizeof(*cache));
+	dev->iotlb_cache_nr--;
+}
+
 static struct vhost_iotlb_entry *
 vhost_user_iotlb_pool_get(struct virtio_net *dev)
 {
@@ -105,9 +155,6 @@ vhost_user_iotlb_pool_put(struct virtio_net *dev, struct vhost_iotlb_entry *node
 	rte_spinlock_unlock(&dev->iotlb_free_lock);
 }
 
-static void
-vhost_user_iotlb_cache_random_evict(struct virtio_net *dev);
-
 static void
 vhost_user_iotlb_pending_remove_all(struct virtio_net *dev)
 {
@@ -152,10 +199,7 @@ vhost_user_iotlb_pending_insert(struct virtio_net *dev, uint64_t iova, uint8_t p
 	if (node == NULL) {
 		VHOST_CONFIG_LOG(dev->ifname, DEBUG,
 			"IOTLB pool empty, clear entries for pending insertion");
-		if (!TAILQ_EMPTY(&dev->iotlb_pending_list))
-			vhost_user_iotlb_pending_remove_all(dev);
-		else
-			vhost_user_iotlb_cache_random_evict(dev);
+		vhost_user_iotlb_pending_remove_all(dev);
 		node = vhost_user_iotlb_pool_get(dev);
 		if (node == NULL) {
 			VHOST_CONFIG_LOG(dev->ifname, ERR,
@@ -199,16 +243,13 @@ vhost_user_iotlb_pending_remove(struct virtio_net *dev, uint64_t iova, uint64_t
 static void
 vhost_user_iotlb_cache_remove_all(struct virtio_net *dev)
 {
-	struct vhost_iotlb_entry *node, *temp_node;
+	uint32_t i;
 
 	vhost_user_iotlb_wr_lock_all(dev);
 
-	RTE_TAILQ_FOREACH_SAFE(node, &dev->iotlb_list, next, temp_node) {
-		vhost_user_iotlb_clear_dump(dev, node, NULL, NULL);
-
-		TAILQ_REMOVE(&dev->iotlb_list, node, next);
-		vhost_user_iotlb_remove_notify(dev, node);
-		vhost_user_iotlb_pool_put(dev, node);
+	for (i = 0; i < dev->iotlb_cache_nr; i++) {
+		vhost_user_iotlb_clear_dump(dev, &dev->iotlb_cache[i], NULL, NULL);
+		vhost_user_iotlb_remove_notify(dev, &dev->iotlb_cache[i]);
 	}
 
 	dev->iotlb_cache_nr = 0;
@@ -219,54 +260,59 @@ vhost_user_iotlb_cache_remove_all(struct virtio_net *dev)
 static void
 vhost_user_iotlb_cache_random_evict(struct virtio_net *dev)
 {
-	struct vhost_iotlb_entry *node, *temp_node, *prev_node = NULL;
-	int entry_idx;
+	vhost_user_iotlb_cache_entry_remove(dev, rte_rand() % dev->iotlb_cache_nr);
+}
 
-	vhost_user_iotlb_wr_lock_all(dev);
+static int
+vhost_user_iotlb_cache_grow(struct virtio_net *dev)
+{
+	struct vhost_iotlb_entry *cache;
+	uint32_t size = dev->iotlb_cache_size * 2;
 
-	entry_idx = rte_rand() % dev->iotlb_cache_nr;
+	if (dev->iotlb_cache_size >= IOTLB_CACHE_MAX_SIZE)
+		return -1;
 
-	RTE_TAILQ_FOREACH_SAFE(node, &dev->iotlb_list, next, temp_node) {
-		if (!entry_idx) {
-			struct vhost_iotlb_entry *next_node = RTE_TAILQ_NEXT(node, next);
+	cache = rte_realloc_socket(dev->iotlb_cache, size * sizeof(*cache), 0,
+			vhost_user_iotlb_socket(dev));
+	if (cache == NULL)
+		return -1;
 
-			vhost_user_iotlb_clear_dump(dev, node, prev_node, next_node);
+	dev->iotlb_cache = cache;
+	dev->iotlb_cache_size = size;
 
-			TAILQ_REMOVE(&dev->iotlb_list, node, next);
-			vhost_user_iotlb_remove_notify(dev, node);
-			vhost_user_iotlb_pool_put(dev, node);
-			dev->iotlb_cache_nr--;
-			break;
-		}
-		prev_node = node;
-		entry_idx--;
-	}
-
-	vhost_user_iotlb_wr_unlock_all(dev);
+	return 0;
 }
 
 void
 vhost_user_iotlb_cache_insert(struct virtio_net *dev, uint64_t iova, uint64_t uaddr,
 				uint64_t uoffset, uint64_t size, uint64_t page_size, uint8_t perm)
 {
-	struct vhost_iotlb_entry *node, *new_node;
+	struct vhost_iotlb_entry *new_node;
+	int32_t idx;
+
+	vhost_user_iotlb_wr_lock_all(dev);
 
-	new_node = vhost_user_iotlb_pool_get(dev);
-	if (new_node == NULL) {
+	idx = vhost_user_iotlb_cache_search(dev, iova);
+	/*
+	 * Entries must be invalidated before being updated.
+	 * So if iova already in cache, assume identical.
+	 */
+	if (idx >= 0 && dev->iotlb_cache[idx].iova == iova)
+		goto unlock;
+
+	if (dev->iotlb_cache_nr == dev->iotlb_cache_size &&
+			vhost_user_iotlb_cache_grow(dev) != 0) {
 		VHOST_CONFIG_LOG(dev->ifname, DEBUG,
-			"IOTLB pool empty, clear entries for cache insertion");
-		if (!TAILQ_EMPTY(&dev->iotlb_list))
-			vhost_user_iotlb_cache_random_evict(dev);
-		else
-			vhost_user_iotlb_pending_remove_all(dev);
-		new_node = vhost_user_iotlb_pool_get(dev);
-		if (new_node == NULL) {
-			VHOST_CONFIG_LOG(dev->ifname, ERR,
-				"IOTLB pool still empty, cache insertion failed");
-			return;
-		}
+			"IOTLB cache full, evict an entry for cache insertion");
+		vhost_user_iotlb_cache_random_evict(dev);
+		idx = vhost_user_iotlb_cache_search(dev, iova);
 	}
 
+	idx++;
+	memmove(&dev->iotlb_cache[idx + 1], &dev->iotlb_cache[idx],
+			(dev->iotlb_cache_nr - idx) * sizeof(*new_node));
+
+	new_node = &dev->iotlb_cache[idx];
 	new_node->iova = iova;
 	new_node->uaddr = uaddr;
 	new_node->uoffset = uoffset;
@@ -274,28 +320,8 @@ vhost_user_iotlb_cache_insert(struct virtio_net *dev, uint64_t iova, uint64_t ua
 	new_node->page_shift = rte_ctz64(page_size);
 	new_node->perm = perm;
 
-	vhost_user_iotlb_wr_lock_all(dev);
-
-	TAILQ_FOREACH(node, &dev->iotlb_list, next) {
-		/*
-		 * Entries must be invalidated before being updated.
-		 * So if iova already in list, assume identical.
-		 */
-		if (node->iova == new_node->iova) {
-			vhost_user_iotlb_pool_put(dev, new_node);
-			goto unlock;
-		} else if (node->iova > new_node->iova) {
-			vhost_user_iotlb_set_dump(dev, new_node);
-
-			TAILQ_INSERT_BEFORE(node, new_node, next);
-			dev->iotlb_cache_nr++;
-			goto unlock;
-		}
-	}
-
 	vhost_user_iotlb_set_dump(dev, new_node);
 
-	TAILQ_INSERT_TAIL(&dev->iotlb_list, new_node, next);
 	dev->iotlb_cache_nr++;
 
 unlock:
@@ -307,46 +333,79 @@ vhost_user_iotlb_cache_insert(struct virtio_net *dev, uint64_t iova, uint64_t ua
 void
 vhost_user_iotlb_cache_remove(struct virtio_net *dev, uint64_t iova, uint64_t size)
 {
-	struct vhost_iotlb_entry *node, *temp_node, *prev_node = NULL;
+	struct vhost_iotlb_entry *cache;
+	uint32_t i, j, nr;
 
 	if (unlikely(!size))
 		return;
 
 	vhost_user_iotlb_wr_lock_all(dev);
 
-	RTE_TAILQ_FOREACH_SAFE(node, &dev->iotlb_list, next, temp_node) {
-		/* Sorted list */
-		if (unlikely(iova + size < node->iova))
-			break;
+	cache = dev->iotlb_cache;
+	nr = dev->iotlb_cache_nr;
 
-		if (iova < node->iova + node->size) {
-			struct vhost_iotlb_entry *next_node = RTE_TAILQ_NEXT(node, next);
+	/* Entries below the one holding iova end before it */
+	i = RTE_MAX(vhost_user_iotlb_cache_search(dev, iova), 0);
 
-			vhost_user_iotlb_clear_dump(dev, node, prev_node, next_node);
+	for (j = i; i < nr; i++) {
+		if (unlikely(iova + size < cache[i].iova))
+			break;
 
-			TAILQ_REMOVE(&dev->iotlb_list, node, next);
-			vhost_user_iotlb_remove_notify(dev, node);
-			vhost_user_iotlb_pool_put(dev, node);
-			dev->iotlb_cache_nr--;
+		if (iova < cache[i].iova + cache[i].size) {
+			vhost_user_iotlb_clear_dump(dev, &cache[i],
+					j > 0 ? &cache[j - 1] : NULL,
+					i + 1 < nr ? &cache[i + 1] : NULL);
+			vhost_user_iotlb_remove_notify(dev, &cache[i]);
 		} else {
-			prev_node = node;
+			if (j != i)
+				cache[j] = cache[i];
+			j++;
 		}
 	}
 
+	if (j != i) {
+		memmove(&cache[j], &cache[i], (nr - i) * sizeof(*cache));
+		dev->iotlb_cache_nr -= i - j;
+	}
+
 	vhost_user_iotlb_wr_unlock_all(dev);
 }
 
 uint64_t
-vhost_user_iotlb_cache_find(struct virtio_net *dev, uint64_t iova, uint64_t *size, uint8_t perm)
+vhost_user_iotlb_cache_find(struct virtio_net *dev, struct vhost_virtqueue *vq,
+		uint64_t iova, uint64_t *size, uint8_t perm)
 {
-	struct vhost_iotlb_entry *node;
+	const struct vhost_iotlb_entry *node;
 	uint64_t offset, vva = 0, mapped = 0;
+	uint32_t idx;
+	int32_t found;
 
 	if (unlikely(!*size))
 		goto out;
 
-	TAILQ_FOREACH(node, &dev->iotlb_list, next) {
-		/* List sorted by iova */
+	/*
+	 * Most translations of a burst hit the same entry as the previous one,
+	 * try it before searching. Updates may have shifted the entries since,
+	 * so the hint is only trusted if it still covers iova.
+	 */
+	idx = rte_atomic_load_explicit(&vq->iotlb_hint, rte_memory_order_relaxed);
+	if (likely(idx < dev->iotlb_cache_nr &&
+			iova >= dev->iotlb_cache[idx].iova &&
+			iova < dev->iotlb_cache[idx].iova + dev->iotlb_cache[idx].size))
+		goto walk;
+
+	found = vhost_user_iotlb_cache_search(dev, iova);
+	if (unlikely(found < 0))
+		goto out;
+
+	idx = found;
+	rte_atomic_store_explicit(&vq->iotlb_hint, idx, rte_memory_order_relaxed);
+
+walk:
+	for (; idx < dev->iotlb_cache_nr; idx++) {
+		node = &dev->iotlb_cache[idx];
+
+		/* Cache sorted by iova */
 		if (unlikely(iova < node->iova))
 			break;
 
@@ -397,18 +456,16 @@ vhost_user_iotlb_init(struct virtio_net *dev)
 		 */
 		vhost_user_iotlb_flush_all(dev);
 		rte_free(dev->iotlb_pool);
+		rte_free(dev->iotlb_cache);
+		dev->iotlb_cache = NULL;
 	}
 
-#ifdef RTE_LIBRTE_VHOST_NUMA
-	if (get_mempolicy(&socket, NULL, 0, dev, MPOL_F_NODE | MPOL_F_ADDR) != 0)
-		socket = 0;
-#endif
+	socket = vhost_user_iotlb_socket(dev);
 
 	rte_spinlock_init(&dev->iotlb_free_lock);
 	rte_rwlock_init(&dev->iotlb_pending_lock);
 
 	SLIST_INIT(&dev->iotlb_free_list);
-	TAILQ_INIT(&dev->iotlb_list);
 	TAILQ_INIT(&dev->iotlb_pending_list);
 
 	if (dev->flags & VIRTIO_DEV_SUPPORT_IOMMU) {
@@ -420,9 +477,19 @@ vhost_user_iotlb_init(struct virtio_net *dev)
 		}
 		for (i = 0; i < IOTLB_CACHE_SIZE; i++)
 			vhost_user_iotlb_pool_put(dev, &dev->iotlb_pool[i]);
+
+		dev->iotlb_cache = rte_malloc_socket("iotlb", IOTLB_CACHE_SIZE *
+			sizeof(struct vhost_iotlb_entry), 0, socket);
+		if (!dev->iotlb_cache) {
+			VHOST_CONFIG_LOG(dev->ifname, ERR, "Failed to create IOTLB cache");
+			rte_free(dev->iotlb_pool);
+			dev->iotlb_pool = NULL;
+			return -1;
+		}
 	}
 
 	dev->iotlb_cache_nr = 0;
+	dev->iotlb_cache_size = dev->iotlb_cache ? IOTLB_CACHE_SIZE : 0;
 
 	return 0;
 }
@@ -431,4 +498,5 @@ void
 vhost_user_iotlb_destroy(struct virtio_net *dev)
 {
 	rte_free(dev->iotlb_pool);
+	rte_free(dev->iotlb_cache);
 }
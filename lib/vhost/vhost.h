@@ -69,6 +69,10 @@
 			    sizeof(struct vring_packed_desc))
 #define PACKED_BATCH_MASK (PACKED_BATCH_SIZE - 1)
 
+#define SPLIT_BATCH_SIZE (RTE_CACHE_LINE_SIZE / \
+			  sizeof(struct vring_desc))
+#define SPLIT_DESC_SINGLE_FLAG (VRING_DESC_F_NEXT | VRING_DESC_F_INDIRECT)
+
 #if defined __clang__
 #define vhost_for_each_try_unroll(iter, val, size) _Pragma("unroll 4") \
 	for (iter = val; iter < size; iter++)
@@ -334,6 +338,8 @@ struct __rte_cache_aligned vhost_virtqueue {
 	struct log_cache_entry	*log_cache;
 
 	rte_rwlock_t	iotlb_lock;
+	/* Index of the IOTLB cache entry of the last translation */
+	RTE_ATOMIC(uint32_t)	iotlb_hint;
 
 	/* Used to notify the guest (trigger interrupt) */
 	int			callfd;
@@ -505,9 +511,11 @@ struct __rte_cache_aligned virtio_net {
 
 	rte_rwlock_t	iotlb_pending_lock;
 	struct vhost_iotlb_entry *iotlb_pool;
-	TAILQ_HEAD(, vhost_iotlb_entry) iotlb_list;
+	/* Entries sorted by iova, updated with all virtqueues iotlb_lock held */
+	struct vhost_iotlb_entry *iotlb_cache;
+	uint32_t		iotlb_cache_nr;
+	uint32_t		iotlb_cache_size;
 	TAILQ_HEAD(, vhost_iotlb_entry) iotlb_pending_list;
-	int				iotlb_cache_nr;
 	rte_spinlock_t	iotlb_free_lock;
 	SLIST_HEAD(, vhost_iotlb_entry) iotlb_free_list;
 
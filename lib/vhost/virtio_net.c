@@ -1390,6 +1390,139 @@ vhost_enqueue_single_packed(struct virtio_net *dev,
 	return 0;
 }
 
+/*
+ * Check whether the next SPLIT_BATCH_SIZE avail entries point to
+ * consecutive single descriptors, as made available by an in-order
+ * driver, and translate their buffers.
+ */
+static __rte_always_inline int
+vhost_reserve_avail_batch_split(struct virtio_net *dev,
+				struct vhost_virtqueue *vq,
+				uint16_t avail_idx,
+				uint64_t *desc_addrs,
+				uint64_t *lens,
+				uint16_t *head_idx,
+				uint8_t perm)
+	__rte_requires_shared_capability(&vq->iotlb_lock)
+{
+	uint16_t ring_idx = avail_idx & (vq->size - 1);
+	struct vring_desc *descs;
+	uint16_t head, i;
+
+	if (unlikely(ring_idx + SPLIT_BATCH_SIZE > vq->size))
+		return -1;
+
+	head = vq->avail->ring[ring_idx];
+	if (unlikely(head + SPLIT_BATCH_SIZE > vq->size))
+		return -1;
+
+	vhost_for_each_try_unroll(i, 1, SPLIT_BATCH_SIZE) {
+		if (unlikely(vq->avail->ring[ring_idx + i] != head + i))
+			return -1;
+	}
+
+	/* The batch descriptors share a cache line, fetch them at once */
+	descs = &vq->desc[head];
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(descs[i].flags & SPLIT_DESC_SINGLE_FLAG))
+			return -1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		lens[i] = descs[i].len;
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		desc_addrs[i] = vhost_iova_to_vva(dev, vq, descs[i].addr,
+						  &lens[i], perm);
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(!desc_addrs[i]))
+			return -1;
+		if (unlikely(lens[i] != descs[i].len))
+			return -1;
+	}
+
+	*head_idx = head;
+
+	return 0;
+}
+
+static __rte_always_inline int
+virtio_dev_rx_sync_batch_split(struct virtio_net *dev,
+			       struct vhost_virtqueue *vq,
+			       struct rte_mbuf **pkts)
+	__rte_requires_shared_capability(&vq->iotlb_lock)
+{
+	const uint64_t ol_mask = RTE_MBUF_F_TX_L4_MASK | RTE_MBUF_F_TX_IP_CKSUM |
+		RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG;
+	uint32_t buf_offset = dev->vhost_hlen;
+	struct virtio_net_hdr_mrg_rxbuf *hdrs[SPLIT_BATCH_SIZE];
+	uint64_t desc_addrs[SPLIT_BATCH_SIZE];
+	uint64_t lens[SPLIT_BATCH_SIZE];
+	uint64_t ol_flags = 0;
+	uint16_t head, i;
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(pkts[i]->next != NULL))
+			return -1;
+	}
+
+	if (vhost_reserve_avail_batch_split(dev, vq, vq->last_avail_idx,
+					    desc_addrs, lens, &head,
+					    VHOST_ACCESS_RW))
+		return -1;
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(lens[i] < buf_offset ||
+			     pkts[i]->pkt_len > (lens[i] - buf_offset)))
+			return -1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		rte_prefetch0((void *)(uintptr_t)desc_addrs[i]);
+		hdrs[i] = (struct virtio_net_hdr_mrg_rxbuf *)
+					(uintptr_t)desc_addrs[i];
+		lens[i] = pkts[i]->pkt_len + buf_offset;
+		ol_flags |= pkts[i]->ol_flags;
+	}
+
+	/*
+	 * Without offload requests the headers are all zeroes, write them
+	 * whole rather than comparing and setting each field.
+	 */
+	if (likely(!(ol_flags & ol_mask))) {
+		vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+			memset(&hdrs[i]->hdr, 0, sizeof(struct virtio_net_hdr));
+	} else {
+		vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+			virtio_enqueue_offload(pkts[i], &hdrs[i]->hdr);
+	}
+
+	if (rxvq_is_mergeable(dev)) {
+		vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+			hdrs[i]->num_buffers = 1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		rte_memcpy((void *)(uintptr_t)(desc_addrs[i] + buf_offset),
+			   rte_pktmbuf_mtod_offset(pkts[i], void *, 0),
+			   pkts[i]->pkt_len);
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		vhost_log_cache_write_iova(dev, vq, vq->desc[head + i].addr,
+					   lens[i]);
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		update_shadow_used_ring_split(vq, head + i, lens[i]);
+
+	vq->last_avail_idx += SPLIT_BATCH_SIZE;
+	vhost_virtqueue_reconnect_log_split(vq);
+
+	return 0;
+}
+
 static __rte_noinline uint32_t
 virtio_dev_rx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	struct rte_mbuf **pkts, uint32_t count)
@@ -1410,10 +1543,20 @@ virtio_dev_rx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 	rte_prefetch0(&vq->avail->ring[vq->last_avail_idx & (vq->size - 1)]);
 
-	for (pkt_idx = 0; pkt_idx < count; pkt_idx++) {
+	while (pkt_idx < count) {
 		uint64_t pkt_len = pkts[pkt_idx]->pkt_len + dev->vhost_hlen;
 		uint16_t nr_vec = 0;
 
+		if (count - pkt_idx >= SPLIT_BATCH_SIZE &&
+		    (uint16_t)(avail_head - vq->last_avail_idx) >=
+				SPLIT_BATCH_SIZE) {
+			if (!virtio_dev_rx_sync_batch_split(dev, vq,
+							    &pkts[pkt_idx])) {
+				pkt_idx += SPLIT_BATCH_SIZE;
+				continue;
+			}
+		}
+
 		if (unlikely(reserve_avail_buf_split(dev, vq,
 						pkt_len, buf_vec, &num_buffers,
 						avail_head, &nr_vec) < 0)) {
@@ -1435,6 +1578,7 @@ virtio_dev_rx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 
 		vq->last_avail_idx += num_buffers;
 		vhost_virtqueue_reconnect_log_split(vq);
+		pkt_idx++;
 	}
 
 	do_data_copy_enqueue(dev, vq);
@@ -3098,6 +3242,73 @@ virtio_dev_pktmbuf_prep(struct virtio_net *dev, struct rte_mbuf *pkt,
 	return -1;
 }
 
+static __rte_always_inline int
+virtio_dev_tx_batch_split(struct virtio_net *dev,
+			  struct vhost_virtqueue *vq,
+			  struct rte_mbuf **pkts,
+			  uint16_t avail_idx,
+			  bool legacy_ol_flags)
+	__rte_requires_shared_capability(&vq->iotlb_lock)
+{
+	uint32_t buf_offset = dev->vhost_hlen;
+	uint64_t desc_addrs[SPLIT_BATCH_SIZE];
+	uint64_t lens[SPLIT_BATCH_SIZE];
+	uint16_t buf_lens[SPLIT_BATCH_SIZE];
+	uint16_t head, i;
+
+	if (vhost_reserve_avail_batch_split(dev, vq, avail_idx, desc_addrs,
+					    lens, &head, VHOST_ACCESS_RO))
+		return -1;
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(lens[i] <= buf_offset))
+			return -1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (virtio_dev_pktmbuf_prep(dev, pkts[i], lens[i] - buf_offset))
+			return -1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		buf_lens[i] = pkts[i]->buf_len - pkts[i]->data_off;
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		if (unlikely(buf_lens[i] < (lens[i] - buf_offset)))
+			return -1;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		rte_prefetch0((void *)(uintptr_t)(desc_addrs[i] + buf_offset));
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+		pkts[i]->pkt_len = lens[i] - buf_offset;
+		pkts[i]->data_len = pkts[i]->pkt_len;
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		rte_memcpy(rte_pktmbuf_mtod_offset(pkts[i], void *, 0),
+			   (void *)(uintptr_t)(desc_addrs[i] + buf_offset),
+			   pkts[i]->pkt_len);
+
+	if (virtio_net_with_host_offload(dev)) {
+		vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE) {
+			struct virtio_net_hdr hdr;
+
+			memcpy(&hdr, (void *)(uintptr_t)desc_addrs[i],
+			       sizeof(struct virtio_net_hdr));
+			rte_compiler_barrier();
+
+			vhost_dequeue_offload(dev, &hdr, pkts[i], legacy_ol_flags);
+		}
+	}
+
+	vhost_for_each_try_unroll(i, 0, SPLIT_BATCH_SIZE)
+		update_shadow_used_ring_split(vq, head + i, 0);
+
+	return 0;
+}
+
 __rte_always_inline
 static uint16_t
 virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
@@ -3132,13 +3343,23 @@ virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		return 0;
 	}
 
-	for (i = 0; i < count; i++) {
+	i = 0;
+	while (i < count) {
 		struct buf_vector buf_vec[BUF_VECTOR_MAX];
 		uint16_t head_idx;
 		uint32_t buf_len;
 		uint16_t nr_vec = 0;
 		int err;
 
+		if (i + SPLIT_BATCH_SIZE <= count) {
+			if (!virtio_dev_tx_batch_split(dev, vq, &pkts[i],
+						       vq->last_avail_idx + i,
+						       legacy_ol_flags)) {
+				i += SPLIT_BATCH_SIZE;
+				continue;
+			}
+		}
+
 		if (unlikely(fill_vec_buf_split(dev, vq,
 						vq->last_avail_idx + i,
 						&nr_vec, buf_vec,
@@ -3178,6 +3399,7 @@ virtio_dev_tx_split(struct virtio_net *dev, struct vhost_virtqueue *vq,
 			}
 			break;
 		}
+		i++;
 	}
 
 	if (unlikely(count != i))